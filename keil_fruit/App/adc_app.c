@@ -1,12 +1,36 @@
 #include "adc_app.h"
+#include "ethylene_lut.h"
 
-#define ADC_CHANNEL_NUM     2       // ADC channel count
-#define ADC_SAMPLE_NUM      16      // samples per channel
-#define ADC_DMA_BUFFER_SIZE (ADC_CHANNEL_NUM * ADC_SAMPLE_NUM)
+#define ADC_BLOCK_LOG2      4
+#define ADC_BLOCK_LEN       (1u << ADC_BLOCK_LOG2) // CH0 samples per DMA half-transfer
+#define ADC_DMA_BUFFER_SIZE (ADC_BLOCK_LEN * 2)
 
-uint32_t adc_dma_buffer[ADC_DMA_BUFFER_SIZE];
+#define ADC_CH0_MEDIAN_LEN  5       // per-sample spike rejector
+#define ADC_CH0_LPF_HZ      20.0f   // biquad cut-off ahead of the decimator
+#define ADC_CH0_LPF_GAIN    3       // codes << 3 into the biquad: 4095 << 3 still fits Q15
+#define ADC_CH1_EMA_ALPHA   8192    // battery EMA, 0.25 in Q15
 
-// Channel 0 (PA0) - Ethylene sensor
+/*
+ * Oversampling: 4^k samples summed and shifted right by k give 12+k bits.
+ * The decimator sums whole DMA blocks, so the window is at least one block;
+ * a longer window than 4^k just averages more (shift by log2(window) - k).
+ */
+#if (ADC_OVERSAMPLE_BITS < 0) || (ADC_OVERSAMPLE_BITS > 4)
+#error "ADC_OVERSAMPLE_BITS must be 0..4"
+#endif
+#if (2 * ADC_OVERSAMPLE_BITS) > ADC_BLOCK_LOG2
+#define ADC_OS_WINDOW_LOG2  (2 * ADC_OVERSAMPLE_BITS)
+#else
+#define ADC_OS_WINDOW_LOG2  ADC_BLOCK_LOG2
+#endif
+#define ADC_OS_BLOCKS       (1u << (ADC_OS_WINDOW_LOG2 - ADC_BLOCK_LOG2))
+#define ADC_OS_SHIFT        (ADC_OS_WINDOW_LOG2 - ADC_OVERSAMPLE_BITS + ADC_CH0_LPF_GAIN)
+#define ADC_CH0_CODE_MAX    ((1u << ADC_CH0_BITS) - 1u)
+
+// Halfword DMA, circular; each half is filtered while the other one fills
+int16_t adc_dma_buffer[ADC_DMA_BUFFER_SIZE];
+
+// Channel 0 (PA0) - Ethylene sensor, ADC_CH0_BITS wide
 __IO uint32_t adc_val_ch0;
 __IO float voltage_ch0;
 
@@ -14,9 +38,213 @@ __IO float voltage_ch0;
 __IO uint32_t adc_val_ch1;
 __IO float voltage_ch1;
 
+// CH0 filter chain: median -> biquad low-pass -> oversampling decimator
+static DSP_Median adc_ch0_median;
+static DSP_BiquadQ15 adc_ch0_lpf;
+static uint8_t adc_ch0_primed = 0;
+static int16_t adc_ch0_block[ADC_BLOCK_LEN];
+static int32_t adc_os_acc = 0;
+static uint16_t adc_os_blocks = 0;
+static __IO uint32_t adc_ch0_filtered = 0;
+
+static DSP_EmaQ31 adc_ch1_ema;
+
+// Actual trigger period: TIM2 ticks (ARR + 1, no prescaler) at its input clock
+static __IO uint32_t adc_trig_ticks = 0;
+static __IO uint32_t adc_trig_clk_hz = 0;
+static __IO uint8_t adc_ch0_redesign = 0;  // rate changed, adc_poll redesigns the low-pass
+
+/**
+ * @brief  TIM2 input clock: PCLK1, doubled when APB1 is divided
+ */
+static uint32_t adc_trig_timer_clock(void)
+{
+    uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_HCLK_DIV1) {
+        return pclk1 * 2u;
+    }
+    return pclk1;
+}
+
+/**
+ * @brief  (Re)design the CH0 low-pass for the current sample rate
+ * @note   Only the coefficients change, the filter history is kept, so a
+ *         rate switch does not restart the output from zero. Task context
+ *         only (adc_poll): the design takes floating-point trig and the
+ *         copy masks interrupts.
+ */
+static void adc_ch0_filter_design(void)
+{
+    DSP_BiquadQ15 design;
+
+    if (adc_trig_ticks == 0) {
+        return;
+    }
+
+    DSP_BiquadQ15_InitLowpass(&design, ADC_CH0_LPF_HZ, adc_get_sample_rate_hz());
+
+    __disable_irq();
+    adc_ch0_lpf.b0 = design.b0;
+    adc_ch0_lpf.b1 = design.b1;
+    adc_ch0_lpf.b2 = design.b2;
+    adc_ch0_lpf.na1 = design.na1;
+    adc_ch0_lpf.na2 = design.na2;
+    __enable_irq();
+}
+
+/**
+ * @brief  Filter one half of the CH0 DMA ring (DMA interrupt context)
+ */
+static void adc_ch0_process_block(const int16_t *samples)
+{
+    int32_t code;
+
+    burst_on_block(samples, ADC_BLOCK_LEN);
+
+    if (!adc_ch0_primed) {
+        // Start the low-pass at the first reading instead of ramping from 0
+        adc_ch0_lpf.x1 = adc_ch0_lpf.x2 = (int16_t)(samples[0] << ADC_CH0_LPF_GAIN);
+        adc_ch0_lpf.y1 = adc_ch0_lpf.y2 = (int16_t)(samples[0] << ADC_CH0_LPF_GAIN);
+        adc_ch0_primed = 1;
+    }
+
+    // Headroom bits keep the dither the decimator needs; an integer-code
+    // biquad output would quantize it away before the averaging
+    for (uint16_t i = 0; i < ADC_BLOCK_LEN; i++)
+    {
+        int32_t v = DSP_Median_Update(&adc_ch0_median, samples[i]);
+        adc_ch0_block[i] = (int16_t)(v << ADC_CH0_LPF_GAIN);
+    }
+    DSP_BiquadQ15_Process(&adc_ch0_lpf, adc_ch0_block, adc_ch0_block, ADC_BLOCK_LEN);
+
+    // Fixed work per sample: one block sum, one decimator step per block
+    adc_os_acc += DSP_SumQ15(adc_ch0_block, ADC_BLOCK_LEN);
+    if (++adc_os_blocks < ADC_OS_BLOCKS) {
+        return;
+    }
+
+    code = (adc_os_acc + (1 << (ADC_OS_SHIFT - 1))) >> ADC_OS_SHIFT;
+    adc_os_acc = 0;
+    adc_os_blocks = 0;
+
+    if (code < 0) {
+        code = 0;
+    } else if (code > (int32_t)ADC_CH0_CODE_MAX) {
+        code = (int32_t)ADC_CH0_CODE_MAX;
+    }
+    adc_ch0_filtered = (uint32_t)code;
+}
+
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->Instance == ADC1) {
+        adc_ch0_process_block(&adc_dma_buffer[0]);
+    }
+}
+
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->Instance == ADC1) {
+        adc_ch0_process_block(&adc_dma_buffer[ADC_BLOCK_LEN]);
+    }
+}
+
+/**
+ * @brief  Set the ADC1 regular (CH0) sample rate
+ * @param  rate_hz: trigger rate, 1 .. half the TIM2 clock
+ * @note   TIM2 is programmed at register level (the HAL TIM driver is not
+ *         part of this project): it counts its input clock undivided
+ *         (PSC = 0; the counter is 32 bits, so 1 Hz still fits ARR), ARR
+ *         gives the period to the nearest clock tick and the update event
+ *         is routed to TRGO, which starts one conversion. Read the rate
+ *         achieved back with adc_get_sample_rate_hz().
+ *         Callable from interrupt handlers (burst capture switches the rate
+ *         in the ADC and DMA callbacks): the CH0 low-pass is redesigned for
+ *         the new rate by the next adc_poll(), until then at most one block
+ *         is filtered with the old coefficients.
+ */
+void adc_set_sample_rate(uint32_t rate_hz)
+{
+    uint32_t clk = adc_trig_timer_clock();
+
+    if (rate_hz == 0 || rate_hz > clk / 2u) {
+        return;
+    }
+
+    uint32_t period = (clk + rate_hz / 2u) / rate_hz;
+
+    __HAL_RCC_TIM2_CLK_ENABLE();
+
+    TIM2->CR1 &= ~TIM_CR1_CEN;
+    TIM2->PSC = 0;
+    TIM2->ARR = period - 1u;
+    TIM2->CNT = 0;
+    TIM2->CR2 = (TIM2->CR2 & ~TIM_CR2_MMS) | TIM_CR2_MMS_1;   // TRGO = update
+    TIM2->EGR = TIM_EGR_UG;                                  // load PSC/ARR now
+    TIM2->CR1 |= TIM_CR1_ARPE | TIM_CR1_CEN;
+
+    adc_trig_clk_hz = clk;
+    adc_trig_ticks = period;
+    adc_ch0_redesign = 1;
+}
+
+void adc_poll(void)
+{
+    if (adc_ch0_redesign) {
+        adc_ch0_redesign = 0;   // a rate change during the design sets it again
+        adc_ch0_filter_design();
+    }
+}
+
+/**
+ * @brief  CH0 conversions in the DMA ring not yet passed to burst_on_block()
+ * @note   For interrupt handlers that change the rate: these were taken at
+ *         the old one. A half whose DMA interrupt is still pending counts
+ *         whole (ADC_IRQn runs before DMA2_Stream0_IRQn at equal priority).
+ */
+uint16_t adc_ch0_pending(void)
+{
+    uint32_t pos = ADC_DMA_BUFFER_SIZE - __HAL_DMA_GET_COUNTER(&hdma_adc1);
+    uint16_t n = (uint16_t)(pos % ADC_BLOCK_LEN);
+
+    if (__HAL_DMA_GET_FLAG(&hdma_adc1, __HAL_DMA_GET_HT_FLAG_INDEX(&hdma_adc1)) ||
+        __HAL_DMA_GET_FLAG(&hdma_adc1, __HAL_DMA_GET_TC_FLAG_INDEX(&hdma_adc1))) {
+        n += ADC_BLOCK_LEN;
+    }
+    return n;
+}
+
+// Trigger period in TIM2 input clock ticks (0: not started)
+uint32_t adc_get_sample_period_ticks(void)
+{
+    return adc_trig_ticks;
+}
+
+// Rate actually achieved: timer clock / (ARR + 1)
+float adc_get_sample_rate_hz(void)
+{
+    if (adc_trig_ticks == 0) {
+        return 0.0f;
+    }
+    return (float)adc_trig_clk_hz / (float)adc_trig_ticks;
+}
+
 void adc_dma_init(void)
 {
+    Ethylene_LUT_SetR0(g_sensor_r0);
+
+    DSP_Median_Init(&adc_ch0_median, ADC_CH0_MEDIAN_LEN);
+    DSP_BiquadQ15_InitLowpass(&adc_ch0_lpf, ADC_CH0_LPF_HZ, (float)ADC_SAMPLE_RATE_HZ);
+    DSP_EmaQ31_Init(&adc_ch1_ema, ADC_CH1_EMA_ALPHA);
+
     HAL_ADC_Start_DMA(&hadc1, (uint32_t*)adc_dma_buffer, ADC_DMA_BUFFER_SIZE);
+    adc_set_sample_rate(ADC_SAMPLE_RATE_HZ);
+
+    burst_init();
+
+    // Kick off the first battery conversion; adc_task collects it
+    SET_BIT(hadc1.Instance->CR2, ADC_CR2_JSWSTART);
 }
 
 #define SENSOR_VC       3.3f
@@ -51,6 +279,123 @@ float Ethylene_CalculatePPM(float voltage_v, float r0_kohm)
     return ppm;
 }
 
+/*
+ * Ethylene curve lookup table
+ *
+ * ppm = A * (rs / r0)^B = (A * r0^-B) * rs^B, so the R0-independent part
+ * rs(code)^B lives in a const table in flash (ethylene_lut.h, generated
+ * by tools/sensor_test/gen_ethylene_lut.c) and a change of R0 only
+ * recomputes one scale factor and the ratio > 1.2 cut-off code.
+ * Against Ethylene_CalculatePPM() on the same code the relative error is
+ * below 1e-5 over all 4096 codes (single-precision rounding of the
+ * factored form); the zero/cut-off decisions are identical.
+ */
+static float ethylene_lut_scale = 0.0f;         // A * r0^-B
+static float ethylene_lut_r0 = -1.0f;           // R0 the scale was built for
+static uint16_t ethylene_lut_code_min = ETHYLENE_LUT_SIZE; // first code with ratio <= 1.2
+
+static float ethylene_code_to_voltage(uint16_t code)
+{
+    return ((float)code * 3.3f) / 4096.0f;
+}
+
+static float ethylene_rs_from_voltage(float voltage_v)
+{
+    return SENSOR_RL * (SENSOR_VC - voltage_v) / voltage_v;
+}
+
+/**
+ * @brief  Re-target the table to a new R0
+ * @note   One powf plus a 12-step binary search for the cut-off code.
+ *         rs falls as the code rises, so ratio <= 1.2 holds from
+ *         ethylene_lut_code_min upwards.
+ */
+void Ethylene_LUT_SetR0(float r0_kohm)
+{
+    ethylene_lut_r0 = r0_kohm;
+
+    if (r0_kohm <= 0.001f) {
+        ethylene_lut_scale = 0.0f;
+        ethylene_lut_code_min = ETHYLENE_LUT_SIZE;
+        return;
+    }
+
+    ethylene_lut_scale = FIT_PARAM_A * powf(r0_kohm, -FIT_PARAM_B);
+
+    uint16_t lo = 0;
+    uint16_t hi = ETHYLENE_LUT_SIZE;
+    while (lo < hi)
+    {
+        uint16_t mid = (uint16_t)((lo + hi) / 2u);
+        float voltage_v = ethylene_code_to_voltage(mid);
+        // Same expression and comparison as Ethylene_CalculatePPM()
+        if (voltage_v <= 0.01f ||
+            ethylene_rs_from_voltage(voltage_v) / r0_kohm > 1.2f) {
+            lo = mid + 1u;
+        } else {
+            hi = mid;
+        }
+    }
+    ethylene_lut_code_min = lo;
+}
+
+/**
+ * @brief  Ethylene PPM from a raw 12-bit ADC code via the lookup table
+ * @param  code: ADC code (0-4095)
+ * @return ethylene PPM (0 where Ethylene_CalculatePPM() returns 0)
+ */
+float Ethylene_PPMFromCode(uint16_t code)
+{
+    if (code >= ETHYLENE_LUT_SIZE || code < ethylene_lut_code_min) {
+        return 0.0f;
+    }
+    return ethylene_lut_scale * ethylene_lut[code];
+}
+
+/**
+ * @brief  Lowest 12-bit code whose table PPM reaches ppm
+ * @note   ppm rises with the code above the cut-off, so a binary search
+ *         over the table inverts the curve for the current R0.
+ * @return code, or 4095 if ppm is out of reach (watchdog never fires)
+ */
+uint16_t Ethylene_CodeFromPPM(float ppm)
+{
+    uint16_t lo = ethylene_lut_code_min;
+    uint16_t hi = ETHYLENE_LUT_SIZE;
+
+    while (lo < hi)
+    {
+        uint16_t mid = (uint16_t)((lo + hi) / 2u);
+        if (Ethylene_PPMFromCode(mid) < ppm) {
+            lo = mid + 1u;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo >= ETHYLENE_LUT_SIZE) ? (ETHYLENE_LUT_SIZE - 1u) : lo;
+}
+
+/**
+ * @brief  Ethylene PPM from an oversampled code
+ * @param  code: ADC code with frac_bits bits below the 12-bit LSB
+ * @param  frac_bits: extra resolution bits (0 = plain 12-bit code)
+ * @return ethylene PPM, linearly interpolated between table entries
+ */
+float Ethylene_PPMFromCodeHR(uint32_t code, uint8_t frac_bits)
+{
+    uint32_t idx = code >> frac_bits;
+    float frac = (float)(code & ((1u << frac_bits) - 1u)) / (float)(1u << frac_bits);
+
+    if (idx >= ETHYLENE_LUT_SIZE || idx < ethylene_lut_code_min) {
+        return 0.0f;
+    }
+    if (idx + 1u >= ETHYLENE_LUT_SIZE || ethylene_lut[idx + 1u] == 0.0f) {
+        return ethylene_lut_scale * ethylene_lut[idx];
+    }
+    return ethylene_lut_scale *
+           (ethylene_lut[idx] + frac * (ethylene_lut[idx + 1u] - ethylene_lut[idx]));
+}
+
 float sensor_rs = 0.0f;
 float g_sensor_r0 = 105.2f;
 float g_ethylene_ppm = 0.0f;
@@ -58,31 +403,38 @@ float charge_fruit_equipment = 0.0f;
 
 void adc_task(void)
 {
-    uint32_t sum_ch0 = 0;
-    uint32_t sum_ch1 = 0;
+    // CH0: filtered and decimated in the DMA half/full-transfer callbacks
+    adc_val_ch0 = adc_ch0_filtered;
 
-    // DMA buffer: [ch0, ch1, ch0, ch1, ch0, ch1, ...]
-    for(uint16_t i = 0; i < ADC_DMA_BUFFER_SIZE; i += ADC_CHANNEL_NUM)
+    // Channel 1: injected group started on the previous call
+    if (__HAL_ADC_GET_FLAG(&hadc1, ADC_FLAG_JEOC))
     {
-        sum_ch0 += adc_dma_buffer[i];       // Channel 0 (PA0)
-        sum_ch1 += adc_dma_buffer[i + 1];   // Channel 1 (PA1)
+        __HAL_ADC_CLEAR_FLAG(&hadc1, ADC_FLAG_JEOC | ADC_FLAG_JSTRT);
+        uint32_t avg_ch1 = (HAL_ADCEx_InjectedGetValue(&hadc1, ADC_INJECTED_RANK_1) +
+                            HAL_ADCEx_InjectedGetValue(&hadc1, ADC_INJECTED_RANK_2) +
+                            HAL_ADCEx_InjectedGetValue(&hadc1, ADC_INJECTED_RANK_3) +
+                            HAL_ADCEx_InjectedGetValue(&hadc1, ADC_INJECTED_RANK_4)) / 4;
+        adc_val_ch1 = (uint32_t)DSP_EmaQ31_Update(&adc_ch1_ema, (int32_t)avg_ch1);
     }
-
-    // Average
-    adc_val_ch0 = sum_ch0 / ADC_SAMPLE_NUM;
-    adc_val_ch1 = sum_ch1 / ADC_SAMPLE_NUM;
+    SET_BIT(hadc1.Instance->CR2, ADC_CR2_JSWSTART);
 
     // Convert to voltage (12bit, 3.3V ref)
-    voltage_ch0 = ((float)adc_val_ch0 * 3.3f) / 4096.0f;
+    voltage_ch0 = ((float)adc_val_ch0 * 3.3f) / (float)(1u << ADC_CH0_BITS);
     voltage_ch1 = ((float)adc_val_ch1 * 3.3f) / 4096.0f;
 
     // Channel 0: Ethylene sensor
-    g_ethylene_ppm = Ethylene_CalculatePPM(voltage_ch0, g_sensor_r0);
+    if (g_sensor_r0 != ethylene_lut_r0) {
+        Ethylene_LUT_SetR0(g_sensor_r0);
+    }
+    g_ethylene_ppm = Ethylene_PPMFromCodeHR(adc_val_ch0, ADC_OVERSAMPLE_BITS);
 
     // Channel 1: Battery voltage (modify formula as needed)
     // Example: if using voltage divider, multiply by ratio
 		charge_fruit_equipment = voltage_ch1 * 11 / 7.4f * 100;
+
+    stats_push(STATS_CH_ETHYLENE, voltage_ch0);
+    stats_push(STATS_CH_BATTERY, charge_fruit_equipment);
     // Print results
-    my_printf(&huart6, "Vol:%.2fV, C2H4:%.2f PPM\r\n", voltage_ch0, g_ethylene_ppm);
-    my_printf(&huart6, "charge_voltage:%.2f%%\r\n", charge_fruit_equipment);
+    uplink_printf("Vol:%.2fV, C2H4:%.2f PPM\r\n", voltage_ch0, g_ethylene_ppm);
+    uplink_printf("charge_voltage:%.2f%%\r\n", charge_fruit_equipment);
 }
@@ -3,9 +3,30 @@
 
 #include "define.h"
 
+#define ADC_SAMPLE_RATE_HZ  250     // CH0 (ethylene) conversions per second, TIM2 TRGO; also the idle rate between bursts
+#ifndef ADC_OVERSAMPLE_BITS
+#define ADC_OVERSAMPLE_BITS 2       // CH0 extra bits from 4^k oversampling (0-4)
+#endif
+#define ADC_CH0_BITS        (12 + ADC_OVERSAMPLE_BITS)
+
 void adc_dma_init(void);//ʼ
 void adc_task(void);//
 float Ethylene_CalculatePPM(float voltage_v, float r0_kohm);
+void Ethylene_LUT_SetR0(float r0_kohm);
+float Ethylene_PPMFromCode(uint16_t code);
+float Ethylene_PPMFromCodeHR(uint32_t code, uint8_t frac_bits);
+uint16_t Ethylene_CodeFromPPM(float ppm);
+void adc_set_sample_rate(uint32_t rate_hz);
+uint32_t adc_get_sample_period_ticks(void);
+float adc_get_sample_rate_hz(void);
+uint16_t adc_ch0_pending(void);
+void adc_poll(void);//CH0 filter follows rate changes (call in scheduler)
+
+extern float g_sensor_r0;
+extern __IO uint32_t adc_val_ch0;
+extern __IO float voltage_ch0;
+extern float g_ethylene_ppm;
+extern float charge_fruit_equipment;
 
 extern DMA_HandleTypeDef hdma_adc1;
 extern ADC_HandleTypeDef hadc1;
@@ -0,0 +1,167 @@
+#include "asset_app.h"
+#include "flash_map.h"
+
+// Fonts and bitmaps from the MD25Q64 (format: Components/flash_asset)
+//
+// The image is built by tools/asset_pack and programmed at FLASH_ASSET_ADDR
+// with an SPI flash programmer. Glyphs go through a 64 slot RAM cache
+// (2.3 KB) shared by all fonts; a status screen redrawn every 100 ms reads
+// the flash only when a character appears for the first time.
+
+#define ASSET_CACHE_SLOTS   64u
+#define ASSET_FONTS         4u
+#define ASSET_OLED_WIDTH    128u
+
+static FlashAsset_Slot asset_slots[ASSET_CACHE_SLOTS];
+static FlashAsset assets;
+static FlashAsset_Font asset_fonts[ASSET_FONTS];
+static uint8_t asset_row[ASSET_OLED_WIDTH];
+
+// Opened on first use, kept open
+static FlashAsset_Font *asset_font(const char *name)
+{
+    uint8_t i;
+
+    for (i = 0; i < ASSET_FONTS; i++)
+    {
+        FlashAsset_Font *f = &asset_fonts[i];
+        if (f->assets != NULL &&
+            strncmp(assets.entries[f->entry].name, name, FLASHASSET_NAME_LEN) == 0)
+        {
+            return f;
+        }
+    }
+    for (i = 0; i < ASSET_FONTS; i++)
+    {
+        if (asset_fonts[i].assets == NULL)
+        {
+            return (FlashAsset_FontOpen(&assets, &asset_fonts[i], name) == FLASHASSET_OK) ?
+                   &asset_fonts[i] : NULL;
+        }
+    }
+    return NULL;
+}
+
+void asset_init(void)
+{
+    MD25Q64_Handle *flash = storage_get_flash();
+    FlashAsset_Status st;
+    uint32_t t0 = HAL_GetTick();
+
+    if (flash == NULL) return;
+
+    st = FlashAsset_Init(&assets, flash, FLASH_ASSET_ADDR, FLASH_ASSET_SIZE,
+                         asset_slots, ASSET_CACHE_SLOTS);
+    if (st == FLASHASSET_NO_IMAGE)
+    {
+        my_printf(&huart1, "asset: no image at 0x%06lX\r\n", (unsigned long)FLASH_ASSET_ADDR);
+        return;
+    }
+    if (st != FLASHASSET_OK)
+    {
+        my_printf(&huart1, "asset: image unreadable (%d)\r\n", st);
+        return;
+    }
+    my_printf(&huart1, "asset: %u entries, %lu bytes (%lu ms)\r\n",
+              assets.hdr.count, (unsigned long)assets.hdr.size,
+              (unsigned long)(HAL_GetTick() - t0));
+}
+
+uint8_t asset_text(uint8_t x, uint8_t y, const char *utf8, const char *font)
+{
+    FlashAsset_Font *f = asset_font(font);
+    uint32_t cps[FLASHASSET_BATCH];
+    const uint8_t *glyphs[FLASHASSET_BATCH];
+    uint8_t n, i;
+
+    if (f == NULL || utf8 == NULL) return x;
+
+    // One FlashAsset_Glyphs() per FLASHASSET_BATCH characters
+    while (*utf8 != '\0')
+    {
+        for (n = 0; n < FLASHASSET_BATCH && *utf8 != '\0'; n++)
+        {
+            cps[n] = FlashAsset_Utf8Next(&utf8);
+        }
+        if (FlashAsset_Glyphs(f, cps, n, glyphs) != FLASHASSET_OK) return x;
+
+        for (i = 0; i < n; i++)
+        {
+            if (x + f->width > ASSET_OLED_WIDTH) return x;
+            OLED_ShowPic(x, y, x + f->width, y + f->height / 8, (uint8_t *)glyphs[i]);
+            x += f->width;
+        }
+    }
+    return x;
+}
+
+uint8_t asset_bitmap(uint8_t x, uint8_t y, const char *name)
+{
+    const FlashAsset_Entry *e = FlashAsset_Find(&assets, name, FLASHASSET_BITMAP);
+    uint8_t page;
+
+    if (e == NULL || x + e->width > ASSET_OLED_WIDTH) return x;
+
+    // One page row at a time: width bytes each
+    for (page = 0; page < e->height / 8; page++)
+    {
+        if (FlashAsset_Read(&assets, e, page * (uint32_t)e->width, asset_row, e->width) != FLASHASSET_OK)
+        {
+            return x;
+        }
+        OLED_ShowPic(x, y + page, x + e->width, y + page + 1, asset_row);
+    }
+    return x + e->width;
+}
+
+void asset_cmd(int argc, char *argv[])
+{
+    const FlashAsset_Stats *s = &assets.stats;
+    uint16_t i;
+
+    if (!assets.ready)
+    {
+        my_printf(&huart1, "asset: no image\r\n");
+        return;
+    }
+
+    // asset verify: CRC over the whole image
+    if (argc > 1 && strcmp(argv[1], "verify") == 0)
+    {
+        uint32_t t0 = HAL_GetTick();
+        FlashAsset_Status st = FlashAsset_Verify(&assets);
+        my_printf(&huart1, "asset: data %s (%lu ms)\r\n",
+                  (st == FLASHASSET_OK) ? "ok" : "CRC mismatch",
+                  (unsigned long)(HAL_GetTick() - t0));
+        return;
+    }
+    // asset text <font> <words...>: draw on the OLED, page 0
+    if (argc > 3 && strcmp(argv[1], "text") == 0)
+    {
+        uint8_t x = 0;
+        for (int a = 3; a < argc; a++)
+        {
+            x = asset_text(x, 0, argv[a], argv[2]);
+            if (a + 1 < argc) x = asset_text(x, 0, " ", argv[2]);
+        }
+        if (x == 0) my_printf(&huart1, "asset: no font %s\r\n", argv[2]);
+    }
+    // asset show <bitmap>
+    if (argc > 2 && strcmp(argv[1], "show") == 0)
+    {
+        if (asset_bitmap(0, 0, argv[2]) == 0) my_printf(&huart1, "asset: no bitmap %s\r\n", argv[2]);
+    }
+
+    for (i = 0; i < assets.hdr.count; i++)
+    {
+        const FlashAsset_Entry *e = &assets.entries[i];
+        my_printf(&huart1, "%-8.8s %-6s %3ux%-3u %7lu bytes\r\n", e->name,
+                  (e->type == FLASHASSET_FONT) ? "font" : "bitmap",
+                  e->width, e->height, (unsigned long)e->size);
+    }
+    my_printf(&huart1, "cache    %u slots, %lu lookups, %lu hits (%lu%%)\r\n",
+              ASSET_CACHE_SLOTS, (unsigned long)s->lookups, (unsigned long)s->hits,
+              s->lookups ? (unsigned long)((uint64_t)s->hits * 100u / s->lookups) : 0ul);
+    my_printf(&huart1, "reads    %lu (%lu bytes, %lu misses)\r\n",
+              (unsigned long)s->reads, (unsigned long)s->read_bytes, (unsigned long)s->misses);
+}
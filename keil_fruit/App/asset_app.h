@@ -0,0 +1,20 @@
+#ifndef ASSET_APP_H
+#define ASSET_APP_H
+
+#include "define.h"
+#include "flash_asset.h"
+
+// Open the font/bitmap image on the sample flash (after storage_init)
+void asset_init(void);
+
+// UTF-8 text in a flash font at column x, page y; returns the next column.
+// Characters past the right edge are dropped.
+uint8_t asset_text(uint8_t x, uint8_t y, const char *utf8, const char *font);
+
+// Flash bitmap at column x, page y
+uint8_t asset_bitmap(uint8_t x, uint8_t y, const char *name);
+
+// Console: "asset"
+void asset_cmd(int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,234 @@
+#include "boot_app.h"
+#include "flash_map.h"
+
+// Boot timing and flash self-check
+//
+// main() marks the end of each init step; step times come from the DWT
+// cycle counter, so sub-millisecond steps still show. HAL_Init and the
+// clock setup run before the counter is started and are reported in ticks.
+//
+// The self-check replaces MD25Q64_Test_RunAll() at boot, which erased and
+// rewrote the test sector on every power cycle and took seconds of UART
+// output. It sends read commands only (JEDEC ID, status registers, the
+// signature page) and finishes well under a millisecond. It runs before
+// anything mounts: mounting a log writes sector headers, so a chip that
+// answers wrongly or carries another firmware's flash map is left as it
+// is. Signing is "boot sign" only. The full suite is the "flashtest"
+// command, or BOOT_FLASH_TEST for a bring-up build.
+
+// Signature page contents: the map this firmware was built with
+typedef struct
+{
+    uint32_t magic;             // FLASH_SIG_MAGIC
+    uint32_t version;           // FLASH_SIG_VERSION
+    uint32_t map[10];           // address/size of each flash_map.h region
+} boot_sig_t;
+
+typedef struct
+{
+    const char *name;
+    uint32_t cycles;
+} boot_step_t;
+
+typedef enum
+{
+    BOOT_SIG_UNCHECKED = 0,
+    BOOT_SIG_OK,
+    BOOT_SIG_BLANK,             // new chip, not signed yet
+    BOOT_SIG_MISMATCH,          // other magic, version or map
+    BOOT_SIG_READ_ERROR
+} boot_sig_state_t;
+
+static const char *const boot_sig_text[] =
+{
+    "not checked", "ok", "blank ('boot sign' writes it)",
+    "differs ('boot sign' rewrites it)", "read error"
+};
+
+static boot_step_t boot_steps[BOOT_STEPS_MAX];
+static uint8_t boot_step_count = 0;
+static uint32_t boot_pre_ms = 0;        // HAL_Init + SystemClock_Config
+static uint32_t boot_last = 0;          // CYCCNT at the previous mark
+
+static uint8_t boot_checked = 0;
+static MD25Q64_Status boot_chip = MD25Q64_ERROR;
+static MD25Q64_Info boot_chip_info;
+static boot_sig_state_t boot_sig = BOOT_SIG_UNCHECKED;
+static uint32_t boot_check_cycles = 0;
+
+static void boot_sig_fill(boot_sig_t *s)
+{
+    memset(s, 0, sizeof(*s));
+    s->magic   = FLASH_SIG_MAGIC;
+    s->version = FLASH_SIG_VERSION;
+    s->map[0]  = FLASH_SYS_ADDR;
+    s->map[1]  = FLASH_SYS_SIZE;
+    s->map[2]  = FLASH_TEST_ADDR;
+    s->map[3]  = FLASH_TEST_SIZE;
+    s->map[4]  = FLASH_UPLINK_ADDR;
+    s->map[5]  = FLASH_UPLINK_SIZE;
+    s->map[6]  = FLASH_ASSET_ADDR;
+    s->map[7]  = FLASH_ASSET_SIZE;
+    s->map[8]  = FLASH_LOG_ADDR;
+    s->map[9]  = FLASH_LOG_SIZE;
+}
+
+static uint8_t boot_is_blank(const uint8_t *p, uint32_t len)
+{
+    while (len--)
+    {
+        if (*p++ != 0xFF) return 0;
+    }
+    return 1;
+}
+
+static uint32_t boot_cycles_to_us(uint32_t cycles)
+{
+    return cycles / (SystemCoreClock / 1000000u);
+}
+
+void boot_time_start(void)
+{
+    boot_pre_ms = HAL_GetTick();
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    boot_last = DWT->CYCCNT;
+}
+
+void boot_time_mark(const char *name)
+{
+    uint32_t now = DWT->CYCCNT;
+
+    if (boot_step_count < BOOT_STEPS_MAX)
+    {
+        boot_steps[boot_step_count].name = name;
+        boot_steps[boot_step_count].cycles = now - boot_last;
+        boot_step_count++;
+    }
+    boot_last = now;
+}
+
+void boot_selfcheck(void)
+{
+    MD25Q64_Handle *flash = storage_get_flash();
+    boot_sig_t expect, found;
+    uint32_t t0;
+
+    if (flash == NULL) return;      // storage_init has reported it
+
+    boot_checked = 1;
+    boot_sig_fill(&expect);
+
+    t0 = DWT->CYCCNT;
+    boot_chip = MD25Q64_SelfCheck(flash, &boot_chip_info);
+    if (boot_chip == MD25Q64_OK)
+    {
+        if (MD25Q64_Read(flash, FLASH_SIG_ADDR, (uint8_t *)&found, sizeof(found)) != MD25Q64_OK)
+            boot_sig = BOOT_SIG_READ_ERROR;
+        else if (memcmp(&found, &expect, sizeof(found)) == 0)
+            boot_sig = BOOT_SIG_OK;
+        else if (boot_is_blank((const uint8_t *)&found, sizeof(found)))
+            boot_sig = BOOT_SIG_BLANK;
+        else
+            boot_sig = BOOT_SIG_MISMATCH;
+    }
+    boot_check_cycles = DWT->CYCCNT - t0;
+}
+
+uint8_t boot_flash_writable(void)
+{
+    return boot_chip == MD25Q64_OK && (boot_sig == BOOT_SIG_OK || boot_sig == BOOT_SIG_BLANK);
+}
+
+void boot_report(void)
+{
+    uint32_t total = 0;
+
+    my_printf(&huart1, "boot     %lu ms HAL_Init + clock, then:\r\n", (unsigned long)boot_pre_ms);
+    for (uint8_t i = 0; i < boot_step_count; i++)
+    {
+        my_printf(&huart1, "  %-12s %8lu us\r\n", boot_steps[i].name,
+                  (unsigned long)boot_cycles_to_us(boot_steps[i].cycles));
+        total += boot_steps[i].cycles;
+    }
+    my_printf(&huart1, "  %-12s %8lu us\r\n", "total", (unsigned long)boot_cycles_to_us(total));
+
+    if (!boot_checked)
+    {
+        my_printf(&huart1, "flash    not checked (no flash)\r\n");
+        return;
+    }
+    my_printf(&huart1, "flash    %s, JEDEC %06lX, SR %02X %02X %02X, signature %s (%lu us)\r\n",
+              boot_chip == MD25Q64_OK              ? "ok" :
+              boot_chip == MD25Q64_BUSY            ? "busy after reset" :
+              boot_chip == MD25Q64_WRITE_PROTECTED ? "write protected" : "wrong ID or no reply",
+              (unsigned long)boot_chip_info.jedec_id, boot_chip_info.sr1,
+              boot_chip_info.sr2, boot_chip_info.sr3, boot_sig_text[boot_sig],
+              (unsigned long)boot_cycles_to_us(boot_check_cycles));
+    if (storage_get_log() == NULL)
+    {
+        my_printf(&huart1, "flash    sample log and uplink queue not mounted%s\r\n",
+                  boot_flash_writable() ? " (reset to mount)" : " (left untouched, fix and reset)");
+    }
+}
+
+void boot_cmd(int argc, char *argv[])
+{
+    // boot sign: rewrite the signature for this firmware's flash map
+    if (argc > 1 && strcmp(argv[1], "sign") == 0)
+    {
+        MD25Q64_Handle *flash = storage_get_flash();
+        boot_sig_t sig;
+
+        if (flash == NULL)
+        {
+            my_printf(&huart1, "boot: no flash\r\n");
+            return;
+        }
+        boot_sig_fill(&sig);
+        if (MD25Q64_EraseSector(flash, FLASH_SIG_ADDR) != MD25Q64_OK ||
+            MD25Q64_Write(flash, FLASH_SIG_ADDR, (const uint8_t *)&sig, sizeof(sig)) != MD25Q64_OK)
+        {
+            my_printf(&huart1, "boot: signature write failed\r\n");
+            return;
+        }
+        boot_sig = BOOT_SIG_OK;
+    }
+    boot_report();
+}
+
+void flashtest_cmd(int argc, char *argv[])
+{
+    MD25Q64_Handle *flash = storage_get_flash();
+
+    // The suite drives the chip through its own handle: let the sample log
+    // finish its buffered programs and queued erases first
+    if (flash != NULL)
+    {
+        storage_flush();
+        while (!MD25Q64_IsIdle(flash))
+        {
+            MD25Q64_Poll(flash);
+        }
+    }
+
+    // flashtest bench [trials]: latency/throughput sweep as CSV
+    if (argc > 1 && strcmp(argv[1], "bench") == 0)
+    {
+        int trials = (argc > 2) ? atoi(argv[2]) : BOOT_BENCH_TRIALS;
+
+        if (trials < 1 || trials > MD25Q64_BENCH_TRIALS_MAX)
+        {
+            my_printf(&huart1, "flashtest: trials 1..%u\r\n", MD25Q64_BENCH_TRIALS_MAX);
+            return;
+        }
+        MD25Q64_Test_Bench((uint8_t)trials);
+    }
+    else
+    {
+        MD25Q64_Test_RunAll();
+    }
+
+    // Written behind the sample flash handle's back: drop its cached lines
+    if (flash != NULL) MD25Q64_Cache_Invalidate(flash->cache, 0, MD25Q64_FLASH_SIZE);
+}
@@ -0,0 +1,34 @@
+#ifndef BOOT_APP_H
+#define BOOT_APP_H
+
+#include "define.h"
+
+#define BOOT_STEPS_MAX      16      // init steps timed by boot_time_mark()
+#define BOOT_FLASH_TEST     0       // 1: run the full MD25Q64 test suite at boot
+                                    //    (erases the test region, takes seconds)
+#define BOOT_BENCH_TRIALS   15      // "flashtest bench" runs per point
+
+// Start the boot clock (after SystemClock_Config)
+void boot_time_start(void);
+
+// End of one init step; name must be a string literal
+void boot_time_mark(const char *name);
+
+// Read-only flash check: JEDEC ID, status registers, signature page
+// (after storage_init, before anything mounts)
+void boot_selfcheck(void);
+
+// The self-check passed (signature ours or blank): mounting may write
+uint8_t boot_flash_writable(void);
+
+// Print the init step times and the self-check result
+void boot_report(void);
+
+// Console: "boot [sign]"
+void boot_cmd(int argc, char *argv[]);
+
+// Console: "flashtest [bench [trials]]" runs the full MD25Q64 test suite,
+// or the benchmark sweep with CSV output
+void flashtest_cmd(int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,290 @@
+#include "burst_app.h"
+
+// Ethylene burst capture
+//
+// CH0 runs at ADC_SAMPLE_RATE_HZ. The ADC1 analog watchdog watches it for
+// a code above the one matching BURST_TRIGGER_PPM. Its interrupt freezes
+// the pre-trigger history into a free capture slot and raises the TIM2
+// rate to BURST_RATE_HZ; the DMA block callback then fills the window and
+// restores ADC_SAMPLE_RATE_HZ. The watchdog is re-armed from burst_task once
+// CH0 has dropped back under the threshold, so a sustained high level
+// gives one capture.
+//
+// A rate switch happens mid-block: conversions already in the DMA ring
+// were taken at the old rate. At the trigger they finish the pre-trigger
+// segment; after the window they are kept out of the history.
+//
+// burst_task appends each capture to the sample log a few records per run
+// and sends the BURST summary line once it is stored; only then is the
+// slot released.
+
+typedef enum
+{
+    BURST_IDLE = 0,
+    BURST_CAPTURING
+} burst_state_t;
+
+static burst_capture_t burst_slots[BURST_SLOTS];
+static __IO uint8_t burst_head = 0;        // next slot to fill (ISR)
+static __IO uint8_t burst_tail = 0;        // oldest queued slot (task)
+static __IO burst_state_t burst_state = BURST_IDLE;
+static __IO uint8_t burst_armed = 0;
+static uint32_t burst_dropped = 0;
+
+static int16_t burst_hist[BURST_PRE_SAMPLES];
+static uint16_t burst_hist_idx = 0;
+static uint16_t burst_hist_count = 0;
+static uint16_t burst_pre_left = 0;     // trigger-time conversions still to come
+static uint16_t burst_hist_skip = 0;    // window-rate conversions after a capture
+
+// Storage of the oldest queued capture (task side)
+static uint16_t burst_store_pos = 0;    // samples stored
+static uint8_t burst_store_started = 0; // head record written
+static uint16_t burst_store_id = 0;
+static uint32_t burst_stored = 0;
+static uint32_t burst_store_failed = 0;
+
+static float burst_trigger_ppm = BURST_TRIGGER_PPM;
+static float burst_trigger_r0 = -1.0f;
+static uint16_t burst_trigger_code = 4095;
+
+static uint8_t burst_queue_len(void)
+{
+    return (uint8_t)(burst_head - burst_tail);
+}
+
+static void burst_update_threshold(void)
+{
+    burst_trigger_r0 = g_sensor_r0;
+    burst_trigger_code = Ethylene_CodeFromPPM(burst_trigger_ppm);
+    hadc1.Instance->HTR = burst_trigger_code;
+}
+
+void burst_init(void)
+{
+    ADC_AnalogWDGConfTypeDef awd = {0};
+
+    awd.WatchdogMode = ADC_ANALOGWATCHDOG_SINGLE_REG;
+    awd.Channel = ADC_CHANNEL_0;
+    awd.HighThreshold = 4095;
+    awd.LowThreshold = 0;
+    awd.ITMode = DISABLE;           // armed by burst_task
+    HAL_ADC_AnalogWDGConfig(&hadc1, &awd);
+
+    burst_update_threshold();
+}
+
+void burst_set_trigger_ppm(float ppm)
+{
+    burst_trigger_ppm = ppm;
+    burst_update_threshold();
+}
+
+float burst_get_trigger_ppm(void)
+{
+    return burst_trigger_ppm;
+}
+
+void HAL_ADC_LevelOutOfWindowCallback(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->Instance != ADC1) return;
+
+    __HAL_ADC_DISABLE_IT(hadc, ADC_IT_AWD);
+    burst_armed = 0;
+
+    if (burst_state != BURST_IDLE || burst_queue_len() >= BURST_SLOTS)
+    {
+        burst_dropped++;
+        return;
+    }
+
+    burst_capture_t *slot = &burst_slots[burst_head % BURST_SLOTS];
+
+    // Conversions still in the DMA ring (less any left from the last
+    // window) close the pre-trigger segment when their block arrives;
+    // the history gives up as many of its oldest samples
+    burst_pre_left = (uint16_t)(adc_ch0_pending() - burst_hist_skip);
+    uint16_t keep = burst_hist_count;
+    if (keep > BURST_PRE_SAMPLES - burst_pre_left) {
+        keep = (uint16_t)(BURST_PRE_SAMPLES - burst_pre_left);
+    }
+    uint16_t start = (uint16_t)((burst_hist_idx + BURST_PRE_SAMPLES - keep) % BURST_PRE_SAMPLES);
+
+    // History ring, oldest first
+    for (uint16_t i = 0; i < keep; i++)
+    {
+        slot->samples[i] = burst_hist[(start + i) % BURST_PRE_SAMPLES];
+    }
+    slot->pre_count = keep;
+    slot->pre_rate_hz = (uint16_t)(adc_get_sample_rate_hz() + 0.5f);
+    slot->tick = HAL_GetTick();
+    slot->trigger_code = burst_trigger_code;
+    slot->count = 0;
+    slot->peak = 0;
+
+    adc_set_sample_rate(BURST_RATE_HZ);
+    slot->rate_hz = (uint16_t)(adc_get_sample_rate_hz() + 0.5f);
+    burst_state = BURST_CAPTURING;
+}
+
+void burst_on_block(const int16_t *samples, uint16_t n)
+{
+    uint16_t i = 0;
+
+    // Taken at the window rate after the last capture ended
+    for (; i < n && burst_hist_skip > 0; i++) {
+        burst_hist_skip--;
+    }
+
+    if (burst_state == BURST_IDLE)
+    {
+        for (; i < n; i++)
+        {
+            burst_hist[burst_hist_idx] = samples[i];
+            burst_hist_idx = (uint16_t)((burst_hist_idx + 1) % BURST_PRE_SAMPLES);
+            if (burst_hist_count < BURST_PRE_SAMPLES) {
+                burst_hist_count++;
+            }
+        }
+        return;
+    }
+
+    burst_capture_t *slot = &burst_slots[burst_head % BURST_SLOTS];
+
+    // Converted before the trigger, at the pre-trigger rate
+    for (; i < n && burst_pre_left > 0; i++, burst_pre_left--)
+    {
+        slot->samples[slot->pre_count++] = samples[i];
+    }
+
+    int16_t *dst = &slot->samples[slot->pre_count];
+
+    for (; i < n && slot->count < BURST_SAMPLES; i++)
+    {
+        dst[slot->count++] = samples[i];
+        if (samples[i] > (int16_t)slot->peak) {
+            slot->peak = (uint16_t)samples[i];
+        }
+    }
+
+    if (slot->count >= BURST_SAMPLES)
+    {
+        burst_hist_skip = adc_ch0_pending();
+        adc_set_sample_rate(ADC_SAMPLE_RATE_HZ);
+        burst_hist_count = 0;       // history restarts at the idle rate
+        burst_head++;
+        burst_state = BURST_IDLE;
+    }
+}
+
+const burst_capture_t *burst_peek(void)
+{
+    if (burst_queue_len() == 0) return NULL;
+    return &burst_slots[burst_tail % BURST_SLOTS];
+}
+
+void burst_release(void)
+{
+    if (burst_queue_len() == 0) return;
+    burst_tail++;
+}
+
+// Append the next records of capture b to the sample log; 1 once it is
+// all stored, or given up because the log is not there or failed
+static uint8_t burst_store(const burst_capture_t *b)
+{
+    static burst_rec_data_t rec;    // 252 B, keep it off the stack
+    uint16_t total = (uint16_t)(b->pre_count + b->count);
+
+    memset(&rec.hdr, 0, sizeof(rec.hdr));
+    rec.hdr.timestamp = rtc_get_timestamp();
+    rec.hdr.magic = BURST_REC_MAGIC;
+    rec.hdr.id = burst_store_id;
+
+    if (!burst_store_started)
+    {
+        burst_rec_head_t head;
+
+        head.hdr = rec.hdr;
+        head.hdr.kind = BURST_REC_HEAD;
+        head.tick = b->tick;
+        head.trigger_code = b->trigger_code;
+        head.pre_rate_hz = b->pre_rate_hz;
+        head.rate_hz = b->rate_hz;
+        head.pre_count = b->pre_count;
+        head.count = b->count;
+        head.peak = b->peak;
+        if (!storage_append(&head, sizeof(head)))
+        {
+            burst_store_failed++;
+            return 1;
+        }
+        burst_store_started = 1;
+        burst_store_pos = 0;
+    }
+
+    rec.hdr.kind = BURST_REC_DATA;
+    for (uint8_t r = 0; r < BURST_STORE_BATCH && burst_store_pos < total; r++)
+    {
+        uint16_t n = (uint16_t)(total - burst_store_pos);
+        if (n > BURST_REC_SAMPLES) n = BURST_REC_SAMPLES;
+
+        rec.hdr.first = burst_store_pos;
+        memset(rec.samples, 0, sizeof(rec.samples));
+        memcpy(rec.samples, &b->samples[burst_store_pos], n * sizeof(int16_t));
+        if (!storage_append(&rec, sizeof(rec)))
+        {
+            burst_store_failed++;
+            return 1;
+        }
+        burst_store_pos = (uint16_t)(burst_store_pos + n);
+    }
+    if (burst_store_pos < total) return 0;
+
+    burst_stored++;
+    return 1;
+}
+
+void burst_task(void)
+{
+    const burst_capture_t *b;
+
+    if (g_sensor_r0 != burst_trigger_r0) {
+        burst_update_threshold();
+    }
+
+    // Re-arm once CH0 is back under the threshold
+    if (!burst_armed && burst_state == BURST_IDLE &&
+        (adc_val_ch0 >> ADC_OVERSAMPLE_BITS) < burst_trigger_code)
+    {
+        __HAL_ADC_CLEAR_FLAG(&hadc1, ADC_FLAG_AWD);
+        burst_armed = 1;
+        __HAL_ADC_ENABLE_IT(&hadc1, ADC_IT_AWD);
+    }
+
+    // Oldest capture to the sample log; the slot is freed once it is stored
+    if ((b = burst_peek()) != NULL && burst_store(b))
+    {
+        uplink_printf("BURST,%lu,%u,%u,%u,%u,%u\r\n",
+                  (unsigned long)b->tick, b->pre_count, b->pre_rate_hz,
+                  b->count, b->rate_hz, b->peak);
+        burst_store_started = 0;
+        burst_store_id++;
+        burst_release();
+    }
+}
+
+void burst_cmd(int argc, char *argv[])
+{
+    if (argc > 1)
+    {
+        burst_set_trigger_ppm((float)atof(argv[1]));
+    }
+    my_printf(&huart1, "burst: trigger %.2f ppm (code %u), %s, %s, queued %u, dropped %lu\r\n",
+              burst_trigger_ppm, burst_trigger_code,
+              burst_armed ? "armed" : "disarmed",
+              burst_state == BURST_CAPTURING ? "capturing" : "idle",
+              burst_queue_len(), (unsigned long)burst_dropped);
+    my_printf(&huart1, "burst: %lu stored in the log, %lu not stored\r\n",
+              (unsigned long)burst_stored, (unsigned long)burst_store_failed);
+}
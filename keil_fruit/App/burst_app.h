@@ -0,0 +1,79 @@
+#ifndef BURST_APP_H
+#define BURST_APP_H
+
+#include "define.h"
+
+#define BURST_TRIGGER_PPM   3.0f    // default watchdog level on CH0 (ethylene)
+#define BURST_RATE_HZ       1000    // CH0 rate while capturing
+#define BURST_PRE_SAMPLES   256     // pre-trigger history, at ADC_SAMPLE_RATE_HZ
+#define BURST_SAMPLES       3000    // capture window (3 s at BURST_RATE_HZ)
+#define BURST_SLOTS         2       // captures queued for storage/uplink
+
+// One captured burst: pre-trigger history followed by the window
+typedef struct
+{
+    uint32_t tick;              // HAL_GetTick() at trigger
+    uint16_t trigger_code;      // watchdog threshold (12-bit code)
+    uint16_t pre_rate_hz;       // rate of samples[0 .. pre_count-1]
+    uint16_t rate_hz;           // rate of the window samples
+    uint16_t pre_count;         // incl. conversions in the DMA ring at the trigger
+    uint16_t count;             // window samples
+    uint16_t peak;              // highest code in the window
+    int16_t  samples[BURST_PRE_SAMPLES + BURST_SAMPLES];
+} burst_capture_t;
+
+// Captures in the sample log (storage_append): one head record, then the
+// samples in fixed-size data records. Both start with the header below,
+// whose timestamp comes first like storage_sample_t's.
+#define BURST_REC_MAGIC     0x5242u // "BR"
+#define BURST_REC_HEAD      0u
+#define BURST_REC_DATA      1u
+#define BURST_REC_SAMPLES   120     // per data record, zero-padded at the end
+#define BURST_STORE_BATCH   4       // records appended per burst_task run
+
+typedef struct
+{
+    uint32_t timestamp;         // rtc_get_timestamp() when stored
+    uint16_t magic;             // BURST_REC_MAGIC
+    uint8_t  kind;              // BURST_REC_HEAD / BURST_REC_DATA
+    uint8_t  reserved;
+    uint16_t id;                // capture number, same in head and data records
+    uint16_t first;             // data: index of samples[0] in the capture
+} burst_rec_hdr_t;
+
+typedef struct
+{
+    burst_rec_hdr_t hdr;
+    uint32_t tick;              // the burst_capture_t fields
+    uint16_t trigger_code;
+    uint16_t pre_rate_hz;
+    uint16_t rate_hz;
+    uint16_t pre_count;
+    uint16_t count;
+    uint16_t peak;
+} burst_rec_head_t;             // 28 bytes
+
+typedef struct
+{
+    burst_rec_hdr_t hdr;
+    int16_t samples[BURST_REC_SAMPLES];
+} burst_rec_data_t;             // 252 bytes
+
+void burst_init(void);
+void burst_set_trigger_ppm(float ppm);
+float burst_get_trigger_ppm(void);
+
+// CH0 raw samples from the ADC DMA callback
+void burst_on_block(const int16_t *samples, uint16_t n);
+
+// Capture queue: oldest completed burst, NULL if none
+const burst_capture_t *burst_peek(void);
+void burst_release(void);
+
+// Re-arm, store queued captures and report them (call in scheduler)
+void burst_task(void);
+
+// Console: "burst [ppm]"
+void burst_cmd(int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,86 @@
+#include "console_app.h"
+
+// Debug console on USART1: one command per line, space separated
+
+typedef struct {
+    const char *name;
+    void (*handler)(int argc, char *argv[]);
+    const char *help;
+} console_cmd_t;
+
+static void console_help(int argc, char *argv[]);
+
+static const console_cmd_t console_cmds[] =
+{
+    {"help",  console_help, "list commands"},
+    {"stats", stats_cmd,    "sensor statistics [reset]"},
+    {"burst", burst_cmd,    "burst capture state [trigger ppm]"},
+    {"log",   storage_cmd,  "sample log state [ahead n | flush | pack n | last s | range t0 t1]"},
+    {"dump",  dump_cmd,     "binary bulk dump to host [stats]"},
+    {"uplink", uplink_cmd,  "4G uplink queue state [save]"},
+    {"oled",  oled_cmd,     "OLED frames and I2C writes, bench"},
+    {"asset", asset_cmd,    "flash fonts/bitmaps [verify | text font s | show name]"},
+    {"boot",  boot_cmd,     "boot step times, flash self-check [sign]"},
+    {"flashtest", flashtest_cmd, "MD25Q64 test suite [bench [trials]] (erases test region)"}
+};
+
+#define CONSOLE_CMD_NUM     (sizeof(console_cmds) / sizeof(console_cmds[0]))
+
+static char console_line[CONSOLE_LINE_MAX];
+static uint8_t console_len = 0;
+
+static void console_help(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+    for (uint8_t i = 0; i < CONSOLE_CMD_NUM; i++)
+    {
+        my_printf(&huart1, "  %-8s %s\r\n", console_cmds[i].name, console_cmds[i].help);
+    }
+}
+
+static void console_execute(char *line)
+{
+    char *argv[CONSOLE_ARGS_MAX];
+    int argc = 0;
+    char *p = line;
+
+    while (*p != '\0' && argc < CONSOLE_ARGS_MAX)
+    {
+        while (*p == ' ') p++;
+        if (*p == '\0') break;
+        argv[argc++] = p;
+        while (*p != '\0' && *p != ' ') p++;
+        if (*p == ' ') *p++ = '\0';
+    }
+    if (argc == 0) return;
+
+    for (uint8_t i = 0; i < CONSOLE_CMD_NUM; i++)
+    {
+        if (strcmp(argv[0], console_cmds[i].name) == 0)
+        {
+            console_cmds[i].handler(argc, argv);
+            return;
+        }
+    }
+    my_printf(&huart1, "unknown command: %s (try help)\r\n", argv[0]);
+}
+
+void console_input(const uint8_t *buf, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        char c = (char)buf[i];
+
+        if (c == '\r' || c == '\n')
+        {
+            console_line[console_len] = '\0';
+            console_len = 0;
+            console_execute(console_line);
+        }
+        else if (console_len < CONSOLE_LINE_MAX - 1)
+        {
+            console_line[console_len++] = c;
+        }
+    }
+}
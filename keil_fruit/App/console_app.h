@@ -0,0 +1,12 @@
+#ifndef CONSOLE_APP_H
+#define CONSOLE_APP_H
+
+#include "define.h"
+
+#define CONSOLE_LINE_MAX    64      // longest command line
+#define CONSOLE_ARGS_MAX    8       // tokens per line, command included
+
+// Feed received debug-UART bytes; complete lines are dispatched
+void console_input(const uint8_t *buf, uint16_t len);
+
+#endif
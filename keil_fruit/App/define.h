@@ -2,6 +2,7 @@
 #include "math.h"
 
 #include "stdio.h"
+#include "stdlib.h"
 #include "string.h"
 #include "stdarg.h"
 
@@ -10,12 +11,24 @@
 #include "oled_app.h"
 #include "oled_font.h"
 #include "oled.h"
+#include "oled_text.h"
 #include "adc_app.h"
 #include "rtc_app.h"
 #include "led_app.h"
 #include "md25q64_test.h"
+#include "md25q64_bench.h"
 #include "md25q64.h"
+#include "dsp_filter.h"
+#include "flash_log.h"
 #include "key_app.h"
+#include "stats_app.h"
+#include "burst_app.h"
+#include "storage_app.h"
+#include "console_app.h"
+#include "dump_app.h"
+#include "uplink_app.h"
+#include "asset_app.h"
+#include "boot_app.h"
 
 extern DMA_HandleTypeDef hdma_usart1_rx;
 extern UART_HandleTypeDef huart1;
@@ -0,0 +1,242 @@
+#include "dump_app.h"
+
+// Bulk dump over USART1 (protocol: Components/bulk_dump)
+//
+// "dump" on the console switches USART1 to binary frames until the host
+// says BYE or goes quiet for BULKDUMP_IDLE_MS. Address requests read the
+// flash with SPI2 DMA straight into the frame buffer; timestamp requests
+// walk the sample log and pack whole records as [u16 len][record]. Frames
+// go out with USART1 TX DMA, so the CPU only builds headers and CRCs.
+// The host side is tools/dump_recv.
+
+#define DUMP_SNAPS      (BULKDUMP_WINDOW + 1)  // iterator per block in the window
+
+static BulkDump dump;
+
+static uint8_t dump_mode;
+static uint32_t dump_start, dump_end;
+
+// Address mode: one async fast read per block
+static volatile uint8_t dump_read_done;
+static volatile MD25Q64_Status dump_read_status;
+static uint8_t *dump_read_buf;
+static uint32_t dump_read_addr;
+static int32_t dump_read_len;
+
+// Timestamp mode: log position at the start of each block in the window
+static FlashLog_Iter dump_it;
+static FlashLog_Iter dump_snaps[DUMP_SNAPS];
+static uint32_t dump_it_seq;
+static uint8_t dump_rec[FLASHLOG_MAX_RECORD];
+
+static void dump_read_cb(MD25Q64_Handle *h, MD25Q64_Status status, void *ctx)
+{
+    (void)h;
+    (void)ctx;
+    dump_read_status = status;
+    dump_read_done = 1;
+}
+
+static uint8_t dump_flash_read(void)
+{
+    dump_read_done = 0;
+    if (MD25Q64_FastRead_Start(storage_get_flash(), dump_read_addr, dump_read_buf,
+                               (uint32_t)dump_read_len, dump_read_cb, NULL) != MD25Q64_OK)
+    {
+        dump_read_done = 1;     // queue full: dump_read_poll tries again
+        dump_read_status = MD25Q64_BUSY;
+        return 0;
+    }
+    return 1;
+}
+
+// Records are storage_sample_t: the timestamp is the first word
+static uint32_t dump_rec_ts(void)
+{
+    uint32_t ts;
+    memcpy(&ts, dump_rec, sizeof(ts));
+    return ts;
+}
+
+static uint8_t dump_open(void *ctx, uint8_t mode, uint32_t start, uint32_t end)
+{
+    FlashLog *log = storage_get_log();
+    FlashLog_Query q;
+    FlashLog_Iter saved;
+    uint16_t len;
+
+    (void)ctx;
+    if (log == NULL) return 0;
+
+    // Buffered records go to flash first so both modes see them
+    storage_flush();
+
+    if (mode == BULKDUMP_MODE_ADDR)
+    {
+        if (start >= end || end > MD25Q64_FLASH_SIZE) return 0;
+    }
+    else
+    {
+        if (start > end) return 0;
+
+        // The span index picks the sector holding start, so the skip below
+        // reads one sector or so, not the whole log from the tail
+        if (FlashLog_QueryInit(log, &q, start, UINT32_MAX) == FLASHLOG_OK)
+        {
+            dump_it = q.it;
+        }
+        else
+        {
+            FlashLog_IterInit(log, &dump_it);   // no index: scan from the tail
+        }
+
+        // Skip to the first record at or after start
+        for (;;)
+        {
+            saved = dump_it;
+            if (FlashLog_IterNext(&dump_it, dump_rec, sizeof(dump_rec), &len) != FLASHLOG_OK) break;
+            if (len >= sizeof(uint32_t) && dump_rec_ts() >= start)
+            {
+                dump_it = saved;
+                break;
+            }
+        }
+        dump_it_seq = 0;
+        dump_snaps[0] = dump_it;
+    }
+
+    dump_mode = mode;
+    dump_start = start;
+    dump_end = end;
+    return 1;
+}
+
+static uint8_t dump_read_start(void *ctx, uint32_t seq, uint8_t *buf, uint16_t max)
+{
+    FlashLog_Iter saved;
+    uint16_t len, n = 0;
+
+    (void)ctx;
+    dump_read_buf = buf;
+
+    if (dump_mode == BULKDUMP_MODE_ADDR)
+    {
+        uint32_t addr = dump_start + seq * (uint32_t)max;
+
+        dump_read_addr = addr;
+        dump_read_len = (addr >= dump_end) ? 0 : (int32_t)((dump_end - addr < max) ? dump_end - addr : max);
+        if (dump_read_len == 0)
+        {
+            dump_read_done = 1;
+            dump_read_status = MD25Q64_OK;
+            return 1;
+        }
+        return dump_flash_read();
+    }
+
+    // Rewound: continue from the block's saved position
+    if (seq != dump_it_seq)
+    {
+        dump_it = dump_snaps[seq % DUMP_SNAPS];
+    }
+    dump_snaps[seq % DUMP_SNAPS] = dump_it;
+
+    for (;;)
+    {
+        saved = dump_it;
+        if (FlashLog_IterNext(&dump_it, dump_rec, sizeof(dump_rec), &len) != FLASHLOG_OK) break;
+        if (len >= sizeof(uint32_t) && dump_rec_ts() > dump_end) { dump_it = saved; break; }
+        if (n + 2u + len > max) { dump_it = saved; break; }
+        buf[n] = (uint8_t)len;
+        buf[n + 1] = (uint8_t)(len >> 8);
+        memcpy(&buf[n + 2], dump_rec, len);
+        n += 2u + len;
+    }
+
+    dump_it_seq = seq + 1u;
+    dump_snaps[dump_it_seq % DUMP_SNAPS] = dump_it;
+    dump_read_len = n;
+    dump_read_done = 1;
+    dump_read_status = MD25Q64_OK;
+    return 1;
+}
+
+static int32_t dump_read_poll(void *ctx)
+{
+    (void)ctx;
+    if (!dump_read_done) return -1;
+
+    // A failed (or not queued) SPI read is issued again, never sent as data
+    if (dump_read_status != MD25Q64_OK)
+    {
+        dump_flash_read();
+        return -1;
+    }
+    return dump_read_len;
+}
+
+static uint8_t dump_tx_start(void *ctx, const uint8_t *data, uint16_t len)
+{
+    (void)ctx;
+    return HAL_UART_Transmit_DMA(&huart1, (uint8_t *)data, len) == HAL_OK;
+}
+
+static uint8_t dump_tx_busy(void *ctx)
+{
+    (void)ctx;
+    return huart1.gState != HAL_UART_STATE_READY;
+}
+
+static uint32_t dump_now_ms(void)
+{
+    return HAL_GetTick();
+}
+
+static const BulkDump_Port dump_port =
+{
+    dump_open, dump_read_start, dump_read_poll,
+    dump_tx_start, dump_tx_busy, dump_now_ms, NULL
+};
+
+void dump_init(void)
+{
+    BulkDump_Init(&dump, &dump_port);
+}
+
+uint8_t dump_active(void)
+{
+    return dump.active;
+}
+
+void dump_input(const uint8_t *buf, uint16_t len)
+{
+    BulkDump_Input(&dump, buf, len);
+}
+
+void dump_task(void)
+{
+    BulkDump_Poll(&dump);
+}
+
+void dump_cmd(int argc, char *argv[])
+{
+    const BulkDump_Stats *s = &dump.stats;
+
+    if (storage_get_flash() == NULL)
+    {
+        my_printf(&huart1, "dump: flash not mounted\r\n");
+        return;
+    }
+
+    // dump stats: counters of the last transfers
+    if (argc > 1 && strcmp(argv[1], "stats") == 0)
+    {
+        my_printf(&huart1, "dump     %lu frames, %lu resent, %lu naks, %lu timeouts, %lu bad host frames\r\n",
+                  (unsigned long)s->frames, (unsigned long)s->resends, (unsigned long)s->naks,
+                  (unsigned long)s->timeouts, (unsigned long)s->rx_errors);
+        return;
+    }
+
+    my_printf(&huart1, "dump: binary mode, waiting for host\r\n");
+    BulkDump_Enter(&dump);
+}
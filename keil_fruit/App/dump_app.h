@@ -0,0 +1,22 @@
+#ifndef DUMP_APP_H
+#define DUMP_APP_H
+
+#include "define.h"
+#include "bulk_dump.h"
+
+// Bind the bulk-dump protocol to USART1 and the sample flash
+void dump_init(void);
+
+// USART1 carries dump frames instead of console lines
+uint8_t dump_active(void);
+
+// Bytes received on USART1 while dump_active()
+void dump_input(const uint8_t *buf, uint16_t len);
+
+// Protocol reads/sends/timers (call in scheduler, every tick)
+void dump_task(void);
+
+// Console: "dump" switches USART1 to binary mode
+void dump_cmd(int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,1037 @@
+#ifndef ETHYLENE_LUT_H
+#define ETHYLENE_LUT_H
+
+// Generated by tools/sensor_test/gen_ethylene_lut.c (make lut), do not edit.
+// rs(code)^B for every 12-bit CH0 code, RL 30.0 kohm, Vc 3.3 V, B -2.35;
+// 0 where the voltage is out of range. Included by adc_app.c only.
+
+#define ETHYLENE_LUT_SIZE   4096
+
+static const float ethylene_lut[ETHYLENE_LUT_SIZE] = {
+    0.00000000e+00f, 0.00000000e+00f, 0.00000000e+00f, 0.00000000e+00f,
+    0.00000000e+00f, 0.00000000e+00f, 0.00000000e+00f, 0.00000000e+00f,
+    0.00000000e+00f, 0.00000000e+00f, 0.00000000e+00f, 0.00000000e+00f,
+    0.00000000e+00f, 4.57857974e-10f, 5.45273993e-10f, 6.41620701e-10f,
+    7.47129691e-10f, 8.62023619e-10f, 9.86517645e-10f, 1.12081966e-09f,
+    1.26513122e-09f, 1.41964829e-09f, 1.58456215e-09f, 1.76005810e-09f,
+    1.94631689e-09f, 2.14351625e-09f, 2.35182940e-09f, 2.57142663e-09f,
+    2.80247470e-09f, 3.04513326e-09f, 3.29956751e-09f, 3.56593199e-09f,
+    3.84438303e-09f, 4.13507317e-09f, 4.43815074e-09f, 4.75376538e-09f,
+    5.08206277e-09f, 5.42318812e-09f, 5.77728310e-09f, 6.14448403e-09f,
+    6.52493481e-09f, 6.91877133e-09f, 7.32612593e-09f, 7.74713715e-09f,
+    8.18193424e-09f, 8.63064997e-09f, 9.09341580e-09f, 9.57035429e-09f,
+    1.00616013e-08f, 1.05672777e-08f, 1.10875105e-08f, 1.16224266e-08f,
+    1.21721397e-08f, 1.27367876e-08f, 1.33164768e-08f, 1.39113370e-08f,
+    1.45214862e-08f, 1.51470374e-08f, 1.57881175e-08f, 1.64448348e-08f,
+    1.71173120e-08f, 1.78056645e-08f, 1.85100006e-08f, 1.92304483e-08f,
+    1.99671035e-08f, 2.07200923e-08f, 2.14895230e-08f, 2.22755041e-08f,
+    2.30781581e-08f, 2.38975755e-08f, 2.47338878e-08f, 2.55871928e-08f,
+    2.64576006e-08f, 2.73452283e-08f, 2.82501684e-08f, 2.91725399e-08f,
+    3.01124530e-08f, 3.10699946e-08f, 3.20453033e-08f, 3.30384502e-08f,
+    3.40495703e-08f, 3.50787452e-08f, 3.61261066e-08f, 3.71917324e-08f,
+    3.82757293e-08f, 3.93782180e-08f, 4.04992875e-08f, 4.16390513e-08f,
+    4.27976161e-08f, 4.39750529e-08f, 4.51714968e-08f, 4.63870400e-08f,
+    4.76217927e-08f, 4.88758332e-08f, 5.01492678e-08f, 5.14422283e-08f,
+    5.27547748e-08f, 5.40870317e-08f, 5.54390986e-08f, 5.68110430e-08f,
+    5.82030069e-08f, 5.96150826e-08f, 6.10473592e-08f, 6.24999288e-08f,
+    6.39728697e-08f, 6.54663452e-08f, 6.69804052e-08f, 6.85151633e-08f,
+    7.00707261e-08f, 7.16471504e-08f, 7.32445784e-08f, 7.48630811e-08f,
+    7.65027934e-08f, 7.81637723e-08f, 7.98461102e-08f, 8.15499419e-08f,
+    8.32753244e-08f, 8.50223998e-08f, 8.67912320e-08f, 8.85818991e-08f,
+    9.03945576e-08f, 9.22292429e-08f, 9.40861113e-08f, 9.59651985e-08f,
+    9.78666108e-08f, 9.97904905e-08f, 1.01736880e-07f, 1.03705915e-07f,
+    1.05697673e-07f, 1.07712211e-07f, 1.09749699e-07f, 1.11810174e-07f,
+    1.13893790e-07f, 1.16000585e-07f, 1.18130643e-07f, 1.20284128e-07f,
+    1.22461074e-07f, 1.24661625e-07f, 1.26885823e-07f, 1.29133781e-07f,
+    1.31405614e-07f, 1.33701406e-07f, 1.36021256e-07f, 1.38365252e-07f,
+    1.40733448e-07f, 1.43126016e-07f, 1.45542998e-07f, 1.47984537e-07f,
+    1.50450674e-07f, 1.52941482e-07f, 1.55457130e-07f, 1.57997661e-07f,
+    1.60563218e-07f, 1.63153857e-07f, 1.65769606e-07f, 1.68410722e-07f,
+    1.71077147e-07f, 1.73769052e-07f, 1.76486537e-07f, 1.79229644e-07f,
+    1.81998502e-07f, 1.84793180e-07f, 1.87613821e-07f, 1.90460483e-07f,
+    1.93333307e-07f, 1.96232264e-07f, 1.99157583e-07f, 2.02109263e-07f,
+    2.05087474e-07f, 2.08092274e-07f, 2.11123734e-07f, 2.14181995e-07f,
+    2.17267100e-07f, 2.20379235e-07f, 2.23518356e-07f, 2.26684662e-07f,
+    2.29878225e-07f, 2.33099101e-07f, 2.36347475e-07f, 2.39623347e-07f,
+    2.42926774e-07f, 2.46257997e-07f, 2.49616988e-07f, 2.53003918e-07f,
+    2.56418872e-07f, 2.59861878e-07f, 2.63332993e-07f, 2.66832529e-07f,
+    2.70360403e-07f, 2.73916754e-07f, 2.77501641e-07f, 2.81115206e-07f,
+    2.84757476e-07f, 2.88428680e-07f, 2.92128789e-07f, 2.95857859e-07f,
+    2.99616175e-07f, 3.03403681e-07f, 3.07220546e-07f, 3.11066771e-07f,
+    3.14942469e-07f, 3.18847810e-07f, 3.22782938e-07f, 3.26747795e-07f,
+    3.30742580e-07f, 3.34767293e-07f, 3.38822048e-07f, 3.42907015e-07f,
+    3.47022365e-07f, 3.51168012e-07f, 3.55344042e-07f, 3.59550711e-07f,
+    3.63787990e-07f, 3.68056163e-07f, 3.72354947e-07f, 3.76684795e-07f,
+    3.81045652e-07f, 3.85437716e-07f, 3.89860929e-07f, 3.94315521e-07f,
+    3.98801433e-07f, 4.03318921e-07f, 4.07867986e-07f, 4.12448912e-07f,
+    4.17061528e-07f, 4.21705948e-07f, 4.26382542e-07f, 4.31091081e-07f,
+    4.35831907e-07f, 4.40604992e-07f, 4.45410421e-07f, 4.50248336e-07f,
+    4.55118851e-07f, 4.60022108e-07f, 4.64958021e-07f, 4.69926846e-07f,
+    4.74928612e-07f, 4.79963489e-07f, 4.85031535e-07f, 4.90132777e-07f,
+    4.95267386e-07f, 5.00435419e-07f, 5.05636990e-07f, 5.10872383e-07f,
+    5.16141370e-07f, 5.21444179e-07f, 5.26780980e-07f, 5.32151773e-07f,
+    5.37556843e-07f, 5.42996077e-07f, 5.48469586e-07f, 5.53977486e-07f,
+    5.59520004e-07f, 5.65097196e-07f, 5.70709062e-07f, 5.76355717e-07f,
+    5.82037330e-07f, 5.87754016e-07f, 5.93505831e-07f, 5.99292719e-07f,
+    6.05115076e-07f, 6.10972791e-07f, 6.16865975e-07f, 6.22795085e-07f,
+    6.28759608e-07f, 6.34759999e-07f, 6.40796316e-07f, 6.46868671e-07f,
+    6.52977292e-07f, 6.59121952e-07f, 6.65302991e-07f, 6.71520468e-07f,
+    6.77774437e-07f, 6.84065185e-07f, 6.90392483e-07f, 6.96756615e-07f,
+    7.03157639e-07f, 7.09595838e-07f, 7.16071156e-07f, 7.22583593e-07f,
+    7.29133433e-07f, 7.35720675e-07f, 7.42345492e-07f, 7.49008052e-07f,
+    7.55708129e-07f, 7.62446177e-07f, 7.69222083e-07f, 7.76036131e-07f,
+    7.82888435e-07f, 7.89778824e-07f, 7.96707525e-07f, 8.03674880e-07f,
+    8.10680604e-07f, 8.17725208e-07f, 8.24808467e-07f, 8.31930549e-07f,
+    8.39091626e-07f, 8.46291641e-07f, 8.53531276e-07f, 8.60809735e-07f,
+    8.68127756e-07f, 8.75485398e-07f, 8.82882432e-07f, 8.90319484e-07f,
+    8.97796042e-07f, 9.05312447e-07f, 9.12869041e-07f, 9.20465766e-07f,
+    9.28102793e-07f, 9.35780065e-07f, 9.43497753e-07f, 9.51255686e-07f,
+    9.59054773e-07f, 9.66894731e-07f, 9.74774935e-07f, 9.82696406e-07f,
+    9.90658918e-07f, 9.98662813e-07f, 1.00670798e-06f, 1.01479418e-06f,
+    1.02292211e-06f, 1.03109141e-06f, 1.03930279e-06f, 1.04755611e-06f,
+    1.05585082e-06f, 1.06418793e-06f, 1.07256710e-06f, 1.08098857e-06f,
+    1.08945244e-06f, 1.09795849e-06f, 1.10650728e-06f, 1.11509860e-06f,
+    1.12373311e-06f, 1.13241060e-06f, 1.14113038e-06f, 1.14989382e-06f,
+    1.15870034e-06f, 1.16755018e-06f, 1.17644390e-06f, 1.18538026e-06f,
+    1.19436095e-06f, 1.20338518e-06f, 1.21245353e-06f, 1.22156598e-06f,
+    1.23072186e-06f, 1.23992254e-06f, 1.24916721e-06f, 1.25845668e-06f,
+    1.26779071e-06f, 1.27716885e-06f, 1.28659212e-06f, 1.29606030e-06f,
+    1.30557351e-06f, 1.31513195e-06f, 1.32473508e-06f, 1.33438402e-06f,
+    1.34407810e-06f, 1.35381777e-06f, 1.36360359e-06f, 1.37343432e-06f,
+    1.38331154e-06f, 1.39323470e-06f, 1.40320401e-06f, 1.41321982e-06f,
+    1.42328099e-06f, 1.43338946e-06f, 1.44354385e-06f, 1.45374543e-06f,
+    1.46399418e-06f, 1.47428898e-06f, 1.48463153e-06f, 1.49502057e-06f,
+    1.50545713e-06f, 1.51594156e-06f, 1.52647283e-06f, 1.53705207e-06f,
+    1.54767849e-06f, 1.55835323e-06f, 1.56907618e-06f, 1.57984641e-06f,
+    1.59066553e-06f, 1.60153218e-06f, 1.61244816e-06f, 1.62341246e-06f,
+    1.63442473e-06f, 1.64548635e-06f, 1.65659640e-06f, 1.66775601e-06f,
+    1.67896496e-06f, 1.69022189e-06f, 1.70152896e-06f, 1.71288536e-06f,
+    1.72429168e-06f, 1.73574801e-06f, 1.74725312e-06f, 1.75880893e-06f,
+    1.77041420e-06f, 1.78206994e-06f, 1.79377685e-06f, 1.80553252e-06f,
+    1.81733969e-06f, 1.82919734e-06f, 1.84110581e-06f, 1.85306601e-06f,
+    1.86507589e-06f, 1.87713749e-06f, 1.88924992e-06f, 1.90141429e-06f,
+    1.91363051e-06f, 1.92589755e-06f, 1.93821688e-06f, 1.95058738e-06f,
+    1.96301039e-06f, 1.97548593e-06f, 1.98801240e-06f, 2.00059276e-06f,
+    2.01322405e-06f, 2.02590923e-06f, 2.03864761e-06f, 2.05143715e-06f,
+    2.06428012e-06f, 2.07717653e-06f, 2.09012615e-06f, 2.10312965e-06f,
+    2.11618521e-06f, 2.12929535e-06f, 2.14245915e-06f, 2.15567684e-06f,
+    2.16894887e-06f, 2.18227410e-06f, 2.19565391e-06f, 2.20908782e-06f,
+    2.22257677e-06f, 2.23612028e-06f, 2.24971768e-06f, 2.26337056e-06f,
+    2.27707824e-06f, 2.29084094e-06f, 2.30466003e-06f, 2.31853278e-06f,
+    2.33246192e-06f, 2.34644608e-06f, 2.36048663e-06f, 2.37458312e-06f,
+    2.38873486e-06f, 2.40294321e-06f, 2.41720750e-06f, 2.43152840e-06f,
+    2.44590660e-06f, 2.46034006e-06f, 2.47483081e-06f, 2.48937818e-06f,
+    2.50398307e-06f, 2.51864572e-06f, 2.53336430e-06f, 2.54814108e-06f,
+    2.56297494e-06f, 2.57786678e-06f, 2.59281728e-06f, 2.60782394e-06f,
+    2.62289018e-06f, 2.63801348e-06f, 2.65319591e-06f, 2.66843722e-06f,
+    2.68373606e-06f, 2.69909401e-06f, 2.71451086e-06f, 2.72998682e-06f,
+    2.74552281e-06f, 2.76111609e-06f, 2.77677009e-06f, 2.79248320e-06f,
+    2.80825611e-06f, 2.82408973e-06f, 2.83998156e-06f, 2.85593455e-06f,
+    2.87194689e-06f, 2.88802062e-06f, 2.90415528e-06f, 2.92034861e-06f,
+    2.93660401e-06f, 2.95291966e-06f, 2.96929716e-06f, 2.98573627e-06f,
+    3.00223473e-06f, 3.01879595e-06f, 3.03541810e-06f, 3.05210278e-06f,
+    3.06884976e-06f, 3.08565700e-06f, 3.10252722e-06f, 3.11945973e-06f,
+    3.13645455e-06f, 3.15351303e-06f, 3.17063200e-06f, 3.18781508e-06f,
+    3.20506092e-06f, 3.22236997e-06f, 3.23974336e-06f, 3.25717792e-06f,
+    3.27467774e-06f, 3.29224008e-06f, 3.30986677e-06f, 3.32755803e-06f,
+    3.34531228e-06f, 3.36313110e-06f, 3.38101427e-06f, 3.39896224e-06f,
+    3.41697569e-06f, 3.43505167e-06f, 3.45319427e-06f, 3.47140121e-06f,
+    3.48967410e-06f, 3.50801315e-06f, 3.52641564e-06f, 3.54488452e-06f,
+    3.56341934e-06f, 3.58202010e-06f, 3.60068793e-06f, 3.61942011e-06f,
+    3.63822005e-06f, 3.65708570e-06f, 3.67601911e-06f, 3.69501959e-06f,
+    3.71408487e-06f, 3.73321905e-06f, 3.75241962e-06f, 3.77168840e-06f,
+    3.79102562e-06f, 3.81042810e-06f, 3.82989992e-06f, 3.84943860e-06f,
+    3.86904685e-06f, 3.88872422e-06f, 3.90846753e-06f, 3.92828088e-06f,
+    3.94816243e-06f, 3.96811356e-06f, 3.98813381e-06f, 4.00822228e-06f,
+    4.02838032e-06f, 4.04860793e-06f, 4.06890604e-06f, 4.08927417e-06f,
+    4.10971052e-06f, 4.13021780e-06f, 4.15079558e-06f, 4.17144383e-06f,
+    4.19216349e-06f, 4.21295181e-06f, 4.23381198e-06f, 4.25474309e-06f,
+    4.27574514e-06f, 4.29682041e-06f, 4.31796479e-06f, 4.33918149e-06f,
+    4.36047003e-06f, 4.38183133e-06f, 4.40326539e-06f, 4.42476858e-06f,
+    4.44634679e-06f, 4.46799640e-06f, 4.48971969e-06f, 4.51151664e-06f,
+    4.53338407e-06f, 4.55532609e-06f, 4.57734131e-06f, 4.59943067e-06f,
+    4.62159414e-06f, 4.64382902e-06f, 4.66613983e-06f, 4.68852431e-06f,
+    4.71098292e-06f, 4.73351793e-06f, 4.75612433e-06f, 4.77880758e-06f,
+    4.80156450e-06f, 4.82439827e-06f, 4.84730754e-06f, 4.87029001e-06f,
+    4.89334889e-06f, 4.91648416e-06f, 4.93969537e-06f, 4.96298344e-06f,
+    4.98634517e-06f, 5.00978513e-06f, 5.03330102e-06f, 5.05689468e-06f,
+    5.08056610e-06f, 5.10431164e-06f, 5.12813631e-06f, 5.15203647e-06f,
+    5.17601666e-06f, 5.20007507e-06f, 5.22420760e-06f, 5.24842108e-06f,
+    5.27271186e-06f, 5.29708177e-06f, 5.32153172e-06f, 5.34605624e-06f,
+    5.37066217e-06f, 5.39534676e-06f, 5.42011139e-06f, 5.44495560e-06f,
+    5.46987758e-06f, 5.49488050e-06f, 5.51996300e-06f, 5.54512599e-06f,
+    5.57037083e-06f, 5.59569162e-06f, 5.62109608e-06f, 5.64658103e-06f,
+    5.67214647e-06f, 5.69779468e-06f, 5.72352155e-06f, 5.74933165e-06f,
+    5.77522178e-06f, 5.80119558e-06f, 5.82725215e-06f, 5.85338739e-06f,
+    5.87960722e-06f, 5.90590935e-06f, 5.93229151e-06f, 5.95876054e-06f,
+    5.98531051e-06f, 6.01194415e-06f, 6.03866147e-06f, 6.06546155e-06f,
+    6.09234576e-06f, 6.11931409e-06f, 6.14636610e-06f, 6.17350270e-06f,
+    6.20072251e-06f, 6.22802827e-06f, 6.25541952e-06f, 6.28289445e-06f,
+    6.31045441e-06f, 6.33809896e-06f, 6.36583127e-06f, 6.39364771e-06f,
+    6.42155101e-06f, 6.44953934e-06f, 6.47761271e-06f, 6.50577522e-06f,
+    6.53402276e-06f, 6.56235852e-06f, 6.59077978e-06f, 6.61928789e-06f,
+    6.64788377e-06f, 6.67656741e-06f, 6.70533882e-06f, 6.73419891e-06f,
+    6.76314494e-06f, 6.79218056e-06f, 6.82130440e-06f, 6.85051646e-06f,
+    6.87981901e-06f, 6.90920751e-06f, 6.93868651e-06f, 6.96825555e-06f,
+    6.99791326e-06f, 7.02766238e-06f, 7.05749926e-06f, 7.08742664e-06f,
+    7.11744542e-06f, 7.14755424e-06f, 7.17775356e-06f, 7.20804292e-06f,
+    7.23842368e-06f, 7.26889539e-06f, 7.29946032e-06f, 7.33011620e-06f,
+    7.36086213e-06f, 7.39170082e-06f, 7.42263273e-06f, 7.45365651e-06f,
+    7.48477350e-06f, 7.51598145e-06f, 7.54728444e-06f, 7.57867974e-06f,
+    7.61016736e-06f, 7.64175093e-06f, 7.67342408e-06f, 7.70519455e-06f,
+    7.73705870e-06f, 7.76901743e-06f, 7.80106893e-06f, 7.83321502e-06f,
+    7.86545752e-06f, 7.89779642e-06f, 7.93022809e-06f, 7.96275799e-06f,
+    7.99537884e-06f, 8.02809882e-06f, 8.06091612e-06f, 8.09382800e-06f,
+    8.12683629e-06f, 8.15994008e-06f, 8.19314300e-06f, 8.22644324e-06f,
+    8.25983898e-06f, 8.29333385e-06f, 8.32692422e-06f, 8.36061372e-06f,
+    8.39440236e-06f, 8.42828922e-06f, 8.46227249e-06f, 8.49635398e-06f,
+    8.53053734e-06f, 8.56481893e-06f, 8.59920056e-06f, 8.63368132e-06f,
+    8.66825849e-06f, 8.70293843e-06f, 8.73771842e-06f, 8.77259936e-06f,
+    8.80758216e-06f, 8.84265955e-06f, 8.87784245e-06f, 8.91312720e-06f,
+    8.94851291e-06f, 8.98399958e-06f, 9.01958811e-06f, 9.05527850e-06f,
+    9.09107257e-06f, 9.12696760e-06f, 9.16296631e-06f, 9.19906506e-06f,
+    9.23526932e-06f, 9.27157635e-06f, 9.30798797e-06f, 9.34450236e-06f,
+    9.38111862e-06f, 9.41784128e-06f, 9.45466854e-06f, 9.49160221e-06f,
+    9.52863957e-06f, 9.56577787e-06f, 9.60302350e-06f, 9.64037645e-06f,
+    9.67783581e-06f, 9.71539885e-06f, 9.75306648e-06f, 9.79084143e-06f,
+    9.82872643e-06f, 9.86671603e-06f, 9.90481294e-06f, 9.94301263e-06f,
+    9.98132509e-06f, 1.00197431e-05f, 1.00582702e-05f, 1.00969028e-05f,
+    1.01356445e-05f, 1.01744963e-05f, 1.02134563e-05f, 1.02525246e-05f,
+    1.02917056e-05f, 1.03309885e-05f, 1.03703869e-05f, 1.04098954e-05f,
+    1.04495130e-05f, 1.04892406e-05f, 1.05290737e-05f, 1.05690251e-05f,
+    1.06090856e-05f, 1.06492544e-05f, 1.06895377e-05f, 1.07299284e-05f,
+    1.07704373e-05f, 1.08110535e-05f, 1.08517861e-05f, 1.08926288e-05f,
+    1.09335824e-05f, 1.09746516e-05f, 1.10158344e-05f, 1.10571291e-05f,
+    1.10985402e-05f, 1.11400595e-05f, 1.11816980e-05f, 1.12234511e-05f,
+    1.12653179e-05f, 1.13072992e-05f, 1.13493934e-05f, 1.13916076e-05f,
+    1.14339346e-05f, 1.14763779e-05f, 1.15189387e-05f, 1.15616122e-05f,
+    1.16044048e-05f, 1.16473157e-05f, 1.16903420e-05f, 1.17334866e-05f,
+    1.17767459e-05f, 1.18201242e-05f, 1.18636226e-05f, 1.19072374e-05f,
+    1.19509723e-05f, 1.19948218e-05f, 1.20387931e-05f, 1.20828845e-05f,
+    1.21270959e-05f, 1.21714265e-05f, 1.22158726e-05f, 1.22604442e-05f,
+    1.23051341e-05f, 1.23499449e-05f, 1.23948785e-05f, 1.24399294e-05f,
+    1.24851031e-05f, 1.25304005e-05f, 1.25758188e-05f, 1.26213590e-05f,
+    1.26670202e-05f, 1.27128069e-05f, 1.27587136e-05f, 1.28047477e-05f,
+    1.28509018e-05f, 1.28971778e-05f, 1.29435803e-05f, 1.29901091e-05f,
+    1.30367589e-05f, 1.30835369e-05f, 1.31304332e-05f, 1.31774596e-05f,
+    1.32246123e-05f, 1.32718887e-05f, 1.33192934e-05f, 1.33668200e-05f,
+    1.34144757e-05f, 1.34622578e-05f, 1.35101673e-05f, 1.35582050e-05f,
+    1.36063663e-05f, 1.36546596e-05f, 1.37030775e-05f, 1.37516281e-05f,
+    1.38003052e-05f, 1.38491068e-05f, 1.38980422e-05f, 1.39471058e-05f,
+    1.39963004e-05f, 1.40456232e-05f, 1.40950742e-05f, 1.41446581e-05f,
+    1.41943719e-05f, 1.42442186e-05f, 1.42941963e-05f, 1.43443021e-05f,
+    1.43945417e-05f, 1.44449123e-05f, 1.44954174e-05f, 1.45460535e-05f,
+    1.45968206e-05f, 1.46477232e-05f, 1.46987586e-05f, 1.47499277e-05f,
+    1.48012314e-05f, 1.48526651e-05f, 1.49042362e-05f, 1.49559446e-05f,
+    1.50077849e-05f, 1.50597625e-05f, 1.51118711e-05f, 1.51641198e-05f,
+    1.52165039e-05f, 1.52690245e-05f, 1.53216806e-05f, 1.53744695e-05f,
+    1.54274003e-05f, 1.54804693e-05f, 1.55336766e-05f, 1.55870202e-05f,
+    1.56405004e-05f, 1.56941187e-05f, 1.57478789e-05f, 1.58017774e-05f,
+    1.58558159e-05f, 1.59099927e-05f, 1.59643096e-05f, 1.60187665e-05f,
+    1.60733671e-05f, 1.61281041e-05f, 1.61829830e-05f, 1.62380056e-05f,
+    1.62931683e-05f, 1.63484729e-05f, 1.64039211e-05f, 1.64595076e-05f,
+    1.65152433e-05f, 1.65711172e-05f, 1.66271384e-05f, 1.66833015e-05f,
+    1.67396065e-05f, 1.67960570e-05f, 1.68526512e-05f, 1.69093946e-05f,
+    1.69662817e-05f, 1.70233070e-05f, 1.70804869e-05f, 1.71378088e-05f,
+    1.71952797e-05f, 1.72528944e-05f, 1.73106546e-05f, 1.73685676e-05f,
+    1.74266243e-05f, 1.74848301e-05f, 1.75431851e-05f, 1.76016838e-05f,
+    1.76603353e-05f, 1.77191341e-05f, 1.77780839e-05f, 1.78371829e-05f,
+    1.78964292e-05f, 1.79558265e-05f, 1.80153766e-05f, 1.80750776e-05f,
+    1.81349315e-05f, 1.81949290e-05f, 1.82550866e-05f, 1.83153934e-05f,
+    1.83758530e-05f, 1.84364635e-05f, 1.84972268e-05f, 1.85581448e-05f,
+    1.86192156e-05f, 1.86804409e-05f, 1.87418209e-05f, 1.88033518e-05f,
+    1.88650429e-05f, 1.89268867e-05f, 1.89888869e-05f, 1.90510455e-05f,
+    1.91133531e-05f, 1.91758209e-05f, 1.92384468e-05f, 1.93012274e-05f,
+    1.93641681e-05f, 1.94272634e-05f, 1.94905169e-05f, 1.95539305e-05f,
+    1.96175042e-05f, 1.96812380e-05f, 1.97451245e-05f, 1.98091730e-05f,
+    1.98733833e-05f, 1.99377537e-05f, 2.00022878e-05f, 2.00669729e-05f,
+    2.01318289e-05f, 2.01968433e-05f, 2.02620213e-05f, 2.03273576e-05f,
+    2.03928557e-05f, 2.04585194e-05f, 2.05243505e-05f, 2.05903398e-05f,
+    2.06564964e-05f, 2.07228095e-05f, 2.07892936e-05f, 2.08559413e-05f,
+    2.09227564e-05f, 2.09897353e-05f, 2.10568778e-05f, 2.11241895e-05f,
+    2.11916686e-05f, 2.12593150e-05f, 2.13271269e-05f, 2.13951025e-05f,
+    2.14632473e-05f, 2.15315631e-05f, 2.16000481e-05f, 2.16687004e-05f,
+    2.17375218e-05f, 2.18065143e-05f, 2.18756759e-05f, 2.19450067e-05f,
+    2.20145121e-05f, 2.20841794e-05f, 2.21540267e-05f, 2.22240451e-05f,
+    2.22942308e-05f, 2.23645911e-05f, 2.24351243e-05f, 2.25058302e-05f,
+    2.25767108e-05f, 2.26477659e-05f, 2.27189921e-05f, 2.27903947e-05f,
+    2.28619683e-05f, 2.29337256e-05f, 2.30056485e-05f, 2.30777550e-05f,
+    2.31500326e-05f, 2.32224902e-05f, 2.32951224e-05f, 2.33679330e-05f,
+    2.34409254e-05f, 2.35140851e-05f, 2.35874304e-05f, 2.36609558e-05f,
+    2.37346612e-05f, 2.38085431e-05f, 2.38825996e-05f, 2.39568417e-05f,
+    2.40312656e-05f, 2.41058733e-05f, 2.41806556e-05f, 2.42556180e-05f,
+    2.43307695e-05f, 2.44061011e-05f, 2.44816129e-05f, 2.45573137e-05f,
+    2.46331892e-05f, 2.47092539e-05f, 2.47855023e-05f, 2.48619344e-05f,
+    2.49385575e-05f, 2.50153535e-05f, 2.50923422e-05f, 2.51695201e-05f,
+    2.52468817e-05f, 2.53244325e-05f, 2.54021616e-05f, 2.54800907e-05f,
+    2.55582017e-05f, 2.56365020e-05f, 2.57149895e-05f, 2.57936645e-05f,
+    2.58725340e-05f, 2.59515928e-05f, 2.60308389e-05f, 2.61102759e-05f,
+    2.61899040e-05f, 2.62697231e-05f, 2.63497368e-05f, 2.64299415e-05f,
+    2.65103408e-05f, 2.65909275e-05f, 2.66717107e-05f, 2.67526939e-05f,
+    2.68338626e-05f, 2.69152315e-05f, 2.69967859e-05f, 2.70785440e-05f,
+    2.71605004e-05f, 2.72426496e-05f, 2.73249952e-05f, 2.74075337e-05f,
+    2.74902759e-05f, 2.75732091e-05f, 2.76563478e-05f, 2.77396812e-05f,
+    2.78232146e-05f, 2.79069445e-05f, 2.79908763e-05f, 2.80750137e-05f,
+    2.81593457e-05f, 2.82438778e-05f, 2.83286099e-05f, 2.84135476e-05f,
+    2.84986872e-05f, 2.85840288e-05f, 2.86695740e-05f, 2.87553230e-05f,
+    2.88412739e-05f, 2.89274321e-05f, 2.90137941e-05f, 2.91003525e-05f,
+    2.91871274e-05f, 2.92741024e-05f, 2.93612939e-05f, 2.94486799e-05f,
+    2.95362770e-05f, 2.96240796e-05f, 2.97120987e-05f, 2.98003197e-05f,
+    2.98887499e-05f, 2.99773874e-05f, 3.00662396e-05f, 3.01553009e-05f,
+    3.02445696e-05f, 3.03340530e-05f, 3.04237383e-05f, 3.05136455e-05f,
+    3.06037655e-05f, 3.06940965e-05f, 3.07846385e-05f, 3.08753915e-05f,
+    3.09663628e-05f, 3.10575524e-05f, 3.11489457e-05f, 3.12405646e-05f,
+    3.13323944e-05f, 3.14244389e-05f, 3.15167053e-05f, 3.16091864e-05f,
+    3.17018821e-05f, 3.17947997e-05f, 3.18879356e-05f, 3.19812898e-05f,
+    3.20748622e-05f, 3.21686566e-05f, 3.22626620e-05f, 3.23569002e-05f,
+    3.24513494e-05f, 3.25460278e-05f, 3.26409281e-05f, 3.27360431e-05f,
+    3.28313909e-05f, 3.29269533e-05f, 3.30227449e-05f, 3.31187621e-05f,
+    3.32149975e-05f, 3.33114658e-05f, 3.34081560e-05f, 3.35050718e-05f,
+    3.36022094e-05f, 3.36995763e-05f, 3.37971796e-05f, 3.38950049e-05f,
+    3.39930557e-05f, 3.40913430e-05f, 3.41898412e-05f, 3.42885869e-05f,
+    3.43875581e-05f, 3.44867585e-05f, 3.45861954e-05f, 3.46858542e-05f,
+    3.47857531e-05f, 3.48858848e-05f, 3.49862494e-05f, 3.50868431e-05f,
+    3.51876733e-05f, 3.52887364e-05f, 3.53900396e-05f, 3.54915683e-05f,
+    3.55933444e-05f, 3.56953460e-05f, 3.57975914e-05f, 3.59000769e-05f,
+    3.60027952e-05f, 3.61057573e-05f, 3.62089486e-05f, 3.63123836e-05f,
+    3.64160587e-05f, 3.65199739e-05f, 3.66241366e-05f, 3.67285247e-05f,
+    3.68331675e-05f, 3.69380541e-05f, 3.70431771e-05f, 3.71485439e-05f,
+    3.72541472e-05f, 3.73600051e-05f, 3.74661104e-05f, 3.75724558e-05f,
+    3.76790485e-05f, 3.77858851e-05f, 3.78929690e-05f, 3.80003039e-05f,
+    3.81078753e-05f, 3.82157123e-05f, 3.83237821e-05f, 3.84321065e-05f,
+    3.85406856e-05f, 3.86495085e-05f, 3.87585860e-05f, 3.88679109e-05f,
+    3.89774868e-05f, 3.90873211e-05f, 3.91974063e-05f, 3.93077462e-05f,
+    3.94183335e-05f, 3.95291827e-05f, 3.96402866e-05f, 3.97516451e-05f,
+    3.98632583e-05f, 3.99751152e-05f, 4.00872486e-05f, 4.01996258e-05f,
+    4.03122758e-05f, 4.04251732e-05f, 4.05383253e-05f, 4.06517502e-05f,
+    4.07654297e-05f, 4.08793640e-05f, 4.09935747e-05f, 4.11080291e-05f,
+    4.12227491e-05f, 4.13377420e-05f, 4.14529932e-05f, 4.15685063e-05f,
+    4.16842850e-05f, 4.18003328e-05f, 4.19166427e-05f, 4.20332181e-05f,
+    4.21500590e-05f, 4.22671619e-05f, 4.23845449e-05f, 4.25021935e-05f,
+    4.26201077e-05f, 4.27382947e-05f, 4.28567400e-05f, 4.29754691e-05f,
+    4.30944674e-05f, 4.32137313e-05f, 4.33332680e-05f, 4.34530739e-05f,
+    4.35731672e-05f, 4.36935261e-05f, 4.38141615e-05f, 4.39350733e-05f,
+    4.40562508e-05f, 4.41777047e-05f, 4.42994497e-05f, 4.44214602e-05f,
+    4.45437581e-05f, 4.46663216e-05f, 4.47891616e-05f, 4.49122927e-05f,
+    4.50357002e-05f, 4.51593987e-05f, 4.52833629e-05f, 4.54076144e-05f,
+    4.55321460e-05f, 4.56569651e-05f, 4.57820643e-05f, 4.59074508e-05f,
+    4.60331175e-05f, 4.61590716e-05f, 4.62853168e-05f, 4.64118420e-05f,
+    4.65386438e-05f, 4.66657511e-05f, 4.67931459e-05f, 4.69208171e-05f,
+    4.70487939e-05f, 4.71770509e-05f, 4.73055952e-05f, 4.74344306e-05f,
+    4.75635716e-05f, 4.76929890e-05f, 4.78227230e-05f, 4.79527116e-05f,
+    4.80830167e-05f, 4.82136275e-05f, 4.83445147e-05f, 4.84757184e-05f,
+    4.86071913e-05f, 4.87389661e-05f, 4.88710575e-05f, 4.90034290e-05f,
+    4.91361316e-05f, 4.92690997e-05f, 4.94023770e-05f, 4.95359564e-05f,
+    4.96698412e-05f, 4.98040426e-05f, 4.99385133e-05f, 5.00733004e-05f,
+    5.02083967e-05f, 5.03437950e-05f, 5.04795171e-05f, 5.06155156e-05f,
+    5.07518234e-05f, 5.08884623e-05f, 5.10253813e-05f, 5.11626495e-05f,
+    5.13001796e-05f, 5.14380336e-05f, 5.15762076e-05f, 5.17146873e-05f,
+    5.18534907e-05f, 5.19925889e-05f, 5.21319926e-05f, 5.22717310e-05f,
+    5.24117786e-05f, 5.25521609e-05f, 5.26928088e-05f, 5.28337951e-05f,
+    5.29751160e-05f, 5.31167316e-05f, 5.32587001e-05f, 5.34009487e-05f,
+    5.35435320e-05f, 5.36864427e-05f, 5.38296590e-05f, 5.39732282e-05f,
+    5.41170775e-05f, 5.42612506e-05f, 5.44057802e-05f, 5.45506155e-05f,
+    5.46957926e-05f, 5.48412609e-05f, 5.49870711e-05f, 5.51332232e-05f,
+    5.52796810e-05f, 5.54265134e-05f, 5.55736078e-05f, 5.57210587e-05f,
+    5.58688480e-05f, 5.60169683e-05f, 5.61654415e-05f, 5.63141948e-05f,
+    5.64633046e-05f, 5.66127601e-05f, 5.67625393e-05f, 5.69126751e-05f,
+    5.70631091e-05f, 5.72138815e-05f, 5.73650250e-05f, 5.75164777e-05f,
+    5.76683051e-05f, 5.78204199e-05f, 5.79728949e-05f, 5.81257300e-05f,
+    5.82788853e-05f, 5.84324189e-05f, 5.85862472e-05f, 5.87404247e-05f,
+    5.88949770e-05f, 5.90498457e-05f, 5.92051001e-05f, 5.93606455e-05f,
+    5.95165584e-05f, 5.96728351e-05f, 5.98294500e-05f, 5.99864361e-05f,
+    6.01437350e-05f, 6.03013868e-05f, 6.04594206e-05f, 6.06177855e-05f,
+    6.07765323e-05f, 6.09355811e-05f, 6.10950010e-05f, 6.12548029e-05f,
+    6.14149321e-05f, 6.15754616e-05f, 6.17362966e-05f, 6.18975027e-05f,
+    6.20590799e-05f, 6.22210064e-05f, 6.23833257e-05f, 6.25459579e-05f,
+    6.27089685e-05f, 6.28723501e-05f, 6.30360882e-05f, 6.32002120e-05f,
+    6.33646632e-05f, 6.35294928e-05f, 6.36947079e-05f, 6.38602723e-05f,
+    6.40262297e-05f, 6.41925144e-05f, 6.43591848e-05f, 6.45262335e-05f,
+    6.46936460e-05f, 6.48614659e-05f, 6.50295915e-05f, 6.51981245e-05f,
+    6.53670431e-05f, 6.55363183e-05f, 6.57060009e-05f, 6.58760182e-05f,
+    6.60464138e-05f, 6.62172242e-05f, 6.63883839e-05f, 6.65599582e-05f,
+    6.67318673e-05f, 6.69041692e-05f, 6.70768713e-05f, 6.72499445e-05f,
+    6.74234252e-05f, 6.75972478e-05f, 6.77714634e-05f, 6.79460936e-05f,
+    6.81210804e-05f, 6.82965037e-05f, 6.84722618e-05f, 6.86484200e-05f,
+    6.88249784e-05f, 6.90019224e-05f, 6.91792957e-05f, 6.93570037e-05f,
+    6.95351118e-05f, 6.97136493e-05f, 6.98925578e-05f, 7.00719029e-05f,
+    7.02515754e-05f, 7.04316772e-05f, 7.06121937e-05f, 7.07930885e-05f,
+    7.09744272e-05f, 7.11560933e-05f, 7.13381887e-05f, 7.15207134e-05f,
+    7.17036164e-05f, 7.18869560e-05f, 7.20706594e-05f, 7.22547775e-05f,
+    7.24393249e-05f, 7.26242506e-05f, 7.28096275e-05f, 7.29953608e-05f,
+    7.31815308e-05f, 7.33681154e-05f, 7.35551002e-05f, 7.37425435e-05f,
+    7.39303359e-05f, 7.41185577e-05f, 7.43072160e-05f, 7.44962817e-05f,
+    7.46857986e-05f, 7.48756647e-05f, 7.50659747e-05f, 7.52567357e-05f,
+    7.54478824e-05f, 7.56395020e-05f, 7.58314709e-05f, 7.60238909e-05f,
+    7.62167620e-05f, 7.64100332e-05f, 7.66037629e-05f, 7.67978709e-05f,
+    7.69924227e-05f, 7.71874184e-05f, 7.73828215e-05f, 7.75787121e-05f,
+    7.77749519e-05f, 7.79716574e-05f, 7.81688213e-05f, 7.83664000e-05f,
+    7.85644443e-05f, 7.87628669e-05f, 7.89617479e-05f, 7.91610873e-05f,
+    7.93608415e-05f, 7.95610831e-05f, 7.97616958e-05f, 7.99627815e-05f,
+    8.01643255e-05f, 8.03662915e-05f, 8.05687450e-05f, 8.07715769e-05f,
+    8.09748672e-05f, 8.11786449e-05f, 8.13828447e-05f, 8.15875392e-05f,
+    8.17926048e-05f, 8.19981651e-05f, 8.22041839e-05f, 8.24106392e-05f,
+    8.26175892e-05f, 8.28249176e-05f, 8.30327554e-05f, 8.32410369e-05f,
+    8.34497769e-05f, 8.36590116e-05f, 8.38686392e-05f, 8.40787761e-05f,
+    8.42893569e-05f, 8.45003960e-05f, 8.47119372e-05f, 8.49238713e-05f,
+    8.51363293e-05f, 8.53492384e-05f, 8.55626058e-05f, 8.57764826e-05f,
+    8.59907523e-05f, 8.62055676e-05f, 8.64208196e-05f, 8.66365372e-05f,
+    8.68527786e-05f, 8.70694130e-05f, 8.72865785e-05f, 8.75042097e-05f,
+    8.77223210e-05f, 8.79409417e-05f, 8.81599626e-05f, 8.83795292e-05f,
+    8.85995614e-05f, 8.88200666e-05f, 8.90410956e-05f, 8.92625394e-05f,
+    8.94845216e-05f, 8.97069767e-05f, 8.99299193e-05f, 9.01533858e-05f,
+    9.03772598e-05f, 9.06016940e-05f, 9.08266011e-05f, 9.10519957e-05f,
+    9.12779360e-05f, 9.15042838e-05f, 9.17311772e-05f, 9.19585582e-05f,
+    9.21864485e-05f, 9.24148699e-05f, 9.26436987e-05f, 9.28731024e-05f,
+    9.31030008e-05f, 9.33333795e-05f, 9.35643111e-05f, 9.37956720e-05f,
+    9.40276004e-05f, 9.42600236e-05f, 9.44929488e-05f, 9.47264343e-05f,
+    9.49603345e-05f, 9.51948168e-05f, 9.54298011e-05f, 9.56652948e-05f,
+    9.59013487e-05f, 9.61378246e-05f, 9.63748826e-05f, 9.66124571e-05f,
+    9.68505192e-05f, 9.70891706e-05f, 9.73282586e-05f, 9.75679359e-05f,
+    9.78081080e-05f, 9.80488112e-05f, 9.82900892e-05f, 9.85318038e-05f,
+    9.87741078e-05f, 9.90169283e-05f, 9.92602727e-05f, 9.95042137e-05f,
+    9.97485695e-05f, 9.99935510e-05f, 1.00239056e-04f, 1.00485078e-04f,
+    1.00731690e-04f, 1.00978752e-04f, 1.01226418e-04f, 1.01474616e-04f,
+    1.01723330e-04f, 1.01972662e-04f, 1.02222439e-04f, 1.02472834e-04f,
+    1.02723752e-04f, 1.02975231e-04f, 1.03227292e-04f, 1.03479819e-04f,
+    1.03732971e-04f, 1.03986640e-04f, 1.04240884e-04f, 1.04495724e-04f,
+    1.04751016e-04f, 1.05006948e-04f, 1.05263411e-04f, 1.05520441e-04f,
+    1.05778083e-04f, 1.06036190e-04f, 1.06294923e-04f, 1.06554231e-04f,
+    1.06814070e-04f, 1.07074557e-04f, 1.07335494e-04f, 1.07597087e-04f,
+    1.07859225e-04f, 1.08121923e-04f, 1.08385269e-04f, 1.08649074e-04f,
+    1.08913533e-04f, 1.09178567e-04f, 1.09444161e-04f, 1.09710389e-04f,
+    1.09977096e-04f, 1.10244480e-04f, 1.10512396e-04f, 1.10780922e-04f,
+    1.11050082e-04f, 1.11319721e-04f, 1.11590023e-04f, 1.11860914e-04f,
+    1.12132380e-04f, 1.12404494e-04f, 1.12677080e-04f, 1.12950365e-04f,
+    1.13224225e-04f, 1.13498681e-04f, 1.13773778e-04f, 1.14049377e-04f,
+    1.14325674e-04f, 1.14602532e-04f, 1.14880007e-04f, 1.15158131e-04f,
+    1.15436756e-04f, 1.15716080e-04f, 1.15995972e-04f, 1.16276504e-04f,
+    1.16557669e-04f, 1.16839365e-04f, 1.17121759e-04f, 1.17404743e-04f,
+    1.17688352e-04f, 1.17972617e-04f, 1.18257391e-04f, 1.18542892e-04f,
+    1.18828997e-04f, 1.19115692e-04f, 1.19403099e-04f, 1.19691016e-04f,
+    1.19979646e-04f, 1.20268880e-04f, 1.20558754e-04f, 1.20849298e-04f,
+    1.21140380e-04f, 1.21432196e-04f, 1.21724595e-04f, 1.22017649e-04f,
+    1.22311394e-04f, 1.22605677e-04f, 1.22900674e-04f, 1.23196311e-04f,
+    1.23492602e-04f, 1.23789549e-04f, 1.24087092e-04f, 1.24385333e-04f,
+    1.24684215e-04f, 1.24983737e-04f, 1.25283972e-04f, 1.25584775e-04f,
+    1.25886276e-04f, 1.26188461e-04f, 1.26491286e-04f, 1.26794796e-04f,
+    1.27098945e-04f, 1.27403735e-04f, 1.27709267e-04f, 1.28015410e-04f,
+    1.28322266e-04f, 1.28629748e-04f, 1.28937885e-04f, 1.29246750e-04f,
+    1.29556254e-04f, 1.29866516e-04f, 1.30177359e-04f, 1.30488916e-04f,
+    1.30801156e-04f, 1.31114066e-04f, 1.31427718e-04f, 1.31741981e-04f,
+    1.32056957e-04f, 1.32372661e-04f, 1.32689005e-04f, 1.33006106e-04f,
+    1.33323847e-04f, 1.33642287e-04f, 1.33961425e-04f, 1.34281290e-04f,
+    1.34601854e-04f, 1.34923073e-04f, 1.35245034e-04f, 1.35567694e-04f,
+    1.35891052e-04f, 1.36215182e-04f, 1.36539908e-04f, 1.36865405e-04f,
+    1.37191615e-04f, 1.37518553e-04f, 1.37846218e-04f, 1.38174539e-04f,
+    1.38503601e-04f, 1.38833406e-04f, 1.39163938e-04f, 1.39495212e-04f,
+    1.39827127e-04f, 1.40159827e-04f, 1.40493285e-04f, 1.40827440e-04f,
+    1.41162338e-04f, 1.41497949e-04f, 1.41834287e-04f, 1.42171397e-04f,
+    1.42509220e-04f, 1.42847843e-04f, 1.43187121e-04f, 1.43527170e-04f,
+    1.43868019e-04f, 1.44209567e-04f, 1.44551901e-04f, 1.44894919e-04f,
+    1.45238708e-04f, 1.45583297e-04f, 1.45928600e-04f, 1.46274717e-04f,
+    1.46621533e-04f, 1.46969105e-04f, 1.47317463e-04f, 1.47666593e-04f,
+    1.48016494e-04f, 1.48367108e-04f, 1.48718536e-04f, 1.49070751e-04f,
+    1.49423708e-04f, 1.49777479e-04f, 1.50131964e-04f, 1.50487263e-04f,
+    1.50843349e-04f, 1.51200191e-04f, 1.51557877e-04f, 1.51916262e-04f,
+    1.52275461e-04f, 1.52635490e-04f, 1.52996261e-04f, 1.53357905e-04f,
+    1.53720233e-04f, 1.54083391e-04f, 1.54447378e-04f, 1.54812122e-04f,
+    1.55177753e-04f, 1.55544069e-04f, 1.55911242e-04f, 1.56279246e-04f,
+    1.56648020e-04f, 1.57017697e-04f, 1.57388073e-04f, 1.57759277e-04f,
+    1.58131341e-04f, 1.58504190e-04f, 1.58877898e-04f, 1.59252362e-04f,
+    1.59627685e-04f, 1.60003852e-04f, 1.60380820e-04f, 1.60758675e-04f,
+    1.61137272e-04f, 1.61516728e-04f, 1.61897056e-04f, 1.62278171e-04f,
+    1.62660173e-04f, 1.63042962e-04f, 1.63426594e-04f, 1.63811128e-04f,
+    1.64196448e-04f, 1.64582700e-04f, 1.64969708e-04f, 1.65357604e-04f,
+    1.65746373e-04f, 1.66135957e-04f, 1.66526443e-04f, 1.66917729e-04f,
+    1.67309918e-04f, 1.67702980e-04f, 1.68096871e-04f, 1.68491708e-04f,
+    1.68887302e-04f, 1.69283798e-04f, 1.69681211e-04f, 1.70079467e-04f,
+    1.70478685e-04f, 1.70878659e-04f, 1.71279549e-04f, 1.71681357e-04f,
+    1.72084008e-04f, 1.72487620e-04f, 1.72892032e-04f, 1.73297347e-04f,
+    1.73703607e-04f, 1.74110697e-04f, 1.74518776e-04f, 1.74927671e-04f,
+    1.75337467e-04f, 1.75748224e-04f, 1.76159840e-04f, 1.76572430e-04f,
+    1.76985850e-04f, 1.77400187e-04f, 1.77815469e-04f, 1.78231669e-04f,
+    1.78648828e-04f, 1.79066788e-04f, 1.79485723e-04f, 1.79905634e-04f,
+    1.80326431e-04f, 1.80748204e-04f, 1.81170806e-04f, 1.81594412e-04f,
+    1.82018965e-04f, 1.82444390e-04f, 1.82870848e-04f, 1.83298151e-04f,
+    1.83726443e-04f, 1.84155695e-04f, 1.84585879e-04f, 1.85017052e-04f,
+    1.85449069e-04f, 1.85882091e-04f, 1.86316131e-04f, 1.86751058e-04f,
+    1.87187034e-04f, 1.87623897e-04f, 1.88061735e-04f, 1.88500533e-04f,
+    1.88940321e-04f, 1.89381128e-04f, 1.89822822e-04f, 1.90265506e-04f,
+    1.90709208e-04f, 1.91153857e-04f, 1.91599567e-04f, 1.92046136e-04f,
+    1.92493739e-04f, 1.92942418e-04f, 1.93391999e-04f, 1.93842672e-04f,
+    1.94294189e-04f, 1.94746797e-04f, 1.95200395e-04f, 1.95654997e-04f,
+    1.96110646e-04f, 1.96567256e-04f, 1.97024856e-04f, 1.97483503e-04f,
+    1.97943169e-04f, 1.98403883e-04f, 1.98865557e-04f, 1.99328235e-04f,
+    1.99792034e-04f, 2.00256793e-04f, 2.00722658e-04f, 2.01189439e-04f,
+    2.01657283e-04f, 2.02126204e-04f, 2.02596144e-04f, 2.03067204e-04f,
+    2.03539181e-04f, 2.04012293e-04f, 2.04486423e-04f, 2.04961587e-04f,
+    2.05437871e-04f, 2.05915145e-04f, 2.06393495e-04f, 2.06872937e-04f,
+    2.07353398e-04f, 2.07835008e-04f, 2.08317564e-04f, 2.08801241e-04f,
+    2.09286023e-04f, 2.09771853e-04f, 2.10258819e-04f, 2.10746788e-04f,
+    2.11235849e-04f, 2.11726016e-04f, 2.12217288e-04f, 2.12709710e-04f,
+    2.13203079e-04f, 2.13697611e-04f, 2.14193264e-04f, 2.14690022e-04f,
+    2.15187931e-04f, 2.15686814e-04f, 2.16186862e-04f, 2.16688088e-04f,
+    2.17190362e-04f, 2.17693829e-04f, 2.18198300e-04f, 2.18703964e-04f,
+    2.19210749e-04f, 2.19718655e-04f, 2.20227754e-04f, 2.20737871e-04f,
+    2.21249182e-04f, 2.21761686e-04f, 2.22275223e-04f, 2.22790055e-04f,
+    2.23305862e-04f, 2.23822877e-04f, 2.24341085e-04f, 2.24860443e-04f,
+    2.25381009e-04f, 2.25902608e-04f, 2.26425414e-04f, 2.26949429e-04f,
+    2.27474549e-04f, 2.28000936e-04f, 2.28528428e-04f, 2.29057085e-04f,
+    2.29586964e-04f, 2.30118007e-04f, 2.30650272e-04f, 2.31183643e-04f,
+    2.31718252e-04f, 2.32254082e-04f, 2.32791048e-04f, 2.33329352e-04f,
+    2.33868661e-04f, 2.34409265e-04f, 2.34951105e-04f, 2.35494139e-04f,
+    2.36038410e-04f, 2.36583815e-04f, 2.37130473e-04f, 2.37678440e-04f,
+    2.38227542e-04f, 2.38777953e-04f, 2.39329500e-04f, 2.39882313e-04f,
+    2.40436391e-04f, 2.40991663e-04f, 2.41548274e-04f, 2.42106020e-04f,
+    2.42665046e-04f, 2.43225339e-04f, 2.43786853e-04f, 2.44349765e-04f,
+    2.44913768e-04f, 2.45479052e-04f, 2.46045674e-04f, 2.46613519e-04f,
+    2.47182732e-04f, 2.47753080e-04f, 2.48324737e-04f, 2.48897763e-04f,
+    2.49472010e-04f, 2.50047626e-04f, 2.50624405e-04f, 2.51202553e-04f,
+    2.51782010e-04f, 2.52362719e-04f, 2.52944854e-04f, 2.53528095e-04f,
+    2.54112732e-04f, 2.54698738e-04f, 2.55286024e-04f, 2.55874736e-04f,
+    2.56464584e-04f, 2.57055828e-04f, 2.57648469e-04f, 2.58242362e-04f,
+    2.58837652e-04f, 2.59434222e-04f, 2.60032131e-04f, 2.60631437e-04f,
+    2.61231995e-04f, 2.61834066e-04f, 2.62437330e-04f, 2.63042020e-04f,
+    2.63648137e-04f, 2.64255505e-04f, 2.64864386e-04f, 2.65474489e-04f,
+    2.66086019e-04f, 2.66698917e-04f, 2.67313240e-04f, 2.67929019e-04f,
+    2.68545991e-04f, 2.69164448e-04f, 2.69784301e-04f, 2.70405581e-04f,
+    2.71028286e-04f, 2.71652301e-04f, 2.72277772e-04f, 2.72904610e-04f,
+    2.73532933e-04f, 2.74162710e-04f, 2.74793798e-04f, 2.75426282e-04f,
+    2.76060338e-04f, 2.76695762e-04f, 2.77332700e-04f, 2.77970918e-04f,
+    2.78610649e-04f, 2.79251864e-04f, 2.79894477e-04f, 2.80538690e-04f,
+    2.81184126e-04f, 2.81831162e-04f, 2.82479683e-04f, 2.83129542e-04f,
+    2.83781061e-04f, 2.84433860e-04f, 2.85088259e-04f, 2.85744143e-04f,
+    2.86401424e-04f, 2.87060335e-04f, 2.87720643e-04f, 2.88382376e-04f,
+    2.89045711e-04f, 2.89710588e-04f, 2.90376978e-04f, 2.91044737e-04f,
+    2.91714066e-04f, 2.92384997e-04f, 2.93057325e-04f, 2.93731340e-04f,
+    2.94406753e-04f, 2.95083708e-04f, 2.95762293e-04f, 2.96442304e-04f,
+    2.97124003e-04f, 2.97807099e-04f, 2.98491796e-04f, 2.99178093e-04f,
+    2.99865904e-04f, 3.00555403e-04f, 3.01246298e-04f, 3.01938766e-04f,
+    3.02632921e-04f, 3.03328590e-04f, 3.04025976e-04f, 3.04724730e-04f,
+    3.05425172e-04f, 3.06127244e-04f, 3.06830916e-04f, 3.07536218e-04f,
+    3.08243005e-04f, 3.08951450e-04f, 3.09661555e-04f, 3.10373260e-04f,
+    3.11086682e-04f, 3.11801559e-04f, 3.12518125e-04f, 3.13236378e-04f,
+    3.13956232e-04f, 3.14677774e-04f, 3.15400859e-04f, 3.16125632e-04f,
+    3.16852122e-04f, 3.17580241e-04f, 3.18310078e-04f, 3.19041457e-04f,
+    3.19774583e-04f, 3.20509396e-04f, 3.21245840e-04f, 3.21984116e-04f,
+    3.22723878e-04f, 3.23465385e-04f, 3.24208668e-04f, 3.24953609e-04f,
+    3.25700326e-04f, 3.26448615e-04f, 3.27198650e-04f, 3.27950460e-04f,
+    3.28703958e-04f, 3.29459319e-04f, 3.30216193e-04f, 3.30974872e-04f,
+    3.31735355e-04f, 3.32497555e-04f, 3.33261589e-04f, 3.34027194e-04f,
+    3.34794604e-04f, 3.35563847e-04f, 3.36334837e-04f, 3.37107660e-04f,
+    3.37882113e-04f, 3.38658370e-04f, 3.39436490e-04f, 3.40216357e-04f,
+    3.40998144e-04f, 3.41781502e-04f, 3.42566724e-04f, 3.43353866e-04f,
+    3.44142696e-04f, 3.44933535e-04f, 3.45725915e-04f, 3.46520275e-04f,
+    3.47316469e-04f, 3.48114467e-04f, 3.48914386e-04f, 3.49716051e-04f,
+    3.50519520e-04f, 3.51324939e-04f, 3.52132192e-04f, 3.52941395e-04f,
+    3.53752286e-04f, 3.54565069e-04f, 3.55379889e-04f, 3.56196426e-04f,
+    3.57015000e-04f, 3.57835350e-04f, 3.58657591e-04f, 3.59481812e-04f,
+    3.60307837e-04f, 3.61135928e-04f, 3.61965736e-04f, 3.62797524e-04f,
+    3.63631319e-04f, 3.64467007e-04f, 3.65304673e-04f, 3.66144173e-04f,
+    3.66985594e-04f, 3.67829110e-04f, 3.68674460e-04f, 3.69521906e-04f,
+    3.70371155e-04f, 3.71222355e-04f, 3.72075679e-04f, 3.72930866e-04f,
+    3.73788236e-04f, 3.74647323e-04f, 3.75508505e-04f, 3.76371725e-04f,
+    3.77236895e-04f, 3.78104247e-04f, 3.78973375e-04f, 3.79844569e-04f,
+    3.80717858e-04f, 3.81593185e-04f, 3.82470578e-04f, 3.83349892e-04f,
+    3.84231244e-04f, 3.85114748e-04f, 3.86000233e-04f, 3.86887958e-04f,
+    3.87777487e-04f, 3.88669199e-04f, 3.89563036e-04f, 3.90458852e-04f,
+    3.91356938e-04f, 3.92256916e-04f, 3.93159018e-04f, 3.94063361e-04f,
+    3.94969684e-04f, 3.95878305e-04f, 3.96788761e-04f, 3.97701515e-04f,
+    3.98616365e-04f, 3.99533368e-04f, 4.00452642e-04f, 4.01373807e-04f,
+    4.02297184e-04f, 4.03222861e-04f, 4.04150574e-04f, 4.05080587e-04f,
+    4.06012579e-04f, 4.06946870e-04f, 4.07883344e-04f, 4.08821972e-04f,
+    4.09762957e-04f, 4.10705950e-04f, 4.11651185e-04f, 4.12598718e-04f,
+    4.13548347e-04f, 4.14500420e-04f, 4.15454473e-04f, 4.16410854e-04f,
+    4.17369534e-04f, 4.18330426e-04f, 4.19293705e-04f, 4.20258992e-04f,
+    4.21226607e-04f, 4.22196637e-04f, 4.23168822e-04f, 4.24143422e-04f,
+    4.25120117e-04f, 4.26099228e-04f, 4.27080668e-04f, 4.28064319e-04f,
+    4.29050502e-04f, 4.30038723e-04f, 4.31029330e-04f, 4.32022411e-04f,
+    4.33017733e-04f, 4.34015557e-04f, 4.35015478e-04f, 4.36017843e-04f,
+    4.37022623e-04f, 4.38029732e-04f, 4.39039373e-04f, 4.40051139e-04f,
+    4.41065349e-04f, 4.42082091e-04f, 4.43101133e-04f, 4.44122707e-04f,
+    4.45146521e-04f, 4.46172809e-04f, 4.47201543e-04f, 4.48232691e-04f,
+    4.49266430e-04f, 4.50302323e-04f, 4.51340777e-04f, 4.52381821e-04f,
+    4.53425222e-04f, 4.54471214e-04f, 4.55519476e-04f, 4.56570328e-04f,
+    4.57623712e-04f, 4.58679482e-04f, 4.59738018e-04f, 4.60798707e-04f,
+    4.61862102e-04f, 4.62928030e-04f, 4.63996374e-04f, 4.65067511e-04f,
+    4.66140918e-04f, 4.67216887e-04f, 4.68295591e-04f, 4.69376711e-04f,
+    4.70460596e-04f, 4.71546839e-04f, 4.72635671e-04f, 4.73727210e-04f,
+    4.74821252e-04f, 4.75918117e-04f, 4.77017311e-04f, 4.78119269e-04f,
+    4.79223818e-04f, 4.80331015e-04f, 4.81440977e-04f, 4.82553296e-04f,
+    4.83668380e-04f, 4.84786200e-04f, 4.85906698e-04f, 4.87029960e-04f,
+    4.88155638e-04f, 4.89284110e-04f, 4.90415317e-04f, 4.91549261e-04f,
+    4.92685998e-04f, 4.93825180e-04f, 4.94967215e-04f, 4.96112101e-04f,
+    4.97259607e-04f, 4.98410023e-04f, 4.99562884e-04f, 5.00718656e-04f,
+    5.01877279e-04f, 5.03038580e-04f, 5.04202850e-04f, 5.05369622e-04f,
+    5.06539363e-04f, 5.07711840e-04f, 5.08887228e-04f, 5.10065467e-04f,
+    5.11246384e-04f, 5.12430153e-04f, 5.13616833e-04f, 5.14806306e-04f,
+    5.15998865e-04f, 5.17193926e-04f, 5.18392131e-04f, 5.19593130e-04f,
+    5.20796981e-04f, 5.22003975e-04f, 5.23213530e-04f, 5.24426054e-04f,
+    5.25641663e-04f, 5.26860124e-04f, 5.28081669e-04f, 5.29305893e-04f,
+    5.30533143e-04f, 5.31763479e-04f, 5.32996666e-04f, 5.34233113e-04f,
+    5.35472122e-04f, 5.36714331e-04f, 5.37959568e-04f, 5.39207773e-04f,
+    5.40459121e-04f, 5.41713205e-04f, 5.42970432e-04f, 5.44230861e-04f,
+    5.45494200e-04f, 5.46760799e-04f, 5.48030133e-04f, 5.49302727e-04f,
+    5.50578465e-04f, 5.51857171e-04f, 5.53139253e-04f, 5.54424070e-04f,
+    5.55712148e-04f, 5.57003426e-04f, 5.58297732e-04f, 5.59595472e-04f,
+    5.60895889e-04f, 5.62199682e-04f, 5.63506794e-04f, 5.64816932e-04f,
+    5.66130388e-04f, 5.67446812e-04f, 5.68766613e-04f, 5.70089556e-04f,
+    5.71415701e-04f, 5.72745339e-04f, 5.74077829e-04f, 5.75413753e-04f,
+    5.76752936e-04f, 5.78095438e-04f, 5.79441257e-04f, 5.80790162e-04f,
+    5.82142326e-04f, 5.83497982e-04f, 5.84856956e-04f, 5.86219365e-04f,
+    5.87584800e-04f, 5.88953553e-04f, 5.90325857e-04f, 5.91701537e-04f,
+    5.93080709e-04f, 5.94462850e-04f, 5.95848600e-04f, 5.97237726e-04f,
+    5.98630286e-04f, 6.00026513e-04f, 6.01425651e-04f, 6.02828397e-04f,
+    6.04234810e-04f, 6.05644484e-04f, 6.07057824e-04f, 6.08474365e-04f,
+    6.09894400e-04f, 6.11318043e-04f, 6.12745236e-04f, 6.14175980e-04f,
+    6.15609926e-04f, 6.17047655e-04f, 6.18488935e-04f, 6.19933649e-04f,
+    6.21382147e-04f, 6.22833904e-04f, 6.24289329e-04f, 6.25748478e-04f,
+    6.27211120e-04f, 6.28677604e-04f, 6.30147348e-04f, 6.31620875e-04f,
+    6.33098069e-04f, 6.34578872e-04f, 6.36063458e-04f, 6.37551537e-04f,
+    6.39043341e-04f, 6.40538929e-04f, 6.42038067e-04f, 6.43541163e-04f,
+    6.45047636e-04f, 6.46558008e-04f, 6.48072280e-04f, 6.49590220e-04f,
+    6.51112059e-04f, 6.52637274e-04f, 6.54166448e-04f, 6.55699580e-04f,
+    6.57236262e-04f, 6.58777135e-04f, 6.60321501e-04f, 6.61869708e-04f,
+    6.63421932e-04f, 6.64977997e-04f, 6.66538079e-04f, 6.68101595e-04f,
+    6.69669360e-04f, 6.71240967e-04f, 6.72816357e-04f, 6.74395997e-04f,
+    6.75979129e-04f, 6.77566451e-04f, 6.79157791e-04f, 6.80753030e-04f,
+    6.82352402e-04f, 6.83955499e-04f, 6.85562729e-04f, 6.87173917e-04f,
+    6.88789296e-04f, 6.90408808e-04f, 6.92031928e-04f, 6.93659415e-04f,
+    6.95290917e-04f, 6.96926436e-04f, 6.98566379e-04f, 7.00209930e-04f,
+    7.01857847e-04f, 7.03510013e-04f, 7.05166196e-04f, 7.06826744e-04f,
+    7.08491134e-04f, 7.10159773e-04f, 7.11832719e-04f, 7.13509740e-04f,
+    7.15191301e-04f, 7.16876646e-04f, 7.18566414e-04f, 7.20260607e-04f,
+    7.21958815e-04f, 7.23661680e-04f, 7.25368329e-04f, 7.27079518e-04f,
+    7.28795014e-04f, 7.30514876e-04f, 7.32239278e-04f, 7.33967521e-04f,
+    7.35700422e-04f, 7.37437746e-04f, 7.39179377e-04f, 7.40925607e-04f,
+    7.42675911e-04f, 7.44430814e-04f, 7.46190140e-04f, 7.47953949e-04f,
+    7.49722472e-04f, 7.51495070e-04f, 7.53272208e-04f, 7.55054061e-04f,
+    7.56840163e-04f, 7.58631213e-04f, 7.60426396e-04f, 7.62226293e-04f,
+    7.64030730e-04f, 7.65839766e-04f, 7.67653750e-04f, 7.69471750e-04f,
+    7.71294639e-04f, 7.73122185e-04f, 7.74954387e-04f, 7.76791479e-04f,
+    7.78632646e-04f, 7.80478877e-04f, 7.82329822e-04f, 7.84185540e-04f,
+    7.86046206e-04f, 7.87911005e-04f, 7.89780868e-04f, 7.91655562e-04f,
+    7.93535088e-04f, 7.95419561e-04f, 7.97308399e-04f, 7.99202302e-04f,
+    8.01101152e-04f, 8.03004776e-04f, 8.04913405e-04f, 8.06826632e-04f,
+    8.08744924e-04f, 8.10668163e-04f, 8.12596350e-04f, 8.14529601e-04f,
+    8.16467335e-04f, 8.18410423e-04f, 8.20358458e-04f, 8.22311500e-04f,
+    8.24269722e-04f, 8.26232659e-04f, 8.28200602e-04f, 8.30173958e-04f,
+    8.32152204e-04f, 8.34135746e-04f, 8.36124003e-04f, 8.38117674e-04f,
+    8.40116525e-04f, 8.42120324e-04f, 8.44129594e-04f, 8.46143696e-04f,
+    8.48163152e-04f, 8.50187731e-04f, 8.52217781e-04f, 8.54253187e-04f,
+    8.56293249e-04f, 8.58338957e-04f, 8.60390079e-04f, 8.62446264e-04f,
+    8.64508154e-04f, 8.66574934e-04f, 8.68647185e-04f, 8.70724965e-04f,
+    8.72808101e-04f, 8.74896941e-04f, 8.76990613e-04f, 8.79089814e-04f,
+    8.81194777e-04f, 8.83304980e-04f, 8.85421177e-04f, 8.87542265e-04f,
+    8.89668940e-04f, 8.91801319e-04f, 8.93939345e-04f, 8.96083075e-04f,
+    8.98231869e-04f, 9.00386425e-04f, 9.02546919e-04f, 9.04712710e-04f,
+    9.06884496e-04f, 9.09061695e-04f, 9.11244424e-04f, 9.13433207e-04f,
+    9.15627636e-04f, 9.17828060e-04f, 9.20033548e-04f, 9.22245323e-04f,
+    9.24462744e-04f, 9.26686102e-04f, 9.28915397e-04f, 9.31149756e-04f,
+    9.33391100e-04f, 9.35637625e-04f, 9.37890087e-04f, 9.40148544e-04f,
+    9.42412822e-04f, 9.44683794e-04f, 9.46959946e-04f, 9.49242385e-04f,
+    9.51530703e-04f, 9.53824609e-04f, 9.56125790e-04f, 9.58431978e-04f,
+    9.60744568e-04f, 9.63063270e-04f, 9.65387735e-04f, 9.67719301e-04f,
+    9.70056164e-04f, 9.72399488e-04f, 9.74748866e-04f, 9.77104297e-04f,
+    9.79466829e-04f, 9.81834834e-04f, 9.84209124e-04f, 9.86589934e-04f,
+    9.88976681e-04f, 9.91370645e-04f, 9.93770198e-04f, 9.96176037e-04f,
+    9.98588628e-04f, 1.00100716e-03f, 1.00343325e-03f, 1.00586470e-03f,
+    1.00830290e-03f, 1.01074751e-03f, 1.01319852e-03f, 1.01565698e-03f,
+    1.01812079e-03f, 1.02059159e-03f, 1.02306914e-03f, 1.02555274e-03f,
+    1.02804415e-03f, 1.03054126e-03f, 1.03304512e-03f, 1.03555585e-03f,
+    1.03807310e-03f, 1.04059768e-03f, 1.04312843e-03f, 1.04566605e-03f,
+    1.04821031e-03f, 1.05076132e-03f, 1.05332013e-03f, 1.05588476e-03f,
+    1.05845660e-03f, 1.06103544e-03f, 1.06362079e-03f, 1.06621394e-03f,
+    1.06881338e-03f, 1.07141992e-03f, 1.07403332e-03f, 1.07665360e-03f,
+    1.07928214e-03f, 1.08191650e-03f, 1.08455820e-03f, 1.08720711e-03f,
+    1.08986301e-03f, 1.09252695e-03f, 1.09519705e-03f, 1.09787472e-03f,
+    1.10055960e-03f, 1.10325147e-03f, 1.10595149e-03f, 1.10865803e-03f,
+    1.11137214e-03f, 1.11409335e-03f, 1.11682178e-03f, 1.11955870e-03f,
+    1.12230203e-03f, 1.12505280e-03f, 1.12781138e-03f, 1.13057706e-03f,
+    1.13335124e-03f, 1.13613193e-03f, 1.13892043e-03f, 1.14171673e-03f,
+    1.14452012e-03f, 1.14733237e-03f, 1.15015090e-03f, 1.15297781e-03f,
+    1.15581206e-03f, 1.15865387e-03f, 1.16150454e-03f, 1.16436195e-03f,
+    1.16722740e-03f, 1.17010076e-03f, 1.17298146e-03f, 1.17587147e-03f,
+    1.17876811e-03f, 1.18167303e-03f, 1.18458574e-03f, 1.18750602e-03f,
+    1.19043572e-03f, 1.19337230e-03f, 1.19631703e-03f, 1.19927002e-03f,
+    1.20223104e-03f, 1.20520114e-03f, 1.20817800e-03f, 1.21116347e-03f,
+    1.21415732e-03f, 1.21715898e-03f, 1.22017018e-03f, 1.22318824e-03f,
+    1.22621539e-03f, 1.22925034e-03f, 1.23229378e-03f, 1.23534666e-03f,
+    1.23840687e-03f, 1.24147558e-03f, 1.24455290e-03f, 1.24763849e-03f,
+    1.25073374e-03f, 1.25383632e-03f, 1.25694787e-03f, 1.26006815e-03f,
+    1.26319646e-03f, 1.26633502e-03f, 1.26948091e-03f, 1.27263565e-03f,
+    1.27579959e-03f, 1.27897167e-03f, 1.28215400e-03f, 1.28534355e-03f,
+    1.28854276e-03f, 1.29175058e-03f, 1.29496702e-03f, 1.29819394e-03f,
+    1.30142854e-03f, 1.30467210e-03f, 1.30792486e-03f, 1.31118670e-03f,
+    1.31445879e-03f, 1.31773867e-03f, 1.32102810e-03f, 1.32432638e-03f,
+    1.32763397e-03f, 1.33095193e-03f, 1.33427815e-03f, 1.33761368e-03f,
+    1.34095864e-03f, 1.34431291e-03f, 1.34767778e-03f, 1.35105068e-03f,
+    1.35443336e-03f, 1.35782571e-03f, 1.36122713e-03f, 1.36463961e-03f,
+    1.36806013e-03f, 1.37149077e-03f, 1.37493107e-03f, 1.37838069e-03f,
+    1.38184149e-03f, 1.38531055e-03f, 1.38878974e-03f, 1.39227882e-03f,
+    1.39577733e-03f, 1.39928714e-03f, 1.40280544e-03f, 1.40633434e-03f,
+    1.40987290e-03f, 1.41342147e-03f, 1.41698110e-03f, 1.42054970e-03f,
+    1.42412877e-03f, 1.42771797e-03f, 1.43131684e-03f, 1.43492757e-03f,
+    1.43854728e-03f, 1.44217710e-03f, 1.44581776e-03f, 1.44946820e-03f,
+    1.45313062e-03f, 1.45680178e-03f, 1.46048376e-03f, 1.46417657e-03f,
+    1.46787940e-03f, 1.47159444e-03f, 1.47531822e-03f, 1.47905352e-03f,
+    1.48279907e-03f, 1.48655509e-03f, 1.49032346e-03f, 1.49410102e-03f,
+    1.49788987e-03f, 1.50168955e-03f, 1.50549971e-03f, 1.50932244e-03f,
+    1.51315460e-03f, 1.51699793e-03f, 1.52085244e-03f, 1.52471778e-03f,
+    1.52859569e-03f, 1.53248350e-03f, 1.53638236e-03f, 1.54029287e-03f,
+    1.54421409e-03f, 1.54814834e-03f, 1.55209214e-03f, 1.55604794e-03f,
+    1.56001502e-03f, 1.56399328e-03f, 1.56798470e-03f, 1.57198589e-03f,
+    1.57599919e-03f, 1.58002402e-03f, 1.58406037e-03f, 1.58810976e-03f,
+    1.59216940e-03f, 1.59624126e-03f, 1.60032499e-03f, 1.60442002e-03f,
+    1.60852878e-03f, 1.61264779e-03f, 1.61677902e-03f, 1.62092247e-03f,
+    1.62507757e-03f, 1.62924652e-03f, 1.63342594e-03f, 1.63761771e-03f,
+    1.64182193e-03f, 1.64603803e-03f, 1.65026833e-03f, 1.65450899e-03f,
+    1.65876257e-03f, 1.66302861e-03f, 1.66730687e-03f, 1.67159922e-03f,
+    1.67590252e-03f, 1.68021885e-03f, 1.68454787e-03f, 1.68888923e-03f,
+    1.69324502e-03f, 1.69761188e-03f, 1.70199224e-03f, 1.70638517e-03f,
+    1.71079079e-03f, 1.71521131e-03f, 1.71964278e-03f, 1.72408787e-03f,
+    1.72854611e-03f, 1.73301715e-03f, 1.73750322e-03f, 1.74200046e-03f,
+    1.74651179e-03f, 1.75103638e-03f, 1.75557390e-03f, 1.76012667e-03f,
+    1.76469132e-03f, 1.76926982e-03f, 1.77386182e-03f, 1.77846698e-03f,
+    1.78308797e-03f, 1.78772060e-03f, 1.79236731e-03f, 1.79702812e-03f,
+    1.80170231e-03f, 1.80639233e-03f, 1.81109435e-03f, 1.81581115e-03f,
+    1.82054180e-03f, 1.82528596e-03f, 1.83004653e-03f, 1.83481933e-03f,
+    1.83960691e-03f, 1.84440869e-03f, 1.84922433e-03f, 1.85405661e-03f,
+    1.85890135e-03f, 1.86376099e-03f, 1.86863530e-03f, 1.87352381e-03f,
+    1.87842897e-03f, 1.88334670e-03f, 1.88827992e-03f, 1.89322804e-03f,
+    1.89819047e-03f, 1.90317002e-03f, 1.90816249e-03f, 1.91317045e-03f,
+    1.91819353e-03f, 1.92323152e-03f, 1.92828651e-03f, 1.93335512e-03f,
+    1.93843897e-03f, 1.94353831e-03f, 1.94865302e-03f, 1.95378531e-03f,
+    1.95893110e-03f, 1.96409249e-03f, 1.96926971e-03f, 1.97446253e-03f,
+    1.97967305e-03f, 1.98489754e-03f, 1.99013809e-03f, 1.99539424e-03f,
+    2.00066692e-03f, 2.00595730e-03f, 2.01126188e-03f, 2.01658299e-03f,
+    2.02191970e-03f, 2.02727318e-03f, 2.03264505e-03f, 2.03803112e-03f,
+    2.04343419e-03f, 2.04885309e-03f, 2.05428898e-03f, 2.05974374e-03f,
+    2.06521293e-03f, 2.07069912e-03f, 2.07620207e-03f, 2.08172179e-03f,
+    2.08726083e-03f, 2.09281477e-03f, 2.09838571e-03f, 2.10397411e-03f,
+    2.10957951e-03f, 2.11520423e-03f, 2.12084455e-03f, 2.12650211e-03f,
+    2.13217689e-03f, 2.13786960e-03f, 2.14358186e-03f, 2.14930973e-03f,
+    2.15505529e-03f, 2.16081901e-03f, 2.16660020e-03f, 2.17240164e-03f,
+    2.17821891e-03f, 2.18405435e-03f, 2.18990794e-03f, 2.19577993e-03f,
+    2.20167194e-03f, 2.20758049e-03f, 2.21350719e-03f, 2.21945276e-03f,
+    2.22541648e-03f, 2.23140116e-03f, 2.23740260e-03f, 2.24342267e-03f,
+    2.24946160e-03f, 2.25551915e-03f, 2.26159813e-03f, 2.26769387e-03f,
+    2.27380893e-03f, 2.27994332e-03f, 2.28609680e-03f, 2.29227147e-03f,
+    2.29846383e-03f, 2.30467529e-03f, 2.31090654e-03f, 2.31715734e-03f,
+    2.32343050e-03f, 2.32972065e-03f, 2.33603129e-03f, 2.34236126e-03f,
+    2.34871148e-03f, 2.35508382e-03f, 2.36147456e-03f, 2.36788485e-03f,
+    2.37431610e-03f, 2.38076737e-03f, 2.38724169e-03f, 2.39373418e-03f,
+    2.40024715e-03f, 2.40678084e-03f, 2.41333549e-03f, 2.41991342e-03f,
+    2.42650928e-03f, 2.43312679e-03f, 2.43976526e-03f, 2.44642515e-03f,
+    2.45310809e-03f, 2.45981058e-03f, 2.46653426e-03f, 2.47327937e-03f,
+    2.48004613e-03f, 2.48683733e-03f, 2.49364739e-03f, 2.50047981e-03f,
+    2.50733364e-03f, 2.51420983e-03f, 2.52111047e-03f, 2.52803089e-03f,
+    2.53497344e-03f, 2.54193833e-03f, 2.54892558e-03f, 2.55593797e-03f,
+    2.56297085e-03f, 2.57002609e-03f, 2.57710414e-03f, 2.58420524e-03f,
+    2.59133172e-03f, 2.59847869e-03f, 2.60564871e-03f, 2.61284201e-03f,
+    2.62005883e-03f, 2.62730173e-03f, 2.63456535e-03f, 2.64185271e-03f,
+    2.64916359e-03f, 2.65649823e-03f, 2.66385986e-03f, 2.67124246e-03f,
+    2.67864903e-03f, 2.68607982e-03f, 2.69353483e-03f, 2.70101754e-03f,
+    2.70852144e-03f, 2.71604955e-03f, 2.72360281e-03f, 2.73118098e-03f,
+    2.73878616e-03f, 2.74641369e-03f, 2.75406661e-03f, 2.76174466e-03f,
+    2.76944786e-03f, 2.77717924e-03f, 2.78493250e-03f, 2.79271230e-03f,
+    2.80051725e-03f, 2.80834828e-03f, 2.81620747e-03f, 2.82409019e-03f,
+    2.83199875e-03f, 2.83993362e-03f, 2.84789479e-03f, 2.85588531e-03f,
+    2.86389934e-03f, 2.87193968e-03f, 2.88000680e-03f, 2.88810069e-03f,
+    2.89622461e-03f, 2.90437229e-03f, 2.91254744e-03f, 2.92074983e-03f,
+    2.92897923e-03f, 2.93723936e-03f, 2.94552348e-03f, 2.95383600e-03f,
+    2.96217576e-03f, 2.97054416e-03f, 2.97894282e-03f, 2.98736710e-03f,
+    2.99581909e-03f, 3.00429924e-03f, 3.01280874e-03f, 3.02134920e-03f,
+    3.02991574e-03f, 3.03851091e-03f, 3.04713473e-03f, 3.05578811e-03f,
+    3.06447293e-03f, 3.07318498e-03f, 3.08192568e-03f, 3.09069594e-03f,
+    3.09949601e-03f, 3.10832891e-03f, 3.11718858e-03f, 3.12607829e-03f,
+    3.13499826e-03f, 3.14394850e-03f, 3.15293204e-03f, 3.16194305e-03f,
+    3.17098480e-03f, 3.18005728e-03f, 3.18916049e-03f, 3.19829769e-03f,
+    3.20746307e-03f, 3.21665965e-03f, 3.22588766e-03f, 3.23514687e-03f,
+    3.24444170e-03f, 3.25376447e-03f, 3.26311961e-03f, 3.27250664e-03f,
+    3.28192534e-03f, 3.29138059e-03f, 3.30086448e-03f, 3.31038074e-03f,
+    3.31992959e-03f, 3.32951173e-03f, 3.33913020e-03f, 3.34877823e-03f,
+    3.35845957e-03f, 3.36817466e-03f, 3.37792328e-03f, 3.38770868e-03f,
+    3.39752436e-03f, 3.40737402e-03f, 3.41725815e-03f, 3.42717627e-03f,
+    3.43713281e-03f, 3.44711961e-03f, 3.45714134e-03f, 3.46719800e-03f,
+    3.47728981e-03f, 3.48742027e-03f, 3.49758216e-03f, 3.50777991e-03f,
+    3.51801305e-03f, 3.52828158e-03f, 3.53859016e-03f, 3.54893133e-03f,
+    3.55930789e-03f, 3.56972124e-03f, 3.58017068e-03f, 3.59066157e-03f,
+    3.60118458e-03f, 3.61174485e-03f, 3.62234213e-03f, 3.63297621e-03f,
+    3.64365266e-03f, 3.65436240e-03f, 3.66510963e-03f, 3.67589458e-03f,
+    3.68671841e-03f, 3.69758415e-03f, 3.70848412e-03f, 3.71942273e-03f,
+    3.73040000e-03f, 3.74141638e-03f, 3.75247584e-03f, 3.76357045e-03f,
+    3.77470464e-03f, 3.78587819e-03f, 3.79709154e-03f, 3.80834937e-03f,
+    3.81964259e-03f, 3.83097632e-03f, 3.84235010e-03f, 3.85376485e-03f,
+    3.86522477e-03f, 3.87672172e-03f, 3.88825918e-03f, 3.89983854e-03f,
+    3.91145935e-03f, 3.92312557e-03f, 3.93482996e-03f, 3.94657627e-03f,
+    3.95836448e-03f, 3.97019600e-03f, 3.98207363e-03f, 3.99399037e-03f,
+    4.00594948e-03f, 4.01795236e-03f, 4.02999809e-03f, 4.04209225e-03f,
+    4.05422552e-03f, 4.06640349e-03f, 4.07862430e-03f, 4.09089075e-03f,
+    4.10320517e-03f, 4.11556056e-03f, 4.12796065e-03f, 4.14040592e-03f,
+    4.15289681e-03f, 4.16543661e-03f, 4.17801877e-03f, 4.19064611e-03f,
+    4.20332095e-03f, 4.21604095e-03f, 4.22881218e-03f, 4.24162624e-03f,
+    4.25448688e-03f, 4.26739454e-03f, 4.28034971e-03f, 4.29335702e-03f,
+    4.30640765e-03f, 4.31950623e-03f, 4.33265371e-03f, 4.34584916e-03f,
+    4.35909815e-03f, 4.37239092e-03f, 4.38573258e-03f, 4.39912500e-03f,
+    4.41256538e-03f, 4.42606211e-03f, 4.43960261e-03f, 4.45319386e-03f,
+    4.46683588e-03f, 4.48052865e-03f, 4.49427683e-03f, 4.50807111e-03f,
+    4.52191709e-03f, 4.53581521e-03f, 4.54976410e-03f, 4.56377119e-03f,
+    4.57782531e-03f, 4.59193205e-03f, 4.60609095e-03f, 4.62030387e-03f,
+    4.63457452e-03f, 4.64889407e-03f, 4.66326717e-03f, 4.67769476e-03f,
+    4.69217589e-03f, 4.70671756e-03f, 4.72130859e-03f, 4.73595504e-03f,
+    4.75065596e-03f, 4.76541277e-03f, 4.78023104e-03f, 4.79510007e-03f,
+    4.81002592e-03f, 4.82500717e-03f, 4.84004570e-03f, 4.85514710e-03f,
+    4.87030018e-03f, 4.88551194e-03f, 4.90077958e-03f, 4.91610775e-03f,
+    4.93149832e-03f, 4.94694291e-03f, 4.96244663e-03f, 4.97800857e-03f,
+    4.99363197e-03f, 5.00931917e-03f, 5.02506131e-03f, 5.04086493e-03f,
+    5.05672721e-03f, 5.07265236e-03f, 5.08864457e-03f, 5.10469172e-03f,
+    5.12080081e-03f, 5.13697229e-03f, 5.15320525e-03f, 5.16950898e-03f,
+    5.18586766e-03f, 5.20229153e-03f, 5.21877734e-03f, 5.23532880e-03f,
+    5.25194872e-03f, 5.26862917e-03f, 5.28537342e-03f, 5.30218240e-03f,
+    5.31905703e-03f, 5.33600478e-03f, 5.35301119e-03f, 5.37008513e-03f,
+    5.38722472e-03f, 5.40443184e-03f, 5.42171346e-03f, 5.43905515e-03f,
+    5.45646576e-03f, 5.47394482e-03f, 5.49149234e-03f, 5.50911576e-03f,
+    5.52680064e-03f, 5.54455724e-03f, 5.56238322e-03f, 5.58027858e-03f,
+    5.59825171e-03f, 5.61628956e-03f, 5.63439913e-03f, 5.65258088e-03f,
+    5.67083387e-03f, 5.68916695e-03f, 5.70756430e-03f, 5.72603708e-03f,
+    5.74458204e-03f, 5.76320104e-03f, 5.78190200e-03f, 5.80066908e-03f,
+    5.81951300e-03f, 5.83843142e-03f, 5.85742574e-03f, 5.87650202e-03f,
+    5.89564955e-03f, 5.91487251e-03f, 5.93417417e-03f, 5.95355267e-03f,
+    5.97301498e-03f, 5.99254994e-03f, 6.01216406e-03f, 6.03185780e-03f,
+    6.05162932e-03f, 6.07148884e-03f, 6.09142240e-03f, 6.11143559e-03f,
+    6.13153027e-03f, 6.15170598e-03f, 6.17197249e-03f, 6.19231304e-03f,
+    6.21273648e-03f, 6.23324187e-03f, 6.25383249e-03f, 6.27451530e-03f,
+    6.29527261e-03f, 6.31611701e-03f, 6.33704616e-03f, 6.35806145e-03f,
+    6.37916941e-03f, 6.40035747e-03f, 6.42163260e-03f, 6.44299341e-03f,
+    6.46444410e-03f, 6.48599118e-03f, 6.50761882e-03f, 6.52933540e-03f,
+    6.55114138e-03f, 6.57303818e-03f, 6.59503369e-03f, 6.61711162e-03f,
+    6.63928268e-03f, 6.66154409e-03f, 6.68389909e-03f, 6.70635467e-03f,
+    6.72889594e-03f, 6.75153127e-03f, 6.77426253e-03f, 6.79708645e-03f,
+    6.82001468e-03f, 6.84303138e-03f, 6.86614402e-03f, 6.88935351e-03f,
+    6.91265985e-03f, 6.93607330e-03f, 6.95957756e-03f, 6.98317820e-03f,
+    7.00687943e-03f, 7.03068264e-03f, 7.05459341e-03f, 7.07859546e-03f,
+    7.10270042e-03f, 7.12690875e-03f, 7.15121720e-03f, 7.17563834e-03f,
+    7.20015634e-03f, 7.22477678e-03f, 7.24950060e-03f, 7.27433199e-03f,
+    7.29927840e-03f, 7.32432259e-03f, 7.34947110e-03f, 7.37473043e-03f,
+    7.40009546e-03f, 7.42557878e-03f, 7.45116454e-03f, 7.47685740e-03f,
+    7.50266202e-03f, 7.52857700e-03f, 7.55461445e-03f, 7.58075388e-03f,
+    7.60700647e-03f, 7.63337128e-03f, 7.65985204e-03f, 7.68645573e-03f,
+    7.71316560e-03f, 7.73999142e-03f, 7.76693365e-03f, 7.79399229e-03f,
+    7.82117993e-03f, 7.84847513e-03f, 7.87589047e-03f, 7.90342502e-03f,
+    7.93107878e-03f, 7.95886479e-03f, 7.98676349e-03f, 8.01478233e-03f,
+    8.04292504e-03f, 8.07119161e-03f, 8.09959229e-03f, 8.12810753e-03f,
+    8.15674942e-03f, 8.18551704e-03f, 8.21441133e-03f, 8.24344531e-03f,
+    8.27259663e-03f, 8.30187649e-03f, 8.33128672e-03f, 8.36082734e-03f,
+    8.39051139e-03f, 8.42031464e-03f, 8.45025200e-03f, 8.48032068e-03f,
+    8.51052534e-03f, 8.54087714e-03f, 8.57135188e-03f, 8.60196445e-03f,
+    8.63271300e-03f, 8.66359938e-03f, 8.69463757e-03f, 8.72580241e-03f,
+    8.75710789e-03f, 8.78855493e-03f, 8.82014446e-03f, 8.85188673e-03f,
+    8.88376217e-03f, 8.91578104e-03f, 8.94794427e-03f, 8.98025464e-03f,
+    9.01272334e-03f, 9.04532801e-03f, 9.07808263e-03f, 9.11098346e-03f,
+    9.14403703e-03f, 9.17725172e-03f, 9.21060611e-03f, 9.24411416e-03f,
+    9.27777681e-03f, 9.31159128e-03f, 9.34557524e-03f, 9.37970262e-03f,
+    9.41398554e-03f, 9.44842957e-03f, 9.48303007e-03f, 9.51780379e-03f,
+    9.55272559e-03f, 9.58780851e-03f, 9.62305348e-03f, 9.65846237e-03f,
+    9.69405007e-03f, 9.72978957e-03f, 9.76569485e-03f, 9.80176777e-03f,
+    9.83800925e-03f, 9.87443235e-03f, 9.91101190e-03f, 9.94776562e-03f,
+    9.98468790e-03f, 1.00217853e-02f, 1.00590698e-02f, 1.00965174e-02f,
+    1.01341400e-02f, 1.01719406e-02f, 1.02099190e-02f, 1.02480920e-02f,
+    1.02864308e-02f, 1.03249494e-02f, 1.03636533e-02f, 1.04025388e-02f,
+    1.04416255e-02f, 1.04808817e-02f, 1.05203260e-02f, 1.05599575e-02f,
+    1.05997790e-02f, 1.06398053e-02f, 1.06800077e-02f, 1.07204039e-02f,
+    1.07609937e-02f, 1.08017763e-02f, 1.08427722e-02f, 1.08839506e-02f,
+    1.09253256e-02f, 1.09669007e-02f, 1.10086771e-02f, 1.10506704e-02f,
+    1.10928509e-02f, 1.11352373e-02f, 1.11778295e-02f, 1.12206275e-02f,
+    1.12636508e-02f, 1.13068661e-02f, 1.13502936e-02f, 1.13939326e-02f,
+    1.14377839e-02f, 1.14818672e-02f, 1.15261506e-02f, 1.15706502e-02f,
+    1.16153676e-02f, 1.16603067e-02f, 1.17054842e-02f, 1.17508657e-02f,
+    1.17964726e-02f, 1.18423039e-02f, 1.18883615e-02f, 1.19346669e-02f,
+    1.19811827e-02f, 1.20279305e-02f, 1.20749092e-02f, 1.21221216e-02f,
+    1.21695893e-02f, 1.22172739e-02f, 1.22651979e-02f, 1.23133603e-02f,
+    1.23617649e-02f, 1.24104312e-02f, 1.24593228e-02f, 1.25084594e-02f,
+    1.25578446e-02f, 1.26074795e-02f, 1.26573825e-02f, 1.27075175e-02f,
+    1.27579095e-02f, 1.28085548e-02f, 1.28594553e-02f, 1.29106361e-02f,
+    1.29620545e-02f, 1.30137382e-02f, 1.30656837e-02f, 1.31178955e-02f,
+    1.31703932e-02f, 1.32231396e-02f, 1.32761560e-02f, 1.33294435e-02f,
+    1.33830067e-02f, 1.34368641e-02f, 1.34909796e-02f, 1.35453744e-02f,
+    1.36000477e-02f, 1.36550050e-02f, 1.37102697e-02f, 1.37657980e-02f,
+    1.38216130e-02f, 1.38777215e-02f, 1.39341187e-02f, 1.39908334e-02f,
+    1.40478220e-02f, 1.41051076e-02f, 1.41626941e-02f, 1.42205814e-02f,
+    1.42787937e-02f, 1.43372882e-02f, 1.43960938e-02f, 1.44552058e-02f,
+    1.45146325e-02f, 1.45743936e-02f, 1.46344472e-02f, 1.46948211e-02f,
+    1.47555126e-02f, 1.48165291e-02f, 1.48778912e-02f, 1.49395550e-02f,
+    1.50015494e-02f, 1.50638754e-02f, 1.51265338e-02f, 1.51895499e-02f,
+    1.52528798e-02f, 1.53165497e-02f, 1.53805614e-02f, 1.54449195e-02f,
+    1.55096482e-02f, 1.55746983e-02f, 1.56401023e-02f, 1.57058593e-02f,
+    1.57719757e-02f, 1.58384703e-02f, 1.59053039e-02f, 1.59725007e-02f,
+    1.60400625e-02f, 1.61079951e-02f, 1.61763225e-02f, 1.62449982e-02f,
+    1.63140502e-02f, 1.63834784e-02f, 1.64532941e-02f, 1.65235102e-02f,
+    1.65940933e-02f, 1.66650657e-02f, 1.67364273e-02f, 1.68081876e-02f,
+    1.68803651e-02f, 1.69529226e-02f, 1.70258824e-02f, 1.70992445e-02f,
+    1.71730202e-02f, 1.72472280e-02f, 1.73218269e-02f, 1.73968431e-02f,
+    1.74722765e-02f, 1.75481401e-02f, 1.76244490e-02f, 1.77011620e-02f,
+    1.77783072e-02f, 1.78558882e-02f, 1.79339107e-02f, 1.80123970e-02f,
+    1.80913042e-02f, 1.81706566e-02f, 1.82504579e-02f, 1.83307193e-02f,
+    1.84114575e-02f, 1.84926372e-02f, 1.85742769e-02f, 1.86563842e-02f,
+    1.87389646e-02f, 1.88220404e-02f, 1.89055707e-02f, 1.89895798e-02f,
+    1.90740749e-02f, 1.91590600e-02f, 1.92445591e-02f, 1.93305332e-02f,
+    1.94169972e-02f, 1.95039678e-02f, 1.95914432e-02f, 1.96794569e-02f,
+    1.97679568e-02f, 1.98569708e-02f, 1.99465100e-02f, 2.00365707e-02f,
+    2.01271921e-02f, 2.02183146e-02f, 2.03099716e-02f, 2.04021689e-02f,
+    2.04949174e-02f, 2.05882397e-02f, 2.06820853e-02f, 2.07764879e-02f,
+    2.08714474e-02f, 2.09669769e-02f, 2.10631043e-02f, 2.11597774e-02f,
+    2.12570243e-02f, 2.13548578e-02f, 2.14532744e-02f, 2.15523150e-02f,
+    2.16519237e-02f, 2.17521265e-02f, 2.18529347e-02f, 2.19543520e-02f,
+    2.20564175e-02f, 2.21590679e-02f, 2.22623404e-02f, 2.23662462e-02f,
+    2.24707797e-02f, 2.25759856e-02f, 2.26818025e-02f, 2.27882639e-02f,
+    2.28953809e-02f, 2.30031554e-02f, 2.31116228e-02f, 2.32207309e-02f,
+    2.33305078e-02f, 2.34409608e-02f, 2.35520974e-02f, 2.36639604e-02f,
+    2.37764884e-02f, 2.38897055e-02f, 2.40036324e-02f, 2.41182726e-02f,
+    2.42336635e-02f, 2.43497398e-02f, 2.44665444e-02f, 2.45840792e-02f,
+    2.47023590e-02f, 2.48214174e-02f, 2.49411892e-02f, 2.50617228e-02f,
+    2.51830127e-02f, 2.53050756e-02f, 2.54279543e-02f, 2.55515762e-02f,
+    2.56759766e-02f, 2.58011837e-02f, 2.59271879e-02f, 2.60540340e-02f,
+    2.61816625e-02f, 2.63101012e-02f, 2.64393706e-02f, 2.65694764e-02f,
+    2.67004594e-02f, 2.68322565e-02f, 2.69648973e-02f, 2.70984024e-02f,
+    2.72327792e-02f, 2.73680761e-02f, 2.75042113e-02f, 2.76412349e-02f,
+    2.77791508e-02f, 2.79179811e-02f, 2.80577559e-02f, 2.81984191e-02f,
+    2.83400007e-02f, 2.84825191e-02f, 2.86259837e-02f, 2.87704449e-02f,
+    2.89158188e-02f, 2.90621556e-02f, 2.92094685e-02f, 2.93577705e-02f,
+    2.95071080e-02f, 2.96573993e-02f, 2.98086945e-02f, 2.99610086e-02f,
+    3.01143508e-02f, 3.02687753e-02f, 3.04241925e-02f, 3.05806659e-02f,
+    3.07381935e-02f, 3.08967941e-02f, 3.10565233e-02f, 3.12172975e-02f,
+    3.13791633e-02f, 3.15421410e-02f, 3.17062363e-02f, 3.18715088e-02f,
+    3.20378654e-02f, 3.22053693e-02f, 3.23740281e-02f, 3.25438604e-02f,
+    3.27149108e-02f, 3.28871123e-02f, 3.30604911e-02f, 3.32350917e-02f,
+    3.34109105e-02f, 3.35880071e-02f, 3.37662995e-02f, 3.39458399e-02f,
+    3.41266394e-02f, 3.43087167e-02f, 3.44921350e-02f, 3.46767977e-02f,
+    3.48627679e-02f, 3.50500531e-02f, 3.52386758e-02f, 3.54286954e-02f,
+    3.56200226e-02f, 3.58127095e-02f, 3.60067785e-02f, 3.62022519e-02f,
+    3.63991819e-02f, 3.65974791e-02f, 3.67971994e-02f, 3.69983688e-02f,
+    3.72009911e-02f, 3.74051630e-02f, 3.76107432e-02f, 3.78178246e-02f,
+    3.80264297e-02f, 3.82365584e-02f, 3.84482853e-02f, 3.86615135e-02f,
+    3.88763025e-02f, 3.90926786e-02f, 3.93106639e-02f, 3.95303220e-02f,
+    3.97515483e-02f, 3.99744138e-02f, 4.01989445e-02f, 4.04251553e-02f,
+    4.06531245e-02f, 4.08827364e-02f, 4.11140695e-02f, 4.13471423e-02f,
+    4.15819809e-02f, 4.18186560e-02f, 4.20570634e-02f, 4.22972739e-02f,
+    4.25393023e-02f, 4.27831896e-02f, 4.30290066e-02f, 4.32766378e-02f,
+    4.35261540e-02f, 4.37775888e-02f, 4.40309718e-02f, 4.42863740e-02f,
+    4.45436835e-02f, 4.48029824e-02f, 4.50642891e-02f, 4.53276373e-02f,
+    4.55931127e-02f, 4.58605848e-02f, 4.61301468e-02f, 4.64018248e-02f,
+    4.66756411e-02f, 4.69516926e-02f, 4.72298488e-02f, 4.75101992e-02f,
+    4.77927700e-02f, 4.80775982e-02f, 4.83647697e-02f, 4.86541614e-02f,
+    4.89458442e-02f, 4.92398702e-02f, 4.95362692e-02f, 4.98351417e-02f,
+    5.01363352e-02f, 5.04399538e-02f, 5.07460348e-02f, 5.10546118e-02f,
+    5.13657890e-02f, 5.16794138e-02f, 5.19955866e-02f, 5.23143560e-02f,
+    5.26357517e-02f, 5.29598817e-02f, 5.32866009e-02f, 5.36159985e-02f,
+    5.39481267e-02f, 5.42830266e-02f, 5.46208099e-02f, 5.49613200e-02f,
+    5.53046539e-02f, 5.56508638e-02f, 5.60000092e-02f, 5.63521795e-02f,
+    5.67072146e-02f, 5.70652522e-02f, 5.74263185e-02f, 5.77904657e-02f,
+    5.81578091e-02f, 5.85281961e-02f, 5.89017272e-02f, 5.92784658e-02f,
+    5.96584566e-02f, 6.00418262e-02f, 6.04283921e-02f, 6.08182997e-02f,
+    6.12115897e-02f, 6.16083071e-02f, 6.20085932e-02f, 6.24122657e-02f,
+    6.28194660e-02f, 6.32302314e-02f, 6.36446327e-02f, 6.40628040e-02f,
+    6.44845515e-02f, 6.49100244e-02f, 6.53392747e-02f, 6.57723695e-02f,
+    6.62094504e-02f, 6.66503161e-02f, 6.70951232e-02f, 6.75439388e-02f,
+    6.79968074e-02f, 6.84539005e-02f, 6.89150169e-02f, 6.93802983e-02f,
+    6.98498040e-02f, 7.03236163e-02f, 7.08019212e-02f, 7.12844506e-02f,
+    7.17714205e-02f, 7.22628757e-02f, 7.27588832e-02f, 7.32596368e-02f,
+    7.37649128e-02f, 7.42748603e-02f, 7.47895762e-02f, 7.53091276e-02f,
+    7.58337080e-02f, 7.63630643e-02f, 7.68974125e-02f, 7.74368048e-02f,
+    7.79813454e-02f, 7.85312057e-02f, 7.90861621e-02f, 7.96464086e-02f,
+    8.02120194e-02f, 8.07830840e-02f, 8.13598186e-02f, 8.19419622e-02f,
+    8.25297087e-02f, 8.31231847e-02f, 8.37224424e-02f, 8.43277350e-02f,
+    8.49387869e-02f, 8.55558142e-02f, 8.61789286e-02f, 8.68081897e-02f,
+    8.74438807e-02f, 8.80857036e-02f, 8.87338668e-02f, 8.93885195e-02f,
+    9.00497437e-02f, 9.07178000e-02f, 9.13923755e-02f, 9.20737460e-02f,
+    9.27620009e-02f, 9.34572741e-02f, 9.41598266e-02f, 9.48693454e-02f,
+    9.55860913e-02f, 9.63102058e-02f, 9.70418081e-02f, 9.77811441e-02f,
+    9.85279456e-02f, 9.92824659e-02f, 1.00044854e-01f, 1.00815229e-01f,
+    1.01593897e-01f, 1.02380507e-01f, 1.03175372e-01f, 1.03978664e-01f,
+    1.04790471e-01f, 1.05611138e-01f, 1.06440306e-01f, 1.07278325e-01f,
+    1.08125359e-01f, 1.08981483e-01f, 1.09847106e-01f, 1.10721834e-01f,
+    1.11606061e-01f, 1.12499915e-01f, 1.13403507e-01f, 1.14317276e-01f,
+    1.15240835e-01f, 1.16174534e-01f, 1.17118567e-01f, 1.18073061e-01f,
+    1.19038470e-01f, 1.20014347e-01f, 1.21001147e-01f, 1.21999025e-01f,
+    1.23008162e-01f, 1.24028958e-01f, 1.25061065e-01f, 1.26104876e-01f,
+    1.27160579e-01f, 1.28228396e-01f, 1.29308760e-01f, 1.30401224e-01f,
+    1.31506339e-01f, 1.32624254e-01f, 1.33755162e-01f, 1.34899601e-01f,
+    1.36057109e-01f, 1.37228206e-01f, 1.38413042e-01f, 1.39611959e-01f,
+    1.40825421e-01f, 1.42052963e-01f, 1.43295139e-01f, 1.44552186e-01f,
+    1.45824373e-01f, 1.47112250e-01f, 1.48415327e-01f, 1.49734259e-01f,
+    1.51069224e-01f, 1.52420551e-01f, 1.53788805e-01f, 1.55173510e-01f,
+    1.56575322e-01f, 1.57994509e-01f, 1.59431353e-01f, 1.60886571e-01f,
+    1.62359551e-01f, 1.63851053e-01f, 1.65361390e-01f, 1.66890815e-01f,
+    1.68440178e-01f, 1.70008779e-01f, 1.71597481e-01f, 1.73206553e-01f,
+    1.74836382e-01f, 1.76487818e-01f, 1.78160161e-01f, 1.79854289e-01f,
+    1.81570604e-01f, 1.83309421e-01f, 1.85071707e-01f, 1.86856702e-01f,
+    1.88665465e-01f, 1.90498292e-01f, 1.92355633e-01f, 1.94238469e-01f,
+    1.96146145e-01f, 1.98079616e-01f, 2.00039327e-01f, 2.02025756e-01f,
+    2.04039961e-01f, 2.06081256e-01f, 2.08150700e-01f, 2.10248783e-01f,
+    2.12376013e-01f, 2.14533597e-01f, 2.16720775e-01f, 2.18938693e-01f,
+    2.21187949e-01f, 2.23469079e-01f, 2.25783408e-01f, 2.28130102e-01f,
+    2.30510473e-01f, 2.32925147e-01f, 2.35374764e-01f, 2.37860724e-01f,
+    2.40382180e-01f, 2.42940620e-01f, 2.45536655e-01f, 2.48171061e-01f,
+    2.50845373e-01f, 2.53558666e-01f, 2.56312609e-01f, 2.59107918e-01f,
+    2.61945426e-01f, 2.64826775e-01f, 2.67751127e-01f, 2.70720124e-01f,
+    2.73734808e-01f, 2.76795924e-01f, 2.79905409e-01f, 2.83062279e-01f,
+    2.86268502e-01f, 2.89525092e-01f, 2.92833060e-01f, 2.96194345e-01f,
+    2.99608141e-01f, 3.03076476e-01f, 3.06600511e-01f, 3.10181379e-01f,
+    3.13821375e-01f, 3.17519575e-01f, 3.21278214e-01f, 3.25098664e-01f,
+    3.28982145e-01f, 3.32931221e-01f, 3.36944968e-01f, 3.41025919e-01f,
+    3.45175534e-01f, 3.49395305e-01f, 3.53688061e-01f, 3.58052909e-01f,
+    3.62492561e-01f, 3.67008746e-01f, 3.71603251e-01f, 3.76279175e-01f,
+    3.81035477e-01f, 3.85875463e-01f, 3.90801072e-01f, 3.95814151e-01f,
+    4.00918305e-01f, 4.06112581e-01f, 4.11400557e-01f, 4.16784436e-01f,
+    4.22266543e-01f, 4.27850723e-01f, 4.33536202e-01f, 4.39326972e-01f,
+    4.45225596e-01f, 4.51234639e-01f, 4.57358658e-01f, 4.63596731e-01f,
+    4.69953626e-01f, 4.76432085e-01f, 4.83035147e-01f, 4.89768028e-01f,
+    4.96629894e-01f, 5.03626049e-01f, 5.10759890e-01f, 5.18034816e-01f,
+    5.25456905e-01f, 5.33025265e-01f, 5.40745974e-01f, 5.48623025e-01f,
+    5.56660593e-01f, 5.64865291e-01f, 5.73236644e-01f, 5.81781566e-01f,
+    5.90504766e-01f, 5.99410951e-01f, 6.08507991e-01f, 6.17795467e-01f,
+    6.27281606e-01f, 6.36971712e-01f, 6.46871507e-01f, 6.56989932e-01f,
+    6.67327046e-01f, 6.77892208e-01f, 6.88691854e-01f, 6.99732900e-01f,
+    7.11025417e-01f, 7.22570360e-01f, 7.34378040e-01f, 7.46456802e-01f,
+    7.58814156e-01f, 7.71462679e-01f, 7.84403443e-01f, 7.97648907e-01f,
+    8.11208725e-01f, 8.25092256e-01f, 8.39313924e-01f, 8.53875995e-01f,
+    8.68793130e-01f, 8.84076774e-01f, 8.99738610e-01f, 9.15795505e-01f,
+    9.32250917e-01f, 9.49122131e-01f, 9.66423213e-01f, 9.84168053e-01f,
+    1.00237751e+00f, 1.02105582e+00f, 1.04022443e+00f, 1.05990005e+00f,
+    1.08010018e+00f, 1.10084915e+00f, 1.12215388e+00f, 1.14403999e+00f,
+    1.16652834e+00f, 1.18964016e+00f, 1.21340537e+00f, 1.23783338e+00f,
+    1.26295567e+00f, 1.28879774e+00f, 1.31538677e+00f, 1.34275913e+00f,
+    1.37092757e+00f, 1.39993131e+00f, 1.42980242e+00f, 1.46057475e+00f,
+    1.49229336e+00f, 1.52497661e+00f, 1.55867243e+00f, 1.59342217e+00f,
+    1.62926841e+00f, 1.66626775e+00f, 1.70444536e+00f, 1.74386251e+00f,
+    1.78457105e+00f, 1.82662642e+00f, 1.87009978e+00f, 1.91502690e+00f,
+    1.96148443e+00f, 2.00954103e+00f, 2.05926871e+00f, 2.11075830e+00f,
+    2.16405988e+00f, 2.21927261e+00f, 2.27648640e+00f, 2.33579564e+00f,
+    2.39732027e+00f, 2.46112895e+00f, 2.52735281e+00f, 2.59611082e+00f,
+    2.66753101e+00f, 2.74176931e+00f, 2.81892586e+00f, 2.89917445e+00f,
+    2.98267627e+00f, 3.06960511e+00f, 3.16017222e+00f, 3.25452089e+00f,
+    3.35288548e+00f, 3.45549178e+00f, 3.56257892e+00f, 3.67443609e+00f,
+    3.79127288e+00f, 3.91341662e+00f, 4.04118299e+00f, 4.17491102e+00f,
+    4.31500769e+00f, 4.46178484e+00f, 4.61570406e+00f, 4.77722359e+00f,
+    4.94683599e+00f, 5.12512732e+00f, 5.31256819e+00f, 5.50983620e+00f,
+    5.71760750e+00f, 5.93661785e+00f, 6.16773748e+00f, 6.41170073e+00f,
+    6.66952372e+00f, 6.94224215e+00f, 7.23099327e+00f, 7.53710938e+00f,
+    7.86177254e+00f, 8.20656586e+00f, 8.57313824e+00f, 8.96330643e+00f,
+    9.37919712e+00f, 9.82278919e+00f, 1.02966576e+01f, 1.08035383e+01f,
+    1.13464689e+01f, 1.19290237e+01f, 1.25546541e+01f, 1.32277765e+01f,
+    1.39531746e+01f, 1.47362261e+01f, 1.55832796e+01f, 1.65007210e+01f,
+    1.74966202e+01f, 1.85799007e+01f, 1.97607594e+01f, 2.10513058e+01f,
+    2.24642525e+01f, 2.40155506e+01f, 2.57232952e+01f, 2.76085472e+01f,
+    2.96966534e+01f, 3.20154228e+01f, 3.45997810e+01f, 3.74905586e+01f,
+    4.07365685e+01f, 4.43977203e+01f, 4.85430222e+01f, 5.32602882e+01f,
+    5.86562462e+01f, 6.48631668e+01f, 7.20487747e+01f, 8.04178467e+01f,
+    9.02390976e+01f, 1.01857147e+02f, 1.15722778e+02f, 1.32439743e+02f,
+    1.52805206e+02f, 1.77931137e+02f, 2.09368469e+02f, 2.49339066e+02f,
+    0.00000000e+00f, 0.00000000e+00f, 0.00000000e+00f, 0.00000000e+00f,
+    0.00000000e+00f, 0.00000000e+00f, 0.00000000e+00f, 0.00000000e+00f,
+    0.00000000e+00f, 0.00000000e+00f, 0.00000000e+00f, 0.00000000e+00f,
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef FLASH_MAP_H
+#define FLASH_MAP_H
+
+// MD25Q64 (8 MB) partition map. Regions are 64 KB block aligned so each
+// can also be cleared with block erases.
+//
+//   0x000000 - 0x00FFFF   system / signature
+//   0x010000 - 0x02FFFF   md25q64_test scratch
+//   0x030000 - 0x0FFFFF   uplink queue
+//   0x100000 - 0x3FFFFF   display assets
+//   0x400000 - 0x7FFFFF   sample log (flash_log)
+
+#define FLASH_SYS_ADDR          0x000000u
+#define FLASH_SYS_SIZE          0x010000u
+
+// Signature page (first page of FLASH_SYS): magic, version and this map,
+// written by "boot sign" and compared on every boot (boot_app.c)
+#define FLASH_SIG_ADDR          FLASH_SYS_ADDR
+#define FLASH_SIG_MAGIC         0x54555246u     // "FRUT"
+#define FLASH_SIG_VERSION       1u
+
+#define FLASH_TEST_ADDR         0x010000u
+#define FLASH_TEST_SIZE         0x020000u
+
+#define FLASH_UPLINK_ADDR       0x030000u
+#define FLASH_UPLINK_SIZE       0x0D0000u
+
+#define FLASH_ASSET_ADDR        0x100000u
+#define FLASH_ASSET_SIZE        0x300000u
+
+#define FLASH_LOG_ADDR          0x400000u
+#define FLASH_LOG_SIZE          0x400000u
+
+#endif
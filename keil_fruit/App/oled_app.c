@@ -1,5 +1,7 @@
 #include "oled_app.h"
 
+#define OLED_BENCH_ROUNDS 100
+
 int Oled_Printf(uint8_t x, uint8_t y, const char *format, ...)
 {
 	char buffer[128]; // СҪ
@@ -17,6 +19,71 @@ int Oled_Printf(uint8_t x, uint8_t y, const char *format, ...)
 
 void oled_task(void)
 {
-	Oled_Printf(1,1,"hello");
+	OLED_Text(1, 8, "hello", &OLED_Font6x8);
+	OLED_Flush(); // changed columns go out over DMA; skipped while a frame is in flight
+}
+
+// I2C1 carries only the OLED
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	if (hi2c->Instance == I2C1) OLED_DMA_Complete();
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+	if (hi2c->Instance == I2C1) OLED_DMA_Error();
+}
+
+// Cycles per rendered line on the bottom two pages: vsnprintf + OLED_ShowStr
+// against oled_text, same text ("T 12.3 C"), then an 8x16 number box
+static void oled_bench(void)
+{
+	uint32_t t0, c_printf = 0, c_text = 0, c_number = 0;
+	uint16_t i;
+	int16_t x;
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	for (i = 0; i < OLED_BENCH_ROUNDS; i++)
+	{
+		t0 = DWT->CYCCNT;
+		Oled_Printf(0, 7, "T %d.%d C", i / 10, i % 10);
+		c_printf += DWT->CYCCNT - t0;
+
+		t0 = DWT->CYCCNT;
+		x = OLED_Text(0, 56, "T ", &OLED_Font6x8);
+		OLED_NumberBox((uint8_t)x, 56, 20, i, 1, &OLED_Font6x8);
+		OLED_Text(x + 21, 56, "C", &OLED_Font6x8);
+		c_text += DWT->CYCCNT - t0;
+
+		t0 = DWT->CYCCNT;
+		OLED_NumberBox(64, 48, 64, (int32_t)i * 137, 2, &OLED_Font8x16);
+		c_number += DWT->CYCCNT - t0;
+	}
+	OLED_FillRect(0, 48, OLED_WIDTH, 16, 0);
+
+	my_printf(&huart1, "printf   %lu cycles per line (Oled_Printf)\r\n",
+	          (unsigned long)(c_printf / OLED_BENCH_ROUNDS));
+	my_printf(&huart1, "text     %lu cycles per line (OLED_Text + OLED_NumberBox)\r\n",
+	          (unsigned long)(c_text / OLED_BENCH_ROUNDS));
+	my_printf(&huart1, "number   %lu cycles per 8x16 box, 64 px\r\n",
+	          (unsigned long)(c_number / OLED_BENCH_ROUNDS));
 }
 
+void oled_cmd(int argc, char *argv[])
+{
+	const OLED_Stats *s = OLED_GetStats();
+
+	if (argc > 1 && strcmp(argv[1], "bench") == 0)
+	{
+		oled_bench();
+		return;
+	}
+	my_printf(&huart1, "frames   %lu sent, %lu flushes while busy, %lu resent\r\n",
+	          (unsigned long)s->frames, (unsigned long)s->busy, (unsigned long)s->errors);
+	my_printf(&huart1, "last     %u I2C writes / %u bytes in %u ms\r\n",
+	          s->last_transactions, s->last_bytes, s->last_ms);
+	my_printf(&huart1, "total    %lu I2C writes, %lu bytes\r\n",
+	          (unsigned long)s->transactions, (unsigned long)s->bytes);
+}
@@ -5,4 +5,7 @@
 void oled_task(void);
 int Oled_Printf(uint8_t x, uint8_t y, const char *format, ...);
 
+// Console: "oled" (frames, I2C writes per frame), "oled bench" (text cycles)
+void oled_cmd(int argc, char *argv[]);
+
 #endif
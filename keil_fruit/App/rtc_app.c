@@ -38,6 +38,32 @@ void rtc_get_time(rtc_time_t *time)
     time->year    = 2000 + sDate.Year;
 }
 
+/**
+ * @brief Get RTC time as a timestamp
+ * @return seconds since 2000-01-01 00:00:00
+ */
+uint32_t rtc_get_timestamp(void)
+{
+    static const uint16_t days_before_month[12] = {
+        0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334
+    };
+    rtc_time_t time;
+    uint32_t years;
+    uint32_t days;
+
+    rtc_get_time(&time);
+    years = time.year - 2000;
+
+    // 2000-2099: every 4th year is a leap year
+    days = years * 365 + (years + 3) / 4;
+    days += days_before_month[time.month - 1] + (time.date - 1);
+    if (time.month > 2 && (years % 4) == 0) {
+        days++;
+    }
+
+    return ((days * 24 + time.hours) * 60 + time.minutes) * 60 + time.seconds;
+}
+
 /**
  * @brief Set RTC time
  * @param hours: hour (0-23)
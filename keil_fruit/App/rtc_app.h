@@ -27,6 +27,9 @@ void rtc_set_time(uint8_t hours, uint8_t minutes, uint8_t seconds);
 // Set date (year, month, date, weekday)
 void rtc_set_date(uint16_t year, uint8_t month, uint8_t date, uint8_t weekday);
 
+// Seconds since 2000-01-01 00:00:00 (RTC local time)
+uint32_t rtc_get_timestamp(void);
+
 // Get time string "HH:MM:SS"
 void rtc_get_time_str(char *buf);
 
@@ -18,9 +18,16 @@ static task_t scheduler_task[] =
 	{oled_task,10,0},
 	{uart3_proc, 900, 0},
 	{adc_task,1000,0},
-	{uart6_proc,500,0},
+	{adc_poll,1,0},
+	{uart6_proc,10,0},
 	{led_proc,10,0},
-	{key_proc,10,0}
+	{key_proc,10,0},
+	{stats_task,1000,0},
+	{burst_task,100,0},
+	{storage_task,STORAGE_SAMPLE_MS,0},
+	{storage_poll,1,0},
+	{dump_task,1,0},
+	{uplink_task,10,0}
  };
 
 
@@ -0,0 +1,91 @@
+#include "stats_app.h"
+
+// Telemetry line per channel at each window close:
+//   STAT,<name>,<count>,<mean>,<m2>,<min>,<max>
+// count/mean/m2/min/max is the mergeable RunStats summary (see run_stats.h)
+
+static const char *const stats_names[STATS_CH_NUM] =
+{
+    "c2h4",
+    "batt",
+    "etoh",
+    "tvoc",
+    "hcho",
+    "co2"
+};
+
+static RunStats stats_current[STATS_CH_NUM];
+static RunStats stats_window[STATS_CH_NUM];
+static uint32_t stats_window_start = 0;
+
+void stats_push(stats_ch_t ch, float x)
+{
+    if (ch >= STATS_CH_NUM) return;
+    RunStats_Push(&stats_current[ch], x);
+}
+
+const RunStats *stats_get_current(stats_ch_t ch)
+{
+    return &stats_current[ch];
+}
+
+const RunStats *stats_get_window(stats_ch_t ch)
+{
+    return &stats_window[ch];
+}
+
+void stats_reset_window(void)
+{
+    for (uint8_t i = 0; i < STATS_CH_NUM; i++)
+    {
+        stats_window[i] = stats_current[i];
+        RunStats_Reset(&stats_current[i]);
+    }
+    stats_window_start = HAL_GetTick();
+}
+
+static void stats_print(const char *tag, const RunStats *table)
+{
+    for (uint8_t i = 0; i < STATS_CH_NUM; i++)
+    {
+        const RunStats *s = &table[i];
+        uplink_printf("%s,%s,%lu,%.9g,%.9g,%.9g,%.9g\r\n",
+                  tag, stats_names[i], (unsigned long)s->count,
+                  s->mean, s->m2, s->min, s->max);
+    }
+}
+
+void stats_task(void)
+{
+    if (HAL_GetTick() - stats_window_start < STATS_WINDOW_MS) return;
+
+    stats_reset_window();
+    stats_print("STAT", stats_window);
+}
+
+void stats_cmd(int argc, char *argv[])
+{
+    if (argc > 1 && strcmp(argv[1], "reset") == 0)
+    {
+        // The closing window goes out like a timed one, so the server's
+        // summaries have no gap
+        stats_print("STAT", stats_current);
+        stats_reset_window();
+        my_printf(&huart1, "stats: window closed\r\n");
+        return;
+    }
+
+    uint32_t age_s = (HAL_GetTick() - stats_window_start) / 1000u;
+
+    my_printf(&huart1, "%-5s %6s %10s %10s %10s %10s\r\n",
+              "ch", "n", "mean", "std", "min", "max");
+    for (uint8_t i = 0; i < STATS_CH_NUM; i++)
+    {
+        const RunStats *s = &stats_current[i];
+        my_printf(&huart1, "%-5s %6lu %10.4g %10.4g %10.4g %10.4g\r\n",
+                  stats_names[i], (unsigned long)s->count, s->mean,
+                  RunStats_StdDev(s), s->min, s->max);
+    }
+    my_printf(&huart1, "current window: %lus of %lus\r\n",
+              (unsigned long)age_s, (unsigned long)(STATS_WINDOW_MS / 1000u));
+}
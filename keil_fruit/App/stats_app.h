@@ -0,0 +1,37 @@
+#ifndef STATS_APP_H
+#define STATS_APP_H
+
+#include "define.h"
+#include "run_stats.h"
+
+#define STATS_WINDOW_MS     60000   // summary window, rolled by stats_task
+
+// Channels with running statistics
+typedef enum
+{
+    STATS_CH_ETHYLENE = 0,  // ADC CH0 voltage (V)
+    STATS_CH_BATTERY,       // battery charge (%)
+    STATS_CH_ETHANOL,       // ethanol concentration (ppm, as decoded)
+    STATS_CH_TVOC,          // TVOC (mg/m3, as decoded)
+    STATS_CH_HCHO,          // HCHO (mg/m3, as decoded)
+    STATS_CH_CO2,           // CO2 (ppm, as decoded)
+    STATS_CH_NUM
+} stats_ch_t;
+
+// Add one sample to the current window
+void stats_push(stats_ch_t ch, float x);
+
+// Current (open) and last completed window of a channel
+const RunStats *stats_get_current(stats_ch_t ch);
+const RunStats *stats_get_window(stats_ch_t ch);
+
+// Close the current window on every channel
+void stats_reset_window(void);
+
+// Window roll-over and telemetry (call in scheduler)
+void stats_task(void);
+
+// Console: "stats [reset]"
+void stats_cmd(int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,354 @@
+#include "storage_app.h"
+#include "flash_map.h"
+#include "spi.h"
+
+// Sample log: one storage_sample_t per STORAGE_SAMPLE_MS in FLASH_LOG region.
+// 84 records per 4 KB sector, so the 1024 sectors hold about a day of
+// samples before the oldest sector is recycled.
+// Ethylene burst windows (burst_app.c) are stored in the same log as
+// records of their own, a few KB per capture, through storage_append().
+// Records are collected in a page write-back buffer and programmed five at a
+// time; a power cut loses at most STORAGE_WBUF_MS of samples.
+// Short reads on the chip (log headers and records, the uplink queue,
+// dashboard queries) go through a small page cache; programs and erases
+// drop the lines they touch. 32 lines hold the two newest sectors, which
+// is what a refresh of the last minute re-reads every few seconds.
+// Each sector header also carries its first and last sample timestamps;
+// the span table below mirrors them so a time range query reads only the
+// sectors it needs ("log last", "log range").
+
+static MD25Q64_Handle storage_flash;
+static FlashLog storage_log;
+static MD25Q64_WBuf storage_wbuf;
+static MD25Q64_Cache storage_cache;
+#if STORAGE_CACHE_LINES > 0
+static MD25Q64_CacheLine storage_cache_lines[STORAGE_CACHE_LINES];
+#define STORAGE_CACHE_BUF   storage_cache_lines
+#else
+#define STORAGE_CACHE_BUF   NULL
+#endif
+static FlashLog_Span storage_spans[FLASH_LOG_SIZE / MD25Q64_SECTOR_SIZE];   // 8 KB
+static uint8_t storage_flash_ok = 0;    // chip answered, nothing written yet
+static uint8_t storage_ready = 0;       // log mounted
+
+static uint32_t storage_append_errors = 0;
+static uint32_t storage_append_max_ms = 0;      // worst append, incl. erase waits
+
+static uint32_t storage_stamp(const void *data, uint16_t len)
+{
+    uint32_t ts;
+
+    if (len != sizeof(storage_sample_t)) return FLASHLOG_NO_STAMP;
+    memcpy(&ts, data, sizeof(ts));      // storage_sample_t.timestamp
+    return ts;
+}
+
+void storage_init(void)
+{
+    if (MD25Q64_Init(&storage_flash, &hspi2, GPIOB, GPIO_PIN_12) != MD25Q64_OK)
+    {
+        my_printf(&huart1, "storage: flash not found\r\n");
+        return;
+    }
+    MD25Q64_Cache_Init(&storage_cache, STORAGE_CACHE_BUF, STORAGE_CACHE_LINES);
+    MD25Q64_SetCache(&storage_flash, &storage_cache);
+    storage_flash_ok = 1;
+}
+
+// Mounting writes: a fresh or torn head sector is erased and given a header
+void storage_mount(void)
+{
+    if (!storage_flash_ok) return;
+    if (FlashLog_Mount(&storage_log, &storage_flash, FLASH_LOG_ADDR,
+                       FLASH_LOG_SIZE / MD25Q64_SECTOR_SIZE) != FLASHLOG_OK)
+    {
+        my_printf(&huart1, "storage: log mount failed\r\n");
+        return;
+    }
+    if (FlashLog_SetIndex(&storage_log, storage_stamp, storage_spans) != FLASHLOG_OK)
+    {
+        my_printf(&huart1, "storage: no time index\r\n");
+    }
+    MD25Q64_WBuf_Init(&storage_wbuf, &storage_flash, STORAGE_WBUF_MS);
+    FlashLog_SetWriteBuffer(&storage_log, &storage_wbuf);
+    storage_ready = 1;
+    my_printf(&huart1, "storage: log head %u seq %lu, %u sectors used\r\n",
+              storage_log.head, (unsigned long)storage_log.head_seq,
+              FlashLog_UsedSectors(&storage_log));
+}
+
+FlashLog *storage_get_log(void)
+{
+    return storage_ready ? &storage_log : NULL;
+}
+
+MD25Q64_Handle *storage_get_flash(void)
+{
+    return storage_flash_ok ? &storage_flash : NULL;
+}
+
+static void storage_fill_sample(storage_sample_t *s)
+{
+    memset(s, 0, sizeof(*s));
+    s->timestamp    = rtc_get_timestamp();
+    s->ethylene_v   = voltage_ch0;
+    s->ethylene_ppm = g_ethylene_ppm;
+    s->ethanol_ppm  = g_ethanol_data.concentration_ppm;
+    s->tvoc_mg_m3   = g_air_data.tvoc_mg_m3;
+    s->hcho_mg_m3   = g_air_data.hcho_mg_m3;
+    s->temp_c       = g_air_data.temp_c;
+    s->humi_percent = g_air_data.humi_percent;
+    s->battery      = charge_fruit_equipment;
+    s->co2_ppm      = g_air_data.co2_ppm;
+    s->alarm        = g_ethanol_data.alarm;
+}
+
+// Integer channels in the units the sensors resolve: CO2 ppm, TVOC/HCHO in
+// thousandths, temperature/humidity/battery in tenths, ethanol in hundredths
+void storage_sample_to_record(const storage_sample_t *s, TsCodec_Record *r)
+{
+    memset(r, 0, sizeof(*r));
+    r->timestamp = s->timestamp;
+    r->i[0] = s->co2_ppm;
+    r->i[1] = (int32_t)lrintf(s->tvoc_mg_m3 * 1000.0f);
+    r->i[2] = (int32_t)lrintf(s->hcho_mg_m3 * 1000.0f);
+    r->i[3] = (int32_t)lrintf(s->temp_c * 10.0f);
+    r->i[4] = (int32_t)lrintf(s->humi_percent * 10.0f);
+    r->i[5] = (int32_t)lrintf(s->ethanol_ppm * 100.0f);
+    r->i[6] = (int32_t)lrintf(s->battery * 10.0f);
+    r->i[7] = s->alarm | (s->flags << 8);
+    r->f[0] = s->ethylene_v;
+    r->f[1] = s->ethylene_ppm;
+}
+
+// log pack [n]: compress the oldest n stored samples and report the ratio
+// and encode cost. Nothing is written.
+static void storage_pack_report(uint32_t limit)
+{
+    static TsCodec_Encoder enc;     // 300 B, keep it off the stack
+    storage_sample_t sample;
+    TsCodec_Record rec;
+    FlashLog_Iter it;
+    uint16_t len;
+    uint32_t records = 0, blocks = 0, packed = 0, cycles = 0, t0;
+
+    TsCodec_EncoderInit(&enc, STORAGE_PACK_INT, STORAGE_PACK_FLOAT, STORAGE_PACK_BLOCK);
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    FlashLog_IterInit(&storage_log, &it);
+    while (records < limit &&
+           FlashLog_IterNext(&it, &sample, sizeof(sample), &len) == FLASHLOG_OK)
+    {
+        if (len != sizeof(sample)) continue;
+        storage_sample_to_record(&sample, &rec);
+
+        t0 = DWT->CYCCNT;
+        if (TsCodec_Add(&enc, &rec) == TSCODEC_FULL)
+        {
+            packed += STORAGE_PACK_BLOCK;
+            blocks++;
+            TsCodec_EncoderReset(&enc);
+            TsCodec_Add(&enc, &rec);
+        }
+        cycles += DWT->CYCCNT - t0;
+        records++;
+    }
+    if (enc.count > 0)
+    {
+        packed += TsCodec_BlockBytes(&enc);
+        blocks++;
+    }
+
+    if (records == 0)
+    {
+        my_printf(&huart1, "pack     no records\r\n");
+        return;
+    }
+    my_printf(&huart1, "pack     %lu records, %lu blocks, %lu B vs %lu B stored (x%lu.%02lu)\r\n",
+              (unsigned long)records, (unsigned long)blocks, (unsigned long)packed,
+              (unsigned long)(records * (sizeof(sample) + sizeof(FlashLog_RecHdr))),
+              (unsigned long)(records * (sizeof(sample) + sizeof(FlashLog_RecHdr)) / packed),
+              (unsigned long)(records * (sizeof(sample) + sizeof(FlashLog_RecHdr)) * 100u / packed % 100u));
+    my_printf(&huart1, "pack     encode %lu cycles/record\r\n", (unsigned long)(cycles / records));
+}
+
+// Samples stamped from .. to, found through the span table
+static void storage_range_report(uint32_t from, uint32_t to)
+{
+    storage_sample_t sample;
+    FlashLog_Query q;
+    uint16_t len;
+    uint32_t records = 0, first = 0, last = 0, t0;
+
+    if (FlashLog_QueryInit(&storage_log, &q, from, to) != FLASHLOG_OK)
+    {
+        my_printf(&huart1, "range    no index or bad range\r\n");
+        return;
+    }
+    t0 = HAL_GetTick();
+    while (FlashLog_QueryNext(&q, &sample, sizeof(sample), &len) == FLASHLOG_OK)
+    {
+        if (records == 0) first = sample.timestamp;
+        last = sample.timestamp;
+        records++;
+    }
+    my_printf(&huart1, "range    %lu records (%lu .. %lu), %u sectors read, %lu ms\r\n",
+              (unsigned long)records, (unsigned long)first, (unsigned long)last,
+              q.sectors, (unsigned long)(HAL_GetTick() - t0));
+}
+
+void storage_task(void)
+{
+    storage_sample_t sample;
+    uint32_t t0;
+
+    if (!storage_ready) return;
+
+    storage_fill_sample(&sample);
+
+    t0 = HAL_GetTick();
+    if (FlashLog_Append(&storage_log, &sample, sizeof(sample)) != FLASHLOG_OK)
+    {
+        storage_append_errors++;
+    }
+    if (HAL_GetTick() - t0 > storage_append_max_ms)
+    {
+        storage_append_max_ms = HAL_GetTick() - t0;
+    }
+
+    // Keep erased sectors ready ahead of the head; storage_poll completes them
+    FlashLog_Maintain(&storage_log);
+}
+
+uint8_t storage_append(const void *data, uint16_t len)
+{
+    if (!storage_ready) return 0;
+
+    if (FlashLog_Append(&storage_log, data, len) != FLASHLOG_OK)
+    {
+        storage_append_errors++;
+        return 0;
+    }
+    return 1;
+}
+
+void storage_poll(void)
+{
+    if (!storage_flash_ok) return;
+
+    // One status read while a program/erase is running, nothing when idle;
+    // also drives dump and asset reads when the log is not mounted
+    MD25Q64_Poll(&storage_flash);
+
+    // Program a part-filled page once it is STORAGE_WBUF_MS old
+    if (storage_ready) MD25Q64_WBuf_Poll(&storage_wbuf);
+}
+
+void storage_flush(void)
+{
+    if (!storage_ready) return;
+    MD25Q64_WBuf_Flush(&storage_wbuf);
+}
+
+// SPI2 DMA data phases (page program data, bulk reads) end here; the driver
+// releases CS and the next MD25Q64_Poll carries on with the operation
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == SPI2) {
+        MD25Q64_DMA_Complete(hspi);
+    }
+}
+
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == SPI2) {
+        MD25Q64_DMA_Complete(hspi);
+    }
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == SPI2) {
+        MD25Q64_DMA_Error(hspi);
+    }
+}
+
+void storage_cmd(int argc, char *argv[])
+{
+    const MD25Q64_Stats *fs = &storage_flash.stats;
+
+    if (!storage_ready)
+    {
+        my_printf(&huart1, "log: not mounted\r\n");
+        return;
+    }
+
+    // log ahead <n>: erased sectors kept ready in front of the head
+    if (argc > 2 && strcmp(argv[1], "ahead") == 0)
+    {
+        if (FlashLog_SetEraseAhead(&storage_log, (uint16_t)atoi(argv[2])) != FLASHLOG_OK)
+        {
+            my_printf(&huart1, "log: depth 0..%u\r\n", storage_log.sector_count - 1u);
+            return;
+        }
+        FlashLog_Maintain(&storage_log);
+    }
+
+    // log pack [n]: compression report over the stored samples
+    if (argc > 1 && strcmp(argv[1], "pack") == 0)
+    {
+        storage_pack_report(argc > 2 ? (uint32_t)atoi(argv[2]) : 1000u);
+        return;
+    }
+
+    // log range <t0> <t1> / log last <s>: timestamps as in storage_sample_t
+    if (argc > 3 && strcmp(argv[1], "range") == 0)
+    {
+        storage_range_report(strtoul(argv[2], NULL, 10), strtoul(argv[3], NULL, 10));
+        return;
+    }
+    if (argc > 2 && strcmp(argv[1], "last") == 0)
+    {
+        uint32_t now = rtc_get_timestamp();
+        uint32_t span = strtoul(argv[2], NULL, 10);
+
+        storage_range_report(span < now ? now - span : 0, now);
+        return;
+    }
+
+    // log flush: program buffered records now (before pulling power)
+    if (argc > 1 && strcmp(argv[1], "flush") == 0)
+    {
+        if (MD25Q64_WBuf_Flush(&storage_wbuf) != MD25Q64_OK)
+        {
+            my_printf(&huart1, "log: flush failed\r\n");
+        }
+    }
+
+    my_printf(&huart1, "sectors  %u used of %u (tail %u, head %u)\r\n",
+              FlashLog_UsedSectors(&storage_log), storage_log.sector_count,
+              storage_log.tail, storage_log.head);
+    my_printf(&huart1, "head     seq %lu, offset %lu\r\n",
+              (unsigned long)storage_log.head_seq, (unsigned long)storage_log.head_offset);
+    my_printf(&huart1, "appended %lu (errors %lu, waited for erase %lu)\r\n",
+              (unsigned long)storage_log.appended, (unsigned long)storage_append_errors,
+              (unsigned long)storage_log.slow_appends);
+    my_printf(&huart1, "wbuf     %lu writes in %lu page programs, %u bytes pending\r\n",
+              (unsigned long)storage_wbuf.writes, (unsigned long)storage_wbuf.programs,
+              (unsigned)(storage_wbuf.page == MD25Q64_WBUF_NONE ? 0 : storage_wbuf.hi - storage_wbuf.lo));
+    my_printf(&huart1, "worst    append %lu ms\r\n", (unsigned long)storage_append_max_ms);
+    my_printf(&huart1, "ahead    %u erased of %u%s\r\n",
+              storage_log.erased_ahead, storage_log.erase_ahead,
+              storage_log.erasing ? ", erasing" : "");
+    my_printf(&huart1, "reads    %lu, wait avg %lu ms max %lu ms, erase suspends %lu\r\n",
+              (unsigned long)fs->reads,
+              (unsigned long)(fs->reads ? fs->read_wait_sum_ms / fs->reads : 0),
+              (unsigned long)fs->read_wait_max_ms, (unsigned long)fs->suspends);
+    my_printf(&huart1, "cache    %u lines, %lu hits %lu misses %lu bypass, %lu KB asked / %lu KB from SPI\r\n",
+              storage_cache.count, (unsigned long)storage_cache.stats.hits,
+              (unsigned long)storage_cache.stats.misses, (unsigned long)storage_cache.stats.bypass,
+              (unsigned long)(storage_cache.stats.read_bytes / 1024u),
+              (unsigned long)(storage_cache.stats.spi_bytes / 1024u));
+}
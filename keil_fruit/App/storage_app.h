@@ -0,0 +1,66 @@
+#ifndef STORAGE_APP_H
+#define STORAGE_APP_H
+
+#include "define.h"
+#include "flash_log.h"
+#include "ts_codec.h"
+
+#define STORAGE_SAMPLE_MS   1000    // one sample record per period
+#define STORAGE_WBUF_MS     10000   // longest a record may sit unflushed in RAM
+#define STORAGE_CACHE_LINES 32      // read cache, MD25Q64_CACHE_LINE bytes each (0: off)
+
+// One record in the sample log (little-endian, packed by layout)
+typedef struct
+{
+    uint32_t timestamp;         // rtc_get_timestamp(), s since 2000-01-01
+    float    ethylene_v;        // ADC CH0 voltage
+    float    ethylene_ppm;
+    float    ethanol_ppm;
+    float    tvoc_mg_m3;
+    float    hcho_mg_m3;
+    float    temp_c;
+    float    humi_percent;
+    float    battery;           // charge (%)
+    uint16_t co2_ppm;
+    uint8_t  alarm;             // ethanol alarm byte
+    uint8_t  flags;             // reserved, 0
+} storage_sample_t;
+
+// Compressed form of a sample (ts_codec): fixed-point integer channels,
+// raw floats for the ethylene pair
+#define STORAGE_PACK_INT    8
+#define STORAGE_PACK_FLOAT  2
+#define STORAGE_PACK_BLOCK  (MD25Q64_PAGE_SIZE - sizeof(FlashLog_RecHdr))  // block + record header = one page
+
+void storage_sample_to_record(const storage_sample_t *s, TsCodec_Record *r);
+
+// Attach the flash, read commands only (after MX_SPI2_Init)
+void storage_init(void);
+
+// Mount the sample log; writes to the chip (after boot_selfcheck)
+void storage_mount(void);
+
+// Sample log, or NULL if it is not mounted
+FlashLog *storage_get_log(void);
+
+// Flash handle, or NULL if the chip did not answer
+MD25Q64_Handle *storage_get_flash(void);
+
+// Append one sample and queue the erase-ahead (call in scheduler)
+void storage_task(void);
+
+// Append another kind of record to the sample log: first 4 bytes a
+// timestamp as in storage_sample_t, length other than sizeof(storage_sample_t)
+// so sample readers skip it. 1 on success
+uint8_t storage_append(const void *data, uint16_t len);
+
+// Advance queued flash operations (call in scheduler, every tick)
+void storage_poll(void);
+
+// Program buffered records now
+void storage_flush(void);
+
+// Console: "log"
+void storage_cmd(int argc, char *argv[]);
+
+#endif
@@ -25,12 +25,49 @@ uint8_t uart3_dma_buffer[128] = {0};
 uint8_t uart6_rx_dma_buffer[128] = {0};
 uint8_t uart6_dma_buffer[128] = {0};
 
+// Decoded gas readings: median-of-5 drops single bad frames, EMA smooths
+#define GAS_MEDIAN_LEN      5
+#define GAS_EMA_ALPHA       8192    // 0.25 in Q15 (frames arrive ~1 Hz)
+
+typedef struct
+{
+    DSP_Median median;
+    DSP_EmaQ31 ema;
+} gas_filter_t;
+
+static gas_filter_t tvoc_filter;
+static gas_filter_t hcho_filter;
+static gas_filter_t co2_filter;
+static gas_filter_t ethanol_filter;
+
+static void gas_filter_init(gas_filter_t *f)
+{
+    DSP_Median_Init(&f->median, GAS_MEDIAN_LEN);
+    DSP_EmaQ31_Init(&f->ema, GAS_EMA_ALPHA);
+}
+
+static uint16_t gas_filter_update(gas_filter_t *f, uint16_t raw)
+{
+#if GAS_FILTER_ENABLE
+    int32_t v = DSP_Median_Update(&f->median, raw);
+    return (uint16_t)DSP_EmaQ31_Update(&f->ema, v);
+#else
+    (void)f;
+    return raw;
+#endif
+}
+
 void buffer_init(void)
 {
   rt_ringbuffer_init(&rb, static_buffer, BUFFER_SIZE);
 	rt_ringbuffer_init(&web_rb, web_static_buffer, BUFFER_SIZE);
 	rt_ringbuffer_init(&uart3_rb, uart3_static_buffer, BUFFER_SIZE);
 	rt_ringbuffer_init(&uart6_rb, uart6_static_buffer, BUFFER_SIZE);
+
+	gas_filter_init(&tvoc_filter);
+	gas_filter_init(&hcho_filter);
+	gas_filter_init(&co2_filter);
+	gas_filter_init(&ethanol_filter);
 }
 
 int my_printf(UART_HandleTypeDef *huart, const char *format, ...)
@@ -39,6 +76,9 @@ int my_printf(UART_HandleTypeDef *huart, const char *format, ...)
 	va_list arg;      
 	int len;          
 
+	// USART1 carries binary frames during a bulk dump
+	if (huart == &huart1 && dump_active()) return 0;
+
 	va_start(arg, format);
 
 	len = vsnprintf(buffer, sizeof(buffer), format, arg);
@@ -136,6 +176,8 @@ int sensor_parse_frame(const uint8_t *buf, sensor_frame_t *out)
     return 0;
 }
 
+sensor_frame_t g_air_data = {0};
+
 void sensor_process_buffer(const uint8_t *buf, uint16_t len)
 {
     uint16_t i = 0;
@@ -147,8 +189,19 @@ void sensor_process_buffer(const uint8_t *buf, uint16_t len)
             int ret = sensor_parse_frame(&buf[i], &frame);
             if (ret == 0)
             {
-
-                my_printf(&huart6,
+                // Statistics see the sensor as reported, before smoothing
+                stats_push(STATS_CH_TVOC, frame.tvoc_mg_m3);
+                stats_push(STATS_CH_HCHO, frame.hcho_mg_m3);
+                stats_push(STATS_CH_CO2, (float)frame.co2_ppm);
+
+                frame.tvoc_raw   = gas_filter_update(&tvoc_filter, frame.tvoc_raw);
+                frame.tvoc_mg_m3 = frame.tvoc_raw * 0.001f;
+                frame.hcho_raw   = gas_filter_update(&hcho_filter, frame.hcho_raw);
+                frame.hcho_mg_m3 = frame.hcho_raw * 0.001f;
+                frame.co2_ppm    = gas_filter_update(&co2_filter, frame.co2_ppm);
+                g_air_data = frame;
+
+                uplink_printf(
                          "TVOC:%.3fmg/m3 HCHO:%.3fmg/m3 CO2:%dppm AQI:%d T:%.1fC H:%.1f%%\r\n",
                          frame.tvoc_mg_m3,
                          frame.hcho_mg_m3,
@@ -235,11 +288,17 @@ void ethanol_process_buffer(const uint8_t *buf, uint16_t len)
             int ret = ethanol_parse_frame(&buf[i], &frame);
             if (ret == 0)
             {
+                stats_push(STATS_CH_ETHANOL, frame.concentration_ppm);
+
+                // 浓度按 0.01ppm 原始值滤波
+                uint16_t conc_raw = (uint16_t)(frame.concentration_ppm * 100.0f + 0.5f);
+                frame.concentration_ppm = (float)gas_filter_update(&ethanol_filter, conc_raw) / 100.0f;
+
                 // 保存到全局变量
                 g_ethanol_data = frame;
 
                 // 调试输出
-                my_printf(&huart6, "Ethanol: %.2f ppm (ADC: %d, Alarm: %d)\r\n",
+                uplink_printf("Ethanol: %.2f ppm (ADC: %d, Alarm: %d)\r\n",
                          frame.concentration_ppm,
                          frame.adc_val,
                          frame.alarm);
@@ -257,7 +316,10 @@ void uart_proc(void)
 	uint8_t Lengh = rt_ringbuffer_data_len(&rb);
 	if(Lengh == 0) return;
 	rt_ringbuffer_get(&rb,uart_dma_buffer,Lengh);
-	//my_printf(&huart1,"%s\r\n",uart_dma_buffer);
+	if (dump_active())
+		dump_input(uart_dma_buffer, Lengh);
+	else
+		console_input(uart_dma_buffer, Lengh);
 	memset(uart_dma_buffer, 0, sizeof(uart_dma_buffer));
 }
 
@@ -289,6 +351,7 @@ void uart6_proc(void)
 	rt_ringbuffer_get(&uart6_rb,uart6_dma_buffer,Lengh);
 
 	//my_printf(&huart1,"%s\r\n",uart6_dma_buffer);
+	uplink_input(uart6_dma_buffer, Lengh);
 	memset(uart6_dma_buffer, 0, sizeof(uart6_dma_buffer));
 }
 
@@ -26,6 +26,9 @@ typedef struct
     uint16_t adc_val;           // ADC原始值
 } ethanol_frame_t;
 
+#define GAS_FILTER_ENABLE   1       // median + EMA on decoded gas readings
+
+extern sensor_frame_t  g_air_data;
 extern ethanol_frame_t g_ethanol_data;
 
 int  sensor_parse_frame(const uint8_t *buf, sensor_frame_t *out);
@@ -0,0 +1,119 @@
+#include "uplink_app.h"
+#include "flash_map.h"
+
+// Store-and-forward telemetry to the 4G module (protocol: Components/uplink_queue)
+//
+// FLASH_UPLINK holds two logs: the ACK cursor in the first 64 KB block and
+// the line queue in the rest. At ~4 lines/s the 768 KB queue covers about
+// an hour without coverage; the backlog replays at 20 lines/s, so an hour
+// out takes about 12 minutes to catch up. The server side is
+// 上云/server/uplink.js.
+
+#define UPLINK_CURSOR_SECTORS   16u
+
+static FlashLog uplink_queue;
+static FlashLog uplink_cursor;
+static Uplink uplink;
+static uint8_t uplink_ready = 0;
+
+static uint8_t uplink_send(void *ctx, const uint8_t *data, uint16_t len)
+{
+    (void)ctx;
+    return HAL_UART_Transmit(&huart6, (uint8_t *)data, len, 0xFF) == HAL_OK;
+}
+
+static uint32_t uplink_now_ms(void)
+{
+    return HAL_GetTick();
+}
+
+static const Uplink_Port uplink_port = {
+    uplink_send, uplink_now_ms, NULL
+};
+
+void uplink_init(void)
+{
+    MD25Q64_Handle *flash = storage_get_flash();
+    uint32_t t0 = HAL_GetTick();
+
+    if (flash == NULL) return;      // lines go out unqueued
+
+    if (FlashLog_Mount(&uplink_cursor, flash, FLASH_UPLINK_ADDR,
+                       UPLINK_CURSOR_SECTORS) != FLASHLOG_OK ||
+        FlashLog_Mount(&uplink_queue, flash,
+                       FLASH_UPLINK_ADDR + UPLINK_CURSOR_SECTORS * MD25Q64_SECTOR_SIZE,
+                       FLASH_UPLINK_SIZE / MD25Q64_SECTOR_SIZE - UPLINK_CURSOR_SECTORS) != FLASHLOG_OK ||
+        Uplink_Init(&uplink, &uplink_queue, &uplink_cursor, &uplink_port) != UPLINK_OK)
+    {
+        my_printf(&huart1, "uplink: queue mount failed\r\n");
+        return;
+    }
+    uplink_ready = 1;
+    my_printf(&huart1, "uplink: next seq %lu, backlog %lu (%lu ms)\r\n",
+              (unsigned long)uplink.next_seq, (unsigned long)Uplink_Backlog(&uplink),
+              (unsigned long)(HAL_GetTick() - t0));
+}
+
+void uplink_printf(const char *format, ...)
+{
+    char buffer[UPLINK_LINE_MAX + 3];
+    va_list arg;
+    int len;
+
+    va_start(arg, format);
+    len = vsnprintf(buffer, sizeof(buffer), format, arg);
+    va_end(arg);
+    if (len < 0) return;
+    if (len >= (int)sizeof(buffer)) len = sizeof(buffer) - 1;
+
+    if (!uplink_ready)
+    {
+        HAL_UART_Transmit(&huart6, (uint8_t *)buffer, (uint16_t)len, 0xFF);
+        return;
+    }
+    Uplink_Write(&uplink, rtc_get_timestamp(), buffer, (uint16_t)len);
+}
+
+void uplink_input(const uint8_t *buf, uint16_t len)
+{
+    if (uplink_ready) Uplink_Input(&uplink, buf, len);
+}
+
+void uplink_task(void)
+{
+    if (uplink_ready) Uplink_Poll(&uplink);
+}
+
+void uplink_cmd(int argc, char *argv[])
+{
+    const Uplink_Stats *s = &uplink.stats;
+
+    if (!uplink_ready)
+    {
+        my_printf(&huart1, "uplink: not mounted\r\n");
+        return;
+    }
+
+    // uplink save: store the ACK cursor now (before pulling power)
+    if (argc > 1 && strcmp(argv[1], "save") == 0)
+    {
+        if (Uplink_Save(&uplink) != UPLINK_OK)
+        {
+            my_printf(&huart1, "uplink: save failed\r\n");
+        }
+    }
+
+    my_printf(&huart1, "link     %s, last ACK %lu ms ago\r\n", uplink.link ? "up" : "down",
+              (unsigned long)(HAL_GetTick() - uplink.ack_tick));
+    my_printf(&huart1, "seq      next %lu, acked below %lu, backlog %lu, %u in replay window\r\n",
+              (unsigned long)uplink.next_seq, (unsigned long)uplink.acked,
+              (unsigned long)Uplink_Backlog(&uplink), uplink.win_count);
+    my_printf(&huart1, "lines    %lu queued (errors %lu), %lu replayed, %lu ACKs\r\n",
+              (unsigned long)s->written, (unsigned long)s->write_errors,
+              (unsigned long)s->replayed, (unsigned long)s->acks);
+    my_printf(&huart1, "replay   %lu resends (%lu timeouts), %lu lost to ring overflow\r\n",
+              (unsigned long)s->resends, (unsigned long)s->timeouts, (unsigned long)s->lost);
+    my_printf(&huart1, "cursor   %lu saves, %u of %u queue sectors used\r\n",
+              (unsigned long)s->saves, FlashLog_UsedSectors(&uplink_queue),
+              uplink_queue.sector_count);
+}
@@ -0,0 +1,23 @@
+#ifndef UPLINK_APP_H
+#define UPLINK_APP_H
+
+#include "define.h"
+#include "uplink_queue.h"
+
+// Mount the uplink queue on the sample flash (after storage_init)
+void uplink_init(void);
+
+// Telemetry line to the server over the 4G module (USART6): queued on
+// flash, sent at once and replayed until the server ACKs it
+void uplink_printf(const char *format, ...);
+
+// Bytes received on USART6 (server ACKs)
+void uplink_input(const uint8_t *buf, uint16_t len);
+
+// Backlog replay, timers and cursor saves (call in scheduler)
+void uplink_task(void);
+
+// Console: "uplink"
+void uplink_cmd(int argc, char *argv[]);
+
+#endif
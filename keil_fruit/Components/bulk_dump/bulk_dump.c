@@ -0,0 +1,408 @@
+/**
+ * @file    bulk_dump.c
+ * @brief   Windowed binary bulk-transfer protocol implementation
+ * @details Two frame buffers form the pipeline: while one block is on the
+ *          wire, the next is read into the other. Resends read the block
+ *          again from the source instead of keeping the window in RAM, and
+ *          go ahead of new blocks.
+ */
+
+#include "bulk_dump.h"
+#include <string.h>
+
+#define BULKDUMP_NONE           0xFFFFFFFFu
+#define BULKDUMP_CTL            2               /* sending: control frame */
+
+#define BULKDUMP_BUF_FREE       0
+#define BULKDUMP_BUF_READING    1
+#define BULKDUMP_BUF_READY      2
+#define BULKDUMP_BUF_SENDING    3
+
+/* ============================================================================
+ * CRC32
+ * ============================================================================ */
+
+/* Nibble table for the reflected polynomial 0xEDB88320 */
+static const uint32_t bulkdump_crc_tab[16] = {
+    0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+    0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+    0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+    0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu
+};
+
+uint32_t BulkDump_Crc32(uint32_t crc, const uint8_t *data, uint32_t len)
+{
+    crc = ~crc;
+    while (len--) {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ bulkdump_crc_tab[crc & 0x0Fu];
+        crc = (crc >> 4) ^ bulkdump_crc_tab[crc & 0x0Fu];
+    }
+    return ~crc;
+}
+
+/* ============================================================================
+ * Private Helpers
+ * ============================================================================ */
+
+static void BulkDump_Put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t BulkDump_Get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* Fill in SOF, type, len and CRC around a payload already at f + HDR_SIZE */
+static uint16_t BulkDump_Frame(uint8_t *f, uint8_t type, uint16_t len)
+{
+    f[0] = BULKDUMP_SOF0;
+    f[1] = BULKDUMP_SOF1;
+    f[2] = type;
+    f[3] = (uint8_t)len;
+    f[4] = (uint8_t)(len >> 8);
+    BulkDump_Put32(&f[BULKDUMP_HDR_SIZE + len],
+                   BulkDump_Crc32(0, &f[2], (uint32_t)len + 3u));
+    return (uint16_t)(BULKDUMP_HDR_SIZE + len + BULKDUMP_CRC_SIZE);
+}
+
+static void BulkDump_Control(BulkDump *bd, uint8_t type, const uint8_t *payload, uint16_t len)
+{
+    if (bd->sending == BULKDUMP_CTL) {
+        return;                     /* Previous one still on the wire; host repeats REQ */
+    }
+    memcpy(&bd->ctl[BULKDUMP_HDR_SIZE], payload, len);
+    bd->ctl_len = BulkDump_Frame(bd->ctl, type, len);
+}
+
+static void BulkDump_Leave(BulkDump *bd)
+{
+    bd->active = 0;
+    bd->running = 0;
+    bd->ctl_len = 0;
+}
+
+static void BulkDump_Request(BulkDump *bd, const uint8_t *p)
+{
+    uint8_t mode = p[0];
+    uint32_t start = BulkDump_Get32(&p[1]);
+    uint32_t end = BulkDump_Get32(&p[5]);
+    uint8_t reply[12];
+    uint8_t i;
+
+    /* Blocks of the previous transfer, ready or still being read, carry
+     * seqs of that transfer: none of them may go out as DATA of this one */
+    bd->running = 0;
+    bd->gen++;
+    for (i = 0; i < 2; i++) {
+        if (bd->bufs[i].state == BULKDUMP_BUF_READY) {
+            bd->bufs[i].state = BULKDUMP_BUF_FREE;
+        }
+    }
+    if (mode != BULKDUMP_MODE_ADDR && mode != BULKDUMP_MODE_TIME) {
+        reply[0] = BULKDUMP_ERR_MODE;
+        BulkDump_Control(bd, BULKDUMP_ERR, reply, 1);
+        return;
+    }
+    if (!bd->port->open(bd->port->ctx, mode, start, end)) {
+        reply[0] = BULKDUMP_ERR_RANGE;
+        BulkDump_Control(bd, BULKDUMP_ERR, reply, 1);
+        return;
+    }
+
+    bd->running = 1;
+    bd->base = 0;
+    bd->next = 0;
+    bd->high = 0;
+    bd->resend = 0;
+    bd->last = BULKDUMP_NONE;
+    bd->ack_tick = bd->rx_tick;
+
+    reply[0] = mode;
+    BulkDump_Put32(&reply[1], start);
+    BulkDump_Put32(&reply[5], end);
+    reply[9] = (uint8_t)BULKDUMP_BLOCK_SIZE;
+    reply[10] = (uint8_t)(BULKDUMP_BLOCK_SIZE >> 8);
+    reply[11] = BULKDUMP_WINDOW;
+    BulkDump_Control(bd, BULKDUMP_INFO, reply, sizeof(reply));
+}
+
+static void BulkDump_Handle(BulkDump *bd, uint8_t type, const uint8_t *p, uint16_t len)
+{
+    uint32_t seq;
+
+    bd->rx_tick = bd->port->now_ms();
+
+    switch (type) {
+    case BULKDUMP_REQ:
+        if (len == 9) {
+            BulkDump_Request(bd, p);
+        }
+        break;
+
+    case BULKDUMP_ACK:
+        if (len != 4 || !bd->running) {
+            break;
+        }
+        seq = BulkDump_Get32(p);
+        if (seq > bd->high) {
+            seq = bd->high;
+        }
+        if (seq > bd->base) {
+            bd->resend = (seq - bd->base < 32u) ? bd->resend >> (seq - bd->base) : 0;
+            bd->base = seq;
+            bd->ack_tick = bd->rx_tick;
+        }
+        break;
+
+    case BULKDUMP_NAK:
+        if (len != 4 || !bd->running) {
+            break;
+        }
+        seq = BulkDump_Get32(p);
+        if (seq >= bd->base && seq < bd->high) {
+            bd->resend |= 1u << (seq - bd->base);
+            bd->stats.naks++;
+        }
+        break;
+
+    case BULKDUMP_BYE:
+        BulkDump_Leave(bd);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/* ============================================================================
+ * Public Functions
+ * ============================================================================ */
+
+void BulkDump_Init(BulkDump *bd, const BulkDump_Port *port)
+{
+    memset(bd, 0, sizeof(*bd));
+    bd->port = port;
+    bd->reading = -1;
+    bd->sending = -1;
+}
+
+void BulkDump_Enter(BulkDump *bd)
+{
+    bd->active = 1;
+    bd->running = 0;
+    bd->rx_len = 0;
+    bd->ctl_len = 0;
+    bd->rx_tick = bd->port->now_ms();
+}
+
+void BulkDump_Input(BulkDump *bd, const uint8_t *data, uint16_t len)
+{
+    if (!bd->active) {
+        return;
+    }
+
+    while (len--) {
+        uint8_t c = *data++;
+        uint16_t plen;
+
+        if (bd->rx_len == 0) {
+            if (c == BULKDUMP_SOF0) {
+                bd->rx[bd->rx_len++] = c;
+            }
+            continue;
+        }
+        if (bd->rx_len == 1) {
+            if (c == BULKDUMP_SOF1) {
+                bd->rx[bd->rx_len++] = c;
+            } else if (c != BULKDUMP_SOF0) {
+                bd->rx_len = 0;
+            }
+            continue;
+        }
+
+        bd->rx[bd->rx_len++] = c;
+        if (bd->rx_len < BULKDUMP_HDR_SIZE) {
+            continue;
+        }
+
+        plen = (uint16_t)(bd->rx[3] | (bd->rx[4] << 8));
+        if (plen > BULKDUMP_RX_MAX) {
+            bd->stats.rx_errors++;
+            bd->rx_len = 0;
+            continue;
+        }
+        if (bd->rx_len < BULKDUMP_HDR_SIZE + plen + BULKDUMP_CRC_SIZE) {
+            continue;
+        }
+
+        if (BulkDump_Crc32(0, &bd->rx[2], (uint32_t)plen + 3u) ==
+            BulkDump_Get32(&bd->rx[BULKDUMP_HDR_SIZE + plen])) {
+            BulkDump_Handle(bd, bd->rx[2], &bd->rx[BULKDUMP_HDR_SIZE], plen);
+        } else {
+            bd->stats.rx_errors++;
+        }
+        bd->rx_len = 0;
+    }
+}
+
+uint8_t BulkDump_Poll(BulkDump *bd)
+{
+    const BulkDump_Port *port = bd->port;
+    uint32_t now;
+    int32_t n;
+    uint8_t i;
+
+    /* An abandoned read still has to land before its buffer is reused */
+    if (!bd->active && bd->reading < 0) {
+        return 0;
+    }
+
+    now = port->now_ms();
+    if (bd->active && (now - bd->rx_tick) >= BULKDUMP_IDLE_MS) {
+        BulkDump_Leave(bd);
+    }
+
+    /* Wire free again */
+    if (bd->sending >= 0 && !port->tx_busy(port->ctx)) {
+        if (bd->sending != BULKDUMP_CTL) {
+            bd->bufs[bd->sending].state = BULKDUMP_BUF_FREE;
+        }
+        bd->sending = -1;
+    }
+
+    /* Block read finished */
+    if (bd->reading >= 0) {
+        BulkDump_Buf *b = &bd->bufs[bd->reading];
+
+        n = port->read_poll(port->ctx);
+        if (n >= 0) {
+            bd->reading = -1;
+            if (!bd->running || b->gen != bd->gen || b->seq < bd->base) {
+                b->state = BULKDUMP_BUF_FREE;
+            } else {
+                BulkDump_Put32(&b->buf[BULKDUMP_HDR_SIZE], b->seq);
+                BulkDump_Frame(b->buf, BULKDUMP_DATA, (uint16_t)(4 + n));
+                if (n == 0) {
+                    bd->last = b->seq;
+                }
+                b->state = BULKDUMP_BUF_READY;
+            }
+        }
+    }
+
+    if (!bd->active) {
+        return 0;
+    }
+
+    if (bd->running) {
+        /* Nothing acknowledged for a while: send the oldest block again */
+        if (bd->base < bd->high && (now - bd->ack_tick) >= BULKDUMP_RTO_MS) {
+            bd->resend |= 1u;
+            bd->ack_tick = now;
+            bd->stats.timeouts++;
+        }
+
+        /* All blocks, end marker included, acknowledged */
+        if (bd->last != BULKDUMP_NONE && bd->base > bd->last) {
+            bd->running = 0;
+        }
+    }
+
+    /* Start a read: a block to resend first, else the next new one */
+    if (bd->running && bd->reading < 0) {
+        uint32_t seq = BULKDUMP_NONE;
+        uint32_t bit = 0;
+
+        if (bd->resend != 0) {
+            while ((bd->resend & (1u << bit)) == 0) {
+                bit++;
+            }
+            seq = bd->base + bit;
+            for (i = 0; i < 2; i++) {
+                if (bd->bufs[i].state == BULKDUMP_BUF_READY && bd->bufs[i].seq == seq) {
+                    bd->resend &= ~(1u << bit);     /* Still queued, not sent yet */
+                    seq = BULKDUMP_NONE;
+                }
+            }
+        } else if (bd->next < bd->base + BULKDUMP_WINDOW &&
+                   (bd->last == BULKDUMP_NONE || bd->next <= bd->last)) {
+            seq = bd->next;
+        }
+
+        for (i = 0; seq != BULKDUMP_NONE && i < 2; i++) {
+            BulkDump_Buf *b = &bd->bufs[i];
+
+            if (b->state != BULKDUMP_BUF_FREE) {
+                continue;
+            }
+            if (port->read_start(port->ctx, seq, &b->buf[BULKDUMP_HDR_SIZE + 4],
+                                 BULKDUMP_BLOCK_SIZE)) {
+                b->seq = seq;
+                b->gen = bd->gen;
+                b->state = BULKDUMP_BUF_READING;
+                bd->reading = (int8_t)i;
+                if (seq == bd->next) {
+                    bd->next++;
+                } else {
+                    bd->resend &= ~(1u << bit);
+                }
+            }
+            break;
+        }
+    }
+
+    /* Send: control frames first, then the lowest ready block */
+    if (bd->sending < 0 && !port->tx_busy(port->ctx)) {
+        if (bd->ctl_len > 0) {
+            if (port->tx_start(port->ctx, bd->ctl, bd->ctl_len)) {
+                bd->ctl_len = 0;
+                bd->sending = BULKDUMP_CTL;
+            }
+        } else {
+            int8_t pick = -1;
+
+            for (i = 0; i < 2; i++) {
+                BulkDump_Buf *b = &bd->bufs[i];
+
+                if (b->state != BULKDUMP_BUF_READY) {
+                    continue;
+                }
+                if (!bd->running || b->gen != bd->gen || b->seq < bd->base) {
+                    b->state = BULKDUMP_BUF_FREE;
+                    continue;
+                }
+                if (pick < 0 || b->seq < bd->bufs[pick].seq) {
+                    pick = (int8_t)i;
+                }
+            }
+
+            if (pick >= 0) {
+                BulkDump_Buf *b = &bd->bufs[pick];
+                uint16_t len = (uint16_t)(b->buf[3] | (b->buf[4] << 8));
+
+                if (port->tx_start(port->ctx, b->buf,
+                                   (uint16_t)(BULKDUMP_HDR_SIZE + len + BULKDUMP_CRC_SIZE))) {
+                    b->state = BULKDUMP_BUF_SENDING;
+                    bd->sending = pick;
+                    bd->stats.frames++;
+                    if (b->seq < bd->high) {
+                        bd->stats.resends++;
+                    } else {
+                        bd->high = b->seq + 1u;
+                    }
+                    if (bd->base == bd->high - 1u && b->seq == bd->base) {
+                        bd->ack_tick = now;     /* Timer runs from the first unacked send */
+                    }
+                }
+            }
+        }
+    }
+
+    return bd->active;
+}
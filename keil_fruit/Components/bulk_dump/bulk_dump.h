@@ -0,0 +1,172 @@
+/**
+ * @file    bulk_dump.h
+ * @brief   Windowed binary bulk-transfer protocol (device side)
+ * @details Moves a flash address range, or the log records in a timestamp
+ *          range, to a host over a byte stream (USART1).
+ *
+ *          Frame (both directions):
+ *            0xA5 0x5A | type | len (u16 LE) | payload | CRC32 (u32 LE)
+ *          The CRC covers type, len and payload. Bad CRC or an oversized
+ *          len drops the frame and the parser hunts for the next 0xA5 0x5A.
+ *
+ *          Host -> device:
+ *            REQ   u8 mode, u32 start, u32 end     start (or restart) a transfer
+ *            ACK   u32 next                        all blocks below next received
+ *            NAK   u32 seq                         block seq missing, resend it
+ *            BYE                                   leave binary mode
+ *          Device -> host:
+ *            INFO  u8 mode, u32 start, u32 end, u16 block, u8 window
+ *            DATA  u32 seq, block payload          empty payload: end of data
+ *            ERR   u8 code                         REQ rejected
+ *
+ *          Blocks are numbered from 0 for each REQ. Up to BULKDUMP_WINDOW
+ *          blocks are unacknowledged at a time (selective repeat): the host
+ *          keeps blocks that arrive after a gap and NAKs only the missing
+ *          ones. No ACK progress for BULKDUMP_RTO_MS resends the oldest
+ *          unacknowledged block. The transfer ends when the empty DATA
+ *          block is acknowledged.
+ *
+ *          The device keeps no state between REQs. To resume, the host asks
+ *          again from where its file ends (next address, or the timestamp
+ *          after its last record).
+ *
+ *          I/O goes through BulkDump_Port, so the same code runs on the
+ *          board (UART/SPI DMA) and on a host test bench.
+ */
+
+#ifndef __BULK_DUMP_H__
+#define __BULK_DUMP_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+#define BULKDUMP_SOF0           0xA5
+#define BULKDUMP_SOF1           0x5A
+#define BULKDUMP_HDR_SIZE       5               /* SOF, type, len */
+#define BULKDUMP_CRC_SIZE       4
+#define BULKDUMP_BLOCK_SIZE     512             /* DATA payload, after seq */
+#define BULKDUMP_WINDOW         8               /* Blocks in flight (<= 32) */
+#define BULKDUMP_RTO_MS         250             /* No ACK progress: resend oldest */
+#define BULKDUMP_IDLE_MS        5000            /* No host frame: leave binary mode */
+#define BULKDUMP_RX_MAX         16              /* Longest host payload */
+
+#define BULKDUMP_FRAME_MAX      (BULKDUMP_HDR_SIZE + 4 + BULKDUMP_BLOCK_SIZE + BULKDUMP_CRC_SIZE)
+
+/* Frame types */
+#define BULKDUMP_REQ            0x01
+#define BULKDUMP_ACK            0x02
+#define BULKDUMP_NAK            0x03
+#define BULKDUMP_BYE            0x04
+#define BULKDUMP_INFO           0x81
+#define BULKDUMP_DATA           0x82
+#define BULKDUMP_ERR            0x83
+
+/* REQ modes */
+#define BULKDUMP_MODE_ADDR      0               /* Flash bytes [start, end) */
+#define BULKDUMP_MODE_TIME      1               /* Records with start <= ts <= end */
+
+/* ERR codes */
+#define BULKDUMP_ERR_RANGE      1
+#define BULKDUMP_ERR_MODE       2
+
+/* ============================================================================
+ * Port
+ * ============================================================================ */
+
+/**
+ * Block source and transport. read_start/read_poll produce block seq:
+ * read_start begins it (seq may go back for a resend, never below the
+ * oldest unacknowledged block), read_poll returns < 0 while busy, else the
+ * block length (0: past the end of the range).
+ */
+typedef struct {
+    uint8_t (*open)(void *ctx, uint8_t mode, uint32_t start, uint32_t end);   /* 0: bad range */
+    uint8_t (*read_start)(void *ctx, uint32_t seq, uint8_t *buf, uint16_t max);
+    int32_t (*read_poll)(void *ctx);
+    uint8_t (*tx_start)(void *ctx, const uint8_t *data, uint16_t len);       /* 0: busy */
+    uint8_t (*tx_busy)(void *ctx);
+    uint32_t (*now_ms)(void);
+    void *ctx;
+} BulkDump_Port;
+
+/* ============================================================================
+ * Protocol State
+ * ============================================================================ */
+typedef struct {
+    uint8_t buf[BULKDUMP_FRAME_MAX];
+    uint32_t seq;
+    uint8_t state;                  /* BULKDUMP_BUF_* */
+    uint8_t gen;                    /* Transfer (REQ) the block was read for */
+} BulkDump_Buf;
+
+typedef struct {
+    uint32_t frames;                /* DATA frames sent, resends included */
+    uint32_t resends;               /* Blocks sent again (NAK or timeout) */
+    uint32_t naks;
+    uint32_t timeouts;
+    uint32_t rx_errors;             /* Host frames dropped (CRC, length) */
+} BulkDump_Stats;
+
+typedef struct {
+    const BulkDump_Port *port;
+    uint8_t active;                 /* Binary mode: console input suspended */
+    uint8_t running;                /* Transfer in progress */
+    uint8_t gen;                    /* Bumped by every REQ */
+    uint32_t base;                  /* Oldest unacknowledged block */
+    uint32_t next;                  /* Next new block to read */
+    uint32_t high;                  /* Highest block sent + 1 */
+    uint32_t resend;                /* Bit i: block base + i to send again */
+    uint32_t last;                  /* End-of-data block, or 0xFFFFFFFF */
+    uint32_t ack_tick;              /* Last ACK progress */
+    uint32_t rx_tick;               /* Last valid host frame */
+    int8_t reading;                 /* Buffer being read, -1: none */
+    int8_t sending;                 /* Buffer on the wire, -1: none */
+    BulkDump_Buf bufs[2];
+    uint8_t ctl[BULKDUMP_HDR_SIZE + 16 + BULKDUMP_CRC_SIZE];    /* INFO / ERR */
+    uint16_t ctl_len;               /* Control frame waiting to go out */
+    uint8_t rx[BULKDUMP_HDR_SIZE + BULKDUMP_RX_MAX + BULKDUMP_CRC_SIZE];
+    uint16_t rx_len;
+    BulkDump_Stats stats;
+} BulkDump;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief  Bind the port; binary mode off
+ */
+void BulkDump_Init(BulkDump *bd, const BulkDump_Port *port);
+
+/**
+ * @brief  Enter binary mode and wait for a REQ
+ */
+void BulkDump_Enter(BulkDump *bd);
+
+/**
+ * @brief  Feed bytes received from the host
+ */
+void BulkDump_Input(BulkDump *bd, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief  Advance reads, sends and timers (call every scheduler tick)
+ * @retval 1 while in binary mode
+ */
+uint8_t BulkDump_Poll(BulkDump *bd);
+
+/**
+ * @brief  CRC-32 (IEEE 802.3), continuing from crc (start with 0)
+ */
+uint32_t BulkDump_Crc32(uint32_t crc, const uint8_t *data, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BULK_DUMP_H__ */
@@ -0,0 +1,329 @@
+/**
+ * @file    dsp_filter.c
+ * @brief   Fixed-point filter library implementation
+ * @details The SIMD paths are selected when the compiler reports the
+ *          Cortex-M DSP extension (__ARM_FEATURE_DSP). They only change
+ *          how products are accumulated; rounding and saturation are
+ *          shared with the *_Ref functions, so both give identical output.
+ */
+
+#include "dsp_filter.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(__arm__) || defined(__ARMCC_VERSION)
+#include "main.h"       /* CMSIS core: SIMD intrinsics */
+#endif
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define DSP_FILTER_USE_SIMD     1
+#else
+#define DSP_FILTER_USE_SIMD     0
+#endif
+
+/* ============================================================================
+ * Private Helpers
+ * ============================================================================ */
+
+static int16_t dsp_sat_q15(int64_t v)
+{
+    if (v > 32767) {
+        return 32767;
+    }
+    if (v < -32768) {
+        return -32768;
+    }
+    return (int16_t)v;
+}
+
+/*
+ * Q14 accumulator back to a Q15 sample with first-order error feedback:
+ * the bits dropped here are added to the next accumulator. Without it the
+ * output rounding, amplified by 1 / (1 + a1 + a2), leaves a dead band of
+ * tens of LSB around the true DC level at low fc / fs.
+ */
+static int16_t dsp_biquad_output(int64_t acc, int32_t *err)
+{
+    int16_t y;
+
+    acc += *err;
+    y = dsp_sat_q15((acc + (1 << (DSP_BIQUAD_COEF_SHIFT - 1))) >> DSP_BIQUAD_COEF_SHIFT);
+    *err = (int32_t)(acc - ((int64_t)y << DSP_BIQUAD_COEF_SHIFT));
+    if (*err > (1 << DSP_BIQUAD_COEF_SHIFT) || *err < -(1 << DSP_BIQUAD_COEF_SHIFT)) {
+        *err = 0;       /* Saturated: do not carry the overflow */
+    }
+    return y;
+}
+
+#if DSP_FILTER_USE_SIMD
+static uint32_t dsp_load_pair(const int16_t *p)
+{
+    uint32_t pair;
+    /* Single (possibly unaligned) LDR; little-endian puts p[0] low */
+    memcpy(&pair, p, sizeof(pair));
+    return pair;
+}
+#endif
+
+/* ============================================================================
+ * Block Kernels
+ * ============================================================================ */
+
+int32_t DSP_SumQ15_Ref(const int16_t *x, uint32_t n)
+{
+    int32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        acc += x[i];
+    }
+    return acc;
+}
+
+int32_t DSP_SumQ15(const int16_t *x, uint32_t n)
+{
+#if DSP_FILTER_USE_SIMD
+    uint32_t acc = 0;
+    uint32_t i = 0;
+
+    /* (x[i], x[i+1]) . (1, 1) per instruction */
+    for (; i + 4 <= n; i += 4) {
+        acc = __SMLAD(dsp_load_pair(&x[i]), 0x00010001u, acc);
+        acc = __SMLAD(dsp_load_pair(&x[i + 2]), 0x00010001u, acc);
+    }
+    for (; i + 2 <= n; i += 2) {
+        acc = __SMLAD(dsp_load_pair(&x[i]), 0x00010001u, acc);
+    }
+    if (i < n) {
+        acc += (uint32_t)(int32_t)x[i];
+    }
+    return (int32_t)acc;
+#else
+    return DSP_SumQ15_Ref(x, n);
+#endif
+}
+
+/* ============================================================================
+ * Moving Average
+ * ============================================================================ */
+
+void DSP_MovAvgQ15_Init(DSP_MovAvgQ15 *f, uint16_t len)
+{
+    if (len == 0) {
+        len = 1;
+    }
+    if (len > DSP_MOVAVG_MAX_LEN) {
+        len = DSP_MOVAVG_MAX_LEN;
+    }
+    f->len = len;
+    f->idx = 0;
+    f->count = 0;
+    f->sum = 0;
+}
+
+int16_t DSP_MovAvgQ15_Update(DSP_MovAvgQ15 *f, int16_t x)
+{
+    if (f->count == f->len) {
+        f->sum -= f->buf[f->idx];
+    } else {
+        f->count++;
+    }
+    f->buf[f->idx] = x;
+    f->sum += x;
+    f->idx = (uint16_t)((f->idx + 1) % f->len);
+
+    int32_t half = (f->sum >= 0) ? (f->count / 2) : -(f->count / 2);
+    return (int16_t)((f->sum + half) / f->count);
+}
+
+void DSP_MovAvgQ31_Init(DSP_MovAvgQ31 *f, uint16_t len)
+{
+    if (len == 0) {
+        len = 1;
+    }
+    if (len > DSP_MOVAVG_MAX_LEN) {
+        len = DSP_MOVAVG_MAX_LEN;
+    }
+    f->len = len;
+    f->idx = 0;
+    f->count = 0;
+    f->sum = 0;
+}
+
+int32_t DSP_MovAvgQ31_Update(DSP_MovAvgQ31 *f, int32_t x)
+{
+    if (f->count == f->len) {
+        f->sum -= f->buf[f->idx];
+    } else {
+        f->count++;
+    }
+    f->buf[f->idx] = x;
+    f->sum += x;
+    f->idx = (uint16_t)((f->idx + 1) % f->len);
+
+    int64_t half = (f->sum >= 0) ? (f->count / 2) : -(f->count / 2);
+    return (int32_t)((f->sum + half) / f->count);
+}
+
+/* ============================================================================
+ * Single-Pole IIR (EMA)
+ * ============================================================================ */
+
+void DSP_EmaQ31_Init(DSP_EmaQ31 *f, int16_t alpha_q15)
+{
+    if (alpha_q15 <= 0) {
+        alpha_q15 = 1;
+    }
+    f->alpha = alpha_q15;
+    f->y = 0;
+    f->primed = 0;
+}
+
+int32_t DSP_EmaQ31_Update(DSP_EmaQ31 *f, int32_t x)
+{
+    if (!f->primed) {
+        f->y = x;
+        f->primed = 1;
+        return f->y;
+    }
+
+    int64_t step = ((int64_t)x - f->y) * f->alpha;
+    f->y += (int32_t)((step + (1 << 14)) >> 15);
+    return f->y;
+}
+
+/* ============================================================================
+ * Median Spike Rejector
+ * ============================================================================ */
+
+void DSP_Median_Init(DSP_Median *f, uint8_t len)
+{
+    if (len == 0) {
+        len = 1;
+    }
+    if (len > DSP_MEDIAN_MAX_LEN) {
+        len = DSP_MEDIAN_MAX_LEN;
+    }
+    if ((len & 1u) == 0) {
+        len--;
+    }
+    f->len = len;
+    f->idx = 0;
+    f->count = 0;
+}
+
+int32_t DSP_Median_Update(DSP_Median *f, int32_t x)
+{
+    int32_t sorted[DSP_MEDIAN_MAX_LEN];
+
+    f->buf[f->idx] = x;
+    f->idx = (uint8_t)((f->idx + 1) % f->len);
+    if (f->count < f->len) {
+        f->count++;
+    }
+
+    /* Insertion sort; N <= 9 so this beats anything clever */
+    for (uint8_t i = 0; i < f->count; i++) {
+        int32_t v = f->buf[i];
+        int8_t j = (int8_t)i - 1;
+        while (j >= 0 && sorted[j] > v) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = v;
+    }
+
+    return sorted[f->count / 2];
+}
+
+/* ============================================================================
+ * Biquad
+ * ============================================================================ */
+
+static int16_t dsp_q14(float v)
+{
+    return dsp_sat_q15((int64_t)lrintf(v * (float)(1 << DSP_BIQUAD_COEF_SHIFT)));
+}
+
+void DSP_BiquadQ15_InitLowpass(DSP_BiquadQ15 *f, float fc_hz, float fs_hz)
+{
+    const float q = 0.70710678f;
+    float w0 = 2.0f * 3.14159265f * fc_hz / fs_hz;
+    float cosw = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * q);
+    float a0 = 1.0f + alpha;
+
+    f->b0 = dsp_q14((1.0f - cosw) / 2.0f / a0);
+    f->b2 = f->b0;
+    f->na1 = dsp_q14(2.0f * cosw / a0);
+    f->na2 = dsp_q14(-(1.0f - alpha) / a0);
+
+    /* Unity DC gain after quantization: b0 + b1 + b2 = 1 - na1 - na2 */
+    int32_t target = (1 << DSP_BIQUAD_COEF_SHIFT) - f->na1 - f->na2;
+    f->b1 = dsp_sat_q15(target - f->b0 - f->b2);
+
+    f->x1 = f->x2 = 0;
+    f->y1 = f->y2 = 0;
+    f->err = 0;
+}
+
+void DSP_BiquadQ15_Process_Ref(DSP_BiquadQ15 *f, const int16_t *in, int16_t *out, uint32_t n)
+{
+    int16_t x1 = f->x1, x2 = f->x2;
+    int16_t y1 = f->y1, y2 = f->y2;
+    int32_t err = f->err;
+
+    for (uint32_t i = 0; i < n; i++) {
+        int16_t x0 = in[i];
+        int64_t acc = (int64_t)f->b0 * x0 + (int64_t)f->b1 * x1 + (int64_t)f->b2 * x2 +
+                      (int64_t)f->na1 * y1 + (int64_t)f->na2 * y2;
+        int16_t y0 = dsp_biquad_output(acc, &err);
+
+        x2 = x1;
+        x1 = x0;
+        y2 = y1;
+        y1 = y0;
+        out[i] = y0;
+    }
+
+    f->x1 = x1;
+    f->x2 = x2;
+    f->y1 = y1;
+    f->y2 = y2;
+    f->err = err;
+}
+
+void DSP_BiquadQ15_Process(DSP_BiquadQ15 *f, const int16_t *in, int16_t *out, uint32_t n)
+{
+#if DSP_FILTER_USE_SIMD
+    /* Coefficient pairs are constant across the block */
+    uint32_t c_b0b1 = __PKHBT(f->b0, f->b1, 16);
+    uint32_t c_b2a1 = __PKHBT(f->b2, f->na1, 16);
+    uint32_t c_a2 = __PKHBT(f->na2, 0, 16);
+    int16_t x1 = f->x1, x2 = f->x2;
+    int16_t y1 = f->y1, y2 = f->y2;
+    int32_t err = f->err;
+
+    for (uint32_t i = 0; i < n; i++) {
+        int16_t x0 = in[i];
+        int64_t acc;
+
+        acc = (int64_t)__SMLALD(c_b0b1, __PKHBT(x0, x1, 16), 0);
+        acc = (int64_t)__SMLALD(c_b2a1, __PKHBT(x2, y1, 16), (uint64_t)acc);
+        acc = (int64_t)__SMLALD(c_a2, __PKHBT(y2, 0, 16), (uint64_t)acc);
+        int16_t y0 = dsp_biquad_output(acc, &err);
+
+        x2 = x1;
+        x1 = x0;
+        y2 = y1;
+        y1 = y0;
+        out[i] = y0;
+    }
+
+    f->x1 = x1;
+    f->x2 = x2;
+    f->y1 = y1;
+    f->y2 = y2;
+    f->err = err;
+#else
+    DSP_BiquadQ15_Process_Ref(f, in, out, n);
+#endif
+}
@@ -0,0 +1,157 @@
+/**
+ * @file    dsp_filter.h
+ * @brief   Fixed-point filter library (Q15 / Q31)
+ * @details Moving average, single-pole IIR (EMA), median-of-N spike
+ *          rejector and biquad low-pass.
+ *          On Cortex-M4 the block kernels use the DSP extension
+ *          (__SMLAD / __SMLALD, two 16-bit MACs per instruction). Each of
+ *          them has a portable scalar *_Ref twin that builds anywhere and
+ *          is the bit-exact reference for the SIMD path.
+ */
+
+#ifndef __DSP_FILTER_H__
+#define __DSP_FILTER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+#define DSP_MOVAVG_MAX_LEN      32      /* Longest moving-average window */
+#define DSP_MEDIAN_MAX_LEN      9       /* Longest median window (odd) */
+
+#define DSP_Q15_ONE             32768   /* 1.0 in Q15 */
+#define DSP_BIQUAD_COEF_SHIFT   14      /* Biquad coefficients are Q14 */
+
+/* ============================================================================
+ * Filter State Structures
+ * ============================================================================ */
+typedef struct {
+    int16_t buf[DSP_MOVAVG_MAX_LEN];
+    int32_t sum;
+    uint16_t len;                   /* Window length */
+    uint16_t idx;                   /* Next slot to overwrite */
+    uint16_t count;                 /* Samples in window (<= len) */
+} DSP_MovAvgQ15;
+
+typedef struct {
+    int32_t buf[DSP_MOVAVG_MAX_LEN];
+    int64_t sum;
+    uint16_t len;
+    uint16_t idx;
+    uint16_t count;
+} DSP_MovAvgQ31;
+
+typedef struct {
+    int32_t y;                      /* Filter output */
+    int16_t alpha;                  /* Smoothing factor, Q15 (0 < alpha <= 1) */
+    uint8_t primed;                 /* First sample loads y directly */
+} DSP_EmaQ31;
+
+typedef struct {
+    int32_t buf[DSP_MEDIAN_MAX_LEN];
+    uint8_t len;
+    uint8_t idx;
+    uint8_t count;
+} DSP_Median;
+
+typedef struct {
+    int16_t b0, b1, b2;             /* Feed-forward, Q14 */
+    int16_t na1, na2;               /* Negated feedback -a1, -a2, Q14 */
+    int16_t x1, x2;                 /* Input history */
+    int16_t y1, y2;                 /* Output history */
+    int32_t err;                    /* Rounding residue carried forward */
+} DSP_BiquadQ15;
+
+/* ============================================================================
+ * Function Prototypes - Block Kernels
+ * ============================================================================ */
+
+/**
+ * @brief  Sum of a Q15 block (SIMD: two samples per __SMLAD)
+ * @param  x: Input samples
+ * @param  n: Number of samples
+ * @retval 32-bit sum (caller keeps n * 32767 within int32)
+ */
+int32_t DSP_SumQ15(const int16_t *x, uint32_t n);
+int32_t DSP_SumQ15_Ref(const int16_t *x, uint32_t n);
+
+/* ============================================================================
+ * Function Prototypes - Moving Average
+ * ============================================================================ */
+
+/**
+ * @brief  Initialize a moving average
+ * @param  f: Filter state
+ * @param  len: Window length (1 - DSP_MOVAVG_MAX_LEN)
+ */
+void DSP_MovAvgQ15_Init(DSP_MovAvgQ15 *f, uint16_t len);
+
+/**
+ * @brief  Push one sample, return the rounded window mean
+ * @note   Until the window is full the mean is over the samples seen so far
+ */
+int16_t DSP_MovAvgQ15_Update(DSP_MovAvgQ15 *f, int16_t x);
+
+void DSP_MovAvgQ31_Init(DSP_MovAvgQ31 *f, uint16_t len);
+int32_t DSP_MovAvgQ31_Update(DSP_MovAvgQ31 *f, int32_t x);
+
+/* ============================================================================
+ * Function Prototypes - Single-Pole IIR (EMA)
+ * ============================================================================ */
+
+/**
+ * @brief  Initialize an EMA: y += alpha * (x - y)
+ * @param  f: Filter state
+ * @param  alpha_q15: Smoothing factor in Q15 (1 - 32767; 32767 ~ no filtering)
+ */
+void DSP_EmaQ31_Init(DSP_EmaQ31 *f, int16_t alpha_q15);
+int32_t DSP_EmaQ31_Update(DSP_EmaQ31 *f, int32_t x);
+
+/* ============================================================================
+ * Function Prototypes - Median Spike Rejector
+ * ============================================================================ */
+
+/**
+ * @brief  Initialize a median-of-N filter
+ * @param  f: Filter state
+ * @param  len: Window length, odd (1 - DSP_MEDIAN_MAX_LEN)
+ */
+void DSP_Median_Init(DSP_Median *f, uint8_t len);
+int32_t DSP_Median_Update(DSP_Median *f, int32_t x);
+
+/* ============================================================================
+ * Function Prototypes - Biquad
+ * ============================================================================ */
+
+/**
+ * @brief  Design a unity-DC-gain low-pass biquad (RBJ cookbook)
+ * @param  f: Filter state (coefficients set, history cleared)
+ * @param  fc_hz: Cut-off frequency
+ * @param  fs_hz: Sample rate
+ * @note   Q14 feedback needs fc_hz / fs_hz >= ~0.005 to stay stable.
+ *         After quantization b1 absorbs the rounding error, so a constant
+ *         input passes through unchanged on average; the carried rounding
+ *         residue can leave a +-1 LSB limit cycle around it.
+ */
+void DSP_BiquadQ15_InitLowpass(DSP_BiquadQ15 *f, float fc_hz, float fs_hz);
+
+/**
+ * @brief  Run a block through the biquad (Direct Form I)
+ * @param  f: Filter state
+ * @param  in: Input samples
+ * @param  out: Output samples (may alias in)
+ * @param  n: Number of samples
+ */
+void DSP_BiquadQ15_Process(DSP_BiquadQ15 *f, const int16_t *in, int16_t *out, uint32_t n);
+void DSP_BiquadQ15_Process_Ref(DSP_BiquadQ15 *f, const int16_t *in, int16_t *out, uint32_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DSP_FILTER_H__ */
@@ -0,0 +1,442 @@
+/**
+ * @file    flash_asset.c
+ * @brief   Flash asset image and glyph cache implementation
+ */
+
+#include "flash_asset.h"
+#include <stddef.h>
+#include <string.h>
+
+#define FLASHASSET_DIR_END(count)   ((uint32_t)sizeof(FlashAsset_Header) + \
+                                     (uint32_t)(count) * sizeof(FlashAsset_Entry))
+#define FLASHASSET_READ_CHUNK       4096
+
+/* ============================================================================
+ * CRC32
+ * ============================================================================ */
+
+/* Nibble table for the reflected polynomial 0xEDB88320 */
+static const uint32_t flashasset_crc_tab[16] = {
+    0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+    0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+    0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+    0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu
+};
+
+uint32_t FlashAsset_Crc32(uint32_t crc, const void *data, uint32_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ flashasset_crc_tab[crc & 0x0Fu];
+        crc = (crc >> 4) ^ flashasset_crc_tab[crc & 0x0Fu];
+    }
+    return ~crc;
+}
+
+/* ============================================================================
+ * Private Helpers
+ * ============================================================================ */
+
+static void FlashAsset_ReadDone(MD25Q64_Handle *handle, MD25Q64_Status status, void *ctx)
+{
+    FlashAsset *fa = (FlashAsset *)ctx;
+
+    (void)handle;
+    fa->read_status = status;
+    fa->read_done = 1;
+}
+
+/* One queued fast read, waited for: a single transaction, never cached */
+static FlashAsset_Status FlashAsset_ReadSpan(FlashAsset *fa, uint32_t address,
+                                             uint8_t *data, uint32_t len)
+{
+    MD25Q64_Status st;
+
+    fa->read_done = 0;
+    while ((st = MD25Q64_FastRead_Start(fa->flash, address, data, len,
+                                        FlashAsset_ReadDone, fa)) == MD25Q64_BUSY) {
+        MD25Q64_Poll(fa->flash);            /* Queue full: let it drain */
+    }
+    if (st != MD25Q64_OK) {
+        return FLASHASSET_ERROR;
+    }
+    while (!fa->read_done) {
+        MD25Q64_Poll(fa->flash);
+    }
+    return (fa->read_status == MD25Q64_OK) ? FLASHASSET_OK : FLASHASSET_ERROR;
+}
+
+static uint16_t FlashAsset_Index(const FlashAsset_Font *font, uint32_t cp)
+{
+    uint8_t lo = 0, hi = font->range_count;
+
+    /* Last range starting at or below cp */
+    while (hi - lo > 1) {
+        uint8_t mid = (uint8_t)((lo + hi) / 2u);
+        if (font->ranges[mid].first <= cp) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    if (cp >= font->ranges[lo].first && cp - font->ranges[lo].first < font->ranges[lo].count) {
+        return (uint16_t)(font->ranges[lo].base + (cp - font->ranges[lo].first));
+    }
+    return font->fallback;
+}
+
+static FlashAsset_Slot *FlashAsset_Lookup(FlashAsset *fa, uint32_t key)
+{
+    uint16_t i;
+
+    for (i = 0; i < fa->slot_count; i++) {
+        if (fa->slots[i].key == key) {
+            return &fa->slots[i];
+        }
+    }
+    return NULL;
+}
+
+/* CLOCK victim, never one returned earlier in this batch */
+static FlashAsset_Slot *FlashAsset_Alloc(FlashAsset *fa)
+{
+    FlashAsset_Slot *slot;
+
+    /* More slots than a batch pins: ends within two turns */
+    for (;;) {
+        slot = &fa->slots[fa->hand];
+        fa->hand = (uint16_t)((fa->hand + 1u) % fa->slot_count);
+        if (slot->pin == fa->batch) {
+            continue;
+        }
+        if (slot->key == FLASHASSET_EMPTY || !slot->ref) {
+            break;
+        }
+        slot->ref = 0;
+    }
+    slot->key = FLASHASSET_EMPTY;
+    return slot;
+}
+
+/* ============================================================================
+ * Public Functions
+ * ============================================================================ */
+
+FlashAsset_Status FlashAsset_Init(FlashAsset *fa, MD25Q64_Handle *flash, uint32_t base,
+                                  uint32_t region, FlashAsset_Slot *slots, uint16_t slot_count)
+{
+    FlashAsset_Header *hdr;
+    uint32_t dir_end;
+    uint16_t i;
+
+    if (fa == NULL || flash == NULL || slots == NULL || slot_count <= FLASHASSET_BATCH) {
+        return FLASHASSET_INVALID_PARAM;
+    }
+    hdr = &fa->hdr;
+
+    memset(fa, 0, sizeof(*fa));
+    fa->flash = flash;
+    fa->base = base;
+    fa->slots = slots;
+    fa->slot_count = slot_count;
+    FlashAsset_CacheClear(fa);
+
+    if (MD25Q64_Read(flash, base, (uint8_t *)hdr, sizeof(*hdr)) != MD25Q64_OK) {
+        return FLASHASSET_ERROR;
+    }
+    if (hdr->magic != FLASHASSET_MAGIC || hdr->version != FLASHASSET_VERSION) {
+        return FLASHASSET_NO_IMAGE;
+    }
+    dir_end = FLASHASSET_DIR_END(hdr->count);
+    if (hdr->count > FLASHASSET_MAX_ENTRIES || hdr->size > region || hdr->size < dir_end) {
+        return FLASHASSET_CORRUPT;
+    }
+
+    if (MD25Q64_Read(flash, base + sizeof(*hdr), (uint8_t *)fa->entries,
+                     hdr->count * (uint32_t)sizeof(FlashAsset_Entry)) != MD25Q64_OK) {
+        return FLASHASSET_ERROR;
+    }
+    if (FlashAsset_Crc32(0, fa->entries, hdr->count * (uint32_t)sizeof(FlashAsset_Entry)) != hdr->dir_crc) {
+        return FLASHASSET_CORRUPT;
+    }
+    for (i = 0; i < hdr->count; i++) {
+        const FlashAsset_Entry *e = &fa->entries[i];
+
+        if (e->offset < dir_end || e->offset > hdr->size || e->size > hdr->size - e->offset) {
+            return FLASHASSET_CORRUPT;
+        }
+    }
+
+    fa->ready = 1;
+    return FLASHASSET_OK;
+}
+
+FlashAsset_Status FlashAsset_Verify(FlashAsset *fa)
+{
+    uint32_t addr, end, crc = 0;
+
+    if (fa == NULL || !fa->ready) {
+        return FLASHASSET_NO_IMAGE;
+    }
+
+    end = fa->hdr.size;
+    for (addr = FLASHASSET_DIR_END(fa->hdr.count); addr < end; addr += FLASHASSET_SPAN_MAX) {
+        uint32_t n = (end - addr < FLASHASSET_SPAN_MAX) ? end - addr : FLASHASSET_SPAN_MAX;
+
+        if (FlashAsset_ReadSpan(fa, fa->base + addr, fa->span, n) != FLASHASSET_OK) {
+            return FLASHASSET_ERROR;
+        }
+        crc = FlashAsset_Crc32(crc, fa->span, n);
+    }
+    return (crc == fa->hdr.data_crc) ? FLASHASSET_OK : FLASHASSET_CORRUPT;
+}
+
+const FlashAsset_Entry *FlashAsset_Find(const FlashAsset *fa, const char *name, uint8_t type)
+{
+    uint16_t i;
+
+    if (fa == NULL || name == NULL || !fa->ready) {
+        return NULL;
+    }
+    for (i = 0; i < fa->hdr.count; i++) {
+        if (fa->entries[i].type == type &&
+            strncmp(fa->entries[i].name, name, FLASHASSET_NAME_LEN) == 0) {
+            return &fa->entries[i];
+        }
+    }
+    return NULL;
+}
+
+FlashAsset_Status FlashAsset_FontOpen(FlashAsset *fa, FlashAsset_Font *font, const char *name)
+{
+    const FlashAsset_Entry *e;
+    uint32_t table, total = 0;
+    uint8_t i;
+
+    if (fa == NULL || font == NULL) {
+        return FLASHASSET_INVALID_PARAM;
+    }
+    memset(font, 0, sizeof(*font));
+    e = FlashAsset_Find(fa, name, FLASHASSET_FONT);
+    if (e == NULL) {
+        return fa->ready ? FLASHASSET_NOT_FOUND : FLASHASSET_NO_IMAGE;
+    }
+    if (e->height % 8u != 0 || e->width == 0 || e->height == 0 ||
+        e->width * (uint32_t)e->height / 8u > FLASHASSET_GLYPH_MAX ||
+        e->ranges == 0 || e->ranges > FLASHASSET_MAX_RANGES) {
+        return FLASHASSET_INVALID_PARAM;
+    }
+
+    table = e->ranges * (uint32_t)sizeof(FlashAsset_RangeRec);
+    if (table > e->size ||
+        FlashAsset_ReadSpan(fa, fa->base + e->offset, fa->span, table) != FLASHASSET_OK) {
+        return (table > e->size) ? FLASHASSET_CORRUPT : FLASHASSET_ERROR;
+    }
+
+    font->assets = fa;
+    font->entry = (uint8_t)(e - fa->entries);
+    font->width = e->width;
+    font->height = e->height;
+    font->glyph_size = (uint16_t)(e->width * (uint32_t)e->height / 8u);
+    font->range_count = (uint8_t)e->ranges;
+    for (i = 0; i < e->ranges; i++) {
+        FlashAsset_RangeRec r;
+
+        memcpy(&r, &fa->span[i * sizeof(r)], sizeof(r));
+        /* Sorted, disjoint, and glyph indices fit the cache key */
+        if (r.count == 0 || r.count > 0xFFFFu - total ||
+            (i > 0 && r.first < font->ranges[i - 1u].first + font->ranges[i - 1u].count)) {
+            font->assets = NULL;
+            return FLASHASSET_CORRUPT;
+        }
+        font->ranges[i].first = r.first;
+        font->ranges[i].count = (uint16_t)r.count;
+        font->ranges[i].base = (uint16_t)total;
+        total += r.count;
+    }
+    if (table + total * font->glyph_size > e->size) {
+        font->assets = NULL;
+        return FLASHASSET_CORRUPT;
+    }
+    font->glyph_count = (uint16_t)total;
+    font->fallback = (e->fallback < total) ? e->fallback : 0;
+    font->glyphs = fa->base + e->offset + table;
+    return FLASHASSET_OK;
+}
+
+FlashAsset_Status FlashAsset_Glyphs(FlashAsset_Font *font, const uint32_t *codepoints,
+                                    uint8_t count, const uint8_t **glyphs)
+{
+    FlashAsset *fa;
+    uint16_t index[FLASHASSET_BATCH];
+    uint16_t miss[FLASHASSET_BATCH];
+    FlashAsset_Slot *fetched[FLASHASSET_BATCH];
+    uint8_t misses = 0, split, i, j, k;
+    uint16_t gs;
+
+    if (font == NULL || font->assets == NULL || codepoints == NULL || glyphs == NULL ||
+        count > FLASHASSET_BATCH) {
+        return FLASHASSET_INVALID_PARAM;
+    }
+    fa = font->assets;
+    gs = font->glyph_size;
+
+    /* New pin stamp; on wrap, old stamps must not match it */
+    if (++fa->batch == 0) {
+        for (i = 0; i < fa->slot_count; i++) {
+            fa->slots[i].pin = 0;
+        }
+        fa->batch = 1;
+    }
+
+    for (i = 0; i < count; i++) {
+        FlashAsset_Slot *slot;
+
+        index[i] = FlashAsset_Index(font, codepoints[i]);
+        fa->stats.lookups++;
+        slot = FlashAsset_Lookup(fa, ((uint32_t)font->entry << 16) | index[i]);
+        if (slot != NULL) {
+            slot->ref = 1;
+            slot->pin = fa->batch;
+            glyphs[i] = slot->data;
+            fa->stats.hits++;
+            continue;
+        }
+        glyphs[i] = NULL;
+        for (j = 0; j < misses && miss[j] != index[i]; j++) {
+        }
+        if (j < misses) {
+            fa->stats.hits++;                   /* Repeat: comes with the first */
+            continue;
+        }
+        /* Insertion by glyph index, which is flash address order */
+        for (j = misses; j > 0 && miss[j - 1u] > index[i]; j--) {
+            miss[j] = miss[j - 1u];
+        }
+        miss[j] = index[i];
+        misses++;
+        fa->stats.misses++;
+    }
+
+    /* The whole [first, last] miss span in one read when the buffer holds
+     * it, else runs of nearby glyphs, one read each */
+    split = misses > 0 && (miss[misses - 1u] - miss[0] + 1u) * (uint32_t)gs > FLASHASSET_SPAN_MAX;
+    for (i = 0; i < misses; i = (uint8_t)(j + 1u)) {
+        uint32_t start = font->glyphs + miss[i] * (uint32_t)gs;
+        uint32_t len;
+
+        for (j = i; j + 1u < misses; j++) {
+            uint32_t prev_end = font->glyphs + (miss[j] + 1u) * (uint32_t)gs;
+            uint32_t next = font->glyphs + miss[j + 1u] * (uint32_t)gs;
+
+            if (next + gs - start > FLASHASSET_SPAN_MAX ||
+                (split && next - prev_end > FLASHASSET_GAP)) {
+                break;
+            }
+        }
+        len = font->glyphs + (miss[j] + 1u) * (uint32_t)gs - start;
+        if (FlashAsset_ReadSpan(fa, start, fa->span, len) != FLASHASSET_OK) {
+            return FLASHASSET_ERROR;
+        }
+        fa->stats.reads++;
+        fa->stats.read_bytes += len;
+
+        for (k = i; k <= j; k++) {
+            FlashAsset_Slot *slot = FlashAsset_Alloc(fa);
+
+            memcpy(slot->data, &fa->span[(miss[k] - miss[i]) * (uint32_t)gs], gs);
+            slot->key = ((uint32_t)font->entry << 16) | miss[k];
+            slot->ref = 0;
+            slot->pin = fa->batch;
+            fetched[k] = slot;
+        }
+    }
+
+    for (i = 0; i < count; i++) {
+        if (glyphs[i] == NULL) {
+            for (j = 0; miss[j] != index[i]; j++) {
+            }
+            glyphs[i] = fetched[j]->data;
+        }
+    }
+    return FLASHASSET_OK;
+}
+
+FlashAsset_Status FlashAsset_Read(FlashAsset *fa, const FlashAsset_Entry *entry,
+                                  uint32_t offset, uint8_t *data, uint32_t len)
+{
+    if (fa == NULL || entry == NULL || data == NULL ||
+        offset > entry->size || len > entry->size - offset) {
+        return FLASHASSET_INVALID_PARAM;
+    }
+
+    while (len > 0) {
+        uint32_t n = (len < FLASHASSET_READ_CHUNK) ? len : FLASHASSET_READ_CHUNK;
+
+        if (FlashAsset_ReadSpan(fa, fa->base + entry->offset + offset, data, n) != FLASHASSET_OK) {
+            return FLASHASSET_ERROR;
+        }
+        offset += n;
+        data += n;
+        len -= n;
+    }
+    return FLASHASSET_OK;
+}
+
+void FlashAsset_CacheClear(FlashAsset *fa)
+{
+    uint16_t i;
+
+    if (fa == NULL) {
+        return;
+    }
+    for (i = 0; i < fa->slot_count; i++) {
+        fa->slots[i].key = FLASHASSET_EMPTY;
+        fa->slots[i].ref = 0;
+        fa->slots[i].pin = 0;
+    }
+    fa->hand = 0;
+}
+
+uint32_t FlashAsset_Utf8Next(const char **s)
+{
+    const uint8_t *p = (const uint8_t *)*s;
+    uint32_t c = p[0], min;
+    uint8_t n, k;
+
+    if (c == 0) {
+        return 0;
+    }
+    if (c < 0x80u) {
+        *s += 1;
+        return c;
+    }
+    if ((c & 0xE0u) == 0xC0u) {
+        n = 1; c &= 0x1Fu; min = 0x80u;
+    } else if ((c & 0xF0u) == 0xE0u) {
+        n = 2; c &= 0x0Fu; min = 0x800u;
+    } else if ((c & 0xF8u) == 0xF0u) {
+        n = 3; c &= 0x07u; min = 0x10000u;
+    } else {
+        *s += 1;
+        return 0xFFFDu;
+    }
+
+    /* A NUL fails the continuation test, so this never reads past the end */
+    for (k = 1; k <= n; k++) {
+        if ((p[k] & 0xC0u) != 0x80u) {
+            *s += 1;
+            return 0xFFFDu;
+        }
+        c = (c << 6) | (p[k] & 0x3Fu);
+    }
+    if (c < min || c > 0x10FFFFu || (c >= 0xD800u && c <= 0xDFFFu)) {
+        *s += 1;
+        return 0xFFFDu;
+    }
+    *s += n + 1u;
+    return c;
+}
@@ -0,0 +1,228 @@
+/**
+ * @file    flash_asset.h
+ * @brief   Fonts and bitmaps stored on the MD25Q64, with a RAM glyph cache
+ * @details The display assets live in a packed image on the external flash
+ *          instead of MCU flash, written by the host tool tools/asset_pack.
+ *
+ *          Image layout (little-endian):
+ *            FlashAsset_Header                 32 bytes, at the region start
+ *            FlashAsset_Entry[count]           directory, 24 bytes each
+ *            entry data                        4-byte aligned, in any order
+ *          Font data:   FlashAsset_RangeRec[ranges], then the glyphs. Range
+ *                       r maps codepoints first .. first + count - 1 to the
+ *                       next count glyphs; codepoints not covered draw the
+ *                       fallback glyph.
+ *          Bitmap data: the pixels.
+ *          Glyphs and bitmaps are in OLED page order: for each 8-row page,
+ *          one byte per column, bit 0 the top row. A width x height glyph
+ *          is width * height / 8 bytes and goes to OLED_ShowPic() as is.
+ *
+ *          FlashAsset_Init() checks the header and the directory CRC only;
+ *          the data CRC (the whole image) is FlashAsset_Verify().
+ *
+ *          Glyph cache: FLASHASSET_GLYPH_MAX byte slots shared by all fonts,
+ *          CLOCK eviction as in md25q64_cache. FlashAsset_Glyphs() looks a
+ *          string's glyphs up together and reads the missing ones in as few
+ *          transactions as possible: when everything from the lowest to the
+ *          highest missing glyph fits the FLASHASSET_SPAN_MAX byte buffer it
+ *          is one fast read, otherwise the misses, sorted by address, are
+ *          read in runs whose gaps are at most FLASHASSET_GAP bytes. In an
+ *          8 x 16 font a 16 character clock or number line is one read
+ *          instead of 16, a mixed ASCII line a handful, and nothing once
+ *          its glyphs are cached; a redrawn status screen runs almost
+ *          entirely from RAM.
+ *          The reads are queued asynchronous
+ *          reads, so they bypass the handle's page cache and wait behind
+ *          (or suspend) the sample log's erases like any other read.
+ */
+
+#ifndef __FLASH_ASSET_H__
+#define __FLASH_ASSET_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "md25q64.h"
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+#define FLASHASSET_MAGIC        0x54455341u     /* "ASET" */
+#define FLASHASSET_VERSION      1
+#define FLASHASSET_NAME_LEN     8
+#define FLASHASSET_MAX_ENTRIES  16              /* Directory entries kept in RAM */
+#define FLASHASSET_MAX_RANGES   32              /* Codepoint ranges per open font */
+#define FLASHASSET_GLYPH_MAX    32              /* Largest cached glyph: 16 x 16 */
+#define FLASHASSET_BATCH        16              /* Glyphs per FlashAsset_Glyphs() */
+#define FLASHASSET_SPAN_MAX     512             /* Longest single glyph read, a batch of 16 x 16 */
+#define FLASHASSET_GAP          64              /* Unused bytes read rather than split (longer spans) */
+#define FLASHASSET_EMPTY        0xFFFFFFFFu     /* Slot holds nothing */
+
+/* ============================================================================
+ * Status Codes
+ * ============================================================================ */
+typedef enum {
+    FLASHASSET_OK = 0,
+    FLASHASSET_ERROR,               /* Flash access failed */
+    FLASHASSET_INVALID_PARAM,
+    FLASHASSET_NO_IMAGE,            /* Blank region or other magic/version */
+    FLASHASSET_CORRUPT,             /* CRC mismatch or entry out of bounds */
+    FLASHASSET_NOT_FOUND            /* No entry of that name and type */
+} FlashAsset_Status;
+
+typedef enum {
+    FLASHASSET_FONT = 1,
+    FLASHASSET_BITMAP = 2
+} FlashAsset_Type;
+
+/* ============================================================================
+ * On-Flash Structures
+ * ============================================================================ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;                 /* Directory entries */
+    uint32_t size;                  /* Image bytes, header included */
+    uint32_t dir_crc;               /* CRC32 of the directory */
+    uint32_t data_crc;              /* CRC32 of everything after the directory */
+    uint32_t reserved[3];
+} FlashAsset_Header;
+
+typedef struct {
+    char name[FLASHASSET_NAME_LEN]; /* NUL padded */
+    uint8_t type;                   /* FlashAsset_Type */
+    uint8_t width;                  /* Glyph cell or bitmap, pixels */
+    uint8_t height;                 /* Multiple of 8 */
+    uint8_t reserved;
+    uint32_t offset;                /* From the image start */
+    uint32_t size;
+    uint16_t ranges;                /* Font: range records */
+    uint16_t fallback;              /* Font: glyph drawn for unmapped codepoints */
+} FlashAsset_Entry;
+
+typedef struct {
+    uint32_t first;                 /* First codepoint */
+    uint32_t count;
+} FlashAsset_RangeRec;
+
+/* ============================================================================
+ * Image, Font and Cache State
+ * ============================================================================ */
+typedef struct {
+    uint32_t key;                   /* Entry << 16 | glyph, or FLASHASSET_EMPTY */
+    uint8_t ref;                    /* CLOCK reference bit */
+    uint8_t pin;                    /* Batch that returned it */
+    uint8_t data[FLASHASSET_GLYPH_MAX];
+} FlashAsset_Slot;
+
+typedef struct {
+    uint32_t lookups;               /* Glyphs asked for */
+    uint32_t hits;                  /* ...served from RAM */
+    uint32_t misses;
+    uint32_t reads;                 /* Flash transactions for glyphs */
+    uint32_t read_bytes;            /* Bytes those transactions moved */
+} FlashAsset_Stats;
+
+typedef struct {
+    MD25Q64_Handle *flash;
+    uint32_t base;                  /* Region start */
+    FlashAsset_Header hdr;
+    FlashAsset_Entry entries[FLASHASSET_MAX_ENTRIES];
+    uint8_t ready;
+    FlashAsset_Slot *slots;
+    uint16_t slot_count;
+    uint16_t hand;
+    uint8_t batch;                  /* Pin stamp of the current batch */
+    volatile uint8_t read_done;
+    MD25Q64_Status read_status;
+    FlashAsset_Stats stats;
+    uint8_t span[FLASHASSET_SPAN_MAX];
+} FlashAsset;
+
+typedef struct {
+    uint32_t first;
+    uint16_t count;
+    uint16_t base;                  /* Glyph index of first */
+} FlashAsset_Range;
+
+typedef struct {
+    FlashAsset *assets;
+    uint8_t entry;                  /* Directory index */
+    uint8_t width;
+    uint8_t height;
+    uint8_t range_count;
+    uint16_t glyph_size;            /* Bytes */
+    uint16_t fallback;
+    uint16_t glyph_count;
+    uint32_t glyphs;                /* Flash address of glyph 0 */
+    FlashAsset_Range ranges[FLASHASSET_MAX_RANGES];
+} FlashAsset_Font;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief  Read the image header and directory at base
+ * @param  region: Bytes reserved for the image
+ * @param  slots: Glyph cache, more than FLASHASSET_BATCH slots
+ * @retval FLASHASSET_NO_IMAGE / CORRUPT leave the cache usable for a later
+ *         FlashAsset_Init() once an image is written
+ */
+FlashAsset_Status FlashAsset_Init(FlashAsset *fa, MD25Q64_Handle *flash, uint32_t base,
+                                  uint32_t region, FlashAsset_Slot *slots, uint16_t slot_count);
+
+/**
+ * @brief  Check the data CRC over the whole image (reads all of it)
+ */
+FlashAsset_Status FlashAsset_Verify(FlashAsset *fa);
+
+/**
+ * @brief  Directory entry by name and type, or NULL
+ */
+const FlashAsset_Entry *FlashAsset_Find(const FlashAsset *fa, const char *name, uint8_t type);
+
+/**
+ * @brief  Open a font: its range table is kept in *font
+ * @retval FLASHASSET_INVALID_PARAM if its glyphs do not fit a cache slot or
+ *         it has more than FLASHASSET_MAX_RANGES ranges
+ */
+FlashAsset_Status FlashAsset_FontOpen(FlashAsset *fa, FlashAsset_Font *font, const char *name);
+
+/**
+ * @brief  Glyphs for up to FLASHASSET_BATCH codepoints
+ * @param  glyphs: Filled with font->glyph_size byte bitmaps in the cache,
+ *                 valid until the next FlashAsset_Glyphs() call
+ * @note   Blocking: polls the flash until the reads are done
+ */
+FlashAsset_Status FlashAsset_Glyphs(FlashAsset_Font *font, const uint32_t *codepoints,
+                                    uint8_t count, const uint8_t **glyphs);
+
+/**
+ * @brief  Read part of an entry's data (bitmaps), uncached
+ */
+FlashAsset_Status FlashAsset_Read(FlashAsset *fa, const FlashAsset_Entry *entry,
+                                  uint32_t offset, uint8_t *data, uint32_t len);
+
+/**
+ * @brief  Drop every cached glyph (after rewriting the image)
+ */
+void FlashAsset_CacheClear(FlashAsset *fa);
+
+/**
+ * @brief  Next codepoint of a UTF-8 string, advancing *s; 0 at the end
+ * @note   Malformed sequences give U+FFFD and skip one byte
+ */
+uint32_t FlashAsset_Utf8Next(const char **s);
+
+/**
+ * @brief  CRC32 (IEEE 802.3, reflected), chainable: pass 0 to start
+ */
+uint32_t FlashAsset_Crc32(uint32_t crc, const void *data, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FLASH_ASSET_H__ */
@@ -0,0 +1,753 @@
+/**
+ * @file    flash_log.c
+ * @brief   Append-only record log implementation
+ */
+
+#include "flash_log.h"
+#include <stddef.h>
+#include <string.h>
+
+#define FLASHLOG_REC_HDR_SIZE   ((uint32_t)sizeof(FlashLog_RecHdr))
+#define FLASHLOG_ALIGN(n)       (((uint32_t)(n) + 3u) & ~3u)
+#define FLASHLOG_BLANK_CHUNK    64
+
+/* Record staging / verification buffer (the log is used from one context) */
+static uint8_t flashlog_buf[sizeof(FlashLog_RecHdr) + FLASHLOG_MAX_RECORD];
+
+/* ============================================================================
+ * CRC32
+ * ============================================================================ */
+
+/* Nibble table for the reflected polynomial 0xEDB88320 */
+static const uint32_t flashlog_crc_tab[16] = {
+    0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+    0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+    0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+    0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu
+};
+
+uint32_t FlashLog_Crc32(uint32_t crc, const void *data, uint32_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ flashlog_crc_tab[crc & 0x0Fu];
+        crc = (crc >> 4) ^ flashlog_crc_tab[crc & 0x0Fu];
+    }
+    return ~crc;
+}
+
+/* ============================================================================
+ * Private Helpers
+ * ============================================================================ */
+
+static uint32_t FlashLog_SectorAddr(const FlashLog *log, uint16_t sector)
+{
+    return log->base + (uint32_t)sector * MD25Q64_SECTOR_SIZE;
+}
+
+static uint16_t FlashLog_NextSector(const FlashLog *log, uint16_t sector)
+{
+    return (uint16_t)((sector + 1u) % log->sector_count);
+}
+
+/* Reads see records still held in the write buffer */
+static MD25Q64_Status FlashLog_Read(const FlashLog *log, uint32_t address,
+                                    void *data, uint32_t size)
+{
+    if (log->wbuf != NULL) {
+        return MD25Q64_WBuf_Read(log->wbuf, address, (uint8_t *)data, size);
+    }
+    return MD25Q64_Read(log->flash, address, (uint8_t *)data, size);
+}
+
+/**
+ * @brief  Read a sector header
+ * @retval 1 if the header is valid, 0 if not, -1 on flash error
+ */
+static int FlashLog_ReadHeader(const FlashLog *log, uint16_t sector, FlashLog_SectorHdr *hdr)
+{
+    if (FlashLog_Read(log, FlashLog_SectorAddr(log, sector), hdr, sizeof(*hdr)) != MD25Q64_OK) {
+        return -1;
+    }
+    if (hdr->magic != FLASHLOG_MAGIC) {
+        return 0;
+    }
+    return (hdr->crc == FlashLog_Crc32(0, hdr, 8)) ? 1 : 0;
+}
+
+static FlashLog_Status FlashLog_WriteHeader(FlashLog *log, uint16_t sector, uint32_t seq)
+{
+    FlashLog_SectorHdr hdr;
+
+    hdr.magic = FLASHLOG_MAGIC;
+    hdr.seq = seq;
+    hdr.crc = FlashLog_Crc32(0, &hdr, 8);
+
+    /* Reserved words stay erased */
+    if (MD25Q64_Write(log->flash, FlashLog_SectorAddr(log, sector),
+                      (const uint8_t *)&hdr, 12) != MD25Q64_OK) {
+        return FLASHLOG_ERROR;
+    }
+    return FLASHLOG_OK;
+}
+
+/* ============================================================================
+ * Time Index
+ * ============================================================================ */
+
+/* A stamp counts only next to its complement: erased or torn reads as none */
+static uint32_t FlashLog_HdrStamp(uint32_t value, uint32_t inv)
+{
+    return (value == ~inv) ? value : FLASHLOG_NO_STAMP;
+}
+
+static MD25Q64_Status FlashLog_WriteStamp(FlashLog *log, uint16_t sector,
+                                          uint32_t offset, uint32_t stamp)
+{
+    uint32_t words[2];
+
+    words[0] = stamp;
+    words[1] = ~stamp;
+    return MD25Q64_Write(log->flash, FlashLog_SectorAddr(log, sector) + offset,
+                         (const uint8_t *)words, sizeof(words));
+}
+
+/* Record appended to the head: its stamp opens or extends the head's span */
+static void FlashLog_SpanAdd(FlashLog *log, const void *data, uint16_t len)
+{
+    FlashLog_Span *span = &log->spans[log->head];
+    uint32_t stamp = log->stamp(data, len);
+
+    if (stamp == FLASHLOG_NO_STAMP) {
+        return;
+    }
+    if (span->first == FLASHLOG_NO_STAMP) {
+        /* A failed write only leaves the header without a first stamp */
+        FlashLog_WriteStamp(log, log->head, offsetof(FlashLog_SectorHdr, first), stamp);
+        span->first = stamp;
+    }
+    if (span->last == FLASHLOG_NO_STAMP || stamp > span->last) {
+        span->last = stamp;
+    }
+}
+
+/* Head about to be left: record its last stamp, unless an earlier boot did */
+static void FlashLog_SpanClose(FlashLog *log)
+{
+    FlashLog_SectorHdr hdr;
+
+    if (log->spans[log->head].last == FLASHLOG_NO_STAMP ||
+        FlashLog_ReadHeader(log, log->head, &hdr) != 1 ||
+        hdr.last != 0xFFFFFFFFu || hdr.last_inv != 0xFFFFFFFFu) {
+        return;
+    }
+    FlashLog_WriteStamp(log, log->head, offsetof(FlashLog_SectorHdr, last),
+                        log->spans[log->head].last);
+}
+
+/**
+ * @brief  Index key of the sector k places after the tail
+ * @note   A sector without a first stamp (never stamped, or the stamp
+ *         write was cut) takes the key of the nearest stamped sector before
+ *         it, which keeps the keys sorted; with none it sorts as oldest.
+ */
+static uint32_t FlashLog_SpanKey(const FlashLog *log, uint16_t k)
+{
+    for (;;) {
+        uint32_t first = log->spans[(log->tail + k) % log->sector_count].first;
+
+        if (first != FLASHLOG_NO_STAMP) {
+            return first;
+        }
+        if (k == 0) {
+            return 0;
+        }
+        k--;
+    }
+}
+
+/**
+ * @brief  First sector past the erased run after the head, dropping it
+ *         from the tail if the ring is full (its records are about to be
+ *         erased)
+ */
+static uint16_t FlashLog_ClaimNext(FlashLog *log)
+{
+    uint16_t next = (uint16_t)((log->head + log->erased_ahead + 1u) % log->sector_count);
+
+    if (next == log->tail && next != log->head) {
+        log->tail = FlashLog_NextSector(log, log->tail);
+    }
+    if (log->spans != NULL) {
+        log->spans[next].first = FLASHLOG_NO_STAMP;
+        log->spans[next].last = FLASHLOG_NO_STAMP;
+    }
+    return next;
+}
+
+static void FlashLog_EraseDone(MD25Q64_Handle *flash, MD25Q64_Status status, void *ctx)
+{
+    FlashLog *log = (FlashLog *)ctx;
+
+    (void)flash;
+    log->erasing = 0;
+    if (status == MD25Q64_OK) {
+        log->erased_ahead++;
+        /* Chain the next erase until the target depth is reached */
+        FlashLog_Maintain(log);
+    }
+}
+
+static FlashLog_Status FlashLog_OpenNext(FlashLog *log)
+{
+    uint16_t next;
+
+    /* Records of the old head reach flash before the new header does */
+    if (log->wbuf != NULL && MD25Q64_WBuf_Flush(log->wbuf) != MD25Q64_OK) {
+        return FLASHLOG_ERROR;
+    }
+
+    if (log->spans != NULL) {
+        FlashLog_SpanClose(log);
+    }
+
+    if (log->erased_ahead == 0) {
+        log->slow_appends++;
+        if (log->erasing) {
+            /* Erase-ahead still running: wait for it */
+            MD25Q64_Flush(log->flash);
+        }
+    }
+    if (log->erased_ahead > 0) {
+        next = FlashLog_NextSector(log, log->head);
+    } else {
+        next = FlashLog_ClaimNext(log);
+        if (MD25Q64_EraseSector(log->flash, FlashLog_SectorAddr(log, next)) != MD25Q64_OK) {
+            return FLASHLOG_ERROR;
+        }
+        log->erased_ahead = 1;
+    }
+    if (FlashLog_WriteHeader(log, next, log->head_seq + 1u) != FLASHLOG_OK) {
+        return FLASHLOG_ERROR;
+    }
+
+    log->head = next;
+    log->head_seq++;
+    log->head_offset = FLASHLOG_HDR_SIZE;
+    log->erased_ahead--;
+    return FLASHLOG_OK;
+}
+
+/*
+ * Record CRC covers len/len_inv as well as the payload. A payload-only
+ * CRC would accept a torn record whose CRC and 4-byte payload are still
+ * erased: CRC32 of FF FF FF FF is FFFFFFFF.
+ */
+static uint32_t FlashLog_RecCrc(const FlashLog_RecHdr *rec, const void *payload)
+{
+    return FlashLog_Crc32(FlashLog_Crc32(0, rec, 4), payload, rec->len);
+}
+
+/**
+ * @brief  Check a record header read from flash
+ * @retval 1 valid, 0 blank (end of records), -1 corrupt
+ */
+static int FlashLog_CheckRecHdr(const FlashLog_RecHdr *rec, uint32_t offset, uint32_t limit)
+{
+    if (rec->len == 0xFFFFu && rec->len_inv == 0xFFFFu) {
+        return 0;
+    }
+    if ((uint16_t)(rec->len ^ rec->len_inv) != 0xFFFFu ||
+        rec->len == 0 || rec->len > FLASHLOG_MAX_RECORD ||
+        offset + FLASHLOG_REC_HDR_SIZE + rec->len > limit) {
+        return -1;
+    }
+    return 1;
+}
+
+/**
+ * @brief  Find the append offset in the head sector
+ * @note   Anything but a clean run of valid records followed by erased
+ *         bytes seals the sector (offset = sector size).
+ */
+static FlashLog_Status FlashLog_ScanHead(FlashLog *log)
+{
+    uint32_t base = FlashLog_SectorAddr(log, log->head);
+    uint32_t offset = FLASHLOG_HDR_SIZE;
+    FlashLog_RecHdr rec;
+    int sealed = 0;
+
+    while (offset + FLASHLOG_REC_HDR_SIZE <= MD25Q64_SECTOR_SIZE) {
+        if (FlashLog_Read(log, base + offset, &rec, sizeof(rec)) != MD25Q64_OK) {
+            return FLASHLOG_ERROR;
+        }
+        int check = FlashLog_CheckRecHdr(&rec, offset, MD25Q64_SECTOR_SIZE);
+        if (check == 0) {
+            break;
+        }
+        if (check < 0) {
+            sealed = 1;
+            break;
+        }
+        if (FlashLog_Read(log, base + offset + FLASHLOG_REC_HDR_SIZE,
+                          flashlog_buf, rec.len) != MD25Q64_OK) {
+            return FLASHLOG_ERROR;
+        }
+        if (FlashLog_RecCrc(&rec, flashlog_buf) != rec.crc) {
+            sealed = 1;
+            break;
+        }
+        offset += FLASHLOG_REC_HDR_SIZE + FLASHLOG_ALIGN(rec.len);
+    }
+
+    /* The free area must be fully erased to be programmed again */
+    for (uint32_t pos = offset; !sealed && pos < MD25Q64_SECTOR_SIZE; pos += FLASHLOG_BLANK_CHUNK) {
+        uint32_t n = MD25Q64_SECTOR_SIZE - pos;
+        if (n > FLASHLOG_BLANK_CHUNK) {
+            n = FLASHLOG_BLANK_CHUNK;
+        }
+        if (FlashLog_Read(log, base + pos, flashlog_buf, n) != MD25Q64_OK) {
+            return FLASHLOG_ERROR;
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            if (flashlog_buf[i] != 0xFF) {
+                sealed = 1;
+                break;
+            }
+        }
+    }
+
+    log->head_offset = sealed ? MD25Q64_SECTOR_SIZE : offset;
+    return FLASHLOG_OK;
+}
+
+/* ============================================================================
+ * Public Functions
+ * ============================================================================ */
+
+FlashLog_Status FlashLog_Mount(FlashLog *log, MD25Q64_Handle *flash,
+                               uint32_t base, uint16_t sector_count)
+{
+    FlashLog_SectorHdr hdr;
+    uint32_t max_seq = 0;
+    uint32_t min_seq = 0xFFFFFFFFu;
+    uint8_t found = 0;
+
+    if (log == NULL || flash == NULL || sector_count < 2 ||
+        (base % MD25Q64_SECTOR_SIZE) != 0 ||
+        base + (uint32_t)sector_count * MD25Q64_SECTOR_SIZE > MD25Q64_FLASH_SIZE) {
+        return FLASHLOG_INVALID_PARAM;
+    }
+
+    /* An erase-ahead from an earlier mount must not complete into the new state */
+    MD25Q64_Flush(flash);
+
+    memset(log, 0, sizeof(*log));
+    log->flash = flash;
+    log->base = base;
+    log->sector_count = sector_count;
+    log->erase_ahead = (FLASHLOG_ERASE_AHEAD < sector_count) ? FLASHLOG_ERASE_AHEAD
+                                                             : (uint16_t)(sector_count - 1u);
+
+    /* Headers only: O(sectors) */
+    for (uint16_t i = 0; i < sector_count; i++) {
+        int valid = FlashLog_ReadHeader(log, i, &hdr);
+        if (valid < 0) {
+            return FLASHLOG_ERROR;
+        }
+        if (valid == 0) {
+            continue;
+        }
+        if (!found || hdr.seq > max_seq) {
+            max_seq = hdr.seq;
+            log->head = i;
+        }
+        if (!found || hdr.seq < min_seq) {
+            min_seq = hdr.seq;
+            log->tail = i;
+        }
+        found = 1;
+    }
+
+    if (!found) {
+        /* Fresh range: start at the first sector with sequence 1 */
+        if (MD25Q64_EraseSector(flash, base) != MD25Q64_OK ||
+            FlashLog_WriteHeader(log, 0, 1) != FLASHLOG_OK) {
+            return FLASHLOG_ERROR;
+        }
+        log->head = 0;
+        log->tail = 0;
+        log->head_seq = 1;
+        log->head_offset = FLASHLOG_HDR_SIZE;
+        log->mounted = 1;
+        return FLASHLOG_OK;
+    }
+
+    log->head_seq = max_seq;
+    if (FlashLog_ScanHead(log) != FLASHLOG_OK) {
+        return FLASHLOG_ERROR;
+    }
+    log->mounted = 1;
+    return FLASHLOG_OK;
+}
+
+FlashLog_Status FlashLog_Append(FlashLog *log, const void *data, uint16_t len)
+{
+    FlashLog_RecHdr rec;
+    MD25Q64_Status status;
+    uint32_t addr;
+    uint32_t need;
+
+    if (log == NULL || data == NULL || len == 0 || len > FLASHLOG_MAX_RECORD) {
+        return FLASHLOG_INVALID_PARAM;
+    }
+    if (!log->mounted) {
+        return FLASHLOG_NOT_MOUNTED;
+    }
+
+    need = FLASHLOG_REC_HDR_SIZE + FLASHLOG_ALIGN(len);
+    if (log->head_offset + need > MD25Q64_SECTOR_SIZE) {
+        if (FlashLog_OpenNext(log) != FLASHLOG_OK) {
+            return FLASHLOG_ERROR;
+        }
+    }
+
+    rec.len = len;
+    rec.len_inv = (uint16_t)~len;
+    rec.crc = FlashLog_RecCrc(&rec, data);
+    memcpy(flashlog_buf, &rec, sizeof(rec));
+    memcpy(&flashlog_buf[sizeof(rec)], data, len);
+
+    /* Header and payload in one write; alignment padding stays erased */
+    addr = FlashLog_SectorAddr(log, log->head) + log->head_offset;
+    status = (log->wbuf != NULL) ?
+             MD25Q64_WBuf_Write(log->wbuf, addr, flashlog_buf, sizeof(rec) + len) :
+             MD25Q64_Write(log->flash, addr, flashlog_buf, sizeof(rec) + len);
+    if (status != MD25Q64_OK) {
+        /* Whatever got programmed there is not reusable */
+        log->head_offset = MD25Q64_SECTOR_SIZE;
+        return FLASHLOG_ERROR;
+    }
+
+    log->head_offset += need;
+    log->appended++;
+    if (log->spans != NULL) {
+        FlashLog_SpanAdd(log, data, len);
+    }
+    return FLASHLOG_OK;
+}
+
+FlashLog_Status FlashLog_Maintain(FlashLog *log)
+{
+    if (log == NULL) {
+        return FLASHLOG_INVALID_PARAM;
+    }
+    if (!log->mounted) {
+        return FLASHLOG_NOT_MOUNTED;
+    }
+    if (log->erased_ahead >= log->erase_ahead || log->erasing) {
+        return FLASHLOG_OK;
+    }
+
+    /* Completes in FlashLog_EraseDone() from MD25Q64_Poll() */
+    log->erasing = 1;
+    if (MD25Q64_EraseSector_Start(log->flash,
+                                  FlashLog_SectorAddr(log, FlashLog_ClaimNext(log)),
+                                  FlashLog_EraseDone, log) != MD25Q64_OK) {
+        log->erasing = 0;
+        return FLASHLOG_ERROR;
+    }
+    return FLASHLOG_OK;
+}
+
+FlashLog_Status FlashLog_SetEraseAhead(FlashLog *log, uint16_t depth)
+{
+    if (log == NULL) {
+        return FLASHLOG_INVALID_PARAM;
+    }
+    if (!log->mounted) {
+        return FLASHLOG_NOT_MOUNTED;
+    }
+    if (depth >= log->sector_count) {
+        return FLASHLOG_INVALID_PARAM;
+    }
+    log->erase_ahead = depth;
+    return FLASHLOG_OK;
+}
+
+FlashLog_Status FlashLog_SetWriteBuffer(FlashLog *log, MD25Q64_WBuf *wb)
+{
+    if (log == NULL || (wb != NULL && wb->flash != log->flash)) {
+        return FLASHLOG_INVALID_PARAM;
+    }
+    if (!log->mounted) {
+        return FLASHLOG_NOT_MOUNTED;
+    }
+    log->wbuf = wb;
+    return FLASHLOG_OK;
+}
+
+FlashLog_Status FlashLog_SetIndex(FlashLog *log, FlashLog_StampFn stamp, FlashLog_Span *spans)
+{
+    FlashLog_SectorHdr hdr;
+    uint16_t used, k;
+
+    if (log == NULL || (stamp != NULL && spans == NULL)) {
+        return FLASHLOG_INVALID_PARAM;
+    }
+    if (!log->mounted) {
+        return FLASHLOG_NOT_MOUNTED;
+    }
+    log->stamp = NULL;
+    log->spans = NULL;
+    if (stamp == NULL) {
+        return FLASHLOG_OK;
+    }
+
+    for (k = 0; k < log->sector_count; k++) {
+        spans[k].first = FLASHLOG_NO_STAMP;
+        spans[k].last = FLASHLOG_NO_STAMP;
+    }
+    /* Headers of the sectors in use only: O(sectors), like the mount */
+    used = FlashLog_UsedSectors(log);
+    for (k = 0; k < used; k++) {
+        uint16_t sector = (uint16_t)((log->tail + k) % log->sector_count);
+        int valid = FlashLog_ReadHeader(log, sector, &hdr);
+
+        if (valid < 0) {
+            return FLASHLOG_ERROR;
+        }
+        if (valid > 0) {
+            spans[sector].first = FlashLog_HdrStamp(hdr.first, hdr.first_inv);
+            spans[sector].last = FlashLog_HdrStamp(hdr.last, hdr.last_inv);
+        }
+    }
+
+    /* A head holding records but no first stamp (cut before or during its
+     * write) cannot take one now: it would be newer than those records, and
+     * a torn stamp cannot be programmed again. Seal it like a torn record.
+     * (The loop read the head's header last.) */
+    if (spans[log->head].first == FLASHLOG_NO_STAMP &&
+        (log->head_offset > FLASHLOG_HDR_SIZE ||
+         hdr.first != 0xFFFFFFFFu || hdr.first_inv != 0xFFFFFFFFu)) {
+        log->head_offset = MD25Q64_SECTOR_SIZE;
+    }
+
+    log->stamp = stamp;
+    log->spans = spans;
+    return FLASHLOG_OK;
+}
+
+uint16_t FlashLog_UsedSectors(const FlashLog *log)
+{
+    uint32_t n = log->sector_count;
+
+    return (uint16_t)(((uint32_t)log->head + n - log->tail) % n + 1u);
+}
+
+/* ============================================================================
+ * Iterator
+ * ============================================================================ */
+
+/* Sectors are opened in ring order with consecutive seqs: the one at
+ * distance d behind the head holds head_seq - d while it is in use */
+static uint8_t FlashLog_IterCurrent(const FlashLog_Iter *it)
+{
+    const FlashLog *log = it->log;
+    uint16_t dist = (uint16_t)((log->head + log->sector_count - it->sector) % log->sector_count);
+
+    return dist < FlashLog_UsedSectors(log) && log->head_seq - dist == it->seq;
+}
+
+static uint8_t FlashLog_IterAdvance(FlashLog_Iter *it)
+{
+    if (it->sector == it->log->head) {
+        it->done = 1;
+        return 0;
+    }
+    it->sector = FlashLog_NextSector(it->log, it->sector);
+    it->checked = 0;
+    return 1;
+}
+
+void FlashLog_IterInit(const FlashLog *log, FlashLog_Iter *it)
+{
+    it->log = log;
+    it->sector = log->tail;
+    it->offset = FLASHLOG_HDR_SIZE;
+    it->seq = 0;
+    it->checked = 0;
+    it->done = log->mounted ? 0 : 1;
+}
+
+/**
+ * @brief  Query filter for a sector about to be read
+ * @retval 1 read it, 0 its span lies before the range, -1 after it
+ */
+static int FlashLog_SpanCheck(const FlashLog_Query *q, uint16_t sector)
+{
+    const FlashLog *log = q->it.log;
+    const FlashLog_Span *span = &log->spans[sector];
+
+    if (span->first != FLASHLOG_NO_STAMP && span->first > q->to) {
+        return -1;
+    }
+    /* The head's span still grows */
+    if (span->last != FLASHLOG_NO_STAMP && span->last < q->from && sector != log->head) {
+        return 0;
+    }
+    return 1;
+}
+
+/* IterNext, with sectors filtered by the query's span check when q is set */
+static FlashLog_Status FlashLog_IterRead(FlashLog_Iter *it, FlashLog_Query *q,
+                                         void *buf, uint16_t max_len, uint16_t *len)
+{
+    const FlashLog *log = it->log;
+    FlashLog_SectorHdr hdr;
+    FlashLog_RecHdr rec;
+
+    while (!it->done) {
+        if (it->checked && !FlashLog_IterCurrent(it)) {
+            /* The ring recycled this sector under us: go on from the oldest */
+            it->sector = log->tail;
+            it->checked = 0;
+        }
+        if (!it->checked) {
+            if (q != NULL) {
+                int check = FlashLog_SpanCheck(q, it->sector);
+                if (check < 0) {
+                    it->done = 1;
+                    break;
+                }
+                if (check == 0) {
+                    FlashLog_IterAdvance(it);
+                    continue;
+                }
+            }
+            int valid = FlashLog_ReadHeader(log, it->sector, &hdr);
+            if (valid < 0) {
+                return FLASHLOG_ERROR;
+            }
+            /* Skip blank sectors and anything out of sequence */
+            if (valid == 0 || hdr.seq <= it->seq) {
+                FlashLog_IterAdvance(it);
+                continue;
+            }
+            it->seq = hdr.seq;
+            it->offset = FLASHLOG_HDR_SIZE;
+            it->checked = 1;
+            if (q != NULL) {
+                q->sectors++;
+            }
+        }
+
+        uint32_t limit = (it->sector == log->head) ? log->head_offset : MD25Q64_SECTOR_SIZE;
+        uint32_t addr = FlashLog_SectorAddr(log, it->sector) + it->offset;
+
+        if (it->offset + FLASHLOG_REC_HDR_SIZE > limit) {
+            FlashLog_IterAdvance(it);
+            continue;
+        }
+        if (FlashLog_Read(log, addr, &rec, sizeof(rec)) != MD25Q64_OK) {
+            return FLASHLOG_ERROR;
+        }
+        if (FlashLog_CheckRecHdr(&rec, it->offset, limit) != 1) {
+            FlashLog_IterAdvance(it);
+            continue;
+        }
+        if (FlashLog_Read(log, addr + FLASHLOG_REC_HDR_SIZE, flashlog_buf, rec.len) != MD25Q64_OK) {
+            return FLASHLOG_ERROR;
+        }
+        if (FlashLog_RecCrc(&rec, flashlog_buf) != rec.crc) {
+            /* Torn record: nothing valid follows it in this sector */
+            FlashLog_IterAdvance(it);
+            continue;
+        }
+
+        memcpy(buf, flashlog_buf, (rec.len < max_len) ? rec.len : max_len);
+        *len = rec.len;
+        it->offset += FLASHLOG_REC_HDR_SIZE + FLASHLOG_ALIGN(rec.len);
+        return FLASHLOG_OK;
+    }
+
+    return FLASHLOG_END;
+}
+
+FlashLog_Status FlashLog_IterNext(FlashLog_Iter *it, void *buf, uint16_t max_len, uint16_t *len)
+{
+    return FlashLog_IterRead(it, NULL, buf, max_len, len);
+}
+
+/* ============================================================================
+ * Range Query
+ * ============================================================================ */
+
+FlashLog_Status FlashLog_QueryInit(const FlashLog *log, FlashLog_Query *q,
+                                   uint32_t from, uint32_t to)
+{
+    uint16_t used, lo, hi;
+
+    if (log == NULL || q == NULL || from > to) {
+        return FLASHLOG_INVALID_PARAM;
+    }
+    if (!log->mounted) {
+        return FLASHLOG_NOT_MOUNTED;
+    }
+    if (log->spans == NULL) {
+        return FLASHLOG_INVALID_PARAM;
+    }
+
+    FlashLog_IterInit(log, &q->it);
+    q->from = from;
+    q->to = to;
+    q->sectors = 0;
+
+    /* Last sector whose first stamp is < from: earlier ones end at or before
+     * it, and equal stamps may straddle a sector boundary */
+    used = FlashLog_UsedSectors(log);
+    lo = 0;
+    hi = used;
+    while (lo < hi) {
+        uint16_t mid = (uint16_t)((lo + hi) / 2u);
+        if (FlashLog_SpanKey(log, mid) < from) {
+            lo = (uint16_t)(mid + 1u);
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo > 0) {
+        lo--;
+    }
+    /* A borrowed key: start at the sector that owns it, the sectors between
+     * may hold records anywhere from that stamp up */
+    while (lo > 0 && log->spans[(log->tail + lo) % log->sector_count].first == FLASHLOG_NO_STAMP) {
+        lo--;
+    }
+    q->it.sector = (uint16_t)((log->tail + lo) % log->sector_count);
+    q->it.seq = log->head_seq - (used - 1u - lo) - 1u;
+    return FLASHLOG_OK;
+}
+
+FlashLog_Status FlashLog_QueryNext(FlashLog_Query *q, void *buf, uint16_t max_len, uint16_t *len)
+{
+    const FlashLog *log = q->it.log;
+    FlashLog_Status status;
+    uint32_t stamp;
+
+    while ((status = FlashLog_IterRead(&q->it, q, buf, max_len, len)) == FLASHLOG_OK) {
+        /* The whole payload is still in the staging buffer */
+        stamp = log->stamp(flashlog_buf, *len);
+        if (stamp > q->to && stamp != FLASHLOG_NO_STAMP) {
+            q->it.done = 1;
+            return FLASHLOG_END;
+        }
+        if (stamp >= q->from && stamp != FLASHLOG_NO_STAMP) {
+            return FLASHLOG_OK;
+        }
+    }
+    return status;
+}
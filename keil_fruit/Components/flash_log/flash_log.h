@@ -0,0 +1,252 @@
+/**
+ * @file    flash_log.h
+ * @brief   Append-only record log on MD25Q64 NOR Flash
+ * @details The log owns a run of 4KB sectors and fills them in ring order.
+ *
+ *          Sector layout:
+ *            [0..31]   FlashLog_SectorHdr (magic, sequence number, CRC,
+ *                      first/last record stamps)
+ *            [32..]    records, each FlashLog_RecHdr + payload, 4-byte aligned
+ *
+ *          Power-loss safety:
+ *          - A sector only counts once its header CRC checks out, so an
+ *            interrupted erase or header write leaves a "free" sector.
+ *          - A record carries len / ~len and a CRC32 over both and the payload; a torn
+ *            record fails the check. Mount then seals that sector and the
+ *            next append opens a fresh one, so a partially programmed area
+ *            is never programmed again.
+ *
+ *          Mount reads only the sector headers (O(sectors)): the highest
+ *          sequence number is the head, the lowest the tail. Only the head
+ *          sector's records are scanned to find the append offset.
+ *
+ *          Wear: sectors are reused strictly round-robin, so every sector
+ *          sees the same erase count. FlashLog_Maintain() keeps up to
+ *          erase_ahead sectors after the head erased in the background,
+ *          which keeps erases off the append path (the oldest sector is
+ *          dropped when its erase is queued, so the ring holds erase_ahead
+ *          fewer sectors of records). The owner of the MD25Q64 handle must
+ *          call MD25Q64_Poll() for the erases to complete.
+ *
+ *          With a page write buffer attached (FlashLog_SetWriteBuffer())
+ *          records are coalesced into page programs. A record is then
+ *          durable only once its page is flushed. A torn page program
+ *          fails the record CRCs and is handled like any torn record.
+ *
+ *          Time index (FlashLog_SetIndex()): with a stamp function that
+ *          reads a record's timestamp, the first append into a sector
+ *          programs its stamp into the sector header, and closing the sector
+ *          programs the last one. Each stamp is stored with its complement,
+ *          so a torn or missing write reads as "unknown". A RAM table of
+ *          one FlashLog_Span per sector mirrors the headers; a range query
+ *          binary-searches it for the first sector to read and skips
+ *          sectors whose span lies outside the range. Stamps must not
+ *          decrease from one record to the next (a clock stepped back hides
+ *          the records after it from queries, not from the iterator).
+ *          Sectors written without an index count as older than any stamp.
+ */
+
+#ifndef __FLASH_LOG_H__
+#define __FLASH_LOG_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "md25q64.h"
+#include "md25q64_wbuf.h"
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+#define FLASHLOG_MAGIC          0x464C4731u     /* "FLG1" */
+#define FLASHLOG_HDR_SIZE       32              /* Sector header, bytes */
+#define FLASHLOG_MAX_RECORD     256             /* Longest record payload */
+#define FLASHLOG_ERASE_AHEAD    2               /* Default erased sectors kept ready */
+#define FLASHLOG_NO_STAMP       0xFFFFFFFFu     /* Span end not known */
+
+/* ============================================================================
+ * Status Codes
+ * ============================================================================ */
+typedef enum {
+    FLASHLOG_OK = 0,
+    FLASHLOG_ERROR,                 /* Flash access failed */
+    FLASHLOG_INVALID_PARAM,
+    FLASHLOG_NOT_MOUNTED,
+    FLASHLOG_END                    /* Iterator: no more records */
+} FlashLog_Status;
+
+/* ============================================================================
+ * On-Flash Structures
+ * ============================================================================ */
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;                   /* Increments for every sector opened */
+    uint32_t crc;                   /* CRC32 of magic and seq */
+    uint32_t first;                 /* Stamp of the first record (index) */
+    uint32_t first_inv;             /* ~first, programmed with it */
+    uint32_t last;                  /* Stamp of the last record, on close */
+    uint32_t last_inv;              /* ~last */
+    uint32_t reserved;              /* Left erased (0xFF) */
+} FlashLog_SectorHdr;
+
+typedef struct {
+    uint16_t len;                   /* Payload length */
+    uint16_t len_inv;               /* ~len */
+    uint32_t crc;                   /* CRC32 of len, len_inv and payload */
+} FlashLog_RecHdr;
+
+/* ============================================================================
+ * Log and Iterator State
+ * ============================================================================ */
+
+/* Timestamp of a record payload (seconds, or any non-decreasing unit) */
+typedef uint32_t (*FlashLog_StampFn)(const void *data, uint16_t len);
+
+typedef struct {
+    uint32_t first;                 /* FLASHLOG_NO_STAMP if not known */
+    uint32_t last;
+} FlashLog_Span;
+
+typedef struct {
+    MD25Q64_Handle *flash;
+    uint32_t base;                  /* First sector address */
+    uint16_t sector_count;
+    uint16_t head;                  /* Sector being appended to */
+    uint16_t tail;                  /* Oldest sector holding records */
+    uint32_t head_seq;
+    uint32_t head_offset;           /* Next free byte in the head sector */
+    uint16_t erased_ahead;          /* Sectors after head known blank */
+    uint16_t erase_ahead;           /* Target for erased_ahead (0: erase inline) */
+    uint8_t erasing;                /* Erase-ahead queued on the flash */
+    MD25Q64_WBuf *wbuf;             /* Optional record write buffer */
+    FlashLog_StampFn stamp;         /* Optional time index: record stamps */
+    FlashLog_Span *spans;           /* ...and one span per sector */
+    uint8_t mounted;
+    uint32_t appended;              /* Records appended since mount */
+    uint32_t slow_appends;          /* Appends that had to wait for an erase */
+} FlashLog;
+
+typedef struct {
+    const FlashLog *log;
+    uint16_t sector;
+    uint32_t offset;
+    uint32_t seq;                   /* Sequence number of the current sector */
+    uint8_t checked;                /* Current sector header validated */
+    uint8_t done;
+} FlashLog_Iter;
+
+typedef struct {
+    FlashLog_Iter it;
+    uint32_t from;                  /* Inclusive stamp range */
+    uint32_t to;
+    uint16_t sectors;               /* Sectors entered (for reports) */
+} FlashLog_Query;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief  Attach to a sector range and recover the head
+ * @param  log: Log state
+ * @param  flash: Initialized MD25Q64 handle
+ * @param  base: Sector-aligned start address
+ * @param  sector_count: Sectors in the range (>= 2)
+ * @note   A range without any valid sector header is started fresh.
+ */
+FlashLog_Status FlashLog_Mount(FlashLog *log, MD25Q64_Handle *flash,
+                               uint32_t base, uint16_t sector_count);
+
+/**
+ * @brief  Append one record
+ * @param  data: Payload
+ * @param  len: 1 - FLASHLOG_MAX_RECORD bytes
+ * @note   Normally one or two page programs. If the head sector is full
+ *         and no erased sector is ready (the erase started by
+ *         FlashLog_Maintain() has not finished, or was never started), the
+ *         append waits for it or erases inline (counted in slow_appends).
+ */
+FlashLog_Status FlashLog_Append(FlashLog *log, const void *data, uint16_t len);
+
+/**
+ * @brief  Start erasing the next sector ahead of the head
+ * @note   Non-blocking: queues MD25Q64_EraseSector_Start() and returns.
+ *         Returns at once if erase_ahead sectors are ready or one is
+ *         erasing. Each completed erase queues the next one until the
+ *         target depth is reached.
+ */
+FlashLog_Status FlashLog_Maintain(FlashLog *log);
+
+/**
+ * @brief  Set how many erased sectors to keep ahead of the head
+ * @param  depth: 0 - sector_count - 1 (0 disables background erase)
+ * @note   Already erased sectors stay claimed if the depth is lowered.
+ */
+FlashLog_Status FlashLog_SetEraseAhead(FlashLog *log, uint16_t depth);
+
+/**
+ * @brief  Route record writes (and reads) through a page write buffer
+ * @param  wb: Buffer on the same flash handle, or NULL to write directly
+ * @note   Call after FlashLog_Mount(), which detaches any buffer. The
+ *         buffer's owner polls it; opening a new sector flushes it.
+ */
+FlashLog_Status FlashLog_SetWriteBuffer(FlashLog *log, MD25Q64_WBuf *wb);
+
+/**
+ * @brief  Keep a time index of the records
+ * @param  stamp: Timestamp of a record payload, or NULL to drop the index
+ * @param  spans: sector_count entries, filled from the sector headers
+ * @note   Call after FlashLog_Mount() (O(sectors) header reads), which
+ *         detaches any index. A head sector holding records without a
+ *         first stamp is sealed, so the next append opens a fresh one.
+ */
+FlashLog_Status FlashLog_SetIndex(FlashLog *log, FlashLog_StampFn stamp, FlashLog_Span *spans);
+
+/**
+ * @brief  Number of sectors currently holding records (tail .. head)
+ */
+uint16_t FlashLog_UsedSectors(const FlashLog *log);
+
+/**
+ * @brief  Start iterating from the oldest record
+ */
+void FlashLog_IterInit(const FlashLog *log, FlashLog_Iter *it);
+
+/**
+ * @brief  Read the next record
+ * @note   Appends may continue between calls. If the ring recycles the
+ *         sector being read, iteration resumes at the oldest record.
+ * @param  buf: Destination, at least max_len bytes
+ * @param  len: Payload length (may exceed max_len; then only max_len copied)
+ * @retval FLASHLOG_OK, FLASHLOG_END or FLASHLOG_ERROR
+ */
+FlashLog_Status FlashLog_IterNext(FlashLog_Iter *it, void *buf, uint16_t max_len, uint16_t *len);
+
+/**
+ * @brief  Start a query for the records stamped from .. to (inclusive)
+ * @note   Needs FlashLog_SetIndex(). Binary-searches the span table for
+ *         the first sector to read, so no flash is read here.
+ * @retval FLASHLOG_INVALID_PARAM without an index or with from > to
+ */
+FlashLog_Status FlashLog_QueryInit(const FlashLog *log, FlashLog_Query *q,
+                                   uint32_t from, uint32_t to);
+
+/**
+ * @brief  Read the next record in the range, oldest first
+ * @note   Same buffer rules and recycling behaviour as FlashLog_IterNext().
+ *         Ends at the first record stamped after `to`.
+ * @retval FLASHLOG_OK, FLASHLOG_END or FLASHLOG_ERROR
+ */
+FlashLog_Status FlashLog_QueryNext(FlashLog_Query *q, void *buf, uint16_t max_len, uint16_t *len);
+
+/**
+ * @brief  CRC32 (IEEE 802.3, reflected), chainable: pass 0 to start
+ */
+uint32_t FlashLog_Crc32(uint32_t crc, const void *data, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FLASH_LOG_H__ */
@@ -7,6 +7,7 @@
  */
 
 #include "md25q64.h"
+#include <string.h>
 
 /* ============================================================================
  * Private Macros
@@ -16,16 +17,31 @@
 
 #define MD25Q64_SPI_TIMEOUT     1000
 
+/* Operation engine states */
+#define MD25Q64_STATE_IDLE      0   /* No active operation */
+#define MD25Q64_STATE_WAIT      1   /* Waiting for the chip to accept a command */
+#define MD25Q64_STATE_RUNNING   2   /* Command issued, polling WIP */
+#define MD25Q64_STATE_DMA       3   /* Data phase on DMA, CS held low */
+
+#define MD25Q64_IS_READ(type)   ((type) == MD25Q64_OP_READ || (type) == MD25Q64_OP_FAST_READ)
+#define MD25Q64_DMA_READY(h)    ((h)->hspi->hdmatx != NULL && (h)->hspi->hdmarx != NULL)
+
+/* ============================================================================
+ * Private Variables
+ * ============================================================================ */
+static MD25Q64_Handle *md25q64_dma_owner;   /* Handle with a DMA transfer in flight */
+
 /* ============================================================================
  * Private Function Prototypes
  * ============================================================================ */
 static MD25Q64_Status MD25Q64_SendCommand(MD25Q64_Handle *handle, uint8_t cmd);
-static MD25Q64_Status MD25Q64_SendCommandWithAddress(MD25Q64_Handle *handle,
-                                                      uint8_t cmd, uint32_t address);
 static MD25Q64_Status MD25Q64_Transmit(MD25Q64_Handle *handle,
                                         const uint8_t *data, uint32_t size);
 static MD25Q64_Status MD25Q64_Receive(MD25Q64_Handle *handle,
                                        uint8_t *data, uint32_t size);
+static MD25Q64_Status MD25Q64_RunSync(MD25Q64_Handle *handle, MD25Q64_Op *op);
+static MD25Q64_Status MD25Q64_CachedRead(MD25Q64_Handle *handle, MD25Q64_Op *op);
+static void MD25Q64_Complete(MD25Q64_Handle *handle, MD25Q64_Status status);
 
 /* ============================================================================
  * Initialization
@@ -41,12 +57,24 @@ MD25Q64_Status MD25Q64_Init(MD25Q64_Handle *handle, SPI_HandleTypeDef *hspi,
     handle->hspi = hspi;
     handle->cs_port = cs_port;
     handle->cs_pin = cs_pin;
+    handle->op_state = MD25Q64_STATE_IDLE;
+    handle->in_poll = 0;
+    handle->q_head = 0;
+    handle->q_count = 0;
+    handle->dma_busy = 0;
+    handle->dma_error = 0;
+    handle->suspended = 0;
+    handle->resume_tick = HAL_GetTick();
+    handle->cache = NULL;
+    memset(&handle->stats, 0, sizeof(handle->stats));
 
     /* Set CS high (deselect) */
     MD25Q64_CS_HIGH(handle);
 
-    /* Wait for power-up (tVSL = 5ms max) */
-    HAL_Delay(10);
+    /* Wait for power-up (tVSL), counted from HAL_Init rather than from here:
+     * by the time main() gets here it has usually passed already */
+    while (HAL_GetTick() < MD25Q64_POWERUP_MS) {
+    }
 
     /* Verify device ID */
     uint32_t jedec_id;
@@ -63,6 +91,15 @@ MD25Q64_Status MD25Q64_Init(MD25Q64_Handle *handle, SPI_HandleTypeDef *hspi,
     return MD25Q64_OK;
 }
 
+void MD25Q64_SetCache(MD25Q64_Handle *handle, MD25Q64_Cache *cache)
+{
+    if (handle == NULL) {
+        return;
+    }
+    MD25Q64_Cache_Invalidate(cache, 0, MD25Q64_FLASH_SIZE);
+    handle->cache = cache;
+}
+
 /* ============================================================================
  * ID Read Operations
  * ============================================================================ */
@@ -231,6 +268,10 @@ MD25Q64_Status MD25Q64_WriteStatusReg1(MD25Q64_Handle *handle, uint8_t status)
         return MD25Q64_INVALID_PARAM;
     }
 
+    if (MD25Q64_Flush(handle) != MD25Q64_OK) {
+        return MD25Q64_BUSY;
+    }
+
     /* Write Enable first */
     if (MD25Q64_WriteEnable(handle) != MD25Q64_OK) {
         return MD25Q64_ERROR;
@@ -257,6 +298,10 @@ MD25Q64_Status MD25Q64_WriteStatusReg2(MD25Q64_Handle *handle, uint8_t status)
         return MD25Q64_INVALID_PARAM;
     }
 
+    if (MD25Q64_Flush(handle) != MD25Q64_OK) {
+        return MD25Q64_BUSY;
+    }
+
     /* Write Enable first */
     if (MD25Q64_WriteEnable(handle) != MD25Q64_OK) {
         return MD25Q64_ERROR;
@@ -283,6 +328,10 @@ MD25Q64_Status MD25Q64_WriteStatusReg3(MD25Q64_Handle *handle, uint8_t status)
         return MD25Q64_INVALID_PARAM;
     }
 
+    if (MD25Q64_Flush(handle) != MD25Q64_OK) {
+        return MD25Q64_BUSY;
+    }
+
     /* Write Enable first */
     if (MD25Q64_WriteEnable(handle) != MD25Q64_OK) {
         return MD25Q64_ERROR;
@@ -376,326 +425,705 @@ MD25Q64_Status MD25Q64_WriteDisable(MD25Q64_Handle *handle)
 MD25Q64_Status MD25Q64_Read(MD25Q64_Handle *handle, uint32_t address,
                              uint8_t *data, uint32_t size)
 {
-    if (handle == NULL || data == NULL || size == 0) {
-        return MD25Q64_INVALID_PARAM;
-    }
+    /* Queued behind any program/erase: the array cannot be read while busy */
+    MD25Q64_Op op = {.type = MD25Q64_OP_READ, .address = address, .size = size, .dest = data};
+    return MD25Q64_CachedRead(handle, &op);
+}
 
-    if ((address + size) > MD25Q64_FLASH_SIZE) {
-        return MD25Q64_INVALID_PARAM;
-    }
+MD25Q64_Status MD25Q64_FastRead(MD25Q64_Handle *handle, uint32_t address,
+                                 uint8_t *data, uint32_t size)
+{
+    MD25Q64_Op op = {.type = MD25Q64_OP_FAST_READ, .address = address, .size = size,
+                     .dest = data};
+    return MD25Q64_CachedRead(handle, &op);
+}
 
-    /* Command + 24-bit address */
-    uint8_t cmd[4] = {
-        MD25Q64_CMD_READ_DATA,
-        (uint8_t)(address >> 16),
-        (uint8_t)(address >> 8),
-        (uint8_t)(address)
-    };
+/* ============================================================================
+ * Program Operations
+ * ============================================================================ */
 
-    MD25Q64_CS_LOW(handle);
+MD25Q64_Status MD25Q64_PageProgram(MD25Q64_Handle *handle, uint32_t address,
+                                    const uint8_t *data, uint32_t size)
+{
+    MD25Q64_Op op = {.type = MD25Q64_OP_PAGE_PROGRAM, .address = address, .data = data,
+                     .size = size};
+    return MD25Q64_RunSync(handle, &op);
+}
 
-    if (MD25Q64_Transmit(handle, cmd, 4) != MD25Q64_OK) {
-        MD25Q64_CS_HIGH(handle);
-        return MD25Q64_ERROR;
-    }
+MD25Q64_Status MD25Q64_Write(MD25Q64_Handle *handle, uint32_t address,
+                              const uint8_t *data, uint32_t size)
+{
+    MD25Q64_Op op = {.type = MD25Q64_OP_WRITE, .address = address, .data = data, .size = size};
+    return MD25Q64_RunSync(handle, &op);
+}
 
-    if (MD25Q64_Receive(handle, data, size) != MD25Q64_OK) {
-        MD25Q64_CS_HIGH(handle);
-        return MD25Q64_ERROR;
-    }
+/* ============================================================================
+ * Erase Operations
+ * ============================================================================ */
 
-    MD25Q64_CS_HIGH(handle);
-    return MD25Q64_OK;
+MD25Q64_Status MD25Q64_EraseSector(MD25Q64_Handle *handle, uint32_t address)
+{
+    MD25Q64_Op op = {.type = MD25Q64_OP_ERASE_SECTOR, .address = address};
+    return MD25Q64_RunSync(handle, &op);
 }
 
-MD25Q64_Status MD25Q64_FastRead(MD25Q64_Handle *handle, uint32_t address,
-                                 uint8_t *data, uint32_t size)
+MD25Q64_Status MD25Q64_EraseBlock32K(MD25Q64_Handle *handle, uint32_t address)
 {
-    if (handle == NULL || data == NULL || size == 0) {
-        return MD25Q64_INVALID_PARAM;
-    }
+    MD25Q64_Op op = {.type = MD25Q64_OP_ERASE_32K, .address = address};
+    return MD25Q64_RunSync(handle, &op);
+}
 
-    if ((address + size) > MD25Q64_FLASH_SIZE) {
-        return MD25Q64_INVALID_PARAM;
+MD25Q64_Status MD25Q64_EraseBlock64K(MD25Q64_Handle *handle, uint32_t address)
+{
+    MD25Q64_Op op = {.type = MD25Q64_OP_ERASE_64K, .address = address};
+    return MD25Q64_RunSync(handle, &op);
+}
+
+MD25Q64_Status MD25Q64_EraseChip(MD25Q64_Handle *handle)
+{
+    MD25Q64_Op op = {.type = MD25Q64_OP_ERASE_CHIP};
+    return MD25Q64_RunSync(handle, &op);
+}
+
+/* ============================================================================
+ * Asynchronous Operations
+ * ============================================================================ */
+
+static uint32_t MD25Q64_OpTimeout(uint8_t type)
+{
+    switch (type) {
+    case MD25Q64_OP_ERASE_SECTOR:   return MD25Q64_TIMEOUT_SECTOR_ERASE;
+    case MD25Q64_OP_ERASE_32K:      return MD25Q64_TIMEOUT_BLOCK_ERASE_32K;
+    case MD25Q64_OP_ERASE_64K:      return MD25Q64_TIMEOUT_BLOCK_ERASE_64K;
+    case MD25Q64_OP_ERASE_CHIP:     return MD25Q64_TIMEOUT_CHIP_ERASE;
+    default:                        return MD25Q64_TIMEOUT_PAGE_PROGRAM;
     }
+}
 
-    /* Command + 24-bit address + 1 dummy byte */
-    uint8_t cmd[5] = {
-        MD25Q64_CMD_FAST_READ,
-        (uint8_t)(address >> 16),
-        (uint8_t)(address >> 8),
-        (uint8_t)(address),
-        0x00  /* Dummy byte */
-    };
+/* Hand the data phase of the current step to DMA; CS stays low until the ISR */
+static MD25Q64_Status MD25Q64_StartDMA(MD25Q64_Handle *handle)
+{
+    const MD25Q64_Op *op = &handle->op;
+    HAL_StatusTypeDef hal_status;
 
-    MD25Q64_CS_LOW(handle);
+    handle->op_state = MD25Q64_STATE_DMA;
+    handle->dma_error = 0;
+    handle->dma_busy = 1;
+    md25q64_dma_owner = handle;
 
-    if (MD25Q64_Transmit(handle, cmd, 5) != MD25Q64_OK) {
-        MD25Q64_CS_HIGH(handle);
-        return MD25Q64_ERROR;
+    if (MD25Q64_IS_READ(op->type)) {
+        hal_status = HAL_SPI_Receive_DMA(handle->hspi, op->dest + handle->op_done,
+                                         (uint16_t)handle->op_chunk);
+    } else {
+        hal_status = HAL_SPI_Transmit_DMA(handle->hspi, (uint8_t *)(op->data + handle->op_done),
+                                          (uint16_t)handle->op_chunk);
     }
 
-    if (MD25Q64_Receive(handle, data, size) != MD25Q64_OK) {
+    if (hal_status != HAL_OK) {
+        md25q64_dma_owner = NULL;
+        handle->dma_busy = 0;
         MD25Q64_CS_HIGH(handle);
         return MD25Q64_ERROR;
     }
-
-    MD25Q64_CS_HIGH(handle);
     return MD25Q64_OK;
 }
 
-/* ============================================================================
- * Program Operations
- * ============================================================================ */
-
-MD25Q64_Status MD25Q64_PageProgram(MD25Q64_Handle *handle, uint32_t address,
-                                    const uint8_t *data, uint32_t size)
+/* Data of the current step is on the bus and CS is high */
+static void MD25Q64_DataDone(MD25Q64_Handle *handle)
 {
-    if (handle == NULL || data == NULL || size == 0) {
-        return MD25Q64_INVALID_PARAM;
+    if (MD25Q64_IS_READ(handle->op.type)) {
+        /* Reads finish with the transfer; the chip stays ready */
+        handle->op_done += handle->op_chunk;
+        if (handle->op_done >= handle->op.size) {
+            MD25Q64_Complete(handle, MD25Q64_OK);
+            return;
+        }
+        handle->op_state = MD25Q64_STATE_WAIT;
+    } else {
+        /* Programming starts when CS rises */
+        handle->op_state = MD25Q64_STATE_RUNNING;
     }
+    handle->op_tick = HAL_GetTick();
+}
 
-    /* Maximum 256 bytes per page */
-    if (size > MD25Q64_PAGE_SIZE) {
+/* Send WREN and the command for the next step of the active operation */
+static MD25Q64_Status MD25Q64_Issue(MD25Q64_Handle *handle)
+{
+    const MD25Q64_Op *op = &handle->op;
+    uint32_t address = op->address + handle->op_done;
+    uint32_t cmd_len = 4;
+    uint8_t cmd[5];
+
+    handle->op_chunk = 0;
+
+    switch (op->type) {
+    case MD25Q64_OP_PAGE_PROGRAM:
+        cmd[0] = MD25Q64_CMD_PAGE_PROGRAM;
+        handle->op_chunk = op->size;
+        break;
+    case MD25Q64_OP_WRITE:
+        /* Up to the end of the current page */
+        cmd[0] = MD25Q64_CMD_PAGE_PROGRAM;
+        handle->op_chunk = MD25Q64_PAGE_SIZE - (address % MD25Q64_PAGE_SIZE);
+        if (handle->op_chunk > op->size - handle->op_done) {
+            handle->op_chunk = op->size - handle->op_done;
+        }
+        break;
+    case MD25Q64_OP_ERASE_SECTOR:
+        cmd[0] = MD25Q64_CMD_SECTOR_ERASE;
+        break;
+    case MD25Q64_OP_ERASE_32K:
+        cmd[0] = MD25Q64_CMD_BLOCK_ERASE_32K;
+        break;
+    case MD25Q64_OP_ERASE_64K:
+        cmd[0] = MD25Q64_CMD_BLOCK_ERASE_64K;
+        break;
+    case MD25Q64_OP_ERASE_CHIP:
+        cmd[0] = MD25Q64_CMD_CHIP_ERASE;
+        cmd_len = 1;
+        break;
+    case MD25Q64_OP_FAST_READ:
+        cmd[4] = 0x00;  /* Dummy byte */
+        cmd_len = 5;
+        /* Fall through */
+    case MD25Q64_OP_READ:
+        cmd[0] = (op->type == MD25Q64_OP_READ) ? MD25Q64_CMD_READ_DATA : MD25Q64_CMD_FAST_READ;
+        handle->op_chunk = op->size - handle->op_done;
+        if (handle->op_chunk > MD25Q64_DMA_CHUNK) {
+            handle->op_chunk = MD25Q64_DMA_CHUNK;
+        }
+        break;
+    default:
         return MD25Q64_INVALID_PARAM;
     }
 
-    if ((address + size) > MD25Q64_FLASH_SIZE) {
-        return MD25Q64_INVALID_PARAM;
-    }
+    cmd[1] = (uint8_t)(address >> 16);
+    cmd[2] = (uint8_t)(address >> 8);
+    cmd[3] = (uint8_t)(address);
 
-    /* Wait for any previous operation to complete */
-    if (MD25Q64_WaitForReady(handle, MD25Q64_TIMEOUT_DEFAULT) != MD25Q64_OK) {
-        return MD25Q64_TIMEOUT;
-    }
-
-    /* Write Enable */
-    if (MD25Q64_WriteEnable(handle) != MD25Q64_OK) {
+    if (!MD25Q64_IS_READ(op->type) && MD25Q64_WriteEnable(handle) != MD25Q64_OK) {
         return MD25Q64_ERROR;
     }
 
-    /* Command + 24-bit address */
-    uint8_t cmd[4] = {
-        MD25Q64_CMD_PAGE_PROGRAM,
-        (uint8_t)(address >> 16),
-        (uint8_t)(address >> 8),
-        (uint8_t)(address)
-    };
-
     MD25Q64_CS_LOW(handle);
 
-    if (MD25Q64_Transmit(handle, cmd, 4) != MD25Q64_OK) {
+    /* Command bytes are always polled */
+    if (MD25Q64_Transmit(handle, cmd, cmd_len) != MD25Q64_OK) {
         MD25Q64_CS_HIGH(handle);
         return MD25Q64_ERROR;
     }
 
-    if (MD25Q64_Transmit(handle, data, size) != MD25Q64_OK) {
-        MD25Q64_CS_HIGH(handle);
-        return MD25Q64_ERROR;
+    if (handle->op_chunk >= MD25Q64_DMA_THRESHOLD && MD25Q64_DMA_READY(handle)) {
+        return MD25Q64_StartDMA(handle);
     }
 
-    MD25Q64_CS_HIGH(handle);
+    if (handle->op_chunk > 0) {
+        MD25Q64_Status status = MD25Q64_IS_READ(op->type) ?
+            MD25Q64_Receive(handle, op->dest + handle->op_done, handle->op_chunk) :
+            MD25Q64_Transmit(handle, op->data + handle->op_done, handle->op_chunk);
+        if (status != MD25Q64_OK) {
+            MD25Q64_CS_HIGH(handle);
+            return MD25Q64_ERROR;
+        }
+    }
 
-    /* Wait for programming to complete */
-    return MD25Q64_WaitForReady(handle, MD25Q64_TIMEOUT_PAGE_PROGRAM);
+    MD25Q64_CS_HIGH(handle);
+    return MD25Q64_OK;
 }
 
-MD25Q64_Status MD25Q64_Write(MD25Q64_Handle *handle, uint32_t address,
-                              const uint8_t *data, uint32_t size)
+static void MD25Q64_Complete(MD25Q64_Handle *handle, MD25Q64_Status status)
 {
-    if (handle == NULL || data == NULL || size == 0) {
-        return MD25Q64_INVALID_PARAM;
+    MD25Q64_Callback callback = handle->op.callback;
+
+    if (MD25Q64_IS_READ(handle->op.type)) {
+        uint32_t wait = HAL_GetTick() - handle->op.submit_tick;
+        handle->stats.reads++;
+        handle->stats.read_wait_sum_ms += wait;
+        if (wait > handle->stats.read_wait_max_ms) {
+            handle->stats.read_wait_max_ms = wait;
+        }
     }
 
-    if ((address + size) > MD25Q64_FLASH_SIZE) {
-        return MD25Q64_INVALID_PARAM;
+    handle->op_state = MD25Q64_STATE_IDLE;
+    if (callback != NULL) {
+        callback(handle, status, handle->op.ctx);
     }
+}
 
-    uint32_t bytes_written = 0;
-    uint32_t current_addr = address;
-    const uint8_t *current_data = data;
-
-    while (bytes_written < size) {
-        /* Calculate bytes remaining in current page */
-        uint32_t page_offset = current_addr % MD25Q64_PAGE_SIZE;
-        uint32_t bytes_in_page = MD25Q64_PAGE_SIZE - page_offset;
-        uint32_t bytes_to_write = size - bytes_written;
+MD25Q64_Status MD25Q64_Submit(MD25Q64_Handle *handle, const MD25Q64_Op *op)
+{
+    if (handle == NULL || op == NULL) {
+        return MD25Q64_INVALID_PARAM;
+    }
 
-        if (bytes_to_write > bytes_in_page) {
-            bytes_to_write = bytes_in_page;
+    switch (op->type) {
+    case MD25Q64_OP_PAGE_PROGRAM:
+        if (op->size > MD25Q64_PAGE_SIZE) {
+            return MD25Q64_INVALID_PARAM;
         }
-
-        /* Program current chunk */
-        MD25Q64_Status status = MD25Q64_PageProgram(handle, current_addr,
-                                                     current_data, bytes_to_write);
-        if (status != MD25Q64_OK) {
-            return status;
+        /* Fall through */
+    case MD25Q64_OP_WRITE:
+        if (op->data == NULL || op->size == 0 ||
+            (op->address + op->size) > MD25Q64_FLASH_SIZE) {
+            return MD25Q64_INVALID_PARAM;
         }
-
-        bytes_written += bytes_to_write;
-        current_addr += bytes_to_write;
-        current_data += bytes_to_write;
+        break;
+    case MD25Q64_OP_ERASE_SECTOR:
+    case MD25Q64_OP_ERASE_32K:
+    case MD25Q64_OP_ERASE_64K:
+        if (op->address >= MD25Q64_FLASH_SIZE) {
+            return MD25Q64_INVALID_PARAM;
+        }
+        break;
+    case MD25Q64_OP_ERASE_CHIP:
+        break;
+    case MD25Q64_OP_READ:
+    case MD25Q64_OP_FAST_READ:
+        if (op->dest == NULL || op->size == 0 ||
+            (op->address + op->size) > MD25Q64_FLASH_SIZE) {
+            return MD25Q64_INVALID_PARAM;
+        }
+        break;
+    default:
+        return MD25Q64_INVALID_PARAM;
     }
 
+    if (handle->q_count >= MD25Q64_QUEUE_LEN) {
+        return MD25Q64_BUSY;
+    }
+
+    /* Cached lines go stale now: later reads must queue up behind this */
+    switch (op->type) {
+    case MD25Q64_OP_PAGE_PROGRAM:
+        /* A page program wraps within its page */
+        MD25Q64_Cache_Invalidate(handle->cache, op->address & ~(uint32_t)(MD25Q64_PAGE_SIZE - 1),
+                                 MD25Q64_PAGE_SIZE);
+        break;
+    case MD25Q64_OP_WRITE:
+        MD25Q64_Cache_Invalidate(handle->cache, op->address, op->size);
+        break;
+    case MD25Q64_OP_ERASE_SECTOR:
+        MD25Q64_Cache_Invalidate(handle->cache, op->address & ~(uint32_t)(MD25Q64_SECTOR_SIZE - 1),
+                                 MD25Q64_SECTOR_SIZE);
+        break;
+    case MD25Q64_OP_ERASE_32K:
+        MD25Q64_Cache_Invalidate(handle->cache, op->address & ~(uint32_t)(MD25Q64_BLOCK_32K_SIZE - 1),
+                                 MD25Q64_BLOCK_32K_SIZE);
+        break;
+    case MD25Q64_OP_ERASE_64K:
+        MD25Q64_Cache_Invalidate(handle->cache, op->address & ~(uint32_t)(MD25Q64_BLOCK_64K_SIZE - 1),
+                                 MD25Q64_BLOCK_64K_SIZE);
+        break;
+    case MD25Q64_OP_ERASE_CHIP:
+        MD25Q64_Cache_Invalidate(handle->cache, 0, MD25Q64_FLASH_SIZE);
+        break;
+    default:
+        break;
+    }
+
+    MD25Q64_Op *slot = &handle->queue[(handle->q_head + handle->q_count) % MD25Q64_QUEUE_LEN];
+    *slot = *op;
+    slot->submit_tick = HAL_GetTick();
+    handle->q_count++;
+
+    /* Issue at once if nothing is running (callbacks are inside Poll already) */
+    if (!handle->in_poll && handle->op_state == MD25Q64_STATE_IDLE) {
+        MD25Q64_Poll(handle);
+    }
     return MD25Q64_OK;
 }
 
-/* ============================================================================
- * Erase Operations
- * ============================================================================ */
+MD25Q64_Status MD25Q64_PageProgram_Start(MD25Q64_Handle *handle, uint32_t address,
+                                          const uint8_t *data, uint32_t size,
+                                          MD25Q64_Callback callback, void *ctx)
+{
+    MD25Q64_Op op = {.type = MD25Q64_OP_PAGE_PROGRAM, .address = address, .data = data, .size = size,
+                     .callback = callback, .ctx = ctx};
+    return MD25Q64_Submit(handle, &op);
+}
 
-MD25Q64_Status MD25Q64_EraseSector(MD25Q64_Handle *handle, uint32_t address)
+MD25Q64_Status MD25Q64_Write_Start(MD25Q64_Handle *handle, uint32_t address,
+                                    const uint8_t *data, uint32_t size,
+                                    MD25Q64_Callback callback, void *ctx)
 {
-    if (handle == NULL) {
-        return MD25Q64_INVALID_PARAM;
-    }
+    MD25Q64_Op op = {.type = MD25Q64_OP_WRITE, .address = address, .data = data, .size = size,
+                     .callback = callback, .ctx = ctx};
+    return MD25Q64_Submit(handle, &op);
+}
 
-    if (address >= MD25Q64_FLASH_SIZE) {
-        return MD25Q64_INVALID_PARAM;
-    }
+MD25Q64_Status MD25Q64_EraseSector_Start(MD25Q64_Handle *handle, uint32_t address,
+                                          MD25Q64_Callback callback, void *ctx)
+{
+    MD25Q64_Op op = {.type = MD25Q64_OP_ERASE_SECTOR, .address = address,
+                     .callback = callback, .ctx = ctx};
+    return MD25Q64_Submit(handle, &op);
+}
 
-    /* Wait for any previous operation to complete */
-    if (MD25Q64_WaitForReady(handle, MD25Q64_TIMEOUT_DEFAULT) != MD25Q64_OK) {
-        return MD25Q64_TIMEOUT;
-    }
+MD25Q64_Status MD25Q64_EraseBlock32K_Start(MD25Q64_Handle *handle, uint32_t address,
+                                            MD25Q64_Callback callback, void *ctx)
+{
+    MD25Q64_Op op = {.type = MD25Q64_OP_ERASE_32K, .address = address,
+                     .callback = callback, .ctx = ctx};
+    return MD25Q64_Submit(handle, &op);
+}
 
-    /* Write Enable */
-    if (MD25Q64_WriteEnable(handle) != MD25Q64_OK) {
-        return MD25Q64_ERROR;
-    }
+MD25Q64_Status MD25Q64_EraseBlock64K_Start(MD25Q64_Handle *handle, uint32_t address,
+                                            MD25Q64_Callback callback, void *ctx)
+{
+    MD25Q64_Op op = {.type = MD25Q64_OP_ERASE_64K, .address = address,
+                     .callback = callback, .ctx = ctx};
+    return MD25Q64_Submit(handle, &op);
+}
 
-    /* Command + 24-bit address */
-    uint8_t cmd[4] = {
-        MD25Q64_CMD_SECTOR_ERASE,
-        (uint8_t)(address >> 16),
-        (uint8_t)(address >> 8),
-        (uint8_t)(address)
-    };
+MD25Q64_Status MD25Q64_EraseChip_Start(MD25Q64_Handle *handle,
+                                        MD25Q64_Callback callback, void *ctx)
+{
+    MD25Q64_Op op = {.type = MD25Q64_OP_ERASE_CHIP, .callback = callback, .ctx = ctx};
+    return MD25Q64_Submit(handle, &op);
+}
 
-    MD25Q64_CS_LOW(handle);
+MD25Q64_Status MD25Q64_Read_Start(MD25Q64_Handle *handle, uint32_t address,
+                                   uint8_t *data, uint32_t size,
+                                   MD25Q64_Callback callback, void *ctx)
+{
+    MD25Q64_Op op = {.type = MD25Q64_OP_READ, .address = address, .size = size,
+                     .callback = callback, .ctx = ctx, .dest = data};
+    return MD25Q64_Submit(handle, &op);
+}
 
-    if (MD25Q64_Transmit(handle, cmd, 4) != MD25Q64_OK) {
-        MD25Q64_CS_HIGH(handle);
-        return MD25Q64_ERROR;
-    }
+MD25Q64_Status MD25Q64_FastRead_Start(MD25Q64_Handle *handle, uint32_t address,
+                                       uint8_t *data, uint32_t size,
+                                       MD25Q64_Callback callback, void *ctx)
+{
+    MD25Q64_Op op = {.type = MD25Q64_OP_FAST_READ, .address = address, .size = size,
+                     .callback = callback, .ctx = ctx, .dest = data};
+    return MD25Q64_Submit(handle, &op);
+}
 
-    MD25Q64_CS_HIGH(handle);
+void MD25Q64_DMA_Complete(SPI_HandleTypeDef *hspi)
+{
+    MD25Q64_Handle *handle = md25q64_dma_owner;
 
-    /* Wait for erase to complete */
-    return MD25Q64_WaitForReady(handle, MD25Q64_TIMEOUT_SECTOR_ERASE);
+    if (handle == NULL || handle->hspi != hspi) {
+        return;
+    }
+    MD25Q64_CS_HIGH(handle);
+    md25q64_dma_owner = NULL;
+    handle->dma_busy = 0;
 }
 
-MD25Q64_Status MD25Q64_EraseBlock32K(MD25Q64_Handle *handle, uint32_t address)
+void MD25Q64_DMA_Error(SPI_HandleTypeDef *hspi)
 {
-    if (handle == NULL) {
-        return MD25Q64_INVALID_PARAM;
-    }
+    MD25Q64_Handle *handle = md25q64_dma_owner;
 
-    if (address >= MD25Q64_FLASH_SIZE) {
-        return MD25Q64_INVALID_PARAM;
+    if (handle == NULL || handle->hspi != hspi) {
+        return;
     }
+    handle->dma_error = 1;
+    MD25Q64_DMA_Complete(hspi);
+}
 
-    /* Wait for any previous operation to complete */
-    if (MD25Q64_WaitForReady(handle, MD25Q64_TIMEOUT_DEFAULT) != MD25Q64_OK) {
-        return MD25Q64_TIMEOUT;
+static uint32_t MD25Q64_EraseSpan(uint8_t type)
+{
+    switch (type) {
+    case MD25Q64_OP_ERASE_SECTOR:   return MD25Q64_SECTOR_SIZE;
+    case MD25Q64_OP_ERASE_32K:      return MD25Q64_BLOCK_32K_SIZE;
+    case MD25Q64_OP_ERASE_64K:      return MD25Q64_BLOCK_64K_SIZE;
+    default:                        return 0;   /* Not suspendable */
     }
+}
 
-    /* Write Enable */
-    if (MD25Q64_WriteEnable(handle) != MD25Q64_OK) {
-        return MD25Q64_ERROR;
+/* The queue head is a read that may run while `erase` is suspended */
+static uint8_t MD25Q64_ReadFitsSuspend(const MD25Q64_Handle *handle, const MD25Q64_Op *erase)
+{
+    const MD25Q64_Op *next = &handle->queue[handle->q_head];
+    uint32_t span = MD25Q64_EraseSpan(erase->type);
+    uint32_t start = erase->address & ~(span - 1u);
+
+    if (handle->q_count == 0 || span == 0 || !MD25Q64_IS_READ(next->type)) {
+        return 0;
     }
+    /* The block being erased reads back undefined */
+    return (next->address + next->size <= start || next->address >= start + span) ? 1 : 0;
+}
 
-    /* Command + 24-bit address */
-    uint8_t cmd[4] = {
-        MD25Q64_CMD_BLOCK_ERASE_32K,
-        (uint8_t)(address >> 16),
-        (uint8_t)(address >> 8),
-        (uint8_t)(address)
-    };
+/* Park the running erase in the chip so the queued read can go first */
+static uint8_t MD25Q64_TrySuspend(MD25Q64_Handle *handle)
+{
+#if MD25Q64_ERASE_SUSPEND
+    uint32_t start;
+    uint8_t sr;
+
+    if (!MD25Q64_ReadFitsSuspend(handle, &handle->op) ||
+        (HAL_GetTick() - handle->resume_tick) < MD25Q64_SUSPEND_GAP_MS) {
+        return 0;
+    }
+    if (MD25Q64_SendCommand(handle, MD25Q64_CMD_PROG_ERASE_SUSPEND) != MD25Q64_OK) {
+        return 0;
+    }
+
+    handle->susp_op = handle->op;
+    handle->susp_tick = HAL_GetTick();
+    handle->susp_elapsed = handle->susp_tick - handle->op_tick;
+    handle->suspended = 1;
+    handle->op_state = MD25Q64_STATE_IDLE;
+    handle->stats.suspends++;
+
+    /* tSUS is tens of microseconds: wait here rather than a whole Poll period */
+    start = HAL_GetTick();
+    while (MD25Q64_ReadStatusReg1(handle, &sr) == MD25Q64_OK &&
+           (sr & MD25Q64_SR1_WIP) && (HAL_GetTick() - start) < 1) {
+    }
+    return 1;
+#else
+    (void)handle;
+    return 0;
+#endif
+}
 
-    MD25Q64_CS_LOW(handle);
+/*
+ * Continue the parked erase. If it had in fact finished before the suspend
+ * command, the chip ignores the resume and the next WIP read completes it.
+ */
+static void MD25Q64_Resume(MD25Q64_Handle *handle)
+{
+    MD25Q64_Status status = MD25Q64_SendCommand(handle, MD25Q64_CMD_PROG_ERASE_RESUME);
 
-    if (MD25Q64_Transmit(handle, cmd, 4) != MD25Q64_OK) {
-        MD25Q64_CS_HIGH(handle);
-        return MD25Q64_ERROR;
+    handle->suspended = 0;
+    handle->op = handle->susp_op;
+    handle->op_state = MD25Q64_STATE_RUNNING;
+    handle->resume_tick = HAL_GetTick();
+    handle->op_tick = handle->resume_tick - handle->susp_elapsed;
+    if (status != MD25Q64_OK) {
+        MD25Q64_Complete(handle, MD25Q64_ERROR);
     }
-
-    MD25Q64_CS_HIGH(handle);
-
-    /* Wait for erase to complete */
-    return MD25Q64_WaitForReady(handle, MD25Q64_TIMEOUT_BLOCK_ERASE_32K);
 }
 
-MD25Q64_Status MD25Q64_EraseBlock64K(MD25Q64_Handle *handle, uint32_t address)
+MD25Q64_Status MD25Q64_Poll(MD25Q64_Handle *handle)
 {
+    uint8_t sr;
+
     if (handle == NULL) {
         return MD25Q64_INVALID_PARAM;
     }
+    if (handle->in_poll) {
+        return MD25Q64_BUSY;
+    }
+    handle->in_poll = 1;
+
+    for (;;) {
+        if (handle->op_state == MD25Q64_STATE_IDLE) {
+            /* Reads queued back to back would otherwise keep it parked */
+            if (handle->suspended &&
+                (!MD25Q64_ReadFitsSuspend(handle, &handle->susp_op) ||
+                 (HAL_GetTick() - handle->susp_tick) >= MD25Q64_SUSPEND_MAX_MS)) {
+                MD25Q64_Resume(handle);
+                continue;
+            }
+            if (handle->q_count == 0) {
+                break;
+            }
+            handle->op = handle->queue[handle->q_head];
+            handle->q_head = (uint8_t)((handle->q_head + 1) % MD25Q64_QUEUE_LEN);
+            handle->q_count--;
+            handle->op_done = 0;
+            handle->op_state = MD25Q64_STATE_WAIT;
+            handle->op_tick = HAL_GetTick();
+        }
 
-    if (address >= MD25Q64_FLASH_SIZE) {
-        return MD25Q64_INVALID_PARAM;
-    }
+        if (handle->op_state == MD25Q64_STATE_DMA) {
+            if (handle->dma_busy) {
+                if ((HAL_GetTick() - handle->op_tick) < MD25Q64_SPI_TIMEOUT) {
+                    break;
+                }
+                HAL_SPI_Abort(handle->hspi);
+                md25q64_dma_owner = NULL;
+                handle->dma_busy = 0;
+                MD25Q64_CS_HIGH(handle);
+                MD25Q64_Complete(handle, MD25Q64_TIMEOUT);
+                continue;
+            }
+            if (handle->dma_error) {
+                MD25Q64_Complete(handle, MD25Q64_ERROR);
+                continue;
+            }
+            MD25Q64_DataDone(handle);
+            continue;
+        }
 
-    /* Wait for any previous operation to complete */
-    if (MD25Q64_WaitForReady(handle, MD25Q64_TIMEOUT_DEFAULT) != MD25Q64_OK) {
-        return MD25Q64_TIMEOUT;
-    }
+        /* One status read per call; never wait here */
+        if (MD25Q64_ReadStatusReg1(handle, &sr) != MD25Q64_OK) {
+            MD25Q64_Complete(handle, MD25Q64_ERROR);
+            continue;
+        }
+        if (sr & MD25Q64_SR1_WIP) {
+            if (handle->op_state == MD25Q64_STATE_RUNNING && MD25Q64_TrySuspend(handle)) {
+                continue;
+            }
+            uint32_t limit = (handle->op_state == MD25Q64_STATE_RUNNING) ?
+                             MD25Q64_OpTimeout(handle->op.type) : MD25Q64_TIMEOUT_DEFAULT;
+            if ((HAL_GetTick() - handle->op_tick) >= limit) {
+                MD25Q64_Complete(handle, MD25Q64_TIMEOUT);
+                continue;
+            }
+            break;
+        }
 
-    /* Write Enable */
-    if (MD25Q64_WriteEnable(handle) != MD25Q64_OK) {
-        return MD25Q64_ERROR;
+        if (handle->op_state == MD25Q64_STATE_RUNNING) {
+            handle->op_done += handle->op_chunk;
+            if (handle->op_done >= handle->op.size) {
+                MD25Q64_Complete(handle, MD25Q64_OK);
+                continue;
+            }
+        }
+
+        /* Chip ready: next page / chunk, or the first command */
+        if (MD25Q64_Issue(handle) != MD25Q64_OK) {
+            MD25Q64_Complete(handle, MD25Q64_ERROR);
+            continue;
+        }
+        if (handle->op_state == MD25Q64_STATE_DMA) {
+            handle->op_tick = HAL_GetTick();
+            break;
+        }
+        MD25Q64_DataDone(handle);
+        if (handle->op_state == MD25Q64_STATE_RUNNING) {
+            break;
+        }
     }
 
-    /* Command + 24-bit address */
-    uint8_t cmd[4] = {
-        MD25Q64_CMD_BLOCK_ERASE_64K,
-        (uint8_t)(address >> 16),
-        (uint8_t)(address >> 8),
-        (uint8_t)(address)
-    };
+    handle->in_poll = 0;
+    return MD25Q64_IsIdle(handle) ? MD25Q64_OK : MD25Q64_BUSY;
+}
 
-    MD25Q64_CS_LOW(handle);
+uint8_t MD25Q64_IsIdle(const MD25Q64_Handle *handle)
+{
+    return (handle->op_state == MD25Q64_STATE_IDLE && handle->q_count == 0 &&
+            !handle->suspended) ? 1 : 0;
+}
 
-    if (MD25Q64_Transmit(handle, cmd, 4) != MD25Q64_OK) {
-        MD25Q64_CS_HIGH(handle);
-        return MD25Q64_ERROR;
+MD25Q64_Status MD25Q64_Flush(MD25Q64_Handle *handle)
+{
+    if (handle == NULL) {
+        return MD25Q64_INVALID_PARAM;
+    }
+    if (handle->in_poll) {
+        return MD25Q64_BUSY;
     }
 
-    MD25Q64_CS_HIGH(handle);
+    while (MD25Q64_Poll(handle) != MD25Q64_OK) {
+        /* Small delay to reduce SPI bus traffic */
+        HAL_Delay(1);
+    }
+    return MD25Q64_OK;
+}
 
-    /* Wait for erase to complete */
-    return MD25Q64_WaitForReady(handle, MD25Q64_TIMEOUT_BLOCK_ERASE_64K);
+static void MD25Q64_SyncDone(MD25Q64_Handle *handle, MD25Q64_Status status, void *ctx)
+{
+    (void)handle;
+    *(MD25Q64_Status *)ctx = status;
 }
 
-MD25Q64_Status MD25Q64_EraseChip(MD25Q64_Handle *handle)
+/* Blocking form: queue behind pending work, then wait for this operation */
+static MD25Q64_Status MD25Q64_RunSync(MD25Q64_Handle *handle, MD25Q64_Op *op)
 {
+    MD25Q64_Status result = MD25Q64_BUSY;
+    MD25Q64_Status status;
+
     if (handle == NULL) {
         return MD25Q64_INVALID_PARAM;
     }
+    if (handle->in_poll) {
+        return MD25Q64_BUSY;
+    }
+
+    op->callback = MD25Q64_SyncDone;
+    op->ctx = &result;
 
-    /* Wait for any previous operation to complete */
-    if (MD25Q64_WaitForReady(handle, MD25Q64_TIMEOUT_DEFAULT) != MD25Q64_OK) {
-        return MD25Q64_TIMEOUT;
+    while ((status = MD25Q64_Submit(handle, op)) == MD25Q64_BUSY) {
+        MD25Q64_Poll(handle);
+        HAL_Delay(1);
+    }
+    if (status != MD25Q64_OK) {
+        return status;
     }
 
-    /* Write Enable */
-    if (MD25Q64_WriteEnable(handle) != MD25Q64_OK) {
-        return MD25Q64_ERROR;
+    /* Completion statuses are OK / ERROR / TIMEOUT, never BUSY */
+    while (result == MD25Q64_BUSY) {
+        if (MD25Q64_Poll(handle) == MD25Q64_BUSY && result == MD25Q64_BUSY &&
+            handle->op_state != MD25Q64_STATE_DMA) {
+            HAL_Delay(1);
+        }
     }
+    return result;
+}
 
-    uint8_t cmd = MD25Q64_CMD_CHIP_ERASE;
+/* Blocking read through handle->cache: a short read is assembled line by
+ * line, fetching each missing line whole; a long one goes to the chip */
+static MD25Q64_Status MD25Q64_CachedRead(MD25Q64_Handle *handle, MD25Q64_Op *op)
+{
+    MD25Q64_Cache *cache = (handle != NULL) ? handle->cache : NULL;
+    const uint32_t mask = ~(uint32_t)(MD25Q64_CACHE_LINE - 1);
+    uint32_t address = op->address, size = op->size;
+    uint8_t *data = op->dest;
+    MD25Q64_Status status;
 
-    MD25Q64_CS_LOW(handle);
+    if (cache == NULL || data == NULL || size == 0 || (address + size) > MD25Q64_FLASH_SIZE) {
+        return MD25Q64_RunSync(handle, op);
+    }
 
-    if (MD25Q64_Transmit(handle, &cmd, 1) != MD25Q64_OK) {
-        MD25Q64_CS_HIGH(handle);
-        return MD25Q64_ERROR;
+    cache->stats.read_bytes += size;
+    if (cache->count == 0 ||
+        ((address + size - 1u) & mask) - (address & mask) >= MD25Q64_CACHE_BYPASS * MD25Q64_CACHE_LINE) {
+        cache->stats.bypass++;
+        cache->stats.spi_bytes += size;
+        return MD25Q64_RunSync(handle, op);
     }
 
-    MD25Q64_CS_HIGH(handle);
+    while (size > 0) {
+        uint32_t line_addr = address & mask;
+        uint32_t offset = address - line_addr;
+        uint32_t n = MD25Q64_CACHE_LINE - offset;
+        const uint8_t *src = MD25Q64_Cache_Lookup(cache, line_addr);
 
-    /* Wait for erase to complete */
-    return MD25Q64_WaitForReady(handle, MD25Q64_TIMEOUT_CHIP_ERASE);
+        if (n > size) {
+            n = size;
+        }
+        if (src == NULL && ((line_addr ^ cache->last_miss) & ~(uint32_t)(MD25Q64_SECTOR_SIZE - 1u)) != 0) {
+            /* First miss in this sector: a scan probing one header per sector
+             * would pay a whole line for a few bytes, so fetch just those */
+            cache->last_miss = line_addr;
+            op->address = address;
+            op->size = n;
+            op->dest = data;
+            status = MD25Q64_RunSync(handle, op);
+            if (status != MD25Q64_OK) {
+                return status;
+            }
+            cache->stats.spi_bytes += n;
+        } else if (src == NULL) {
+            MD25Q64_CacheLine *line = MD25Q64_Cache_Alloc(cache);
+            uint32_t gen = cache->gen;
+
+            op->address = line_addr;
+            op->size = MD25Q64_CACHE_LINE;
+            op->dest = line->data;
+            status = MD25Q64_RunSync(handle, op);
+            if (status != MD25Q64_OK) {
+                return status;
+            }
+            cache->stats.spi_bytes += MD25Q64_CACHE_LINE;
+            cache->last_miss = line_addr;
+            MD25Q64_Cache_Commit(cache, line, line_addr, gen);
+            memcpy(data, line->data + offset, n);
+        } else {
+            memcpy(data, src + offset, n);
+        }
+        data += n;
+        address += n;
+        size -= n;
+    }
+    return MD25Q64_OK;
 }
 
 /* ============================================================================
@@ -708,6 +1136,10 @@ MD25Q64_Status MD25Q64_PowerDown(MD25Q64_Handle *handle)
         return MD25Q64_INVALID_PARAM;
     }
 
+    if (MD25Q64_Flush(handle) != MD25Q64_OK) {
+        return MD25Q64_BUSY;
+    }
+
     uint8_t cmd = MD25Q64_CMD_DEEP_POWER_DOWN;
 
     MD25Q64_CS_LOW(handle);
@@ -748,6 +1180,10 @@ MD25Q64_Status MD25Q64_Reset(MD25Q64_Handle *handle)
         return MD25Q64_INVALID_PARAM;
     }
 
+    if (MD25Q64_Flush(handle) != MD25Q64_OK) {
+        return MD25Q64_BUSY;
+    }
+
     /* Send Enable Reset command */
     uint8_t cmd = MD25Q64_CMD_ENABLE_RESET;
 
@@ -800,29 +1236,49 @@ MD25Q64_Status MD25Q64_LockAll(MD25Q64_Handle *handle)
 }
 
 /* ============================================================================
- * Private Functions
+ * Self-Check
  * ============================================================================ */
 
-static MD25Q64_Status MD25Q64_SendCommand(MD25Q64_Handle *handle, uint8_t cmd)
+MD25Q64_Status MD25Q64_SelfCheck(MD25Q64_Handle *handle, MD25Q64_Info *info)
 {
-    MD25Q64_CS_LOW(handle);
-    MD25Q64_Status status = MD25Q64_Transmit(handle, &cmd, 1);
-    MD25Q64_CS_HIGH(handle);
-    return status;
+    MD25Q64_Info snap;
+
+    if (handle == NULL) {
+        return MD25Q64_INVALID_PARAM;
+    }
+
+    if (MD25Q64_ReadJEDECID(handle, &snap.jedec_id) != MD25Q64_OK ||
+        MD25Q64_ReadStatusReg1(handle, &snap.sr1) != MD25Q64_OK ||
+        MD25Q64_ReadStatusReg2(handle, &snap.sr2) != MD25Q64_OK ||
+        MD25Q64_ReadStatusReg3(handle, &snap.sr3) != MD25Q64_OK) {
+        return MD25Q64_ERROR;
+    }
+    if (info != NULL) {
+        *info = snap;
+    }
+
+    if (snap.jedec_id != MD25Q64_JEDEC_ID) {
+        return MD25Q64_ERROR;
+    }
+    if (snap.sr1 & MD25Q64_SR1_WIP) {
+        return MD25Q64_BUSY;
+    }
+    if ((snap.sr1 & (MD25Q64_SR1_BP0 | MD25Q64_SR1_BP1 | MD25Q64_SR1_BP2 |
+                     MD25Q64_SR1_BP3 | MD25Q64_SR1_BP4 | MD25Q64_SR1_SRP0)) ||
+        (snap.sr2 & (MD25Q64_SR2_SRP1 | MD25Q64_SR2_CMP))) {
+        return MD25Q64_WRITE_PROTECTED;
+    }
+    return MD25Q64_OK;
 }
 
-static MD25Q64_Status MD25Q64_SendCommandWithAddress(MD25Q64_Handle *handle,
-                                                      uint8_t cmd, uint32_t address)
-{
-    uint8_t data[4] = {
-        cmd,
-        (uint8_t)(address >> 16),
-        (uint8_t)(address >> 8),
-        (uint8_t)(address)
-    };
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
 
+static MD25Q64_Status MD25Q64_SendCommand(MD25Q64_Handle *handle, uint8_t cmd)
+{
     MD25Q64_CS_LOW(handle);
-    MD25Q64_Status status = MD25Q64_Transmit(handle, data, 4);
+    MD25Q64_Status status = MD25Q64_Transmit(handle, &cmd, 1);
     MD25Q64_CS_HIGH(handle);
     return status;
 }
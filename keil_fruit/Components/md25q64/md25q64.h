@@ -13,7 +13,12 @@
 extern "C" {
 #endif
 
+#ifdef USE_HAL_DRIVER
 #include "main.h"
+#else
+#include "md25q64_port.h"   /* Host build: HAL subset from a SPI/GPIO shim */
+#endif
+#include "md25q64_cache.h"
 
 /* ============================================================================
  * Flash Memory Configuration
@@ -141,6 +146,7 @@ extern "C" {
 #define MD25Q64_TIMEOUT_CHIP_ERASE      150000  /* Typ: 30s, Max: 120s */
 #define MD25Q64_TIMEOUT_WRITE_SR        50      /* Typ: 5ms, Max: 30ms */
 #define MD25Q64_TIMEOUT_DEFAULT         1000
+#define MD25Q64_POWERUP_MS              10      /* tVSL: 5ms max after VCC */
 
 /* ============================================================================
  * Error Codes
@@ -155,13 +161,90 @@ typedef enum {
 } MD25Q64_Status;
 
 /* ============================================================================
- * Hardware Configuration Structure
+ * Asynchronous Operations
  * ============================================================================ */
+#define MD25Q64_QUEUE_LEN       4       /* Operations waiting behind the active one */
+#define MD25Q64_DMA_THRESHOLD   64      /* Data phases this long or longer use DMA */
+#define MD25Q64_DMA_CHUNK       32768   /* Longest single DMA read (HAL limit 65535) */
+#define MD25Q64_ERASE_SUSPEND   1       /* Suspend sector/block erases for reads */
+#define MD25Q64_SUSPEND_GAP_MS  2       /* Erase runs at least this long between suspends */
+#define MD25Q64_SUSPEND_MAX_MS  10      /* and stays parked at most this long */
+
+typedef enum {
+    MD25Q64_OP_PAGE_PROGRAM = 1,    /* One page program (size <= 256) */
+    MD25Q64_OP_WRITE,               /* Any size, split at page boundaries */
+    MD25Q64_OP_ERASE_SECTOR,
+    MD25Q64_OP_ERASE_32K,
+    MD25Q64_OP_ERASE_64K,
+    MD25Q64_OP_ERASE_CHIP,
+    MD25Q64_OP_READ,                /* Standard read into dest */
+    MD25Q64_OP_FAST_READ
+} MD25Q64_OpType;
+
+typedef struct MD25Q64_Handle MD25Q64_Handle;
+
+/**
+ * @brief  Completion callback, called from MD25Q64_Poll()
+ * @param  status: MD25Q64_OK, MD25Q64_ERROR or MD25Q64_TIMEOUT
+ * @note   May submit follow-up operations; must not call the blocking API.
+ */
+typedef void (*MD25Q64_Callback)(MD25Q64_Handle *handle, MD25Q64_Status status, void *ctx);
+
+typedef struct {
+    uint8_t type;                   /* MD25Q64_OpType */
+    uint32_t address;
+    const uint8_t *data;            /* Program source, valid until completion */
+    uint32_t size;
+    MD25Q64_Callback callback;      /* Optional */
+    void *ctx;
+    uint8_t *dest;                  /* Read destination, valid until completion */
+    uint32_t submit_tick;           /* Set by MD25Q64_Submit() */
+} MD25Q64_Op;
+
 typedef struct {
+    uint32_t reads;                 /* Read operations completed */
+    uint32_t read_wait_sum_ms;      /* Submit to completion, summed */
+    uint32_t read_wait_max_ms;
+    uint32_t suspends;              /* Erases suspended to serve a read */
+} MD25Q64_Stats;
+
+/* Identity and status snapshot (MD25Q64_SelfCheck) */
+typedef struct {
+    uint32_t jedec_id;
+    uint8_t sr1;
+    uint8_t sr2;
+    uint8_t sr3;
+} MD25Q64_Info;
+
+/* ============================================================================
+ * Hardware Configuration Structure
+ * ============================================================================ */
+struct MD25Q64_Handle {
     SPI_HandleTypeDef *hspi;        /* SPI Handle */
     GPIO_TypeDef *cs_port;          /* CS Pin Port */
     uint16_t cs_pin;                /* CS Pin */
-} MD25Q64_Handle;
+
+    /* Operation engine (driver private) */
+    MD25Q64_Op op;                  /* Active operation */
+    uint32_t op_done;               /* Bytes of op already programmed */
+    uint32_t op_chunk;              /* Bytes in the command now running */
+    uint32_t op_tick;               /* HAL_GetTick() at the last state change */
+    uint8_t op_state;
+    uint8_t in_poll;
+    uint8_t q_head;
+    uint8_t q_count;
+    volatile uint8_t dma_busy;      /* Data phase running on DMA */
+    volatile uint8_t dma_error;
+    uint8_t suspended;              /* susp_op is parked in the chip */
+    MD25Q64_Op susp_op;
+    uint32_t susp_elapsed;          /* Erase time before the suspend */
+    uint32_t susp_tick;             /* HAL_GetTick() at the suspend */
+    uint32_t resume_tick;
+    MD25Q64_Op queue[MD25Q64_QUEUE_LEN];
+
+    MD25Q64_Cache *cache;           /* Optional read cache, NULL: none */
+    MD25Q64_Stats stats;
+};
 
 /* ============================================================================
  * Function Prototypes - Initialization
@@ -178,6 +261,13 @@ typedef struct {
 MD25Q64_Status MD25Q64_Init(MD25Q64_Handle *handle, SPI_HandleTypeDef *hspi,
                              GPIO_TypeDef *cs_port, uint16_t cs_pin);
 
+/**
+ * @brief  Attach a read cache (md25q64_cache.h), or detach with NULL
+ * @param  handle: Flash handle pointer
+ * @param  cache: Initialized cache; emptied here
+ */
+void MD25Q64_SetCache(MD25Q64_Handle *handle, MD25Q64_Cache *cache);
+
 /* ============================================================================
  * Function Prototypes - ID Read
  * ============================================================================ */
@@ -300,9 +390,12 @@ MD25Q64_Status MD25Q64_WriteDisable(MD25Q64_Handle *handle);
  * @brief  Read data from flash (Standard Read, up to 80MHz)
  * @param  handle: Flash handle pointer
  * @param  address: Start address (0x000000 - 0x7FFFFF)
- * @param  data: Output data buffer
+ * @param  data: Output data buffer (DMA-reachable SRAM for large reads)
  * @param  size: Number of bytes to read
  * @retval MD25Q64_Status
+ * @note   Waits behind queued operations; reads of MD25Q64_DMA_THRESHOLD
+ *         bytes or more use DMA in MD25Q64_DMA_CHUNK pieces. Served from
+ *         the read cache when one is attached.
  */
 MD25Q64_Status MD25Q64_Read(MD25Q64_Handle *handle, uint32_t address,
                              uint8_t *data, uint32_t size);
@@ -382,6 +475,93 @@ MD25Q64_Status MD25Q64_EraseBlock64K(MD25Q64_Handle *handle, uint32_t address);
  */
 MD25Q64_Status MD25Q64_EraseChip(MD25Q64_Handle *handle);
 
+/* ============================================================================
+ * Function Prototypes - Asynchronous Operations
+ * ============================================================================ */
+
+/*
+ * Program and erase run as a queue of operations per handle. Start
+ * functions queue the operation and, if the chip is free, issue its first
+ * command at once. MD25Q64_Poll() then reads the WIP bit once per call,
+ * issues the next page of a write, completes the operation (callback) and
+ * starts the next one; call it from a timer or scheduler tick. The
+ * blocking program/erase functions above are the same operations followed
+ * by a wait; reads are queued the same way. Status register writes,
+ * power-down and reset first wait for the queue to drain.
+ *
+ * Data phases of MD25Q64_DMA_THRESHOLD bytes or more (page program data,
+ * read data) run on the SPI's DMA streams when both hdmatx and hdmarx are
+ * linked; command bytes stay polled. The CPU is free until the DMA
+ * interrupt, which releases CS; the operation then continues on the next
+ * Poll. Forward the HAL SPI Tx/Rx complete and error callbacks to
+ * MD25Q64_DMA_Complete() / MD25Q64_DMA_Error().
+ *
+ * A read that reaches the head of the queue while a sector or block erase
+ * is running suspends the erase (0x75), as long as it does not touch the
+ * block being erased. Further reads are served under the same suspend;
+ * anything else resumes the erase (0x7A) first. Chip erase is never
+ * suspended.
+ * Main-loop context only (not from interrupts).
+ */
+
+/**
+ * @brief  Queue an operation
+ * @param  handle: Flash handle pointer
+ * @param  op: Operation, copied (op->data is not)
+ * @retval MD25Q64_OK, MD25Q64_INVALID_PARAM, or MD25Q64_BUSY if the queue is full
+ */
+MD25Q64_Status MD25Q64_Submit(MD25Q64_Handle *handle, const MD25Q64_Op *op);
+
+MD25Q64_Status MD25Q64_PageProgram_Start(MD25Q64_Handle *handle, uint32_t address,
+                                          const uint8_t *data, uint32_t size,
+                                          MD25Q64_Callback callback, void *ctx);
+MD25Q64_Status MD25Q64_Write_Start(MD25Q64_Handle *handle, uint32_t address,
+                                    const uint8_t *data, uint32_t size,
+                                    MD25Q64_Callback callback, void *ctx);
+MD25Q64_Status MD25Q64_EraseSector_Start(MD25Q64_Handle *handle, uint32_t address,
+                                          MD25Q64_Callback callback, void *ctx);
+MD25Q64_Status MD25Q64_EraseBlock32K_Start(MD25Q64_Handle *handle, uint32_t address,
+                                            MD25Q64_Callback callback, void *ctx);
+MD25Q64_Status MD25Q64_EraseBlock64K_Start(MD25Q64_Handle *handle, uint32_t address,
+                                            MD25Q64_Callback callback, void *ctx);
+MD25Q64_Status MD25Q64_EraseChip_Start(MD25Q64_Handle *handle,
+                                        MD25Q64_Callback callback, void *ctx);
+MD25Q64_Status MD25Q64_Read_Start(MD25Q64_Handle *handle, uint32_t address,
+                                   uint8_t *data, uint32_t size,
+                                   MD25Q64_Callback callback, void *ctx);
+MD25Q64_Status MD25Q64_FastRead_Start(MD25Q64_Handle *handle, uint32_t address,
+                                       uint8_t *data, uint32_t size,
+                                       MD25Q64_Callback callback, void *ctx);
+
+/**
+ * @brief  DMA data phase finished / failed (call from HAL SPI callbacks)
+ * @param  hspi: SPI handle passed to the HAL callback
+ * @note   Ignores transfers that were not started by this driver.
+ */
+void MD25Q64_DMA_Complete(SPI_HandleTypeDef *hspi);
+void MD25Q64_DMA_Error(SPI_HandleTypeDef *hspi);
+
+/**
+ * @brief  Advance the operation queue (non-blocking)
+ * @param  handle: Flash handle pointer
+ * @retval MD25Q64_OK when idle, MD25Q64_BUSY while operations are pending
+ */
+MD25Q64_Status MD25Q64_Poll(MD25Q64_Handle *handle);
+
+/**
+ * @brief  Check for pending operations
+ * @retval 1: Queue empty and no operation active, 0: otherwise
+ */
+uint8_t MD25Q64_IsIdle(const MD25Q64_Handle *handle);
+
+/**
+ * @brief  Block until every queued operation has completed
+ * @param  handle: Flash handle pointer
+ * @retval MD25Q64_OK, or MD25Q64_BUSY when called from a completion callback
+ * @note   Each operation has its own timeout, so this always returns.
+ */
+MD25Q64_Status MD25Q64_Flush(MD25Q64_Handle *handle);
+
 /* ============================================================================
  * Function Prototypes - Power Management
  * ============================================================================ */
@@ -429,6 +609,23 @@ MD25Q64_Status MD25Q64_UnlockAll(MD25Q64_Handle *handle);
  */
 MD25Q64_Status MD25Q64_LockAll(MD25Q64_Handle *handle);
 
+/* ============================================================================
+ * Function Prototypes - Self-Check
+ * ============================================================================ */
+
+/**
+ * @brief  Check the chip with read commands only
+ * @param  handle: Flash handle pointer
+ * @param  info: Output JEDEC ID and status registers (may be NULL)
+ * @note   Sends no write enable, erase or program, so it is safe on every
+ *         boot; four short transactions, a few tens of microseconds.
+ * @retval MD25Q64_OK
+ *         MD25Q64_ERROR: bus error or not an MD25Q64
+ *         MD25Q64_BUSY: an erase/program outlived the MCU reset
+ *         MD25Q64_WRITE_PROTECTED: block protect or SR lock bits set
+ */
+MD25Q64_Status MD25Q64_SelfCheck(MD25Q64_Handle *handle, MD25Q64_Info *info);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,290 @@
+/**
+ * @file    md25q64_bench.c
+ * @brief   MD25Q64 benchmark implementation
+ */
+
+#include "md25q64_bench.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ============================================================================
+ * Private Types
+ * ============================================================================ */
+typedef enum {
+    BENCH_READ = 0,
+    BENCH_FAST_READ,
+    BENCH_PROGRAM,
+    BENCH_WRITE,
+    BENCH_ERASE_4K,
+    BENCH_ERASE_32K,
+    BENCH_ERASE_64K
+} Bench_Op;
+
+static const char *const bench_op_name[] = {
+    "read", "fast_read", "program", "write", "erase_4k", "erase_32k", "erase_64k"
+};
+
+typedef struct {
+    MD25Q64_Handle *flash;
+    const MD25Q64_BenchPort *port;
+    uint32_t base;
+    uint8_t trials;
+    uint8_t *buf;
+    uint32_t buf_size;
+    uint32_t next_page;             /* Next erased page for programs */
+    volatile uint8_t done;
+    MD25Q64_Status status;
+    uint32_t end;                   /* Cycle count at completion */
+    uint32_t samples[MD25Q64_BENCH_TRIALS_MAX];
+    char line[128];
+} Bench;
+
+/* ============================================================================
+ * Private Helpers
+ * ============================================================================ */
+
+static void Bench_Done(MD25Q64_Handle *handle, MD25Q64_Status status, void *ctx)
+{
+    Bench *b = (Bench *)ctx;
+
+    (void)handle;
+    b->end = b->port->cycles();
+    b->status = status;
+    b->done = 1;
+}
+
+static MD25Q64_Status Bench_Start(Bench *b, Bench_Op op, uint32_t addr, uint32_t size)
+{
+    MD25Q64_Handle *h = b->flash;
+
+    switch (op) {
+    case BENCH_READ:      return MD25Q64_Read_Start(h, addr, b->buf, size, Bench_Done, b);
+    case BENCH_FAST_READ: return MD25Q64_FastRead_Start(h, addr, b->buf, size, Bench_Done, b);
+    case BENCH_PROGRAM:   return MD25Q64_PageProgram_Start(h, addr, b->buf, size, Bench_Done, b);
+    case BENCH_WRITE:     return MD25Q64_Write_Start(h, addr, b->buf, size, Bench_Done, b);
+    case BENCH_ERASE_4K:  return MD25Q64_EraseSector_Start(h, addr, Bench_Done, b);
+    case BENCH_ERASE_32K: return MD25Q64_EraseBlock32K_Start(h, addr, Bench_Done, b);
+    default:              return MD25Q64_EraseBlock64K_Start(h, addr, Bench_Done, b);
+    }
+}
+
+/* Run one operation to completion; *cycles from submit to callback */
+static MD25Q64_Status Bench_Time(Bench *b, Bench_Op op, uint32_t addr, uint32_t size,
+                                 uint32_t *cycles)
+{
+    uint32_t start;
+    MD25Q64_Status st;
+
+    b->done = 0;
+    start = b->port->cycles();
+    st = Bench_Start(b, op, addr, size);
+    if (st != MD25Q64_OK) {
+        return st;
+    }
+    while (!b->done) {
+        MD25Q64_Poll(b->flash);
+    }
+    if (cycles != NULL) {
+        *cycles = b->end - start;
+    }
+    return b->status;
+}
+
+/* Page-aligned address of `pages` erased pages in the scratch block */
+static MD25Q64_Status Bench_Fresh(Bench *b, uint32_t pages, uint32_t *addr)
+{
+    const uint32_t per_sector = MD25Q64_SECTOR_SIZE / MD25Q64_PAGE_SIZE;
+    const uint32_t total = MD25Q64_BENCH_AREA / MD25Q64_PAGE_SIZE;
+    MD25Q64_Status st;
+
+    if (b->next_page % per_sector + pages > per_sector) {
+        b->next_page += per_sector - b->next_page % per_sector;
+    }
+    if (b->next_page >= total) {
+        b->next_page = 0;
+    }
+    if (b->next_page % per_sector == 0) {
+        st = Bench_Time(b, BENCH_ERASE_4K, b->base + b->next_page * MD25Q64_PAGE_SIZE, 0, NULL);
+        if (st != MD25Q64_OK) {
+            return st;
+        }
+    }
+    *addr = b->base + b->next_page * MD25Q64_PAGE_SIZE;
+    b->next_page += pages;
+    return MD25Q64_OK;
+}
+
+static uint64_t Bench_Ns(const Bench *b, uint32_t cycles)
+{
+    return (uint64_t)cycles * 1000u / b->port->cycles_per_us;
+}
+
+/* Sort the samples and print one CSV line */
+static void Bench_Report(Bench *b, Bench_Op op, uint32_t size, uint32_t offset, uint32_t chunk)
+{
+    uint32_t *s = b->samples;
+    uint8_t n = b->trials, i, j;
+    uint64_t median_ns, kib_s;
+
+    for (i = 1; i < n; i++) {
+        uint32_t v = s[i];
+        for (j = i; j > 0 && s[j - 1u] > v; j--) {
+            s[j] = s[j - 1u];
+        }
+        s[j] = v;
+    }
+
+    median_ns = Bench_Ns(b, s[(n - 1u) / 2u]);
+    kib_s = (size > 0 && median_ns > 0) ?
+            (uint64_t)size * 1000000000u / median_ns / 1024u : 0;
+
+    /* p99 by nearest rank, ceil(0.99 n): the maximum below 100 trials */
+    snprintf(b->line, sizeof(b->line), "%s,%lu,%lu,%lu,%u,%lu,%lu,%lu,%lu",
+             bench_op_name[op], (unsigned long)size, (unsigned long)offset,
+             (unsigned long)chunk, n,
+             (unsigned long)Bench_Ns(b, s[0]), (unsigned long)median_ns,
+             (unsigned long)Bench_Ns(b, s[(99u * n + 99u) / 100u - 1u]),
+             (unsigned long)kib_s);
+    b->port->print(b->port->ctx, b->line);
+}
+
+static MD25Q64_Status Bench_Reads(Bench *b, Bench_Op op)
+{
+    uint32_t size, done, chunk, cycles;
+    uint8_t t;
+    MD25Q64_Status st;
+
+    for (size = 1; size <= MD25Q64_BENCH_READ_MAX; size *= 4u) {
+        chunk = (size < b->buf_size) ? size : b->buf_size;
+        for (t = 0; t < b->trials; t++) {
+            b->samples[t] = 0;
+            for (done = 0; done < size; done += chunk) {
+                st = Bench_Time(b, op, b->base + done, chunk, &cycles);
+                if (st != MD25Q64_OK) {
+                    return st;
+                }
+                b->samples[t] += cycles;
+            }
+        }
+        Bench_Report(b, op, size, 0, chunk);
+    }
+    return MD25Q64_OK;
+}
+
+static MD25Q64_Status Bench_Programs(Bench *b)
+{
+    static const uint16_t sizes[] = {1, 16, 64, 128, 256};
+    static const uint16_t offsets[] = {0, 64, 128, 255};
+    uint32_t addr;
+    uint8_t i, t;
+    MD25Q64_Status st;
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        for (t = 0; t < b->trials; t++) {
+            if ((st = Bench_Fresh(b, 1, &addr)) != MD25Q64_OK ||
+                (st = Bench_Time(b, BENCH_PROGRAM, addr, sizes[i], &b->samples[t])) != MD25Q64_OK) {
+                return st;
+            }
+        }
+        Bench_Report(b, BENCH_PROGRAM, sizes[i], 0, sizes[i]);
+    }
+
+    for (i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+        for (t = 0; t < b->trials; t++) {
+            if ((st = Bench_Fresh(b, 2, &addr)) != MD25Q64_OK ||
+                (st = Bench_Time(b, BENCH_WRITE, addr + offsets[i], MD25Q64_PAGE_SIZE,
+                                 &b->samples[t])) != MD25Q64_OK) {
+                return st;
+            }
+        }
+        Bench_Report(b, BENCH_WRITE, MD25Q64_PAGE_SIZE, offsets[i],
+                     (offsets[i] > MD25Q64_PAGE_SIZE / 2u) ? offsets[i] : MD25Q64_PAGE_SIZE - offsets[i]);
+    }
+    return MD25Q64_OK;
+}
+
+static MD25Q64_Status Bench_Erases(Bench *b)
+{
+    static const struct {
+        Bench_Op op;
+        uint32_t size;
+    } erases[] = {
+        {BENCH_ERASE_4K,  MD25Q64_SECTOR_SIZE},
+        {BENCH_ERASE_32K, MD25Q64_BLOCK_32K_SIZE},
+        {BENCH_ERASE_64K, MD25Q64_BLOCK_64K_SIZE}
+    };
+    uint8_t i, t;
+    MD25Q64_Status st;
+
+    for (i = 0; i < sizeof(erases) / sizeof(erases[0]); i++) {
+        for (t = 0; t < b->trials; t++) {
+            /* Walk the block so no single sector takes every erase */
+            uint32_t addr = b->base + (t * erases[i].size) % MD25Q64_BENCH_AREA;
+
+            st = Bench_Time(b, erases[i].op, addr, 0, &b->samples[t]);
+            if (st != MD25Q64_OK) {
+                return st;
+            }
+        }
+        Bench_Report(b, erases[i].op, erases[i].size, 0, 0);
+    }
+    b->next_page = 0;               /* Block is blank again */
+    return MD25Q64_OK;
+}
+
+/* ============================================================================
+ * Public Functions
+ * ============================================================================ */
+
+MD25Q64_Status MD25Q64_Bench_Run(MD25Q64_Handle *handle, const MD25Q64_BenchPort *port,
+                                 uint32_t base, uint8_t trials,
+                                 uint8_t *buf, uint32_t buf_size)
+{
+    static Bench b;                 /* Sample table and line buffer off the stack */
+    MD25Q64_Status st;
+    uint32_t i;
+
+    if (handle == NULL || port == NULL || port->cycles == NULL || port->print == NULL ||
+        port->cycles_per_us == 0 || buf == NULL || buf_size < 2u * MD25Q64_PAGE_SIZE ||
+        base % MD25Q64_BENCH_AREA != 0 || base + MD25Q64_BENCH_AREA > MD25Q64_FLASH_SIZE ||
+        trials == 0 || trials > MD25Q64_BENCH_TRIALS_MAX || !MD25Q64_IsIdle(handle)) {
+        return MD25Q64_INVALID_PARAM;
+    }
+
+    memset(&b, 0, sizeof(b));
+    b.flash = handle;
+    b.port = port;
+    b.base = base;
+    b.trials = trials;
+    b.buf = buf;
+    b.buf_size = buf_size;
+    b.next_page = 0;
+
+    snprintf(b.line, sizeof(b.line), "# md25q64 bench: block 0x%06lX, %u trials, %lu cycles/us, DMA %s",
+             (unsigned long)base, trials, (unsigned long)port->cycles_per_us,
+             (handle->hspi->hdmatx != NULL && handle->hspi->hdmarx != NULL) ? "on" : "off");
+    port->print(port->ctx, b.line);
+    port->print(port->ctx, "op,size,offset,chunk,trials,min_ns,median_ns,p99_ns,kib_s");
+
+    /* Reads see a known pattern rather than whatever the block held */
+    for (i = 0; i < buf_size; i++) {
+        buf[i] = (uint8_t)(i * 7u + 1u);
+    }
+    if ((st = Bench_Programs(&b)) != MD25Q64_OK ||
+        (st = Bench_Erases(&b)) != MD25Q64_OK) {
+        return st;
+    }
+    for (i = 0; i < MD25Q64_BENCH_AREA; i += buf_size) {
+        uint32_t n = (MD25Q64_BENCH_AREA - i < buf_size) ? MD25Q64_BENCH_AREA - i : buf_size;
+        if ((st = Bench_Time(&b, BENCH_WRITE, base + i, n, NULL)) != MD25Q64_OK) {
+            return st;
+        }
+    }
+    if ((st = Bench_Reads(&b, BENCH_READ)) != MD25Q64_OK ||
+        (st = Bench_Reads(&b, BENCH_FAST_READ)) != MD25Q64_OK) {
+        return st;
+    }
+
+    port->print(port->ctx, "# done");
+    return MD25Q64_OK;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file    md25q64_bench.h
+ * @brief   MD25Q64 latency / throughput benchmark with CSV output
+ * @details Times driver operations with a free-running cycle counter (DWT
+ *          CYCCNT on the target, the emulator clock on a host build), so
+ *          microsecond reads resolve instead of rounding to HAL_GetTick()
+ *          milliseconds. Operations go through the asynchronous API with
+ *          Poll spinning: the blocking calls sleep 1 ms between status
+ *          polls, which would quantize program and erase times as well.
+ *
+ *          Every point runs `trials` times and prints one CSV line:
+ *            op,size,offset,chunk,trials,min_ns,median_ns,p99_ns,kib_s
+ *          offset is the page offset, chunk the largest single transfer
+ *          (reads longer than the caller's buffer run as back-to-back chunk
+ *          reads), kib_s the throughput at the median. Lines starting with
+ *          '#' describe the setup.
+ *
+ *          Sweep:
+ *            read, fast_read      1 B .. 64 KB, x4 steps
+ *            program              1 .. 256 B at page offset 0 (one PageProgram)
+ *            write                256 B at page offsets 0, 64, 128, 255
+ *                                 (Write splits at the page boundary)
+ *            erase_4k, erase_32k, erase_64k
+ *          Programs go to freshly erased pages; those erases are not timed.
+ *
+ *          Uses one 64 KB block and destroys its contents. The driver must
+ *          have nothing else queued.
+ */
+
+#ifndef __MD25Q64_BENCH_H__
+#define __MD25Q64_BENCH_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "md25q64.h"
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+#define MD25Q64_BENCH_AREA          MD25Q64_BLOCK_64K_SIZE  /* Scratch, 64 KB aligned */
+#define MD25Q64_BENCH_TRIALS_MAX    32
+#define MD25Q64_BENCH_READ_MAX      (64u * 1024u)           /* Largest read point */
+
+/* ============================================================================
+ * Port
+ * ============================================================================ */
+typedef struct {
+    uint32_t (*cycles)(void);                       /* Free-running, wraps */
+    uint32_t cycles_per_us;
+    void (*print)(void *ctx, const char *line);     /* One line, no ending */
+    void *ctx;
+} MD25Q64_BenchPort;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief  Run the whole sweep and print the results
+ * @param  base: Scratch block address (multiple of MD25Q64_BENCH_AREA)
+ * @param  trials: Runs per point, 1 .. MD25Q64_BENCH_TRIALS_MAX
+ * @param  buf: Transfer buffer, at least MD25Q64_PAGE_SIZE * 2 bytes;
+ *              reads above buf_size are split into buf_size chunks
+ * @retval MD25Q64_OK, MD25Q64_INVALID_PARAM, or the first failed
+ *         operation's status (the sweep stops there)
+ */
+MD25Q64_Status MD25Q64_Bench_Run(MD25Q64_Handle *handle, const MD25Q64_BenchPort *port,
+                                 uint32_t base, uint8_t trials,
+                                 uint8_t *buf, uint32_t buf_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MD25Q64_BENCH_H__ */
@@ -0,0 +1,94 @@
+/**
+ * @file    md25q64_cache.c
+ * @brief   SRAM read cache implementation
+ */
+
+#include "md25q64_cache.h"
+#include <stddef.h>
+#include <string.h>
+
+/* ============================================================================
+ * Public Functions
+ * ============================================================================ */
+
+void MD25Q64_Cache_Init(MD25Q64_Cache *cache, MD25Q64_CacheLine *lines, uint16_t count)
+{
+    uint16_t i;
+
+    memset(cache, 0, sizeof(*cache));
+    cache->lines = lines;
+    cache->count = (lines != NULL) ? count : 0;
+    cache->last_miss = MD25Q64_CACHE_EMPTY;
+    for (i = 0; i < cache->count; i++) {
+        lines[i].addr = MD25Q64_CACHE_EMPTY;
+        lines[i].ref = 0;
+    }
+}
+
+const uint8_t *MD25Q64_Cache_Lookup(MD25Q64_Cache *cache, uint32_t line_addr)
+{
+    uint16_t i;
+
+    for (i = 0; i < cache->count; i++) {
+        if (cache->lines[i].addr == line_addr) {
+            cache->lines[i].ref = 1;
+            cache->stats.hits++;
+            return cache->lines[i].data;
+        }
+    }
+    cache->stats.misses++;
+    return NULL;
+}
+
+MD25Q64_CacheLine *MD25Q64_Cache_Alloc(MD25Q64_Cache *cache)
+{
+    MD25Q64_CacheLine *line;
+
+    if (cache->count == 0) {
+        return NULL;
+    }
+
+    /* CLOCK: give referenced lines a second chance; ends within two turns */
+    for (;;) {
+        line = &cache->lines[cache->hand];
+        cache->hand = (uint16_t)((cache->hand + 1u) % cache->count);
+        if (line->addr == MD25Q64_CACHE_EMPTY || !line->ref) {
+            break;
+        }
+        line->ref = 0;
+    }
+    line->addr = MD25Q64_CACHE_EMPTY;
+    return line;
+}
+
+void MD25Q64_Cache_Commit(MD25Q64_Cache *cache, MD25Q64_CacheLine *line,
+                          uint32_t line_addr, uint32_t gen)
+{
+    if (gen != cache->gen) {
+        return;                     /* A program/erase was queued meanwhile */
+    }
+    line->addr = line_addr;
+    line->ref = 0;
+}
+
+void MD25Q64_Cache_Invalidate(MD25Q64_Cache *cache, uint32_t address, uint32_t size)
+{
+    uint32_t first, last;
+    uint16_t i;
+
+    if (cache == NULL || size == 0) {
+        return;
+    }
+    cache->gen++;
+
+    first = address & ~(uint32_t)(MD25Q64_CACHE_LINE - 1);
+    last = (address + size - 1u) & ~(uint32_t)(MD25Q64_CACHE_LINE - 1);
+    for (i = 0; i < cache->count; i++) {
+        uint32_t a = cache->lines[i].addr;
+
+        if (a != MD25Q64_CACHE_EMPTY && a >= first && a <= last) {
+            cache->lines[i].addr = MD25Q64_CACHE_EMPTY;
+            cache->stats.invalidated++;
+        }
+    }
+}
@@ -0,0 +1,109 @@
+/**
+ * @file    md25q64_cache.h
+ * @brief   SRAM read cache for the MD25Q64 driver
+ * @details Keeps recently read flash lines (MD25Q64_CACHE_LINE bytes, line
+ *          aligned) in RAM. Attached to a handle with MD25Q64_SetCache(),
+ *          it serves the blocking MD25Q64_Read() / MD25Q64_FastRead():
+ *          a read of up to MD25Q64_CACHE_BYPASS lines is assembled from
+ *          cached lines, and each missing line is fetched whole. Longer
+ *          reads (dumps, scans) go straight to the chip and leave the cache
+ *          alone, and so does the first miss in a 4 KB sector: a mount scan
+ *          reading one header per sector would otherwise fetch a whole line
+ *          for every few bytes. Asynchronous reads are never cached.
+ *
+ *          Eviction is CLOCK: a hit sets the line's reference bit, and the
+ *          hand clears bits until it finds a line without one.
+ *
+ *          Coherence: MD25Q64_Submit() drops every line a program or erase
+ *          touches when the operation is queued, so a later read misses and
+ *          waits behind it in the queue. A fetch that overlaps an
+ *          invalidation is not kept. A write-back buffer above the driver
+ *          (md25q64_wbuf) overlays its unflushed bytes on whatever the
+ *          read returns, and its flush invalidates like any program.
+ *          Writes through another handle on the same chip bypass all of
+ *          this: call MD25Q64_Cache_Invalidate() after them.
+ *
+ *          A cache of zero lines is valid and passes every read through.
+ */
+
+#ifndef __MD25Q64_CACHE_H__
+#define __MD25Q64_CACHE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+#define MD25Q64_CACHE_LINE      256             /* Page (256) or sector (4096) */
+#define MD25Q64_CACHE_BYPASS    4               /* Reads over this many lines skip the cache */
+#define MD25Q64_CACHE_EMPTY     0xFFFFFFFFu     /* Line holds nothing */
+
+/* ============================================================================
+ * Cache State
+ * ============================================================================ */
+typedef struct {
+    uint32_t addr;                  /* Line address, or MD25Q64_CACHE_EMPTY */
+    uint8_t ref;                    /* CLOCK reference bit */
+    uint8_t data[MD25Q64_CACHE_LINE];
+} MD25Q64_CacheLine;
+
+typedef struct {
+    uint32_t hits;                  /* Lines served from RAM */
+    uint32_t misses;                /* Lines fetched */
+    uint32_t bypass;                /* Reads too long to cache */
+    uint32_t invalidated;           /* Lines dropped by programs/erases */
+    uint32_t read_bytes;            /* Bytes asked for by callers */
+    uint32_t spi_bytes;             /* Bytes actually read from the chip */
+} MD25Q64_CacheStats;
+
+typedef struct {
+    MD25Q64_CacheLine *lines;
+    uint16_t count;
+    uint16_t hand;
+    uint32_t gen;                   /* Bumped by every invalidation */
+    uint32_t last_miss;             /* Line address of the previous miss */
+    MD25Q64_CacheStats stats;
+} MD25Q64_Cache;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief  Set up an empty cache over caller-owned lines
+ * @param  lines: count entries (may be NULL when count is 0)
+ */
+void MD25Q64_Cache_Init(MD25Q64_Cache *cache, MD25Q64_CacheLine *lines, uint16_t count);
+
+/**
+ * @brief  Cached copy of the line at line_addr, or NULL
+ * @note   Counts a hit or a miss and sets the reference bit on a hit
+ */
+const uint8_t *MD25Q64_Cache_Lookup(MD25Q64_Cache *cache, uint32_t line_addr);
+
+/**
+ * @brief  Pick a line to fetch into (CLOCK victim), or NULL with no lines
+ * @note   The line is marked empty until MD25Q64_Cache_Commit()
+ */
+MD25Q64_CacheLine *MD25Q64_Cache_Alloc(MD25Q64_Cache *cache);
+
+/**
+ * @brief  Keep a fetched line, unless an invalidation ran since gen was read
+ */
+void MD25Q64_Cache_Commit(MD25Q64_Cache *cache, MD25Q64_CacheLine *line,
+                          uint32_t line_addr, uint32_t gen);
+
+/**
+ * @brief  Drop every line overlapping [address, address + size)
+ */
+void MD25Q64_Cache_Invalidate(MD25Q64_Cache *cache, uint32_t address, uint32_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MD25Q64_CACHE_H__ */
@@ -0,0 +1,262 @@
+/**
+ * @file    md25q64_erase.c
+ * @brief   Range erase planner implementation
+ */
+
+#include "md25q64_erase.h"
+#include <string.h>
+
+#define ERASE_WINDOW_SECTORS    (MD25Q64_BLOCK_64K_SIZE / MD25Q64_SECTOR_SIZE)
+#define ERASE_HALF_SECTORS      (MD25Q64_BLOCK_32K_SIZE / MD25Q64_SECTOR_SIZE)
+#define ERASE_HALF_MASK         0x00FFu
+
+static void Erase_Done(MD25Q64_Handle *handle, MD25Q64_Status status, void *ctx);
+static void Erase_CheckDone(MD25Q64_Handle *handle, MD25Q64_Status status, void *ctx);
+
+/* ============================================================================
+ * Private Helpers
+ * ============================================================================ */
+
+static uint8_t Erase_Count(uint16_t mask)
+{
+    uint8_t n = 0;
+
+    while (mask) {
+        mask &= (uint16_t)(mask - 1u);
+        n++;
+    }
+    return n;
+}
+
+static uint8_t Erase_Lowest(uint16_t mask)
+{
+    uint8_t i = 0;
+
+    while (!(mask & 1u)) {
+        mask >>= 1;
+        i++;
+    }
+    return i;
+}
+
+/* Sectors of the current window that lie inside the range */
+static void Erase_WindowInit(MD25Q64_EraseJob *job, uint32_t start)
+{
+    uint32_t lo = (start > job->window) ? start : job->window;
+    uint32_t hi = (job->end < job->window + MD25Q64_BLOCK_64K_SIZE) ?
+                  job->end : job->window + MD25Q64_BLOCK_64K_SIZE;
+    uint8_t first = (uint8_t)((lo - job->window) / MD25Q64_SECTOR_SIZE);
+    uint8_t count = (uint8_t)((hi - lo) / MD25Q64_SECTOR_SIZE);
+
+    job->want = (uint16_t)(((1u << count) - 1u) << first);
+    job->todo = job->want;
+    job->checking = job->skip_blank;
+    job->sector = 0;
+    job->offset = 0;
+    job->plan_64k = 0;
+    job->plan_32k = 0;
+    job->plan_4k = 0;
+}
+
+/*
+ * Cheapest cover of job->todo by erases inside job->want. A 32K half is
+ * only used when the whole half is in the range, 64K only for the whole
+ * window; blank sectors inside a big erase are simply erased again.
+ */
+static void Erase_Plan(MD25Q64_EraseJob *job)
+{
+    uint32_t cost[2], total;
+    uint8_t h;
+
+    for (h = 0; h < 2u; h++) {
+        uint8_t shift = (uint8_t)(h * ERASE_HALF_SECTORS);
+        uint16_t todo = (uint16_t)((job->todo >> shift) & ERASE_HALF_MASK);
+        uint16_t want = (uint16_t)((job->want >> shift) & ERASE_HALF_MASK);
+
+        cost[h] = Erase_Count(todo) * (uint32_t)MD25Q64_ERASE_TYP_4K_MS;
+        if (want == ERASE_HALF_MASK && todo != 0 && cost[h] > MD25Q64_ERASE_TYP_32K_MS) {
+            cost[h] = MD25Q64_ERASE_TYP_32K_MS;
+            job->plan_32k |= (uint8_t)(1u << h);
+        } else {
+            job->plan_4k |= (uint16_t)(todo << shift);
+        }
+    }
+
+    total = cost[0] + cost[1];
+    if (job->want == 0xFFFFu && total > MD25Q64_ERASE_TYP_64K_MS) {
+        total = MD25Q64_ERASE_TYP_64K_MS;
+        job->plan_64k = 1;
+        job->plan_32k = 0;
+        job->plan_4k = 0;
+    }
+    job->report.planned_ms += total;
+}
+
+static void Erase_Finish(MD25Q64_EraseJob *job, MD25Q64_Status status)
+{
+    job->report.actual_ms = HAL_GetTick() - job->start_tick;
+    job->status = status;
+    job->done = 1;
+    if (job->callback != NULL) {
+        job->callback(job->flash, status, job->ctx);
+    }
+}
+
+/*
+ * Queue the job's next operation: a check read, or the window's next
+ * erase. Windows with nothing to erase are passed over here.
+ * Returns MD25Q64_OK with job->done set once the range is finished.
+ */
+static MD25Q64_Status Erase_Step(MD25Q64_EraseJob *job)
+{
+    MD25Q64_Handle *h = job->flash;
+    uint32_t addr;
+    uint8_t i;
+
+    for (;;) {
+        if (job->checking) {
+            while (job->sector < ERASE_WINDOW_SECTORS && !(job->want & (1u << job->sector))) {
+                job->sector++;
+            }
+            if (job->sector < ERASE_WINDOW_SECTORS) {
+                addr = job->window + job->sector * (uint32_t)MD25Q64_SECTOR_SIZE + job->offset;
+                return MD25Q64_FastRead_Start(h, addr, job->buf, MD25Q64_ERASE_CHECK,
+                                              Erase_CheckDone, job);
+            }
+            job->checking = 0;
+            Erase_Plan(job);
+        }
+
+        if (job->plan_64k) {
+            job->plan_64k = 0;
+            job->report.erases_64k++;
+            return MD25Q64_EraseBlock64K_Start(h, job->window, Erase_Done, job);
+        }
+        if (job->plan_32k) {
+            i = Erase_Lowest(job->plan_32k);
+            job->plan_32k &= (uint8_t)~(1u << i);
+            job->report.erases_32k++;
+            return MD25Q64_EraseBlock32K_Start(h, job->window + i * (uint32_t)MD25Q64_BLOCK_32K_SIZE,
+                                               Erase_Done, job);
+        }
+        if (job->plan_4k) {
+            i = Erase_Lowest(job->plan_4k);
+            job->plan_4k &= (uint16_t)~(1u << i);
+            job->report.erases_4k++;
+            return MD25Q64_EraseSector_Start(h, job->window + i * (uint32_t)MD25Q64_SECTOR_SIZE,
+                                             Erase_Done, job);
+        }
+
+        job->window += MD25Q64_BLOCK_64K_SIZE;
+        if (job->window >= job->end) {
+            Erase_Finish(job, MD25Q64_OK);
+            return MD25Q64_OK;
+        }
+        Erase_WindowInit(job, job->window);
+        if (!job->checking) {
+            Erase_Plan(job);
+        }
+    }
+}
+
+static void Erase_Next(MD25Q64_EraseJob *job, MD25Q64_Status status)
+{
+    if (status == MD25Q64_OK) {
+        status = Erase_Step(job);
+    }
+    if (status != MD25Q64_OK && !job->done) {
+        Erase_Finish(job, status);
+    }
+}
+
+static void Erase_Done(MD25Q64_Handle *handle, MD25Q64_Status status, void *ctx)
+{
+    (void)handle;
+    Erase_Next((MD25Q64_EraseJob *)ctx, status);
+}
+
+static void Erase_CheckDone(MD25Q64_Handle *handle, MD25Q64_Status status, void *ctx)
+{
+    MD25Q64_EraseJob *job = (MD25Q64_EraseJob *)ctx;
+    uint16_t i;
+
+    (void)handle;
+    if (status == MD25Q64_OK) {
+        for (i = 0; i < MD25Q64_ERASE_CHECK && job->buf[i] == 0xFF; i++) {
+        }
+        if (i < MD25Q64_ERASE_CHECK) {
+            job->sector++;                      /* Programmed: stays in todo */
+            job->offset = 0;
+        } else if ((job->offset += MD25Q64_ERASE_CHECK) >= MD25Q64_SECTOR_SIZE) {
+            job->todo &= (uint16_t)~(1u << job->sector);
+            job->report.skipped++;
+            job->sector++;
+            job->offset = 0;
+        }
+    }
+    Erase_Next(job, status);
+}
+
+/* ============================================================================
+ * Public Functions
+ * ============================================================================ */
+
+MD25Q64_Status MD25Q64_EraseRange_Start(MD25Q64_EraseJob *job, MD25Q64_Handle *handle,
+                                        uint32_t address, uint32_t length, uint8_t skip_blank,
+                                        MD25Q64_Callback callback, void *ctx)
+{
+    MD25Q64_Status st;
+
+    if (job == NULL || handle == NULL || length == 0 ||
+        address % MD25Q64_SECTOR_SIZE != 0 || length % MD25Q64_SECTOR_SIZE != 0 ||
+        address > MD25Q64_FLASH_SIZE || length > MD25Q64_FLASH_SIZE - address) {
+        return MD25Q64_INVALID_PARAM;
+    }
+
+    memset(job, 0, sizeof(*job));
+    job->flash = handle;
+    job->end = address + length;
+    job->window = address & ~(uint32_t)(MD25Q64_BLOCK_64K_SIZE - 1u);
+    job->skip_blank = skip_blank ? 1u : 0u;
+    job->callback = callback;
+    job->ctx = ctx;
+    job->start_tick = HAL_GetTick();
+    job->report.sectors = (uint16_t)(length / MD25Q64_SECTOR_SIZE);
+    job->report.naive_ms = job->report.sectors * (uint32_t)MD25Q64_ERASE_TYP_4K_MS;
+
+    Erase_WindowInit(job, address);
+    if (!job->checking) {
+        Erase_Plan(job);
+    }
+
+    /* The first window always queues a read or an erase */
+    st = Erase_Step(job);
+    if (st != MD25Q64_OK) {
+        job->status = st;
+        job->done = 1;
+    }
+    return st;
+}
+
+MD25Q64_Status MD25Q64_EraseRange(MD25Q64_Handle *handle, uint32_t address, uint32_t length,
+                                  uint8_t skip_blank, MD25Q64_EraseReport *report)
+{
+    static MD25Q64_EraseJob job;        /* Check buffer off the stack */
+    MD25Q64_Status st;
+
+    st = MD25Q64_EraseRange_Start(&job, handle, address, length, skip_blank, NULL, NULL);
+    if (st == MD25Q64_OK) {
+        while (!job.done) {
+            MD25Q64_Poll(handle);
+        }
+        st = job.status;
+    }
+    if (report != NULL) {
+        if (st == MD25Q64_INVALID_PARAM) {
+            memset(report, 0, sizeof(*report));
+        } else {
+            *report = job.report;
+        }
+    }
+    return st;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file    md25q64_erase.h
+ * @brief   Range erase planner for the MD25Q64 driver
+ * @details Erases any sector-aligned range with the fewest chip-busy
+ *          milliseconds: one 64 KB block erase costs about as much as five
+ *          sector erases, so a range is cut into 64 KB windows and each
+ *          window gets the cheapest mix of 64K / 32K / 4K erases that
+ *          covers it, using only erases that lie fully inside the range.
+ *          Without a blank check that is the greedy largest-aligned split.
+ *
+ *          With skip_blank, each sector of a window is read first (fast
+ *          read, MD25Q64_ERASE_CHECK bytes at a time, stopping at the first
+ *          programmed byte). Blank sectors are left alone and the window's
+ *          plan covers only the rest, e.g. one dirty sector in an otherwise
+ *          blank block costs a 4K erase instead of a 64K one. A blank
+ *          sector takes about 2 ms to check at 21 MHz, a programmed one
+ *          microseconds.
+ *
+ *          The job runs on the driver queue: every check read and erase is
+ *          one queued operation, and its completion callback queues the
+ *          next, so MD25Q64_Poll() drives it like any other operation and
+ *          reads from other users go in between (and suspend erases).
+ *
+ *          The report compares the plan's typical time with the sector by
+ *          sector equivalent and with the measured start-to-finish time.
+ */
+
+#ifndef __MD25Q64_ERASE_H__
+#define __MD25Q64_ERASE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "md25q64.h"
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+#define MD25Q64_ERASE_CHECK         256     /* Blank check read size */
+#define MD25Q64_ERASE_TYP_4K_MS     60      /* Datasheet typicals, for planning */
+#define MD25Q64_ERASE_TYP_32K_MS    200
+#define MD25Q64_ERASE_TYP_64K_MS    300
+
+/* ============================================================================
+ * Job State
+ * ============================================================================ */
+typedef struct {
+    uint16_t erases_4k;             /* Erases issued */
+    uint16_t erases_32k;
+    uint16_t erases_64k;
+    uint16_t sectors;               /* Sectors in the range */
+    uint16_t skipped;               /* Sectors found blank and left alone */
+    uint32_t planned_ms;            /* Typical time of the erases issued */
+    uint32_t naive_ms;              /* Typical time erasing every sector */
+    uint32_t actual_ms;             /* Start to completion, checks included */
+} MD25Q64_EraseReport;
+
+typedef struct {
+    MD25Q64_Handle *flash;
+    uint32_t end;                   /* Range end, exclusive */
+    uint32_t window;                /* 64 KB window being worked on */
+    uint16_t want;                  /* Window sectors inside the range */
+    uint16_t todo;                  /* Sectors still to check / to erase */
+    uint8_t plan_64k;               /* Window plan, issued in order */
+    uint8_t plan_32k;               /* Bit per half */
+    uint16_t plan_4k;               /* Bit per sector */
+    uint8_t sector;                 /* Sector being checked */
+    uint16_t offset;                /* ...and the offset in it */
+    uint8_t skip_blank;
+    uint8_t checking;
+    volatile uint8_t done;
+    MD25Q64_Status status;
+    uint32_t start_tick;
+    MD25Q64_Callback callback;
+    void *ctx;
+    MD25Q64_EraseReport report;
+    uint8_t buf[MD25Q64_ERASE_CHECK];
+} MD25Q64_EraseJob;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief  Start erasing [address, address + length)
+ * @param  job: Job state, owned by the caller until the callback
+ * @param  address, length: Multiples of MD25Q64_SECTOR_SIZE
+ * @param  skip_blank: Check sectors first and leave blank ones alone
+ * @param  callback: Optional, called from MD25Q64_Poll() when done;
+ *                   job->report is final by then
+ * @note   Every step needs a free queue slot; a full queue ends the job
+ *         with MD25Q64_BUSY.
+ * @retval MD25Q64_OK, MD25Q64_INVALID_PARAM, or the first step's status
+ */
+MD25Q64_Status MD25Q64_EraseRange_Start(MD25Q64_EraseJob *job, MD25Q64_Handle *handle,
+                                        uint32_t address, uint32_t length, uint8_t skip_blank,
+                                        MD25Q64_Callback callback, void *ctx);
+
+/**
+ * @brief  Erase [address, address + length) and wait for it
+ * @param  report: Plan and timing (may be NULL)
+ * @note   Blocking; uses a static job, main-loop context only.
+ */
+MD25Q64_Status MD25Q64_EraseRange(MD25Q64_Handle *handle, uint32_t address, uint32_t length,
+                                  uint8_t skip_blank, MD25Q64_EraseReport *report);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MD25Q64_ERASE_H__ */
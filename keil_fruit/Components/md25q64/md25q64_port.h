@@ -0,0 +1,71 @@
+/**
+ * @file    md25q64_port.h
+ * @brief   HAL subset used by the MD25Q64 driver, for host builds
+ * @details On the target (USE_HAL_DRIVER) md25q64.h takes these from the
+ *          STM32 HAL via main.h. Without it md25q64.h includes this header,
+ *          so md25q64.c and the modules on top of it (flash_log) compile
+ *          unchanged. The host build links a SPI/GPIO shim implementing the
+ *          functions below: tools/flash_emu/spi_shim.c, on the file-backed
+ *          chip emulator tools/flash_emu/nor_emu.c.
+ */
+
+#ifndef __MD25Q64_PORT_H__
+#define __MD25Q64_PORT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* ============================================================================
+ * Types
+ * ============================================================================ */
+typedef enum {
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum {
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct {
+    uint32_t id;                    /* Shim-defined */
+} GPIO_TypeDef;
+
+typedef struct {
+    uint32_t id;                    /* Shim-defined */
+} DMA_HandleTypeDef;
+
+typedef struct {
+    void *Instance;                 /* Shim-defined bus */
+    DMA_HandleTypeDef *hdmatx;      /* NULL: transfers stay polled */
+    DMA_HandleTypeDef *hdmarx;
+} SPI_HandleTypeDef;
+
+/* ============================================================================
+ * Functions (provided by the host shim)
+ * ============================================================================ */
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+
+/* Complete by calling MD25Q64_DMA_Complete() / MD25Q64_DMA_Error() */
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_Receive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef *hspi);
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MD25Q64_PORT_H__ */
@@ -13,6 +13,8 @@
 
 #include "md25q64_test.h"
 #include "md25q64.h"
+#include "md25q64_bench.h"
+#include "md25q64_erase.h"
 #include "spi.h"
 #include "usart.h"
 #include "uart_app.h"
@@ -317,6 +319,60 @@ int MD25Q64_Test_ReadWrite(void)
     }
 }
 
+/* Completion flag for the DMA read in the speed test */
+static volatile int g_dma_done;
+static volatile MD25Q64_Status g_dma_status;
+
+static void dma_read_done(MD25Q64_Handle *handle, MD25Q64_Status status, void *ctx)
+{
+    (void)handle;
+    (void)ctx;
+    g_dma_status = status;
+    g_dma_done = 1;
+}
+
+/**
+ * @brief  Async fast read of SPEED_TEST_SIZE bytes, timed with the DWT counter
+ * @param  speed: Throughput in KB/s
+ * @param  free_pct: Share of the transfer time spent outside driver calls
+ * @retval 0 on success
+ * @note   Without linked SPI DMA the whole transfer runs inside Start, so
+ *         free_pct is close to 0.
+ */
+static int MD25Q64_Test_DmaRead(float *speed, uint32_t *free_pct)
+{
+    uint32_t t_start, t_call, total, busy;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    memset(g_speed_buf, 0, SPEED_TEST_SIZE);
+    g_dma_done = 0;
+
+    t_start = DWT->CYCCNT;
+    if (MD25Q64_FastRead_Start(&g_flash, 0x000000, g_speed_buf, SPEED_TEST_SIZE,
+                               dma_read_done, NULL) != MD25Q64_OK) {
+        return -1;
+    }
+    busy = DWT->CYCCNT - t_start;
+
+    while (!g_dma_done) {
+        t_call = DWT->CYCCNT;
+        MD25Q64_Poll(&g_flash);
+        busy += DWT->CYCCNT - t_call;
+    }
+    total = DWT->CYCCNT - t_start;
+
+    if (g_dma_status != MD25Q64_OK || total == 0) {
+        return -1;
+    }
+
+    *speed = (float)SPEED_TEST_SIZE * (float)SystemCoreClock / (float)total / 1024.0f;
+    *free_pct = (uint32_t)(((uint64_t)(total - busy) * 100u) / total);
+    return 0;
+}
+
 /**
  * @brief  Test: Speed measurement
  */
@@ -369,7 +425,18 @@ int MD25Q64_Test_Speed(void)
     my_printf(&huart1, "  Time: %d ms\r\n", elapsed);
     my_printf(&huart1, "  Speed: %.2f KB/s\r\n", speed);
 
-    /* Erase Speed Test (4KB sector) */
+    /* DMA Fast Read: CPU time inside the driver vs. wall time (DWT cycles) */
+    my_printf(&huart1, "\r\n[DMA Fast Read Test] Size: %d bytes\r\n", SPEED_TEST_SIZE);
+
+    if (MD25Q64_Test_DmaRead(&speed, &elapsed) != 0) {
+        my_printf(&huart1, "[FAIL] DMA Fast Read failed\r\n");
+        return -1;
+    }
+
+    my_printf(&huart1, "  Speed: %.2f KB/s\r\n", speed);
+    my_printf(&huart1, "  CPU free: %d%%\r\n", elapsed);
+
+        /* Erase Speed Test (4KB sector) */
     my_printf(&huart1, "\r\n[Sector Erase Speed Test]\r\n");
 
     start_tick = HAL_GetTick();
@@ -412,6 +479,205 @@ int MD25Q64_Test_Speed(void)
     return 0;
 }
 
+/* Async test: erase completion queues the write, the write ends the chain */
+static volatile int g_async_done;
+static volatile MD25Q64_Status g_async_status;
+static volatile uint32_t g_async_erase_tick;
+static uint32_t g_async_addr;
+
+static void async_write_done(MD25Q64_Handle *handle, MD25Q64_Status status, void *ctx)
+{
+    (void)handle;
+    (void)ctx;
+    g_async_status = status;
+    g_async_done = 1;
+}
+
+static void async_erase_done(MD25Q64_Handle *handle, MD25Q64_Status status, void *ctx)
+{
+    (void)ctx;
+    g_async_erase_tick = HAL_GetTick();
+    if (status != MD25Q64_OK ||
+        MD25Q64_Write_Start(handle, g_async_addr, g_test_write_buf, TEST_DATA_SIZE,
+                            async_write_done, NULL) != MD25Q64_OK) {
+        g_async_status = status;
+        g_async_done = 1;
+    }
+}
+
+/**
+ * @brief  Test: Asynchronous erase + program
+ */
+int MD25Q64_Test_Async(void)
+{
+    my_printf(&huart1, "\r\n");
+    print_separator();
+    my_printf(&huart1, "Test 4: Asynchronous Operations\r\n");
+    print_separator();
+
+    uint32_t test_addr = TEST_SECTOR_ADDR + MD25Q64_SECTOR_SIZE;
+    uint32_t start_tick, start_ms, polls = 0;
+
+    for (int i = 0; i < TEST_DATA_SIZE; i++) {
+        g_test_write_buf[i] = (uint8_t)(0xA5 ^ i);
+    }
+
+    g_async_addr = test_addr;
+    g_async_done = 0;
+    g_async_status = MD25Q64_BUSY;
+    start_tick = HAL_GetTick();
+    if (MD25Q64_EraseSector_Start(&g_flash, test_addr, async_erase_done, NULL) != MD25Q64_OK) {
+        my_printf(&huart1, "[FAIL] Erase start failed\r\n");
+        return -1;
+    }
+    start_ms = HAL_GetTick() - start_tick;
+
+    /* What a 1 ms scheduler tick would do */
+    while (!g_async_done) {
+        HAL_Delay(1);
+        MD25Q64_Poll(&g_flash);
+        polls++;
+    }
+
+    my_printf(&huart1, "  Start returned after: %d ms\r\n", start_ms);
+    my_printf(&huart1, "  Erase done after:     %d ms\r\n", g_async_erase_tick - start_tick);
+    my_printf(&huart1, "  Write done after:     %d ms (%d polls)\r\n",
+              HAL_GetTick() - start_tick, polls);
+
+    if (g_async_status != MD25Q64_OK) {
+        my_printf(&huart1, "[FAIL] Async chain failed (error: %d)\r\n", g_async_status);
+        return -1;
+    }
+
+    memset(g_test_read_buf, 0, TEST_DATA_SIZE);
+    if (MD25Q64_Read(&g_flash, test_addr, g_test_read_buf, TEST_DATA_SIZE) != MD25Q64_OK ||
+        memcmp(g_test_read_buf, g_test_write_buf, TEST_DATA_SIZE) != 0) {
+        my_printf(&huart1, "[FAIL] Async data verification failed\r\n");
+        return -1;
+    }
+
+    my_printf(&huart1, "[PASS] Async erase + write verified\r\n");
+    return 0;
+}
+
+static void erase_report(const char *name, const MD25Q64_EraseReport *r)
+{
+    my_printf(&huart1, "  %-10s %d x 4K, %d x 32K, %d x 64K, %d blank skipped\r\n", name,
+              r->erases_4k, r->erases_32k, r->erases_64k, r->skipped);
+    my_printf(&huart1, "             planned %d ms (per-sector %d ms), took %d ms\r\n",
+              r->planned_ms, r->naive_ms, r->actual_ms);
+}
+
+/**
+ * @brief  Test: Range erase planner
+ */
+int MD25Q64_Test_EraseRange(void)
+{
+    my_printf(&huart1, "\r\n");
+    print_separator();
+    my_printf(&huart1, "Test 5: Range Erase Planner\r\n");
+    print_separator();
+
+    /* Sectors 1-15 of the test block: 7 sector erases and the upper 32K half */
+    uint32_t start = TEST_SECTOR_ADDR + MD25Q64_SECTOR_SIZE;
+    uint32_t length = MD25Q64_BLOCK_64K_SIZE - MD25Q64_SECTOR_SIZE;
+    uint32_t dirty = TEST_SECTOR_ADDR + 9 * MD25Q64_SECTOR_SIZE;
+    MD25Q64_EraseReport report;
+
+    /* Sector 0 keeps a marker page; sector 9 gets one to be found again */
+    for (int i = 0; i < TEST_DATA_SIZE; i++) {
+        g_test_write_buf[i] = (uint8_t)(0x3C ^ i);
+    }
+    if (MD25Q64_EraseSector(&g_flash, TEST_SECTOR_ADDR) != MD25Q64_OK ||
+        MD25Q64_Write(&g_flash, TEST_SECTOR_ADDR, g_test_write_buf, TEST_DATA_SIZE) != MD25Q64_OK) {
+        my_printf(&huart1, "[FAIL] Marker write failed\r\n");
+        return -1;
+    }
+
+    if (MD25Q64_EraseRange(&g_flash, start, length, 0, &report) != MD25Q64_OK) {
+        my_printf(&huart1, "[FAIL] Range erase failed\r\n");
+        return -1;
+    }
+    erase_report("full:", &report);
+    if (report.erases_4k != 7 || report.erases_32k != 1 || report.erases_64k != 0) {
+        my_printf(&huart1, "[FAIL] Unexpected plan\r\n");
+        return -1;
+    }
+
+    if (MD25Q64_Write(&g_flash, dirty + 100, g_test_write_buf, 16) != MD25Q64_OK ||
+        MD25Q64_EraseRange(&g_flash, start, length, 1, &report) != MD25Q64_OK) {
+        my_printf(&huart1, "[FAIL] Skip-blank erase failed\r\n");
+        return -1;
+    }
+    erase_report("skip blank:", &report);
+    if (report.erases_4k != 1 || report.skipped != 14) {
+        my_printf(&huart1, "[FAIL] Blank sectors not skipped\r\n");
+        return -1;
+    }
+
+    /* Range blank, neighbour untouched */
+    for (uint32_t addr = start; addr < start + length; addr += SPEED_TEST_SIZE) {
+        if (MD25Q64_Read(&g_flash, addr, g_speed_buf, SPEED_TEST_SIZE) != MD25Q64_OK) {
+            my_printf(&huart1, "[FAIL] Read back failed\r\n");
+            return -1;
+        }
+        for (int i = 0; i < SPEED_TEST_SIZE; i++) {
+            if (g_speed_buf[i] != 0xFF) {
+                my_printf(&huart1, "[FAIL] Not blank at 0x%06X\r\n", addr + i);
+                return -1;
+            }
+        }
+    }
+    memset(g_test_read_buf, 0, TEST_DATA_SIZE);
+    if (MD25Q64_Read(&g_flash, TEST_SECTOR_ADDR, g_test_read_buf, TEST_DATA_SIZE) != MD25Q64_OK ||
+        memcmp(g_test_read_buf, g_test_write_buf, TEST_DATA_SIZE) != 0) {
+        my_printf(&huart1, "[FAIL] Neighbour sector was erased\r\n");
+        return -1;
+    }
+
+    my_printf(&huart1, "[PASS] Range erased exactly, blank sectors skipped\r\n");
+    return 0;
+}
+
+static uint32_t bench_cycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+static void bench_print(void *ctx, const char *line)
+{
+    (void)ctx;
+    my_printf(&huart1, "%s\r\n", line);
+}
+
+/**
+ * @brief  Benchmark sweep on the test block, CSV over USART1
+ */
+int MD25Q64_Test_Bench(uint8_t trials)
+{
+    MD25Q64_BenchPort port = {bench_cycles, 0, bench_print, NULL};
+    MD25Q64_Status status;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    port.cycles_per_us = SystemCoreClock / 1000000u;
+
+    /* Quiet init: nothing but CSV and '#' lines on the port */
+    Flash_CS_GPIO_Init();
+    if (MD25Q64_Init(&g_flash, &hspi2, FLASH_CS_PORT, FLASH_CS_PIN) != MD25Q64_OK) {
+        my_printf(&huart1, "# flash init failed\r\n");
+        return -1;
+    }
+
+    status = MD25Q64_Bench_Run(&g_flash, &port, TEST_SECTOR_ADDR, trials,
+                               g_speed_buf, SPEED_TEST_SIZE);
+    if (status != MD25Q64_OK) {
+        my_printf(&huart1, "# bench failed (error: %d)\r\n", status);
+        return -1;
+    }
+    return 0;
+}
+
 /**
  * @brief  Run all Flash tests
  */
@@ -449,6 +715,14 @@ void MD25Q64_Test_RunAll(void)
     result = MD25Q64_Test_Speed();
     if (result == 0) pass_count++; else fail_count++;
 
+    /* Test 4: Async */
+    result = MD25Q64_Test_Async();
+    if (result == 0) pass_count++; else fail_count++;
+
+    /* Test 5: Range erase */
+    result = MD25Q64_Test_EraseRange();
+    if (result == 0) pass_count++; else fail_count++;
+
     /* Summary */
     my_printf(&huart1, "\r\n");
     my_printf(&huart1, "========================================\r\n");
@@ -37,11 +37,31 @@ int MD25Q64_Test_ReadID(void);
 int MD25Q64_Test_ReadWrite(void);
 
 /**
- * @brief  Test: Speed measurement
+ * @brief  Test: Speed measurement (KB/s; CPU-free share of a DMA read)
  * @retval 0: Pass, -1: Fail
  */
 int MD25Q64_Test_Speed(void);
 
+/**
+ * @brief  Test: Asynchronous erase/program with Poll and callbacks
+ * @retval 0: Pass, -1: Fail
+ */
+int MD25Q64_Test_Async(void);
+
+/**
+ * @brief  Test: Range erase planner (plan, blank skipping, exact coverage)
+ * @retval 0: Pass, -1: Fail
+ */
+int MD25Q64_Test_EraseRange(void);
+
+/**
+ * @brief  Benchmark sweep (md25q64_bench.h) on the test block
+ * @param  trials: Runs per point, 1 .. MD25Q64_BENCH_TRIALS_MAX
+ * @note   CSV lines via USART1; erases the 64 KB test block
+ * @retval 0: Done, -1: Fail
+ */
+int MD25Q64_Test_Bench(uint8_t trials);
+
 /**
  * @brief  Get Flash handle for external use
  * @retval Pointer to MD25Q64_Handle
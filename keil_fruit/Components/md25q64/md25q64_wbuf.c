@@ -0,0 +1,150 @@
+/**
+ * @file    md25q64_wbuf.c
+ * @brief   Page write-back buffer implementation
+ */
+
+#include "md25q64_wbuf.h"
+#include <string.h>
+
+/* ============================================================================
+ * Private Helpers
+ * ============================================================================ */
+
+static void MD25Q64_WBuf_Reset(MD25Q64_WBuf *wb)
+{
+    wb->page = MD25Q64_WBUF_NONE;
+    wb->lo = MD25Q64_PAGE_SIZE;
+    wb->hi = 0;
+    memset(wb->data, 0xFF, sizeof(wb->data));
+}
+
+/* ============================================================================
+ * Public Functions
+ * ============================================================================ */
+
+MD25Q64_Status MD25Q64_WBuf_Init(MD25Q64_WBuf *wb, MD25Q64_Handle *flash, uint32_t timeout_ms)
+{
+    if (wb == NULL || flash == NULL) {
+        return MD25Q64_INVALID_PARAM;
+    }
+
+    wb->flash = flash;
+    wb->timeout_ms = timeout_ms;
+    wb->writes = 0;
+    wb->programs = 0;
+    MD25Q64_WBuf_Reset(wb);
+    return MD25Q64_OK;
+}
+
+MD25Q64_Status MD25Q64_WBuf_Flush(MD25Q64_WBuf *wb)
+{
+    MD25Q64_Status status;
+
+    if (wb == NULL) {
+        return MD25Q64_INVALID_PARAM;
+    }
+    if (wb->page == MD25Q64_WBUF_NONE) {
+        return MD25Q64_OK;
+    }
+
+    status = MD25Q64_PageProgram(wb->flash, wb->page + wb->lo,
+                                 &wb->data[wb->lo], (uint32_t)(wb->hi - wb->lo));
+    wb->programs++;
+
+    /* A failed program is not retried: the bytes may be partly written */
+    MD25Q64_WBuf_Reset(wb);
+    return status;
+}
+
+MD25Q64_Status MD25Q64_WBuf_Write(MD25Q64_WBuf *wb, uint32_t address,
+                                  const uint8_t *data, uint32_t size)
+{
+    if (wb == NULL || data == NULL || size == 0) {
+        return MD25Q64_INVALID_PARAM;
+    }
+    if ((address + size) > MD25Q64_FLASH_SIZE) {
+        return MD25Q64_INVALID_PARAM;
+    }
+
+    wb->writes++;
+
+    while (size > 0) {
+        uint32_t page = address & ~(uint32_t)(MD25Q64_PAGE_SIZE - 1u);
+        uint16_t offset = (uint16_t)(address - page);
+        uint16_t chunk = (uint16_t)(MD25Q64_PAGE_SIZE - offset);
+
+        if (chunk > size) {
+            chunk = (uint16_t)size;
+        }
+
+        if (wb->page != page) {
+            if (MD25Q64_WBuf_Flush(wb) != MD25Q64_OK) {
+                return MD25Q64_ERROR;
+            }
+            wb->page = page;
+            wb->dirty_tick = HAL_GetTick();
+        }
+
+        /* Programming can only clear bits: the buffer does the same */
+        for (uint16_t i = 0; i < chunk; i++) {
+            wb->data[offset + i] &= data[i];
+        }
+        if (offset < wb->lo) {
+            wb->lo = offset;
+        }
+        if (offset + chunk > wb->hi) {
+            wb->hi = (uint16_t)(offset + chunk);
+        }
+
+        if (wb->hi == MD25Q64_PAGE_SIZE && MD25Q64_WBuf_Flush(wb) != MD25Q64_OK) {
+            return MD25Q64_ERROR;
+        }
+
+        address += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+    return MD25Q64_OK;
+}
+
+MD25Q64_Status MD25Q64_WBuf_Read(MD25Q64_WBuf *wb, uint32_t address,
+                                 uint8_t *data, uint32_t size)
+{
+    uint32_t start, end;
+
+    if (wb == NULL) {
+        return MD25Q64_INVALID_PARAM;
+    }
+    if (MD25Q64_Read(wb->flash, address, data, size) != MD25Q64_OK) {
+        return MD25Q64_ERROR;
+    }
+    if (wb->page == MD25Q64_WBUF_NONE) {
+        return MD25Q64_OK;
+    }
+
+    /* Overlap of [address, address + size) with the dirty range */
+    start = wb->page + wb->lo;
+    end = wb->page + wb->hi;
+    if (start < address) {
+        start = address;
+    }
+    if (end > address + size) {
+        end = address + size;
+    }
+    for (uint32_t a = start; a < end; a++) {
+        data[a - address] &= wb->data[a - wb->page];
+    }
+    return MD25Q64_OK;
+}
+
+MD25Q64_Status MD25Q64_WBuf_Poll(MD25Q64_WBuf *wb)
+{
+    if (wb == NULL) {
+        return MD25Q64_INVALID_PARAM;
+    }
+    if (wb->page == MD25Q64_WBUF_NONE || wb->timeout_ms == 0 ||
+        (HAL_GetTick() - wb->dirty_tick) < wb->timeout_ms) {
+        return MD25Q64_OK;
+    }
+    return MD25Q64_WBuf_Flush(wb);
+}
@@ -0,0 +1,89 @@
+/**
+ * @file    md25q64_wbuf.h
+ * @brief   Page write-back buffer in front of the MD25Q64 driver
+ * @details Small writes (log records) are collected in RAM until a whole
+ *          256-byte page is covered and then go to flash as one page
+ *          program, instead of one program cycle per write. The page is
+ *          written out when:
+ *          - a write reaches the last byte of the page,
+ *          - a write goes to a different page,
+ *          - MD25Q64_WBuf_Flush() is called,
+ *          - the oldest unflushed byte is timeout_ms old (MD25Q64_WBuf_Poll()).
+ *
+ *          Like flash, the buffer ANDs writes into its contents, so writing
+ *          through it behaves the same as programming directly. Only the
+ *          touched byte range of the page is programmed.
+ *          MD25Q64_WBuf_Read() overlays unflushed bytes on the flash data.
+ *
+ *          Anything still in the buffer is lost on power failure. Bound the
+ *          loss with timeout_ms.
+ */
+
+#ifndef __MD25Q64_WBUF_H__
+#define __MD25Q64_WBUF_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "md25q64.h"
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+#define MD25Q64_WBUF_NONE       0xFFFFFFFFu     /* No page held */
+
+/* ============================================================================
+ * Buffer State
+ * ============================================================================ */
+typedef struct {
+    MD25Q64_Handle *flash;
+    uint32_t page;                  /* Page address held, or MD25Q64_WBUF_NONE */
+    uint16_t lo;                    /* Dirty range within the page: [lo, hi) */
+    uint16_t hi;
+    uint32_t dirty_tick;            /* HAL_GetTick() of the first unflushed write */
+    uint32_t timeout_ms;            /* 0: flush only on page full / explicit */
+    uint32_t writes;                /* MD25Q64_WBuf_Write() calls */
+    uint32_t programs;              /* Page programs issued */
+    uint8_t data[MD25Q64_PAGE_SIZE];
+} MD25Q64_WBuf;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief  Attach a buffer to an initialized flash handle
+ * @param  timeout_ms: Longest time data may stay unflushed (0: no limit)
+ */
+MD25Q64_Status MD25Q64_WBuf_Init(MD25Q64_WBuf *wb, MD25Q64_Handle *flash, uint32_t timeout_ms);
+
+/**
+ * @brief  Buffered write (same contract as MD25Q64_Write)
+ * @note   Blocks only when a page is written out.
+ */
+MD25Q64_Status MD25Q64_WBuf_Write(MD25Q64_WBuf *wb, uint32_t address,
+                                  const uint8_t *data, uint32_t size);
+
+/**
+ * @brief  Read flash with unflushed data applied
+ */
+MD25Q64_Status MD25Q64_WBuf_Read(MD25Q64_WBuf *wb, uint32_t address,
+                                 uint8_t *data, uint32_t size);
+
+/**
+ * @brief  Program the buffered range now
+ */
+MD25Q64_Status MD25Q64_WBuf_Flush(MD25Q64_WBuf *wb);
+
+/**
+ * @brief  Flush if the buffered data is older than timeout_ms
+ * @note   Call periodically (scheduler tick).
+ */
+MD25Q64_Status MD25Q64_WBuf_Poll(MD25Q64_WBuf *wb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MD25Q64_WBUF_H__ */
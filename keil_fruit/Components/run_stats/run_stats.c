@@ -0,0 +1,80 @@
+/**
+ * @file    run_stats.c
+ * @brief   Streaming statistics implementation
+ */
+
+#include "run_stats.h"
+#include <math.h>
+
+void RunStats_Reset(RunStats *s)
+{
+    s->count = 0;
+    s->mean = 0.0f;
+    s->m2 = 0.0f;
+    s->min = 0.0f;
+    s->max = 0.0f;
+}
+
+void RunStats_Push(RunStats *s, float x)
+{
+    float delta;
+
+    if (s->count == 0) {
+        s->min = x;
+        s->max = x;
+    } else {
+        if (x < s->min) {
+            s->min = x;
+        }
+        if (x > s->max) {
+            s->max = x;
+        }
+    }
+
+    s->count++;
+    delta = x - s->mean;
+    s->mean += delta / (float)s->count;
+    s->m2 += delta * (x - s->mean);
+}
+
+void RunStats_Merge(RunStats *dst, const RunStats *src)
+{
+    float n_a, n_b, n, delta;
+
+    if (src->count == 0) {
+        return;
+    }
+    if (dst->count == 0) {
+        *dst = *src;
+        return;
+    }
+
+    n_a = (float)dst->count;
+    n_b = (float)src->count;
+    n = n_a + n_b;
+    delta = src->mean - dst->mean;
+
+    dst->mean += delta * (n_b / n);
+    dst->m2 += src->m2 + delta * delta * (n_a * n_b / n);
+    dst->count += src->count;
+
+    if (src->min < dst->min) {
+        dst->min = src->min;
+    }
+    if (src->max > dst->max) {
+        dst->max = src->max;
+    }
+}
+
+float RunStats_Variance(const RunStats *s)
+{
+    if (s->count < 2) {
+        return 0.0f;
+    }
+    return s->m2 / (float)(s->count - 1);
+}
+
+float RunStats_StdDev(const RunStats *s)
+{
+    return sqrtf(RunStats_Variance(s));
+}
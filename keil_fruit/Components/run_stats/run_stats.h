@@ -0,0 +1,62 @@
+/**
+ * @file    run_stats.h
+ * @brief   Streaming statistics (Welford mean/variance, min, max, count)
+ * @details O(1) per sample and numerically stable: the running sum of
+ *          squared deviations (m2) is updated around the running mean
+ *          instead of accumulating sum(x^2).
+ *          {count, mean, m2, min, max} is a complete, mergeable summary:
+ *          two windows combine with RunStats_Merge() (Chan et al.), so a
+ *          receiver holding per-minute summaries can build hourly ones
+ *          without the raw samples:
+ *            n = na + nb, d = mean_b - mean_a
+ *            mean = mean_a + d * nb / n
+ *            m2   = m2_a + m2_b + d^2 * na * nb / n
+ */
+
+#ifndef __RUN_STATS_H__
+#define __RUN_STATS_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t count;
+    float mean;
+    float m2;                       /* Sum of squared deviations from mean */
+    float min;
+    float max;
+} RunStats;
+
+/**
+ * @brief  Clear a summary (count = 0)
+ */
+void RunStats_Reset(RunStats *s);
+
+/**
+ * @brief  Add one sample
+ */
+void RunStats_Push(RunStats *s, float x);
+
+/**
+ * @brief  Fold src into dst; dst then summarizes both sample sets
+ */
+void RunStats_Merge(RunStats *dst, const RunStats *src);
+
+/**
+ * @brief  Sample variance (n - 1 denominator), 0 for fewer than 2 samples
+ */
+float RunStats_Variance(const RunStats *s);
+
+/**
+ * @brief  Sample standard deviation
+ */
+float RunStats_StdDev(const RunStats *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RUN_STATS_H__ */
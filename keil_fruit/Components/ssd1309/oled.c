@@ -7,6 +7,7 @@ this library is a 0.91'OLED(ssd1306) driver
 #include "oled.h"
 #include "oledfont.h"
 #include "i2c.h"
+#include <string.h>
 
 /**
  * 0.91 "OLED initialization control word
@@ -32,18 +33,396 @@ uint8_t initcmd1[] = {
     0xA6,       // 【新增】设置正常显示 (非反色)
     0xAF,       // set display on
 };
+#define OLED_CLEAN 0xFF
+#define OLED_TX_TIMEOUT_MS 100      // Frame not done by then: bus reset, resend
+
+static uint8_t oled_fb[OLED_PAGES][OLED_WIDTH];     // Drawn into (back)
+static uint8_t oled_dirty_lo[OLED_PAGES];   // Dirty columns lo..hi, OLED_CLEAN if none
+static uint8_t oled_dirty_hi[OLED_PAGES];
+static uint8_t oled_cur_x, oled_cur_page;    // OLED_Write_data() cursor
+static OLED_Stats oled_stats;
+
+// Frame in flight (front): the dirty spans, copied out at OLED_Flush()
+static uint8_t oled_tx_fb[OLED_PAGES][OLED_WIDTH];
+static uint8_t oled_tx_lo[OLED_PAGES];
+static uint8_t oled_tx_hi[OLED_PAGES];
+static uint8_t oled_tx_cmd[3];
+static volatile uint8_t oled_tx_busy;
+static volatile uint8_t oled_tx_failed;
+static uint8_t oled_tx_page;                // Page being sent
+static uint8_t oled_tx_data;                // Its address is out, the span is next
+static uint32_t oled_tx_tick;
+static uint16_t oled_tx_count, oled_tx_bytes;
+
 /**
- * OLED writes commands and data functions
- * OLED writes commands, data functions, and changes the contents of these two functions if you want to migrate them to another development board
+ * OLED bus write: every command and framebuffer transfer goes through here
+ * Change the contents of these functions if you want to migrate them to another development board
  * For example: I use the i2c2 interface, then you only need to change &hi2c1 to &hi2c2.
 **/
+static void OLED_Bus_Write(uint8_t control, uint8_t *buf, uint16_t len)
+{
+	HAL_I2C_Mem_Write(&hi2c1, OLED_ADDR, control, I2C_MEMADD_SIZE_8BIT, buf, len, 0x100);
+	oled_stats.transactions++;
+	oled_stats.bytes += len;
+}
+
+static uint8_t OLED_Bus_Write_DMA(uint8_t control, uint8_t *buf, uint16_t len)
+{
+	oled_tx_count++;
+	oled_tx_bytes += len;
+	return HAL_I2C_Mem_Write_DMA(&hi2c1, OLED_ADDR, control, I2C_MEMADD_SIZE_8BIT, buf, len) == HAL_OK;
+}
+
+static void OLED_Mark(uint8_t page, uint8_t lo, uint8_t hi)
+{
+	if (oled_dirty_lo[page] > lo) oled_dirty_lo[page] = lo;
+	if (oled_dirty_hi[page] < hi) oled_dirty_hi[page] = hi;
+}
+
+// Framebuffer byte; only a change makes the column dirty
+static void OLED_Put(uint8_t page, uint8_t x, uint8_t data)
+{
+	if (oled_fb[page][x] != data)
+	{
+		oled_fb[page][x] = data;
+		OLED_Mark(page, x, x);
+	}
+}
+
+/**
+ * Next transfer of the frame in flight: the page address (3 commands), then
+ * the span. Runs from OLED_Flush() for the first and from the TX-complete
+ * interrupt for the rest.
+**/
+static void OLED_Tx_Next(void)
+{
+	uint8_t page, lo, hi, ok;
+
+	while (oled_tx_page < OLED_PAGES && oled_tx_lo[oled_tx_page] > oled_tx_hi[oled_tx_page])
+	{
+		oled_tx_page++;
+	}
+	if (oled_tx_page == OLED_PAGES)
+	{
+		oled_stats.frames++;
+		oled_stats.transactions += oled_tx_count;
+		oled_stats.bytes += oled_tx_bytes;
+		oled_stats.last_transactions = oled_tx_count;
+		oled_stats.last_bytes = oled_tx_bytes;
+		oled_stats.last_ms = HAL_GetTick() - oled_tx_tick;
+		oled_tx_busy = 0;
+		return;
+	}
+
+	page = oled_tx_page;
+	lo = oled_tx_lo[page];
+	hi = oled_tx_hi[page];
+	if (!oled_tx_data)
+	{
+		oled_tx_cmd[0] = 0xb0 + page;
+		oled_tx_cmd[1] = ((lo & 0xf0) >> 4) | 0x10;
+		oled_tx_cmd[2] = lo & 0x0f;
+		oled_tx_data = 1;
+		ok = OLED_Bus_Write_DMA(0x00, oled_tx_cmd, 3);
+	}
+	else
+	{
+		oled_tx_data = 0;
+		oled_tx_page++;
+		ok = OLED_Bus_Write_DMA(0x40, &oled_tx_fb[page][lo], hi - lo + 1);
+	}
+	if (!ok)
+	{
+		oled_tx_failed = 1;
+		oled_tx_busy = 0;
+	}
+}
+
+/**
+ * Main-loop side of a frame that ended badly (error, or no completion
+ * within OLED_TX_TIMEOUT_MS): its spans are dirty again and go out with
+ * the next flush.
+**/
+static void OLED_Tx_Check(void)
+{
+	uint8_t page;
+
+	if (oled_tx_busy && HAL_GetTick() - oled_tx_tick > OLED_TX_TIMEOUT_MS)
+	{
+		// Stuck bus or lost interrupt: start I2C1 and its DMA over
+		HAL_I2C_DeInit(&hi2c1);
+		MX_I2C1_Init();
+		oled_tx_busy = 0;
+		oled_tx_failed = 1;
+	}
+	if (oled_tx_busy || !oled_tx_failed)
+	{
+		return;
+	}
+	for (page = 0; page < OLED_PAGES; page++)
+	{
+		if (oled_tx_lo[page] <= oled_tx_hi[page])
+		{
+			OLED_Mark(page, oled_tx_lo[page], oled_tx_hi[page]);
+		}
+	}
+	oled_tx_failed = 0;
+	oled_stats.errors++;
+}
+
+/**
+ * @brief	Call from HAL_I2C_MemTxCpltCallback() for hi2c1
+**/
+void OLED_DMA_Complete(void)
+{
+	if (oled_tx_busy)
+	{
+		OLED_Tx_Next();
+	}
+}
+
+/**
+ * @brief	Call from HAL_I2C_ErrorCallback() for hi2c1
+**/
+void OLED_DMA_Error(void)
+{
+	if (oled_tx_busy)
+	{
+		oled_tx_failed = 1;
+		oled_tx_busy = 0;
+	}
+}
+
+/**
+ * @brief	A frame is being sent: OLED_Flush() would return OLED_FLUSH_BUSY
+**/
+uint8_t OLED_Busy(void)
+{
+	OLED_Tx_Check();
+	return oled_tx_busy;
+}
+
+/**
+ * @brief	Commands wait for the frame in flight, then go out blocking
+**/
 void OLED_Write_cmd(uint8_t cmd)
 {
-	HAL_I2C_Mem_Write(&hi2c1, 0x78, 0x00, I2C_MEMADD_SIZE_8BIT, &cmd, 1, 0x100);
+	while (OLED_Busy())
+	{
+	}
+	OLED_Bus_Write(0x00, &cmd, 1);
 }
+
+/**
+ * @brief	Write one byte at the OLED_Set_Position() cursor (framebuffer)
+ * @note	The cursor moves right and wraps to column 0 of the same page,
+ *          as the panel's page addressing mode does
+**/
 void OLED_Write_data(uint8_t data)
 {
-	HAL_I2C_Mem_Write(&hi2c1, 0x78, 0x40, I2C_MEMADD_SIZE_8BIT, &data, 1, 0x100);
+	if (oled_cur_page < OLED_PAGES)
+	{
+		OLED_Put(oled_cur_page, oled_cur_x, data);
+	}
+	oled_cur_x = (oled_cur_x + 1) % OLED_WIDTH;
+}
+
+/**
+ * @brief	Start sending what changed since the last frame, over DMA
+ * @note	The dirty spans are copied to the frame buffer in flight, so
+ *          drawing can go on at once and the panel only ever gets whole
+ *          frames. While a frame is in flight nothing is started; the
+ *          changes stay dirty for the next call.
+ * @retval	OLED_FLUSH_IDLE: nothing changed, OLED_FLUSH_STARTED, or
+ *          OLED_FLUSH_BUSY: previous frame still in flight
+**/
+OLED_FlushStatus OLED_Flush(void)
+{
+	uint8_t page, any = 0;
+
+	if (OLED_Busy())
+	{
+		oled_stats.busy++;
+		return OLED_FLUSH_BUSY;
+	}
+
+	for (page = 0; page < OLED_PAGES; page++)
+	{
+		uint8_t lo = oled_dirty_lo[page], hi = oled_dirty_hi[page];
+
+		oled_tx_lo[page] = lo;
+		oled_tx_hi[page] = hi;
+		if (lo > hi) continue;
+		memcpy(&oled_tx_fb[page][lo], &oled_fb[page][lo], hi - lo + 1);
+		oled_dirty_lo[page] = OLED_CLEAN;
+		oled_dirty_hi[page] = 0;
+		any = 1;
+	}
+	if (!any)
+	{
+		return OLED_FLUSH_IDLE;
+	}
+
+	oled_tx_page = 0;
+	oled_tx_data = 0;
+	oled_tx_count = 0;
+	oled_tx_bytes = 0;
+	oled_tx_tick = HAL_GetTick();
+	oled_tx_busy = 1;
+	OLED_Tx_Next();
+	return OLED_FLUSH_STARTED;
+}
+
+const OLED_Stats *OLED_GetStats(void)
+{
+	return &oled_stats;
+}
+
+/**
+ * @brief	Set or clear one pixel
+ * @param x  0 - 127
+ * @param y  0 - 63 (pixels, not pages)
+**/
+void OLED_DrawPixel(uint8_t x, uint8_t y, uint8_t on)
+{
+	uint8_t bit;
+
+	if (x >= OLED_WIDTH || y >= OLED_HEIGHT) return;
+	bit = 1 << (y & 7);
+	OLED_Put(y >> 3, x, on ? (oled_fb[y >> 3][x] | bit) : (oled_fb[y >> 3][x] & ~bit));
+}
+
+/**
+ * @brief	Line between two pixels (Bresenham), ends included
+**/
+void OLED_DrawLine(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t on)
+{
+	int16_t dx = (x1 > x0) ? x1 - x0 : x0 - x1;
+	int16_t dy = (y1 > y0) ? y0 - y1 : y1 - y0;
+	int8_t sx = (x0 < x1) ? 1 : -1;
+	int8_t sy = (y0 < y1) ? 1 : -1;
+	int16_t err = dx + dy, e2;
+
+	for (;;)
+	{
+		OLED_DrawPixel(x0, y0, on);
+		if (x0 == x1 && y0 == y1) break;
+		e2 = 2 * err;
+		if (e2 >= dy)
+		{
+			err += dy;
+			x0 += sx;
+		}
+		if (e2 <= dx)
+		{
+			err += dx;
+			y0 += sy;
+		}
+	}
+}
+
+/**
+ * @brief	Filled rectangle, w x h pixels from (x, y); clipped to the panel
+ * @note	Page at a time: one masked byte per column
+**/
+void OLED_FillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t on)
+{
+	uint16_t x_end = x + w, y_end = y + h, row, col;
+
+	if (x >= OLED_WIDTH || y >= OLED_HEIGHT || w == 0 || h == 0) return;
+	if (x_end > OLED_WIDTH) x_end = OLED_WIDTH;
+	if (y_end > OLED_HEIGHT) y_end = OLED_HEIGHT;
+
+	for (row = y; row < y_end; row = (row & ~7u) + 8)
+	{
+		uint8_t page = row >> 3;
+		uint16_t stop = ((row & ~7u) + 8 < y_end) ? (row & ~7u) + 8 : y_end;
+		uint8_t mask = (uint8_t)((0xFFu << (row & 7)) & (0xFFu >> (8 - (stop - (row & ~7u)))));
+
+		for (col = x; col < x_end; col++)
+		{
+			OLED_Put(page, col, on ? (oled_fb[page][col] | mask) : (oled_fb[page][col] & ~mask));
+		}
+	}
+}
+
+/**
+ * @brief	Opaque blit of a column-major bitmap at any pixel position
+ * @param x, y  Top left, may be off the panel
+ * @param w, h  Pixels, h <= 24
+ * @param cols  w columns of (h + 7) / 8 bytes, top byte first, bit 0 the top
+ *              row; NULL blits blank columns
+ * @param clip  Drawn only inside it as well as the panel; NULL for the panel
+ * @note	The h rows are replaced, set and clear bits alike. Each touched page
+ *          costs one shift and one masked byte per column.
+**/
+void OLED_Blit(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *cols, const OLED_Clip *clip)
+{
+	int16_t cx0 = 0, cy0 = 0, cx1 = OLED_WIDTH, cy1 = OLED_HEIGHT;
+	int16_t col, row, stop, first, end;
+	uint8_t stride = (h + 7) >> 3, pages = 0, i;
+	uint8_t page[4], mask[4], shift[4];
+	const uint8_t *c;
+
+	if (h == 0 || h > 24) return;
+	if (clip != NULL)
+	{
+		if (cx0 < clip->x0) cx0 = clip->x0;
+		if (cy0 < clip->y0) cy0 = clip->y0;
+		if (cx1 > clip->x1) cx1 = clip->x1;
+		if (cy1 > clip->y1) cy1 = clip->y1;
+	}
+	first = (x > cx0) ? x : cx0;
+	end = (x + w < cx1) ? x + w : cx1;
+	row = (y > cy0) ? y : cy0;
+	stop = (y + h < cy1) ? y + h : cy1;
+	if (first >= end || row >= stop) return;
+
+	// Per page: its shift of the column (held 8 bits up, so never negative)
+	// and the rows to replace
+	for (; row < stop; row = (row & ~7) + 8)
+	{
+		int16_t top = row & ~7;
+		int16_t last = (top + 8 < stop) ? top + 8 : stop;
+
+		page[pages] = (uint8_t)(top >> 3);
+		shift[pages] = (uint8_t)(top - y + 8);
+		mask[pages] = (uint8_t)((0xFFu << (row - top)) & (0xFFu >> (8 - (last - top))));
+		pages++;
+	}
+
+	c = (cols != NULL) ? cols + (first - x) * stride : NULL;
+	for (col = first; col < end; col++)
+	{
+		uint32_t bits = 0;
+
+		if (c != NULL)
+		{
+			bits = c[0];
+			if (stride > 1) bits |= (uint32_t)c[1] << 8;
+			if (stride > 2) bits |= (uint32_t)c[2] << 16;
+			bits <<= 8;
+			c += stride;
+		}
+		for (i = 0; i < pages; i++)
+		{
+			uint8_t data = (uint8_t)(bits >> shift[i]);
+			if (mask[i] != 0xFF) data = (oled_fb[page[i]][col] & ~mask[i]) | (data & mask[i]);
+			OLED_Put(page[i], (uint8_t)col, data);
+		}
+	}
+}
+
+/**
+ * @brief	Rectangle outline, w x h pixels from (x, y)
+**/
+void OLED_DrawRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t on)
+{
+	if (w == 0 || h == 0) return;
+	OLED_FillRect(x, y, w, 1, on);
+	OLED_FillRect(x, y + h - 1, w, 1, on);
+	OLED_FillRect(x, y, 1, h, on);
+	OLED_FillRect(x + w - 1, y, 1, h, on);
 }
 
 
@@ -321,17 +700,7 @@ void OLED_ShowChar(uint8_t x, uint8_t y, uint8_t ch, uint8_t fontsize)
 **/
 void OLED_Allfill(void)
 {
-    uint8_t i, j;
-    for (i = 0; i < 8; i++) // 【修改】将 < 4 改为 < 8
-    {
-        OLED_Write_cmd(0xb0 + i);
-        OLED_Write_cmd(0x00);
-        OLED_Write_cmd(0x10);
-        for (j = 0; j < 128; j++)
-        {
-            OLED_Write_data(0xFF);
-        }
-    }
+    OLED_FillRect(0, 0, OLED_WIDTH, OLED_HEIGHT, 1);
 }
 
 /**
@@ -341,9 +710,8 @@ void OLED_Allfill(void)
 **/
 void OLED_Set_Position(uint8_t x, uint8_t y)
 {
-	OLED_Write_cmd(0xb0 + y);
-	OLED_Write_cmd(((x & 0xf0) >> 4) | 0x10);
-	OLED_Write_cmd((x & 0x0f) | 0x00);
+	oled_cur_x = x % OLED_WIDTH;
+	oled_cur_page = y;
 }
 /**
  * Clear Screen Function
@@ -351,17 +719,7 @@ void OLED_Set_Position(uint8_t x, uint8_t y)
 **/
 void OLED_Clear(void)
 {
-    uint8_t i, n;
-    for (i = 0; i < 8; i++) // 【修改】将 < 4 改为 < 8
-    {
-        OLED_Write_cmd(0xb0 + i);
-        OLED_Write_cmd(0x00);
-        OLED_Write_cmd(0x10);
-        for (n = 0; n < 128; n++)
-        {
-            OLED_Write_data(0);
-        }
-    }
+    OLED_FillRect(0, 0, OLED_WIDTH, OLED_HEIGHT, 0);
 }
 /**
  * Turn screen display on and off
@@ -382,14 +740,18 @@ void OLED_Display_Off(void)
 void OLED_Init(void)
 {
 
-	HAL_Delay(100);
 	uint8_t i;
-	for (i = 0; i < sizeof(initcmd1); i++)
-	{
 
-		OLED_Write_cmd(initcmd1[i]); //display off
-	}
+	HAL_Delay(100);
+	OLED_Bus_Write(0x00, initcmd1, sizeof(initcmd1)); // one command stream
 
-	OLED_Clear();
+	// Panel RAM is random after power-up: send the whole (blank) frame
+	memset(oled_fb, 0, sizeof(oled_fb));
+	for (i = 0; i < OLED_PAGES; i++)
+	{
+		oled_dirty_lo[i] = 0;
+		oled_dirty_hi[i] = OLED_WIDTH - 1;
+	}
+	OLED_Flush();
 	OLED_Set_Position(0, 0);
 }
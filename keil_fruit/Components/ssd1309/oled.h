@@ -9,6 +9,39 @@
 
 #define OLED_WIDTH 128
 #define OLED_HEIGHT 64
+#define OLED_PAGES (OLED_HEIGHT / 8)
+
+/*
+ * Drawing goes into a RAM framebuffer (OLED_PAGES x OLED_WIDTH bytes, same
+ * page order as the panel). OLED_Flush() copies what changed into a second
+ * buffer and sends it in the background over I2C1 TX DMA, one address
+ * write and one data write per dirty column span of a page, chained from
+ * the TX-complete interrupt. oled_task() flushes every tick, so OLED_Show*
+ * output appears within 10 ms, or with the next frame if one is in flight.
+ */
+
+typedef enum {
+	OLED_FLUSH_IDLE = 0,    // Nothing changed
+	OLED_FLUSH_STARTED,     // Frame in flight
+	OLED_FLUSH_BUSY         // Previous frame still in flight, nothing started
+} OLED_FlushStatus;
+
+typedef struct {
+	uint32_t frames;        // Frames sent completely
+	uint32_t transactions;  // I2C writes of those frames
+	uint32_t bytes;         // Payload bytes of those writes
+	uint32_t busy;          // OLED_Flush() calls during a frame
+	uint32_t errors;        // Frames failed or timed out, resent
+	uint16_t last_transactions; // ...of the last frame
+	uint16_t last_bytes;
+	uint16_t last_ms;       // Its OLED_Flush() to completion
+} OLED_Stats;
+
+// Clip rectangle for OLED_Blit(), pixels, x1 / y1 exclusive
+typedef struct {
+	int16_t x0, y0;
+	int16_t x1, y1;
+} OLED_Clip;
 
 void OLED_Write_cmd(uint8_t cmd);
 void OLED_Write_data(uint8_t data);
@@ -26,4 +59,15 @@ void OLED_Display_On(void);
 void OLED_Display_Off(void);
 void OLED_Init(void);
 
+OLED_FlushStatus OLED_Flush(void);
+uint8_t OLED_Busy(void);
+void OLED_DMA_Complete(void);
+void OLED_DMA_Error(void);
+void OLED_DrawPixel(uint8_t x, uint8_t y, uint8_t on);
+void OLED_DrawLine(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t on);
+void OLED_DrawRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t on);
+void OLED_FillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t on);
+void OLED_Blit(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *cols, const OLED_Clip *clip);
+const OLED_Stats *OLED_GetStats(void);
+
 #endif  /*__OLED_H__*/
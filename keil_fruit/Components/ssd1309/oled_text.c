@@ -0,0 +1,179 @@
+/*
+Text rendering for the OLED framebuffer: proportional fonts, clipping,
+aligned boxes and number formatting without vsnprintf
+*/
+
+#include "oled_text.h"
+#include "oled_text_font.h"
+#include <string.h>
+
+const OLED_Font OLED_Font6x8 = {8, ' ', sizeof(TEXT_W6X8), 1, TEXT_W6X8, TEXT_O6X8, TEXT_D6X8};
+const OLED_Font OLED_Font8x16 = {16, ' ', sizeof(TEXT_W8X16), 1, TEXT_W8X16, TEXT_O8X16, TEXT_D8X16};
+
+static uint8_t text_cols[OLED_WIDTH * 2];   // One line of 8x16 columns, main loop only
+
+// Glyph index of a character, '?' for anything the font lacks
+static uint8_t OLED_Glyph(const OLED_Font *font, char ch)
+{
+	uint8_t c = (uint8_t)ch - font->first;
+
+	return (c < font->count) ? c : (uint8_t)('?' - font->first);
+}
+
+/**
+ * @brief	Draw a string at (x, y), pixels, clipped to the panel
+ * @retval	x just past the last glyph
+**/
+int16_t OLED_Text(int16_t x, int16_t y, const char *s, const OLED_Font *font)
+{
+	return OLED_TextClip(x, y, s, font, NULL);
+}
+
+// Columns lo .. hi - 1 of s drawn from x, glyphs and the spacing between
+// them, into text_cols from lo; returns x just past the last glyph
+static int16_t OLED_Gather(int16_t x, const char *s, const OLED_Font *font, int16_t lo, int16_t hi)
+{
+	uint8_t stride = font->height >> 3, g, w;
+	int16_t a, b;
+
+	while (*s != '\0' && x < hi)
+	{
+		g = OLED_Glyph(font, *s++);
+		w = font->width[g];
+		a = (x > lo) ? x : lo;
+		b = (x + w < hi) ? x + w : hi;
+		if (a < b)
+		{
+			memcpy(&text_cols[(a - lo) * stride], font->data + font->offset[g] + (a - x) * stride,
+			       (b - a) * stride);
+		}
+		x += w;
+		if (*s != '\0')
+		{
+			a = (x > lo) ? x : lo;
+			b = (x + font->spacing < hi) ? x + font->spacing : hi;
+			if (a < b) memset(&text_cols[(a - lo) * stride], 0, (b - a) * stride);
+			x += font->spacing;
+		}
+	}
+	// Past the right edge only the returned x still counts
+	if (*s != '\0') x += OLED_TextWidth(s, font);
+	return x;
+}
+
+/**
+ * @brief	Draw a string at (x, y), clipped to clip as well as the panel
+ * @note	The visible columns, glyphs and the spacing between them, are
+ *          gathered in text_cols and go out in one OLED_Blit(). Opaque: they
+ *          replace the font's height of rows, so redrawing changed text
+ *          needs no clear.
+ * @retval	x just past the last glyph
+**/
+int16_t OLED_TextClip(int16_t x, int16_t y, const char *s, const OLED_Font *font, const OLED_Clip *clip)
+{
+	int16_t lo = 0, hi = OLED_WIDTH, end;
+
+	if (clip != NULL)
+	{
+		if (lo < clip->x0) lo = clip->x0;
+		if (hi > clip->x1) hi = clip->x1;
+	}
+	if (lo < x) lo = x;
+	end = OLED_Gather(x, s, font, lo, hi);
+	if (hi > end) hi = end;
+	if (hi > lo) OLED_Blit(lo, y, (uint8_t)(hi - lo), font->height, text_cols, clip);
+	return end;
+}
+
+/**
+ * @brief	Width of a string in pixels, as OLED_Text() draws it
+**/
+uint16_t OLED_TextWidth(const char *s, const OLED_Font *font)
+{
+	uint16_t w = 0;
+
+	if (*s == '\0') return 0;
+	while (*s != '\0')
+	{
+		w += font->width[OLED_Glyph(font, *s++)] + font->spacing;
+	}
+	return w - font->spacing;
+}
+
+/**
+ * @brief	String in a box w pixels wide and one line of the font high
+ * @note	The whole box is rewritten: the text, and blank padding around it.
+ *          Text wider than the box is cut at the box edge.
+**/
+void OLED_TextBox(uint8_t x, uint8_t y, uint8_t w, const char *s, const OLED_Font *font, OLED_Align align)
+{
+	int16_t hi = (x + w < OLED_WIDTH) ? x + w : OLED_WIDTH;
+	int16_t tx = x, tw;
+
+	if (x >= hi) return;
+	if (align != OLED_ALIGN_LEFT)
+	{
+		tw = OLED_TextWidth(s, font);
+		tx = (align == OLED_ALIGN_RIGHT) ? x + w - tw : x + (w - tw) / 2;
+	}
+	// Padding and text in one pass over the box
+	memset(text_cols, 0, (hi - x) * (font->height >> 3));
+	OLED_Gather(tx, s, font, x, hi);
+	OLED_Blit(x, y, (uint8_t)(hi - x), font->height, text_cols, NULL);
+}
+
+/**
+ * @brief	Decimal digits of value into buf (OLED_NUM_LEN bytes)
+ * @retval	Characters written, NUL not counted
+**/
+uint8_t OLED_FormatInt(char *buf, int32_t value)
+{
+	return OLED_FormatFixed(buf, value, 0);
+}
+
+/**
+ * @brief	value / 10^decimals with exactly decimals places, e.g. 2345, 2
+ *          gives "23.45" and -5, 2 gives "-0.05"
+ * @param decimals  0 - 9
+ * @retval	Characters written, NUL not counted
+**/
+uint8_t OLED_FormatFixed(char *buf, int32_t value, uint8_t decimals)
+{
+	char tmp[10];
+	uint32_t mag = (value < 0) ? 0u - (uint32_t)value : (uint32_t)value;
+	uint8_t n = 0, len = 0;
+
+	if (decimals > 9) decimals = 9;
+	do
+	{
+		tmp[n++] = (char)('0' + mag % 10);
+		mag /= 10;
+	} while (mag != 0);
+	while (n <= decimals) tmp[n++] = '0';
+
+	if (value < 0) buf[len++] = '-';
+	while (n > 0)
+	{
+		if (n == decimals) buf[len++] = '.';
+		buf[len++] = tmp[--n];
+	}
+	buf[len] = '\0';
+	return len;
+}
+
+/**
+ * @brief	Right-aligned fixed-point number in a box w pixels wide
+ * @note	A number wider than the box shows as "#" rather than losing digits
+**/
+void OLED_NumberBox(uint8_t x, uint8_t y, uint8_t w, int32_t value, uint8_t decimals, const OLED_Font *font)
+{
+	char buf[OLED_NUM_LEN];
+
+	OLED_FormatFixed(buf, value, decimals);
+	if (OLED_TextWidth(buf, font) > w)
+	{
+		buf[0] = '#';
+		buf[1] = '\0';
+	}
+	OLED_TextBox(x, y, w, buf, font, OLED_ALIGN_RIGHT);
+}
@@ -0,0 +1,48 @@
+
+#ifndef __OLED_TEXT_H__
+#define __OLED_TEXT_H__
+
+#include "oled.h"
+
+/*
+ * Text straight into the OLED framebuffer, without printf. Glyphs are
+ * stored column-major (oled_text_font.h) and go through OLED_Blit(), so
+ * text sits at any pixel position, clips at a box or the panel edge, and
+ * rewrites only the bytes that changed. Fonts are proportional with
+ * tabular digits; numbers are formatted by OLED_FormatInt/Fixed() into a
+ * small buffer and drawn right-aligned by OLED_NumberBox().
+ *
+ * Positions are pixels (y is not a page). Characters outside a font draw
+ * as '?'.
+ */
+
+typedef struct {
+	uint8_t height;         // Pixels, 8 or 16
+	uint8_t first;          // First character
+	uint8_t count;
+	uint8_t spacing;        // Blank columns after each glyph
+	const uint8_t *width;   // Columns per glyph
+	const uint16_t *offset; // Byte offset of each glyph in data
+	const uint8_t *data;    // Columns of height / 8 bytes
+} OLED_Font;
+
+typedef enum {
+	OLED_ALIGN_LEFT = 0,
+	OLED_ALIGN_CENTER,
+	OLED_ALIGN_RIGHT
+} OLED_Align;
+
+#define OLED_NUM_LEN 13     // "-2147483648" / "-2.147483648" and the NUL
+
+extern const OLED_Font OLED_Font6x8;
+extern const OLED_Font OLED_Font8x16;
+
+int16_t OLED_Text(int16_t x, int16_t y, const char *s, const OLED_Font *font);
+int16_t OLED_TextClip(int16_t x, int16_t y, const char *s, const OLED_Font *font, const OLED_Clip *clip);
+uint16_t OLED_TextWidth(const char *s, const OLED_Font *font);
+void OLED_TextBox(uint8_t x, uint8_t y, uint8_t w, const char *s, const OLED_Font *font, OLED_Align align);
+uint8_t OLED_FormatInt(char *buf, int32_t value);
+uint8_t OLED_FormatFixed(char *buf, int32_t value, uint8_t decimals);
+void OLED_NumberBox(uint8_t x, uint8_t y, uint8_t w, int32_t value, uint8_t decimals, const OLED_Font *font);
+
+#endif  /*__OLED_TEXT_H__*/
@@ -0,0 +1,253 @@
+#ifndef OLED_TEXT_FONT_H
+#define OLED_TEXT_FONT_H
+
+/*
+ * Column-major copies of F6X8 and F8X16 (oledfont.h) for oled_text.c.
+ * Each glyph is its inked columns only, blank columns trimmed; the digits
+ * are padded to the widest digit so numbers line up. A column is
+ * height / 8 bytes, top page first, bit 0 the top row.
+ * Included only by oled_text.c.
+ */
+
+/*************************6*8*************************/
+static const uint8_t TEXT_W6X8[92] =
+{
+	3, 1, 3, 5, 5, 5, 5, 2, 3, 3, 5, 5, 2, 5, 2, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 2, 2, 4, 5, 4, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 3, 5, 5,
+	3, 5, 5, 5, 5, 5, 5, 5, 5, 3, 4, 4, 3, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 6,
+};
+
+static const uint16_t TEXT_O6X8[92] =
+{
+	0, 3, 4, 7, 12, 17, 22, 27, 29, 32, 35, 40,
+	45, 47, 52, 54, 59, 64, 69, 74, 79, 84, 89, 94,
+	99, 104, 109, 111, 113, 117, 122, 126, 131, 136, 141, 146,
+	151, 156, 161, 166, 171, 176, 179, 184, 189, 194, 199, 204,
+	209, 214, 219, 224, 229, 234, 239, 244, 249, 254, 259, 264,
+	267, 272, 275, 280, 285, 288, 293, 298, 303, 308, 313, 318,
+	323, 328, 331, 335, 339, 342, 347, 352, 357, 362, 367, 372,
+	377, 382, 387, 392, 397, 402, 407, 412,
+};
+
+static const uint8_t TEXT_D6X8[418] =
+{
+	0x00,0x00,0x00,// sp
+	0x2F,// !
+	0x07,0x00,0x07,// "
+	0x14,0x7F,0x14,0x7F,0x14,// #
+	0x24,0x2A,0x7F,0x2A,0x12,// $
+	0x62,0x64,0x08,0x13,0x23,// %
+	0x36,0x49,0x55,0x22,0x50,// &
+	0x05,0x03,// '
+	0x1C,0x22,0x41,// (
+	0x41,0x22,0x1C,// )
+	0x14,0x08,0x3E,0x08,0x14,// *
+	0x08,0x08,0x3E,0x08,0x08,// +
+	0xA0,0x60,// ,
+	0x08,0x08,0x08,0x08,0x08,// -
+	0x60,0x60,// .
+	0x20,0x10,0x08,0x04,0x02,// /
+	0x3E,0x51,0x49,0x45,0x3E,// 0
+	0x00,0x42,0x7F,0x40,0x00,// 1
+	0x42,0x61,0x51,0x49,0x46,// 2
+	0x21,0x41,0x45,0x4B,0x31,// 3
+	0x18,0x14,0x12,0x7F,0x10,// 4
+	0x27,0x45,0x45,0x45,0x39,// 5
+	0x3C,0x4A,0x49,0x49,0x30,// 6
+	0x01,0x71,0x09,0x05,0x03,// 7
+	0x36,0x49,0x49,0x49,0x36,// 8
+	0x06,0x49,0x49,0x29,0x1E,// 9
+	0x36,0x36,// :
+	0x56,0x36,// ;
+	0x08,0x14,0x22,0x41,// <
+	0x14,0x14,0x14,0x14,0x14,// =
+	0x41,0x22,0x14,0x08,// >
+	0x02,0x01,0x51,0x09,0x06,// ?
+	0x32,0x49,0x59,0x51,0x3E,// @
+	0x7C,0x12,0x11,0x12,0x7C,// A
+	0x7F,0x49,0x49,0x49,0x36,// B
+	0x3E,0x41,0x41,0x41,0x22,// C
+	0x7F,0x41,0x41,0x22,0x1C,// D
+	0x7F,0x49,0x49,0x49,0x41,// E
+	0x7F,0x09,0x09,0x09,0x01,// F
+	0x3E,0x41,0x49,0x49,0x7A,// G
+	0x7F,0x08,0x08,0x08,0x7F,// H
+	0x41,0x7F,0x41,// I
+	0x20,0x40,0x41,0x3F,0x01,// J
+	0x7F,0x08,0x14,0x22,0x41,// K
+	0x7F,0x40,0x40,0x40,0x40,// L
+	0x7F,0x02,0x0C,0x02,0x7F,// M
+	0x7F,0x04,0x08,0x10,0x7F,// N
+	0x3E,0x41,0x41,0x41,0x3E,// O
+	0x7F,0x09,0x09,0x09,0x06,// P
+	0x3E,0x41,0x51,0x21,0x5E,// Q
+	0x7F,0x09,0x19,0x29,0x46,// R
+	0x46,0x49,0x49,0x49,0x31,// S
+	0x01,0x01,0x7F,0x01,0x01,// T
+	0x3F,0x40,0x40,0x40,0x3F,// U
+	0x1F,0x20,0x40,0x20,0x1F,// V
+	0x3F,0x40,0x38,0x40,0x3F,// W
+	0x63,0x14,0x08,0x14,0x63,// X
+	0x07,0x08,0x70,0x08,0x07,// Y
+	0x61,0x51,0x49,0x45,0x43,// Z
+	0x7F,0x41,0x41,// [
+	0x55,0x2A,0x55,0x2A,0x55,// backslash
+	0x41,0x41,0x7F,// ]
+	0x04,0x02,0x01,0x02,0x04,// ^
+	0x40,0x40,0x40,0x40,0x40,// _
+	0x01,0x02,0x04,// `
+	0x20,0x54,0x54,0x54,0x78,// a
+	0x7F,0x48,0x44,0x44,0x38,// b
+	0x38,0x44,0x44,0x44,0x20,// c
+	0x38,0x44,0x44,0x48,0x7F,// d
+	0x38,0x54,0x54,0x54,0x18,// e
+	0x08,0x7E,0x09,0x01,0x02,// f
+	0x18,0xA4,0xA4,0xA4,0x7C,// g
+	0x7F,0x08,0x04,0x04,0x78,// h
+	0x44,0x7D,0x40,// i
+	0x40,0x80,0x84,0x7D,// j
+	0x7F,0x10,0x28,0x44,// k
+	0x41,0x7F,0x40,// l
+	0x7C,0x04,0x18,0x04,0x78,// m
+	0x7C,0x08,0x04,0x04,0x78,// n
+	0x38,0x44,0x44,0x44,0x38,// o
+	0xFC,0x24,0x24,0x24,0x18,// p
+	0x18,0x24,0x24,0x18,0xFC,// q
+	0x7C,0x08,0x04,0x04,0x08,// r
+	0x48,0x54,0x54,0x54,0x20,// s
+	0x04,0x3F,0x44,0x40,0x20,// t
+	0x3C,0x40,0x40,0x20,0x7C,// u
+	0x1C,0x20,0x40,0x20,0x1C,// v
+	0x3C,0x40,0x30,0x40,0x3C,// w
+	0x44,0x28,0x10,0x28,0x44,// x
+	0x1C,0xA0,0xA0,0xA0,0x7C,// y
+	0x44,0x64,0x54,0x4C,0x44,// z
+	0x14,0x14,0x14,0x14,0x14,0x14,// {
+};
+
+/*************************8*16*************************/
+static const uint8_t TEXT_W8X16[95] =
+{
+	4, 2, 6, 7, 5, 7, 8, 3, 4, 4, 7, 7, 3, 7, 2, 7,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 2, 2, 6, 7, 6, 6,
+	7, 8, 7, 7, 7, 7, 7, 7, 8, 5, 7, 7, 7, 7, 8, 7,
+	7, 7, 8, 6, 7, 8, 8, 7, 8, 7, 7, 4, 6, 4, 5, 8,
+	3, 7, 7, 6, 7, 6, 7, 6, 6, 5, 5, 7, 5, 8, 8, 6,
+	7, 7, 7, 6, 5, 8, 8, 8, 6, 8, 6, 4, 1, 4, 7,
+};
+
+static const uint16_t TEXT_O8X16[95] =
+{
+	0, 8, 12, 24, 38, 48, 62, 78, 84, 92, 100, 114,
+	128, 134, 148, 152, 166, 178, 190, 202, 214, 226, 238, 250,
+	262, 274, 286, 290, 294, 306, 320, 332, 344, 358, 374, 388,
+	402, 416, 430, 444, 458, 474, 484, 498, 512, 526, 540, 556,
+	570, 584, 598, 614, 626, 640, 656, 672, 686, 702, 716, 730,
+	738, 750, 758, 768, 784, 790, 804, 818, 830, 844, 856, 870,
+	882, 894, 904, 914, 928, 938, 954, 970, 982, 996, 1010, 1024,
+	1036, 1046, 1062, 1078, 1094, 1106, 1122, 1134, 1142, 1144, 1152,
+};
+
+static const uint8_t TEXT_D8X16[1166] =
+{
+	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,// sp
+	0xF8,0x33,0x00,0x30,// !
+	0x10,0x00,0x0C,0x00,0x06,0x00,0x10,0x00,0x0C,0x00,0x06,0x00,// "
+	0x40,0x04,0xC0,0x3F,0x78,0x04,0x40,0x04,0xC0,0x3F,0x78,0x04,0x40,0x04,// #
+	0x70,0x18,0x88,0x20,0xFC,0xFF,0x08,0x21,0x30,0x1E,// $
+	0xF0,0x00,0x08,0x21,0xF0,0x1C,0x00,0x03,0xE0,0x1E,0x18,0x21,0x00,0x1E,// %
+	0x00,0x1E,0xF0,0x21,0x08,0x23,0x88,0x24,0x70,0x19,0x00,0x27,0x00,0x21,0x00,0x10,// &
+	0x10,0x00,0x16,0x00,0x0E,0x00,// '
+	0xE0,0x07,0x18,0x18,0x04,0x20,0x02,0x40,// (
+	0x02,0x40,0x04,0x20,0x18,0x18,0xE0,0x07,// )
+	0x40,0x02,0x40,0x02,0x80,0x01,0xF0,0x0F,0x80,0x01,0x40,0x02,0x40,0x02,// *
+	0x00,0x01,0x00,0x01,0x00,0x01,0xF0,0x1F,0x00,0x01,0x00,0x01,0x00,0x01,// +
+	0x00,0x80,0x00,0xB0,0x00,0x70,// ,
+	0x00,0x01,0x00,0x01,0x00,0x01,0x00,0x01,0x00,0x01,0x00,0x01,0x00,0x01,// -
+	0x00,0x30,0x00,0x30,// .
+	0x00,0x60,0x00,0x18,0x00,0x06,0x80,0x01,0x60,0x00,0x18,0x00,0x04,0x00,// /
+	0xE0,0x0F,0x10,0x10,0x08,0x20,0x08,0x20,0x10,0x10,0xE0,0x0F,// 0
+	0x10,0x20,0x10,0x20,0xF8,0x3F,0x00,0x20,0x00,0x20,0x00,0x00,// 1
+	0x70,0x30,0x08,0x28,0x08,0x24,0x08,0x22,0x88,0x21,0x70,0x30,// 2
+	0x30,0x18,0x08,0x20,0x88,0x20,0x88,0x20,0x48,0x11,0x30,0x0E,// 3
+	0x00,0x07,0xC0,0x04,0x20,0x24,0x10,0x24,0xF8,0x3F,0x00,0x24,// 4
+	0xF8,0x19,0x08,0x21,0x88,0x20,0x88,0x20,0x08,0x11,0x08,0x0E,// 5
+	0xE0,0x0F,0x10,0x11,0x88,0x20,0x88,0x20,0x18,0x11,0x00,0x0E,// 6
+	0x38,0x00,0x08,0x00,0x08,0x3F,0xC8,0x00,0x38,0x00,0x08,0x00,// 7
+	0x70,0x1C,0x88,0x22,0x08,0x21,0x08,0x21,0x88,0x22,0x70,0x1C,// 8
+	0xE0,0x00,0x10,0x31,0x08,0x22,0x08,0x22,0x10,0x11,0xE0,0x0F,// 9
+	0xC0,0x30,0xC0,0x30,// :
+	0x00,0x80,0x80,0x60,// ;
+	0x00,0x01,0x80,0x02,0x40,0x04,0x20,0x08,0x10,0x10,0x08,0x20,// <
+	0x40,0x04,0x40,0x04,0x40,0x04,0x40,0x04,0x40,0x04,0x40,0x04,0x40,0x04,// =
+	0x08,0x20,0x10,0x10,0x20,0x08,0x40,0x04,0x80,0x02,0x00,0x01,// >
+	0x70,0x00,0x48,0x00,0x08,0x30,0x08,0x36,0x08,0x01,0xF0,0x00,// ?
+	0xC0,0x07,0x30,0x18,0xC8,0x27,0x28,0x24,0xE8,0x23,0x10,0x14,0xE0,0x0B,// @
+	0x00,0x20,0x00,0x3C,0xC0,0x23,0x38,0x02,0xE0,0x02,0x00,0x27,0x00,0x38,0x00,0x20,// A
+	0x08,0x20,0xF8,0x3F,0x88,0x20,0x88,0x20,0x88,0x20,0x70,0x11,0x00,0x0E,// B
+	0xC0,0x07,0x30,0x18,0x08,0x20,0x08,0x20,0x08,0x20,0x08,0x10,0x38,0x08,// C
+	0x08,0x20,0xF8,0x3F,0x08,0x20,0x08,0x20,0x08,0x20,0x10,0x10,0xE0,0x0F,// D
+	0x08,0x20,0xF8,0x3F,0x88,0x20,0x88,0x20,0xE8,0x23,0x08,0x20,0x10,0x18,// E
+	0x08,0x20,0xF8,0x3F,0x88,0x20,0x88,0x00,0xE8,0x03,0x08,0x00,0x10,0x00,// F
+	0xC0,0x07,0x30,0x18,0x08,0x20,0x08,0x20,0x08,0x22,0x38,0x1E,0x00,0x02,// G
+	0x08,0x20,0xF8,0x3F,0x08,0x21,0x00,0x01,0x00,0x01,0x08,0x21,0xF8,0x3F,0x08,0x20,// H
+	0x08,0x20,0x08,0x20,0xF8,0x3F,0x08,0x20,0x08,0x20,// I
+	0x00,0xC0,0x00,0x80,0x08,0x80,0x08,0x80,0xF8,0x7F,0x08,0x00,0x08,0x00,// J
+	0x08,0x20,0xF8,0x3F,0x88,0x20,0xC0,0x01,0x28,0x26,0x18,0x38,0x08,0x20,// K
+	0x08,0x20,0xF8,0x3F,0x08,0x20,0x00,0x20,0x00,0x20,0x00,0x20,0x00,0x30,// L
+	0x08,0x20,0xF8,0x3F,0xF8,0x00,0x00,0x3F,0xF8,0x00,0xF8,0x3F,0x08,0x20,// M
+	0x08,0x20,0xF8,0x3F,0x30,0x20,0xC0,0x00,0x00,0x07,0x08,0x18,0xF8,0x3F,0x08,0x00,// N
+	0xE0,0x0F,0x10,0x10,0x08,0x20,0x08,0x20,0x08,0x20,0x10,0x10,0xE0,0x0F,// O
+	0x08,0x20,0xF8,0x3F,0x08,0x21,0x08,0x01,0x08,0x01,0x08,0x01,0xF0,0x00,// P
+	0xE0,0x0F,0x10,0x18,0x08,0x24,0x08,0x24,0x08,0x38,0x10,0x50,0xE0,0x4F,// Q
+	0x08,0x20,0xF8,0x3F,0x88,0x20,0x88,0x00,0x88,0x03,0x88,0x0C,0x70,0x30,0x00,0x20,// R
+	0x70,0x38,0x88,0x20,0x08,0x21,0x08,0x21,0x08,0x22,0x38,0x1C,// S
+	0x18,0x00,0x08,0x00,0x08,0x20,0xF8,0x3F,0x08,0x20,0x08,0x00,0x18,0x00,// T
+	0x08,0x00,0xF8,0x1F,0x08,0x20,0x00,0x20,0x00,0x20,0x08,0x20,0xF8,0x1F,0x08,0x00,// U
+	0x08,0x00,0x78,0x00,0x88,0x07,0x00,0x38,0x00,0x0E,0xC8,0x01,0x38,0x00,0x08,0x00,// V
+	0xF8,0x03,0x08,0x3C,0x00,0x07,0xF8,0x00,0x00,0x07,0x08,0x3C,0xF8,0x03,// W
+	0x08,0x20,0x18,0x30,0x68,0x2C,0x80,0x03,0x80,0x03,0x68,0x2C,0x18,0x30,0x08,0x20,// X
+	0x08,0x00,0x38,0x00,0xC8,0x20,0x00,0x3F,0xC8,0x20,0x38,0x00,0x08,0x00,// Y
+	0x10,0x20,0x08,0x38,0x08,0x26,0x08,0x21,0xC8,0x20,0x38,0x20,0x08,0x18,// Z
+	0xFE,0x7F,0x02,0x40,0x02,0x40,0x02,0x40,// [
+	0x0C,0x00,0x30,0x00,0xC0,0x01,0x00,0x06,0x00,0x38,0x00,0xC0,// backslash
+	0x02,0x40,0x02,0x40,0x02,0x40,0xFE,0x7F,// ]
+	0x04,0x00,0x02,0x00,0x02,0x00,0x02,0x00,0x04,0x00,// ^
+	0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x80,// _
+	0x02,0x00,0x02,0x00,0x04,0x00,// `
+	0x00,0x19,0x80,0x24,0x80,0x22,0x80,0x22,0x80,0x22,0x00,0x3F,0x00,0x20,// a
+	0x08,0x00,0xF8,0x3F,0x00,0x11,0x80,0x20,0x80,0x20,0x00,0x11,0x00,0x0E,// b
+	0x00,0x0E,0x00,0x11,0x80,0x20,0x80,0x20,0x80,0x20,0x00,0x11,// c
+	0x00,0x0E,0x00,0x11,0x80,0x20,0x80,0x20,0x88,0x10,0xF8,0x3F,0x00,0x20,// d
+	0x00,0x1F,0x80,0x22,0x80,0x22,0x80,0x22,0x80,0x22,0x00,0x13,// e
+	0x80,0x20,0x80,0x20,0xF0,0x3F,0x88,0x20,0x88,0x20,0x88,0x00,0x18,0x00,// f
+	0x00,0x6B,0x80,0x94,0x80,0x94,0x80,0x94,0x80,0x93,0x80,0x60,// g
+	0xF8,0x3F,0x00,0x01,0x80,0x00,0x80,0x00,0x80,0x00,0x80,0x3F,// h
+	0x80,0x20,0x98,0x20,0x98,0x3F,0x00,0x20,0x00,0x20,// i
+	0x00,0xC0,0x00,0x80,0x80,0x80,0x98,0x80,0x98,0x7F,// j
+	0x08,0x20,0xF8,0x3F,0x00,0x24,0x00,0x02,0x80,0x2D,0x80,0x30,0x80,0x20,// k
+	0x08,0x20,0x08,0x20,0xF8,0x3F,0x00,0x20,0x00,0x20,// l
+	0x80,0x20,0x80,0x3F,0x80,0x20,0x80,0x00,0x80,0x3F,0x80,0x20,0x80,0x00,0x00,0x3F,// m
+	0x80,0x20,0x80,0x3F,0x00,0x21,0x80,0x00,0x80,0x00,0x80,0x20,0x00,0x3F,0x00,0x20,// n
+	0x00,0x1F,0x80,0x20,0x80,0x20,0x80,0x20,0x80,0x20,0x00,0x1F,// o
+	0x80,0x80,0x80,0xFF,0x00,0xA1,0x80,0x20,0x80,0x20,0x00,0x11,0x00,0x0E,// p
+	0x00,0x0E,0x00,0x11,0x80,0x20,0x80,0x20,0x80,0xA0,0x80,0xFF,0x00,0x80,// q
+	0x80,0x20,0x80,0x20,0x80,0x3F,0x00,0x21,0x80,0x20,0x80,0x00,0x80,0x01,// r
+	0x00,0x33,0x80,0x24,0x80,0x24,0x80,0x24,0x80,0x24,0x80,0x19,// s
+	0x80,0x00,0x80,0x00,0xE0,0x1F,0x80,0x20,0x80,0x20,// t
+	0x80,0x00,0x80,0x1F,0x00,0x20,0x00,0x20,0x00,0x20,0x80,0x10,0x80,0x3F,0x00,0x20,// u
+	0x80,0x00,0x80,0x01,0x80,0x0E,0x00,0x30,0x00,0x08,0x80,0x06,0x80,0x01,0x80,0x00,// v
+	0x80,0x0F,0x80,0x30,0x00,0x0C,0x80,0x03,0x00,0x0C,0x80,0x30,0x80,0x0F,0x80,0x00,// w
+	0x80,0x20,0x80,0x31,0x00,0x2E,0x80,0x0E,0x80,0x31,0x80,0x20,// x
+	0x80,0x80,0x80,0x81,0x80,0x8E,0x00,0x70,0x00,0x18,0x80,0x06,0x80,0x01,0x80,0x00,// y
+	0x80,0x21,0x80,0x30,0x80,0x2C,0x80,0x22,0x80,0x21,0x80,0x30,// z
+	0x80,0x00,0x7C,0x3F,0x02,0x40,0x02,0x40,// {
+	0xFF,0xFF,// |
+	0x02,0x40,0x02,0x40,0x7C,0x3F,0x80,0x00,// }
+	0x06,0x00,0x01,0x00,0x01,0x00,0x02,0x00,0x02,0x00,0x04,0x00,0x04,0x00,// ~
+};
+
+#endif
@@ -0,0 +1,438 @@
+/**
+ * @file    ts_codec.c
+ * @brief   Block codec implementation
+ * @details The encoder writes each record straight into the block. If the
+ *          block runs out mid-record, the bit position and predictor state
+ *          are rolled back and the partial bits cleared, so a full block is
+ *          always left exactly as it was after the last record that fit.
+ */
+
+#include "ts_codec.h"
+#include <string.h>
+
+/* ============================================================================
+ * Private Helpers - Bit Stream
+ * ============================================================================ */
+
+static uint32_t tsc_zigzag(int32_t v)
+{
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static int32_t tsc_unzigzag(uint32_t z)
+{
+    return (int32_t)(z >> 1) ^ -(int32_t)(z & 1u);
+}
+
+static uint8_t tsc_clz(uint32_t x)
+{
+    uint8_t n = 0;
+
+    if (x == 0) {
+        return 32;
+    }
+#if defined(__GNUC__) || defined(__ARMCC_VERSION)
+    n = (uint8_t)__builtin_clz(x);
+#else
+    while ((x & 0x80000000u) == 0) {
+        x <<= 1;
+        n++;
+    }
+#endif
+    return n;
+}
+
+static uint8_t tsc_ctz(uint32_t x)
+{
+    uint8_t n = 0;
+
+    if (x == 0) {
+        return 32;
+    }
+#if defined(__GNUC__) || defined(__ARMCC_VERSION)
+    n = (uint8_t)__builtin_ctz(x);
+#else
+    while ((x & 1u) == 0) {
+        x >>= 1;
+        n++;
+    }
+#endif
+    return n;
+}
+
+/* Write the low n bits of v (n <= 32), MSB first; 0 if the block is full */
+static uint8_t tsc_put(TsCodec_Encoder *enc, uint32_t v, uint8_t n)
+{
+    uint8_t *p = enc->block + TSCODEC_HDR_SIZE;
+    uint32_t pos = enc->bitpos;
+
+    if (pos + n > (uint32_t)(enc->size - TSCODEC_HDR_SIZE) * 8u) {
+        return 0;
+    }
+
+    while (n > 0) {
+        uint8_t room = (uint8_t)(8u - (pos & 7u));
+        uint8_t take = (n < room) ? n : room;
+        uint8_t bits = (uint8_t)((v >> (n - take)) & ((1u << take) - 1u));
+
+        p[pos >> 3] |= (uint8_t)(bits << (room - take));
+        pos += take;
+        n = (uint8_t)(n - take);
+    }
+    enc->bitpos = pos;
+    return 1;
+}
+
+/* Read n bits (n <= 32); 0 if the stream ends first */
+static uint8_t tsc_get(TsCodec_Decoder *dec, uint8_t n, uint32_t *v)
+{
+    const uint8_t *p = dec->block + TSCODEC_HDR_SIZE;
+    uint32_t pos = dec->bitpos;
+    uint32_t out = 0;
+
+    if (pos + n > (uint32_t)(dec->size - TSCODEC_HDR_SIZE) * 8u) {
+        return 0;
+    }
+
+    while (n > 0) {
+        uint8_t room = (uint8_t)(8u - (pos & 7u));
+        uint8_t take = (n < room) ? n : room;
+        uint8_t bits = (uint8_t)((p[pos >> 3] >> (room - take)) & ((1u << take) - 1u));
+
+        out = (out << take) | bits;
+        pos += take;
+        n = (uint8_t)(n - take);
+    }
+    dec->bitpos = pos;
+    *v = out;
+    return 1;
+}
+
+/* ============================================================================
+ * Private Helpers - Channel Coders
+ * ============================================================================ */
+
+static uint8_t tsc_put_ts(TsCodec_Encoder *enc, uint32_t ts)
+{
+    uint32_t delta = ts - enc->st.ts;
+    uint32_t z = tsc_zigzag((int32_t)(delta - enc->st.delta));
+    uint8_t ok;
+
+    if (z == 0) {
+        ok = tsc_put(enc, 0x0, 1);
+    } else if (z < (1u << 7)) {
+        ok = tsc_put(enc, 0x2, 2) && tsc_put(enc, z, 7);
+    } else if (z < (1u << 9)) {
+        ok = tsc_put(enc, 0x6, 3) && tsc_put(enc, z, 9);
+    } else if (z < (1u << 12)) {
+        ok = tsc_put(enc, 0xE, 4) && tsc_put(enc, z, 12);
+    } else {
+        ok = tsc_put(enc, 0xF, 4) && tsc_put(enc, z, 32);
+    }
+    enc->st.ts = ts;
+    enc->st.delta = delta;
+    return ok;
+}
+
+static uint8_t tsc_get_ts(TsCodec_Decoder *dec, uint32_t *ts)
+{
+    static const uint8_t width[4] = {7, 9, 12, 32};
+    uint32_t bit, z = 0;
+    uint8_t ones = 0;
+
+    /* Count the '1' prefix, up to four */
+    for (;;) {
+        if (!tsc_get(dec, 1, &bit)) {
+            return 0;
+        }
+        if (bit == 0) {
+            break;
+        }
+        if (++ones == 4) {
+            break;
+        }
+    }
+    if (ones > 0 && !tsc_get(dec, width[ones - 1], &z)) {
+        return 0;
+    }
+
+    dec->st.delta += (uint32_t)tsc_unzigzag(z);
+    dec->st.ts += dec->st.delta;
+    *ts = dec->st.ts;
+    return 1;
+}
+
+static uint8_t tsc_put_int(TsCodec_Encoder *enc, uint8_t ch, int32_t value)
+{
+    uint32_t z = tsc_zigzag((int32_t)((uint32_t)value - enc->st.i[ch]));
+
+    enc->st.i[ch] = (uint32_t)value;
+    if (z == 0) {
+        return tsc_put(enc, 0, 1);
+    }
+    if (!tsc_put(enc, 1, 1)) {
+        return 0;
+    }
+    while (z >= 0x80u) {
+        if (!tsc_put(enc, 0x80u | (z & 0x7Fu), 8)) {
+            return 0;
+        }
+        z >>= 7;
+    }
+    return tsc_put(enc, z, 8);
+}
+
+static uint8_t tsc_get_int(TsCodec_Decoder *dec, uint8_t ch, int32_t *value)
+{
+    uint32_t bit, byte, z = 0;
+    uint8_t shift = 0;
+
+    if (!tsc_get(dec, 1, &bit)) {
+        return 0;
+    }
+    if (bit) {
+        do {
+            if (shift > 28 || !tsc_get(dec, 8, &byte)) {
+                return 0;
+            }
+            z |= (byte & 0x7Fu) << shift;
+            shift += 7;
+        } while (byte & 0x80u);
+    }
+
+    dec->st.i[ch] += (uint32_t)tsc_unzigzag(z);
+    *value = (int32_t)dec->st.i[ch];
+    return 1;
+}
+
+static uint8_t tsc_put_float(TsCodec_Encoder *enc, uint8_t ch, float value)
+{
+    uint32_t bits, x;
+    uint8_t lead, trail, len;
+
+    memcpy(&bits, &value, sizeof(bits));
+    x = bits ^ enc->st.f[ch];
+    enc->st.f[ch] = bits;
+
+    if (x == 0) {
+        return tsc_put(enc, 0, 1);
+    }
+
+    lead = tsc_clz(x);
+    trail = tsc_ctz(x);
+
+    /* Reuse the previous window if the meaningful bits sit inside it */
+    if (enc->st.len[ch] != 0 && lead >= enc->st.lead[ch] &&
+        trail >= (uint8_t)(32u - enc->st.lead[ch] - enc->st.len[ch])) {
+        len = enc->st.len[ch];
+        return tsc_put(enc, 0x2, 2) &&
+               tsc_put(enc, x >> (32u - enc->st.lead[ch] - len), len);
+    }
+
+    len = (uint8_t)(32u - lead - trail);
+    enc->st.lead[ch] = lead;
+    enc->st.len[ch] = len;
+    return tsc_put(enc, 0x3, 2) && tsc_put(enc, lead, 5) && tsc_put(enc, len, 6) &&
+           tsc_put(enc, x >> trail, len);
+}
+
+static uint8_t tsc_get_float(TsCodec_Decoder *dec, uint8_t ch, float *value)
+{
+    uint32_t bit, x = 0, lead, len;
+
+    if (!tsc_get(dec, 1, &bit)) {
+        return 0;
+    }
+    if (bit) {
+        if (!tsc_get(dec, 1, &bit)) {
+            return 0;
+        }
+        if (bit) {
+            if (!tsc_get(dec, 5, &lead) || !tsc_get(dec, 6, &len)) {
+                return 0;
+            }
+            if (len == 0 || lead + len > 32u) {
+                return 0;
+            }
+            dec->st.lead[ch] = (uint8_t)lead;
+            dec->st.len[ch] = (uint8_t)len;
+        } else if (dec->st.len[ch] == 0) {
+            return 0;               /* Window reuse before any window */
+        }
+        lead = dec->st.lead[ch];
+        len = dec->st.len[ch];
+        if (!tsc_get(dec, (uint8_t)len, &x)) {
+            return 0;
+        }
+        x <<= (32u - lead - len);
+    }
+
+    dec->st.f[ch] ^= x;
+    memcpy(value, &dec->st.f[ch], sizeof(*value));
+    return 1;
+}
+
+/* ============================================================================
+ * Encoder
+ * ============================================================================ */
+
+TsCodec_Status TsCodec_EncoderInit(TsCodec_Encoder *enc, uint8_t n_int,
+                                   uint8_t n_float, uint16_t size)
+{
+    if (enc == NULL || n_int > TSCODEC_MAX_INT || n_float > TSCODEC_MAX_FLOAT) {
+        return TSCODEC_INVALID_PARAM;
+    }
+    /* An empty block must take at least one raw record */
+    if (size < TSCODEC_HDR_SIZE + 4u * (1u + n_int + n_float) || size > TSCODEC_BLOCK_SIZE) {
+        return TSCODEC_INVALID_PARAM;
+    }
+
+    enc->n_int = n_int;
+    enc->n_float = n_float;
+    enc->size = size;
+    TsCodec_EncoderReset(enc);
+    return TSCODEC_OK;
+}
+
+void TsCodec_EncoderReset(TsCodec_Encoder *enc)
+{
+    memset(enc->block, 0, sizeof(enc->block));
+    memset(&enc->st, 0, sizeof(enc->st));
+    enc->block[0] = TSCODEC_MAGIC;
+    enc->block[1] = (uint8_t)((enc->n_int << 4) | enc->n_float);
+    enc->count = 0;
+    enc->bitpos = 0;
+}
+
+TsCodec_Status TsCodec_Add(TsCodec_Encoder *enc, const TsCodec_Record *rec)
+{
+    TsCodec_State saved;
+    uint32_t saved_pos, bits;
+    uint8_t ok = 1;
+    uint8_t ch;
+
+    if (enc == NULL || rec == NULL || enc->count == 0xFFFFu) {
+        return TSCODEC_INVALID_PARAM;
+    }
+
+    saved = enc->st;
+    saved_pos = enc->bitpos;
+
+    if (enc->count == 0) {
+        ok = tsc_put(enc, rec->timestamp, 32);
+        enc->st.ts = rec->timestamp;
+        for (ch = 0; ok && ch < enc->n_int; ch++) {
+            enc->st.i[ch] = (uint32_t)rec->i[ch];
+            ok = tsc_put(enc, enc->st.i[ch], 32);
+        }
+        for (ch = 0; ok && ch < enc->n_float; ch++) {
+            memcpy(&bits, &rec->f[ch], sizeof(bits));
+            enc->st.f[ch] = bits;
+            ok = tsc_put(enc, bits, 32);
+        }
+    } else {
+        ok = tsc_put_ts(enc, rec->timestamp);
+        for (ch = 0; ok && ch < enc->n_int; ch++) {
+            ok = tsc_put_int(enc, ch, rec->i[ch]);
+        }
+        for (ch = 0; ok && ch < enc->n_float; ch++) {
+            ok = tsc_put_float(enc, ch, rec->f[ch]);
+        }
+    }
+
+    if (!ok) {
+        /* Undo: clear the bits written past the last complete record */
+        uint8_t *p = enc->block + TSCODEC_HDR_SIZE;
+        uint32_t first = saved_pos >> 3;
+
+        if (saved_pos & 7u) {
+            p[first] &= (uint8_t)(0xFFu << (8u - (saved_pos & 7u)));
+            first++;
+        }
+        memset(&p[first], 0, (size_t)(enc->size - TSCODEC_HDR_SIZE) - first);
+        enc->st = saved;
+        enc->bitpos = saved_pos;
+        return TSCODEC_FULL;
+    }
+
+    enc->count++;
+    enc->block[2] = (uint8_t)(enc->count & 0xFFu);
+    enc->block[3] = (uint8_t)(enc->count >> 8);
+    return TSCODEC_OK;
+}
+
+uint16_t TsCodec_BlockBytes(const TsCodec_Encoder *enc)
+{
+    return (uint16_t)(TSCODEC_HDR_SIZE + (enc->bitpos + 7u) / 8u);
+}
+
+/* ============================================================================
+ * Decoder
+ * ============================================================================ */
+
+TsCodec_Status TsCodec_DecoderInit(TsCodec_Decoder *dec, const uint8_t *block, uint16_t size)
+{
+    if (dec == NULL || block == NULL) {
+        return TSCODEC_INVALID_PARAM;
+    }
+    if (size < TSCODEC_HDR_SIZE || block[0] != TSCODEC_MAGIC) {
+        return TSCODEC_CORRUPT;
+    }
+
+    dec->block = block;
+    dec->size = size;
+    dec->n_int = (uint8_t)(block[1] >> 4);
+    dec->n_float = (uint8_t)(block[1] & 0x0Fu);
+    dec->count = (uint16_t)(block[2] | (block[3] << 8));
+    dec->index = 0;
+    dec->bitpos = 0;
+    memset(&dec->st, 0, sizeof(dec->st));
+
+    if (dec->n_int > TSCODEC_MAX_INT || dec->n_float > TSCODEC_MAX_FLOAT) {
+        return TSCODEC_CORRUPT;
+    }
+    return TSCODEC_OK;
+}
+
+TsCodec_Status TsCodec_Next(TsCodec_Decoder *dec, TsCodec_Record *rec)
+{
+    uint8_t ok = 1;
+    uint8_t ch;
+
+    if (dec == NULL || rec == NULL) {
+        return TSCODEC_INVALID_PARAM;
+    }
+    if (dec->index >= dec->count) {
+        return TSCODEC_END;
+    }
+
+    memset(rec, 0, sizeof(*rec));
+
+    if (dec->index == 0) {
+        ok = tsc_get(dec, 32, &dec->st.ts);
+        rec->timestamp = dec->st.ts;
+        for (ch = 0; ok && ch < dec->n_int; ch++) {
+            ok = tsc_get(dec, 32, &dec->st.i[ch]);
+            rec->i[ch] = (int32_t)dec->st.i[ch];
+        }
+        for (ch = 0; ok && ch < dec->n_float; ch++) {
+            ok = tsc_get(dec, 32, &dec->st.f[ch]);
+            memcpy(&rec->f[ch], &dec->st.f[ch], sizeof(float));
+        }
+    } else {
+        ok = tsc_get_ts(dec, &rec->timestamp);
+        for (ch = 0; ok && ch < dec->n_int; ch++) {
+            ok = tsc_get_int(dec, ch, &rec->i[ch]);
+        }
+        for (ch = 0; ok && ch < dec->n_float; ch++) {
+            ok = tsc_get_float(dec, ch, &rec->f[ch]);
+        }
+    }
+
+    if (!ok) {
+        dec->index = dec->count;
+        return TSCODEC_CORRUPT;
+    }
+    dec->index++;
+    return TSCODEC_OK;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file    ts_codec.h
+ * @brief   Block codec for slowly changing sensor time series
+ * @details Records are {timestamp, integer channels, float channels}. A block
+ *          holds as many records as fit in its size (one flash page by
+ *          default) and decodes on its own; nothing is carried between blocks.
+ *
+ *          Block layout (little-endian header, then an MSB-first bit stream):
+ *            [0]    TSCODEC_MAGIC
+ *            [1]    n_int << 4 | n_float
+ *            [2..3] record count
+ *            [4..]  first record raw: timestamp, ints, float bits (32 bits each)
+ *                   then per record:
+ *            timestamp  delta-of-delta D, zig-zagged to z:
+ *                         D == 0        '0'
+ *                         z < 2^7       '10'   + 7 bits
+ *                         z < 2^9       '110'  + 9 bits
+ *                         z < 2^12      '1110' + 12 bits
+ *                         otherwise     '1111' + 32 bits
+ *            int        delta from the previous value, zig-zagged to z:
+ *                         z == 0        '0'
+ *                         otherwise     '1' + varint(z), 7 bits per byte,
+ *                                       bit 7 set on all but the last byte
+ *            float      XOR x with the previous value's bits (Gorilla):
+ *                         x == 0        '0'
+ *                         fits the previous leading/trailing zero window
+ *                                       '10' + the window's bits of x
+ *                         otherwise     '11' + 5 bits leading zeros
+ *                                       + 6 bits length + length bits of x
+ *
+ *          Integer and timestamp arithmetic is modulo 2^32, so any values
+ *          round-trip. The file has no target dependencies and is also the
+ *          host-side decoder.
+ */
+
+#ifndef __TS_CODEC_H__
+#define __TS_CODEC_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+#define TSCODEC_MAGIC           0xC5            /* Block format 1 */
+#define TSCODEC_HDR_SIZE        4
+#define TSCODEC_BLOCK_SIZE      256             /* Largest block (one flash page) */
+#define TSCODEC_MAX_INT         8               /* Integer channels per record */
+#define TSCODEC_MAX_FLOAT       4               /* Float channels per record */
+
+/* ============================================================================
+ * Status Codes
+ * ============================================================================ */
+typedef enum {
+    TSCODEC_OK = 0,
+    TSCODEC_FULL,                   /* Encoder: record does not fit, block unchanged */
+    TSCODEC_END,                    /* Decoder: no more records */
+    TSCODEC_CORRUPT,                /* Decoder: bad header or truncated stream */
+    TSCODEC_INVALID_PARAM
+} TsCodec_Status;
+
+/* ============================================================================
+ * Record and Codec State
+ * ============================================================================ */
+typedef struct {
+    uint32_t timestamp;
+    int32_t  i[TSCODEC_MAX_INT];
+    float    f[TSCODEC_MAX_FLOAT];
+} TsCodec_Record;
+
+/* Predictor state, identical on both sides */
+typedef struct {
+    uint32_t ts;
+    uint32_t delta;                 /* Previous timestamp delta */
+    uint32_t i[TSCODEC_MAX_INT];
+    uint32_t f[TSCODEC_MAX_FLOAT];  /* Float bit patterns */
+    uint8_t lead[TSCODEC_MAX_FLOAT];    /* XOR window of the last non-zero XOR */
+    uint8_t len[TSCODEC_MAX_FLOAT];     /* 0: no window yet */
+} TsCodec_State;
+
+typedef struct {
+    uint8_t n_int;
+    uint8_t n_float;
+    uint16_t size;                  /* Block capacity, bytes */
+    uint16_t count;                 /* Records in the block */
+    uint32_t bitpos;                /* Bits used after the header */
+    TsCodec_State st;
+    uint8_t block[TSCODEC_BLOCK_SIZE];
+} TsCodec_Encoder;
+
+typedef struct {
+    const uint8_t *block;
+    uint16_t size;
+    uint8_t n_int;
+    uint8_t n_float;
+    uint16_t count;
+    uint16_t index;                 /* Next record to decode */
+    uint32_t bitpos;
+    TsCodec_State st;
+} TsCodec_Decoder;
+
+/* ============================================================================
+ * Function Prototypes - Encoder
+ * ============================================================================ */
+
+/**
+ * @brief  Set the record shape and start an empty block
+ * @param  n_int: Integer channels (0 - TSCODEC_MAX_INT)
+ * @param  n_float: Float channels (0 - TSCODEC_MAX_FLOAT)
+ * @param  size: Block capacity, from one raw record
+ *               (TSCODEC_HDR_SIZE + 4 * (1 + n_int + n_float)) up to
+ *               TSCODEC_BLOCK_SIZE
+ */
+TsCodec_Status TsCodec_EncoderInit(TsCodec_Encoder *enc, uint8_t n_int,
+                                   uint8_t n_float, uint16_t size);
+
+/**
+ * @brief  Append one record
+ * @retval TSCODEC_FULL: start a new block (TsCodec_EncoderReset) and add again
+ */
+TsCodec_Status TsCodec_Add(TsCodec_Encoder *enc, const TsCodec_Record *rec);
+
+/**
+ * @brief  Bytes of enc->block in use (header included)
+ */
+uint16_t TsCodec_BlockBytes(const TsCodec_Encoder *enc);
+
+/**
+ * @brief  Empty the block, keeping the record shape and size
+ */
+void TsCodec_EncoderReset(TsCodec_Encoder *enc);
+
+/* ============================================================================
+ * Function Prototypes - Decoder
+ * ============================================================================ */
+
+/**
+ * @brief  Check a block header and prepare to decode it
+ * @param  size: Bytes available (trailing padding is ignored)
+ */
+TsCodec_Status TsCodec_DecoderInit(TsCodec_Decoder *dec, const uint8_t *block, uint16_t size);
+
+/**
+ * @brief  Decode the next record
+ * @retval TSCODEC_END after the last record
+ */
+TsCodec_Status TsCodec_Next(TsCodec_Decoder *dec, TsCodec_Record *rec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TS_CODEC_H__ */
@@ -0,0 +1,443 @@
+/**
+ * @file    uplink_queue.c
+ * @brief   Store-and-forward queue implementation
+ * @details ACKs come back in two streams. Replayed lines sit in a small
+ *          window with the queue position of each, so a line can be read
+ *          back and sent again, and the iterator stepped back when the link
+ *          drops. Live ACKs are kept as runs of consecutive lines above the
+ *          cursor: replay skips them, and the cursor jumps over a run when it
+ *          reaches its start. A live ACK that skips a line opens a new run,
+ *          leaving the missing line to replay. With no backlog every live
+ *          ACK opens a run at the cursor, which is joined at once.
+ */
+
+#include "uplink_queue.h"
+#include <string.h>
+
+/* ============================================================================
+ * Private Helpers
+ * ============================================================================ */
+
+static uint16_t Uplink_PutDec(uint8_t *p, uint32_t v)
+{
+    uint8_t tmp[10];
+    uint16_t n = 0, i;
+
+    do {
+        tmp[n++] = (uint8_t)('0' + v % 10u);
+        v /= 10u;
+    } while (v != 0);
+    for (i = 0; i < n; i++) {
+        p[i] = tmp[n - 1u - i];
+    }
+    return n;
+}
+
+/* "#seq,ts[,R] text\r\n" */
+static void Uplink_Send(Uplink *u, const Uplink_RecHdr *hdr, const uint8_t *text,
+                        uint16_t len, uint8_t replay)
+{
+    uint8_t *p = u->tx;
+
+    *p++ = '#';
+    p += Uplink_PutDec(p, hdr->seq);
+    *p++ = ',';
+    p += Uplink_PutDec(p, hdr->timestamp);
+    if (replay) {
+        *p++ = ',';
+        *p++ = 'R';
+    }
+    *p++ = ' ';
+    memcpy(p, text, len);
+    p += len;
+    *p++ = '\r';
+    *p++ = '\n';
+    u->port->send(u->port->ctx, u->tx, (uint16_t)(p - u->tx));
+}
+
+/* Next queue record into u->rec; *before is the position it was read from */
+static uint8_t Uplink_ReadNext(Uplink *u, FlashLog_Iter *before, Uplink_RecHdr *hdr, uint16_t *len)
+{
+    for (;;) {
+        uint16_t n;
+
+        *before = u->it;
+        if (FlashLog_IterNext(&u->it, u->rec, sizeof(u->rec), &n) != FLASHLOG_OK) {
+            u->it = *before;        /* Stay at the end; new records show up later */
+            return 0;
+        }
+        if (n < sizeof(Uplink_RecHdr) || n > sizeof(u->rec)) {
+            continue;
+        }
+        memcpy(hdr, u->rec, sizeof(*hdr));
+        *len = (uint16_t)(n - sizeof(Uplink_RecHdr));
+        return 1;
+    }
+}
+
+static void Uplink_WinPop(Uplink *u, uint32_t now);
+
+/* Send the oldest replayed line again, read back from its queue position */
+static void Uplink_Resend(Uplink *u, uint32_t now)
+{
+    Uplink_Slot *s = &u->win[u->win_head];
+    FlashLog_Iter it = s->pos;
+    FlashLog_Status st;
+    Uplink_RecHdr hdr;
+    uint16_t n;
+
+    u->win_tick = now;
+    st = FlashLog_IterNext(&it, u->rec, sizeof(u->rec), &n);
+    if (st == FLASHLOG_ERROR) {
+        return;
+    }
+    if (st == FLASHLOG_OK && n >= sizeof(hdr) && n <= sizeof(u->rec)) {
+        memcpy(&hdr, u->rec, sizeof(hdr));
+        if (hdr.seq == s->seq) {
+            Uplink_Send(u, &hdr, &u->rec[sizeof(hdr)], (uint16_t)(n - sizeof(hdr)), 1);
+            u->stats.resends++;
+            return;
+        }
+    }
+
+    /* Recycled by the ring while it waited: give it up */
+    u->stats.lost++;
+    s->acked = 1;
+    Uplink_WinPop(u, now);
+}
+
+/* Cursor reached a run of acknowledged live lines: continue after it */
+static void Uplink_Join(Uplink *u)
+{
+    while (u->run_count > 0 && u->acked >= u->runs[0].start) {
+        if (u->runs[0].end > u->acked) {
+            u->acked = u->runs[0].end;
+        }
+        u->run_count--;
+        memmove(&u->runs[0], &u->runs[1], u->run_count * sizeof(Uplink_Run));
+    }
+}
+
+static uint8_t Uplink_InRun(const Uplink *u, uint32_t seq)
+{
+    uint8_t i;
+
+    for (i = 0; i < u->run_count; i++) {
+        if (seq >= u->runs[i].start && seq < u->runs[i].end) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void Uplink_WinPop(Uplink *u, uint32_t now)
+{
+    while (u->win_count > 0 && u->win[u->win_head].acked) {
+        if (u->win[u->win_head].seq >= u->acked) {
+            u->acked = u->win[u->win_head].seq + 1u;
+        }
+        u->win_head = (uint8_t)((u->win_head + 1u) % UPLINK_WINDOW);
+        u->win_count--;
+        u->win_tick = now;
+    }
+    Uplink_Join(u);
+}
+
+static void Uplink_Ack(Uplink *u, uint32_t seq)
+{
+    uint32_t now = u->port->now_ms();
+    uint8_t i;
+
+    u->stats.acks++;
+    u->ack_tick = now;
+    u->link = 1;
+
+    /* A replayed line */
+    for (i = 0; i < u->win_count; i++) {
+        Uplink_Slot *s = &u->win[(u->win_head + i) % UPLINK_WINDOW];
+
+        if (s->seq == seq) {
+            uint8_t later = 0;
+
+            s->acked = 1;
+            Uplink_WinPop(u, now);
+
+            /* Lines after the oldest got through: its ACK (or itself) was lost */
+            for (i = 1; i < u->win_count; i++) {
+                later += u->win[(u->win_head + i) % UPLINK_WINDOW].acked;
+            }
+            if (later >= UPLINK_DUP_ACKS && !u->win[u->win_head].resent) {
+                u->win[u->win_head].resent = 1;
+                Uplink_Resend(u, now);
+            }
+            return;
+        }
+    }
+
+    /* A live line: extend the newest run or open one after it */
+    if (seq < u->acked || seq >= u->next_seq) {
+        return;
+    }
+    if (u->run_count > 0 && seq == u->runs[u->run_count - 1u].end) {
+        u->runs[u->run_count - 1u].end++;
+    } else if (u->run_count == 0 || seq > u->runs[u->run_count - 1u].end) {
+        if (u->run_count == UPLINK_RUNS) {
+            /* Forget the oldest run; its lines are replayed again */
+            u->run_count--;
+            memmove(&u->runs[0], &u->runs[1], u->run_count * sizeof(Uplink_Run));
+        }
+        u->runs[u->run_count].start = seq;
+        u->runs[u->run_count].end = seq + 1u;
+        u->run_count++;
+    }
+    Uplink_Join(u);
+}
+
+/* Send the next backlog line if the window and the pacing allow */
+static void Uplink_Replay(Uplink *u, uint32_t now)
+{
+    FlashLog_Iter before;
+    Uplink_RecHdr hdr;
+    uint32_t limit;
+    uint16_t len, n;
+    Uplink_Slot *s;
+
+    /* While the link is up, lines after the newest run are still in flight */
+    if (!u->link) {
+        limit = u->next_seq;
+    } else if (u->run_count > 0) {
+        limit = u->runs[u->run_count - 1u].end;
+    } else {
+        limit = u->acked;
+    }
+    if (u->acked >= limit || (now - u->send_tick) < UPLINK_REPLAY_MS) {
+        return;
+    }
+    /* While the link is down, one line at a time probes it */
+    if (u->win_count >= (u->link ? UPLINK_WINDOW : 1u)) {
+        return;
+    }
+
+    for (n = 0; n < UPLINK_SCAN_MAX; n++) {
+        if (!Uplink_ReadNext(u, &before, &hdr, &len)) {
+            return;
+        }
+        if (u->win_count > 0 && hdr.seq > u->it_seq) {
+            /* Recycled under the iterator while the window was out; the
+             * cursor passes them when the window drains */
+            u->stats.lost += hdr.seq - u->it_seq;
+        }
+        u->it_seq = hdr.seq + 1u;
+        if (hdr.seq < u->acked) {
+            continue;               /* Confirmed while it was waiting */
+        }
+        if (u->win_count == 0 && hdr.seq > u->acked) {
+            u->stats.lost += hdr.seq - u->acked;    /* Recycled by the ring */
+            u->acked = hdr.seq;
+            Uplink_Join(u);
+            if (hdr.seq < u->acked) {
+                continue;
+            }
+        }
+        if (hdr.seq >= limit) {
+            u->it = before;         /* Caught up */
+            u->it_seq = hdr.seq;
+            return;
+        }
+        if (Uplink_InRun(u, hdr.seq)) {
+            continue;
+        }
+
+        s = &u->win[(u->win_head + u->win_count) % UPLINK_WINDOW];
+        s->seq = hdr.seq;
+        s->acked = 0;
+        s->resent = 0;
+        s->pos = before;
+        if (u->win_count++ == 0) {
+            u->win_tick = now;
+        }
+        Uplink_Send(u, &hdr, &u->rec[sizeof(hdr)], len, 1);
+        u->send_tick = now;
+        u->stats.replayed++;
+        return;
+    }
+}
+
+/* ============================================================================
+ * Public Functions
+ * ============================================================================ */
+
+Uplink_Status Uplink_Init(Uplink *u, FlashLog *queue, FlashLog *cursor, const Uplink_Port *port)
+{
+    FlashLog_Iter it, before, first;
+    FlashLog_Status st;
+    Uplink_Cursor cur;
+    Uplink_RecHdr hdr;
+    uint8_t found = 0;
+    uint16_t len;
+
+    if (u == NULL || queue == NULL || cursor == NULL || port == NULL) {
+        return UPLINK_INVALID_PARAM;
+    }
+
+    memset(u, 0, sizeof(*u));
+    u->queue = queue;
+    u->cursor = cursor;
+    u->port = port;
+
+    /* Newest cursor record wins */
+    FlashLog_IterInit(cursor, &it);
+    while ((st = FlashLog_IterNext(&it, &cur, sizeof(cur), &len)) == FLASHLOG_OK) {
+        if (len == sizeof(cur)) {
+            u->acked = cur.acked;
+            u->next_seq = cur.next_seq;
+        }
+    }
+    if (st == FLASHLOG_ERROR) {
+        return UPLINK_ERROR;
+    }
+
+    /* Highest stored seq, and where the first unacknowledged line sits */
+    FlashLog_IterInit(queue, &u->it);
+    first = u->it;
+    for (;;) {
+        before = u->it;
+        st = FlashLog_IterNext(&u->it, u->rec, sizeof(u->rec), &len);
+        if (st != FLASHLOG_OK) {
+            break;
+        }
+        if (len < sizeof(hdr)) {
+            continue;
+        }
+        memcpy(&hdr, u->rec, sizeof(hdr));
+        if (!found && hdr.seq >= u->acked) {
+            first = before;
+            found = 1;
+        }
+        if (hdr.seq >= u->next_seq) {
+            u->next_seq = hdr.seq + 1u;
+        }
+    }
+    if (st == FLASHLOG_ERROR) {
+        return UPLINK_ERROR;
+    }
+    u->it = found ? first : before;
+
+    if (u->acked > u->next_seq) {
+        u->acked = u->next_seq;
+    }
+    u->it_seq = u->acked;
+    u->saved = u->acked;
+    u->save_tick = port->now_ms();
+    u->ack_tick = u->save_tick - UPLINK_LINK_MS;
+    return UPLINK_OK;
+}
+
+Uplink_Status Uplink_Write(Uplink *u, uint32_t timestamp, const char *text, uint16_t len)
+{
+    Uplink_RecHdr hdr;
+    Uplink_Status ret = UPLINK_OK;
+
+    while (len > 0 && (text[len - 1u] == '\r' || text[len - 1u] == '\n')) {
+        len--;
+    }
+    if (len > UPLINK_LINE_MAX) {
+        len = UPLINK_LINE_MAX;
+    }
+
+    hdr.seq = u->next_seq++;
+    hdr.timestamp = timestamp;
+    memcpy(u->rec, &hdr, sizeof(hdr));
+    memcpy(&u->rec[sizeof(hdr)], text, len);
+    if (FlashLog_Append(u->queue, u->rec, (uint16_t)(sizeof(hdr) + len)) != FLASHLOG_OK) {
+        u->stats.write_errors++;
+        ret = UPLINK_ERROR;
+    } else {
+        u->stats.written++;
+    }
+
+    Uplink_Send(u, &hdr, (const uint8_t *)text, len, 0);
+    return ret;
+}
+
+void Uplink_Input(Uplink *u, const uint8_t *data, uint16_t len)
+{
+    while (len--) {
+        char c = (char)*data++;
+
+        if (c != '\r' && c != '\n') {
+            if (u->rx_len < UPLINK_RX_MAX) {
+                u->rx[u->rx_len++] = c;
+            } else {
+                u->rx_len = UPLINK_RX_MAX + 1;     /* Not an ACK; drop to end of line */
+            }
+            continue;
+        }
+
+        if (u->rx_len > 4 && u->rx_len <= UPLINK_RX_MAX && memcmp(u->rx, "ACK:", 4) == 0) {
+            uint32_t seq = 0;
+            uint8_t i, ok = 1;
+
+            for (i = 4; i < u->rx_len; i++) {
+                if (u->rx[i] < '0' || u->rx[i] > '9') {
+                    ok = 0;
+                    break;
+                }
+                seq = seq * 10u + (uint32_t)(u->rx[i] - '0');
+            }
+            if (ok) {
+                Uplink_Ack(u, seq);
+            }
+        }
+        u->rx_len = 0;
+    }
+}
+
+void Uplink_Poll(Uplink *u)
+{
+    uint32_t now = u->port->now_ms();
+
+    if (u->link && (now - u->ack_tick) >= UPLINK_LINK_MS) {
+        u->link = 0;                    /* Lines in flight join the backlog */
+        if (u->win_count > 0) {
+            u->it = u->win[u->win_head].pos;    /* Replay the window again later */
+            u->it_seq = u->win[u->win_head].seq;
+            u->win_count = 0;
+        }
+    }
+
+    /* Oldest replayed line unanswered */
+    if (u->win_count > 0 && (now - u->win_tick) >= UPLINK_ACK_MS) {
+        Uplink_Resend(u, now);
+        u->stats.timeouts++;
+    }
+
+    Uplink_Replay(u, now);
+
+    if (u->acked != u->saved && (now - u->save_tick) >= UPLINK_SAVE_MS) {
+        Uplink_Save(u);
+    }
+
+    FlashLog_Maintain(u->queue);
+    FlashLog_Maintain(u->cursor);
+}
+
+Uplink_Status Uplink_Save(Uplink *u)
+{
+    Uplink_Cursor cur;
+
+    u->save_tick = u->port->now_ms();
+    cur.acked = u->acked;
+    cur.next_seq = u->next_seq;
+    if (FlashLog_Append(u->cursor, &cur, sizeof(cur)) != FLASHLOG_OK) {
+        return UPLINK_ERROR;
+    }
+    u->saved = u->acked;
+    u->stats.saves++;
+    return UPLINK_OK;
+}
+
+uint32_t Uplink_Backlog(const Uplink *u)
+{
+    return u->next_seq - u->acked;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file    uplink_queue.h
+ * @brief   Store-and-forward queue for telemetry lines (device side)
+ * @details Every line is appended to a FlashLog before it is sent, with a
+ *          sequence number that never repeats (it survives resets: mount
+ *          recovers it from the newest record). The server answers each
+ *          line it receives with "ACK:<seq>".
+ *
+ *          Line on the wire:
+ *            #<seq>,<timestamp> <text>\r\n        sent live, as written
+ *            #<seq>,<timestamp>,R <text>\r\n      replayed from the queue
+ *
+ *          New lines always go out at once. Lines that got no ACK (link
+ *          down, modem out of coverage) are replayed oldest first, one per
+ *          UPLINK_REPLAY_MS and at most UPLINK_WINDOW unacknowledged, so
+ *          the backlog drains alongside the live lines instead of ahead of
+ *          them. The oldest replayed line is sent again when UPLINK_DUP_ACKS
+ *          later ones were acknowledged before it, or after UPLINK_ACK_MS.
+ *
+ *          Delivery is at least once: a line may arrive twice (an ACK lost
+ *          on the way, a reset before the cursor was saved) and the server
+ *          drops repeats by seq. The acknowledged cursor is appended to a
+ *          second, small FlashLog at most every UPLINK_SAVE_MS.
+ *
+ *          If an outage outlasts the queue, the ring recycles its oldest
+ *          sector and those lines are counted as lost.
+ */
+
+#ifndef __UPLINK_QUEUE_H__
+#define __UPLINK_QUEUE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "flash_log.h"
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+#define UPLINK_LINE_MAX         200             /* Text bytes per line */
+#define UPLINK_WINDOW           8               /* Replayed lines awaiting ACK */
+#define UPLINK_REPLAY_MS        50              /* Gap between replayed lines */
+#define UPLINK_ACK_MS           3000            /* Replay ACK timeout: resend oldest */
+#define UPLINK_DUP_ACKS         3               /* Later ACKs that resend the oldest early */
+#define UPLINK_LINK_MS          10000           /* No ACK this long: link down */
+#define UPLINK_SAVE_MS          60000           /* Cursor saved at most this often */
+#define UPLINK_SCAN_MAX         16              /* Records skipped per poll while replaying */
+#define UPLINK_RUNS             4               /* Acknowledged live ranges kept */
+#define UPLINK_RX_MAX           24              /* Longest server line kept */
+
+/* ============================================================================
+ * Status Codes
+ * ============================================================================ */
+typedef enum {
+    UPLINK_OK = 0,
+    UPLINK_ERROR,                   /* Flash access failed */
+    UPLINK_INVALID_PARAM
+} Uplink_Status;
+
+/* ============================================================================
+ * On-Flash Records
+ * ============================================================================ */
+
+/* Queue record: header, then the text (no line ending) */
+typedef struct {
+    uint32_t seq;
+    uint32_t timestamp;             /* Caller's clock, sent as is */
+} Uplink_RecHdr;
+
+/* Cursor record: the newest one is current */
+typedef struct {
+    uint32_t acked;                 /* Every line below acked confirmed */
+    uint32_t next_seq;
+} Uplink_Cursor;
+
+/* ============================================================================
+ * Port
+ * ============================================================================ */
+typedef struct {
+    uint8_t (*send)(void *ctx, const uint8_t *data, uint16_t len);     /* 0: not sent */
+    uint32_t (*now_ms)(void);
+    void *ctx;
+} Uplink_Port;
+
+/* ============================================================================
+ * Queue State
+ * ============================================================================ */
+typedef struct {
+    uint32_t seq;
+    uint8_t acked;
+    uint8_t resent;                 /* Sent again early (UPLINK_DUP_ACKS) */
+    FlashLog_Iter pos;              /* Queue position of this record */
+} Uplink_Slot;
+
+/* Live lines start .. end - 1, all acknowledged */
+typedef struct {
+    uint32_t start;
+    uint32_t end;
+} Uplink_Run;
+
+typedef struct {
+    uint32_t written;               /* Lines queued */
+    uint32_t write_errors;          /* Lines sent but not stored */
+    uint32_t replayed;              /* Lines sent from the queue */
+    uint32_t acks;
+    uint32_t resends;               /* Replayed lines sent again */
+    uint32_t timeouts;              /* ... of which after UPLINK_ACK_MS */
+    uint32_t lost;                  /* Lines recycled before their ACK */
+    uint32_t saves;                 /* Cursor records written */
+} Uplink_Stats;
+
+typedef struct {
+    FlashLog *queue;
+    FlashLog *cursor;
+    const Uplink_Port *port;
+    uint32_t next_seq;
+    uint32_t acked;                 /* Every line below acked confirmed */
+    uint32_t saved;                 /* acked as last stored */
+    Uplink_Run runs[UPLINK_RUNS];   /* Above acked, ascending */
+    uint8_t run_count;
+    uint8_t link;                   /* An ACK within UPLINK_LINK_MS */
+    uint32_t ack_tick;              /* Last ACK */
+    uint32_t send_tick;             /* Last replayed line */
+    uint32_t win_tick;              /* Oldest window slot sent or advanced */
+    uint32_t save_tick;
+    FlashLog_Iter it;               /* Next record to replay */
+    uint32_t it_seq;                /* ...and the seq it should hold */
+    Uplink_Slot win[UPLINK_WINDOW];
+    uint8_t win_head;
+    uint8_t win_count;
+    char rx[UPLINK_RX_MAX];
+    uint8_t rx_len;                 /* UPLINK_RX_MAX + 1: skipping a long line */
+    uint8_t rec[sizeof(Uplink_RecHdr) + UPLINK_LINE_MAX];
+    uint8_t tx[32 + UPLINK_LINE_MAX];
+    Uplink_Stats stats;
+} Uplink;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief  Recover the sequence number and cursor from mounted logs
+ * @param  queue: Line queue (records up to FLASHLOG_MAX_RECORD)
+ * @param  cursor: Small log holding Uplink_Cursor records
+ * @note   Scans the whole queue once to find the first unacknowledged line.
+ */
+Uplink_Status Uplink_Init(Uplink *u, FlashLog *queue, FlashLog *cursor, const Uplink_Port *port);
+
+/**
+ * @brief  Queue one line and send it live
+ * @param  text: Line without its ending (trailing CR/LF are dropped);
+ *               longer than UPLINK_LINE_MAX is cut
+ */
+Uplink_Status Uplink_Write(Uplink *u, uint32_t timestamp, const char *text, uint16_t len);
+
+/**
+ * @brief  Feed bytes received from the server (ACK lines)
+ */
+void Uplink_Input(Uplink *u, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief  Replay, timers and cursor saves (call periodically)
+ */
+void Uplink_Poll(Uplink *u);
+
+/**
+ * @brief  Store the cursor now
+ */
+Uplink_Status Uplink_Save(Uplink *u);
+
+/**
+ * @brief  Lines not yet acknowledged
+ */
+uint32_t Uplink_Backlog(const Uplink *u);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UPLINK_QUEUE_H__ */
@@ -87,6 +87,7 @@ int main(void)
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
+	boot_time_start();
 
   /* USER CODE END SysInit */
 
@@ -102,11 +103,34 @@ int main(void)
   MX_RTC_Init();
   MX_SPI2_Init();
   /* USER CODE BEGIN 2 */
+	boot_time_mark("peripherals");
 	scheduler_init();
 	buffer_init();
+	boot_time_mark("buffers");
 	OLED_Init();
+	boot_time_mark("oled");
 	adc_dma_init();
+	boot_time_mark("adc");
+#if BOOT_FLASH_TEST
 	MD25Q64_Test_RunAll();
+	boot_time_mark("flash test");
+#endif
+	storage_init();
+	boot_time_mark("flash");
+	boot_selfcheck();
+	boot_time_mark("self-check");
+	if (boot_flash_writable())
+	{
+		storage_mount();
+		boot_time_mark("storage");
+		uplink_init();
+		boot_time_mark("uplink");
+	}
+	dump_init();
+	boot_time_mark("dump");
+	asset_init();
+	boot_time_mark("assets");
+	boot_report();
   /* USER CODE END 2 */
 
   /* Infinite loop */
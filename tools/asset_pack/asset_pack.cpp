@@ -0,0 +1,879 @@
+/**
+ * @file    asset_pack.cpp
+ * @brief   Host builder for the display asset image (Components/flash_asset)
+ * @details Packs fonts and bitmaps into one image for the MD25Q64 asset
+ *          region (FLASH_ASSET_ADDR, flash_map.h). Program the output there
+ *          with any SPI programmer, e.g. flashrom with a layout entry for
+ *          0x100000:0x3FFFFF.
+ *
+ *          Font sources (glyphs rendered into a WxH cell, H a multiple of 8):
+ *            *.ttf / *.otf       FreeType, monochrome; built with
+ *                                -DASSET_PACK_FREETYPE only
+ *            *.bdf               BDF bitmap font (e.g. from otf2bdf, or the
+ *                                WenQuanYi / unifont bitmap sets)
+ *            FILE.h:ARRAY        C array already in OLED page order, as in
+ *                                oledfont.h (F6X8, F8X16, Hzk)
+ *          --chars picks the codepoints, comma separated: 0x20-0x7E,
+ *          U+4E00-U+9FA5, @text.txt (every character in a UTF-8 file) or
+ *          literal text. Default 0x20-0x7E. For a C array the glyphs are
+ *          taken in --chars order.
+ *
+ *          Bitmap sources: *.pbm (P1/P4, 1 = lit pixel, rows padded to a
+ *          multiple of 8), or FILE.h:ARRAY in page order with SIZE given.
+ *
+ *          Codepoints without a glyph in the source are dropped. Ranges
+ *          closer together than the rest are merged (the gap filled with
+ *          the fallback glyph) until at most --max-ranges remain.
+ *
+ *          Build:  g++ -std=c++17 -O2 -o asset_pack asset_pack.cpp
+ *                  g++ -std=c++17 -O2 -DASSET_PACK_FREETYPE $(pkg-config --cflags freetype2) \
+ *                      -o asset_pack asset_pack.cpp $(pkg-config --libs freetype2)
+ *          Use:    asset_pack -o assets.bin \
+ *                      --font f8x16 8x16 oledfont.h:F8X16 \
+ *                      --font cjk16 16x16 wenquanyi_12pt.bdf --chars 0x20-0x7E,@ui_text.txt \
+ *                      --bitmap logo 32x32 oledpic.h:BMP1
+ *                  asset_pack --show assets.bin cjk16 "乙烯 0.42 ppm"
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef ASSET_PACK_FREETYPE
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#endif
+
+namespace {
+
+/* ============================================================================
+ * Image constants (match flash_asset.h)
+ * ============================================================================ */
+constexpr uint32_t kMagic = 0x54455341u;        // "ASET"
+constexpr uint16_t kVersion = 1;
+constexpr size_t kHeaderSize = 32;
+constexpr size_t kEntrySize = 24;
+constexpr size_t kNameLen = 8;
+constexpr size_t kMaxEntries = 16;
+constexpr size_t kGlyphMax = 32;                // FLASHASSET_GLYPH_MAX
+constexpr uint8_t kTypeFont = 1;
+constexpr uint8_t kTypeBitmap = 2;
+constexpr uint32_t kReplacement = 0xFFFD;
+
+uint32_t crc32(uint32_t crc, const uint8_t *p, size_t n)
+{
+    static uint32_t table[256];
+    static bool ready = false;
+    if (!ready) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? (c >> 1) ^ 0xEDB88320u : c >> 1;
+            }
+            table[i] = c;
+        }
+        ready = true;
+    }
+    crc = ~crc;
+    while (n--) {
+        crc = (crc >> 8) ^ table[(crc ^ *p++) & 0xFF];
+    }
+    return ~crc;
+}
+
+void put16(std::vector<uint8_t> &v, uint16_t x)
+{
+    v.push_back(static_cast<uint8_t>(x));
+    v.push_back(static_cast<uint8_t>(x >> 8));
+}
+
+void put32(std::vector<uint8_t> &v, uint32_t x)
+{
+    for (int i = 0; i < 4; i++) {
+        v.push_back(static_cast<uint8_t>(x >> (8 * i)));
+    }
+}
+
+uint16_t get16(const uint8_t *p)
+{
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t get32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+[[noreturn]] void fail(const char *fmt, const std::string &arg)
+{
+    std::fprintf(stderr, "asset_pack: ");
+    std::fprintf(stderr, fmt, arg.c_str());
+    std::fprintf(stderr, "\n");
+    std::exit(1);
+}
+
+bool read_file(const std::string &path, std::string &out)
+{
+    FILE *f = std::fopen(path.c_str(), "rb");
+    if (!f) {
+        return false;
+    }
+    char tmp[65536];
+    size_t n;
+    out.clear();
+    while ((n = std::fread(tmp, 1, sizeof(tmp), f)) > 0) {
+        out.append(tmp, n);
+    }
+    std::fclose(f);
+    return true;
+}
+
+bool ends_with(const std::string &s, const char *suffix)
+{
+    size_t n = std::strlen(suffix);
+    if (s.size() < n) {
+        return false;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (std::tolower(static_cast<unsigned char>(s[s.size() - n + i])) != suffix[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* UTF-8 decode, invalid bytes as U+FFFD (same rules as FlashAsset_Utf8Next) */
+std::vector<uint32_t> utf8_decode(const std::string &s)
+{
+    std::vector<uint32_t> out;
+    size_t i = 0;
+    while (i < s.size()) {
+        uint32_t c = static_cast<uint8_t>(s[i]), min;
+        size_t n;
+        if (c < 0x80) {
+            out.push_back(c);
+            i++;
+            continue;
+        }
+        if ((c & 0xE0) == 0xC0) {
+            n = 1; c &= 0x1F; min = 0x80;
+        } else if ((c & 0xF0) == 0xE0) {
+            n = 2; c &= 0x0F; min = 0x800;
+        } else if ((c & 0xF8) == 0xF0) {
+            n = 3; c &= 0x07; min = 0x10000;
+        } else {
+            out.push_back(kReplacement);
+            i++;
+            continue;
+        }
+        bool ok = true;
+        for (size_t k = 1; ok && k <= n; k++) {
+            ok = i + k < s.size() && (static_cast<uint8_t>(s[i + k]) & 0xC0) == 0x80;
+            if (ok) {
+                c = (c << 6) | (static_cast<uint8_t>(s[i + k]) & 0x3F);
+            }
+        }
+        if (!ok || c < min || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) {
+            out.push_back(kReplacement);
+            i++;
+            continue;
+        }
+        out.push_back(c);
+        i += n + 1;
+    }
+    return out;
+}
+
+bool parse_size(const std::string &s, int &w, int &h)
+{
+    return std::sscanf(s.c_str(), "%dx%d", &w, &h) == 2 && w > 0 && h > 0;
+}
+
+/* ============================================================================
+ * Glyph cell: pixels, packed to OLED page order
+ * ============================================================================ */
+struct Cell {
+    int w, h;
+    std::vector<uint8_t> px;                    // w * h, 1 = lit
+
+    Cell(int w_, int h_) : w(w_), h(h_), px(static_cast<size_t>(w_ * h_), 0) {}
+
+    void set(int x, int y)
+    {
+        if (x >= 0 && x < w && y >= 0 && y < h) {
+            px[static_cast<size_t>(y * w + x)] = 1;
+        }
+    }
+
+    /* For each 8-row page, one byte per column, bit 0 the top row */
+    std::vector<uint8_t> pack() const
+    {
+        std::vector<uint8_t> out;
+        for (int page = 0; page < h / 8; page++) {
+            for (int x = 0; x < w; x++) {
+                uint8_t b = 0;
+                for (int r = 0; r < 8; r++) {
+                    if (px[static_cast<size_t>((page * 8 + r) * w + x)]) {
+                        b |= static_cast<uint8_t>(1u << r);
+                    }
+                }
+                out.push_back(b);
+            }
+        }
+        return out;
+    }
+};
+
+using GlyphMap = std::map<uint32_t, std::vector<uint8_t>>;     // codepoint -> packed
+
+/* ============================================================================
+ * Character sets
+ * ============================================================================ */
+std::vector<uint32_t> parse_chars(const std::string &spec)
+{
+    std::vector<uint32_t> out;
+    size_t pos = 0;
+    while (pos <= spec.size()) {
+        size_t comma = spec.find(',', pos);
+        std::string item = spec.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+        pos = (comma == std::string::npos) ? spec.size() + 1 : comma + 1;
+        if (item.empty()) {
+            continue;
+        }
+
+        auto number = [](const std::string &t, uint32_t &v) {
+            std::string d = t;
+            if (d.size() > 2 && (d[0] == 'U' || d[0] == 'u') && d[1] == '+') {
+                d = "0x" + d.substr(2);
+            }
+            if (d.size() < 3 || d[0] != '0' || (d[1] != 'x' && d[1] != 'X')) {
+                return false;
+            }
+            char *end = nullptr;
+            v = static_cast<uint32_t>(std::strtoul(d.c_str(), &end, 16));
+            return end && *end == '\0';
+        };
+
+        uint32_t a, b;
+        size_t dash = item.find('-');
+        if (item[0] == '@') {
+            std::string text;
+            if (!read_file(item.substr(1), text)) {
+                fail("cannot read %s", item.substr(1));
+            }
+            for (uint32_t c : utf8_decode(text)) {
+                if (c >= 0x20) {
+                    out.push_back(c);
+                }
+            }
+        } else if (dash != std::string::npos && number(item.substr(0, dash), a) &&
+                   number(item.substr(dash + 1), b) && a <= b) {
+            for (uint32_t c = a; c <= b; c++) {
+                out.push_back(c);
+            }
+        } else if (number(item, a)) {
+            out.push_back(a);
+        } else {
+            for (uint32_t c : utf8_decode(item)) {
+                out.push_back(c);
+            }
+        }
+    }
+    return out;
+}
+
+/* Sorted, unique; for C arrays the order given is kept instead */
+std::vector<uint32_t> unique_sorted(std::vector<uint32_t> v)
+{
+    std::sort(v.begin(), v.end());
+    v.erase(std::unique(v.begin(), v.end()), v.end());
+    return v;
+}
+
+/* ============================================================================
+ * Sources
+ * ============================================================================ */
+
+/* Bytes of a C array initializer, comments stripped */
+std::vector<uint8_t> load_c_array(const std::string &spec)
+{
+    size_t colon = spec.rfind(':');
+    if (colon == std::string::npos) {
+        fail("expected FILE:ARRAY, got %s", spec);
+    }
+    std::string path = spec.substr(0, colon), name = spec.substr(colon + 1), src, text;
+    if (!read_file(path, src)) {
+        fail("cannot read %s", path);
+    }
+    for (size_t i = 0; i < src.size(); i++) {
+        if (src.compare(i, 2, "//") == 0) {
+            i = src.find('\n', i);
+            if (i == std::string::npos) {
+                break;
+            }
+        } else if (src.compare(i, 2, "/*") == 0) {
+            i = src.find("*/", i + 2);
+            if (i == std::string::npos) {
+                break;
+            }
+            i++;
+            text += ' ';
+            continue;
+        }
+        text += src[i];
+    }
+
+    size_t at = 0;
+    for (;;) {
+        at = text.find(name, at);
+        if (at == std::string::npos) {
+            fail("array %s not found", name);
+        }
+        bool word = (at == 0 || !(std::isalnum(static_cast<unsigned char>(text[at - 1])) || text[at - 1] == '_')) &&
+                    (at + name.size() < text.size() && (text[at + name.size()] == '[' ||
+                                                        std::isspace(static_cast<unsigned char>(text[at + name.size()]))));
+        size_t eq = text.find('=', at);
+        size_t semi = text.find(';', at);
+        if (word && eq != std::string::npos && eq < semi) {
+            at = eq;
+            break;
+        }
+        at += name.size();
+    }
+
+    size_t open = text.find('{', at);
+    std::vector<uint8_t> out;
+    int depth = 0;
+    for (size_t i = open; i < text.size(); i++) {
+        char c = text[i];
+        if (c == '{') {
+            depth++;
+        } else if (c == '}') {
+            if (--depth == 0) {
+                break;
+            }
+        } else if (std::isdigit(static_cast<unsigned char>(c)) &&
+                   (i == 0 || !std::isalnum(static_cast<unsigned char>(text[i - 1])))) {
+            char *end = nullptr;
+            unsigned long v = std::strtoul(&text[i], &end, 0);
+            out.push_back(static_cast<uint8_t>(v));
+            i = static_cast<size_t>(end - text.data()) - 1;
+        }
+    }
+    return out;
+}
+
+GlyphMap font_from_c_array(const std::string &spec, int w, int h, const std::vector<uint32_t> &chars)
+{
+    std::vector<uint8_t> bytes = load_c_array(spec);
+    size_t gs = static_cast<size_t>(w * h / 8);
+    size_t n = bytes.size() / gs;
+    if (n == 0) {
+        fail("no glyphs in %s", spec);
+    }
+    if (chars.size() > n) {
+        std::fprintf(stderr, "asset_pack: %s has %zu glyphs, %zu characters given: extra dropped\n",
+                     spec.c_str(), n, chars.size());
+    }
+    GlyphMap g;
+    for (size_t i = 0; i < n && i < chars.size(); i++) {
+        g[chars[i]].assign(bytes.begin() + static_cast<long>(i * gs),
+                           bytes.begin() + static_cast<long>((i + 1) * gs));
+    }
+    return g;
+}
+
+GlyphMap font_from_bdf(const std::string &path, int w, int h, const std::vector<uint32_t> &chars)
+{
+    std::string src;
+    if (!read_file(path, src)) {
+        fail("cannot read %s", path);
+    }
+    std::vector<uint32_t> want = unique_sorted(chars);
+
+    struct Bdf {
+        int bw, bh, bx, by;
+        std::vector<std::string> rows;
+    };
+    std::map<uint32_t, Bdf> glyphs;
+    int fbw = w, fbh = h, fbx = 0, fby = 0, ascent = -1, descent = -1;
+    long enc = -1;
+    Bdf cur{};
+    bool in_bitmap = false;
+
+    size_t pos = 0;
+    while (pos < src.size()) {
+        size_t nl = src.find('\n', pos);
+        std::string line = src.substr(pos, nl == std::string::npos ? std::string::npos : nl - pos);
+        pos = (nl == std::string::npos) ? src.size() : nl + 1;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        if (in_bitmap) {
+            if (line == "ENDCHAR") {
+                in_bitmap = false;
+                if (enc >= 0 && std::binary_search(want.begin(), want.end(), static_cast<uint32_t>(enc))) {
+                    glyphs[static_cast<uint32_t>(enc)] = cur;
+                }
+            } else {
+                cur.rows.push_back(line);
+            }
+            continue;
+        }
+        std::sscanf(line.c_str(), "FONTBOUNDINGBOX %d %d %d %d", &fbw, &fbh, &fbx, &fby);
+        std::sscanf(line.c_str(), "FONT_ASCENT %d", &ascent);
+        std::sscanf(line.c_str(), "FONT_DESCENT %d", &descent);
+        if (line.compare(0, 9, "STARTCHAR") == 0) {
+            cur = Bdf{};
+            enc = -1;
+        }
+        std::sscanf(line.c_str(), "ENCODING %ld", &enc);
+        std::sscanf(line.c_str(), "BBX %d %d %d %d", &cur.bw, &cur.bh, &cur.bx, &cur.by);
+        if (line == "BITMAP") {
+            in_bitmap = true;
+        }
+    }
+    if (ascent < 0 || descent < 0) {
+        ascent = fbh + fby;
+        descent = -fby;
+    }
+
+    /* Baseline so the font's ascent + descent sits centred in the cell */
+    int baseline = ascent + (h - (ascent + descent)) / 2;
+    int xshift = (w - fbw) / 2 - fbx;
+
+    GlyphMap g;
+    for (auto &kv : glyphs) {
+        const Bdf &b = kv.second;
+        Cell cell(w, h);
+        int top = baseline - (b.by + b.bh);
+        for (int r = 0; r < b.bh && r < static_cast<int>(b.rows.size()); r++) {
+            const std::string &row = b.rows[static_cast<size_t>(r)];
+            for (int c = 0; c < b.bw; c++) {
+                size_t digit = static_cast<size_t>(c / 4);
+                if (digit >= row.size()) {
+                    break;
+                }
+                int nib = std::isdigit(static_cast<unsigned char>(row[digit])) ? row[digit] - '0'
+                                                                              : (std::toupper(row[digit]) - 'A' + 10);
+                if (nib & (8 >> (c % 4))) {
+                    cell.set(xshift + b.bx + c, top + r);
+                }
+            }
+        }
+        g[kv.first] = cell.pack();
+    }
+    return g;
+}
+
+#ifdef ASSET_PACK_FREETYPE
+GlyphMap font_from_freetype(const std::string &path, int w, int h, const std::vector<uint32_t> &chars)
+{
+    FT_Library lib;
+    FT_Face face;
+    if (FT_Init_FreeType(&lib) != 0 || FT_New_Face(lib, path.c_str(), 0, &face) != 0) {
+        fail("FreeType cannot open %s", path);
+    }
+
+    /* Largest pixel size whose ascent + descent fits the cell height */
+    int px = h;
+    if (FT_IS_SCALABLE(face) && face->ascender - face->descender > 0) {
+        px = static_cast<int>(static_cast<long>(h) * face->units_per_EM /
+                              (face->ascender - face->descender));
+    }
+    FT_Set_Pixel_Sizes(face, 0, static_cast<FT_UInt>(px));
+    int ascent = static_cast<int>((face->size->metrics.ascender + 63) >> 6);
+    int descent = static_cast<int>((-face->size->metrics.descender + 63) >> 6);
+    int baseline = ascent + (h - (ascent + descent)) / 2;
+
+    GlyphMap g;
+    for (uint32_t cp : unique_sorted(chars)) {
+        if (FT_Get_Char_Index(face, cp) == 0 ||
+            FT_Load_Char(face, cp, FT_LOAD_RENDER | FT_LOAD_TARGET_MONO | FT_LOAD_MONOCHROME) != 0) {
+            continue;
+        }
+        FT_GlyphSlot s = face->glyph;
+        int advance = static_cast<int>(s->advance.x >> 6);
+        int x0 = (w - advance) / 2 + s->bitmap_left;
+        int y0 = baseline - s->bitmap_top;
+        Cell cell(w, h);
+        for (unsigned r = 0; r < s->bitmap.rows; r++) {
+            for (unsigned c = 0; c < s->bitmap.width; c++) {
+                const uint8_t *row = s->bitmap.buffer + static_cast<long>(r) * s->bitmap.pitch;
+                bool on = (s->bitmap.pixel_mode == FT_PIXEL_MODE_MONO) ? (row[c / 8] & (0x80 >> (c % 8))) != 0
+                                                                     : row[c] >= 128;
+                if (on) {
+                    cell.set(x0 + static_cast<int>(c), y0 + static_cast<int>(r));
+                }
+            }
+        }
+        g[cp] = cell.pack();
+    }
+    FT_Done_Face(face);
+    FT_Done_FreeType(lib);
+    return g;
+}
+#endif
+
+std::vector<uint8_t> bitmap_from_pbm(const std::string &path, int &w, int &h)
+{
+    std::string src;
+    if (!read_file(path, src) || src.size() < 2 || src[0] != 'P' || (src[1] != '1' && src[1] != '4')) {
+        fail("%s is not a P1/P4 PBM", path);
+    }
+    bool binary = src[1] == '4';
+    size_t pos = 2;
+    auto next_int = [&]() {
+        for (;;) {
+            while (pos < src.size() && std::isspace(static_cast<unsigned char>(src[pos]))) {
+                pos++;
+            }
+            if (pos < src.size() && src[pos] == '#') {
+                pos = src.find('\n', pos);
+                continue;
+            }
+            break;
+        }
+        int v = 0;
+        while (pos < src.size() && std::isdigit(static_cast<unsigned char>(src[pos]))) {
+            v = v * 10 + (src[pos++] - '0');
+        }
+        return v;
+    };
+    int pw = next_int(), ph = next_int();
+    pos++;                                      // Single whitespace before P4 data
+    if (pw <= 0 || ph <= 0) {
+        fail("bad PBM size in %s", path);
+    }
+
+    w = pw;
+    h = (ph + 7) / 8 * 8;
+    Cell cell(w, h);
+    size_t stride = static_cast<size_t>((pw + 7) / 8);
+    for (int y = 0; y < ph; y++) {
+        for (int x = 0; x < pw; x++) {
+            bool on;
+            if (binary) {
+                size_t i = pos + static_cast<size_t>(y) * stride + static_cast<size_t>(x / 8);
+                on = i < src.size() && (static_cast<uint8_t>(src[i]) & (0x80 >> (x % 8)));
+            } else {
+                while (pos < src.size() && src[pos] != '0' && src[pos] != '1') {
+                    pos++;
+                }
+                on = pos < src.size() && src[pos++] == '1';
+            }
+            if (on) {
+                cell.set(x, y);
+            }
+        }
+    }
+    return cell.pack();
+}
+
+/* ============================================================================
+ * Entries
+ * ============================================================================ */
+struct Entry {
+    std::string name;
+    uint8_t type;
+    int w, h;
+    uint16_t ranges = 0;
+    uint16_t fallback = 0;
+    std::vector<uint8_t> data;
+    size_t glyphs = 0, filled = 0;
+};
+
+/* Range table + glyphs; nearest ranges merged down to max_ranges */
+Entry build_font(const std::string &name, int w, int h, GlyphMap g, size_t max_ranges)
+{
+    if (g.empty()) {
+        fail("font %s: none of the characters are in the source", name);
+    }
+
+    /* Fallback: U+FFFD, else '?', else a blank glyph added as U+FFFD */
+    uint32_t fb_cp = g.count(kReplacement) ? kReplacement : (g.count('?') ? '?' : kReplacement);
+    if (!g.count(fb_cp)) {
+        g[fb_cp] = Cell(w, h).pack();
+    }
+    const std::vector<uint8_t> fallback = g[fb_cp];
+
+    struct Range {
+        uint32_t first, count;
+    };
+    std::vector<Range> ranges;
+    for (auto &kv : g) {
+        if (!ranges.empty() && ranges.back().first + ranges.back().count == kv.first) {
+            ranges.back().count++;
+        } else {
+            ranges.push_back({kv.first, 1});
+        }
+    }
+    size_t filled = 0;
+    while (ranges.size() > max_ranges) {
+        size_t best = 0;
+        uint32_t best_gap = UINT32_MAX;
+        for (size_t i = 0; i + 1 < ranges.size(); i++) {
+            uint32_t gap = ranges[i + 1].first - (ranges[i].first + ranges[i].count);
+            if (gap < best_gap) {
+                best_gap = gap;
+                best = i;
+            }
+        }
+        for (uint32_t cp = ranges[best].first + ranges[best].count; cp < ranges[best + 1].first; cp++) {
+            g[cp] = fallback;
+        }
+        filled += best_gap;
+        ranges[best].count += best_gap + ranges[best + 1].count;
+        ranges.erase(ranges.begin() + static_cast<long>(best) + 1);
+    }
+    if (g.size() > 0xFFFF) {
+        fail("font %s: more than 65535 glyphs after merging ranges", name);
+    }
+
+    Entry e{name, kTypeFont, w, h, 0, 0, {}, 0, 0};
+    e.ranges = static_cast<uint16_t>(ranges.size());
+    for (const Range &r : ranges) {
+        put32(e.data, r.first);
+        put32(e.data, r.count);
+    }
+    uint16_t index = 0;
+    for (auto &kv : g) {
+        if (kv.first == fb_cp) {
+            e.fallback = index;
+        }
+        e.data.insert(e.data.end(), kv.second.begin(), kv.second.end());
+        index++;
+    }
+    e.glyphs = g.size();
+    e.filled = filled;
+    return e;
+}
+
+std::vector<uint8_t> write_image(const std::vector<Entry> &entries)
+{
+    std::vector<uint8_t> dir, data;
+    size_t data_start = kHeaderSize + entries.size() * kEntrySize;
+
+    for (const Entry &e : entries) {
+        while (data.size() % 4) {
+            data.push_back(0xFF);
+        }
+        for (size_t i = 0; i < kNameLen; i++) {
+            dir.push_back(i < e.name.size() ? static_cast<uint8_t>(e.name[i]) : 0);
+        }
+        dir.push_back(e.type);
+        dir.push_back(static_cast<uint8_t>(e.w));
+        dir.push_back(static_cast<uint8_t>(e.h));
+        dir.push_back(0xFF);
+        put32(dir, static_cast<uint32_t>(data_start + data.size()));
+        put32(dir, static_cast<uint32_t>(e.data.size()));
+        put16(dir, e.ranges);
+        put16(dir, e.fallback);
+        data.insert(data.end(), e.data.begin(), e.data.end());
+    }
+
+    std::vector<uint8_t> img;
+    put32(img, kMagic);
+    put16(img, kVersion);
+    put16(img, static_cast<uint16_t>(entries.size()));
+    put32(img, static_cast<uint32_t>(data_start + data.size()));
+    put32(img, crc32(0, dir.data(), dir.size()));
+    put32(img, crc32(0, data.data(), data.size()));
+    while (img.size() < kHeaderSize) {
+        img.push_back(0xFF);
+    }
+    img.insert(img.end(), dir.begin(), dir.end());
+    img.insert(img.end(), data.begin(), data.end());
+    return img;
+}
+
+/* ============================================================================
+ * Preview: the device lookup, drawn as text
+ * ============================================================================ */
+int show(const std::string &path, const std::string &name, const std::string &text)
+{
+    std::string raw;
+    if (!read_file(path, raw) || raw.size() < kHeaderSize) {
+        fail("cannot read %s", path);
+    }
+    const uint8_t *img = reinterpret_cast<const uint8_t *>(raw.data());
+    if (get32(img) != kMagic) {
+        fail("%s is not an asset image", path);
+    }
+    uint16_t count = get16(img + 6);
+    for (uint16_t i = 0; i < count; i++) {
+        const uint8_t *d = img + kHeaderSize + i * kEntrySize;
+        if (std::strncmp(reinterpret_cast<const char *>(d), name.c_str(), kNameLen) != 0) {
+            continue;
+        }
+        int w = d[9], h = d[10];
+        const uint8_t *data = img + get32(d + 12);
+        size_t gs = static_cast<size_t>(w * h / 8);
+        std::vector<const uint8_t *> cells;
+
+        if (d[8] == kTypeBitmap) {
+            cells.push_back(data);
+        } else {
+            uint16_t ranges = get16(d + 20), fallback = get16(d + 22);
+            const uint8_t *glyphs = data + ranges * 8u;
+            for (uint32_t cp : utf8_decode(text)) {
+                uint32_t base = 0, index = fallback;
+                for (uint16_t r = 0; r < ranges; r++) {
+                    uint32_t first = get32(data + r * 8u), n = get32(data + r * 8u + 4);
+                    if (cp >= first && cp - first < n) {
+                        index = base + cp - first;
+                        break;
+                    }
+                    base += n;
+                }
+                cells.push_back(glyphs + index * gs);
+            }
+        }
+        for (int y = 0; y < h; y++) {
+            std::string line;
+            for (const uint8_t *c : cells) {
+                for (int x = 0; x < w; x++) {
+                    line += (c[(y / 8) * w + x] >> (y % 8)) & 1 ? '#' : '.';
+                }
+            }
+            std::printf("%s\n", line.c_str());
+        }
+        return 0;
+    }
+    fail("no entry %s", name);
+}
+
+void usage()
+{
+    std::fprintf(stderr,
+        "usage: asset_pack -o IMAGE [--max-ranges N] [--region BYTES]\n"
+        "                  (--font NAME WxH SRC [--chars SPEC] | --bitmap NAME WxH|- SRC) ...\n"
+        "       asset_pack --show IMAGE NAME [TEXT]\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::string out_path;
+    size_t max_ranges = 32, region = 0x300000;
+    struct Spec {
+        bool font;
+        std::string name, size, src, chars;
+    };
+    std::vector<Spec> specs;
+
+    if (argc >= 4 && std::string(argv[1]) == "--show") {
+        return show(argv[2], argv[3], argc > 4 ? argv[4] : "");
+    }
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        if (a == "-o" && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (a == "--max-ranges" && i + 1 < argc) {
+            max_ranges = std::strtoul(argv[++i], nullptr, 0);
+        } else if (a == "--region" && i + 1 < argc) {
+            region = std::strtoul(argv[++i], nullptr, 0);
+        } else if ((a == "--font" || a == "--bitmap") && i + 3 < argc) {
+            specs.push_back({a == "--font", argv[i + 1], argv[i + 2], argv[i + 3], ""});
+            i += 3;
+        } else if (a == "--chars" && i + 1 < argc && !specs.empty() && specs.back().font) {
+            specs.back().chars = argv[++i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (out_path.empty() || specs.empty() || max_ranges == 0 || max_ranges > 32) {
+        usage();
+        return 2;
+    }
+    if (specs.size() > kMaxEntries) {
+        fail("more than %s entries", std::to_string(kMaxEntries));
+    }
+
+    std::vector<Entry> entries;
+    for (const Spec &s : specs) {
+        int w = 0, h = 0;
+        if (s.name.empty() || s.name.size() > kNameLen) {
+            fail("name '%s' must be 1..8 characters", s.name);
+        }
+        if (!s.font) {
+            Entry e{s.name, kTypeBitmap, 0, 0, 0, 0, {}, 0, 0};
+            if (ends_with(s.src, ".pbm")) {
+                e.data = bitmap_from_pbm(s.src, e.w, e.h);
+            } else if (parse_size(s.size, w, h) && h % 8 == 0) {
+                e.data = load_c_array(s.src);
+                e.w = w;
+                e.h = h;
+                if (e.data.size() < static_cast<size_t>(w * h / 8)) {
+                    fail("%s is shorter than its size", s.src);
+                }
+                e.data.resize(static_cast<size_t>(w * h / 8));
+            } else {
+                fail("bitmap %s needs WxH (H a multiple of 8) for a C array", s.name);
+            }
+            if (e.w > 255 || e.h > 248) {
+                fail("bitmap %s is larger than 255x248", s.name);
+            }
+            entries.push_back(e);
+            continue;
+        }
+
+        if (!parse_size(s.size, w, h) || h % 8 != 0 || w > 255 || h > 248) {
+            fail("font size %s: WxH, H a multiple of 8", s.size);
+        }
+        if (static_cast<size_t>(w * h / 8) > kGlyphMax) {
+            fail("font %s: glyphs over 32 bytes do not fit the device glyph cache", s.name);
+        }
+        std::vector<uint32_t> chars = parse_chars(s.chars.empty() ? "0x20-0x7E" : s.chars);
+        GlyphMap g;
+        if (ends_with(s.src, ".bdf")) {
+            g = font_from_bdf(s.src, w, h, chars);
+        } else if (ends_with(s.src, ".ttf") || ends_with(s.src, ".otf") || ends_with(s.src, ".ttc")) {
+#ifdef ASSET_PACK_FREETYPE
+            g = font_from_freetype(s.src, w, h, chars);
+#else
+            fail("%s: rebuild with -DASSET_PACK_FREETYPE for TrueType sources", s.src);
+#endif
+        } else {
+            g = font_from_c_array(s.src, w, h, chars);
+        }
+        size_t asked = unique_sorted(chars).size();
+        Entry e = build_font(s.name, w, h, g, max_ranges);
+        if (g.size() < asked) {
+            std::fprintf(stderr, "asset_pack: %s: %zu of %zu characters not in %s\n",
+                         s.name.c_str(), asked - g.size(), asked, s.src.c_str());
+        }
+        entries.push_back(e);
+    }
+
+    std::vector<uint8_t> img = write_image(entries);
+    if (img.size() > region) {
+        fail("image is larger than the region (%s bytes)", std::to_string(region));
+    }
+    FILE *f = std::fopen(out_path.c_str(), "wb");
+    if (!f || std::fwrite(img.data(), 1, img.size(), f) != img.size()) {
+        fail("cannot write %s", out_path);
+    }
+    std::fclose(f);
+
+    for (const Entry &e : entries) {
+        if (e.type == kTypeFont) {
+            std::printf("%-8s font   %3dx%-3d %6zu glyphs (%zu gap fill), %2u ranges, %8zu bytes\n",
+                        e.name.c_str(), e.w, e.h, e.glyphs, e.filled, e.ranges, e.data.size());
+        } else {
+            std::printf("%-8s bitmap %3dx%-3d %48zu bytes\n", e.name.c_str(), e.w, e.h, e.data.size());
+        }
+    }
+    std::printf("%zu bytes, program at FLASH_ASSET_ADDR (0x100000)\n", img.size());
+    return 0;
+}
@@ -0,0 +1,489 @@
+/**
+ * @file    dump_recv.cpp
+ * @brief   Host receiver for the bulk-dump protocol (Components/bulk_dump)
+ * @details Pulls a flash address range, or the sample-log records in a
+ *          timestamp range, from the board over USART1 and writes them to
+ *          a file:
+ *            address mode: the raw bytes [start, end)
+ *            time mode:    the records as [u16 len][record] ...
+ *
+ *          With --resume an existing output file is continued: address
+ *          mode asks again from start + file size, time mode from the
+ *          timestamp after the last complete record.
+ *
+ *          Build:  make                (build/dump_recv; make check runs test_dump)
+ *          Use:    dump_recv -d /dev/ttyUSB0 --addr 0x400000 0x800000 -o log.bin
+ *                  dump_recv -d /dev/ttyUSB0 --time 836000000 836086400 -o day.rec
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace {
+
+/* ============================================================================
+ * Protocol constants (match bulk_dump.h)
+ * ============================================================================ */
+constexpr uint8_t kSof0 = 0xA5;
+constexpr uint8_t kSof1 = 0x5A;
+constexpr size_t kHdr = 5;
+constexpr size_t kCrc = 4;
+constexpr size_t kMaxPayload = 4 + 512;
+
+constexpr uint8_t kReq = 0x01;
+constexpr uint8_t kAck = 0x02;
+constexpr uint8_t kNak = 0x03;
+constexpr uint8_t kBye = 0x04;
+constexpr uint8_t kInfo = 0x81;
+constexpr uint8_t kData = 0x82;
+constexpr uint8_t kErr = 0x83;
+
+constexpr uint8_t kModeAddr = 0;
+constexpr uint8_t kModeTime = 1;
+
+constexpr int kReqRetryMs = 500;
+constexpr int kNakRetryMs = 300;
+constexpr int kQuietAckMs = 1000;       // Re-ACK when the line goes quiet
+constexpr int kGiveUpMs = 10000;
+
+using Clock = std::chrono::steady_clock;
+
+int elapsed_ms(Clock::time_point since)
+{
+    return static_cast<int>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - since).count());
+}
+
+uint32_t crc32(uint32_t crc, const uint8_t *p, size_t n)
+{
+    static uint32_t table[256];
+    static bool ready = false;
+    if (!ready) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? (c >> 1) ^ 0xEDB88320u : c >> 1;
+            }
+            table[i] = c;
+        }
+        ready = true;
+    }
+    crc = ~crc;
+    while (n--) {
+        crc = (crc >> 8) ^ table[(crc ^ *p++) & 0xFF];
+    }
+    return ~crc;
+}
+
+void put32(std::vector<uint8_t> &v, uint32_t x)
+{
+    for (int i = 0; i < 4; i++) {
+        v.push_back(static_cast<uint8_t>(x >> (8 * i)));
+    }
+}
+
+uint32_t get32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+/* ============================================================================
+ * Serial link
+ * ============================================================================ */
+class Link {
+public:
+    bool open(const std::string &dev, int baud)
+    {
+        fd_ = ::open(dev.c_str(), O_RDWR | O_NOCTTY);
+        if (fd_ < 0) {
+            std::fprintf(stderr, "open %s: %s\n", dev.c_str(), std::strerror(errno));
+            return false;
+        }
+        termios tio{};
+        if (tcgetattr(fd_, &tio) == 0) {
+            cfmakeraw(&tio);
+            tio.c_cc[VMIN] = 0;
+            tio.c_cc[VTIME] = 0;
+            speed_t sp = baud_const(baud);
+            cfsetispeed(&tio, sp);
+            cfsetospeed(&tio, sp);
+            tcsetattr(fd_, TCSANOW, &tio);      // Not a tty (test pipe): ignored
+            tcflush(fd_, TCIFLUSH);             // Drop frames left over from an earlier run
+        }
+        return true;
+    }
+
+    ~Link()
+    {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    void write_all(const uint8_t *p, size_t n)
+    {
+        while (n > 0) {
+            ssize_t w = ::write(fd_, p, n);
+            if (w < 0) {
+                if (errno == EINTR || errno == EAGAIN) {
+                    continue;
+                }
+                return;
+            }
+            p += w;
+            n -= static_cast<size_t>(w);
+        }
+    }
+
+    void send(uint8_t type, const std::vector<uint8_t> &payload)
+    {
+        std::vector<uint8_t> f = {kSof0, kSof1, type, static_cast<uint8_t>(payload.size()),
+                                  static_cast<uint8_t>(payload.size() >> 8)};
+        f.insert(f.end(), payload.begin(), payload.end());
+        put32(f, crc32(0, &f[2], f.size() - 2));
+        write_all(f.data(), f.size());
+    }
+
+    /* Bytes available within timeout_ms, appended to buf */
+    void read_some(std::vector<uint8_t> &buf, int timeout_ms)
+    {
+        pollfd pfd{fd_, POLLIN, 0};
+        if (::poll(&pfd, 1, timeout_ms) <= 0) {
+            return;
+        }
+        uint8_t tmp[4096];
+        ssize_t n = ::read(fd_, tmp, sizeof(tmp));
+        if (n > 0) {
+            buf.insert(buf.end(), tmp, tmp + n);
+        }
+    }
+
+private:
+    static speed_t baud_const(int baud)
+    {
+        switch (baud) {
+        case 115200: return B115200;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        case 921600: return B921600;
+        default:     return B460800;
+        }
+    }
+
+    int fd_ = -1;
+};
+
+/* ============================================================================
+ * Frame parser
+ * ============================================================================ */
+struct Frame {
+    uint8_t type;
+    std::vector<uint8_t> payload;
+};
+
+class Parser {
+public:
+    /* Next complete, CRC-checked frame from the stream, if any */
+    bool next(std::vector<uint8_t> &in, Frame &out)
+    {
+        for (;;) {
+            while (pos_ + 1 < in.size() && !(in[pos_] == kSof0 && in[pos_ + 1] == kSof1)) {
+                pos_++;
+            }
+            if (pos_ + kHdr > in.size()) {
+                compact(in);
+                return false;
+            }
+            size_t len = in[pos_ + 3] | (in[pos_ + 4] << 8);
+            if (len > kMaxPayload) {
+                errors++;
+                pos_++;
+                continue;
+            }
+            if (pos_ + kHdr + len + kCrc > in.size()) {
+                compact(in);
+                return false;
+            }
+            const uint8_t *f = &in[pos_];
+            if (crc32(0, f + 2, len + 3) != get32(f + kHdr + len)) {
+                errors++;
+                pos_++;                         // Resync inside the bad frame
+                continue;
+            }
+            out.type = f[2];
+            out.payload.assign(f + kHdr, f + kHdr + len);
+            pos_ += kHdr + len + kCrc;
+            return true;
+        }
+    }
+
+    unsigned long errors = 0;
+
+private:
+    void compact(std::vector<uint8_t> &in)
+    {
+        in.erase(in.begin(), in.begin() + static_cast<long>(pos_));
+        pos_ = 0;
+    }
+
+    size_t pos_ = 0;
+};
+
+/* ============================================================================
+ * Resume
+ * ============================================================================ */
+
+/* Time mode: keep whole records, return the timestamp after the last one */
+bool resume_records(const std::string &path, uint32_t &start)
+{
+    FILE *f = std::fopen(path.c_str(), "rb");
+    if (!f) {
+        return true;                            // Nothing to resume
+    }
+    std::vector<uint8_t> data;
+    uint8_t tmp[65536];
+    size_t n;
+    while ((n = std::fread(tmp, 1, sizeof(tmp), f)) > 0) {
+        data.insert(data.end(), tmp, tmp + n);
+    }
+    std::fclose(f);
+
+    size_t pos = 0, good = 0;
+    uint32_t last_ts = 0;
+    bool any = false;
+    while (pos + 2 <= data.size()) {
+        size_t len = data[pos] | (data[pos + 1] << 8);
+        if (pos + 2 + len > data.size()) {
+            break;
+        }
+        if (len >= 4) {
+            last_ts = get32(&data[pos + 2]);
+            any = true;
+        }
+        pos += 2 + len;
+        good = pos;
+    }
+    if (truncate(path.c_str(), static_cast<off_t>(good)) != 0) {
+        return false;
+    }
+    if (any) {
+        start = last_ts + 1;
+    }
+    return true;
+}
+
+void usage()
+{
+    std::fprintf(stderr,
+        "usage: dump_recv -d DEV [-b BAUD] (--addr START END | --time START END) -o FILE\n"
+        "                 [--resume] [--no-enter]\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::string dev, out_path;
+    int baud = 460800;
+    uint8_t mode = 0xFF;
+    uint32_t start = 0, end = 0;
+    bool resume = false, enter = true;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        if (a == "-d" && i + 1 < argc) {
+            dev = argv[++i];
+        } else if (a == "-b" && i + 1 < argc) {
+            baud = std::atoi(argv[++i]);
+        } else if ((a == "--addr" || a == "--time") && i + 2 < argc) {
+            mode = (a == "--addr") ? kModeAddr : kModeTime;
+            start = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+            end = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+        } else if (a == "-o" && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (a == "--resume") {
+            resume = true;
+        } else if (a == "--no-enter") {
+            enter = false;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (dev.empty() || out_path.empty() || mode == 0xFF) {
+        usage();
+        return 2;
+    }
+
+    /* Where to continue from */
+    long long have = 0;
+    if (resume) {
+        if (mode == kModeAddr) {
+            FILE *f = std::fopen(out_path.c_str(), "rb");
+            if (f) {
+                std::fseek(f, 0, SEEK_END);
+                have = std::ftell(f);
+                std::fclose(f);
+            }
+            if (have >= static_cast<long long>(end) - start) {
+                std::printf("already complete\n");
+                return 0;
+            }
+            start += static_cast<uint32_t>(have);
+        } else if (!resume_records(out_path, start)) {
+            std::fprintf(stderr, "cannot trim %s\n", out_path.c_str());
+            return 1;
+        }
+    }
+
+    FILE *out = std::fopen(out_path.c_str(), resume ? "ab" : "wb");
+    if (!out) {
+        std::fprintf(stderr, "open %s: %s\n", out_path.c_str(), std::strerror(errno));
+        return 1;
+    }
+
+    Link link;
+    if (!link.open(dev, baud)) {
+        return 1;
+    }
+    if (enter) {
+        const char *cmd = "\r\ndump\r\n";      // Leading CR/LF clears a partial console line
+        link.write_all(reinterpret_cast<const uint8_t *>(cmd), std::strlen(cmd));
+    }
+
+    std::vector<uint8_t> req;
+    req.push_back(mode);
+    put32(req, start);
+    put32(req, end);
+
+    std::vector<uint8_t> rx;
+    Parser parser;
+    Frame fr;
+    bool started = false, done = false;
+    uint32_t expect = 0;
+    std::map<uint32_t, std::vector<uint8_t>> held;      // Arrived after a gap
+    std::map<uint32_t, Clock::time_point> nak_at;       // Last NAK per missing block
+    unsigned long long bytes = 0;
+    unsigned long naks = 0, dups = 0;
+    auto t_start = Clock::now();
+    auto t_req = Clock::now() - std::chrono::seconds(10);
+    auto t_rx = Clock::now();
+    auto t_quiet = Clock::now();
+
+    while (!done) {
+        if (!started && elapsed_ms(t_req) >= kReqRetryMs) {
+            link.send(kReq, req);
+            t_req = Clock::now();
+        }
+
+        link.read_some(rx, 20);
+        while (parser.next(rx, fr)) {
+            t_rx = Clock::now();
+
+            if (fr.type == kErr) {
+                std::fprintf(stderr, "device rejected request (code %u)\n",
+                             fr.payload.empty() ? 0u : fr.payload[0]);
+                return 1;
+            }
+            if (fr.type == kInfo) {
+                /* Only the answer to this REQ: mode, start and end echoed back */
+                if (!started && fr.payload.size() >= 9 &&
+                    std::equal(req.begin(), req.end(), fr.payload.begin())) {
+                    started = true;
+                    t_start = Clock::now();
+                }
+                continue;
+            }
+            /* DATA before our INFO belongs to an earlier request */
+            if (!started || fr.type != kData || fr.payload.size() < 4) {
+                continue;
+            }
+
+            uint32_t seq = get32(fr.payload.data());
+            std::vector<uint8_t> ack;
+            if (seq == expect) {
+                held[seq].assign(fr.payload.begin() + 4, fr.payload.end());
+                /* Write out this block and any held ones that now follow on */
+                for (auto it = held.begin(); !done && it != held.end() && it->first == expect;
+                     it = held.erase(it)) {
+                    if (!it->second.empty()) {
+                        std::fwrite(it->second.data(), 1, it->second.size(), out);
+                        bytes += it->second.size();
+                    } else {
+                        done = true;            // Empty block: end of data
+                    }
+                    nak_at.erase(expect);
+                    expect++;
+                }
+                put32(ack, expect);
+                link.send(kAck, ack);
+            } else if (seq > expect && seq - expect < 64) {
+                /* Keep it; NAK each block missing before it, again if that NAK got lost */
+                held[seq].assign(fr.payload.begin() + 4, fr.payload.end());
+                for (uint32_t m = expect; m < seq; m++) {
+                    auto at = nak_at.find(m);
+                    if (held.count(m) ||
+                        (at != nak_at.end() && elapsed_ms(at->second) < kNakRetryMs)) {
+                        continue;
+                    }
+                    ack.clear();
+                    put32(ack, m);
+                    link.send(kNak, ack);
+                    nak_at[m] = Clock::now();
+                    naks++;
+                }
+            } else if (seq < expect) {
+                dups++;
+                put32(ack, expect);
+                link.send(kAck, ack);
+            }
+        }
+
+        if (elapsed_ms(t_rx) >= kGiveUpMs) {
+            std::fprintf(stderr, "no response from device, %llu bytes kept (use --resume)\n",
+                         static_cast<unsigned long long>(bytes + have));
+            std::fclose(out);
+            return 1;
+        }
+        if (started && elapsed_ms(t_rx) >= kQuietAckMs && elapsed_ms(t_quiet) >= kQuietAckMs) {
+            std::vector<uint8_t> ack;
+            put32(ack, expect);
+            link.send(kAck, ack);
+            t_quiet = Clock::now();
+        }
+    }
+
+    /* Answer resends of the end block briefly, in case the last ACK got lost */
+    auto t_end = Clock::now();
+    while (elapsed_ms(t_end) < 300) {
+        link.read_some(rx, 20);
+        while (parser.next(rx, fr)) {
+            if (fr.type == kData) {
+                std::vector<uint8_t> ack;
+                put32(ack, expect);
+                link.send(kAck, ack);
+            }
+        }
+    }
+    link.send(kBye, {});
+    std::fclose(out);
+
+    double secs = elapsed_ms(t_start) / 1000.0;
+    std::printf("%llu bytes in %.2f s, %.1f KB/s, %lu bad frames, %lu naks, %lu duplicates\n",
+                static_cast<unsigned long long>(bytes), secs,
+                secs > 0 ? bytes / 1024.0 / secs : 0.0, parser.errors, naks, dups);
+    return 0;
+}
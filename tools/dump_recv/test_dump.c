@@ -0,0 +1,413 @@
+/**
+ * @file    test_dump.c
+ * @brief   bulk_dump end to end: dump_recv over a pty, faults, resume
+ * @details BulkDump runs here on a fake port: a flash image and a sample
+ *          log in RAM, reads that complete a few polls later (as the SPI
+ *          DMA does), and a UART that holds the wire for 10 bits per byte
+ *          at DUMP_BAUD. The frames go through a pseudo terminal to the
+ *          real dump_recv (built next to this test), which writes its file
+ *          as on the board. Every file is compared byte for byte with what
+ *          the range holds.
+ *
+ *          Faults: device frames dropped or with a byte flipped, host
+ *          bytes flipped. Resume: dump_recv is killed while the device
+ *          still has a block read or queued for the transfer, then run
+ *          again with --resume at once, so its REQ (from a different
+ *          start) reaches a device that is still in binary mode.
+ */
+
+#define _XOPEN_SOURCE 600
+
+#include "bulk_dump.h"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DUMP_BAUD       460800
+#define IMG_SIZE        (256u * 1024u)
+#define REC_COUNT       3000
+#define REC_T0          844000000u
+#define MAX_BLOCKS      1024
+
+static int fails;
+
+#define CHECK(c) do { \
+        if (!(c)) { \
+            printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #c); \
+            fails++; \
+        } \
+    } while (0)
+
+/* ============================================================================
+ * Fake flash: raw image and sample log
+ * ============================================================================ */
+static uint8_t img[IMG_SIZE];
+static uint8_t rec[REC_COUNT][40];
+static uint16_t rec_len[REC_COUNT];
+static uint32_t rec_ts[REC_COUNT];
+
+static uint8_t f_mode;
+static uint32_t f_start, f_end;
+static uint32_t f_first[MAX_BLOCKS + 1];    /* Time mode: first record of each block */
+static uint32_t f_known;                    /* ...known up to this block */
+
+/* Read in flight: the address is taken at the start, the bytes land in
+ * the buffer when it completes (as the SPI DMA does) */
+static uint8_t *r_buf;
+static uint32_t r_addr;
+static int32_t r_len;
+static int r_wait;                          /* Polls left, -1: idle */
+static uint32_t run_frames;                 /* stats.frames when dump_recv started */
+
+/* ============================================================================
+ * Fake UART and faults
+ * ============================================================================ */
+static int master = -1;
+static uint8_t outq[1u << 20];
+static size_t out_len;
+static double tx_until;                     /* Wire busy until (µs) */
+static int fault_rate;                      /* Per mille, each kind */
+static long dropped, flipped, host_flipped;
+
+static double now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static uint32_t port_now_ms(void)
+{
+    return (uint32_t)(now_us() / 1000.0);
+}
+
+static uint8_t port_open(void *ctx, uint8_t mode, uint32_t start, uint32_t end)
+{
+    uint32_t i;
+
+    (void)ctx;
+    if (mode == BULKDUMP_MODE_ADDR) {
+        if (start >= end || end > IMG_SIZE) {
+            return 0;
+        }
+    } else {
+        if (start > end) {
+            return 0;
+        }
+        for (i = 0; i < REC_COUNT && rec_ts[i] < start; i++) {
+        }
+        f_first[0] = i;
+        f_known = 0;
+    }
+    f_mode = mode;
+    f_start = start;
+    f_end = end;
+    return 1;
+}
+
+/* Time mode: whole records [u16 len][record] from f_first[seq], as dump_app.c */
+static uint16_t pack(uint32_t seq, uint8_t *buf, uint16_t max)
+{
+    uint32_t i;
+    uint16_t n = 0;
+
+    for (i = f_first[seq]; i < REC_COUNT && rec_ts[i] <= f_end; i++) {
+        if (n + 2u + rec_len[i] > max) {
+            break;
+        }
+        buf[n] = (uint8_t)rec_len[i];
+        buf[n + 1] = (uint8_t)(rec_len[i] >> 8);
+        memcpy(&buf[n + 2], rec[i], rec_len[i]);
+        n = (uint16_t)(n + 2u + rec_len[i]);
+    }
+    if (seq == f_known && seq < MAX_BLOCKS) {
+        f_first[++f_known] = i;
+    }
+    return n;
+}
+
+static uint8_t port_read_start(void *ctx, uint32_t seq, uint8_t *buf, uint16_t max)
+{
+    (void)ctx;
+    if (r_wait >= 0 || (f_mode == BULKDUMP_MODE_TIME && (seq > f_known || seq >= MAX_BLOCKS))) {
+        return 0;
+    }
+    r_buf = buf;
+    r_wait = rand() % 4;
+    if (f_mode == BULKDUMP_MODE_TIME) {
+        r_len = pack(seq, buf, max);
+        return 1;
+    }
+    r_addr = f_start + seq * (uint32_t)max;
+    r_len = (r_addr >= f_end) ? 0 : (int32_t)((f_end - r_addr < max) ? f_end - r_addr : max);
+    return 1;
+}
+
+static int32_t port_read_poll(void *ctx)
+{
+    (void)ctx;
+    if (r_wait > 0) {
+        r_wait--;
+        return -1;
+    }
+    r_wait = -1;
+    if (f_mode == BULKDUMP_MODE_ADDR && r_len > 0) {
+        memcpy(r_buf, &img[r_addr], (size_t)r_len);
+    }
+    return r_len;
+}
+
+static uint8_t port_tx_start(void *ctx, const uint8_t *data, uint16_t len)
+{
+    (void)ctx;
+    if (now_us() < tx_until || out_len + len > sizeof(outq)) {
+        return 0;
+    }
+    tx_until = now_us() + len * 10e6 / DUMP_BAUD;
+    if (rand() % 1000 < fault_rate) {
+        dropped++;
+        return 1;
+    }
+    memcpy(&outq[out_len], data, len);
+    if (rand() % 1000 < fault_rate) {
+        outq[out_len + (size_t)(rand() % len)] ^= (uint8_t)(1u << (rand() % 8));
+        flipped++;
+    }
+    out_len += len;
+    return 1;
+}
+
+static uint8_t port_tx_busy(void *ctx)
+{
+    (void)ctx;
+    return now_us() < tx_until;
+}
+
+static const BulkDump_Port port = {
+    port_open, port_read_start, port_read_poll, port_tx_start, port_tx_busy, port_now_ms, NULL
+};
+
+static BulkDump dump;
+
+/* ============================================================================
+ * Bench
+ * ============================================================================ */
+
+/* One pass: host bytes in, BulkDump_Poll, device bytes out */
+static void pump(void)
+{
+    uint8_t tmp[256];
+    ssize_t n, i;
+
+    while ((n = read(master, tmp, sizeof(tmp))) > 0) {
+        for (i = 0; i < n; i++) {
+            if (rand() % 100000 < fault_rate * 20) {
+                tmp[i] ^= 0x10;
+                host_flipped++;
+            }
+        }
+        BulkDump_Input(&dump, tmp, (uint16_t)n);
+    }
+    BulkDump_Poll(&dump);
+    if (out_len > 0 && (n = write(master, outq, out_len)) > 0) {
+        memmove(outq, &outq[n], out_len - (size_t)n);
+        out_len -= (size_t)n;
+    }
+    usleep(100);
+}
+
+/* A block of this transfer read or queued, and another on the wire */
+static int mid_window(void)
+{
+    int i, ready = 0;
+
+    for (i = 0; i < 2; i++) {
+        ready += dump.bufs[i].state == 1 || dump.bufs[i].state == 2;     /* READING, READY */
+    }
+    return dump.running && dump.sending >= 0 && dump.sending < 2 && ready &&
+           dump.stats.frames - run_frames >= 20;
+}
+
+/* Run dump_recv to the end, or kill it mid window; exit status, -1 killed */
+static int recv_run(const char *tty, const char *mode, uint32_t start, uint32_t end,
+                    const char *out, int resume, int kill_mid)
+{
+    char a[16], b[16];
+    double t0 = now_us();
+    int status;
+    pid_t pid;
+
+    snprintf(a, sizeof(a), "%lu", (unsigned long)start);
+    snprintf(b, sizeof(b), "%lu", (unsigned long)end);
+    if (!dump.active) {
+        BulkDump_Enter(&dump);
+    }
+    run_frames = dump.stats.frames;
+    fflush(stdout);
+    pid = fork();
+    if (pid == 0) {
+        execl("./dump_recv", "dump_recv", "-d", tty, "--no-enter", mode, a, b, "-o", out,
+              resume ? "--resume" : NULL, (char *)NULL);
+        _exit(127);
+    }
+    for (;;) {
+        pump();
+        if (waitpid(pid, &status, WNOHANG) == pid) {
+            /* Its last bytes (BYE) reach the device before the next run */
+            for (t0 = now_us(); now_us() - t0 < 20000.0;) {
+                pump();
+            }
+            return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+        }
+        if ((kill_mid && mid_window()) || now_us() - t0 > 60e6) {
+            kill(pid, SIGKILL);
+            waitpid(pid, &status, 0);
+            return -1;
+        }
+    }
+}
+
+static int file_is(const char *path, const uint8_t *want, size_t n)
+{
+    static uint8_t got[IMG_SIZE + 65536];
+    FILE *f = fopen(path, "rb");
+    size_t len, i;
+
+    if (f == NULL) {
+        return 0;
+    }
+    len = fread(got, 1, sizeof(got), f);
+    fclose(f);
+    if (len != n || memcmp(got, want, n) != 0) {
+        for (i = 0; i < len && i < n && got[i] == want[i]; i++) {
+        }
+        printf("%s: %lu bytes, want %lu, first difference at %lu\n", path, (unsigned long)len,
+               (unsigned long)n, (unsigned long)i);
+        return 0;
+    }
+    return 1;
+}
+
+/* Records with start <= ts <= end, as dump_recv writes them */
+static size_t records(uint32_t start, uint32_t end, uint8_t *out)
+{
+    size_t n = 0;
+    int i;
+
+    for (i = 0; i < REC_COUNT; i++) {
+        if (rec_ts[i] >= start && rec_ts[i] <= end) {
+            out[n] = (uint8_t)rec_len[i];
+            out[n + 1] = (uint8_t)(rec_len[i] >> 8);
+            memcpy(&out[n + 2], rec[i], rec_len[i]);
+            n += 2u + rec_len[i];
+        }
+    }
+    return n;
+}
+
+static void addr_case(const char *tty, const char *name, uint32_t start, uint32_t end, int faults,
+                      int resume)
+{
+    const char *out = "test_dump.bin";
+    int rc;
+
+    fault_rate = faults;
+    remove(out);
+    if (resume) {
+        CHECK(recv_run(tty, "--addr", start, end, out, 0, 1) == -1);
+        CHECK(dump.active);                 /* Still in binary mode, blocks pending */
+    }
+    rc = recv_run(tty, "--addr", start, end, out, resume, 0);
+    CHECK(rc == 0);
+    CHECK(file_is(out, &img[start], end - start));
+    printf("%-22s %6lu bytes, %lu frames dropped, %lu flipped, %lu host bytes flipped\n", name,
+           (unsigned long)(end - start), dropped, flipped, host_flipped);
+    dropped = flipped = host_flipped = 0;
+}
+
+static void time_case(const char *tty, const char *name, uint32_t start, uint32_t end, int faults,
+                      int resume)
+{
+    static uint8_t want[REC_COUNT * 42];
+    const char *out = "test_dump.rec";
+    size_t n = records(start, end, want);
+    int rc;
+
+    fault_rate = faults;
+    remove(out);
+    if (resume) {
+        CHECK(recv_run(tty, "--time", start, end, out, 0, 1) == -1);
+        CHECK(dump.active);
+    }
+    rc = recv_run(tty, "--time", start, end, out, resume, 0);
+    CHECK(rc == 0);
+    CHECK(file_is(out, want, n));
+    printf("%-22s %6lu bytes, %lu frames dropped, %lu flipped, %lu host bytes flipped\n", name,
+           (unsigned long)n, dropped, flipped, host_flipped);
+    dropped = flipped = host_flipped = 0;
+}
+
+int main(int argc, char **argv)
+{
+    struct termios tio;
+    uint32_t ts = REC_T0;
+    int slave, i, j;
+
+    srand(argc > 1 ? (unsigned)atoi(argv[1]) : 1u);
+    for (i = 0; i < (int)IMG_SIZE; i++) {
+        img[i] = (uint8_t)rand();
+    }
+    for (i = 0; i < REC_COUNT; i++) {
+        ts += 1u + (uint32_t)(rand() % 5);
+        rec_ts[i] = ts;
+        rec_len[i] = (uint16_t)(8 + rand() % 33);
+        memcpy(rec[i], &ts, 4);
+        for (j = 4; j < rec_len[i]; j++) {
+            rec[i][j] = (uint8_t)rand();
+        }
+    }
+
+    /* The pty stays open on this side too, raw, so dump_recv runs come and go */
+    master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        perror("pty");
+        return 1;
+    }
+    slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+    if (slave < 0 || tcgetattr(slave, &tio) != 0) {
+        perror("pty");
+        return 1;
+    }
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+    fcntl(master, F_SETFL, O_NONBLOCK);
+
+    BulkDump_Init(&dump, &port);
+    r_wait = -1;
+
+    addr_case(ptsname(master), "addr clean", 0x1234, 0x1234 + 40000, 0, 0);
+    addr_case(ptsname(master), "addr faults", 0x20000, 0x20000 + 60000, 30, 0);
+    time_case(ptsname(master), "time faults", REC_T0 + 1000, REC_T0 + 7000, 30, 0);
+    addr_case(ptsname(master), "addr resume", 0x100, 0x100 + 60000, 0, 1);
+    addr_case(ptsname(master), "addr resume + faults", 0x8000, 0x8000 + 60000, 20, 1);
+    time_case(ptsname(master), "time resume", REC_T0 + 500, REC_T0 + 8000, 0, 1);
+
+    printf("device: %lu frames, %lu resent, %lu naks, %lu timeouts, %lu bad host frames\n",
+           (unsigned long)dump.stats.frames, (unsigned long)dump.stats.resends,
+           (unsigned long)dump.stats.naks, (unsigned long)dump.stats.timeouts,
+           (unsigned long)dump.stats.rx_errors);
+    remove("test_dump.bin");
+    remove("test_dump.rec");
+    close(slave);
+    printf("%s\n", fails ? "FAILED" : "ALL OK");
+    return fails != 0;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file    emu_test.h
+ * @brief   Shared setup for the host tests on nor_emu + spi_shim
+ * @details Each test is one program: a fresh image named after it in the
+ *          current directory, the GD25Q64 timing, CHECK() counting
+ *          failures, and exit status 0 only if nothing failed and the chip
+ *          saw no protocol violation.
+ */
+
+#ifndef __EMU_TEST_H__
+#define __EMU_TEST_H__
+
+#include "md25q64.h"
+#include "nor_emu.h"
+#include "spi_shim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static int emu_fails;
+static SPI_HandleTypeDef emu_spi;
+static GPIO_TypeDef emu_cs_port;
+static DMA_HandleTypeDef emu_dma_tx, emu_dma_rx;
+static char emu_image[256];
+
+#define CHECK(c) do { \
+        if (!(c)) { \
+            printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #c); \
+            emu_fails++; \
+        } \
+    } while (0)
+
+/* Erased image NAME.img, seed from argv[1] (default 1) */
+static inline void emu_open(const char *name, int argc, char **argv)
+{
+    char wear[300];
+
+    srand(argc > 1 ? (unsigned)atoi(argv[1]) : 1u);
+    snprintf(emu_image, sizeof(emu_image), "%s.img", name);
+    snprintf(wear, sizeof(wear), "%s.wear", emu_image);
+    unlink(emu_image);
+    unlink(wear);
+    if (nor_open(emu_image, &nor_timing_gd25q64) != 0) {
+        printf("cannot open %s\n", emu_image);
+        exit(2);
+    }
+}
+
+/* SPI with or without the DMA channels, driver state from scratch */
+static inline MD25Q64_Status emu_init(MD25Q64_Handle *h, int use_dma)
+{
+    emu_spi.hdmatx = use_dma ? &emu_dma_tx : NULL;
+    emu_spi.hdmarx = use_dma ? &emu_dma_rx : NULL;
+    return MD25Q64_Init(h, &emu_spi, &emu_cs_port, 12);
+}
+
+/* Poll until the queue drains, time passing in steps of us */
+static inline void emu_drain(MD25Q64_Handle *h, uint32_t us)
+{
+    while (!MD25Q64_IsIdle(h)) {
+        nor_now_us += us;
+        MD25Q64_Poll(h);
+    }
+}
+
+static inline int emu_finish(void)
+{
+    if (nor_stats.violations != 0) {
+        printf("FAIL %ld protocol violations (NOR_VERBOSE=1 lists them)\n", nor_stats.violations);
+        emu_fails++;
+    }
+    nor_close();
+    printf("%s\n", emu_fails ? "FAILED" : "ALL OK");
+    return emu_fails != 0;
+}
+
+#endif /* __EMU_TEST_H__ */
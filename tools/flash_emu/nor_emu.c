@@ -0,0 +1,405 @@
+/**
+ * @file    nor_emu.c
+ * @brief   File-backed MD25Q64 SPI NOR emulator, see nor_emu.h
+ */
+
+#include "nor_emu.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* ============================================================================
+ * State
+ * ============================================================================ */
+const NorTiming nor_timing_gd25q64 = {700, 45000, 150000, 200000, 25000000, 5000, 20, 400};
+
+uint64_t nor_now_us;
+NorTiming nor_timing;
+NorStats nor_stats;
+uint32_t *nor_wear;
+
+static uint8_t *mem;
+static int mem_fd = -1, wear_fd = -1;
+
+static uint64_t busy_until, susp_remaining;
+static int wel, suspended, busy_erase, cs, powered_down;
+static uint32_t erase_lo, erase_hi;     /* Block of the last erase, for suspend */
+
+static uint8_t cmd[8];                  /* Opcode and address of this CS frame */
+static uint32_t ncmd;                   /* Bytes clocked in this CS frame */
+static uint8_t pp_buf[256];             /* Page program latch, last 256 bytes win */
+static uint32_t rd_addr;
+
+static long cut_budget = -1;
+static jmp_buf *cut_env;
+
+int nor_busy(void)
+{
+    return nor_now_us < busy_until;
+}
+
+static void violation(const char *what)
+{
+    nor_stats.violations++;
+    if (getenv("NOR_VERBOSE") != NULL) {
+        fprintf(stderr, "nor: %s\n", what);
+    }
+}
+
+/* ============================================================================
+ * Image
+ * ============================================================================ */
+int nor_open(const char *image_path, const NorTiming *timing)
+{
+    char wear_path[512];
+    struct stat st;
+    int fresh;
+
+    nor_timing = *timing;
+    mem_fd = open(image_path, O_RDWR | O_CREAT, 0644);
+    if (mem_fd < 0 || fstat(mem_fd, &st) != 0) {
+        return -1;
+    }
+    fresh = (st.st_size != NOR_SIZE);
+    if (fresh && ftruncate(mem_fd, NOR_SIZE) != 0) {
+        return -1;
+    }
+    mem = mmap(NULL, NOR_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, mem_fd, 0);
+    if (mem == MAP_FAILED) {
+        return -1;
+    }
+    if (fresh) {
+        memset(mem, 0xFF, NOR_SIZE);            /* Shipped erased */
+    }
+
+    snprintf(wear_path, sizeof(wear_path), "%s.wear", image_path);
+    wear_fd = open(wear_path, O_RDWR | O_CREAT, 0644);
+    if (wear_fd < 0 || fstat(wear_fd, &st) != 0) {
+        return -1;
+    }
+    if (st.st_size != NOR_SECTORS * 4 && ftruncate(wear_fd, NOR_SECTORS * 4) != 0) {
+        return -1;
+    }
+    nor_wear = mmap(NULL, NOR_SECTORS * 4, PROT_READ | PROT_WRITE, MAP_SHARED, wear_fd, 0);
+    if (nor_wear == MAP_FAILED) {
+        return -1;
+    }
+    if (fresh) {
+        memset(nor_wear, 0, NOR_SECTORS * 4);
+    }
+    memset(&nor_stats, 0, sizeof(nor_stats));
+    nor_power_cycle();
+    return 0;
+}
+
+void nor_close(void)
+{
+    msync(mem, NOR_SIZE, MS_SYNC);
+    munmap(mem, NOR_SIZE);
+    close(mem_fd);
+    munmap(nor_wear, NOR_SECTORS * 4);
+    close(wear_fd);
+}
+
+uint8_t *nor_mem(void)
+{
+    return mem;
+}
+
+void nor_power_cycle(void)
+{
+    busy_until = 0;
+    wel = 0;
+    suspended = 0;
+    busy_erase = 0;
+    cs = 0;
+    ncmd = 0;
+    powered_down = 0;
+}
+
+/* ============================================================================
+ * Power cuts
+ * ============================================================================ */
+void nor_arm_cut(long budget, jmp_buf *env)
+{
+    cut_budget = budget;
+    cut_env = env;
+}
+
+void nor_disarm_cut(void)
+{
+    cut_budget = -1;
+}
+
+/* Spend budget; the units left when the cut falls inside this step, else -1 */
+static long cut_take(long units)
+{
+    long left;
+
+    if (cut_budget < 0) {
+        return -1;
+    }
+    if (cut_budget > units) {
+        cut_budget -= units;
+        return -1;
+    }
+    left = cut_budget;
+    cut_budget = -1;
+    return left;
+}
+
+static void cut_now(void)
+{
+    nor_power_cycle();
+    longjmp(*cut_env, 1);
+}
+
+/* ============================================================================
+ * Array operations
+ * ============================================================================ */
+static void do_erase(uint32_t addr, uint32_t len, uint32_t t_us)
+{
+    uint32_t s;
+
+    addr &= ~(len - 1u);
+    if (cut_take(40) >= 0) {
+        /* Torn erase: a prefix erased, the rest left with disturbed bytes */
+        uint32_t k = (uint32_t)rand() % len;
+        memset(mem + addr, 0xFF, k);
+        for (s = k; s < len; s += 1u + (uint32_t)rand() % 13u) {
+            mem[addr + s] = (uint8_t)rand();
+        }
+        cut_now();
+    }
+    memset(mem + addr, 0xFF, len);
+    for (s = addr / 4096u; s < (addr + len) / 4096u; s++) {
+        nor_wear[s]++;
+    }
+    erase_lo = addr;
+    erase_hi = addr + len;
+    busy_erase = 1;
+    busy_until = nor_now_us + t_us;
+    nor_stats.erases++;
+}
+
+static void do_program(uint32_t addr, uint32_t n)
+{
+    uint32_t page = addr & ~255u;
+    uint32_t i = (n > 256u) ? n - 256u : 0u;
+
+    for (; i < n; i++) {
+        uint32_t at = page | ((addr + i) & 255u);   /* Wraps inside the page */
+        uint8_t d = pp_buf[i & 255u];
+        if (cut_take(1) >= 0) {
+            mem[at] &= (uint8_t)(d | rand());        /* Some bits made it */
+            cut_now();
+        }
+        mem[at] &= d;
+    }
+    busy_until = nor_now_us + nor_timing.t_pp_us;
+    nor_stats.programs++;
+}
+
+/* ============================================================================
+ * Command decoder
+ * ============================================================================ */
+
+/* Commands execute on CS rising edge */
+static void frame_end(void)
+{
+    uint8_t c = cmd[0];
+    uint32_t a;
+
+    if (ncmd == 0) {
+        return;
+    }
+    a = (ncmd >= 4) ? ((uint32_t)cmd[1] << 16 | (uint32_t)cmd[2] << 8 | cmd[3]) : 0;
+    switch (c) {
+    case 0x05: case 0x35: case 0x15: case 0x03: case 0x0B: case 0x9F: case 0x90:
+        return;                                 /* Reads act while clocked */
+    default:
+        break;
+    }
+    nor_stats.cmds++;
+    if (powered_down && c != 0xAB) {
+        violation("command in power-down");
+        return;
+    }
+    if (c == 0x75) {
+        if (!nor_busy() || suspended) {
+            return;
+        }
+        if (!busy_erase) {
+            violation("program suspend not modelled");
+            return;
+        }
+        if (busy_until - nor_now_us <= nor_timing.t_sus_us) {
+            return;                             /* Finishes anyway */
+        }
+        susp_remaining = busy_until - nor_now_us;
+        busy_until = nor_now_us + nor_timing.t_sus_us;
+        suspended = 1;
+        nor_stats.suspends++;
+        return;
+    }
+    if (c == 0x7A) {
+        if (!suspended) {
+            return;
+        }
+        if (nor_busy()) {
+            violation("resume during tSUS");
+            return;
+        }
+        suspended = 0;
+        busy_until = nor_now_us + susp_remaining;
+        nor_stats.resumes++;
+        return;
+    }
+    if (nor_busy()) {
+        violation("command while WIP");
+        return;
+    }
+    if (suspended && c != 0x06 && c != 0x04 && c != 0xAB) {
+        violation("command while suspended");
+        return;
+    }
+    busy_erase = 0;
+
+    switch (c) {
+    case 0x06:
+        wel = 1;
+        nor_stats.wrens++;
+        break;
+    case 0x04:
+        wel = 0;
+        break;
+    case 0x01: case 0x31: case 0x11:
+        if (!wel) { violation("WRSR without WEL"); break; }
+        busy_until = nor_now_us + nor_timing.t_wrsr_us;
+        wel = 0;
+        break;
+    case 0x02:
+        if (!wel) { violation("PP without WEL"); break; }
+        wel = 0;
+        if (ncmd > 4) {
+            do_program(a, ncmd - 4);
+        }
+        break;
+    case 0x20:
+        if (!wel) { violation("SE without WEL"); break; }
+        wel = 0;
+        do_erase(a, 4096u, nor_timing.t_se_us);
+        break;
+    case 0x52:
+        if (!wel) { violation("BE32 without WEL"); break; }
+        wel = 0;
+        do_erase(a, 32768u, nor_timing.t_be32_us);
+        break;
+    case 0xD8:
+        if (!wel) { violation("BE64 without WEL"); break; }
+        wel = 0;
+        do_erase(a, 65536u, nor_timing.t_be64_us);
+        break;
+    case 0x60: case 0xC7:
+        if (!wel) { violation("CE without WEL"); break; }
+        wel = 0;
+        do_erase(0, NOR_SIZE, nor_timing.t_ce_us);
+        break;
+    case 0xB9:
+        powered_down = 1;
+        break;
+    case 0xAB:
+        powered_down = 0;
+        break;
+    default:
+        break;
+    }
+}
+
+void nor_cs(int asserted)
+{
+    if (asserted) {
+        cs = 1;
+        ncmd = 0;
+        return;
+    }
+    if (cs) {
+        cs = 0;
+        frame_end();
+    }
+}
+
+/* Byte the chip drives on MISO at position pos of the frame */
+static uint8_t out_byte(uint32_t pos)
+{
+    static const uint8_t id[3] = {0xC8, 0x40, 0x17};
+    uint32_t first, at;
+
+    switch (cmd[0]) {
+    case 0x05:
+        if (pos == 1) {
+            nor_stats.rdsr++;                   /* Once per status read */
+        }
+        return (uint8_t)((nor_busy() ? 0x01 : 0) | (wel ? 0x02 : 0));
+    case 0x35:
+        return (uint8_t)(suspended ? 0x80 : 0);
+    case 0x15:
+        return 0x60;
+    case 0x9F:
+        return (pos >= 1 && pos <= 3) ? id[pos - 1] : 0xFF;
+    case 0x90:
+        return (pos >= 4) ? ((pos & 1u) ? 0x16 : 0xC8) : 0xFF;
+    case 0xAB:
+        return (pos >= 4) ? 0x16 : 0xFF;
+    case 0x03: case 0x0B:
+        first = (cmd[0] == 0x03) ? 4u : 5u;     /* Fast read has a dummy byte */
+        if (pos < first) {
+            return 0xFF;
+        }
+        if (pos == first) {
+            rd_addr = (uint32_t)cmd[1] << 16 | (uint32_t)cmd[2] << 8 | cmd[3];
+            if (nor_busy()) {
+                violation("read while WIP");
+            }
+        }
+        at = rd_addr % NOR_SIZE;
+        rd_addr++;
+        if (suspended && at >= erase_lo && at < erase_hi) {
+            violation("read inside suspended erase");
+            return (uint8_t)rand();
+        }
+        return mem[at];
+    default:
+        return 0xFF;
+    }
+}
+
+void nor_xfer(const uint8_t *tx, uint8_t *rx, uint32_t n)
+{
+    uint32_t i, pos;
+    uint8_t b, o;
+
+    for (i = 0; i < n; i++) {
+        b = (tx != NULL) ? tx[i] : 0xFF;
+        if (!cs) {
+            violation("clock without CS");
+            continue;
+        }
+        pos = ncmd++;
+        if (pos >= 4 && cmd[0] == 0x02) {
+            pp_buf[(pos - 4) & 255u] = b;
+        } else if (pos < sizeof(cmd)) {
+            cmd[pos] = b;
+        }
+        o = out_byte(pos);
+        if (rx != NULL) {
+            rx[i] = o;
+        }
+    }
+    nor_now_us += ((uint64_t)n * nor_timing.t_byte_ns + 999u) / 1000u;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file    nor_emu.h
+ * @brief   File-backed MD25Q64 (GD25Q64-class) SPI NOR emulator
+ * @details The 8 MB array is an mmap'd image file, so contents survive
+ *          between runs; erase counts per 4K sector live in "<image>.wear".
+ *          Commands are decoded per CS frame and executed on CS rising edge
+ *          with the datasheet rules the driver depends on: WEL gating, WIP
+ *          busy time from NorTiming, program as bitwise AND with page wrap,
+ *          erase/program suspend (0x75/0x7A) and the status registers.
+ *          Anything the real chip would ignore or answer with garbage is
+ *          counted in nor_stats.violations.
+ *
+ *          Time is virtual: nor_now_us advances with bytes clocked on the
+ *          bus and with whatever the host shim charges for CPU time.
+ *
+ *          Power cuts: nor_arm_cut() gives a budget in program/erase units;
+ *          when it runs out the operation in progress is torn (partially
+ *          programmed bits, partially erased sector with disturbed bytes),
+ *          volatile state is lost and control longjmps back to the test.
+ */
+
+#ifndef __NOR_EMU_H__
+#define __NOR_EMU_H__
+
+#include <setjmp.h>
+#include <stdint.h>
+
+#define NOR_SIZE        (8u * 1024u * 1024u)
+#define NOR_SECTORS     (NOR_SIZE / 4096u)
+#define NOR_JEDEC_ID    0xC84017u
+
+typedef struct {
+    uint32_t t_pp_us;               /* Page program */
+    uint32_t t_se_us;               /* 4K sector erase */
+    uint32_t t_be32_us;
+    uint32_t t_be64_us;
+    uint32_t t_ce_us;               /* Chip erase */
+    uint32_t t_wrsr_us;
+    uint32_t t_sus_us;              /* Suspend latency */
+    uint32_t t_byte_ns;             /* One byte on the SPI bus */
+} NorTiming;
+
+typedef struct {
+    long violations;                /* Commands the chip would ignore, undefined reads */
+    long cmds;
+    long wrens;                     /* Write enables: every write-class command needs one */
+    long rdsr;
+    long programs;
+    long erases;
+    long suspends;
+    long resumes;
+} NorStats;
+
+/* GD25Q64 typical times, 21 MHz SPI */
+extern const NorTiming nor_timing_gd25q64;
+
+extern uint64_t nor_now_us;         /* Virtual clock */
+extern NorTiming nor_timing;        /* May be changed between operations */
+extern NorStats nor_stats;
+extern uint32_t *nor_wear;          /* Erase count per 4K sector */
+
+int nor_open(const char *image_path, const NorTiming *timing);  /* 0 on success */
+void nor_close(void);
+void nor_power_cycle(void);         /* WEL, WIP, suspend and bus state lost */
+uint8_t *nor_mem(void);
+int nor_busy(void);                 /* WIP as RDSR would report it */
+
+/* SPI bus */
+void nor_cs(int asserted);
+void nor_xfer(const uint8_t *tx, uint8_t *rx, uint32_t n);
+
+/* Tear the operation in progress after budget units (one per programmed
+ * byte, 40 per erase) and longjmp to *env */
+void nor_arm_cut(long budget, jmp_buf *env);
+void nor_disarm_cut(void);
+
+#endif /* __NOR_EMU_H__ */
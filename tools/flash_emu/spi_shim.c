@@ -0,0 +1,130 @@
+/**
+ * @file    spi_shim.c
+ * @brief   HAL shim for md25q64.c on top of nor_emu, see spi_shim.h
+ */
+
+#include "spi_shim.h"
+
+#include "md25q64.h"
+#include "nor_emu.h"
+
+#include <string.h>
+
+static struct {
+    int pending;
+    int rx;
+    int hang;
+    uint8_t *buf;
+    uint16_t n;
+    uint64_t at;                    /* Virtual time the transfer is done */
+    SPI_HandleTypeDef *hspi;
+} dma;
+
+long shim_dma_transfers;
+int shim_dma_fail_next;
+int shim_dma_hang_next;
+
+void shim_reset(void)
+{
+    memset(&dma, 0, sizeof(dma));
+}
+
+int shim_dma_busy(void)
+{
+    return dma.pending;
+}
+
+void shim_service(void)
+{
+    uint64_t now = nor_now_us;
+
+    if (!dma.pending || dma.hang || nor_now_us < dma.at) {
+        return;
+    }
+    dma.pending = 0;
+    /* Bus time was charged through dma.at */
+    nor_xfer(dma.rx ? NULL : dma.buf, dma.rx ? dma.buf : NULL, dma.n);
+    nor_now_us = now;
+    if (shim_dma_fail_next) {
+        shim_dma_fail_next = 0;
+        MD25Q64_DMA_Error(dma.hspi);
+    } else {
+        MD25Q64_DMA_Complete(dma.hspi);
+    }
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    (void)GPIOx;
+    (void)GPIO_Pin;
+    nor_cs(PinState == GPIO_PIN_RESET);
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)hspi;
+    (void)Timeout;
+    if (dma.pending) {
+        return HAL_BUSY;
+    }
+    nor_xfer(pData, NULL, Size);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)hspi;
+    (void)Timeout;
+    if (dma.pending) {
+        return HAL_BUSY;
+    }
+    nor_xfer(NULL, pData, Size);
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef shim_start_dma(SPI_HandleTypeDef *hspi, uint8_t *data, uint16_t size, int rx)
+{
+    if (dma.pending) {
+        return HAL_BUSY;
+    }
+    dma.pending = 1;
+    dma.rx = rx;
+    dma.buf = data;
+    dma.n = size;
+    dma.hspi = hspi;
+    dma.at = nor_now_us + ((uint64_t)size * nor_timing.t_byte_ns) / 1000u + 2u;
+    dma.hang = shim_dma_hang_next;
+    shim_dma_hang_next = 0;
+    shim_dma_transfers++;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size)
+{
+    return shim_start_dma(hspi, pData, Size, 0);
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size)
+{
+    return shim_start_dma(hspi, pData, Size, 1);
+}
+
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef *hspi)
+{
+    (void)hspi;
+    dma.pending = 0;
+    return HAL_OK;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    nor_now_us += 1;
+    shim_service();
+    return (uint32_t)(nor_now_us / 1000u);
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    nor_now_us += (uint64_t)Delay * 1000u + 1u;
+    shim_service();
+}
@@ -0,0 +1,23 @@
+/**
+ * @file    spi_shim.h
+ * @brief   HAL SPI/GPIO/tick functions of md25q64_port.h on top of nor_emu
+ * @details CS is any HAL_GPIO_WritePin() call. Polled transfers clock bytes
+ *          straight into the emulator. A DMA transfer is only queued: it
+ *          completes, through MD25Q64_DMA_Complete() or MD25Q64_DMA_Error(),
+ *          once the virtual clock passes its bus time, checked whenever the
+ *          driver reads HAL_GetTick() or calls HAL_Delay(). Each tick read
+ *          costs 1 us so busy-waits make progress.
+ */
+
+#ifndef __SPI_SHIM_H__
+#define __SPI_SHIM_H__
+
+extern long shim_dma_transfers;     /* DMA transfers started */
+extern int shim_dma_fail_next;      /* Next DMA completes through the error callback */
+extern int shim_dma_hang_next;      /* Next DMA never completes until aborted */
+
+void shim_reset(void);              /* Drop a DMA in flight, e.g. after a power cut */
+void shim_service(void);            /* Complete a DMA that is due */
+int shim_dma_busy(void);            /* A DMA transfer is in flight */
+
+#endif /* __SPI_SHIM_H__ */
@@ -0,0 +1,329 @@
+/**
+ * @file    test_asset.c
+ * @brief   Flash assets on the emulator: image checks, UTF-8 decoding, glyph
+ *          bytes against the image for random batches with the fewest
+ *          slots allowed, the number of reads per string, the status
+ *          screen hit rate and corrupt images
+ * @details The image is built here in the asset_pack layout with random
+ *          glyph bits: "f8x16" (printable ASCII), "cjk16" (ASCII and the
+ *          CJK Unified Ideographs block), "ui16" (ASCII plus the status
+ *          screen's characters, one range each) and a bitmap "news".
+ */
+
+#include "emu_test.h"
+#include "flash_asset.h"
+
+#define BASE        0x100000u
+#define REGION      0x300000u
+
+static MD25Q64_Handle h;
+static FlashAsset fa;
+static FlashAsset_Slot slots[64], few[FLASHASSET_BATCH + 1];
+static uint8_t img[REGION];
+static uint32_t img_len;
+
+/* ============================================================================
+ * Image
+ * ============================================================================ */
+static FlashAsset_Entry *add_entry(const char *name, uint8_t type, uint8_t w, uint8_t hgt)
+{
+    FlashAsset_Header *hd = (FlashAsset_Header *)img;
+    FlashAsset_Entry *e = (FlashAsset_Entry *)(img + sizeof(*hd)) + hd->count++;
+
+    memset(e, 0, sizeof(*e));
+    memcpy(e->name, name, strlen(name));         /* NUL padded by the memset */
+    e->type = type;
+    e->width = w;
+    e->height = hgt;
+    e->offset = img_len;
+    return e;
+}
+
+static void add_font(const char *name, uint8_t w, uint8_t hgt,
+                     const FlashAsset_RangeRec *ranges, uint16_t n, uint16_t fallback)
+{
+    FlashAsset_Entry *e = add_entry(name, FLASHASSET_FONT, w, hgt);
+    uint32_t glyphs = 0, i;
+
+    memcpy(img + img_len, ranges, n * sizeof(*ranges));
+    img_len += n * (uint32_t)sizeof(*ranges);
+    for (i = 0; i < n; i++) {
+        glyphs += ranges[i].count;
+    }
+    for (i = 0; i < glyphs * (w * hgt / 8u); i++) {
+        img[img_len++] = (uint8_t)rand();
+    }
+    e->ranges = n;
+    e->fallback = fallback;
+    e->size = img_len - e->offset;
+    img_len = (img_len + 3u) & ~3u;
+}
+
+static void add_bitmap(const char *name, uint8_t w, uint8_t hgt)
+{
+    FlashAsset_Entry *e = add_entry(name, FLASHASSET_BITMAP, w, hgt);
+    uint32_t i;
+
+    for (i = 0; i < w * hgt / 8u; i++) {
+        img[img_len++] = (uint8_t)rand();
+    }
+    e->size = img_len - e->offset;
+    img_len = (img_len + 3u) & ~3u;
+}
+
+static void build(uint16_t entries)
+{
+    static const FlashAsset_RangeRec ascii = {0x20, 95};
+    static const FlashAsset_RangeRec cjk[] = {{0x20, 95}, {0x3000, 64}, {0x4E00, 20902}};
+    static const char ui_text[] = "乙烯温度状态新鲜成熟过腐败: ";
+    FlashAsset_RangeRec ui[FLASHASSET_MAX_RANGES];
+    FlashAsset_Header *hd = (FlashAsset_Header *)img;
+    const char *s = ui_text;
+    uint32_t cp, dir_end;
+    uint16_t n = 1;
+
+    memset(img, 0xFF, sizeof(img));
+    memset(hd, 0, sizeof(*hd));
+    hd->magic = FLASHASSET_MAGIC;
+    hd->version = FLASHASSET_VERSION;
+    dir_end = (uint32_t)sizeof(*hd) + entries * (uint32_t)sizeof(FlashAsset_Entry);
+    img_len = dir_end;
+
+    ui[0] = ascii;
+    while ((cp = FlashAsset_Utf8Next(&s)) != 0) {
+        if (cp > 0x7E) {
+            ui[n].first = cp;
+            ui[n++].count = 1;
+        }
+    }
+    /* Sorted, as asset_pack writes them */
+    for (uint16_t i = 1; i < n; i++) {
+        for (uint16_t j = i; j > 1 && ui[j - 1].first > ui[j].first; j--) {
+            FlashAsset_RangeRec t = ui[j];
+            ui[j] = ui[j - 1];
+            ui[j - 1] = t;
+        }
+    }
+
+    add_font("f8x16", 8, 16, &ascii, 1, '?' - 0x20);
+    add_font("cjk16", 16, 16, cjk, 3, '?' - 0x20);
+    add_font("ui16", 16, 16, ui, n, '?' - 0x20);
+    add_bitmap("news", 128, 64);
+    hd->size = img_len;
+    hd->dir_crc = FlashAsset_Crc32(0, img + sizeof(*hd), dir_end - (uint32_t)sizeof(*hd));
+    hd->data_crc = FlashAsset_Crc32(0, img + dir_end, img_len - dir_end);
+    memcpy(nor_mem() + BASE, img, REGION);
+}
+
+/* Glyph straight from the image bytes */
+static const uint8_t *expect(const char *name, uint32_t cp)
+{
+    const FlashAsset_Header *hd = (const FlashAsset_Header *)img;
+    const FlashAsset_Entry *e = (const FlashAsset_Entry *)(img + sizeof(*hd));
+    const FlashAsset_RangeRec *r;
+    uint32_t i, k, g = 0, gs;
+
+    for (i = 0; i < hd->count; i++, e++) {
+        if (e->type != FLASHASSET_FONT || strncmp(e->name, name, FLASHASSET_NAME_LEN) != 0) {
+            continue;
+        }
+        r = (const FlashAsset_RangeRec *)(img + e->offset);
+        gs = e->width * e->height / 8u;
+        for (k = 0; k < e->ranges; k++) {
+            if (cp >= r[k].first && cp < r[k].first + r[k].count) {
+                return img + e->offset + e->ranges * 8u + (g + cp - r[k].first) * gs;
+            }
+            g += r[k].count;
+        }
+        return img + e->offset + e->ranges * 8u + e->fallback * gs;
+    }
+    return NULL;
+}
+
+/* Looks a string up; glyph bytes checked, reads and time returned */
+static void text(FlashAsset_Font *f, const char *name, const char *s, long *reads, uint64_t *us)
+{
+    uint32_t cps[FLASHASSET_BATCH], c;
+    const uint8_t *g[FLASHASSET_BATCH];
+    uint32_t r0 = fa.stats.reads;
+    uint64_t t0 = nor_now_us;
+    uint8_t n = 0, i;
+
+    while (n < FLASHASSET_BATCH && (c = FlashAsset_Utf8Next(&s)) != 0) {
+        cps[n++] = c;
+    }
+    CHECK(FlashAsset_Glyphs(f, cps, n, g) == FLASHASSET_OK);
+    for (i = 0; i < n; i++) {
+        CHECK(memcmp(g[i], expect(name, cps[i]), f->glyph_size) == 0);
+    }
+    if (reads != NULL) {
+        *reads = (long)(fa.stats.reads - r0);
+    }
+    if (us != NULL) {
+        *us = nor_now_us - t0;
+    }
+}
+
+/* ============================================================================
+ * Tests
+ * ============================================================================ */
+static void utf8(void)
+{
+    const char *s = "A\xC3\xA9\xE4\xB9\x99\xF0\x9F\x98\x80\xC0\xAF\xED\xA0\x80\xE4\xB9";
+    uint32_t c[16], x;
+    int n = 0;
+
+    while ((x = FlashAsset_Utf8Next(&s)) != 0 && n < 16) {
+        c[n++] = x;
+    }
+    CHECK(n == 11 && c[0] == 'A' && c[1] == 0xE9 && c[2] == 0x4E59 && c[3] == 0x1F600);
+    for (x = 4; x < 11; x++) {
+        CHECK(c[x] == 0xFFFD);                  /* Overlong, surrogate, truncated */
+    }
+}
+
+static void reads_per_string(void)
+{
+    FlashAsset_Font ascii, cjk, f;
+    const FlashAsset_Entry *e;
+    uint8_t b[128];
+    long rd;
+    uint64_t cold, warm, t0;
+    int i;
+
+    CHECK(FlashAsset_Init(&fa, &h, BASE, REGION, slots, 64) == FLASHASSET_OK);
+    CHECK(FlashAsset_Verify(&fa) == FLASHASSET_OK);
+    CHECK(FlashAsset_Find(&fa, "news", FLASHASSET_BITMAP) != NULL);
+    CHECK(FlashAsset_Find(&fa, "news", FLASHASSET_FONT) == NULL);
+    CHECK(FlashAsset_FontOpen(&fa, &ascii, "f8x16") == FLASHASSET_OK);
+    CHECK(FlashAsset_FontOpen(&fa, &cjk, "cjk16") == FLASHASSET_OK && cjk.glyph_count == 21061);
+    CHECK(FlashAsset_FontOpen(&fa, &f, "nope") == FLASHASSET_NOT_FOUND);
+
+    /* Misses within one buffer: one read */
+    text(&ascii, "f8x16", "12:30:05 0.42 13", &rd, &cold);
+    CHECK(rd == 1);
+    printf("clock line, 16 glyphs: %ld read, %llu us cold\n", rd, (unsigned long long)cold);
+    /* Wider: runs */
+    text(&ascii, "f8x16", "Ethylene 0.42ppm", &rd, &cold);
+    CHECK(rd >= 2 && rd <= 4);
+    text(&ascii, "f8x16", "Ethylene 0.42ppm", NULL, &warm);
+    CHECK(warm == 0);
+    t0 = nor_now_us;
+    for (i = 0; i < 16; i++) {
+        CHECK(MD25Q64_FastRead(&h, ascii.glyphs + ("Ethylene 0.42ppm"[i] - 0x20) * 16u, b, 16) == MD25Q64_OK);
+    }
+    printf("mixed line, 16 glyphs: %ld reads, %llu us cold, %llu us cached, %llu us one read per glyph\n",
+           rd, (unsigned long long)cold, (unsigned long long)warm,
+           (unsigned long long)(nor_now_us - t0));
+    /* 16 x 16 batch: the whole span fits when the glyphs are close */
+    FlashAsset_CacheClear(&fa);
+    text(&cjk, "cjk16", "乙乙乙\xEF\xBF\xBF乙", &rd, NULL);       /* U+FFFF: fallback */
+    CHECK(rd == 2);
+    text(&cjk, "cjk16", "状态: 新鲜", &rd, NULL);
+    printf("cjk mixed-script line: %ld reads\n", rd);
+
+    e = FlashAsset_Find(&fa, "news", FLASHASSET_BITMAP);
+    CHECK(FlashAsset_Read(&fa, e, 0, b, 128) == FLASHASSET_OK && memcmp(b, img + e->offset, 128) == 0);
+    CHECK(FlashAsset_Read(&fa, e, e->size - 127, b, 128) == FLASHASSET_INVALID_PARAM);
+}
+
+/* Every glyph of a batch stays valid with one slot to spare */
+static void pins(void)
+{
+    FlashAsset_Font cjk;
+    uint32_t cps[FLASHASSET_BATCH];
+    const uint8_t *g[FLASHASSET_BATCH];
+    int it, i, n;
+
+    CHECK(FlashAsset_Init(&fa, &h, BASE, REGION, few, FLASHASSET_BATCH + 1) == FLASHASSET_OK);
+    CHECK(FlashAsset_FontOpen(&fa, &cjk, "cjk16") == FLASHASSET_OK);
+    for (it = 0; it < 2000; it++) {
+        n = 1 + rand() % FLASHASSET_BATCH;
+        for (i = 0; i < n; i++) {
+            cps[i] = 0x4E00u + (uint32_t)((rand() % 3) ? rand() % 40 : rand() % 20902);
+        }
+        CHECK(FlashAsset_Glyphs(&cjk, cps, (uint8_t)n, g) == FLASHASSET_OK);
+        for (i = 0; i < n; i++) {
+            CHECK(memcmp(g[i], expect("cjk16", cps[i]), 32) == 0);
+        }
+    }
+    for (it = 0; it < 300; it++) {                  /* The batch stamp wraps */
+        for (i = 0; i < FLASHASSET_BATCH; i++) {
+            cps[i] = 0x20u + (uint32_t)((it * FLASHASSET_BATCH + i) % 95);
+        }
+        CHECK(FlashAsset_Glyphs(&cjk, cps, FLASHASSET_BATCH, g) == FLASHASSET_OK);
+        for (i = 0; i < FLASHASSET_BATCH; i++) {
+            CHECK(memcmp(g[i], expect("cjk16", cps[i]), 32) == 0);
+        }
+    }
+    printf("pins: 2300 batches with %d slots\n", FLASHASSET_BATCH + 1);
+}
+
+/* Status screen redrawn at 10 Hz for 10 minutes */
+static void status_screen(void)
+{
+    static const char *states[] = {"新鲜", "成熟", "过熟", "腐败"};
+    FlashAsset_Font ui, a8;
+    char line[64];
+    uint64_t us, total = 0;
+    long strings = 0;
+    int fr;
+
+    CHECK(FlashAsset_Init(&fa, &h, BASE, REGION, slots, 64) == FLASHASSET_OK);
+    CHECK(FlashAsset_FontOpen(&fa, &ui, "ui16") == FLASHASSET_OK);
+    CHECK(FlashAsset_FontOpen(&fa, &a8, "f8x16") == FLASHASSET_OK);
+    for (fr = 0; fr < 6000; fr++) {
+        snprintf(line, sizeof(line), "乙烯 %d.%02d", fr % 7, fr % 100);
+        text(&ui, "ui16", line, NULL, &us);
+        total += us;
+        snprintf(line, sizeof(line), "温度 %d.%d", 20 + fr % 9, fr % 10);
+        text(&ui, "ui16", line, NULL, &us);
+        total += us;
+        snprintf(line, sizeof(line), "状态: %s", states[(fr / 600) % 4]);
+        text(&ui, "ui16", line, NULL, &us);
+        total += us;
+        snprintf(line, sizeof(line), "%02d:%02d:%02d RSSI-%d", fr / 36000, fr / 600 % 60,
+                 fr / 10 % 60, 60 + fr % 30);
+        text(&a8, "f8x16", line, NULL, &us);
+        total += us;
+        strings += 4;
+    }
+    printf("status screen: %ld strings, %lu lookups, %.2f%% hits, %lu reads, %.2f us/string\n",
+           strings, (unsigned long)fa.stats.lookups, 100.0 * fa.stats.hits / fa.stats.lookups,
+           (unsigned long)fa.stats.reads, (double)total / strings);
+    CHECK(fa.stats.reads < 40);
+}
+
+static void corrupt(void)
+{
+    FlashAsset_Font f;
+
+    nor_mem()[BASE + sizeof(FlashAsset_Header) + 3] ^= 1;
+    CHECK(FlashAsset_Init(&fa, &h, BASE, REGION, slots, 64) == FLASHASSET_CORRUPT);
+    CHECK(FlashAsset_FontOpen(&fa, &f, "ui16") == FLASHASSET_NO_IMAGE);
+    nor_mem()[BASE + sizeof(FlashAsset_Header) + 3] ^= 1;
+    nor_mem()[BASE + img_len - 1] ^= 0x80;
+    CHECK(FlashAsset_Init(&fa, &h, BASE, REGION, slots, 64) == FLASHASSET_OK);
+    CHECK(FlashAsset_Verify(&fa) == FLASHASSET_CORRUPT);
+    CHECK(FlashAsset_Init(&fa, &h, BASE, 100, slots, 64) == FLASHASSET_CORRUPT);
+}
+
+int main(int argc, char **argv)
+{
+    FlashAsset_Font f;
+
+    emu_open("test_asset", argc, argv);
+    CHECK(emu_init(&h, 1) == MD25Q64_OK);
+
+    CHECK(FlashAsset_Init(&fa, &h, BASE, REGION, slots, 64) == FLASHASSET_NO_IMAGE);
+    CHECK(FlashAsset_FontOpen(&fa, &f, "f8x16") == FLASHASSET_NO_IMAGE);
+    CHECK(FlashAsset_Init(&fa, &h, BASE, REGION, slots, FLASHASSET_BATCH) == FLASHASSET_INVALID_PARAM);
+    utf8();
+
+    build(4);
+    reads_per_string();
+    pins();
+    status_screen();
+    corrupt();
+    return emu_finish();
+}
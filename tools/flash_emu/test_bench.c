@@ -0,0 +1,82 @@
+/**
+ * @file    test_bench.c
+ * @brief   The md25q64_bench sweep on the emulator, polled and on DMA, with
+ *          the virtual clock as the cycle counter (1 cycle per us). Prints
+ *          the CSV and checks the medians against the timing model: erase
+ *          and program times plus the bytes on the bus.
+ */
+
+#include "emu_test.h"
+#include "md25q64_bench.h"
+
+static MD25Q64_Handle h;
+static uint8_t buf[4096];
+static int lines;
+
+static uint32_t cycles(void)
+{
+    return (uint32_t)nor_now_us;
+}
+
+/* Median within 5% (and one clock tick) of the model, in us */
+static void expect(const char *op, unsigned long size, unsigned long median_ns, double model_us)
+{
+    double us = median_ns / 1000.0;
+
+    if (us < model_us * 0.95 - 1.0 || us > model_us * 1.05 + 1.0) {
+        printf("FAIL %s %lu: median %.1f us, model %.1f us\n", op, size, us, model_us);
+        emu_fails++;
+    }
+}
+
+static void on_line(void *ctx, const char *line)
+{
+    char op[16];
+    unsigned long size, offset, chunk, trials, min_ns, median_ns, p99_ns, kib_s;
+    double byte_us = nor_timing.t_byte_ns / 1000.0;
+
+    (void)ctx;
+    puts(line);
+    if (sscanf(line, "%15[^,],%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu", op, &size, &offset, &chunk,
+               &trials, &min_ns, &median_ns, &p99_ns, &kib_s) != 9) {
+        return;
+    }
+    lines++;
+    CHECK(min_ns <= median_ns && median_ns <= p99_ns);
+    if (strcmp(op, "erase_4k") == 0) {
+        expect(op, size, median_ns, nor_timing.t_se_us);
+    } else if (strcmp(op, "erase_32k") == 0) {
+        expect(op, size, median_ns, nor_timing.t_be32_us);
+    } else if (strcmp(op, "erase_64k") == 0) {
+        expect(op, size, median_ns, nor_timing.t_be64_us);
+    } else if (strcmp(op, "program") == 0) {
+        expect(op, size, median_ns, nor_timing.t_pp_us + (size + 4) * byte_us);
+    } else if (strcmp(op, "write") == 0) {
+        /* Split at the page boundary unless page aligned: two programs */
+        expect(op, size, median_ns, (offset ? 2 : 1) * (nor_timing.t_pp_us + 4 * byte_us) +
+               size * byte_us);
+    } else if (strcmp(op, "read") == 0 && size >= 4096) {
+        expect(op, size, median_ns, size * byte_us);        /* Command bytes vanish */
+    }
+}
+
+static void run(int use_dma)
+{
+    const MD25Q64_BenchPort port = {cycles, 1, on_line, NULL};
+    NorStats before = nor_stats;
+
+    CHECK(emu_init(&h, use_dma) == MD25Q64_OK);
+    lines = 0;
+    CHECK(MD25Q64_Bench_Run(&h, &port, 0x10000, 9, buf, sizeof(buf)) == MD25Q64_OK);
+    CHECK(lines == 5 + 4 + 3 + 2 * 9);     /* program, write, erase, both reads */
+    printf("# %s: %ld erases, %ld page programs\n", use_dma ? "DMA" : "polled",
+           nor_stats.erases - before.erases, nor_stats.programs - before.programs);
+}
+
+int main(int argc, char **argv)
+{
+    emu_open("test_bench", argc, argv);
+    run(0);
+    run(1);
+    return emu_finish();
+}
@@ -0,0 +1,204 @@
+/**
+ * @file    test_cache.c
+ * @brief   MD25Q64 read cache: a random mix of sync/async writes, erases
+ *          and reads checked byte for byte against a shadow copy, then the
+ *          dashboard trace with the cache off, at 16 and at 32 lines
+ * @details Trace: a 1024-sector log holding 20 h of 48-byte samples at 1 Hz,
+ *          then one hour of appends with a last-minute read every 5 s and
+ *          a last-hour read every minute. The reads walk the newest sectors
+ *          with the plain iterator, as a time query without the index does.
+ *          Every configuration starts from the same image and must return
+ *          the same records.
+ */
+
+#include "emu_test.h"
+#include "flash_log.h"
+#include "md25q64_cache.h"
+#include "md25q64_wbuf.h"
+
+#define SHADOW_AREA     0x20000u
+#define LOG_BASE        0x400000u
+#define LOG_SECTORS     1024u
+
+typedef struct {
+    uint32_t ts;
+    float f[10];
+    uint32_t pad;
+} Sample;                                   /* 48 B, like storage_sample_t */
+
+static MD25Q64_Handle h;
+static MD25Q64_Cache cache;
+static MD25Q64_CacheLine lines[32];
+static FlashLog lg;
+static MD25Q64_WBuf wb;
+static uint8_t shadow[SHADOW_AREA], buf[2048], rd[2048];
+static uint8_t *image;
+static uint32_t now_ts, sum;
+
+/* ============================================================================
+ * Shadow test
+ * ============================================================================ */
+static void shadow_test(void)
+{
+    MD25Q64_Status st;
+    uint32_t a, n, k;
+    int i, r, bad = 0;
+
+    CHECK(emu_init(&h, 1) == MD25Q64_OK);
+    MD25Q64_Cache_Init(&cache, lines, 6);
+    MD25Q64_SetCache(&h, &cache);
+    memset(shadow, 0xFF, sizeof(shadow));
+    for (i = 0; i < 200000 && !bad; i++) {
+        r = rand() % 100;
+        a = (uint32_t)rand() % SHADOW_AREA;
+        n = 1u + (uint32_t)rand() % ((rand() % 4) ? 300u : 2000u);
+        if (a + n > SHADOW_AREA) {
+            n = SHADOW_AREA - a;
+        }
+        if (r < 15) {
+            for (k = 0; k < n; k++) {
+                buf[k] = (uint8_t)rand();
+                shadow[a + k] &= buf[k];
+            }
+            if (rand() % 2) {
+                CHECK(MD25Q64_Write_Start(&h, a, buf, n, NULL, NULL) == MD25Q64_OK);
+                emu_drain(&h, 100);
+            } else {
+                CHECK(MD25Q64_Write(&h, a, buf, n) == MD25Q64_OK);
+            }
+        } else if (r < 17) {
+            a &= ~0xFFFu;
+            memset(shadow + a, 0xFF, 4096);
+            if (rand() % 2) {
+                CHECK(MD25Q64_EraseSector_Start(&h, a, NULL, NULL) == MD25Q64_OK);
+            } else {
+                CHECK(MD25Q64_EraseSector(&h, a) == MD25Q64_OK);
+            }
+        } else if (r < 18) {
+            a &= ~0x7FFFu;
+            memset(shadow + a, 0xFF, 0x8000);
+            CHECK(MD25Q64_EraseBlock32K(&h, a) == MD25Q64_OK);
+        } else {
+            st = (rand() % 2) ? MD25Q64_Read(&h, a, rd, n) : MD25Q64_FastRead(&h, a, rd, n);
+            if (st != MD25Q64_OK || memcmp(rd, shadow + a, n) != 0) {
+                printf("FAIL op %d: read 0x%06lX+%lu status %d\n", i, (unsigned long)a,
+                       (unsigned long)n, st);
+                emu_fails++;
+                bad = 1;
+            }
+        }
+    }
+    printf("shadow: %d ops, hits %lu misses %lu bypass %lu invalidated %lu\n", i,
+           (unsigned long)cache.stats.hits, (unsigned long)cache.stats.misses,
+           (unsigned long)cache.stats.bypass, (unsigned long)cache.stats.invalidated);
+    MD25Q64_SetCache(&h, NULL);
+}
+
+/* ============================================================================
+ * Dashboard trace
+ * ============================================================================ */
+static void append(int n)
+{
+    Sample s;
+
+    memset(&s, 0, sizeof(s));
+    while (n--) {
+        s.ts = now_ts++;
+        s.f[0] = (float)s.ts;
+        CHECK(FlashLog_Append(&lg, &s, sizeof(s)) == FLASHLOG_OK);
+        FlashLog_Maintain(&lg);
+        MD25Q64_Poll(&h);
+    }
+}
+
+/* Records of the last `want` seconds, walking the newest `sectors` sectors */
+static void query(uint16_t sectors, uint32_t want)
+{
+    FlashLog_Iter it;
+    Sample s;
+    uint16_t len, back = sectors - 1u;
+
+    it.log = &lg;
+    it.sector = (uint16_t)((lg.head + lg.sector_count - back) % lg.sector_count);
+    it.seq = lg.head_seq - back - 1u;
+    it.offset = 0;
+    it.checked = 0;
+    it.done = 0;
+    while (FlashLog_IterNext(&it, &s, sizeof(s), &len) == FLASHLOG_OK) {
+        if (s.ts + want >= now_ts) {
+            sum = sum * 31u + s.ts;
+        }
+    }
+}
+
+static void build_image(void)
+{
+    CHECK(emu_init(&h, 1) == MD25Q64_OK);
+    CHECK(FlashLog_Mount(&lg, &h, LOG_BASE, LOG_SECTORS) == FLASHLOG_OK);
+    MD25Q64_WBuf_Init(&wb, &h, 10000);
+    FlashLog_SetWriteBuffer(&lg, &wb);
+    now_ts = 0;
+    append(72000);
+    CHECK(MD25Q64_WBuf_Flush(&wb) == MD25Q64_OK);
+    emu_drain(&h, 1000);
+    image = malloc(NOR_SIZE);
+    memcpy(image, nor_mem(), NOR_SIZE);
+}
+
+/* One hour of the trace; returns the dashboard time in us */
+static uint64_t trace(uint16_t count, uint32_t *result)
+{
+    uint64_t t0, mount_us, dash_us = 0, hour_us = 0;
+    int sec;
+
+    memcpy(nor_mem(), image, NOR_SIZE);
+    nor_power_cycle();
+    shim_reset();
+    CHECK(emu_init(&h, 1) == MD25Q64_OK);
+    MD25Q64_Cache_Init(&cache, count ? lines : NULL, count);
+    MD25Q64_SetCache(&h, &cache);
+    t0 = nor_now_us;
+    CHECK(FlashLog_Mount(&lg, &h, LOG_BASE, LOG_SECTORS) == FLASHLOG_OK);
+    mount_us = nor_now_us - t0;
+    MD25Q64_WBuf_Init(&wb, &h, 10000);
+    FlashLog_SetWriteBuffer(&lg, &wb);
+    now_ts = 72000;
+    sum = 0;
+    for (sec = 0; sec < 3600; sec += 5) {
+        append(5);
+        t0 = nor_now_us;
+        query(2, 60);
+        dash_us += nor_now_us - t0;
+        if (sec % 60 == 0) {
+            t0 = nor_now_us;
+            query(44, 3600);
+            hour_us += nor_now_us - t0;
+        }
+    }
+    printf("  %-5s %6lu %10lu %10lu %9lu %9lu\n", count ? (count == 16 ? "16" : "32") : "off",
+           (unsigned long)(mount_us / 1000), (unsigned long)(dash_us / 1000),
+           (unsigned long)(hour_us / 1000), (unsigned long)cache.stats.hits,
+           (unsigned long)cache.stats.misses);
+    *result = sum;
+    MD25Q64_SetCache(&h, NULL);
+    return dash_us;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t off, l16, l32;
+    uint32_t r_off, r16, r32;
+
+    emu_open("test_cache", argc, argv);
+    shadow_test();
+
+    build_image();
+    printf("  lines  mount  dashboard  last-hour      hits    misses   (virtual ms)\n");
+    off = trace(0, &r_off);
+    l16 = trace(16, &r16);
+    l32 = trace(32, &r32);
+    CHECK(r_off == r16 && r_off == r32);
+    CHECK(l32 < l16 && l16 < off);
+    free(image);
+    return emu_finish();
+}
@@ -0,0 +1,102 @@
+/**
+ * @file    test_dma.c
+ * @brief   MD25Q64 data phases on SPI DMA: threshold and chunking, the
+ *          CPU returning while a transfer runs, DMA error, a hung transfer
+ *          timing out and the driver recovering, and queued ops around DMA
+ */
+
+#include "emu_test.h"
+
+static MD25Q64_Handle h;
+static int done_n;
+static MD25Q64_Status done_st[8];
+static uint8_t wbuf[5000], rbuf[5000];
+static uint8_t big[70000];
+
+static void on_done(MD25Q64_Handle *handle, MD25Q64_Status status, void *ctx)
+{
+    (void)handle;
+    (void)ctx;
+    done_st[done_n++] = status;
+}
+
+static void run_ticks(int max)
+{
+    while (!MD25Q64_IsIdle(&h) && max-- > 0) {
+        nor_now_us += 1000;
+        MD25Q64_Poll(&h);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    long c0;
+    uint64_t t0;
+    int i;
+
+    emu_open("test_dma", argc, argv);
+    for (i = 0; i < (int)sizeof(wbuf); i++) {
+        wbuf[i] = (uint8_t)rand();
+    }
+    for (i = 0; i < (int)sizeof(big); i++) {
+        nor_mem()[i] = (uint8_t)rand();
+    }
+    CHECK(emu_init(&h, 1) == MD25Q64_OK);
+
+    /* Blocking write and read go through DMA page by page */
+    c0 = shim_dma_transfers;
+    CHECK(MD25Q64_EraseBlock64K(&h, 0x70000) == MD25Q64_OK);
+    CHECK(MD25Q64_Write(&h, 0x70000 + 77, wbuf, 5000) == MD25Q64_OK);
+    CHECK(MD25Q64_Read(&h, 0x70000 + 77, rbuf, 5000) == MD25Q64_OK && memcmp(rbuf, wbuf, 5000) == 0);
+    CHECK(shim_dma_transfers - c0 == 20 + 1);   /* 179 + 18 x 256 + 213 byte pages, 1 read */
+
+    /* Async fast read: Start returns with the data phase in flight */
+    done_n = 0;
+    memset(rbuf, 0, sizeof(rbuf));
+    t0 = nor_now_us;
+    CHECK(MD25Q64_FastRead_Start(&h, 0x70000 + 77, rbuf, 5000, on_done, NULL) == MD25Q64_OK);
+    CHECK(done_n == 0 && shim_dma_busy());
+    CHECK(nor_now_us - t0 < 20);
+    run_ticks(100);
+    CHECK(done_n == 1 && done_st[0] == MD25Q64_OK && memcmp(rbuf, wbuf, 5000) == 0);
+
+    /* Short data phases stay polled; long reads split into DMA chunks */
+    c0 = shim_dma_transfers;
+    CHECK(MD25Q64_Read(&h, 0x70000, rbuf, MD25Q64_DMA_THRESHOLD - 1) == MD25Q64_OK);
+    CHECK(shim_dma_transfers == c0);
+    CHECK(MD25Q64_Read(&h, 0, big, sizeof(big)) == MD25Q64_OK);
+    CHECK(memcmp(big, nor_mem(), sizeof(big)) == 0);
+    CHECK(shim_dma_transfers - c0 == (sizeof(big) + MD25Q64_DMA_CHUNK - 1) / MD25Q64_DMA_CHUNK);
+
+    /* A read queued behind a program waits for WIP before its DMA */
+    done_n = 0;
+    CHECK(MD25Q64_EraseSector_Start(&h, 0x80000, on_done, NULL) == MD25Q64_OK);
+    CHECK(MD25Q64_PageProgram_Start(&h, 0x80000, wbuf + 7, 256, on_done, NULL) == MD25Q64_OK);
+    CHECK(MD25Q64_Read_Start(&h, 0x80000, rbuf, 256, on_done, NULL) == MD25Q64_OK);
+    run_ticks(1000);
+    CHECK(done_n == 3 && done_st[2] == MD25Q64_OK && memcmp(rbuf, wbuf + 7, 256) == 0);
+
+    /* DMA error: the op fails, CS goes high, the next op works */
+    done_n = 0;
+    shim_dma_fail_next = 1;
+    CHECK(MD25Q64_Read_Start(&h, 0x1000, rbuf, 512, on_done, NULL) == MD25Q64_OK);
+    run_ticks(100);
+    CHECK(done_n == 1 && done_st[0] == MD25Q64_ERROR && MD25Q64_IsIdle(&h));
+    CHECK(MD25Q64_Read(&h, 0x1000, rbuf, 512) == MD25Q64_OK && memcmp(rbuf, nor_mem() + 0x1000, 512) == 0);
+
+    /* DMA that never completes: timeout, abort, and the driver recovers */
+    done_n = 0;
+    shim_dma_hang_next = 1;
+    CHECK(MD25Q64_Write_Start(&h, 0x80100, wbuf, 256, on_done, NULL) == MD25Q64_OK);
+    run_ticks(3000);
+    CHECK(done_n == 1 && done_st[0] == MD25Q64_TIMEOUT && !shim_dma_busy());
+    CHECK(MD25Q64_Read(&h, 0x80000, rbuf, 256) == MD25Q64_OK && memcmp(rbuf, wbuf + 7, 256) == 0);
+    /* The aborted program never reached the array */
+    CHECK(MD25Q64_Read(&h, 0x80100, rbuf, 256) == MD25Q64_OK);
+    for (i = 0; i < 256; i++) {
+        if (rbuf[i] != 0xFF) { CHECK(rbuf[i] == 0xFF); break; }
+    }
+
+    printf("%ld DMA transfers\n", shim_dma_transfers);
+    return emu_finish();
+}
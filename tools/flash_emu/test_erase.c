@@ -0,0 +1,210 @@
+/**
+ * @file    test_erase.c
+ * @brief   MD25Q64_EraseRange: parameter checks, exact coverage of random
+ *          ranges, the greedy split without blank checks, reads served
+ *          while the async job runs, and the time saved against a sector
+ *          by sector loop
+ */
+
+#include "emu_test.h"
+#include "md25q64_erase.h"
+
+#define AREA        0x400000u
+#define AREA_LEN    0x100000u
+
+static MD25Q64_Handle h;
+static uint8_t shadow[NOR_SIZE];
+
+/* Program 16 bytes into `density` percent of the sectors */
+static void dirty(uint32_t a, uint32_t len, int density)
+{
+    uint8_t b[16];
+    uint32_t s;
+    int i;
+
+    for (s = a; s < a + len; s += 4096u) {
+        if (rand() % 100 >= density) {
+            continue;
+        }
+        for (i = 0; i < 16; i++) {
+            b[i] = (uint8_t)(rand() & 0x7F);
+        }
+        CHECK(MD25Q64_Write(&h, s + (uint32_t)rand() % 4080u, b, 16) == MD25Q64_OK);
+    }
+}
+
+/* Range blank, the rest of the area as before */
+static void verify(uint32_t a, uint32_t len)
+{
+    const uint8_t *m = nor_mem();
+    uint32_t i;
+
+    for (i = AREA; i < AREA + AREA_LEN; i++) {
+        if ((i >= a && i < a + len) ? m[i] != 0xFF : m[i] != shadow[i]) {
+            printf("FAIL range 0x%06lX+0x%lX: byte 0x%06lX\n", (unsigned long)a,
+                   (unsigned long)len, (unsigned long)i);
+            emu_fails++;
+            return;
+        }
+    }
+}
+
+static void snapshot(void)
+{
+    memcpy(shadow, nor_mem(), NOR_SIZE);
+}
+
+static void restore(void)
+{
+    memcpy(nor_mem(), shadow, NOR_SIZE);
+}
+
+static uint32_t blank_sectors(uint32_t a, uint32_t len)
+{
+    uint32_t s, n = 0;
+    int i;
+
+    for (s = a; s < a + len; s += 4096u) {
+        for (i = 0; i < 4096 && shadow[s + i] == 0xFF; i++) {
+        }
+        n += (i == 4096);
+    }
+    return n;
+}
+
+static void params(void)
+{
+    MD25Q64_EraseReport r;
+
+    CHECK(MD25Q64_EraseRange(&h, 0x1000, 0, 0, &r) == MD25Q64_INVALID_PARAM);
+    CHECK(MD25Q64_EraseRange(&h, 0x1001, 4096, 0, &r) == MD25Q64_INVALID_PARAM);
+    CHECK(MD25Q64_EraseRange(&h, 0x1000, 4000, 0, &r) == MD25Q64_INVALID_PARAM);
+    CHECK(MD25Q64_EraseRange(&h, NOR_SIZE - 4096, 8192, 0, &r) == MD25Q64_INVALID_PARAM);
+    CHECK(MD25Q64_EraseRange(&h, NOR_SIZE - 4096, 4096, 0, &r) == MD25Q64_OK);
+    CHECK(r.erases_4k == 1);
+}
+
+static void random_ranges(void)
+{
+    MD25Q64_EraseReport r;
+    uint32_t s, len, a, e4, e32, e64;
+    int n, skip;
+
+    for (n = 0; n < 300; n++) {
+        CHECK(MD25Q64_EraseRange(&h, AREA, AREA_LEN, 0, NULL) == MD25Q64_OK);
+        dirty(AREA, AREA_LEN, 60);
+        snapshot();
+        s = AREA + (uint32_t)(rand() % 200) * 4096u;
+        len = (uint32_t)(1 + rand() % 50) * 4096u;
+        skip = n & 1;
+        CHECK(MD25Q64_EraseRange(&h, s, len, (uint8_t)skip, &r) == MD25Q64_OK);
+        verify(s, len);
+        CHECK(r.sectors == len / 4096u);
+        CHECK(r.skipped == (skip ? blank_sectors(s, len) : 0u));
+        CHECK(r.planned_ms <= r.naive_ms);
+        if (skip) {
+            continue;
+        }
+        /* Without checks: largest aligned erase that fits, in order */
+        e4 = e32 = e64 = 0;
+        for (a = s; a < s + len;) {
+            if (a % 65536u == 0 && a + 65536u <= s + len) {
+                e64++;
+                a += 65536u;
+            } else if (a % 32768u == 0 && a + 32768u <= s + len) {
+                e32++;
+                a += 32768u;
+            } else {
+                e4++;
+                a += 4096u;
+            }
+        }
+        CHECK(r.erases_4k == e4 && r.erases_32k == e32 && r.erases_64k == e64);
+    }
+    printf("random ranges: 300, coverage exact\n");
+}
+
+/* Reads of another region go through while the job runs */
+static void async_job(void)
+{
+    static MD25Q64_EraseJob job;
+    uint8_t b[64];
+    int reads = 0;
+
+    dirty(AREA, AREA_LEN, 100);
+    snapshot();
+    CHECK(MD25Q64_EraseRange_Start(&job, &h, AREA + 0x3000, 0x40000, 1, NULL, NULL) == MD25Q64_OK);
+    while (!job.done) {
+        MD25Q64_Poll(&h);
+        if (MD25Q64_Read(&h, 0x100000, b, sizeof(b)) == MD25Q64_OK) {
+            reads++;
+        }
+    }
+    CHECK(job.status == MD25Q64_OK);
+    verify(AREA + 0x3000, 0x40000);
+    CHECK(reads > 100);
+    printf("async: %d reads served during a %lu ms range erase\n", reads,
+           (unsigned long)job.report.actual_ms);
+}
+
+static uint32_t erase_ms(uint32_t a, uint32_t len, int skip, MD25Q64_EraseReport *r)
+{
+    uint64_t t0 = nor_now_us;
+    uint32_t s;
+
+    if (skip < 0) {
+        for (s = a; s < a + len; s += 4096u) {
+            CHECK(MD25Q64_EraseSector(&h, s) == MD25Q64_OK);
+        }
+    } else {
+        CHECK(MD25Q64_EraseRange(&h, a, len, (uint8_t)skip, r) == MD25Q64_OK);
+    }
+    return (uint32_t)((nor_now_us - t0) / 1000u);
+}
+
+static void time_saved(void)
+{
+    static const struct {
+        const char *name;
+        uint32_t a, len;
+        int density;
+    } cases[] = {
+        {"100K misaligned, dirty", AREA + 0x3000, 100u * 1024u, 100},
+        {"1M aligned, dirty",      AREA, 0x100000, 100},
+        {"1M, 10% sectors dirty",  AREA, 0x100000, 10},
+        {"1M, already blank",      AREA, 0x100000, 0},
+    };
+    MD25Q64_EraseReport r0, r1;
+    uint32_t tn, t0, t1;
+    unsigned c;
+
+    printf("  %-24s %9s %9s %9s   4k/32k/64k skipped   (emulated ms)\n",
+           "case", "sectors", "plan", "skip");
+    for (c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        CHECK(MD25Q64_EraseRange(&h, AREA, AREA_LEN, 0, NULL) == MD25Q64_OK);
+        dirty(cases[c].a, cases[c].len, cases[c].density);
+        snapshot();
+        tn = erase_ms(cases[c].a, cases[c].len, -1, NULL);
+        restore();
+        t0 = erase_ms(cases[c].a, cases[c].len, 0, &r0);
+        verify(cases[c].a, cases[c].len);
+        restore();
+        t1 = erase_ms(cases[c].a, cases[c].len, 1, &r1);
+        verify(cases[c].a, cases[c].len);
+        printf("  %-24s %9lu %9lu %9lu   %u/%u/%u %u\n", cases[c].name, (unsigned long)tn,
+               (unsigned long)t0, (unsigned long)t1, r1.erases_4k, r1.erases_32k,
+               r1.erases_64k, r1.skipped);
+        CHECK(t0 < tn && t1 <= t0 * 11u / 10u);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    emu_open("test_erase", argc, argv);
+    CHECK(emu_init(&h, 1) == MD25Q64_OK);
+    params();
+    random_ranges();
+    async_job();
+    time_saved();
+    return emu_finish();
+}
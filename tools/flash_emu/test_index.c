@@ -0,0 +1,223 @@
+/**
+ * @file    test_index.c
+ * @brief   Flash log time index: range queries against a filtered linear
+ *          scan on a full 8 MB log, and power cuts during appends with
+ *          random-range queries checked against the iterator after every
+ *          remount
+ * @details Query log: two days of 48-byte samples at 1 Hz with a 6 h
+ *          outage in the middle, wrapping the 2048-sector ring once.
+ *          Power cuts: 16 sectors, records of 4..203 bytes with stamps
+ *          stepping 0..2, every other round through the write buffer;
+ *          400 rounds for each of 10 seeds.
+ */
+
+#include "emu_test.h"
+#include "flash_log.h"
+#include "md25q64_wbuf.h"
+
+#include <setjmp.h>
+
+#define LOG_SECTORS     2048u
+#define T0              1000000u
+#define HALF            120000u
+#define OUTAGE          (6u * 3600u)
+
+typedef struct {
+    uint32_t ts;
+    float f[10];
+    uint32_t pad;
+} Sample;
+
+static MD25Q64_Handle h;
+static FlashLog lg;
+static MD25Q64_WBuf wb;
+static FlashLog_Span spans[LOG_SECTORS];
+static uint32_t now_ts = T0;
+
+static uint32_t stamp(const void *data, uint16_t len)
+{
+    uint32_t t;
+
+    (void)len;
+    memcpy(&t, data, sizeof(t));
+    return t;
+}
+
+static void append(uint32_t n)
+{
+    Sample s;
+
+    memset(&s, 0, sizeof(s));
+    while (n--) {
+        s.ts = now_ts++;
+        CHECK(FlashLog_Append(&lg, &s, sizeof(s)) == FLASHLOG_OK);
+        FlashLog_Maintain(&lg);
+        MD25Q64_Poll(&h);
+    }
+}
+
+static void mount(uint16_t sectors, int use_wbuf)
+{
+    CHECK(FlashLog_Mount(&lg, &h, 0, sectors) == FLASHLOG_OK);
+    CHECK(FlashLog_SetIndex(&lg, stamp, spans) == FLASHLOG_OK);
+    if (use_wbuf) {
+        MD25Q64_WBuf_Init(&wb, &h, 10000);
+        FlashLog_SetWriteBuffer(&lg, &wb);
+    }
+}
+
+/* ============================================================================
+ * Queries on the full log
+ * ============================================================================ */
+static void run(const char *name, uint32_t from, uint32_t to)
+{
+    FlashLog_Iter it;
+    FlashLog_Query q;
+    Sample s;
+    uint16_t len;
+    uint32_t n1 = 0, n2 = 0, c1 = 0, c2 = 0;
+    uint64_t t, lin, idx;
+
+    t = nor_now_us;
+    FlashLog_IterInit(&lg, &it);
+    while (FlashLog_IterNext(&it, &s, sizeof(s), &len) == FLASHLOG_OK && s.ts <= to) {
+        if (s.ts >= from) {
+            n1++;
+            c1 = c1 * 31u + s.ts;
+        }
+    }
+    lin = nor_now_us - t;
+
+    t = nor_now_us;
+    CHECK(FlashLog_QueryInit(&lg, &q, from, to) == FLASHLOG_OK);
+    while (FlashLog_QueryNext(&q, &s, sizeof(s), &len) == FLASHLOG_OK) {
+        n2++;
+        c2 = c2 * 31u + s.ts;
+    }
+    idx = nor_now_us - t;
+
+    printf("  %-22s %7lu %9.1f %9.1f %6u\n", name, (unsigned long)n1, lin / 1000.0, idx / 1000.0,
+           q.sectors);
+    CHECK(n1 == n2 && c1 == c2);
+}
+
+static void query_test(void)
+{
+    uint32_t end = T0 + 2u * HALF + OUTAGE, oldest;
+    FlashLog_Iter it;
+    Sample s;
+    uint16_t len;
+    uint64_t t;
+
+    CHECK(emu_init(&h, 1) == MD25Q64_OK);
+    mount(LOG_SECTORS, 1);
+    append(HALF);
+    now_ts += OUTAGE;
+    append(HALF);
+    CHECK(MD25Q64_WBuf_Flush(&wb) == MD25Q64_OK);
+    emu_drain(&h, 1000);
+
+    /* Reboot */
+    shim_reset();
+    CHECK(emu_init(&h, 1) == MD25Q64_OK);
+    t = nor_now_us;
+    mount(LOG_SECTORS, 1);
+    printf("mount + index: %.1f ms, %u sectors in use\n", (nor_now_us - t) / 1000.0,
+           FlashLog_UsedSectors(&lg));
+    FlashLog_IterInit(&lg, &it);
+    CHECK(FlashLog_IterNext(&it, &s, sizeof(s), &len) == FLASHLOG_OK);
+    oldest = s.ts;
+    CHECK(oldest > T0);                                     /* Wrapped */
+
+    printf("  query                  records    linear     index  sectors   (ms)\n");
+    run("last minute", end - 60u, end);
+    run("last hour", end - 3600u, end);
+    run("1 h, middle", end - 100000u, end - 96400u);
+    run("1 h, oldest", oldest, oldest + 3600u);
+    run("before oldest", 0, oldest - 1u);
+    run("inside outage", T0 + HALF + 60u, T0 + HALF + 3600u);
+    run("everything", 0, 0xFFFFFFFEu);
+    append(500);
+    run("last 500 s, appended", now_ts - 500u, now_ts);
+}
+
+/* ============================================================================
+ * Power cuts
+ * ============================================================================ */
+static void check_queries(void)
+{
+    FlashLog_Iter it;
+    FlashLog_Query q;
+    uint8_t r[256];
+    uint16_t len;
+    uint32_t a, b, n1, n2, ts;
+    int k;
+
+    for (k = 0; k < 30; k++) {
+        a = (uint32_t)rand() % 200000u;
+        b = a + (uint32_t)rand() % 5000u;
+        n1 = n2 = 0;
+        FlashLog_IterInit(&lg, &it);
+        while (FlashLog_IterNext(&it, r, sizeof(r), &len) == FLASHLOG_OK) {
+            memcpy(&ts, r, 4);
+            n1 += (ts >= a && ts <= b);
+        }
+        CHECK(FlashLog_QueryInit(&lg, &q, a, b) == FLASHLOG_OK);
+        while (FlashLog_QueryNext(&q, r, sizeof(r), &len) == FLASHLOG_OK) {
+            memcpy(&ts, r, 4);
+            CHECK(ts >= a && ts <= b);
+            n2++;
+        }
+        CHECK(n1 == n2);
+    }
+}
+
+static void cut_test(unsigned seed)
+{
+    static jmp_buf env;
+    static uint32_t ts;
+    static int r;
+    uint8_t rec[256];
+    uint16_t len;
+
+    srand(seed);
+    ts = 0;
+    shim_reset();
+    CHECK(emu_init(&h, 1) == MD25Q64_OK);
+    CHECK(MD25Q64_EraseBlock64K(&h, 0) == MD25Q64_OK);
+    for (r = 0; r < 400; r++) {
+        mount(16, r & 1);
+        check_queries();
+        nor_arm_cut(1 + rand() % 20000, &env);
+        if (setjmp(env) == 0) {
+            for (;;) {
+                len = (uint16_t)(4 + rand() % 200);
+                ts += (uint32_t)rand() % 3u;
+                memcpy(rec, &ts, 4);
+                FlashLog_Append(&lg, rec, len);
+                if (rand() % 8 == 0) {
+                    FlashLog_Maintain(&lg);
+                }
+                nor_now_us += (uint64_t)(rand() % 2000);
+                MD25Q64_Poll(&h);
+            }
+        }
+        nor_disarm_cut();
+        shim_reset();
+        nor_now_us += 100000;
+        CHECK(emu_init(&h, 1) == MD25Q64_OK);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    unsigned seed;
+
+    emu_open("test_index", argc, argv);
+    query_test();
+    for (seed = 1; seed <= 10; seed++) {
+        cut_test(seed);
+    }
+    printf("power cuts: 10 seeds x 400 rounds, 30 random ranges after each remount\n");
+    return emu_finish();
+}
@@ -0,0 +1,111 @@
+/**
+ * @file    test_md25q64.c
+ * @brief   md25q64.c against the emulator: ID, read/program/erase semantics,
+ *          timing, wear, suspend, DMA and persistence of the image
+ */
+
+#include "emu_test.h"
+
+static MD25Q64_Handle h;
+static uint8_t wb[8192], rb[8192];
+static int done;
+static MD25Q64_Status done_status;
+
+static void on_done(MD25Q64_Handle *handle, MD25Q64_Status status, void *ctx)
+{
+    (void)handle;
+    (void)ctx;
+    done++;
+    done_status = status;
+}
+
+int main(int argc, char **argv)
+{
+    const NorTiming *t = &nor_timing_gd25q64;
+    uint32_t id, i;
+    uint64_t t0;
+    long d0;
+    uint8_t x = 0x0F, y = 0xF3;
+
+    emu_open("test_md25q64", argc, argv);
+    for (i = 0; i < sizeof(wb); i++) {
+        wb[i] = (uint8_t)rand();
+    }
+    CHECK(emu_init(&h, 0) == MD25Q64_OK);
+    CHECK(MD25Q64_ReadJEDECID(&h, &id) == MD25Q64_OK && id == NOR_JEDEC_ID);
+
+    /* Erase time follows the model, wear counted */
+    t0 = nor_now_us;
+    CHECK(MD25Q64_EraseSector(&h, 0x10000) == MD25Q64_OK);
+    CHECK(nor_now_us - t0 >= t->t_se_us && nor_now_us - t0 < t->t_se_us + 2500);
+    CHECK(nor_wear[0x10] == 1);
+
+    /* Write across pages, read and fast read back */
+    CHECK(MD25Q64_Write(&h, 0x10000 + 37, wb, 3000) == MD25Q64_OK);
+    CHECK(MD25Q64_Read(&h, 0x10000 + 37, rb, 3000) == MD25Q64_OK && memcmp(rb, wb, 3000) == 0);
+    memset(rb, 0, sizeof(rb));
+    CHECK(MD25Q64_FastRead(&h, 0x10000 + 37, rb, 3000) == MD25Q64_OK && memcmp(rb, wb, 3000) == 0);
+
+    /* Programming over data only clears bits */
+    CHECK(MD25Q64_EraseSector(&h, 0x11000) == MD25Q64_OK);
+    CHECK(MD25Q64_PageProgram(&h, 0x11000, &x, 1) == MD25Q64_OK);
+    CHECK(MD25Q64_PageProgram(&h, 0x11000, &y, 1) == MD25Q64_OK);
+    CHECK(MD25Q64_Read(&h, 0x11000, rb, 1) == MD25Q64_OK && rb[0] == (0x0F & 0xF3));
+
+    /* Page wrap: 20 bytes at offset 250 land at 250..255 and 0..13 */
+    CHECK(MD25Q64_PageProgram(&h, 0x11100 + 250, wb, 20) == MD25Q64_OK);
+    CHECK(MD25Q64_Read(&h, 0x11100, rb, 256) == MD25Q64_OK);
+    CHECK(memcmp(rb + 250, wb, 6) == 0 && memcmp(rb, wb + 6, 14) == 0 && rb[14] == 0xFF);
+
+    /* 32K / 64K erase: time and wear on every covered sector */
+    t0 = nor_now_us;
+    CHECK(MD25Q64_EraseBlock32K(&h, 0x20000) == MD25Q64_OK);
+    CHECK(nor_now_us - t0 >= t->t_be32_us);
+    t0 = nor_now_us;
+    CHECK(MD25Q64_EraseBlock64K(&h, 0x30000) == MD25Q64_OK);
+    CHECK(nor_now_us - t0 >= t->t_be64_us);
+    for (i = 0x20; i < 0x28; i++) CHECK(nor_wear[i] == 1);
+    for (i = 0x30; i < 0x40; i++) CHECK(nor_wear[i] == 1);
+    CHECK(nor_wear[0x28] == 0);
+
+    /* A read during an erase suspends it and is served in microseconds */
+    done = 0;
+    CHECK(MD25Q64_EraseSector_Start(&h, 0x12000, on_done, NULL) == MD25Q64_OK);
+    nor_now_us += 5000;
+    MD25Q64_Poll(&h);
+    t0 = nor_now_us;
+    CHECK(MD25Q64_Read(&h, 0x10000 + 37, rb, 512) == MD25Q64_OK && memcmp(rb, wb, 512) == 0);
+    CHECK(nor_now_us - t0 < 500 && nor_stats.suspends == 1 && done == 0);
+    CHECK(MD25Q64_Flush(&h) == MD25Q64_OK && done == 1 && done_status == MD25Q64_OK);
+    CHECK(nor_stats.resumes == 1);
+
+    /* DMA: 16 page programs and one 4K read */
+    CHECK(emu_init(&h, 1) == MD25Q64_OK);
+    d0 = shim_dma_transfers;
+    CHECK(MD25Q64_EraseSector(&h, 0x13000) == MD25Q64_OK);
+    CHECK(MD25Q64_Write(&h, 0x13000, wb + 100, 4096) == MD25Q64_OK);
+    CHECK(MD25Q64_FastRead(&h, 0x13000, rb, 4096) == MD25Q64_OK && memcmp(rb, wb + 100, 4096) == 0);
+    CHECK(shim_dma_transfers - d0 == 17);
+    CHECK(emu_init(&h, 0) == MD25Q64_OK);
+
+    /* Chip erase: 25 s of virtual time, every sector worn once more */
+    done = 0;
+    t0 = nor_now_us;
+    CHECK(MD25Q64_EraseChip_Start(&h, on_done, NULL) == MD25Q64_OK);
+    while (!done) {
+        nor_now_us += 1000;
+        MD25Q64_Poll(&h);
+    }
+    CHECK(done_status == MD25Q64_OK && nor_now_us - t0 >= t->t_ce_us);
+    CHECK(nor_wear[0x400] == 1 && nor_wear[0x10] == 2);
+
+    /* The image and wear survive close / open */
+    CHECK(MD25Q64_Write(&h, 0x7FF000, wb, 100) == MD25Q64_OK);
+    nor_close();
+    CHECK(nor_open(emu_image, t) == 0);
+    CHECK(emu_init(&h, 0) == MD25Q64_OK);
+    CHECK(MD25Q64_Read(&h, 0x7FF000, rb, 100) == MD25Q64_OK && memcmp(rb, wb, 100) == 0);
+    CHECK(nor_wear[0x10] == 2);
+
+    return emu_finish();
+}
@@ -0,0 +1,205 @@
+/**
+ * @file    test_queue.c
+ * @brief   MD25Q64 operation queue: *_Start() returns at once, Poll()
+ *          advances without waiting, callbacks chain, BUSY when full,
+ *          blocking calls keep FIFO order, timeouts, and a random mix of
+ *          queued operations checked against a shadow image
+ */
+
+#include "emu_test.h"
+
+static MD25Q64_Handle h;
+static int done_n;
+static MD25Q64_Status done_st[16];
+static uint64_t done_t[16];
+static uint8_t wbuf[5000], rbuf[5000];
+
+static void on_done(MD25Q64_Handle *handle, MD25Q64_Status status, void *ctx)
+{
+    (void)handle;
+    (void)ctx;
+    done_st[done_n] = status;
+    done_t[done_n] = nor_now_us;
+    done_n++;
+}
+
+static void on_erased(MD25Q64_Handle *handle, MD25Q64_Status status, void *ctx)
+{
+    on_done(handle, status, ctx);
+    CHECK(MD25Q64_Write_Start(handle, 0x20010, wbuf, 600, on_done, NULL) == MD25Q64_OK);
+}
+
+/* Scheduler: one Poll per 1 ms tick until the queue is empty */
+static int run_ticks(int max)
+{
+    int t = 0;
+
+    while (!MD25Q64_IsIdle(&h) && t < max) {
+        nor_now_us += 1000;
+        MD25Q64_Poll(&h);
+        t++;
+    }
+    return t;
+}
+
+static int all_erased(const uint8_t *p, uint32_t n)
+{
+    while (n-- > 0) {
+        if (*p++ != 0xFF) return 0;
+    }
+    return 1;
+}
+
+/* Random erases, writes and reads over 128 KB; every read must see exactly
+ * the operations submitted before it */
+static void random_mix(void)
+{
+    static uint8_t shadow[0x20000], src[64][256], got[512];
+    const uint32_t base = 0xA0000;
+    uint32_t a, n, i;
+    int it, k, si = 0;
+
+    memcpy(shadow, nor_mem() + base, sizeof(shadow));
+    for (it = 0; it < 20000; it++) {
+        k = rand() % 10;
+        a = base + (uint32_t)(rand() % 0x20000);
+        if (k == 0) {
+            a &= ~4095u;
+            if (MD25Q64_EraseSector_Start(&h, a, NULL, NULL) == MD25Q64_OK) {
+                memset(shadow + (a - base), 0xFF, 4096);
+            }
+        } else if (k < 4) {
+            uint8_t *s = src[si++ % 64];
+            n = 1 + (uint32_t)rand() % 200;
+            if (a + n > base + 0x20000) n = base + 0x20000 - a;
+            for (i = 0; i < n; i++) s[i] = (uint8_t)rand();
+            if (MD25Q64_Write_Start(&h, a, s, n, NULL, NULL) == MD25Q64_OK) {
+                for (i = 0; i < n; i++) shadow[a - base + i] &= s[i];
+            }
+        } else if (k < 7) {
+            n = 1 + (uint32_t)rand() % 512;
+            if (a + n > base + 0x20000) n = base + 0x20000 - a;
+            done_n = 0;
+            if (MD25Q64_Read_Start(&h, a, got, n, on_done, NULL) == MD25Q64_OK) {
+                while (done_n == 0) {
+                    nor_now_us += 1 + (uint64_t)(rand() % 800);
+                    MD25Q64_Poll(&h);
+                }
+                if (memcmp(got, shadow + (a - base), n) != 0) {
+                    printf("mix %d: read of %u at %06X differs\n", it, n, a);
+                    emu_fails++;
+                    return;
+                }
+            }
+        } else {
+            nor_now_us += (uint64_t)(rand() % 3000);
+            MD25Q64_Poll(&h);
+        }
+        /* Program sources must outlive their op: keep the queue short */
+        while (h.q_count >= 3) {
+            nor_now_us += 500;
+            MD25Q64_Poll(&h);
+        }
+    }
+    run_ticks(100000);
+    CHECK(memcmp(shadow, nor_mem() + base, sizeof(shadow)) == 0);
+    printf("random mix: 20000 ops, %lu reads, average wait %.2f ms\n",
+           (unsigned long)h.stats.reads, (double)h.stats.read_wait_sum_ms / h.stats.reads);
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t t0, t_start, te;
+    long r0;
+    int i, ticks;
+
+    emu_open("test_queue", argc, argv);
+    memset(nor_mem(), 0x00, NOR_SIZE);          /* Not erased: erases must show */
+    for (i = 0; i < (int)sizeof(wbuf); i++) {
+        wbuf[i] = (uint8_t)rand();
+    }
+    CHECK(emu_init(&h, 0) == MD25Q64_OK);
+
+    /* Blocking wrappers and parameter checks */
+    t0 = nor_now_us;
+    CHECK(MD25Q64_EraseSector(&h, 0x10000) == MD25Q64_OK);
+    te = nor_now_us - t0;
+    CHECK(MD25Q64_Write(&h, 0x10000 + 100, wbuf, 1000) == MD25Q64_OK);
+    CHECK(MD25Q64_Read(&h, 0x10000 + 100, rbuf, 1000) == MD25Q64_OK && memcmp(rbuf, wbuf, 1000) == 0);
+    CHECK(MD25Q64_PageProgram(&h, 0x10000 + 2048, wbuf, 256) == MD25Q64_OK);
+    CHECK(MD25Q64_Read(&h, 0x10000 + 2048, rbuf, 256) == MD25Q64_OK && memcmp(rbuf, wbuf, 256) == 0);
+    CHECK(MD25Q64_PageProgram(&h, 0, wbuf, 257) == MD25Q64_INVALID_PARAM);
+    CHECK(MD25Q64_Write(&h, NOR_SIZE - 10, wbuf, 11) == MD25Q64_INVALID_PARAM);
+    CHECK(MD25Q64_EraseSector(&h, NOR_SIZE) == MD25Q64_INVALID_PARAM);
+    printf("blocking sector erase: %.1f ms (chip tSE %u us)\n", te / 1000.0, nor_timing.t_se_us);
+
+    /* Async erase returns at once; its callback chains a write */
+    done_n = 0;
+    t0 = nor_now_us;
+    CHECK(MD25Q64_EraseSector_Start(&h, 0x20000, on_erased, NULL) == MD25Q64_OK);
+    t_start = nor_now_us - t0;
+    CHECK(t_start < 100);
+    r0 = nor_stats.rdsr;
+    ticks = run_ticks(1000);
+    CHECK(done_n == 2 && done_st[0] == MD25Q64_OK && done_st[1] == MD25Q64_OK);
+    /* One status read per tick, never a busy-wait */
+    CHECK(nor_stats.rdsr - r0 <= ticks + 1);
+    printf("async erase: Start %llu us, erased after %.1f ms, chained 600 B write after %.1f ms, "
+           "%d ticks, %ld RDSR\n", (unsigned long long)t_start, (done_t[0] - t0) / 1000.0,
+           (done_t[1] - t0) / 1000.0, ticks, nor_stats.rdsr - r0);
+    CHECK(MD25Q64_Read(&h, 0x20010, rbuf, 600) == MD25Q64_OK && memcmp(rbuf, wbuf, 600) == 0);
+    CHECK(MD25Q64_Read(&h, 0x20000, rbuf, 16) == MD25Q64_OK && all_erased(rbuf, 16));
+
+    /* One active and MD25Q64_QUEUE_LEN waiting, then BUSY */
+    done_n = 0;
+    CHECK(MD25Q64_EraseSector_Start(&h, 0x30000, on_done, NULL) == MD25Q64_OK);
+    for (i = 0; i < MD25Q64_QUEUE_LEN; i++) {
+        CHECK(MD25Q64_EraseSector_Start(&h, 0x31000 + (uint32_t)i * 4096, on_done, NULL) == MD25Q64_OK);
+    }
+    CHECK(MD25Q64_EraseSector_Start(&h, 0x40000, on_done, NULL) == MD25Q64_BUSY);
+    /* A blocking read waits for the erases queued before it (the last may
+     * be suspended for it, it is outside the read) */
+    CHECK(MD25Q64_Read(&h, 0x30000, rbuf, 4096) == MD25Q64_OK && all_erased(rbuf, 4096));
+    CHECK(done_n >= MD25Q64_QUEUE_LEN);
+    run_ticks(1000);
+    CHECK(done_n == MD25Q64_QUEUE_LEN + 1 && MD25Q64_IsIdle(&h));
+
+    /* A blocking write behind an async erase runs after it */
+    done_n = 0;
+    CHECK(MD25Q64_EraseSector_Start(&h, 0x50000, on_done, NULL) == MD25Q64_OK);
+    CHECK(MD25Q64_Write(&h, 0x50000, wbuf, 300) == MD25Q64_OK);
+    CHECK(done_n == 1);
+    CHECK(MD25Q64_Read(&h, 0x50000, rbuf, 300) == MD25Q64_OK && memcmp(rbuf, wbuf, 300) == 0);
+
+    /* Chip busy past MD25Q64_TIMEOUT_SECTOR_ERASE: the op times out */
+    done_n = 0;
+    nor_timing.t_se_us = 900000;
+    CHECK(MD25Q64_EraseSector_Start(&h, 0x60000, on_done, NULL) == MD25Q64_OK);
+    run_ticks(2000);
+    CHECK(done_n == 1 && done_st[0] == MD25Q64_TIMEOUT);
+    while (nor_busy()) {
+        nor_now_us += 1000;
+    }
+    nor_timing.t_se_us = nor_timing_gd25q64.t_se_us;
+
+    /* 64K erase, then a 5000 byte write split into pages from an odd offset */
+    done_n = 0;
+    CHECK(MD25Q64_EraseBlock64K_Start(&h, 0x70000, on_done, NULL) == MD25Q64_OK);
+    CHECK(MD25Q64_Write_Start(&h, 0x70000 + 77, wbuf, 5000, on_done, NULL) == MD25Q64_OK);
+    ticks = run_ticks(5000);
+    CHECK(done_n == 2 && done_st[1] == MD25Q64_OK);
+    CHECK(MD25Q64_Read(&h, 0x70000 + 77, rbuf, 5000) == MD25Q64_OK && memcmp(rbuf, wbuf, 5000) == 0);
+    printf("64K erase + 5000 B write: %d ticks\n", ticks);
+
+    /* A queued read behind a program waits for WIP and sees the new data */
+    done_n = 0;
+    memset(rbuf, 0, sizeof(rbuf));
+    CHECK(MD25Q64_EraseSector_Start(&h, 0x80000, on_done, NULL) == MD25Q64_OK);
+    CHECK(MD25Q64_PageProgram_Start(&h, 0x80000, wbuf + 7, 256, on_done, NULL) == MD25Q64_OK);
+    CHECK(MD25Q64_Read_Start(&h, 0x80000, rbuf, 256, on_done, NULL) == MD25Q64_OK);
+    run_ticks(1000);
+    CHECK(done_n == 3 && done_st[2] == MD25Q64_OK && memcmp(rbuf, wbuf + 7, 256) == 0);
+
+    random_mix();
+    return emu_finish();
+}
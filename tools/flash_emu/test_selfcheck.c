@@ -0,0 +1,75 @@
+/**
+ * @file    test_selfcheck.c
+ * @brief   The boot self-check is read-only: MD25Q64_Init, the handle's
+ *          cache, MD25Q64_SelfCheck and the signature page read, in the
+ *          order storage_init() and boot_selfcheck() run them, send no
+ *          write enable, program or erase, blank chip or signed. An erase
+ *          still running from before an MCU reset reads back as BUSY.
+ */
+
+#include "emu_test.h"
+#include "flash_map.h"
+#include "md25q64_cache.h"
+
+static MD25Q64_Handle h;
+static MD25Q64_Cache cache;
+static MD25Q64_CacheLine lines[32];
+static uint8_t sig[48];
+
+/* storage_init() and boot_selfcheck() flash traffic; returns the check */
+static MD25Q64_Status boot_sequence(MD25Q64_Info *info, uint64_t *check_us)
+{
+    MD25Q64_Status st;
+    uint64_t t0;
+
+    CHECK(emu_init(&h, 1) == MD25Q64_OK);
+    MD25Q64_Cache_Init(&cache, lines, 32);
+    MD25Q64_SetCache(&h, &cache);
+    t0 = nor_now_us;
+    st = MD25Q64_SelfCheck(&h, info);
+    if (st == MD25Q64_OK) {
+        CHECK(MD25Q64_Read(&h, FLASH_SIG_ADDR, sig, sizeof(sig)) == MD25Q64_OK);
+    }
+    *check_us = nor_now_us - t0;
+    return st;
+}
+
+int main(int argc, char **argv)
+{
+    MD25Q64_Info info;
+    NorStats before;
+    uint64_t us;
+    unsigned i;
+
+    emu_open("test_selfcheck", argc, argv);
+
+    /* Blank chip: nothing written, the page reads blank */
+    before = nor_stats;
+    CHECK(boot_sequence(&info, &us) == MD25Q64_OK);
+    CHECK(info.jedec_id == NOR_JEDEC_ID);
+    CHECK(nor_stats.wrens == before.wrens && nor_stats.programs == before.programs &&
+          nor_stats.erases == before.erases);
+    for (i = 0; i < sizeof(sig); i++) CHECK(sig[i] == 0xFF);
+    CHECK(us < 100);
+    printf("self-check + signature read: %llu us, %ld commands, %ld write enables\n",
+           (unsigned long long)us, nor_stats.cmds - before.cmds, nor_stats.wrens - before.wrens);
+
+    /* A page that is not ours: still read-only */
+    memset(nor_mem() + FLASH_SIG_ADDR, 0x5A, sizeof(sig));
+    before = nor_stats;
+    CHECK(boot_sequence(&info, &us) == MD25Q64_OK);
+    CHECK(sig[0] == 0x5A && sig[sizeof(sig) - 1] == 0x5A);
+    CHECK(nor_stats.wrens == before.wrens && nor_stats.programs == before.programs &&
+          nor_stats.erases == before.erases);
+
+    /* MCU reset during a block erase: the chip keeps erasing */
+    CHECK(MD25Q64_EraseBlock64K_Start(&h, 0x400000, NULL, NULL) == MD25Q64_OK);
+    nor_now_us += 10000;
+    shim_reset();
+    before = nor_stats;
+    CHECK(boot_sequence(&info, &us) == MD25Q64_BUSY);
+    CHECK(info.sr1 & MD25Q64_SR1_WIP);
+    CHECK(nor_stats.wrens == before.wrens && nor_stats.erases == before.erases);
+
+    return emu_finish();
+}
@@ -0,0 +1,173 @@
+/**
+ * @file    test_suspend.c
+ * @brief   Erase suspend for reads and the flash_log erase-ahead: read
+ *          latency during an erase, reads of the erasing block, FIFO order,
+ *          read storms not starving the erase, suspended time not counted
+ *          toward the timeout, and appends at sector boundaries not
+ *          waiting for an erase. Polled and DMA passes.
+ */
+
+#include "emu_test.h"
+#include "flash_log.h"
+
+static MD25Q64_Handle h;
+static FlashLog lg;
+static int done_n;
+static MD25Q64_Status done_st[8];
+static uint64_t done_t[8];
+static uint8_t wbuf[512], rbuf[512];
+static uint8_t big[16384];             /* 6.5 ms on the bus */
+
+static void on_done(MD25Q64_Handle *handle, MD25Q64_Status status, void *ctx)
+{
+    (void)handle;
+    (void)ctx;
+    done_st[done_n] = status;
+    done_t[done_n] = nor_now_us;
+    done_n++;
+}
+
+static void run_ticks(int max)
+{
+    while (!MD25Q64_IsIdle(&h) && max-- > 0) {
+        nor_now_us += 1000;
+        MD25Q64_Poll(&h);
+    }
+}
+
+static void suspend_cases(int use_dma)
+{
+    uint64_t te0, t1, lat;
+    long s0 = nor_stats.suspends, r0 = nor_stats.resumes;
+    int i;
+
+    CHECK(emu_init(&h, use_dma) == MD25Q64_OK);
+    CHECK(MD25Q64_EraseSector(&h, 0x70000) == MD25Q64_OK);
+    CHECK(MD25Q64_Write(&h, 0x70000 + 77, wbuf, 300) == MD25Q64_OK);
+
+    /* A read of another block during a sector erase returns in about tSUS */
+    done_n = 0;
+    memset(nor_mem() + 0x90000, 0, 4096);
+    CHECK(MD25Q64_EraseSector_Start(&h, 0x90000, on_done, NULL) == MD25Q64_OK);
+    te0 = nor_now_us;
+    for (i = 0; i < 10; i++) {
+        nor_now_us += 1000;
+        MD25Q64_Poll(&h);
+    }
+    t1 = nor_now_us;
+    CHECK(MD25Q64_Read(&h, 0x70000 + 77, rbuf, 300) == MD25Q64_OK && memcmp(rbuf, wbuf, 300) == 0);
+    lat = nor_now_us - t1;
+    CHECK(lat < 1000);
+    CHECK(nor_stats.suspends - s0 == 1 && h.stats.suspends == 1);
+    CHECK(done_n == 0 && !MD25Q64_IsIdle(&h));
+    run_ticks(1000);
+    CHECK(done_n == 1 && done_st[0] == MD25Q64_OK && nor_stats.resumes - r0 == 1);
+    CHECK(done_t[0] - te0 >= nor_timing.t_se_us);
+    for (i = 0; i < 4096; i++) {
+        if (nor_mem()[0x90000 + i] != 0xFF) { CHECK(0); break; }
+    }
+    printf("%s: read during erase %llu us, erase done after %.1f ms\n", use_dma ? "dma" : "polled",
+           (unsigned long long)lat, (done_t[0] - te0) / 1000.0);
+
+    /* A read inside the erasing sector waits for the erase */
+    s0 = nor_stats.suspends;
+    done_n = 0;
+    CHECK(MD25Q64_EraseSector_Start(&h, 0x91000, on_done, NULL) == MD25Q64_OK);
+    nor_now_us += 5000;
+    MD25Q64_Poll(&h);
+    t1 = nor_now_us;
+    CHECK(MD25Q64_Read(&h, 0x91000 + 100, rbuf, 16) == MD25Q64_OK);
+    CHECK(nor_stats.suspends == s0 && done_n == 1 && nor_now_us - t1 > nor_timing.t_se_us - 6000);
+    for (i = 0; i < 16; i++) CHECK(rbuf[i] == 0xFF);
+
+    /* A program behind the read resumes the erase first: FIFO order holds */
+    done_n = 0;
+    CHECK(MD25Q64_EraseSector_Start(&h, 0x92000, on_done, NULL) == MD25Q64_OK);
+    nor_now_us += 5000;
+    MD25Q64_Poll(&h);
+    nor_now_us += 5000;
+    CHECK(MD25Q64_Read_Start(&h, 0x70000 + 77, rbuf, 100, on_done, NULL) == MD25Q64_OK);
+    CHECK(MD25Q64_PageProgram_Start(&h, 0x92000, wbuf, 64, on_done, NULL) == MD25Q64_OK);
+    CHECK(MD25Q64_Read_Start(&h, 0x92000, rbuf + 200, 64, on_done, NULL) == MD25Q64_OK);
+    run_ticks(1000);
+    CHECK(done_n == 4 && done_st[0] == MD25Q64_OK && done_st[3] == MD25Q64_OK);
+    CHECK(done_t[0] < done_t[1]);           /* The first read beat the erase */
+    CHECK(memcmp(rbuf, wbuf, 100) == 0 && memcmp(rbuf + 200, wbuf, 64) == 0);
+
+    /* Back-to-back reads cannot starve the erase */
+    done_n = 0;
+    te0 = nor_now_us;
+    CHECK(MD25Q64_EraseSector_Start(&h, 0x93000, on_done, NULL) == MD25Q64_OK);
+    while (done_n == 0 && nor_now_us - te0 < 2000000) {
+        nor_now_us += 200;
+        MD25Q64_Read(&h, 0x70000, rbuf, 32);
+    }
+    CHECK(done_n == 1 && done_st[0] == MD25Q64_OK);
+    printf("%s: erase under a read storm %.1f ms, %u suspends, read wait max %lu ms\n",
+           use_dma ? "dma" : "polled", (nor_now_us - te0) / 1000.0, (unsigned)h.stats.suspends,
+           (unsigned long)h.stats.read_wait_max_ms);
+
+    /* An async read stream cannot park the erase for good, and suspended
+     * time does not count toward its timeout: a 350 ms erase between
+     * long reads finishes well past the 500 ms limit */
+    done_n = 0;
+    nor_timing.t_se_us = 350000;            /* Under MD25Q64_TIMEOUT_SECTOR_ERASE */
+    te0 = nor_now_us;
+    CHECK(MD25Q64_EraseSector_Start(&h, 0x94000, on_done, NULL) == MD25Q64_OK);
+    while (done_n == 0 && nor_now_us - te0 < 10000000u) {
+        nor_now_us += 3000;
+        MD25Q64_Poll(&h);
+        if (!MD25Q64_IsIdle(&h)) {
+            MD25Q64_Read_Start(&h, 0x70000, big, sizeof(big), NULL, NULL);
+            nor_now_us += 3000;
+            MD25Q64_Poll(&h);
+        }
+    }
+    CHECK(done_n == 1 && done_st[0] == MD25Q64_OK);
+    CHECK(nor_now_us - te0 > MD25Q64_TIMEOUT_SECTOR_ERASE * 1000ull);
+    nor_timing.t_se_us = nor_timing_gd25q64.t_se_us;
+    run_ticks(100);
+}
+
+/* One record a second with the scheduler's 1 ms polls: with erase-ahead
+ * no append ever waits for an erase */
+static void erase_ahead_case(void)
+{
+    const uint32_t base = 0x400000;
+    uint8_t rec[200];
+    uint64_t t0, worst = 0;
+    int i, k;
+
+    CHECK(emu_init(&h, 0) == MD25Q64_OK);
+    CHECK(MD25Q64_EraseBlock64K(&h, base) == MD25Q64_OK);
+    CHECK(FlashLog_Mount(&lg, &h, base, 16) == FLASHLOG_OK);
+    CHECK(FlashLog_SetEraseAhead(&lg, 2) == FLASHLOG_OK);
+    for (i = 0; i < 2000; i++) {
+        memset(rec, i, sizeof(rec));
+        t0 = nor_now_us;
+        CHECK(FlashLog_Append(&lg, rec, sizeof(rec)) == FLASHLOG_OK);
+        if (nor_now_us - t0 > worst) worst = nor_now_us - t0;
+        FlashLog_Maintain(&lg);
+        for (k = 0; k < 100; k++) {
+            nor_now_us += 1000;
+            MD25Q64_Poll(&h);
+        }
+    }
+    /* 2000 x 200 B is about 100 sector changes */
+    CHECK(worst < nor_timing.t_se_us / 4);
+    printf("erase-ahead 2: worst append %llu us over 2000 records\n", (unsigned long long)worst);
+}
+
+int main(int argc, char **argv)
+{
+    int i;
+
+    emu_open("test_suspend", argc, argv);
+    for (i = 0; i < (int)sizeof(wbuf); i++) {
+        wbuf[i] = (uint8_t)rand();
+    }
+    suspend_cases(0);
+    suspend_cases(1);
+    erase_ahead_case();
+    return emu_finish();
+}
@@ -0,0 +1,251 @@
+/**
+ * @file    test_uplink.c
+ * @brief   Uplink store-and-forward over a simulated 4G link to a stand-in
+ *          server (uplink_server.js, the server's own parser and repeat
+ *          filter under node)
+ * @details A line every 250 ms, the queue and cursor logs as uplink_app
+ *          mounts them, 150 ms one-way latency, 1% of ACKs lost, the UART
+ *          charged at 115200 baud. The link schedule has two outages; an
+ *          MCU reset falls in the first one.
+ *            reset     40 min, down 5..12 and 20..23, reset at 8: every
+ *                      line arrives, none twice downstream
+ *            overflow  180 min, down 5..105 and 113..116: the queue
+ *                      recycles, only the recycled lines are missing, the
+ *                      backlog drains
+ *          uplink_filter_check.js covers the filter's per-device cases
+ *          (same seqs from two devices, seq restart, server restart).
+ *          Skipped (exit 0) when node is not installed.
+ */
+
+#include "emu_test.h"
+#include "flash_log.h"
+#include "uplink_queue.h"
+
+#include <sys/wait.h>
+
+#define LATENCY_MS      150
+#define MS              (nor_now_us / 1000u)
+
+typedef struct {
+    uint64_t at;
+    char s[32];
+    uint16_t n;
+} Ack;
+
+static MD25Q64_Handle h;
+static FlashLog qlog, clog;
+static Uplink up;
+static FILE *to_srv, *from_srv;
+static double sched[6];                 /* Minutes: up, down, up, down, up, end */
+static Ack acks[4096];
+static unsigned nacks, ack_head;
+static long sent, dropped;
+
+static int link_up(uint64_t ms)
+{
+    double m = ms / 60000.0;
+    int i = 0;
+
+    while (m >= sched[i + 1]) {
+        i++;
+    }
+    return (i % 2) == 0;
+}
+
+/* ============================================================================
+ * Port
+ * ============================================================================ */
+static uint8_t port_send(void *ctx, const uint8_t *data, uint16_t len)
+{
+    char line[300], rep[64];
+    uint64_t at;
+    Ack *a;
+
+    (void)ctx;
+    sent++;
+    nor_now_us += (uint64_t)len * 87u;          /* Half the 115200 baud line time */
+    if (!link_up(MS) || !link_up(MS + LATENCY_MS)) {
+        dropped++;
+        return 1;                               /* The module took it */
+    }
+    memcpy(line, data, len);
+    line[len] = '\0';
+    line[strcspn(line, "\r\n")] = '\0';
+    fprintf(to_srv, "%s\n", line);
+    fflush(to_srv);
+    if (fgets(rep, sizeof(rep), from_srv) == NULL) {
+        printf("server gone\n");
+        exit(2);
+    }
+    CHECK(rep[0] != '-');
+    at = MS + 2u * LATENCY_MS;
+    if (rep[0] == '-' || rand() % 100 == 0 || !link_up(at)) {
+        return 1;                               /* ACK lost */
+    }
+    a = &acks[nacks++ % 4096u];
+    a->at = at;
+    rep[strcspn(rep, "\n")] = '\0';
+    a->n = (uint16_t)snprintf(a->s, sizeof(a->s), "%s\r\n", rep);
+    return 1;
+}
+
+static uint32_t port_now(void)
+{
+    return (uint32_t)MS;
+}
+
+static const Uplink_Port port = {port_send, port_now, NULL};
+
+/* ============================================================================
+ * Device
+ * ============================================================================ */
+static void boot(void)
+{
+    uint64_t t0;
+
+    shim_reset();
+    nor_power_cycle();
+    CHECK(emu_init(&h, 0) == MD25Q64_OK);
+    t0 = nor_now_us;
+    CHECK(FlashLog_Mount(&clog, &h, 0x030000, 16) == FLASHLOG_OK);
+    CHECK(FlashLog_Mount(&qlog, &h, 0x040000, 192) == FLASHLOG_OK);
+    CHECK(Uplink_Init(&up, &qlog, &clog, &port) == UPLINK_OK);
+    printf("  %6.1f min boot: next %lu acked %lu backlog %lu, mount + scan %.1f ms\n",
+           MS / 60000.0, (unsigned long)up.next_seq, (unsigned long)up.acked,
+           (unsigned long)Uplink_Backlog(&up), (nor_now_us - t0) / 1000.0);
+}
+
+static void deliver_acks(void)
+{
+    while (ack_head < nacks && acks[ack_head % 4096u].at <= MS) {
+        Ack *a = &acks[ack_head++ % 4096u];
+        Uplink_Input(&up, (const uint8_t *)a->s, a->n);
+    }
+}
+
+/* One run; the server's summary in sum[] */
+static uint32_t scenario(const double *minutes, double reset_at, long sum[6])
+{
+    int to[2], from[2], was_up = 1, reset_done = 0;
+    uint64_t end = (uint64_t)(minutes[5] * 60000.0), next_line = 0, next_poll = 0, drain = 0;
+    uint32_t written = 0;
+    char t[64], line[128];
+    pid_t pid;
+    int i, n;
+
+    memcpy(sched, minutes, sizeof(sched));
+    sched[5] = 1e9;
+    if (pipe(to) != 0 || pipe(from) != 0) {
+        exit(2);
+    }
+    pid = fork();
+    if (pid == 0) {
+        dup2(to[0], 0);
+        dup2(from[1], 1);
+        close(to[1]);
+        close(from[0]);
+        execlp("node", "node", "../uplink_server.js", (char *)NULL);
+        _exit(127);
+    }
+    close(to[0]);
+    close(from[1]);
+    to_srv = fdopen(to[1], "w");
+    from_srv = fdopen(from[0], "r");
+
+    memset(nor_mem(), 0xFF, NOR_SIZE);
+    nor_now_us = 0;
+    nacks = ack_head = 0;
+    sent = dropped = 0;
+    boot();
+    while (MS < end) {
+        uint64_t now = MS;
+        int u = link_up(now);
+
+        if (!reset_done && now >= reset_at * 60000.0) {
+            reset_done = 1;
+            boot();
+        }
+        if (now >= next_line) {
+            n = snprintf(t, sizeof(t), "L%lu payload %lu\r\n", (unsigned long)up.next_seq,
+                         (unsigned long)((up.next_seq * 7919u) % 1000u));
+            CHECK(Uplink_Write(&up, 836000000u + (uint32_t)(now / 1000u), t, (uint16_t)n) == UPLINK_OK);
+            written++;
+            next_line = now + 250u;
+        }
+        deliver_acks();
+        if (now >= next_poll) {
+            Uplink_Poll(&up);
+            next_poll = now + 10u;
+        }
+        MD25Q64_Poll(&h);
+        if (u && !was_up) {
+            printf("  %6.1f min link up, backlog %lu\n", now / 60000.0,
+                   (unsigned long)Uplink_Backlog(&up));
+            drain = now;
+        }
+        if (u && drain && Uplink_Backlog(&up) <= 2u) {
+            printf("  %6.1f min backlog drained in %.1f s\n", now / 60000.0, (now - drain) / 1000.0);
+            drain = 0;
+        }
+        was_up = u;
+        if (MS == now) {
+            nor_now_us += 1000u - nor_now_us % 1000u;   /* 1 ms tick */
+        }
+    }
+    /* The last ACKs land */
+    for (i = 0; i < 5000; i++) {
+        deliver_acks();
+        if (i % 10 == 0) {
+            Uplink_Poll(&up);
+        }
+        MD25Q64_Poll(&h);
+        nor_now_us += 1000u;
+    }
+
+    fclose(to_srv);
+    if (fgets(line, sizeof(line), from_srv) == NULL ||
+        sscanf(line, "SUMMARY %ld %ld %ld %ld %ld %ld", &sum[0], &sum[1], &sum[2], &sum[3],
+               &sum[4], &sum[5]) != 6) {
+        printf("FAIL no server summary\n");
+        emu_fails++;
+    }
+    fclose(from_srv);
+    waitpid(pid, NULL, 0);
+    printf("  device: %lu lines, backlog %lu, %ld sent (%ld into a dead link), %lu replayed, %lu lost\n",
+           (unsigned long)written, (unsigned long)Uplink_Backlog(&up), sent, dropped,
+           (unsigned long)up.stats.replayed, (unsigned long)up.stats.lost);
+    printf("  server: %ld unique (%ld live, %ld replayed), %ld duplicates dropped, %ld missing\n",
+           sum[0], sum[1], sum[2], sum[3], sum[5]);
+    CHECK(sum[4] == 0);                             /* Payloads intact */
+    CHECK(Uplink_Backlog(&up) == 0);
+    return written;
+}
+
+int main(int argc, char **argv)
+{
+    static const double reset[6] = {0, 5, 12, 20, 23, 40};
+    static const double overflow[6] = {0, 5, 105, 113, 116, 180};
+    long sum[6];
+    uint32_t written;
+
+    if (system("node --version > /dev/null 2>&1") != 0) {
+        printf("SKIP: node not found\n");
+        return 0;
+    }
+    emu_open("test_uplink", argc, argv);
+
+    printf("server repeat filter:\n");
+    fflush(stdout);
+    CHECK(system("node ../uplink_filter_check.js") == 0);
+
+    printf("reset during an outage:\n");
+    written = scenario(reset, 8.0, sum);
+    CHECK(sum[0] == (long)written && sum[5] == 0);
+    CHECK(up.stats.lost == 0);
+
+    printf("outage longer than the queue:\n");
+    written = scenario(overflow, 8.0, sum);
+    CHECK(up.stats.lost > 0 && sum[5] == (long)up.stats.lost);
+    CHECK(sum[0] + sum[5] == (long)written);
+    return emu_finish();
+}
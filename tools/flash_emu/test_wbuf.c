@@ -0,0 +1,206 @@
+/**
+ * @file    test_wbuf.c
+ * @brief   MD25Q64_WBuf: AND semantics, read overlay, write-out on page
+ *          change / full page / timeout, a direct vs buffered FlashLog
+ *          append benchmark, and power cuts with the buffer attached
+ */
+
+#include "emu_test.h"
+#include "flash_log.h"
+
+#include <setjmp.h>
+
+#define LOG_BASE        0x400000u
+#define LOG_SECTORS     16u
+
+static MD25Q64_Handle h;
+static MD25Q64_WBuf wb;
+static FlashLog lg;
+static uint32_t next_id, flushed;   /* Live across the longjmp of a cut */
+
+static void buffer_cases(void)
+{
+    uint8_t a[300], r[300];
+    long p0;
+    int i;
+
+    for (i = 0; i < (int)sizeof(a); i++) a[i] = (uint8_t)rand();
+    CHECK(emu_init(&h, 0) == MD25Q64_OK);
+    CHECK(MD25Q64_EraseSector(&h, 0x10000) == MD25Q64_OK);
+    CHECK(MD25Q64_WBuf_Init(&wb, &h, 100) == MD25Q64_OK);
+
+    /* Small writes stay in RAM and read back through the overlay */
+    p0 = nor_stats.programs;
+    CHECK(MD25Q64_WBuf_Write(&wb, 0x10010, a, 20) == MD25Q64_OK);
+    CHECK(MD25Q64_WBuf_Write(&wb, 0x10030, a + 20, 20) == MD25Q64_OK);
+    CHECK(nor_stats.programs == p0);
+    CHECK(MD25Q64_WBuf_Read(&wb, 0x10010, r, 20) == MD25Q64_OK && memcmp(r, a, 20) == 0);
+    CHECK(nor_mem()[0x10010] == 0xFF);
+
+    /* Writes AND into the buffer like a program over data */
+    {
+        uint8_t x = 0x0F, y = 0xF3;
+        CHECK(MD25Q64_WBuf_Write(&wb, 0x10050, &x, 1) == MD25Q64_OK);
+        CHECK(MD25Q64_WBuf_Write(&wb, 0x10050, &y, 1) == MD25Q64_OK);
+        CHECK(MD25Q64_WBuf_Read(&wb, 0x10050, r, 1) == MD25Q64_OK && r[0] == (0x0F & 0xF3));
+    }
+
+    /* Moving to another page writes the held one out in one program */
+    CHECK(MD25Q64_WBuf_Write(&wb, 0x10100, a, 10) == MD25Q64_OK);
+    CHECK(nor_stats.programs == p0 + 1);
+    CHECK(memcmp(nor_mem() + 0x10010, a, 20) == 0 && memcmp(nor_mem() + 0x10030, a + 20, 20) == 0);
+
+    /* Filling the last byte of the page writes it out at once */
+    CHECK(MD25Q64_WBuf_Write(&wb, 0x1010A, a, 246) == MD25Q64_OK);
+    CHECK(nor_stats.programs == p0 + 2 && wb.page == MD25Q64_WBUF_NONE);
+
+    /* A write across pages, then the timeout */
+    CHECK(MD25Q64_WBuf_Write(&wb, 0x102F0, a, 40) == MD25Q64_OK);
+    CHECK(MD25Q64_WBuf_Read(&wb, 0x102F0, r, 40) == MD25Q64_OK && memcmp(r, a, 40) == 0);
+    CHECK(MD25Q64_WBuf_Poll(&wb) == MD25Q64_OK && wb.page != MD25Q64_WBUF_NONE);
+    nor_now_us += 150000;
+    CHECK(MD25Q64_WBuf_Poll(&wb) == MD25Q64_OK && wb.page == MD25Q64_WBUF_NONE);
+    CHECK(memcmp(nor_mem() + 0x102F0, a, 40) == 0);
+}
+
+/* 4000 48-byte records through FlashLog_Append, scheduler polls between */
+static void bench(int use_wb)
+{
+    const uint32_t base = 0x500000;
+    const int n = 4000;
+    uint8_t rec[48];
+    uint32_t a;
+    long p0;
+    uint64_t t0;
+    int i;
+
+    CHECK(emu_init(&h, 0) == MD25Q64_OK);
+    for (a = base; a < base + 32u * 4096u; a += 65536u) {
+        CHECK(MD25Q64_EraseBlock64K(&h, a) == MD25Q64_OK);
+    }
+    CHECK(FlashLog_Mount(&lg, &h, base, 32) == FLASHLOG_OK);
+    if (use_wb) {
+        CHECK(MD25Q64_WBuf_Init(&wb, &h, 0) == MD25Q64_OK);
+        CHECK(FlashLog_SetWriteBuffer(&lg, &wb) == FLASHLOG_OK);
+    }
+    p0 = nor_stats.programs;
+    t0 = nor_now_us;
+    for (i = 0; i < n; i++) {
+        memset(rec, i, sizeof(rec));
+        CHECK(FlashLog_Append(&lg, rec, sizeof(rec)) == FLASHLOG_OK);
+        FlashLog_Maintain(&lg);
+        MD25Q64_Poll(&h);
+    }
+    if (use_wb) {
+        MD25Q64_WBuf_Flush(&wb);
+    }
+    emu_drain(&h, 10);
+    printf("bench %-6s %d x 48 B: %.0f records/s, %.2f page programs per record\n",
+           use_wb ? "wbuf" : "direct", n, n / ((nor_now_us - t0) / 1e6),
+           (double)(nor_stats.programs - p0) / n);
+}
+
+static int verify(uint32_t *last)
+{
+    FlashLog_Iter it;
+    uint8_t buf[300];
+    uint16_t len, i;
+    uint32_t id, prev = 0;
+    int n = 0;
+
+    FlashLog_IterInit(&lg, &it);
+    while (FlashLog_IterNext(&it, buf, sizeof(buf), &len) == FLASHLOG_OK) {
+        memcpy(&id, buf, 4);
+        for (i = 4; i < len; i++) {
+            if (buf[i] != (uint8_t)(id * 7u + i)) return -1;
+        }
+        if (n > 0 && id != prev + 1) {
+            printf("gap %u -> %u\n", prev, id);
+            return -1;
+        }
+        prev = id;
+        n++;
+    }
+    *last = (n > 0) ? prev : 0xFFFFFFFFu;
+    return n;
+}
+
+static FlashLog_Status mount(void)
+{
+    FlashLog_Status st;
+
+    CHECK(emu_init(&h, 0) == MD25Q64_OK);
+    st = FlashLog_Mount(&lg, &h, LOG_BASE, LOG_SECTORS);
+    MD25Q64_WBuf_Init(&wb, &h, 0);
+    return (st == FLASHLOG_OK) ? FlashLog_SetWriteBuffer(&lg, &wb) : st;
+}
+
+/* Every record that was flushed (or written out with a full page) before
+ * the cut must survive; buffered ones may be lost, but never leave a gap */
+static int power_cuts(int rounds)
+{
+    static jmp_buf env;
+    static int r;
+    static uint32_t last;
+    uint8_t rec[256];
+    uint16_t len, i;
+    int n;
+
+    CHECK(MD25Q64_EraseBlock64K(&h, LOG_BASE) == MD25Q64_OK);
+    CHECK(mount() == FLASHLOG_OK);
+    next_id = 0;
+    flushed = 0xFFFFFFFFu;
+    for (r = 0; r < rounds; r++) {
+        nor_arm_cut(1 + rand() % 20000, &env);
+        if (setjmp(env) == 0) {
+            for (;;) {
+                len = (uint16_t)(4 + rand() % 200);
+                memcpy(rec, &next_id, 4);
+                for (i = 4; i < len; i++) rec[i] = (uint8_t)(next_id * 7u + i);
+                if (FlashLog_Append(&lg, rec, len) != FLASHLOG_OK) {
+                    printf("round %d: append failed\n", r);
+                    return r;
+                }
+                if (wb.page == MD25Q64_WBUF_NONE) flushed = next_id;
+                next_id++;
+                if (rand() % 16 == 0) {
+                    MD25Q64_WBuf_Flush(&wb);
+                    flushed = next_id - 1;
+                }
+                if (rand() % 8 == 0) FlashLog_Maintain(&lg);
+                nor_now_us += (uint64_t)(rand() % 2000);
+                MD25Q64_Poll(&h);
+            }
+        }
+        nor_disarm_cut();
+        shim_reset();
+        nor_now_us += 100000;
+        if (mount() != FLASHLOG_OK) {
+            printf("round %d: remount failed\n", r);
+            return r;
+        }
+        n = verify(&last);
+        if (n < 0 || (flushed != 0xFFFFFFFFu && (n == 0 || last < flushed)) ||
+            (n > 0 && last > next_id)) {
+            printf("round %d: %d records, last %u, flushed %u\n", r, n, last, flushed);
+            return r;
+        }
+        next_id = (n > 0) ? last + 1 : 0;
+        flushed = (n > 0) ? last : 0xFFFFFFFFu;
+    }
+    return r;
+}
+
+int main(int argc, char **argv)
+{
+    int rounds;
+
+    emu_open("test_wbuf", argc, argv);
+    buffer_cases();
+    bench(0);
+    bench(1);
+    rounds = power_cuts(1500);
+    CHECK(rounds == 1500);
+    printf("power cuts with wbuf: %d rounds, %u records\n", rounds, next_id);
+    return emu_finish();
+}
@@ -0,0 +1,66 @@
+/**
+ * Checks the server's per-device repeat filter (上云/server/uplink.js) on
+ * the cases one stream in test_uplink does not reach: two devices with the
+ * same seqs, a device whose seq restarts, a large backward jump, and the
+ * state surviving a server restart.
+ *   node uplink_filter_check.js      exit 0 when every case holds
+ */
+
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { parseLine, SeqFilters } = require(path.join(__dirname, '../../上云/server/uplink.js'));
+
+let failed = 0;
+
+function check(ok, what) {
+    if (!ok) {
+        console.log('FAILED:', what);
+        failed++;
+    }
+}
+
+// "#<seq>,<timestamp>[,R] x" for SeqFilters.accept
+function line(seq, ts, replay) {
+    return parseLine(`#${seq},${ts}${replay ? ',R' : ''} x`);
+}
+
+const file = path.join(os.tmpdir(), `uplink_filter_check_${process.pid}.json`);
+let f = new SeqFilters(file, 100);
+
+// Two devices sending the same seqs are both delivered
+for (let seq = 0; seq < 50; seq++) {
+    check(f.accept('a', line(seq, 1000 + seq)), `device a seq ${seq}`);
+    check(f.accept('b', line(seq, 5000 + seq)), `device b seq ${seq}`);
+}
+// A replay of a line already received is a repeat
+check(!f.accept('a', line(10, 1010, true)), 'replay of a received line dropped');
+check(f.filters.get('a').duplicates === 1, 'one duplicate counted');
+
+// Queue reformatted: live seq 0 again, later time -> new lines
+check(f.accept('b', line(0, 6000)), 'live seq restart accepted');
+check(f.accept('b', line(1, 6001)), 'line after a restart accepted');
+check(f.filters.get('b').resets === 1, 'restart counted');
+// Restart first seen as a replay: older seq but later device time
+check(f.accept('a', line(3, 2000, true)), 'replayed restart accepted');
+check(!f.accept('a', line(3, 2000, true)), 'repeat after a restart dropped');
+
+// Large backward jump (more than limit) with an old time is a reset too
+for (let seq = 100; seq < 400; seq++) {
+    f.accept('c', line(seq, 100 + seq));
+}
+check(f.accept('c', line(150, 250, true)), 'jump of more than limit accepted');
+check(f.filters.get('c').resets === 1, 'jump counted as a reset');
+
+// State survives a restart of the server
+f.accept('d', line(7, 70));
+f.accept('d', line(9, 90));
+f.save();
+f = new SeqFilters(file, 100);
+check(!f.accept('d', line(7, 70, true)), 'repeat after a server restart dropped');
+check(f.accept('d', line(8, 80, true)), 'missing line after a server restart accepted');
+check(!f.accept('b', line(1, 6001, true)), 'second device state restored');
+fs.unlinkSync(file);
+
+console.log(failed ? 'FAILED' : 'ALL OK');
+process.exit(failed ? 1 : 0);
@@ -0,0 +1,45 @@
+/**
+ * Stand-in server for test_uplink: one reply line per input line, using the
+ * server's own parser and repeat filter (上云/server/uplink.js).
+ *   stdin   lines from the device, as the 4G module forwards them
+ *   stdout  "ACK:<seq>", or "-" for a line that does not parse; on EOF a
+ *           summary: "SUMMARY <unique> <live> <replayed> <duplicates>
+ *           <bad payloads> <missing seqs>"
+ */
+
+const path = require('path');
+const readline = require('readline');
+const { parseLine, SeqFilter } = require(path.join(__dirname, '../../上云/server/uplink.js'));
+
+const filter = new SeqFilter();
+let live = 0;
+let replay = 0;
+let bad = 0;
+
+const rl = readline.createInterface({ input: process.stdin });
+
+rl.on('line', (line) => {
+    const m = parseLine(line);
+    if (!m) {
+        process.stdout.write('-\n');
+        return;
+    }
+    if (filter.accept(m)) {
+        // test_uplink writes "L<seq> payload <seq * 7919 % 1000>"
+        if (m.content !== `L${m.seq} payload ${(m.seq * 7919) % 1000}`) {
+            bad++;
+        }
+        if (m.replay) {
+            replay++;
+        } else {
+            live++;
+        }
+    }
+    process.stdout.write(`ACK:${m.seq}\n`);
+});
+
+rl.on('close', () => {
+    const seqs = [...filter.seen].sort((a, b) => a - b);
+    const missing = seqs.length ? seqs[seqs.length - 1] - seqs[0] + 1 - seqs.length : 0;
+    process.stdout.write(`SUMMARY ${seqs.length} ${live} ${replay} ${filter.duplicates} ${bad} ${missing}\n`);
+});
@@ -0,0 +1,836 @@
+/**
+ * @file    oled_sim.cpp
+ * @brief   Host renderer and golden-image runner for the SSD1309 display path
+ * @details Builds the firmware's ssd1309 driver (oled.c, oled_text.c) for the
+ *          host against a simulated I2C1: blocking writes and TX DMA with
+ *          its completion interrupt, so OLED_Init(), OLED_Write_cmd() and
+ *          OLED_Flush() run unchanged. Every I2C write to OLED_ADDR is fed
+ *          byte by byte to an SSD1309 model: control bytes (Co, D/C#), the
+ *          command set with its arguments, page / horizontal / vertical
+ *          addressing and the GDDRAM. The image is rebuilt from the RAM with
+ *          the panel settings the stream left: segment remap (A0/A1), COM
+ *          scan direction (C0/C8), start line, display offset, multiplex
+ *          ratio, invert, entire display on and display off. It is shown as
+ *          the module is mounted for initcmd1's A1/C8 (RAM column 0, row 0
+ *          top left); A0 mirrors it, C0 turns it upside down. Scrolling
+ *          commands are parsed but not animated. The RAM starts out with
+ *          noise, as after power-up, so anything the driver fails to send
+ *          shows.
+ *
+ *          Scenes are display pages drawn through the driver API. Each
+ *          starts with OLED_Init() on a freshly powered panel, counted as
+ *          step 0; every further step draws, calls OLED_Flush() and lets the
+ *          DMA chain run out, and is counted as one frame: I2C writes and
+ *          payload bytes seen on the bus, commands included. DMA frames are
+ *          checked against OLED_GetStats().
+ *
+ *          Goldens are P1 PBM files, 1 = lit pixel, one per scene, with the
+ *          per-step counts in comment lines; they are committed in golden/
+ *          and the counts in them are the budgets. --check fails a scene
+ *          when its golden is missing, a pixel differs or a step needs more
+ *          writes or bytes than its golden, and writes NAME.actual.pbm to
+ *          the current directory. Fewer is reported, so a golden can be
+ *          refreshed on purpose. --update only rewrites goldens that exist;
+ *          a new scene gets one when it is named on the command line.
+ *
+ *          Build:  cd tools/oled_sim && make check    (runs --check ../golden)
+ *          Use:    build/oled_sim --list
+ *                  build/oled_sim status               (ASCII preview and counts)
+ *                  build/oled_sim status --png status.png --scale 4
+ *                  build/oled_sim --update golden      (then review the diff)
+ *                  build/oled_sim --update golden NEWSCENE
+ *                  build/oled_sim --check golden
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "oled.h"
+#include "oled_text.h"
+}
+
+namespace {
+
+/* ============================================================================
+ * SSD1309 model
+ * ============================================================================ */
+constexpr int kWidth = 128;
+constexpr int kHeight = 64;
+constexpr int kPages = kHeight / 8;
+constexpr uint8_t kAddr = OLED_ADDR;
+
+struct Panel {
+    uint8_t ram[kPages][kWidth];
+    int col, page;                  // RAM pointer
+    int mode;                       // 0 horizontal, 1 vertical, 2 page
+    int col_lo, col_hi, page_lo, page_hi;
+    bool seg_remap, com_remap, invert, entire_on, on;
+    int start_line, offset, mux, contrast;
+    uint8_t cmd;                    // Command collecting arguments
+    int need;                       // ...still to come
+    uint8_t args[6];
+    int got;
+    unsigned unknown;               // Bytes not in the command set
+
+    // Power-on reset (datasheet defaults), RAM filled with noise
+    void reset(uint32_t seed)
+    {
+        std::memset(this, 0, sizeof(*this));
+        for (int p = 0; p < kPages; p++) {
+            for (int x = 0; x < kWidth; x++) {
+                seed = seed * 1103515245u + 12345u;
+                ram[p][x] = static_cast<uint8_t>(seed >> 16);
+            }
+        }
+        mode = 2;
+        col_hi = kWidth - 1;
+        page_hi = kPages - 1;
+        mux = kHeight - 1;
+        contrast = 0x7F;
+    }
+
+    static int arg_count(uint8_t c)
+    {
+        switch (c) {
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5:
+        case 0xD9: case 0xDA: case 0xDB: case 0xFD:
+            return 1;
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x26: case 0x27:
+            return 6;
+        default:
+            return 0;
+        }
+    }
+
+    void run(uint8_t c, const uint8_t *a)
+    {
+        if (c <= 0x0F) {
+            col = (col & 0xF0) | c;
+        } else if (c <= 0x1F) {
+            col = (col & 0x0F) | ((c & 0x0F) << 4);
+        } else if (c >= 0x40 && c <= 0x7F) {
+            start_line = c & 0x3F;
+        } else if (c >= 0xB0 && c <= 0xB7) {
+            page = c & 0x07;
+        } else {
+            switch (c) {
+            case 0x20: mode = a[0] & 0x03; break;
+            case 0x21: col_lo = col = a[0] & 0x7F; col_hi = a[1] & 0x7F; break;
+            case 0x22: page_lo = page = a[0] & 0x07; page_hi = a[1] & 0x07; break;
+            case 0x81: contrast = a[0]; break;
+            case 0xA0: case 0xA1: seg_remap = c & 1; break;
+            case 0xA4: case 0xA5: entire_on = c & 1; break;
+            case 0xA6: case 0xA7: invert = c & 1; break;
+            case 0xA8: mux = a[0] & 0x3F; break;
+            case 0xAE: case 0xAF: on = c & 1; break;
+            case 0xC0: case 0xC8: com_remap = (c & 0x08) != 0; break;
+            case 0xD3: offset = a[0] & 0x3F; break;
+            case 0x8D: case 0xA3: case 0xD5: case 0xD9: case 0xDA: case 0xDB: case 0xFD:
+            case 0x26: case 0x27: case 0x29: case 0x2A: case 0x2E: case 0x2F: case 0xE3:
+                break;                  // Timing, electrical, lock, scrolling, NOP
+            default:
+                unknown++;
+                break;
+            }
+        }
+    }
+
+    void command(uint8_t b)
+    {
+        if (need > 0) {
+            args[got++] = b;
+            if (--need == 0) {
+                run(cmd, args);
+            }
+            return;
+        }
+        cmd = b;
+        got = 0;
+        need = arg_count(b);
+        if (need == 0) {
+            run(b, args);
+        }
+    }
+
+    void data(uint8_t b)
+    {
+        ram[page & 7][col & 0x7F] = b;
+        if (mode == 2) {                // Page: wrap within the page
+            col = (col + 1) & 0x7F;
+        } else if (mode == 0) {         // Horizontal: columns, then pages
+            if (++col > col_hi) {
+                col = col_lo;
+                page = (page >= page_hi) ? page_lo : page + 1;
+            }
+        } else if (mode == 1) {         // Vertical: pages, then columns
+            if (++page > page_hi) {
+                page = page_lo;
+                col = (col >= col_hi) ? col_lo : col + 1;
+            }
+        }
+    }
+
+    // One I2C write: control byte(s) and the bytes they announce
+    void transfer(const uint8_t *p, size_t n)
+    {
+        size_t i = 0;
+
+        while (i < n) {
+            uint8_t control = p[i++];
+            bool single = (control & 0x80) != 0;
+            bool is_data = (control & 0x40) != 0;
+            size_t end = single ? ((i + 1 < n) ? i + 1 : n) : n;
+
+            for (; i < end; i++) {
+                if (is_data) {
+                    data(p[i]);
+                } else {
+                    command(p[i]);
+                }
+            }
+        }
+    }
+
+    bool pixel(int x, int y) const
+    {
+        int col_ram = seg_remap ? x : kWidth - 1 - x;
+        int row = com_remap ? y : kHeight - 1 - y;
+
+        if (!on) {
+            return false;
+        }
+        row = (row - offset + kHeight) % kHeight;   // Row in scan order
+        if (row > mux) {
+            return false;
+        }
+        if (entire_on) {
+            return true;
+        }
+        row = (row + start_line) % kHeight;         // Row of RAM it shows
+        return (((ram[row >> 3][col_ram] >> (row & 7)) & 1) != 0) != invert;
+    }
+};
+
+/* ============================================================================
+ * Simulated I2C1 + TX DMA
+ * ============================================================================ */
+struct Bus {
+    Panel panel;
+    uint32_t ms;
+    uint32_t writes, bytes;         // Writes to the panel and their payload
+    uint32_t dma_writes;
+    uint32_t collisions;            // Writes started with a DMA transfer in flight
+    bool pending, in_irq;
+    std::vector<uint8_t> buf;       // Control byte + payload of the transfer
+};
+
+Bus bus;
+
+void bus_write(uint16_t addr, uint16_t control, const uint8_t *data, uint16_t len)
+{
+    if (addr != kAddr) {
+        return;                         // Nobody else on I2C1
+    }
+    bus.buf.assign(1, static_cast<uint8_t>(control));
+    bus.buf.insert(bus.buf.end(), data, data + len);
+    bus.panel.transfer(bus.buf.data(), bus.buf.size());
+    bus.writes++;
+    bus.bytes += len;
+}
+
+// Transfer in flight ends: its bytes reach the panel, then TX complete
+void bus_complete()
+{
+    while (bus.pending && !bus.in_irq) {
+        bus.in_irq = true;
+        bus.pending = false;
+        bus.panel.transfer(bus.buf.data(), bus.buf.size());
+        bus.writes++;
+        bus.bytes += static_cast<uint32_t>(bus.buf.size() - 1);
+        OLED_DMA_Complete();
+        bus.in_irq = false;
+    }
+}
+
+} // namespace
+
+/* ============================================================================
+ * HAL stand-ins (shim/main.h, shim/i2c.h)
+ * ============================================================================ */
+extern "C" {
+
+I2C_TypeDef sim_i2c1;
+I2C_HandleTypeDef hi2c1 = {&sim_i2c1};
+
+// The driver polls the tick while it waits for a frame: let the DMA run
+uint32_t HAL_GetTick(void)
+{
+    bus_complete();
+    return bus.ms;
+}
+
+void HAL_Delay(uint32_t ms)
+{
+    bus.ms += ms;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem,
+                                    uint16_t mem_size, uint8_t *data, uint16_t len, uint32_t timeout)
+{
+    (void)hi2c;
+    (void)mem_size;
+    (void)timeout;
+    if (bus.pending) {
+        bus.collisions++;
+        return HAL_BUSY;
+    }
+    bus_write(addr, mem, data, len);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem,
+                                        uint16_t mem_size, uint8_t *data, uint16_t len)
+{
+    (void)hi2c;
+    (void)mem_size;
+    if (bus.pending) {
+        bus.collisions++;
+        return HAL_BUSY;
+    }
+    if (addr != kAddr) {
+        return HAL_ERROR;
+    }
+    // Bytes are taken at completion, as the DMA reads them
+    bus.buf.assign(1, static_cast<uint8_t>(mem));
+    bus.buf.insert(bus.buf.end(), data, data + len);
+    bus.pending = true;
+    bus.dma_writes++;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c)
+{
+    (void)hi2c;
+    bus.pending = false;
+    return HAL_OK;
+}
+
+void MX_I2C1_Init(void)
+{
+}
+
+} // extern "C"
+
+namespace {
+
+/* ============================================================================
+ * Scenes
+ * ============================================================================ */
+struct Scene {
+    const char *name;
+    const char *about;
+    int steps;
+    void (*draw)(int step);
+};
+
+void scene_blank(int)
+{
+}
+
+// What oled_task() shows; the second step redraws it unchanged
+void scene_hello(int)
+{
+    OLED_Text(1, 8, "hello", &OLED_Font6x8);
+}
+
+void scene_status(int step)
+{
+    static const int32_t c2h4[] = {42, 57};
+    static const int32_t temp[] = {245, 251};
+    static const int32_t humid[] = {613, 613};
+
+    if (step == 0) {
+        OLED_Text(0, 0, "Fresh", &OLED_Font8x16);
+        OLED_TextBox(64, 4, 64, "12:00:00", &OLED_Font6x8, OLED_ALIGN_RIGHT);
+        OLED_DrawLine(0, 17, 127, 17, 1);
+        OLED_Text(0, 24, "C2H4", &OLED_Font6x8);
+        OLED_Text(0, 36, "Temp", &OLED_Font6x8);
+        OLED_Text(0, 48, "Humidity", &OLED_Font6x8);
+        OLED_Text(108, 24, "ppm", &OLED_Font6x8);
+        OLED_Text(108, 36, "C", &OLED_Font6x8);
+        OLED_Text(108, 48, "%", &OLED_Font6x8);
+    } else {
+        OLED_TextBox(64, 4, 64, "12:00:01", &OLED_Font6x8, OLED_ALIGN_RIGHT);
+    }
+    OLED_NumberBox(56, 24, 48, c2h4[step], 2, &OLED_Font6x8);
+    OLED_NumberBox(56, 36, 48, temp[step], 1, &OLED_Font6x8);
+    OLED_NumberBox(56, 48, 48, humid[step], 1, &OLED_Font6x8);
+}
+
+// The original page-addressed calls, through the framebuffer
+void scene_legacy(int)
+{
+    char str[] = "ShowStr 8";
+    char big[] = "Str16";
+
+    OLED_ShowStr(0, 0, str, 8);
+    OLED_ShowStr(0, 1, big, 16);
+    OLED_ShowNum(0, 3, 12345, 5, 8);
+    OLED_ShowFloat(0, 4, 3.14f, 2, 16);
+    OLED_ShowChar(120, 7, 'Z', 8);
+}
+
+void scene_shapes(int step)
+{
+    OLED_DrawRect(0, 0, 128, 64, 1);
+    OLED_DrawLine(0, 0, 127, 63, 1);
+    OLED_DrawLine(0, 63, 127, 0, 1);
+    OLED_FillRect(40, 20, 48, 24, 1);
+    OLED_FillRect(50, 27, 28, 10, 0);
+    if (step == 1) {
+        OLED_DrawPixel(64, 2, 1);           // One byte changes
+    }
+}
+
+void scene_clip(int)
+{
+    OLED_Clip box = {30, 20, 90, 30};
+
+    OLED_Text(-5, 0, "left edge", &OLED_Font8x16);
+    OLED_Text(100, 20, "right edge", &OLED_Font6x8);
+    OLED_Text(10, 59, "bottom", &OLED_Font6x8);
+    OLED_TextClip(20, 18, "clipped box", &OLED_Font8x16, &box);
+    OLED_DrawRect(29, 19, 62, 12, 1);
+    OLED_NumberBox(0, 48, 24, 123456, 0, &OLED_Font6x8);
+}
+
+// Commands between frames: invert, and the panel turned by 180 degrees
+void scene_invert(int)
+{
+    OLED_Text(0, 0, "inverted", &OLED_Font8x16);
+    OLED_Write_cmd(0xA7);
+}
+
+void scene_rotate(int)
+{
+    OLED_Text(0, 0, "A0 C0", &OLED_Font8x16);
+    OLED_Write_cmd(0xA0);
+    OLED_Write_cmd(0xC0);
+}
+
+const Scene kScenes[] = {
+    {"blank",  "OLED_Init() only",                      1, scene_blank},
+    {"hello",  "oled_task() text, redrawn unchanged",   2, scene_hello},
+    {"status", "sensor page, then one value update",    2, scene_status},
+    {"legacy", "OLED_Show* page-addressed calls",       1, scene_legacy},
+    {"shapes", "lines and rectangles, then one pixel",  2, scene_shapes},
+    {"clip",   "text clipped at edges and a box",       1, scene_clip},
+    {"invert", "0xA7 after a frame",                    1, scene_invert},
+    {"rotate", "0xA0 / 0xC0 after a frame",             1, scene_rotate},
+};
+
+/* ============================================================================
+ * Running a scene
+ * ============================================================================ */
+struct StepCount {
+    uint32_t writes;
+    uint32_t bytes;
+};
+
+struct Result {
+    std::vector<StepCount> steps;
+    std::vector<uint8_t> pixels;    // kWidth * kHeight, 1 = lit
+    std::string error;
+};
+
+StepCount bus_since(const StepCount &from)
+{
+    return {bus.writes - from.writes, bus.bytes - from.bytes};
+}
+
+Result run_scene(const Scene &scene)
+{
+    Result r;
+    StepCount before;
+    uint32_t dma_before;
+
+    bus = Bus();
+    bus.panel.reset(0x5EED0000u);
+    OLED_Init();                        // Step 0: initcmd1 and the blank frame
+    bus_complete();
+    r.steps.push_back(bus_since({0, 0}));
+    for (int s = 0; s < scene.steps; s++) {
+        before = {bus.writes, bus.bytes};
+        dma_before = bus.dma_writes;
+        scene.draw(s);
+        if (OLED_Flush() == OLED_FLUSH_STARTED) {
+            bus_complete();
+            const OLED_Stats *st = OLED_GetStats();
+            if (OLED_Busy()) {
+                r.error = "frame did not finish";
+            } else if (st->last_transactions != bus.dma_writes - dma_before) {
+                r.error = "OLED_GetStats() disagrees with the bus";
+            }
+        }
+        r.steps.push_back(bus_since(before));
+    }
+    if (bus.collisions != 0) {
+        r.error = "write started during a DMA transfer";
+    }
+    if (bus.panel.unknown != 0) {
+        r.error = "unknown SSD1309 command";
+    }
+    r.pixels.resize(kWidth * kHeight);
+    for (int y = 0; y < kHeight; y++) {
+        for (int x = 0; x < kWidth; x++) {
+            r.pixels[y * kWidth + x] = bus.panel.pixel(x, y) ? 1 : 0;
+        }
+    }
+    return r;
+}
+
+const Scene *find_scene(const std::string &name)
+{
+    for (const Scene &s : kScenes) {
+        if (name == s.name) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+std::string counts(const std::vector<StepCount> &steps)
+{
+    std::string out;
+    char buf[48];
+
+    for (size_t i = 0; i < steps.size(); i++) {
+        std::snprintf(buf, sizeof(buf), "%s%u/%u", i ? "  " : "", steps[i].writes, steps[i].bytes);
+        out += buf;
+    }
+    return out;
+}
+
+/* ============================================================================
+ * PBM / PNG
+ * ============================================================================ */
+bool write_pbm(const std::string &path, const Scene &scene, const Result &r)
+{
+    std::ofstream f(path);
+
+    if (!f) {
+        return false;
+    }
+    f << "P1\n# oled_sim " << scene.name << ": " << scene.about << "\n";
+    for (size_t i = 0; i < r.steps.size(); i++) {
+        f << "# step " << i << " writes " << r.steps[i].writes << " bytes " << r.steps[i].bytes << "\n";
+    }
+    f << kWidth << " " << kHeight << "\n";
+    for (int y = 0; y < kHeight; y++) {
+        for (int half = 0; half < 2; half++) {     // Lines under 70 characters
+            for (int x = half * 64; x < half * 64 + 64; x++) {
+                f << static_cast<char>('0' + r.pixels[y * kWidth + x]);
+            }
+            f << "\n";
+        }
+    }
+    return static_cast<bool>(f);
+}
+
+bool read_pbm(const std::string &path, std::vector<uint8_t> &pixels, std::vector<StepCount> &steps)
+{
+    std::ifstream f(path);
+    std::string line, text;
+    int w = 0, h = 0;
+
+    if (!std::getline(f, line) || line != "P1") {
+        return false;
+    }
+    while (std::getline(f, line)) {
+        unsigned step, writes, bytes;
+        if (std::sscanf(line.c_str(), "# step %u writes %u bytes %u", &step, &writes, &bytes) == 3) {
+            if (step == steps.size()) {
+                steps.push_back({writes, bytes});
+            }
+        } else if (!line.empty() && line[0] != '#') {
+            text += line + "\n";
+        }
+    }
+    std::istringstream in(text);
+    if (!(in >> w >> h) || w != kWidth || h != kHeight) {
+        return false;
+    }
+    pixels.clear();
+    char c;
+    while (in.get(c)) {
+        if (c == '0' || c == '1') {
+            pixels.push_back(static_cast<uint8_t>(c - '0'));
+        }
+    }
+    return pixels.size() == static_cast<size_t>(kWidth * kHeight);
+}
+
+uint32_t crc32(uint32_t crc, const uint8_t *p, size_t n)
+{
+    crc = ~crc;
+    while (n--) {
+        crc ^= *p++;
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+void put32be(std::vector<uint8_t> &v, uint32_t x)
+{
+    v.push_back(static_cast<uint8_t>(x >> 24));
+    v.push_back(static_cast<uint8_t>(x >> 16));
+    v.push_back(static_cast<uint8_t>(x >> 8));
+    v.push_back(static_cast<uint8_t>(x));
+}
+
+void png_chunk(std::vector<uint8_t> &out, const char *type, const std::vector<uint8_t> &data)
+{
+    std::vector<uint8_t> body(type, type + 4);
+
+    body.insert(body.end(), data.begin(), data.end());
+    put32be(out, static_cast<uint32_t>(data.size()));
+    out.insert(out.end(), body.begin(), body.end());
+    put32be(out, crc32(0, body.data(), body.size()));
+}
+
+// 8-bit grey, lit pixels white as on the panel; stored deflate blocks, no zlib
+bool write_png(const std::string &path, const std::vector<uint8_t> &pixels, int scale)
+{
+    const uint32_t w = kWidth * scale, h = kHeight * scale;
+    std::vector<uint8_t> raw, z, ihdr, out = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    uint32_t a = 1, b = 0;
+
+    for (uint32_t y = 0; y < h; y++) {
+        raw.push_back(0);                           // Filter: none
+        for (uint32_t x = 0; x < w; x++) {
+            raw.push_back(pixels[(y / scale) * kWidth + x / scale] ? 0xFF : 0x00);
+        }
+    }
+    z = {0x78, 0x01};
+    for (size_t i = 0; i < raw.size(); i += 65535) {
+        size_t n = (raw.size() - i < 65535) ? raw.size() - i : 65535;
+        z.push_back(i + n == raw.size() ? 1 : 0);
+        z.push_back(static_cast<uint8_t>(n));
+        z.push_back(static_cast<uint8_t>(n >> 8));
+        z.push_back(static_cast<uint8_t>(~n));
+        z.push_back(static_cast<uint8_t>(~n >> 8));
+        z.insert(z.end(), raw.begin() + i, raw.begin() + i + n);
+    }
+    for (uint8_t c : raw) {
+        a = (a + c) % 65521u;
+        b = (b + a) % 65521u;
+    }
+    put32be(z, (b << 16) | a);
+
+    put32be(ihdr, w);
+    put32be(ihdr, h);
+    ihdr.insert(ihdr.end(), {8, 0, 0, 0, 0});        // 8 bit, grey, no interlace
+    png_chunk(out, "IHDR", ihdr);
+    png_chunk(out, "IDAT", z);
+    png_chunk(out, "IEND", {});
+
+    FILE *f = std::fopen(path.c_str(), "wb");
+    if (f == nullptr) {
+        return false;
+    }
+    bool ok = std::fwrite(out.data(), 1, out.size(), f) == out.size();
+    return std::fclose(f) == 0 && ok;
+}
+
+void print_ascii(const std::vector<uint8_t> &pixels)
+{
+    for (int y = 0; y < kHeight; y++) {
+        for (int x = 0; x < kWidth; x++) {
+            std::putchar(pixels[y * kWidth + x] ? '#' : '.');
+        }
+        std::putchar('\n');
+    }
+}
+
+/* ============================================================================
+ * Golden runner
+ * ============================================================================ */
+// Rewrites the goldens that exist; a new one only for a scene named on the line
+int update(const std::string &dir, const std::vector<std::string> &names)
+{
+    int failed = 0;
+
+    for (const std::string &n : names) {
+        if (find_scene(n) == nullptr) {
+            std::fprintf(stderr, "oled_sim: no scene %s\n", n.c_str());
+            return 2;
+        }
+    }
+    for (const Scene &s : kScenes) {
+        std::string path = dir + "/" + s.name + ".pbm";
+        bool named = false;
+        for (const std::string &n : names) {
+            named = named || n == s.name;
+        }
+        if (!names.empty() && !named) {
+            continue;
+        }
+        if (names.empty() && !std::ifstream(path)) {
+            std::printf("%-8s no golden at %s, not created (name the scene to add it)\n", s.name,
+                        path.c_str());
+            failed++;
+            continue;
+        }
+        Result r = run_scene(s);
+        if (!r.error.empty()) {
+            std::printf("%-8s %s, not written\n", s.name, r.error.c_str());
+            failed++;
+        } else if (!write_pbm(path, s, r)) {
+            std::fprintf(stderr, "oled_sim: cannot write %s\n", path.c_str());
+            failed++;
+        } else {
+            std::printf("%-8s writes/bytes per step %s -> %s\n", s.name, counts(r.steps).c_str(),
+                        path.c_str());
+        }
+    }
+    return failed ? 1 : 0;
+}
+
+int check(const std::string &dir)
+{
+    int failed = 0;
+
+    std::printf("%-8s %-28s %-28s %s\n", "scene", "writes/bytes per step", "golden", "result");
+    for (const Scene &s : kScenes) {
+        Result r = run_scene(s);
+        std::vector<uint8_t> golden;
+        std::vector<StepCount> budget;
+        std::string verdict = "ok";
+        bool fail = false;
+
+        if (!r.error.empty()) {
+            verdict = r.error;
+            fail = true;
+        } else if (!read_pbm(dir + "/" + s.name + ".pbm", golden, budget)) {
+            verdict = "no golden";
+            fail = true;
+        } else {
+            int diff = 0;
+            for (size_t i = 0; i < golden.size(); i++) {
+                diff += golden[i] != r.pixels[i];
+            }
+            if (diff != 0) {
+                verdict = std::to_string(diff) + " pixels differ";
+                fail = true;
+            } else if (budget.size() != r.steps.size()) {
+                verdict = "step count changed";
+                fail = true;
+            } else {
+                for (size_t i = 0; i < budget.size(); i++) {
+                    if (r.steps[i].writes > budget[i].writes || r.steps[i].bytes > budget[i].bytes) {
+                        verdict = "step " + std::to_string(i) + " over budget";
+                        fail = true;
+                    } else if (!fail && (r.steps[i].writes < budget[i].writes ||
+                                         r.steps[i].bytes < budget[i].bytes)) {
+                        verdict = "ok, under budget (--update to keep)";
+                    }
+                }
+            }
+        }
+        if (fail) {
+            write_pbm(std::string(s.name) + ".actual.pbm", s, r);
+            failed++;
+        }
+        std::printf("%-8s %-28s %-28s %s\n", s.name, counts(r.steps).c_str(), counts(budget).c_str(),
+                    verdict.c_str());
+    }
+    std::printf("%d of %zu scenes failed\n", failed, sizeof(kScenes) / sizeof(kScenes[0]));
+    return failed ? 1 : 0;
+}
+
+void usage()
+{
+    std::fprintf(stderr,
+        "usage: oled_sim --list\n"
+        "       oled_sim SCENE [--pbm FILE] [--png FILE] [--scale N] [--quiet]\n"
+        "       oled_sim --update DIR [SCENE...] | --check DIR\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::string scene_name, pbm_path, png_path;
+    int scale = 1;
+    bool quiet = false;
+
+    if (argc == 2 && std::string(argv[1]) == "--list") {
+        for (const Scene &s : kScenes) {
+            std::printf("%-8s %d step%s  %s\n", s.name, s.steps, s.steps > 1 ? "s" : " ", s.about);
+        }
+        return 0;
+    }
+    if (argc >= 3 && std::string(argv[1]) == "--update") {
+        return update(argv[2], std::vector<std::string>(argv + 3, argv + argc));
+    }
+    if (argc == 3 && std::string(argv[1]) == "--check") {
+        return check(argv[2]);
+    }
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        if (a == "--pbm" && i + 1 < argc) {
+            pbm_path = argv[++i];
+        } else if (a == "--png" && i + 1 < argc) {
+            png_path = argv[++i];
+        } else if (a == "--scale" && i + 1 < argc) {
+            scale = std::atoi(argv[++i]);
+        } else if (a == "--quiet") {
+            quiet = true;
+        } else if (a[0] != '-' && scene_name.empty()) {
+            scene_name = a;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    const Scene *scene = find_scene(scene_name);
+    if (scene == nullptr || scale < 1 || scale > 16) {
+        usage();
+        return 2;
+    }
+
+    Result r = run_scene(*scene);
+    if (!quiet) {
+        print_ascii(r.pixels);
+    }
+    for (size_t i = 0; i < r.steps.size(); i++) {
+        std::printf("step %zu: %u I2C writes, %u bytes%s\n", i, r.steps[i].writes, r.steps[i].bytes,
+                    i == 0 ? " (OLED_Init)" : "");
+    }
+    if (!pbm_path.empty() && !write_pbm(pbm_path, *scene, r)) {
+        std::fprintf(stderr, "oled_sim: cannot write %s\n", pbm_path.c_str());
+        return 1;
+    }
+    if (!png_path.empty() && !write_png(png_path, r.pixels, scale)) {
+        std::fprintf(stderr, "oled_sim: cannot write %s\n", png_path.c_str());
+        return 1;
+    }
+    if (!r.error.empty()) {
+        std::fprintf(stderr, "oled_sim: %s\n", r.error.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file    oled_test.h
+ * @brief   Shared helpers for the ssd1309 driver host tests
+ * @details Each test is one program: CHECK() counts failures, the seed
+ *          comes from argv[1] (default 1), and the exit status is 0 only
+ *          if nothing failed.
+ */
+
+#ifndef __OLED_TEST_H__
+#define __OLED_TEST_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int test_fails;
+
+#define CHECK(c) do { \
+        if (!(c)) { \
+            printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #c); \
+            test_fails++; \
+        } \
+    } while (0)
+
+static inline void test_seed(int argc, char **argv)
+{
+    srand(argc > 1 ? (unsigned)atoi(argv[1]) : 1u);
+}
+
+static inline int test_finish(void)
+{
+    printf("%s\n", test_fails ? "FAILED" : "ALL OK");
+    return test_fails != 0;
+}
+
+#endif /* __OLED_TEST_H__ */
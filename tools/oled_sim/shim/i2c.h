@@ -0,0 +1,23 @@
+/**
+ * @file    i2c.h
+ * @brief   Host stand-in for the CubeMX i2c.h (tools/oled_sim)
+ */
+
+#ifndef __I2C_H__
+#define __I2C_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+extern I2C_HandleTypeDef hi2c1;
+
+void MX_I2C1_Init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __I2C_H__ */
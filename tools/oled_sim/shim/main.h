@@ -0,0 +1,50 @@
+/**
+ * @file    main.h
+ * @brief   Host stand-in for the firmware's main.h, just what the ssd1309
+ *          driver uses (tools/oled_sim)
+ */
+
+#ifndef __MAIN_H
+#define __MAIN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    HAL_OK = 0,
+    HAL_ERROR,
+    HAL_BUSY,
+    HAL_TIMEOUT
+} HAL_StatusTypeDef;
+
+typedef struct {
+    uint32_t unused;
+} I2C_TypeDef;
+
+typedef struct {
+    I2C_TypeDef *Instance;
+} I2C_HandleTypeDef;
+
+extern I2C_TypeDef sim_i2c1;
+#define I2C1                    (&sim_i2c1)
+#define I2C_MEMADD_SIZE_8BIT    1u
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t ms);
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem,
+                                    uint16_t mem_size, uint8_t *data, uint16_t len, uint32_t timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem,
+                                        uint16_t mem_size, uint8_t *data, uint16_t len);
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MAIN_H */
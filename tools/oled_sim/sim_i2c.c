@@ -0,0 +1,186 @@
+/**
+ * @file    sim_i2c.c
+ * @brief   Simulated I2C1 + TX DMA with an SSD1309, see sim_i2c.h
+ */
+
+#include "sim_i2c.h"
+#include "i2c.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================================
+ * State
+ * ============================================================================ */
+I2C_TypeDef sim_i2c1;
+I2C_HandleTypeDef hi2c1 = {&sim_i2c1};
+
+uint8_t sim_panel[8][128];
+double sim_now_us, sim_cpu_us, sim_bus_us;
+long sim_writes, sim_bytes, sim_dma_starts, sim_faults, sim_resets, sim_overlap;
+int sim_fail_start, sim_fail_error, sim_fail_hang;
+
+static int page, col, skip;
+static int pending, in_isr;
+static double done_at;
+static uint8_t pend_control;
+static const uint8_t *pend_buf;
+static uint16_t pend_len;
+
+void sim_init(void)
+{
+    memset(sim_panel, 0, sizeof(sim_panel));
+    sim_now_us = sim_cpu_us = sim_bus_us = 0.0;
+    sim_writes = sim_bytes = sim_dma_starts = sim_faults = sim_resets = sim_overlap = 0;
+    sim_fail_start = sim_fail_error = sim_fail_hang = 0;
+    page = col = skip = 0;
+    pending = in_isr = 0;
+}
+
+/* ============================================================================
+ * SSD1309, page addressing
+ * ============================================================================ */
+static void panel_write(uint8_t control, const uint8_t *p, int n)
+{
+    int i;
+
+    for (i = 0; i < n; i++) {
+        uint8_t b = p[i];
+
+        if (control == 0x40) {
+            sim_panel[page][col] = b;
+            col = (col + 1) & 0x7F;
+        } else if (skip) {
+            skip = 0;
+        } else if (b >= 0xB0 && b <= 0xB7) {
+            page = b - 0xB0;
+        } else if (b <= 0x0F) {
+            col = (col & 0xF0) | b;
+        } else if (b <= 0x1F) {
+            col = (col & 0x0F) | ((b & 0x0F) << 4);
+        } else if (b == 0xFD || b == 0xD5 || b == 0xA8 || b == 0xD3 || b == 0xDA ||
+                   b == 0x81 || b == 0xD9 || b == 0xDB || b == 0x8D || b == 0x20) {
+            skip = 1;                                   /* One argument */
+        }
+    }
+}
+
+int sim_pixel(int x, int y)
+{
+    return (sim_panel[y >> 3][x] >> (y & 7)) & 1;
+}
+
+/* ============================================================================
+ * I2C1 and its TX DMA
+ * ============================================================================ */
+int sim_dma_pending(void)
+{
+    return pending;
+}
+
+void sim_run_until(double t_us)
+{
+    in_isr++;
+    while (pending && done_at <= t_us) {
+        int r = rand() % 1000;
+
+        sim_now_us = done_at;
+        sim_bus_us += pend_len * SIM_BYTE_US;
+        pending = 0;
+        if (r < sim_fail_hang) {
+            sim_faults++;
+            pending = 1;                                /* Never completes */
+            done_at = 1e300;
+            break;
+        }
+        if (r < sim_fail_hang + sim_fail_error) {
+            sim_faults++;
+            panel_write(pend_control, pend_buf, pend_len / 2);
+            HAL_I2C_ErrorCallback(&hi2c1);
+            continue;
+        }
+        panel_write(pend_control, pend_buf, pend_len);
+        sim_writes++;
+        sim_bytes += pend_len;
+        HAL_I2C_MemTxCpltCallback(&hi2c1);
+    }
+    if (sim_now_us < t_us) {
+        sim_now_us = t_us;
+    }
+    in_isr--;
+}
+
+/* The driver polls the tick while it waits: the DMA moves on meanwhile */
+uint32_t HAL_GetTick(void)
+{
+    if (!in_isr) {
+        sim_run_until(sim_now_us + 1.0);
+    }
+    return (uint32_t)(sim_now_us / 1000.0);
+}
+
+void HAL_Delay(uint32_t ms)
+{
+    sim_run_until(sim_now_us + ms * 1000.0);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem,
+                                    uint16_t mem_size, uint8_t *data, uint16_t len, uint32_t timeout)
+{
+    double us = (3 + len) * SIM_BYTE_US + 5.0;         /* Start, address, control, payload, stop */
+
+    (void)hi2c;
+    (void)addr;
+    (void)mem_size;
+    (void)timeout;
+    if (pending) {
+        sim_overlap++;
+        return HAL_BUSY;
+    }
+    sim_now_us += us;
+    sim_cpu_us += us;
+    sim_bus_us += us;
+    panel_write((uint8_t)mem, data, len);
+    sim_writes++;
+    sim_bytes += len;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem,
+                                        uint16_t mem_size, uint8_t *data, uint16_t len)
+{
+    double poll = 2 * SIM_BYTE_US + 5.0;               /* Start, address, control: polled */
+
+    (void)hi2c;
+    (void)addr;
+    (void)mem_size;
+    if (pending) {
+        return HAL_BUSY;
+    }
+    sim_dma_starts++;
+    if (rand() % 1000 < sim_fail_start) {
+        sim_faults++;
+        return HAL_ERROR;
+    }
+    sim_now_us += poll;
+    sim_cpu_us += poll;
+    sim_bus_us += poll;
+    pending = 1;
+    pend_control = (uint8_t)mem;
+    pend_buf = data;                                    /* Read by the DMA as it goes */
+    pend_len = len;
+    done_at = sim_now_us + (len + 1) * SIM_BYTE_US;     /* Payload, stop */
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c)
+{
+    (void)hi2c;
+    pending = 0;
+    sim_resets++;
+    return HAL_OK;
+}
+
+void MX_I2C1_Init(void)
+{
+}
@@ -0,0 +1,48 @@
+/**
+ * @file    sim_i2c.h
+ * @brief   Simulated I2C1 + TX DMA with an SSD1309, for the driver tests
+ * @details Time is virtual and only moves on the bus: a byte takes 9 bit
+ *          times at 400 kHz. A blocking HAL_I2C_Mem_Write() holds the CPU
+ *          for start, address, control byte and payload. The HAL's memory
+ *          write DMA polls start, address and control byte, then the
+ *          payload goes out in the background and completes from
+ *          sim_run_until() with HAL_I2C_MemTxCpltCallback(), which the test
+ *          routes as App/oled_app.c does.
+ *
+ *          The panel is the GDDRAM in page addressing mode, with the
+ *          commands the driver sends; arguments of the others are skipped.
+ *          Faults, per mille of DMA transfers: start refused, bus error
+ *          after half the payload, completion never comes.
+ */
+
+#ifndef __SIM_I2C_H__
+#define __SIM_I2C_H__
+
+#include "main.h"
+
+#define SIM_BYTE_US     22.5    /* 9 bits at 400 kHz */
+
+extern uint8_t sim_panel[8][128];   /* Panel RAM, [page][column] */
+extern double sim_now_us;           /* Virtual clock */
+extern double sim_cpu_us;           /* CPU held in HAL_I2C_* calls */
+extern double sim_bus_us;           /* Bus busy */
+extern long sim_writes;             /* I2C writes to the panel */
+extern long sim_bytes;              /* ...their payload, control bytes not counted */
+extern long sim_dma_starts;
+extern long sim_faults;             /* Faults injected */
+extern long sim_resets;             /* HAL_I2C_DeInit() calls */
+extern long sim_overlap;            /* Blocking writes with a DMA transfer in flight */
+extern int sim_fail_start, sim_fail_error, sim_fail_hang;
+
+void sim_init(void);
+
+/* Let the DMA run until t_us: completions and error callbacks */
+void sim_run_until(double t_us);
+
+/* A DMA transfer is in flight */
+int sim_dma_pending(void);
+
+/* Pixel of the panel RAM (x 0-127, y 0-63), as the driver addresses it */
+int sim_pixel(int x, int y);
+
+#endif /* __SIM_I2C_H__ */
@@ -0,0 +1,217 @@
+/**
+ * @file    test_oled_dma.c
+ * @brief   Background DMA flush: frames in flight, tearing, faults, CPU time
+ * @details The driver runs as oled_task() does: draw, OLED_Flush(), then
+ *          10 ms pass on the simulated bus. Drawing goes through rectangles
+ *          and pixels whose effect the test keeps in its own pixel model,
+ *          so the model at each OLED_Flush() that starts a frame is the
+ *          frame the panel must show when that frame completes; anything
+ *          else is a torn frame.
+ *
+ *          CPU time is what the HAL holds the CPU in HAL_I2C_* (the DMA
+ *          start polls start, address and control byte); bus time is what
+ *          a blocking flush of the same frames would have held it. Then
+ *          start failures, bus errors halfway through a transfer and lost
+ *          completions: every frame that completes is still whole, and the
+ *          panel converges to the model once the faults stop.
+ */
+
+#include "oled_test.h"
+#include "sim_i2c.h"
+#include "oled.h"
+
+static uint8_t model[64][128];
+static uint8_t expect[64][128];
+static uint32_t frames_seen;
+static long checked, torn;
+
+/* App glue, as in App/oled_app.c */
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c->Instance == I2C1) OLED_DMA_Complete();
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c->Instance == I2C1) OLED_DMA_Error();
+}
+
+static int panel_is(uint8_t img[64][128])
+{
+    int x, y;
+
+    for (y = 0; y < 64; y++) {
+        for (x = 0; x < 128; x++) {
+            if (sim_pixel(x, y) != img[y][x]) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static void fill(int x, int y, int w, int h, int on)
+{
+    int i, j;
+
+    OLED_FillRect((uint8_t)x, (uint8_t)y, (uint8_t)w, (uint8_t)h, (uint8_t)on);
+    for (j = y; j < y + h; j++) {
+        for (i = x; i < x + w; i++) {
+            model[j][i] = (uint8_t)on;
+        }
+    }
+}
+
+static void pixel(int x, int y, int on)
+{
+    OLED_DrawPixel((uint8_t)x, (uint8_t)y, (uint8_t)on);
+    model[y][x] = (uint8_t)on;
+}
+
+/* A frame completed since the last look: it must be the one flushed */
+static void frame_check(void)
+{
+    if (OLED_GetStats()->frames != frames_seen) {
+        frames_seen = OLED_GetStats()->frames;
+        checked++;
+        torn += !panel_is(expect);
+    }
+}
+
+static OLED_FlushStatus flush(void)
+{
+    OLED_FlushStatus st;
+
+    frame_check();
+    st = OLED_Flush();
+    if (st == OLED_FLUSH_STARTED) {
+        memcpy(expect, model, sizeof(model));
+    }
+    return st;
+}
+
+static void settle(void)
+{
+    int i;
+
+    for (i = 0; i < 1000; i++) {
+        if (flush() == OLED_FLUSH_IDLE && !OLED_Busy()) {
+            break;
+        }
+        sim_run_until(sim_now_us + 10000.0);
+    }
+    frame_check();
+}
+
+static void draw(int kind, int n)
+{
+    int i;
+
+    switch (kind) {
+    case 0:                                 /* One value changes */
+        fill(80, 40, 30, 8, 0);
+        fill(80 + n % 24, 40, 6, 8, 1);
+        break;
+    case 1:                                 /* Whole screen every tick */
+        fill(0, 0, 128, 64, n & 1);
+        break;
+    default:                                /* Anything, anywhere */
+        for (i = 0; i < 20; i++) {
+            pixel(rand() % 128, rand() % 64, rand() & 1);
+        }
+        {
+            int w = 1 + rand() % 40, h = 1 + rand() % 20;
+            fill(rand() % (129 - w), rand() % (65 - h), w, h, rand() & 1);
+        }
+        break;
+    }
+}
+
+static void workload(const char *name, int kind, int ticks)
+{
+    const OLED_Stats *st = OLED_GetStats();
+    double cpu = sim_cpu_us, bus = sim_bus_us;
+    uint32_t frames = st->frames, busy = st->busy, writes = st->transactions, bytes = st->bytes;
+    int i;
+
+    for (i = 0; i < ticks; i++) {
+        double t = sim_now_us;
+        draw(kind, i);
+        flush();
+        sim_run_until(t + 10000.0);
+    }
+    settle();
+    CHECK(panel_is(model));
+
+    frames = st->frames - frames;
+    printf("%-14s %4lu frames / %d ticks, %4lu busy, %5.1f writes %6.1f bytes per frame, "
+           "bus %6.0f us, CPU %5.0f us per frame\n", name, (unsigned long)frames, ticks,
+           (unsigned long)(st->busy - busy),
+           frames ? (double)(st->transactions - writes) / frames : 0.0,
+           frames ? (double)(st->bytes - bytes) / frames : 0.0,
+           frames ? (sim_bus_us - bus) / frames : 0.0,
+           frames ? (sim_cpu_us - cpu) / frames : 0.0);
+}
+
+int main(int argc, char **argv)
+{
+    const OLED_Stats *st = OLED_GetStats();
+    long faults;
+
+    test_seed(argc, argv);
+    sim_init();
+
+    /* The blank frame after the init commands goes out in the background */
+    OLED_Init();
+    CHECK(OLED_Busy());
+    sim_run_until(sim_now_us + 100000.0);
+    frame_check();
+    CHECK(!OLED_Busy() && st->frames == 1 && st->last_bytes == 8 * 131);
+    CHECK(panel_is(model));
+    printf("init frame: %u writes, %u bytes, %u ms\n", st->last_transactions, st->last_bytes,
+           st->last_ms);
+
+    /* A flush during a frame starts nothing and keeps the change for later */
+    fill(0, 0, 128, 64, 1);
+    CHECK(flush() == OLED_FLUSH_STARTED);
+    fill(0, 0, 10, 8, 0);
+    CHECK(flush() == OLED_FLUSH_BUSY && st->busy == 1);
+    sim_run_until(sim_now_us + 50000.0);
+    frame_check();
+    CHECK(checked == 2 && torn == 0);               /* Whole lit frame, no hole */
+    CHECK(flush() == OLED_FLUSH_STARTED);
+    sim_run_until(sim_now_us + 50000.0);
+    frame_check();
+    CHECK(st->last_transactions == 2 && st->last_bytes == 3 + 10);
+    CHECK(panel_is(model));
+
+    /* Commands wait for the frame in flight */
+    fill(0, 0, 128, 64, 0);
+    CHECK(flush() == OLED_FLUSH_STARTED);
+    OLED_Display_On();
+    CHECK(!sim_dma_pending() && sim_overlap == 0);
+    CHECK(panel_is(model));
+
+    workload("one value", 0, 500);
+    workload("full frame", 1, 500);
+    workload("random", 2, 500);
+    printf("clean bus: %ld frames checked, %ld torn\n", checked, torn);
+    CHECK(torn == 0);
+
+    /* Faults, per mille of DMA transfers */
+    faults = sim_faults;
+    sim_fail_start = 20;
+    sim_fail_error = 20;
+    sim_fail_hang = 5;
+    workload("random+faults", 2, 3000);
+    workload("value+faults", 0, 3000);
+    sim_fail_start = sim_fail_error = sim_fail_hang = 0;
+    settle();
+    CHECK(panel_is(model));
+    printf("faults: %ld injected, %lu frames resent, %ld bus resets, %ld torn of %ld\n",
+           sim_faults - faults, (unsigned long)st->errors, sim_resets, torn, checked);
+    CHECK(torn == 0 && st->errors > 0 && sim_resets > 0);
+    CHECK(sim_overlap == 0);
+
+    return test_finish();
+}
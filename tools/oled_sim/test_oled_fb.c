@@ -0,0 +1,206 @@
+/**
+ * @file    test_oled_fb.c
+ * @brief   I2C writes and bytes per frame: per-byte driver vs framebuffer
+ * @details The same drawing runs on the driver in the tree (test_oled_fb)
+ *          and on the per-byte driver it replaced (test_oled_fb_legacy,
+ *          the oled.c before the framebuffer, kept in legacy/). Each
+ *          workload is drawn once, then redrawn for FRAMES frames; the bus
+ *          writes and payload bytes the panel sees are reported per frame.
+ *
+ *          The legacy run leaves the panel RAM after every workload in
+ *          oled_fb_legacy.ram; the framebuffer run must end each workload
+ *          with the same RAM, byte for byte. Then the drawing primitives,
+ *          pixel by pixel (framebuffer only).
+ */
+
+#include "oled_test.h"
+#include "sim_i2c.h"
+#include "oled.h"
+
+#define FRAMES      100
+#define WORKLOADS   5
+
+static uint8_t ram[WORKLOADS][8][128];
+
+/* App glue, as in App/oled_app.c */
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+#ifndef OLED_LEGACY
+    if (hi2c->Instance == I2C1) OLED_DMA_Complete();
+#else
+    (void)hi2c;
+#endif
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+#ifndef OLED_LEGACY
+    if (hi2c->Instance == I2C1) OLED_DMA_Error();
+#else
+    (void)hi2c;
+#endif
+}
+
+/* What oled_task() does after drawing: flush, here until the frame is out */
+static void frame_end(void)
+{
+#ifndef OLED_LEGACY
+    OLED_Flush();
+    while (OLED_Busy()) {
+        sim_run_until(sim_now_us + 100.0);
+    }
+#endif
+}
+
+static void draw(int kind, int n)
+{
+    static uint8_t glyph[32];
+    char b[32];
+    int i;
+
+    switch (kind) {
+    case 0:
+        OLED_ShowStr(1, 1, "hello", 8);
+        break;
+    case 1:
+        snprintf(b, sizeof(b), "C2H4 %d.%02d ppm", n % 7, n % 100);
+        OLED_ShowStr(0, 0, b, 16);
+        OLED_ShowStr(0, 2, "Temp 24.5 C", 16);
+        OLED_ShowStr(0, 4, "State: fresh", 16);
+        snprintf(b, sizeof(b), "%02d:%02d:%02d", n / 3600, n / 60 % 60, n % 60);
+        OLED_ShowStr(0, 6, b, 16);
+        break;
+    case 2:
+        if (n & 1) {
+            OLED_Allfill();
+        } else {
+            OLED_Clear();
+        }
+        break;
+    case 3:
+        for (i = 0; i < 32; i++) {
+            glyph[i] = (uint8_t)(i * 37 + 1);
+        }
+        for (i = 0; i < 8; i++) {
+            OLED_ShowPic(i * 16, 2, i * 16 + 16, 4, glyph);
+        }
+        break;
+    default:
+        OLED_ShowNum(0, 6, (uint32_t)n * 7u, 5, 16);
+        OLED_ShowChar(64, 6, 'A' + n % 26, 16);
+        break;
+    }
+    frame_end();
+}
+
+static void workloads(void)
+{
+    static const char *const names[WORKLOADS] = {
+        "\"hello\" redraw", "4-line status", "full screen", "8 16x16 glyphs", "number field"
+    };
+    int k, i;
+
+    for (k = 0; k < WORKLOADS; k++) {
+        long w, b;
+
+        draw(k, 0);                         /* First draw */
+        w = sim_writes;
+        b = sim_bytes;
+        for (i = 1; i <= FRAMES; i++) {
+            draw(k, i);
+        }
+        printf("%-16s %8.1f writes %8.1f bytes per frame\n", names[k],
+               (double)(sim_writes - w) / FRAMES, (double)(sim_bytes - b) / FRAMES);
+        memcpy(ram[k], sim_panel, sizeof(sim_panel));
+    }
+}
+
+#ifndef OLED_LEGACY
+static int lit(int x, int y)
+{
+    return sim_pixel(x, y);
+}
+
+static void primitives(void)
+{
+    int x, y, bad = 0;
+
+    /* Line: one pixel per column, within half a pixel of the ideal */
+    OLED_Clear();
+    OLED_DrawLine(0, 0, 127, 63, 1);
+    frame_end();
+    for (x = 0; x < 128; x++) {
+        int n = 0, at = -1;
+        for (y = 0; y < 64; y++) {
+            if (lit(x, y)) {
+                n++;
+                at = y;
+            }
+        }
+        bad += (n != 1 || abs(2 * 127 * at - 2 * 63 * x) > 127);
+    }
+    CHECK(bad == 0);
+
+    /* Outline, filled block, one pixel cleared again */
+    OLED_Clear();
+    OLED_DrawRect(0, 0, 128, 64, 1);
+    OLED_FillRect(10, 5, 20, 13, 1);
+    OLED_DrawPixel(127, 63, 0);
+    frame_end();
+    bad = 0;
+    for (y = 0; y < 64; y++) {
+        for (x = 0; x < 128; x++) {
+            int want = (x == 0 || x == 127 || y == 0 || y == 63) ||
+                       (x >= 10 && x < 30 && y >= 5 && y < 18);
+            if (x == 127 && y == 63) {
+                want = 0;
+            }
+            bad += (lit(x, y) != want);
+        }
+    }
+    CHECK(bad == 0);
+    printf("primitives: line, outline, fill and pixel match pixel by pixel\n");
+}
+#endif
+
+int main(int argc, char **argv)
+{
+    FILE *f;
+
+    test_seed(argc, argv);
+    sim_init();
+
+    OLED_Init();
+    frame_end();
+    printf("%-16s %8ld writes %8ld bytes\n", "init + clear", sim_writes, sim_bytes);
+
+    workloads();
+
+#ifdef OLED_LEGACY
+    f = fopen("oled_fb_legacy.ram", "wb");
+    CHECK(f != NULL && fwrite(ram, sizeof(ram), 1, f) == 1);
+    if (f != NULL) {
+        fclose(f);
+    }
+#else
+    {
+        static uint8_t legacy[WORKLOADS][8][128];
+        int k;
+
+        f = fopen("oled_fb_legacy.ram", "rb");
+        CHECK(f != NULL);                   /* test_oled_fb_legacy runs first */
+        if (f != NULL) {
+            CHECK(fread(legacy, sizeof(legacy), 1, f) == 1);
+            fclose(f);
+            for (k = 0; k < WORKLOADS; k++) {
+                CHECK(memcmp(legacy[k], ram[k], sizeof(ram[k])) == 0);
+            }
+            printf("panel RAM after each workload: same as the per-byte driver\n");
+        }
+    }
+    CHECK(sim_overlap == 0);
+    primitives();
+#endif
+
+    return test_finish();
+}
@@ -0,0 +1,260 @@
+/**
+ * @file    test_oled_text.c
+ * @brief   oled_text: golden framebuffers, formatting, dirty tracking, cycles
+ * @details Six cases drawn with OLED_Text/TextClip/TextBox/NumberBox,
+ *          flushed to the simulated panel and compared pixel for pixel with
+ *          golden/text_*.pbm. Those come from text_golden.py, which draws
+ *          the same cases from oledfont.h with its own renderer, so the C
+ *          font tables and blitter are checked against an independent
+ *          reading of the rules. Then OLED_FormatFixed() edge cases, text
+ *          widths, and a redraw of unchanged text that must leave nothing
+ *          to flush.
+ *
+ *          Benchmark: time per rendered string, vsnprintf + OLED_ShowStr
+ *          (what Oled_Printf() in App/oled_app.c does) against
+ *          OLED_FormatFixed + OLED_Text. TSC cycles on x86, ns elsewhere;
+ *          the target figure comes from the "oled bench" console command.
+ */
+
+#include "oled_test.h"
+#include "sim_i2c.h"
+#include "oled.h"
+#include "oled_text.h"
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT  "TSC cycles"
+static double bench_now(void)
+{
+    return (double)__rdtsc();
+}
+#else
+#define BENCH_UNIT  "ns"
+static double bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+#endif
+
+#define GOLDEN_DIR  "../golden/"    /* Tests run in build/ */
+
+/* App glue, as in App/oled_app.c */
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c->Instance == I2C1) OLED_DMA_Complete();
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c->Instance == I2C1) OLED_DMA_Error();
+}
+
+/* As in App/oled_app.c */
+static int Oled_Printf(uint8_t x, uint8_t y, const char *format, ...)
+{
+    char buffer[128];
+    va_list arg;
+    int len;
+
+    va_start(arg, format);
+    len = vsnprintf(buffer, sizeof(buffer), format, arg);
+    va_end(arg);
+    OLED_ShowStr(x, y, buffer, 8);
+    return len;
+}
+
+static void flush(void)
+{
+    OLED_Flush();
+    while (OLED_Busy()) {
+        sim_run_until(sim_now_us + 100.0);
+    }
+}
+
+/* P1 PBM, 128 x 64, comments skipped */
+static int read_pbm(const char *path, uint8_t img[64][128])
+{
+    FILE *f = fopen(path, "r");
+    char line[256];
+    int w = 0, h = 0, n = 0, c;
+
+    if (f == NULL) {
+        return 0;
+    }
+    if (fgets(line, sizeof(line), f) == NULL || strncmp(line, "P1", 2) != 0) {
+        fclose(f);
+        return 0;
+    }
+    while ((c = fgetc(f)) == '#') {
+        if (fgets(line, sizeof(line), f) == NULL) {
+            break;
+        }
+    }
+    ungetc(c, f);
+    if (fscanf(f, "%d %d", &w, &h) != 2 || w != 128 || h != 64) {
+        fclose(f);
+        return 0;
+    }
+    while (n < 64 * 128 && (c = fgetc(f)) != EOF) {
+        if (c == '0' || c == '1') {
+            img[n / 128][n % 128] = (uint8_t)(c - '0');
+            n++;
+        }
+    }
+    fclose(f);
+    return n == 64 * 128;
+}
+
+static void golden(const char *name)
+{
+    static uint8_t img[64][128];
+    char path[128];
+    int x, y, diff = 0;
+
+    flush();
+    snprintf(path, sizeof(path), GOLDEN_DIR "text_%s.pbm", name);
+    if (!read_pbm(path, img)) {
+        printf("%-9s no golden at %s\n", name, path);
+        CHECK(0);
+        return;
+    }
+    for (y = 0; y < 64; y++) {
+        for (x = 0; x < 128; x++) {
+            diff += (sim_pixel(x, y) != img[y][x]);
+        }
+    }
+    if (diff) {
+        printf("%-9s %d pixels differ from %s\n", name, diff, path);
+    } else {
+        printf("%-9s matches the golden\n", name);
+    }
+    CHECK(diff == 0);
+}
+
+static void background(uint8_t on)
+{
+    OLED_FillRect(0, 0, OLED_WIDTH, OLED_HEIGHT, on);
+}
+
+static void goldens(void)
+{
+    OLED_Clip box = {20, 30, 60, 40};
+
+    background(0);
+    OLED_Text(1, 8, "hello", &OLED_Font6x8);
+    golden("hello");
+
+    background(0);
+    OLED_Text(3, 5, "Temp 24.5 C", &OLED_Font8x16);
+    golden("8x16");
+
+    background(1);
+    OLED_Text(-4, 58, "Clip{|}~", &OLED_Font6x8);
+    OLED_Text(100, 50, "Wide text", &OLED_Font8x16);
+    golden("edges");
+
+    background(1);
+    OLED_TextBox(10, 20, 50, "OK", &OLED_Font8x16, OLED_ALIGN_CENTER);
+    OLED_TextBox(0, 0, 30, "left", &OLED_Font6x8, OLED_ALIGN_LEFT);
+    OLED_TextBox(60, 3, 20, "overflowing", &OLED_Font6x8, OLED_ALIGN_RIGHT);
+    golden("boxes");
+
+    background(0);
+    OLED_NumberBox(70, 40, 50, -1234, 2, &OLED_Font8x16);
+    OLED_NumberBox(0, 40, 20, -1234, 2, &OLED_Font8x16);
+    OLED_NumberBox(0, 0, 60, 7, 3, &OLED_Font6x8);
+    OLED_NumberBox(0, 9, 60, INT32_MIN, 0, &OLED_Font6x8);
+    golden("numbers");
+
+    background(1);
+    OLED_TextClip(12, 27, "clipped", &OLED_Font8x16, &box);
+    golden("cliprect");
+}
+
+static void formatting(void)
+{
+    static const struct {
+        int32_t v;
+        uint8_t d;
+        const char *s;
+    } fc[] = {
+        {0, 0, "0"}, {-5, 2, "-0.05"}, {2345, 2, "23.45"}, {INT32_MIN, 0, "-2147483648"},
+        {INT32_MIN, 9, "-2.147483648"}, {INT32_MAX, 9, "2.147483647"}, {100, 1, "10.0"},
+        {1, 12, "0.000000001"},
+    };
+    char b[OLED_NUM_LEN];
+    unsigned i;
+
+    for (i = 0; i < sizeof(fc) / sizeof(fc[0]); i++) {
+        uint8_t n = OLED_FormatFixed(b, fc[i].v, fc[i].d);
+        if (strcmp(b, fc[i].s) != 0 || n != strlen(fc[i].s)) {
+            printf("FormatFixed(%ld, %u) = \"%s\", want \"%s\"\n", (long)fc[i].v, fc[i].d, b, fc[i].s);
+            CHECK(0);
+        }
+    }
+    CHECK(OLED_FormatInt(b, -42) == 3 && strcmp(b, "-42") == 0);
+    CHECK(OLED_TextWidth("", &OLED_Font6x8) == 0);
+    CHECK(OLED_TextWidth("0123456789", &OLED_Font6x8) == 10 * 5 + 9);    /* Tabular digits */
+
+    /* Unchanged redraw: nothing dirty, nothing to send */
+    background(0);
+    OLED_NumberBox(70, 40, 50, -1234, 2, &OLED_Font8x16);
+    OLED_Text(3, 5, "Temp 24.5 C", &OLED_Font8x16);
+    flush();
+    OLED_NumberBox(70, 40, 50, -1234, 2, &OLED_Font8x16);
+    OLED_Text(3, 5, "Temp 24.5 C", &OLED_Font8x16);
+    CHECK(OLED_Flush() == OLED_FLUSH_IDLE);
+    printf("formatting, widths and unchanged redraws checked\n");
+}
+
+static void bench(void)
+{
+    enum { N = 20000 };
+    char b[OLED_NUM_LEN];
+    double t0, per[3];
+    int i;
+
+    t0 = bench_now();
+    for (i = 0; i < N; i++) {
+        Oled_Printf(1, 1, "T %d.%d C", i % 100, i % 10);
+    }
+    per[0] = (bench_now() - t0) / N;
+
+    t0 = bench_now();
+    for (i = 0; i < N; i++) {
+        OLED_FormatFixed(b, i % 1000, 1);
+        OLED_Text(1, 8, "T ", &OLED_Font6x8);
+        OLED_Text(12, 8, b, &OLED_Font6x8);
+    }
+    per[1] = (bench_now() - t0) / N;
+
+    t0 = bench_now();
+    for (i = 0; i < N; i++) {
+        OLED_NumberBox(70, 40, 50, i % 100000, 2, &OLED_Font8x16);
+    }
+    per[2] = (bench_now() - t0) / N;
+
+    printf("host %s per string: Oled_Printf 6x8 %.0f, FormatFixed + OLED_Text 6x8 %.0f, "
+           "NumberBox 8x16 %.0f\n", BENCH_UNIT, per[0], per[1], per[2]);
+    flush();
+}
+
+int main(int argc, char **argv)
+{
+    test_seed(argc, argv);
+    sim_init();
+    OLED_Init();
+    flush();
+
+    goldens();
+    formatting();
+    bench();
+
+    return test_finish();
+}
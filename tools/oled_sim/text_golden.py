@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""
+Golden framebuffers for test_oled_text, drawn without the C code.
+  python3 text_golden.py [-v]     writes golden/text_*.pbm (-v: ASCII preview)
+
+Reads F6X8 / F8X16 from oledfont.h and applies the oled_text rules on its
+own: blank columns trimmed (space keeps 3 / 4 columns), digits padded to
+the widest digit and centred, one blank column between glyphs, '?' for
+characters outside the font, clipping to the panel and to a rectangle,
+boxes cleared before the text, fixed point formatting, '#' when a number
+does not fit its box. The cases must match test_oled_text.c.
+"""
+
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SRC = open(os.path.join(HERE, '../../keil_fruit/Components/ssd1309/oledfont.h'), encoding='utf-8').read()
+W, H = 128, 64
+
+
+def table(name):
+    i = SRC.index(name)
+    j = SRC.index('{', i)
+    k = SRC.index('};', j)
+    body = re.sub(r'//[^\n]*', '', SRC[j + 1:k])
+    return [int(x, 16) for x in re.findall(r'0x[0-9a-fA-F]+', body)]
+
+
+F6X8 = table('F6X8[][6]')
+F8X16 = table('F8X16[]')
+
+
+def glyph6(c):
+    return [[(F6X8[c * 6 + i] >> r) & 1 for r in range(8)] for i in range(6)]
+
+
+def glyph8(c):
+    return [[(F8X16[c * 16 + i] >> r) & 1 for r in range(8)] +
+            [(F8X16[c * 16 + 8 + i] >> r) & 1 for r in range(8)] for i in range(8)]
+
+
+class Font:
+    def __init__(self, count, glyph, height, space):
+        self.h = height
+        self.cols = []
+        for c in range(count):
+            cols = glyph(c)
+            ink = [i for i, col in enumerate(cols) if any(col)]
+            self.cols.append(cols[ink[0]:ink[-1] + 1] if ink else [[0] * height] * space)
+        dw = max(len(self.cols[ord(d) - 32]) for d in '0123456789')
+        for d in '0123456789':
+            c = self.cols[ord(d) - 32]
+            pad = dw - len(c)
+            self.cols[ord(d) - 32] = [[0] * height] * (pad // 2) + c + [[0] * height] * (pad - pad // 2)
+
+    def glyph(self, ch):
+        i = ord(ch) - 32
+        return self.cols[i] if 0 <= i < len(self.cols) else self.cols[ord('?') - 32]
+
+    def line(self, text):
+        out = []
+        for k, ch in enumerate(text):
+            out += self.glyph(ch)
+            if k < len(text) - 1:
+                out.append([0] * self.h)
+        return out
+
+
+FONT6 = Font(len(F6X8) // 6, glyph6, 8, 3)
+FONT8 = Font(len(F8X16) // 16, glyph8, 16, 4)
+
+
+def fixed(value, decimals):
+    t = str(abs(value)).rjust(decimals + 1, '0')
+    if decimals:
+        t = t[:-decimals] + '.' + t[-decimals:]
+    return ('-' if value < 0 else '') + t
+
+
+class Image:
+    def __init__(self, fill=0):
+        self.p = [[fill] * W for _ in range(H)]
+
+    def put(self, x, y, v, clip):
+        x0, y0, x1, y1 = clip
+        if max(0, x0) <= x < min(W, x1) and max(0, y0) <= y < min(H, y1):
+            self.p[y][x] = v
+
+    def cols(self, x, y, cols, h, clip):
+        for i, col in enumerate(cols):
+            for r in range(h):
+                self.put(x + i, y + r, col[r], clip)
+
+    def text(self, x, y, s, f, clip=(0, 0, W, H)):
+        self.cols(x, y, f.line(s), f.h, clip)
+
+    def box(self, x, y, w, s, f, align):
+        tw = len(f.line(s))
+        tx = {'L': x, 'R': x + w - tw, 'C': x + (w - tw) // 2}[align]
+        clip = (x, y, x + w, y + f.h)
+        self.cols(x, y, [[0] * f.h] * w, f.h, clip)
+        self.text(tx, y, s, f, clip)
+
+    def number(self, x, y, w, value, decimals, f):
+        s = fixed(value, decimals)
+        if len(f.line(s)) > w:
+            s = '#'
+        self.box(x, y, w, s, f, 'R')
+
+    def pbm(self, path, about):
+        with open(path, 'w') as out:
+            out.write('P1\n# text_golden.py: %s\n%d %d\n' % (about, W, H))
+            for y in range(H):
+                row = ''.join(str(v) for v in self.p[y])
+                out.write(row[:64] + '\n' + row[64:] + '\n')
+
+
+def cases():
+    a = Image()
+    a.text(1, 8, 'hello', FONT6)
+    yield 'hello', 'oled_task() text, 6x8 at y 8', a
+
+    a = Image()
+    a.text(3, 5, 'Temp 24.5 C', FONT8)
+    yield '8x16', '8x16 at y 5, across three pages', a
+
+    a = Image(1)
+    a.text(-4, 58, 'Clip{|}~', FONT6)
+    a.text(100, 50, 'Wide text', FONT8)
+    yield 'edges', 'clipped at the left, bottom and right edges, lit background', a
+
+    a = Image(1)
+    a.box(10, 20, 50, 'OK', FONT8, 'C')
+    a.box(0, 0, 30, 'left', FONT6, 'L')
+    a.box(60, 3, 20, 'overflowing', FONT6, 'R')
+    yield 'boxes', 'centred, left and overflowing right-aligned boxes', a
+
+    a = Image()
+    a.number(70, 40, 50, -1234, 2, FONT8)
+    a.number(0, 40, 20, -1234, 2, FONT8)
+    a.number(0, 0, 60, 7, 3, FONT6)
+    a.number(0, 9, 60, -2 ** 31, 0, FONT6)
+    yield 'numbers', 'fixed point boxes, one too narrow, INT32_MIN', a
+
+    a = Image(1)
+    a.text(12, 27, 'clipped', FONT8, (20, 30, 60, 40))
+    yield 'cliprect', 'text clipped to a rectangle', a
+
+
+def main():
+    out = os.path.join(HERE, 'golden')
+    os.makedirs(out, exist_ok=True)
+    for name, about, img in cases():
+        path = os.path.join(out, 'text_%s.pbm' % name)
+        img.pbm(path, about)
+        print(os.path.relpath(path))
+        if '-v' in sys.argv:
+            for y in range(H):
+                print(''.join('#' if v else '.' for v in img.p[y]))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,47 @@
+/**
+ * @file    gen_ethylene_lut.c
+ * @brief   Writes keil_fruit/App/ethylene_lut.h, the ethylene curve table
+ * @details rs(code)^B for every 12-bit code, 0 where the voltage is out of
+ *          range, computed with the float expressions adc_app.c used to
+ *          run at boot. The constants must match adc_app.c; make check
+ *          (test_ethylene_lut) compares the table with
+ *          Ethylene_CalculatePPM() on every code, so a mismatch fails there.
+ *            make lut        regenerate after changing a constant
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#define SENSOR_VC       3.3f
+#define SENSOR_RL       30.0f
+#define FIT_PARAM_B     -2.35f
+
+int main(int argc, char **argv)
+{
+    FILE *f;
+    int code;
+
+    if (argc != 2 || (f = fopen(argv[1], "w")) == NULL) {
+        fprintf(stderr, "usage: gen_ethylene_lut OUT.h\n");
+        return 2;
+    }
+
+    fprintf(f, "#ifndef ETHYLENE_LUT_H\n#define ETHYLENE_LUT_H\n\n");
+    fprintf(f, "// Generated by tools/sensor_test/gen_ethylene_lut.c (make lut), do not edit.\n");
+    fprintf(f, "// rs(code)^B for every 12-bit CH0 code, RL %.1f kohm, Vc %.1f V, B %.2f;\n",
+            SENSOR_RL, SENSOR_VC, FIT_PARAM_B);
+    fprintf(f, "// 0 where the voltage is out of range. Included by adc_app.c only.\n\n");
+    fprintf(f, "#define ETHYLENE_LUT_SIZE   4096\n\n");
+    fprintf(f, "static const float ethylene_lut[ETHYLENE_LUT_SIZE] = {\n");
+    for (code = 0; code < 4096; code++) {
+        float v = ((float)code * 3.3f) / 4096.0f;
+        float x = 0.0f;
+
+        if (v > 0.01f && v < SENSOR_VC - 0.01f) {
+            x = powf(SENSOR_RL * (SENSOR_VC - v) / v, FIT_PARAM_B);
+        }
+        fprintf(f, "%s%.8ef,%s", code % 4 == 0 ? "    " : " ", x, code % 4 == 3 ? "\n" : "");
+    }
+    fprintf(f, "};\n\n#endif\n");
+    return fclose(f) != 0;
+}
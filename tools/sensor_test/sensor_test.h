@@ -0,0 +1,55 @@
+/**
+ * @file    sensor_test.h
+ * @brief   Shared helpers for the sensor component host tests
+ * @details Each test is one program: CHECK() counts failures, the seed
+ *          comes from argv[1] (default 1), and the exit status is 0 only
+ *          if nothing failed.
+ */
+
+#ifndef __SENSOR_TEST_H__
+#define __SENSOR_TEST_H__
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static int test_fails;
+
+#define CHECK(c) do { \
+        if (!(c)) { \
+            printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #c); \
+            test_fails++; \
+        } \
+    } while (0)
+
+static inline void test_seed(int argc, char **argv)
+{
+    srand(argc > 1 ? (unsigned)atoi(argv[1]) : 1u);
+}
+
+/* Standard normal deviate (Box-Muller) */
+static inline double test_gauss(void)
+{
+    double u = (rand() + 1.0) / (RAND_MAX + 2.0);
+    double v = (rand() + 1.0) / (RAND_MAX + 2.0);
+
+    return sqrt(-2.0 * log(u)) * cos(6.283185307179586 * v);
+}
+
+static inline double test_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static inline int test_finish(void)
+{
+    printf("%s\n", test_fails ? "FAILED" : "ALL OK");
+    return test_fails != 0;
+}
+
+#endif /* __SENSOR_TEST_H__ */
@@ -0,0 +1,34 @@
+/**
+ * @file    cmsis_simd.h
+ * @brief   Host versions of the Cortex-M4 SIMD intrinsics dsp_filter.c uses
+ * @details Force-included with -D__ARM_FEATURE_DSP=1 so the SIMD kernels
+ *          build and run on the host (test_dsp_filter_simd). Semantics
+ *          follow the ARMv7-M reference: signed halfword products, a
+ *          32-bit wrapping accumulator for SMLAD and 64-bit for SMLALD.
+ */
+
+#ifndef __CMSIS_SIMD_H__
+#define __CMSIS_SIMD_H__
+
+#include <stdint.h>
+
+static inline uint32_t __SMLAD(uint32_t op1, uint32_t op2, uint32_t op3)
+{
+    int32_t lo = (int32_t)(int16_t)op1 * (int16_t)op2;
+    int32_t hi = (int32_t)(int16_t)(op1 >> 16) * (int16_t)(op2 >> 16);
+
+    return op3 + (uint32_t)lo + (uint32_t)hi;
+}
+
+static inline uint64_t __SMLALD(uint32_t op1, uint32_t op2, uint64_t acc)
+{
+    int64_t lo = (int64_t)(int16_t)op1 * (int16_t)op2;
+    int64_t hi = (int64_t)(int16_t)(op1 >> 16) * (int16_t)(op2 >> 16);
+
+    return acc + (uint64_t)lo + (uint64_t)hi;
+}
+
+#define __PKHBT(ARG1, ARG2, ARG3) \
+    ((((uint32_t)(ARG1)) & 0x0000FFFFUL) | ((((uint32_t)(ARG2)) << (ARG3)) & 0xFFFF0000UL))
+
+#endif /* __CMSIS_SIMD_H__ */
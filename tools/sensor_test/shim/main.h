@@ -0,0 +1,183 @@
+/**
+ * @file    main.h
+ * @brief   Host stand-in for the firmware's main.h (tools/sensor_test)
+ * @details The STM32 HAL subset that App/define.h and the sensor-side App
+ *          modules (adc_app, burst_app, stats_app) use. Registers are plain
+ *          structs: TIM2 and ADC1 are read by the simulated converter in
+ *          sim_hal.c, which also implements the functions declared here.
+ *          Register bits keep their STM32F4 values.
+ */
+
+#ifndef __MAIN_H
+#define __MAIN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define __IO volatile
+
+#define SET_BIT(REG, BIT)       ((REG) |= (BIT))
+#define CLEAR_BIT(REG, BIT)     ((REG) &= ~(BIT))
+
+typedef enum {
+    HAL_OK = 0,
+    HAL_ERROR,
+    HAL_BUSY,
+    HAL_TIMEOUT
+} HAL_StatusTypeDef;
+
+typedef enum {
+    DISABLE = 0,
+    ENABLE = 1
+} FunctionalState;
+
+typedef enum {
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+/* ============================================================================
+ * Peripherals
+ * ============================================================================ */
+typedef struct {
+    uint32_t id;
+} GPIO_TypeDef;
+
+typedef struct {
+    __IO uint32_t CR1, CR2, EGR, CNT, PSC, ARR;
+} TIM_TypeDef;
+
+typedef struct {
+    __IO uint32_t CFGR;
+} RCC_TypeDef;
+
+typedef struct {
+    __IO uint32_t SR, CR1, CR2, HTR, LTR, JDR1, JDR2, JDR3, JDR4;
+} ADC_TypeDef;
+
+typedef struct {
+    __IO uint32_t NDTR;
+} DMA_Stream_TypeDef;
+
+typedef struct {
+    __IO uint32_t LISR;
+} DMA_TypeDef;
+
+extern TIM_TypeDef sim_tim2;
+extern RCC_TypeDef sim_rcc;
+extern ADC_TypeDef sim_adc1;
+extern DMA_Stream_TypeDef sim_dma2_stream0;
+extern DMA_TypeDef sim_dma2;
+
+#define TIM2                    (&sim_tim2)
+#define RCC                     (&sim_rcc)
+#define ADC1                    (&sim_adc1)
+#define DMA2_Stream0            (&sim_dma2_stream0)
+
+#define TIM_CR1_CEN             0x0001u
+#define TIM_CR1_ARPE            0x0080u
+#define TIM_CR2_MMS             0x0070u
+#define TIM_CR2_MMS_1           0x0020u
+#define TIM_EGR_UG              0x0001u
+
+#define RCC_CFGR_PPRE1          0x1C00u
+#define RCC_HCLK_DIV1           0x0000u
+#define RCC_HCLK_DIV4           0x1400u
+
+#define ADC_SR_AWD              0x01u
+#define ADC_SR_JEOC             0x04u
+#define ADC_SR_JSTRT            0x08u
+#define ADC_CR1_AWDIE           0x40u
+#define ADC_CR2_JSWSTART        0x400000u
+
+#define ADC_FLAG_AWD            ADC_SR_AWD
+#define ADC_FLAG_JEOC           ADC_SR_JEOC
+#define ADC_FLAG_JSTRT          ADC_SR_JSTRT
+#define ADC_IT_AWD              ADC_CR1_AWDIE
+#define ADC_CHANNEL_0           0u
+#define ADC_ANALOGWATCHDOG_SINGLE_REG 0x00800200u
+#define ADC_INJECTED_RANK_1     1u
+#define ADC_INJECTED_RANK_2     2u
+#define ADC_INJECTED_RANK_3     3u
+#define ADC_INJECTED_RANK_4     4u
+
+#define DMA_FLAG_HTIF0_4        0x10u
+#define DMA_FLAG_TCIF0_4        0x20u
+
+/* ============================================================================
+ * Handles
+ * ============================================================================ */
+typedef struct {
+    DMA_Stream_TypeDef *Instance;
+} DMA_HandleTypeDef;
+
+typedef struct {
+    ADC_TypeDef *Instance;
+    DMA_HandleTypeDef *DMA_Handle;
+} ADC_HandleTypeDef;
+
+typedef struct {
+    uint32_t WatchdogMode;
+    uint32_t HighThreshold;
+    uint32_t LowThreshold;
+    uint32_t Channel;
+    FunctionalState ITMode;
+} ADC_AnalogWDGConfTypeDef;
+
+typedef struct {
+    uint32_t id;
+} UART_HandleTypeDef;
+
+typedef struct {
+    uint32_t id;
+} I2C_HandleTypeDef;
+
+typedef struct {
+    uint32_t id;
+} RTC_HandleTypeDef;
+
+typedef struct {
+    void *Instance;
+    DMA_HandleTypeDef *hdmatx;
+    DMA_HandleTypeDef *hdmarx;
+} SPI_HandleTypeDef;
+
+#define __HAL_RCC_TIM2_CLK_ENABLE()             ((void)0)
+
+#define __HAL_ADC_GET_FLAG(h, f)                ((((h)->Instance->SR) & (f)) == (f))
+#define __HAL_ADC_CLEAR_FLAG(h, f)              (((h)->Instance->SR) &= ~(f))
+#define __HAL_ADC_ENABLE_IT(h, it)              (((h)->Instance->CR1) |= (it))
+#define __HAL_ADC_DISABLE_IT(h, it)             (((h)->Instance->CR1) &= ~(it))
+
+#define __HAL_DMA_GET_COUNTER(h)                ((h)->Instance->NDTR)
+#define __HAL_DMA_GET_HT_FLAG_INDEX(h)          DMA_FLAG_HTIF0_4
+#define __HAL_DMA_GET_TC_FLAG_INDEX(h)          DMA_FLAG_TCIF0_4
+#define __HAL_DMA_GET_FLAG(h, f)                ((sim_dma2.LISR & (f)) != 0u)
+
+/* ============================================================================
+ * Functions (sim_hal.c)
+ * ============================================================================ */
+void __disable_irq(void);
+void __enable_irq(void);
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t ms);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *data, uint32_t len);
+HAL_StatusTypeDef HAL_ADC_AnalogWDGConfig(ADC_HandleTypeDef *hadc, ADC_AnalogWDGConfTypeDef *cfg);
+uint32_t HAL_ADCEx_InjectedGetValue(ADC_HandleTypeDef *hadc, uint32_t rank);
+
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc);
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc);
+void HAL_ADC_LevelOutOfWindowCallback(ADC_HandleTypeDef *hadc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MAIN_H */
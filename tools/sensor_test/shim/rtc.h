@@ -0,0 +1,13 @@
+/**
+ * @file    rtc.h
+ * @brief   Host stand-in for the CubeMX rtc.h (tools/sensor_test)
+ */
+
+#ifndef __RTC_H__
+#define __RTC_H__
+
+#include "main.h"
+
+extern RTC_HandleTypeDef hrtc;
+
+#endif /* __RTC_H__ */
@@ -0,0 +1,262 @@
+/**
+ * @file    sim_hal.c
+ * @brief   Simulated ADC1/TIM2/DMA and HAL stubs, see sim_hal.h
+ */
+
+#include "sim_hal.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================================
+ * State
+ * ============================================================================ */
+TIM_TypeDef sim_tim2;
+RCC_TypeDef sim_rcc;
+ADC_TypeDef sim_adc1;
+DMA_Stream_TypeDef sim_dma2_stream0;
+DMA_TypeDef sim_dma2;
+
+DMA_HandleTypeDef hdma_adc1 = {DMA2_Stream0};
+ADC_HandleTypeDef hadc1 = {ADC1, &hdma_adc1};
+UART_HandleTypeDef huart1, huart2, huart3, huart6;
+DMA_HandleTypeDef hdma_usart1_rx, hdma_usart2_rx, hdma_usart3_rx, hdma_usart6_rx;
+RTC_HandleTypeDef hrtc;
+
+uint64_t sim_now_us;
+uint32_t sim_pclk1_hz = 42000000u;
+uint16_t sim_battery_code = 2048;
+long sim_conversions;
+long sim_irq_off_in_isr;
+int sim_in_isr;
+
+uint8_t sim_log[1u << 20];
+uint32_t sim_log_used;
+int sim_log_mounted = 1;
+
+long sim_uplink_count;
+char sim_uplink_last[256];
+char sim_console_last[256];
+
+static uint16_t *dma_buf;
+static uint32_t dma_len;
+static double next_conv_us = -1.0;     /* < 0: TIM2 not running */
+static void (*uplink_hook)(const char *line);
+
+void sim_init(void)
+{
+    memset(&sim_tim2, 0, sizeof(sim_tim2));
+    memset(&sim_adc1, 0, sizeof(sim_adc1));
+    memset(&sim_dma2, 0, sizeof(sim_dma2));
+    sim_dma2_stream0.NDTR = 0;
+    sim_rcc.CFGR = RCC_HCLK_DIV4;
+    sim_now_us = 0;
+    sim_conversions = 0;
+    sim_irq_off_in_isr = 0;
+    next_conv_us = -1.0;
+}
+
+/* ============================================================================
+ * Core and clocks
+ * ============================================================================ */
+void __disable_irq(void)
+{
+    if (sim_in_isr) {
+        sim_irq_off_in_isr++;
+    }
+}
+
+void __enable_irq(void)
+{
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return (uint32_t)(sim_now_us / 1000u);
+}
+
+void HAL_Delay(uint32_t ms)
+{
+    sim_now_us += (uint64_t)ms * 1000u;
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+    return sim_pclk1_hz;
+}
+
+double sim_tim2_period_us(void)
+{
+    uint32_t clk = sim_pclk1_hz;
+
+    if (!(sim_tim2.CR1 & TIM_CR1_CEN)) {
+        return 0.0;
+    }
+    if ((sim_rcc.CFGR & RCC_CFGR_PPRE1) != RCC_HCLK_DIV1) {
+        clk *= 2u;
+    }
+    return (double)(sim_tim2.PSC + 1u) * (double)(sim_tim2.ARR + 1u) * 1e6 / clk;
+}
+
+/* TIM2 register writes take effect here: UG restarts the period */
+static void tim2_sync(void)
+{
+    if (!(sim_tim2.CR1 & TIM_CR1_CEN)) {
+        next_conv_us = -1.0;
+        return;
+    }
+    if ((sim_tim2.EGR & TIM_EGR_UG) || next_conv_us < 0.0) {
+        sim_tim2.EGR = 0;
+        next_conv_us = (double)sim_now_us + sim_tim2_period_us();
+    }
+}
+
+/* ============================================================================
+ * ADC1 and DMA2 stream 0
+ * ============================================================================ */
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *data, uint32_t len)
+{
+    (void)hadc;
+    dma_buf = (uint16_t *)data;
+    dma_len = len;
+    sim_dma2_stream0.NDTR = len;
+    sim_dma2.LISR = 0;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_AnalogWDGConfig(ADC_HandleTypeDef *hadc, ADC_AnalogWDGConfTypeDef *cfg)
+{
+    hadc->Instance->HTR = cfg->HighThreshold;
+    hadc->Instance->LTR = cfg->LowThreshold;
+    if (cfg->ITMode == ENABLE) {
+        __HAL_ADC_ENABLE_IT(hadc, ADC_IT_AWD);
+    } else {
+        __HAL_ADC_DISABLE_IT(hadc, ADC_IT_AWD);
+    }
+    return HAL_OK;
+}
+
+uint32_t HAL_ADCEx_InjectedGetValue(ADC_HandleTypeDef *hadc, uint32_t rank)
+{
+    (void)hadc;
+    (void)rank;
+    return sim_battery_code;
+}
+
+/* Injected group: a software start completes before the next task run */
+static void injected_sync(void)
+{
+    if (sim_adc1.CR2 & ADC_CR2_JSWSTART) {
+        sim_adc1.CR2 &= ~ADC_CR2_JSWSTART;
+        sim_adc1.SR |= ADC_SR_JEOC | ADC_SR_JSTRT;
+    }
+}
+
+static void convert(uint16_t code)
+{
+    uint32_t flags;
+
+    sim_conversions++;
+    if (dma_buf != NULL && dma_len > 0u) {
+        dma_buf[dma_len - sim_dma2_stream0.NDTR] = code;
+        if (--sim_dma2_stream0.NDTR == dma_len / 2u) {
+            sim_dma2.LISR |= DMA_FLAG_HTIF0_4;
+        } else if (sim_dma2_stream0.NDTR == 0u) {
+            sim_dma2.LISR |= DMA_FLAG_TCIF0_4;
+            sim_dma2_stream0.NDTR = dma_len;            /* Circular */
+        }
+    }
+
+    sim_in_isr = 1;
+    if (code > sim_adc1.HTR || code < sim_adc1.LTR) {
+        sim_adc1.SR |= ADC_SR_AWD;
+    }
+    /* HAL_ADC_IRQHandler: watchdog callback when its interrupt is enabled */
+    if ((sim_adc1.SR & ADC_SR_AWD) && (sim_adc1.CR1 & ADC_CR1_AWDIE)) {
+        HAL_ADC_LevelOutOfWindowCallback(&hadc1);
+        sim_adc1.SR &= ~ADC_SR_AWD;
+    }
+    /* HAL_DMA_IRQHandler: flags cleared before the callback */
+    flags = sim_dma2.LISR;
+    sim_dma2.LISR = 0;
+    if (flags & DMA_FLAG_HTIF0_4) {
+        HAL_ADC_ConvHalfCpltCallback(&hadc1);
+    }
+    if (flags & DMA_FLAG_TCIF0_4) {
+        HAL_ADC_ConvCpltCallback(&hadc1);
+    }
+    sim_in_isr = 0;
+}
+
+void sim_adc_run(uint64_t until_us, SimSignal ch0)
+{
+    injected_sync();
+    tim2_sync();
+    while (next_conv_us >= 0.0 && next_conv_us <= (double)until_us) {
+        double t = next_conv_us;
+
+        sim_now_us = (uint64_t)t;
+        next_conv_us = t + sim_tim2_period_us();
+        convert(ch0(t * 1e-6));
+        tim2_sync();                                    /* Rate change in a callback */
+    }
+    sim_now_us = until_us;
+}
+
+/* ============================================================================
+ * Output
+ * ============================================================================ */
+uint32_t rtc_get_timestamp(void)
+{
+    return 844000000u + (uint32_t)(sim_now_us / 1000000u);  /* Oct 2026 */
+}
+
+uint8_t storage_append(const void *data, uint16_t len)
+{
+    if (!sim_log_mounted || sim_log_used + 2u + len > sizeof(sim_log)) {
+        return 0;
+    }
+    sim_log[sim_log_used] = (uint8_t)len;
+    sim_log[sim_log_used + 1u] = (uint8_t)(len >> 8);
+    memcpy(&sim_log[sim_log_used + 2u], data, len);
+    sim_log_used += 2u + len;
+    return 1;
+}
+
+void sim_uplink_hook(void (*fn)(const char *line))
+{
+    uplink_hook = fn;
+}
+
+void uplink_printf(const char *format, ...)
+{
+    va_list ap;
+
+    va_start(ap, format);
+    vsnprintf(sim_uplink_last, sizeof(sim_uplink_last), format, ap);
+    va_end(ap);
+    sim_uplink_count++;
+    if (uplink_hook != NULL) {
+        uplink_hook(sim_uplink_last);
+    }
+    if (getenv("SIM_VERBOSE") != NULL) {
+        fputs(sim_uplink_last, stdout);
+    }
+}
+
+int my_printf(UART_HandleTypeDef *huart, const char *format, ...)
+{
+    va_list ap;
+    int n;
+
+    (void)huart;
+    va_start(ap, format);
+    n = vsnprintf(sim_console_last, sizeof(sim_console_last), format, ap);
+    va_end(ap);
+    if (getenv("SIM_VERBOSE") != NULL) {
+        fputs(sim_console_last, stdout);
+    }
+    return n;
+}
@@ -0,0 +1,52 @@
+/**
+ * @file    sim_hal.h
+ * @brief   Simulated ADC1/TIM2/DMA for the App-level sensor tests
+ * @details App/adc_app.c programs TIM2 and starts ADC1 in circular DMA
+ *          exactly as on the target; sim_adc_run() then plays conversions
+ *          at the period TIM2 was programmed with (PSC/ARR and the APB1
+ *          timer clock), writes them into the DMA buffer and raises the
+ *          interrupts the target would: the ADC analog watchdog, then DMA
+ *          half/full transfer. ADC_IRQn is numbered below DMA2_Stream0_IRQn
+ *          and both run at priority 0, so when one conversion raises both,
+ *          the watchdog callback runs first with the DMA flag still set.
+ *
+ *          Time is virtual: sim_now_us only moves inside sim_adc_run().
+ *          uplink_printf(), my_printf() and the sample log appends of
+ *          storage_append() are captured here too.
+ */
+
+#ifndef __SIM_HAL_H__
+#define __SIM_HAL_H__
+
+#include "main.h"
+
+/* CH0 code converted at time t_s (seconds since sim_init) */
+typedef uint16_t (*SimSignal)(double t_s);
+
+extern uint64_t sim_now_us;         /* Virtual clock */
+extern uint32_t sim_pclk1_hz;       /* APB1 clock, 42 MHz (HCLK / 4) */
+extern uint16_t sim_battery_code;   /* CH1 injected conversions */
+extern long sim_conversions;        /* CH0 conversions so far */
+extern long sim_irq_off_in_isr;     /* __disable_irq() calls from interrupt context */
+extern int sim_in_isr;
+
+extern uint8_t sim_log[1u << 20];  /* storage_append() records, [u16 len][payload] each */
+extern uint32_t sim_log_used;
+extern int sim_log_mounted;         /* 0: storage_append() fails, as with no flash */
+
+extern long sim_uplink_count;       /* uplink_printf() calls */
+extern char sim_uplink_last[256];
+extern char sim_console_last[256];
+
+void sim_init(void);
+
+/* Convert CH0 until sim_now_us reaches until_us, raising the interrupts */
+void sim_adc_run(uint64_t until_us, SimSignal ch0);
+
+/* Trigger period TIM2 is programmed for, in microseconds (0 if stopped) */
+double sim_tim2_period_us(void);
+
+/* Every uplink_printf() line, NULL to stop */
+void sim_uplink_hook(void (*fn)(const char *line));
+
+#endif /* __SIM_HAL_H__ */
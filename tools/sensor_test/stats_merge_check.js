@@ -0,0 +1,57 @@
+/**
+ * Merges test_run_stats's STAT lines with the server's code and compares
+ * the result with the two-pass reference on all samples.
+ *   node stats_merge_check.js <stat_lines.txt> <stat_expected.txt>
+ * stat_expected.txt: "<channel> <count> <mean> <variance> <min> <max>".
+ */
+
+const fs = require('fs');
+const path = require('path');
+const { parseStat, mergeStats, stdDev, StatsMerger } = require(path.join(__dirname, '../../上云/server/stats.js'));
+
+const [linesPath, expectedPath] = process.argv.slice(2);
+const lines = fs.readFileSync(linesPath, 'utf8').split('\n').filter((l) => l.length > 0);
+const [name, count, mean, variance, min, max] = fs.readFileSync(expectedPath, 'utf8').trim().split(' ');
+const want = { count: Number(count), mean: Number(mean), variance: Number(variance), min: Number(min), max: Number(max) };
+
+let merged = null;
+let windows = 0;
+let bad = 0;
+// Every window in one period, so the merger must agree with a plain fold
+const merger = new StatsMerger(1e9);
+let period = null;
+
+lines.forEach((line, i) => {
+    const s = parseStat(line);
+    if (!s) {
+        console.log('not a STAT line:', JSON.stringify(line));
+        bad++;
+        return;
+    }
+    if (s.name === name) {
+        merged = mergeStats(merged, s);
+        period = merger.add('dev', s, 836000000 + i).summary;
+        windows++;
+    }
+});
+
+const got = merged.m2 / (merged.count - 1);
+const relMean = Math.abs(merged.mean - want.mean) / Math.abs(want.mean);
+const relVar = Math.abs(got - want.variance) / want.variance;
+console.log(`server merge: ${windows} windows, var ref ${want.variance.toPrecision(6)}, ` +
+            `merged ${got.toPrecision(6)} (std ${stdDev(merged).toPrecision(6)}), ` +
+            `rel err mean ${relMean.toExponential(1)} var ${relVar.toExponential(1)}`);
+
+if (merged.count !== want.count || relMean > 1e-6 || relVar > 2e-2 ||
+    merged.min !== want.min || merged.max !== want.max) {
+    bad++;
+}
+if (period.count !== merged.count || period.mean !== merged.mean || period.m2 !== merged.m2) {
+    console.log('StatsMerger differs from the fold');
+    bad++;
+}
+// A window of 0 samples (an idle channel) changes nothing
+if (mergeStats(merged, { count: 0, mean: 0, m2: 0, min: 0, max: 0 }).min !== merged.min) {
+    bad++;
+}
+process.exit(bad ? 1 : 0);
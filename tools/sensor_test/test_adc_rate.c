@@ -0,0 +1,92 @@
+/**
+ * @file    test_adc_rate.c
+ * @brief   TIM2-paced ADC1: period rounding, achieved rate, DMA blocks
+ * @details adc_set_sample_rate() over rates from 1 Hz to 1 MHz, checked on
+ *          the TIM2 registers (no prescaler, period to the nearest timer
+ *          clock tick), on the rate reported back and on the conversions
+ *          the simulated ADC actually makes in 2 s of virtual time; then
+ *          the timer clock with APB1 undivided, and the injected battery
+ *          channel collected by adc_task().
+ */
+
+#include "sensor_test.h"
+#include "sim_hal.h"
+#include "define.h"
+
+extern __IO uint32_t adc_val_ch1;
+
+static uint16_t flat(double t_s)
+{
+    (void)t_s;
+    return 1000;
+}
+
+int main(int argc, char **argv)
+{
+    static const uint32_t rates[] = {1, 10, 250, 333, 1000, 3000, 7000, 44100, 333333, 1000000};
+    const uint32_t clk = 84000000u;     /* PCLK1 42 MHz, doubled for TIM2 */
+    uint32_t i, period;
+
+    test_seed(argc, argv);
+    sim_init();
+    adc_dma_init();
+
+    CHECK(TIM2->CR1 & TIM_CR1_CEN);
+    CHECK(TIM2->CR1 & TIM_CR1_ARPE);
+    CHECK((TIM2->CR2 & TIM_CR2_MMS) == TIM_CR2_MMS_1);     /* TRGO on update */
+    CHECK(TIM2->PSC == 0u);
+
+    printf("%8s %10s %14s %10s %10s\n", "rate", "ticks", "achieved", "err ppm", "conv/2s");
+    for (i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        long before, got, want;
+        double achieved, err;
+
+        adc_set_sample_rate(rates[i]);
+        period = (clk + rates[i] / 2u) / rates[i];
+        achieved = adc_get_sample_rate_hz();
+        err = (achieved - rates[i]) / rates[i] * 1e6;
+
+        CHECK(TIM2->ARR == period - 1u);
+        CHECK(adc_get_sample_period_ticks() == period);
+        /* Reported: what the registers give, not what was asked for */
+        CHECK(fabs(achieved - (double)clk / period) < 1e-6 * achieved);
+        /* Nearest timer tick: off by at most half a tick */
+        CHECK(fabs((double)clk / rates[i] - period) <= 0.5 + 1e-9);
+        CHECK(fabs(err) <= 0.5e6 / period + 1.0);
+        CHECK(fabs(sim_tim2_period_us() - period * 1e6 / clk) < 1e-6);
+
+        before = sim_conversions;
+        sim_adc_run(sim_now_us + 2000000u, flat);
+        got = sim_conversions - before;
+        want = (long)(2.0 * achieved);
+        CHECK(labs(got - want) <= 1);
+        printf("%8lu %10lu %14.3f %10.1f %10ld\n", (unsigned long)rates[i],
+               (unsigned long)period, achieved, err, got);
+    }
+
+    /* Out of range: ignored, the last rate stays */
+    adc_set_sample_rate(0);
+    CHECK(adc_get_sample_period_ticks() == 84u);
+    adc_set_sample_rate(clk / 2u + 1u);
+    CHECK(adc_get_sample_period_ticks() == 84u);
+
+    /* APB1 undivided: the timer runs at PCLK1, not twice it */
+    sim_rcc.CFGR = RCC_HCLK_DIV1;
+    adc_set_sample_rate(1000);
+    CHECK(TIM2->PSC == 0u && TIM2->ARR == 41999u);
+    CHECK(fabs(sim_tim2_period_us() - 1000.0) < 1e-9);
+    CHECK(fabs(adc_get_sample_rate_hz() - 1000.0) < 1e-3);
+    sim_rcc.CFGR = RCC_HCLK_DIV4;
+
+    /* Battery: injected group started by one adc_task, read by the next */
+    sim_battery_code = 3000;
+    for (i = 0; i < 40; i++) {
+        sim_adc_run(sim_now_us + 1000000u, flat);
+        adc_task();
+    }
+    printf("battery code %lu after 40 task runs (converting %u)\n",
+           (unsigned long)adc_val_ch1, sim_battery_code);
+    CHECK(labs((long)adc_val_ch1 - 3000) <= 2);
+
+    return test_finish();
+}
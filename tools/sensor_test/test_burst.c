@@ -0,0 +1,274 @@
+/**
+ * @file    test_burst.c
+ * @brief   Burst capture: rate labels, in-flight blocks, storage before release
+ * @details The simulated ADC runs the real adc_app.c/burst_app.c under the
+ *          firmware schedule (adc_poll every 1 ms, burst_task every 100 ms,
+ *          adc_task every 1 s) while CH0 steps above the trigger level in
+ *          short pulses. Each pulse starts a little later in the DMA block
+ *          than the last, so the trigger also lands on the conversion that
+ *          completes a half block (DMA flag pending in the watchdog ISR).
+ *
+ *          Every conversion is logged with its time, so each capture can be
+ *          located in the conversion stream and checked: contiguous, the
+ *          pre-trigger segment ends with the triggering conversion and is
+ *          spaced at pre_rate_hz throughout, the window at rate_hz, and no
+ *          window-rate conversion leaks into the next capture's history.
+ *          The sample log must hold every capture before its BURST line is
+ *          sent; with the log unmounted the capture is given up, not kept.
+ */
+
+#include "sensor_test.h"
+#include "sim_hal.h"
+#include "define.h"
+
+#define NPULSE      40
+#define PULSE_US    200000u
+#define MAX_CONV    400000
+
+static uint64_t pulse_us[NPULSE + 1];   /* last one with the log unmounted */
+static uint16_t trig_code;
+static long block;                      /* CH0 conversions per DMA half */
+
+static uint64_t conv_us[MAX_CONV];
+static uint16_t conv_code[MAX_CONV];
+static long nconv;
+
+static burst_capture_t snap[NPULSE + 1];
+static int nsnap;
+
+static int nlines;
+static uint32_t line_log_used[NPULSE + 1];
+static unsigned line_pre[NPULSE + 1], line_count[NPULSE + 1];
+
+static uint16_t pulses(double t_s)
+{
+    uint64_t t = (uint64_t)llround(t_s * 1e6);
+    int high = 0, k;
+    int code;
+
+    for (k = 0; k <= NPULSE; k++) {
+        if (t >= pulse_us[k] && t < pulse_us[k] + PULSE_US) {
+            high = 1;
+        }
+    }
+    code = trig_code + (high ? 300 : -400) + rand() % 81 - 40;
+    if (nconv < MAX_CONV) {
+        conv_us[nconv] = t;
+        conv_code[nconv] = (uint16_t)code;
+        nconv++;
+    }
+    return (uint16_t)code;
+}
+
+static void on_uplink(const char *line)
+{
+    unsigned long tick;
+    unsigned pre, pre_rate, count, rate, peak;
+
+    if (sscanf(line, "BURST,%lu,%u,%u,%u,%u,%u", &tick, &pre, &pre_rate, &count,
+               &rate, &peak) == 6 && nlines <= NPULSE) {
+        line_log_used[nlines] = sim_log_used;
+        line_pre[nlines] = pre;
+        line_count[nlines] = count;
+        nlines++;
+    }
+}
+
+/* Oldest queued capture, copied once while it waits for storage */
+static void snapshot(void)
+{
+    const burst_capture_t *b = burst_peek();
+
+    if (b != NULL && (nsnap == 0 || snap[nsnap - 1].tick != b->tick) && nsnap <= NPULSE) {
+        snap[nsnap++] = *b;
+    }
+}
+
+/* First conversion at or after t */
+static long conv_at(uint64_t t)
+{
+    long i;
+
+    for (i = 0; i < nconv; i++) {
+        if (conv_us[i] >= t) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void check_captures(int *in_flight, int *reach_back)
+{
+    long prev_end = -1;
+    int k;
+
+    for (k = 0; k < NPULSE; k++) {
+        const burst_capture_t *b = &snap[k];
+        long trig = conv_at(pulse_us[k]);
+        long first = trig - b->pre_count + 1;
+        int i, bad = 0;
+        uint16_t peak = 0;
+
+        CHECK(b->pre_rate_hz == ADC_SAMPLE_RATE_HZ && b->rate_hz == BURST_RATE_HZ);
+        CHECK(b->count == BURST_SAMPLES && b->pre_count <= BURST_PRE_SAMPLES);
+        CHECK(b->trigger_code == trig_code);
+        CHECK(b->tick == conv_us[trig] / 1000u);
+        if (trig < 0 || first < 1 || trig + BURST_SAMPLES >= nconv) {
+            CHECK(0);
+            continue;
+        }
+
+        /* The same conversions, in order, with nothing missing */
+        for (i = 0; i < b->pre_count + b->count; i++) {
+            bad += (b->samples[i] != conv_code[first + i]);
+        }
+        CHECK(bad == 0);
+
+        /* Pre-trigger: idle spacing from the conversion before it on, and
+           not reaching into the previous window */
+        for (i = 0; i < b->pre_count; i++) {
+            bad += (conv_us[first + i] - conv_us[first + i - 1] != 1000000u / ADC_SAMPLE_RATE_HZ);
+        }
+        CHECK(bad == 0);
+        CHECK(first > prev_end);
+        CHECK(b->pre_count == BURST_PRE_SAMPLES || prev_end < 0 ||
+              conv_us[first] - conv_us[prev_end] <= 1000000u / ADC_SAMPLE_RATE_HZ * (uint64_t)(block + 1));
+        *reach_back += (prev_end >= 0 && b->pre_count < BURST_PRE_SAMPLES);
+
+        /* Window: the first conversion one window period after the trigger */
+        for (i = 0; i < b->count; i++) {
+            bad += (conv_us[trig + 1 + i] - conv_us[trig + i] != 1000000u / BURST_RATE_HZ);
+            if (conv_code[trig + 1 + i] > peak) {
+                peak = conv_code[trig + 1 + i];
+            }
+        }
+        CHECK(bad == 0);
+        CHECK(b->peak == peak);
+
+        /* Trigger on the conversion completing a half block */
+        *in_flight += (trig % block == block - 1);
+        prev_end = trig + b->count;
+    }
+}
+
+static void check_log(void)
+{
+    uint32_t pos = 0;
+    int k = -1, i;
+    uint16_t next = 0, total = 0;
+    int bad = 0;
+
+    while (pos < sim_log_used) {
+        uint16_t len = (uint16_t)(sim_log[pos] | (sim_log[pos + 1] << 8));
+        const uint8_t *p = &sim_log[pos + 2];
+        burst_rec_hdr_t hdr;
+
+        memcpy(&hdr, p, sizeof(hdr));
+        bad += (hdr.magic != BURST_REC_MAGIC);
+        if (len == sizeof(burst_rec_head_t) && hdr.kind == BURST_REC_HEAD) {
+            burst_rec_head_t head;
+
+            bad += (k >= 0 && next != total);       /* previous one complete */
+            memcpy(&head, p, sizeof(head));
+            k++;
+            bad += (k >= NPULSE || hdr.id != k);
+            if (k < NPULSE) {
+                bad += (head.tick != snap[k].tick || head.pre_count != snap[k].pre_count ||
+                        head.count != snap[k].count || head.peak != snap[k].peak ||
+                        head.pre_rate_hz != snap[k].pre_rate_hz ||
+                        head.rate_hz != snap[k].rate_hz ||
+                        head.trigger_code != snap[k].trigger_code);
+                total = (uint16_t)(snap[k].pre_count + snap[k].count);
+            }
+            next = 0;
+        } else if (len == sizeof(burst_rec_data_t) && hdr.kind == BURST_REC_DATA && k >= 0 && k < NPULSE) {
+            burst_rec_data_t rec;
+
+            memcpy(&rec, p, sizeof(rec));
+            bad += (hdr.id != k || hdr.first != next);
+            for (i = 0; i < BURST_REC_SAMPLES; i++) {
+                int16_t want = (next + i < total) ? snap[k].samples[next + i] : 0;
+                bad += (rec.samples[i] != want);
+            }
+            next = (uint16_t)(next + BURST_REC_SAMPLES < total ? next + BURST_REC_SAMPLES : total);
+            /* Complete before its BURST line went out */
+            bad += (next == total && pos + 2u + len > line_log_used[k]);
+        } else {
+            bad++;
+        }
+        pos += 2u + len;
+    }
+    CHECK(bad == 0);
+    CHECK(k == NPULSE - 1 && next == total);
+    printf("log: %d captures in %lu bytes, %d-byte head + %d-byte data records\n",
+           k + 1, (unsigned long)sim_log_used, (int)sizeof(burst_rec_head_t),
+           (int)sizeof(burst_rec_data_t));
+}
+
+int main(int argc, char **argv)
+{
+    char *cmd[] = {"burst"};
+    uint64_t end, ms;
+    int k, in_flight = 0, reach_back = 0;
+    unsigned long stored, failed;
+
+    test_seed(argc, argv);
+    CHECK(sizeof(burst_rec_head_t) == 28 && sizeof(burst_rec_data_t) == 252);
+
+    /* 4 to 5.6 s apart, stepping through the 16 positions in a DMA half */
+    pulse_us[0] = 10000000u;
+    for (k = 1; k < NPULSE; k++) {
+        pulse_us[k] = pulse_us[k - 1] + 4000000u + (k % 4) * 500000u + (k * 20300u) % 64000u;
+    }
+    pulse_us[NPULSE] = pulse_us[NPULSE - 1] + 6000000u;
+    end = pulse_us[NPULSE] + 5000000u;
+
+    sim_init();
+    sim_uplink_hook(on_uplink);
+    adc_dma_init();
+    trig_code = (uint16_t)hadc1.Instance->HTR;
+    block = (long)(sim_dma2_stream0.NDTR / 2u);
+    CHECK(trig_code > 400 && trig_code < 4095 - 340);
+    CHECK(fabs(adc_get_sample_rate_hz() - ADC_SAMPLE_RATE_HZ) < 1e-3);
+    printf("trigger %.1f ppm = code %u, idle %d Hz, window %d Hz\n",
+           burst_get_trigger_ppm(), trig_code, ADC_SAMPLE_RATE_HZ, BURST_RATE_HZ);
+
+    for (ms = 1; ms * 1000u <= end; ms++) {
+        if (ms * 1000u >= pulse_us[NPULSE] - 1000000u) {
+            sim_log_mounted = 0;
+        }
+        sim_adc_run(ms * 1000u, pulses);
+        adc_poll();
+        if (ms % 100u == 0) {
+            snapshot();
+            burst_task();
+        }
+        if (ms % 1000u == 0) {
+            adc_task();
+        }
+    }
+
+    CHECK(nsnap == NPULSE + 1);
+    CHECK(nlines == NPULSE + 1);
+    CHECK(burst_peek() == NULL);
+    CHECK(fabs(adc_get_sample_rate_hz() - ADC_SAMPLE_RATE_HZ) < 1e-3);
+    CHECK(sim_irq_off_in_isr == 0);
+    for (k = 0; k < nlines && k < nsnap; k++) {
+        CHECK(line_pre[k] == snap[k].pre_count && line_count[k] == snap[k].count);
+    }
+
+    check_captures(&in_flight, &reach_back);
+    printf("captures: %d, %d triggered on a half-block end, %d with history back to the last window\n",
+           NPULSE, in_flight, reach_back);
+    CHECK(in_flight > 0 && reach_back > 0);
+    check_log();
+
+    /* Unmounted log: the last capture was given up and its slot freed */
+    burst_cmd(1, cmd);
+    CHECK(sscanf(sim_console_last, "burst: %lu stored in the log, %lu not stored",
+                 &stored, &failed) == 2);
+    CHECK(stored == NPULSE && failed == 1);
+    printf("%s", sim_console_last);
+
+    return test_finish();
+}
@@ -0,0 +1,225 @@
+/**
+ * @file    test_dsp_filter.c
+ * @brief   dsp_filter kernels: SIMD/reference equivalence and filter behaviour
+ * @details Built twice: test_dsp_filter with the portable kernels and
+ *          test_dsp_filter_simd with -D__ARM_FEATURE_DSP=1 and the host
+ *          intrinsics of shim/cmsis_simd.h, so the __SMLAD/__SMLALD paths
+ *          run here. In both, DSP_SumQ15 and DSP_BiquadQ15_Process must
+ *          match their *_Ref twins bit for bit (output and carried state)
+ *          on random blocks of every length up to 67, full-scale and
+ *          saturating input included. Then the filters themselves: biquad
+ *          DC pass-through with no dead band down to fc/fs = 0.005, median
+ *          spike rejection, moving averages against exact rounded means,
+ *          EMA convergence.
+ */
+
+#include "sensor_test.h"
+#include "dsp_filter.h"
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define PATH    "SIMD"
+#else
+#define PATH    "portable"
+#endif
+
+#define BLOCK_MAX   67
+
+static int16_t rand_q15(int full_scale)
+{
+    if (full_scale) {
+        return (int16_t)((rand() & 1) ? 32767 - rand() % 4 : -32768 + rand() % 4);
+    }
+    return (int16_t)(rand() % 65536 - 32768);
+}
+
+static int same_state(const DSP_BiquadQ15 *a, const DSP_BiquadQ15 *b)
+{
+    return a->x1 == b->x1 && a->x2 == b->x2 && a->y1 == b->y1 &&
+           a->y2 == b->y2 && a->err == b->err;
+}
+
+static void equivalence(void)
+{
+    static const float designs[][2] = {{20, 250}, {20, 1000}, {5, 1000}, {100, 1000}, {300, 1000}};
+    int16_t in[BLOCK_MAX], o1[BLOCK_MAX], o2[BLOCK_MAX];
+    long blocks = 0, diffs = 0;
+    unsigned d;
+    uint32_t n;
+    int round, i;
+
+    for (round = 0; round < 2000; round++) {
+        for (n = 0; n <= BLOCK_MAX; n++) {
+            for (i = 0; i < (int)n; i++) {
+                in[i] = rand_q15(round % 4 == 3);
+            }
+            CHECK(DSP_SumQ15(in, n) == DSP_SumQ15_Ref(in, n));
+        }
+    }
+
+    for (d = 0; d < sizeof(designs) / sizeof(designs[0]); d++) {
+        DSP_BiquadQ15 a, b;
+
+        DSP_BiquadQ15_InitLowpass(&a, designs[d][0], designs[d][1]);
+        b = a;
+        for (round = 0; round < 4000; round++) {
+            int full = (round % 50) >= 45;      /* Bursts of saturating input */
+            int level = rand() % 40000 - 20000;
+
+            n = (uint32_t)(rand() % (BLOCK_MAX + 1));
+            for (i = 0; i < (int)n; i++) {
+                int v = full ? rand_q15(1) : level + rand() % 2001 - 1000;
+                in[i] = (int16_t)(v > 32767 ? 32767 : v < -32768 ? -32768 : v);
+            }
+            DSP_BiquadQ15_Process(&a, in, o1, n);
+            DSP_BiquadQ15_Process_Ref(&b, in, o2, n);
+            diffs += memcmp(o1, o2, n * sizeof(int16_t)) != 0;
+            diffs += !same_state(&a, &b);
+            blocks++;
+        }
+    }
+    CHECK(diffs == 0);
+    printf("%s kernels: %ld biquad blocks and %d sums match the reference (%ld differ)\n",
+           PATH, blocks, 2000 * (BLOCK_MAX + 1), diffs);
+}
+
+/*
+ * A constant input settles on itself: no dead band. The carried rounding
+ * residue may leave a +-1 LSB limit cycle, but the block mean is exact.
+ */
+static void dc_gain(void)
+{
+    static const float ratios[] = {0.005f, 0.02f, 0.08f, 0.25f};
+    static const int16_t levels[] = {1, 7, 1000, 3001, 32760, -5, -12345};
+    int16_t buf[256];
+    unsigned r, l;
+    int worst = 0, cycles = 0, i, k;
+
+    for (r = 0; r < sizeof(ratios) / sizeof(ratios[0]); r++) {
+        for (l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+            DSP_BiquadQ15 f;
+            long sum = 0;
+
+            DSP_BiquadQ15_InitLowpass(&f, ratios[r] * 1000.0f, 1000.0f);
+            for (k = 0; k < 41; k++) {          /* 10496 samples */
+                for (i = 0; i < 256; i++) {
+                    buf[i] = levels[l];
+                }
+                DSP_BiquadQ15_Process(&f, buf, buf, 256);
+            }
+            for (i = 0; i < 256; i++) {
+                int e = abs(buf[i] - levels[l]);
+                worst = (e > worst) ? e : worst;
+                cycles += (e != 0);
+                sum += buf[i] - levels[l];
+            }
+            CHECK(labs(sum) <= 1);
+        }
+    }
+    CHECK(worst <= 1);
+    printf("biquad DC: worst settled error %d LSB (%d of %d samples off), mean exact, fc/fs 0.005 .. 0.25\n",
+           worst, cycles, (int)(256 * sizeof(ratios) / sizeof(ratios[0]) * sizeof(levels) / sizeof(levels[0])));
+}
+
+static void median(void)
+{
+    static const int32_t spikes[] = {100, 101, 99, 5000, 100, 102, -4000, 98, 100, 7000, 7000, 101, 100};
+    DSP_Median m;
+    int32_t win[DSP_MEDIAN_MAX_LEN], sorted[DSP_MEDIAN_MAX_LEN];
+    int i, j, k, n, len;
+
+    /* Up to (len - 1) / 2 adjacent spikes never reach the output */
+    DSP_Median_Init(&m, 5);
+    for (i = 0; i < (int)(sizeof(spikes) / sizeof(spikes[0])); i++) {
+        int32_t y = DSP_Median_Update(&m, spikes[i]);
+        CHECK(y >= 98 && y <= 102);
+    }
+
+    /* Against a sorted window, random input, every odd length */
+    for (len = 1; len <= DSP_MEDIAN_MAX_LEN; len += 2) {
+        DSP_Median_Init(&m, (uint8_t)len);
+        for (i = 0; i < 2000; i++) {
+            int32_t x = rand() % 2001 - 1000, y = DSP_Median_Update(&m, x);
+
+            win[i % len] = x;
+            n = (i + 1 < len) ? i + 1 : len;
+            for (j = 0; j < n; j++) {
+                int32_t v = win[j];
+                for (k = j - 1; k >= 0 && sorted[k] > v; k--) {
+                    sorted[k + 1] = sorted[k];
+                }
+                sorted[k + 1] = v;
+            }
+            CHECK(y == sorted[n / 2]);
+        }
+    }
+}
+
+/* Round half away from zero, as the filters do */
+static long round_div(long long sum, int n)
+{
+    return (long)((sum + (sum >= 0 ? n / 2 : -(n / 2))) / n);
+}
+
+static void moving_average(void)
+{
+    int16_t h15[DSP_MOVAVG_MAX_LEN];
+    int32_t h31[DSP_MOVAVG_MAX_LEN];
+    int len, i, j, n;
+
+    for (len = 1; len <= DSP_MOVAVG_MAX_LEN; len++) {
+        DSP_MovAvgQ15 a;
+        DSP_MovAvgQ31 b;
+
+        DSP_MovAvgQ15_Init(&a, (uint16_t)len);
+        DSP_MovAvgQ31_Init(&b, (uint16_t)len);
+        for (i = 0; i < 500; i++) {
+            long long s15 = 0, s31 = 0;
+            int16_t x15 = rand_q15(i % 7 == 0);
+            int32_t x31 = (int32_t)((uint32_t)rand() << 8) - (1 << 30);
+            int16_t y15 = DSP_MovAvgQ15_Update(&a, x15);
+            int32_t y31 = DSP_MovAvgQ31_Update(&b, x31);
+
+            h15[i % len] = x15;
+            h31[i % len] = x31;
+            n = (i + 1 < len) ? i + 1 : len;
+            for (j = 0; j < n; j++) {
+                s15 += h15[j];
+                s31 += h31[j];
+            }
+            CHECK(y15 == round_div(s15, n));
+            CHECK(y31 == round_div(s31, n));
+        }
+    }
+}
+
+static void ema(void)
+{
+    DSP_EmaQ31 e;
+    int32_t y = 0;
+    int i, steps = -1;
+
+    /* alpha 0.1: first sample loads, a step reaches 63 % in ~10 samples */
+    DSP_EmaQ31_Init(&e, 3277);
+    CHECK(DSP_EmaQ31_Update(&e, 500) == 500);
+    for (i = 0; i < 400; i++) {
+        y = DSP_EmaQ31_Update(&e, 100500);
+        if (steps < 0 && y >= 500 + 63212) {
+            steps = i + 1;
+        }
+    }
+    CHECK(steps >= 9 && steps <= 11);
+    CHECK(abs(y - 100500) <= 5);
+    printf("EMA alpha 0.1: 63%% of a step after %d samples, settles at %ld\n",
+           steps, (long)y);
+}
+
+int main(int argc, char **argv)
+{
+    test_seed(argc, argv);
+    equivalence();
+    dc_gain();
+    median();
+    moving_average();
+    ema();
+    return test_finish();
+}
@@ -0,0 +1,113 @@
+/**
+ * @file    test_ethylene_lut.c
+ * @brief   Ethylene lookup table against the powf() curve
+ * @details For several R0 values every 12-bit code is converted both ways
+ *          (Ethylene_PPMFromCode / Ethylene_CalculatePPM on the same
+ *          voltage): the zero/non-zero decision must match on every code
+ *          and the relative error stay under the 1e-5 adc_app.c states.
+ *          Ethylene_CodeFromPPM must return the lowest code reaching the
+ *          level and Ethylene_PPMFromCodeHR must agree with the table on
+ *          whole codes and stay monotonic between them. Then the cost of
+ *          both paths per conversion.
+ */
+
+#include "sensor_test.h"
+#include "sim_hal.h"
+#include "define.h"
+
+#define HR_BITS     4
+
+static float code_voltage(uint16_t code)
+{
+    return ((float)code * 3.3f) / 4096.0f;      /* As adc_app.c */
+}
+
+static void sweep(float r0)
+{
+    static const float levels[] = {0.2f, 1.0f, 3.0f, 10.0f, 50.0f, 1e6f};
+    double max_rel = 0.0;
+    int mismatch = 0, nonzero = 0, drops = 0;
+    uint16_t code, first = 4096;
+    uint32_t hr;
+    unsigned i;
+
+    Ethylene_LUT_SetR0(r0);
+    for (code = 0; code < 4096; code++) {
+        float ref = Ethylene_CalculatePPM(code_voltage(code), r0);
+        float lut = Ethylene_PPMFromCode(code);
+
+        if ((ref == 0.0f) != (lut == 0.0f)) {
+            mismatch++;
+        } else if (ref != 0.0f) {
+            double rel = fabs((double)lut - ref) / ref;
+            max_rel = (rel > max_rel) ? rel : max_rel;
+            nonzero++;
+            first = (first == 4096) ? code : first;
+        }
+        CHECK(Ethylene_PPMFromCodeHR((uint32_t)code << HR_BITS, HR_BITS) == lut);
+        CHECK(Ethylene_PPMFromCodeHR(code, 0) == lut);
+    }
+    CHECK(mismatch == 0);
+    CHECK(max_rel < 1e-5);
+
+    /* Interpolated codes rise monotonically from the cut-off up */
+    for (hr = (uint32_t)first << HR_BITS; hr + 1u < (4095u << HR_BITS); hr++) {
+        float a = Ethylene_PPMFromCodeHR(hr, HR_BITS);
+        float b = Ethylene_PPMFromCodeHR(hr + 1u, HR_BITS);
+        drops += (b != 0.0f && b < a);          /* 0 past the top of the range */
+    }
+    CHECK(drops == 0);
+
+    /* Inverse: lowest code whose table PPM reaches the level */
+    for (i = 0; i < sizeof(levels) / sizeof(levels[0]); i++) {
+        uint16_t c = Ethylene_CodeFromPPM(levels[i]);
+        if (Ethylene_PPMFromCode(c) >= levels[i]) {
+            CHECK(c == 0 || Ethylene_PPMFromCode(c - 1u) < levels[i]);
+        } else {
+            CHECK(c == 4095);                   /* Out of reach */
+        }
+    }
+
+    printf("r0 %7.1f kohm: %4d codes > 0 ppm from %4u, max rel err %.2g, %d zero mismatches\n",
+           r0, nonzero, first, max_rel, mismatch);
+}
+
+int main(int argc, char **argv)
+{
+    static const float r0s[] = {105.2f, 10.0f, 50.0f, 300.0f, 1000.0f};
+    volatile float sink = 0.0f;
+    double t0, t_pow, t_lut;
+    unsigned i;
+    int n;
+
+    test_seed(argc, argv);
+    sim_init();
+
+    for (i = 0; i < sizeof(r0s) / sizeof(r0s[0]); i++) {
+        sweep(r0s[i]);
+    }
+
+    /* R0 unset: everything reads 0, the watchdog level is out of reach */
+    Ethylene_LUT_SetR0(0.0f);
+    for (n = 0; n < 4096; n++) {
+        CHECK(Ethylene_PPMFromCode((uint16_t)n) == 0.0f);
+    }
+    CHECK(Ethylene_CodeFromPPM(3.0f) == 4095);
+
+    /* Cost per conversion on the host, random codes */
+    Ethylene_LUT_SetR0(105.2f);
+    t0 = test_now_ns();
+    for (n = 0; n < 1000000; n++) {
+        sink += Ethylene_CalculatePPM(code_voltage((uint16_t)(rand() & 4095)), 105.2f);
+    }
+    t_pow = (test_now_ns() - t0) / 1e6;
+    t0 = test_now_ns();
+    for (n = 0; n < 1000000; n++) {
+        sink += Ethylene_PPMFromCode((uint16_t)(rand() & 4095));
+    }
+    t_lut = (test_now_ns() - t0) / 1e6;
+    printf("powf path %.1f ns, table %.1f ns per conversion (incl. rand)\n", t_pow, t_lut);
+    (void)sink;
+
+    return test_finish();
+}
@@ -0,0 +1,78 @@
+/**
+ * @file    test_oversample.c
+ * @brief   CH0 oversampling: error of adc_val_ch0 on a dithered ramp
+ * @details The simulated ADC converts a level rising 8 LSB over 400 s at
+ *          1 kHz, with 0.7 LSB of Gaussian noise as the dither. The real
+ *          adc_app.c chain (median, biquad on codes << 3, block decimator)
+ *          produces adc_val_ch0, read by adc_task() every 100 ms and
+ *          compared with the true level. Built once per output width:
+ *          test_oversample (ADC_OVERSAMPLE_BITS 2, the firmware setting),
+ *          test_oversample_12 (0) and test_oversample_16 (4).
+ */
+
+#include "sensor_test.h"
+#include "sim_hal.h"
+#include "define.h"
+
+#define RUN_S       400
+#define WARMUP_S    20
+#define SLOPE       0.02            /* LSB per second */
+#define NOISE       0.7             /* LSB rms */
+
+#if ADC_OVERSAMPLE_BITS == 0
+#define RMS_LIMIT   0.40
+#elif ADC_OVERSAMPLE_BITS == 2
+#define RMS_LIMIT   0.22
+#else
+#define RMS_LIMIT   0.08
+#endif
+
+static double level(double t_s)
+{
+    return 1000.0 + SLOPE * t_s;
+}
+
+static uint16_t ramp(double t_s)
+{
+    return (uint16_t)floor(level(t_s) + NOISE * test_gauss() + 0.5);
+}
+
+int main(int argc, char **argv)
+{
+    const double lsb = 1.0 / (1u << ADC_OVERSAMPLE_BITS);
+    double err2 = 0.0, raw2 = 0.0;
+    uint32_t prev = 0, changes = 0;
+    long n = 0;
+    uint64_t t;
+
+    test_seed(argc, argv);
+    sim_init();
+    adc_dma_init();
+    adc_set_sample_rate(1000);
+    adc_poll();
+
+    for (t = 100000; t <= (uint64_t)RUN_S * 1000000u; t += 100000) {
+        sim_adc_run(t, ramp);
+        adc_task();
+        if (t < (uint64_t)WARMUP_S * 1000000u) {
+            continue;
+        }
+        double e = adc_val_ch0 * lsb - level(t * 1e-6);
+        double r = ramp(t * 1e-6) - level(t * 1e-6);
+        err2 += e * e;
+        raw2 += r * r;
+        changes += (adc_val_ch0 != prev);
+        prev = adc_val_ch0;
+        n++;
+    }
+
+    double rms = sqrt(err2 / n);
+    printf("%d-bit output: rms error %.3f LSB12 (one raw conversion: %.3f), "
+           "%lu code changes over %.1f LSB12\n", ADC_CH0_BITS, rms, sqrt(raw2 / n),
+           (unsigned long)changes, SLOPE * (RUN_S - WARMUP_S));
+    CHECK(rms < RMS_LIMIT);
+    /* Moves in steps finer than 1 LSB12: more changes than 2^k-wide steps */
+    CHECK(changes >= (uint32_t)(SLOPE * (RUN_S - WARMUP_S) / lsb / 2.0));
+
+    return test_finish();
+}
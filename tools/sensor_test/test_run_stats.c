@@ -0,0 +1,235 @@
+/**
+ * @file    test_run_stats.c
+ * @brief   Welford running statistics, window merging and the STAT telemetry
+ * @details RunStats against a two-pass double reference on 100k samples
+ *          around 400 (a CO2-like channel) and around 1e4 with a spread of
+ *          1, where the textbook float sum(x^2) - n*mean^2 falls apart.
+ *          Per-minute summaries merged with RunStats_Merge must give the
+ *          single-pass result. Then stats_app.c: a timed window close and
+ *          "stats reset" both send one STAT line per channel carrying the
+ *          window that closed. Last, STAT lines from windows of random
+ *          length are merged by the server's code (stats_merge_check.js,
+ *          上云/server/stats.js under node) and compared with the two-pass
+ *          reference on all samples.
+ */
+
+#include "sensor_test.h"
+#include "sim_hal.h"
+#include "define.h"
+
+#define N   100000
+
+static float x[N];
+
+static void reference(const float *v, int n, double *mean, double *var)
+{
+    double m = 0.0, s = 0.0;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        m += v[i];
+    }
+    m /= n;
+    for (i = 0; i < n; i++) {
+        s += (v[i] - m) * (v[i] - m);
+    }
+    *mean = m;
+    *var = s / (n - 1);
+}
+
+static void accuracy(const char *name, double centre, double spread, double var_tol)
+{
+    RunStats all, window, merged;
+    double mean, var;
+    float sum = 0.0f, sum2 = 0.0f, naive;
+    int i, start;
+
+    for (i = 0; i < N; i++) {
+        x[i] = (float)(centre + spread * (rand() / (double)RAND_MAX - 0.5));
+    }
+    reference(x, N, &mean, &var);
+
+    RunStats_Reset(&all);
+    RunStats_Reset(&merged);
+    for (i = 0; i < N; i++) {
+        RunStats_Push(&all, x[i]);
+        sum += x[i];
+        sum2 += x[i] * x[i];
+    }
+    naive = (sum2 - sum * sum / N) / (N - 1);
+
+    /* Windows of random length, folded together as a receiver would */
+    for (start = 0; start < N; ) {
+        int len = 1 + rand() % 3000;
+        RunStats_Reset(&window);
+        for (i = start; i < N && i < start + len; i++) {
+            RunStats_Push(&window, x[i]);
+        }
+        RunStats_Merge(&merged, &window);
+        start += len;
+    }
+
+    printf("%s: var ref %.6g, welford %.6g, merged %.6g, float sum(x^2) %.6g\n",
+           name, var, RunStats_Variance(&all), RunStats_Variance(&merged), naive);
+    CHECK(all.count == N && merged.count == N);
+    CHECK(fabs(all.mean - mean) < 1e-5 * fabs(mean));
+    CHECK(fabs(merged.mean - mean) < 1e-5 * fabs(mean));
+    CHECK(fabs(RunStats_Variance(&all) - var) < var_tol * var);
+    CHECK(fabs(RunStats_Variance(&merged) - var) < var_tol * var);
+    CHECK(all.min == merged.min && all.max == merged.max);
+}
+
+static void edges(void)
+{
+    RunStats a, b;
+
+    RunStats_Reset(&a);
+    RunStats_Reset(&b);
+    CHECK(RunStats_Variance(&a) == 0.0f);
+    RunStats_Push(&a, 5.0f);
+    CHECK(RunStats_Variance(&a) == 0.0f && a.min == 5.0f && a.max == 5.0f);
+    RunStats_Merge(&a, &b);                 /* Empty source: unchanged */
+    CHECK(a.count == 1 && a.mean == 5.0f);
+    RunStats_Merge(&b, &a);                 /* Empty destination: copy */
+    CHECK(b.count == 1 && b.mean == 5.0f && b.min == 5.0f);
+    RunStats_Push(&a, 7.0f);
+    CHECK(a.mean == 6.0f && RunStats_Variance(&a) == 2.0f);
+}
+
+/* ============================================================================
+ * stats_app telemetry
+ * ============================================================================ */
+static int stat_lines;
+static unsigned long stat_count[STATS_CH_NUM];
+static double stat_mean[STATS_CH_NUM];
+
+static void on_uplink(const char *line)
+{
+    static const char *const names[STATS_CH_NUM] = {"c2h4", "batt", "etoh", "tvoc", "hcho", "co2"};
+    char name[8];
+    unsigned long count;
+    double mean;
+    int i;
+
+    if (sscanf(line, "STAT,%7[^,],%lu,%lf", name, &count, &mean) != 3) {
+        return;
+    }
+    for (i = 0; i < STATS_CH_NUM; i++) {
+        if (strcmp(name, names[i]) == 0) {
+            stat_count[i] = count;
+            stat_mean[i] = mean;
+            stat_lines++;
+        }
+    }
+}
+
+static void push_window(int n, float co2)
+{
+    int i;
+
+    for (i = 0; i < n; i++) {
+        stats_push(STATS_CH_CO2, co2 + (float)(i % 3));
+        stats_push(STATS_CH_ETHYLENE, 0.5f);
+    }
+}
+
+static void telemetry(void)
+{
+    char *reset[] = {"stats", "reset"};
+
+    sim_uplink_hook(on_uplink);
+
+    /* Timed close after STATS_WINDOW_MS */
+    push_window(60, 400.0f);
+    sim_now_us = (STATS_WINDOW_MS + 1u) * 1000ull;
+    stats_task();
+    CHECK(stat_lines == STATS_CH_NUM);
+    CHECK(stat_count[STATS_CH_CO2] == 60 && fabs(stat_mean[STATS_CH_CO2] - 401.0) < 1e-3);
+    CHECK(stat_count[STATS_CH_HCHO] == 0);
+
+    /* Console reset mid-window: the partial window is sent, not lost */
+    stat_lines = 0;
+    push_window(21, 800.0f);
+    sim_now_us += 20000000u;
+    stats_cmd(2, reset);
+    CHECK(stat_lines == STATS_CH_NUM);
+    CHECK(stat_count[STATS_CH_CO2] == 21 && fabs(stat_mean[STATS_CH_CO2] - 801.0) < 1e-3);
+    CHECK(stats_get_window(STATS_CH_CO2)->count == 21);
+    CHECK(stats_get_current(STATS_CH_CO2)->count == 0);
+    CHECK(strcmp(sim_console_last, "stats: window closed\r\n") == 0);
+
+    /* The next timed close counts from the reset */
+    stat_lines = 0;
+    push_window(5, 100.0f);
+    sim_now_us += (STATS_WINDOW_MS - 1000u) * 1000ull;
+    stats_task();
+    CHECK(stat_lines == 0);
+    sim_now_us += 2000000u;
+    stats_task();
+    CHECK(stat_lines == STATS_CH_NUM && stat_count[STATS_CH_CO2] == 5);
+    printf("telemetry: timed close and \"stats reset\" each sent %d STAT lines\n", STATS_CH_NUM);
+
+    sim_uplink_hook(NULL);
+}
+
+/* ============================================================================
+ * Server merge of STAT lines
+ * ============================================================================ */
+static FILE *stat_file;
+
+static void on_stat_line(const char *line)
+{
+    fputs(line, stat_file);
+}
+
+static void server_merge(double centre, double spread)
+{
+    FILE *ref = fopen("stat_expected.txt", "w");
+    double mean, var;
+    float lo = 1e30f, hi = -1e30f;
+    int i, start;
+
+    for (i = 0; i < N; i++) {
+        x[i] = (float)(centre + spread * (rand() / (double)RAND_MAX - 0.5));
+        lo = x[i] < lo ? x[i] : lo;
+        hi = x[i] > hi ? x[i] : hi;
+    }
+    reference(x, N, &mean, &var);
+    fprintf(ref, "co2 %d %.17g %.17g %.9g %.9g\n", N, mean, var, lo, hi);
+    fclose(ref);
+
+    stat_file = fopen("stat_lines.txt", "w");
+    sim_uplink_hook(on_stat_line);
+    for (start = 0; start < N; ) {
+        int len = 1 + rand() % 3000;
+        for (i = start; i < N && i < start + len; i++) {
+            stats_push(STATS_CH_CO2, x[i]);
+        }
+        sim_now_us += (STATS_WINDOW_MS + 1u) * 1000ull;
+        stats_task();
+        start += len;
+    }
+    sim_uplink_hook(NULL);
+    fclose(stat_file);
+
+    fflush(stdout);
+    if (system("node --version > /dev/null 2>&1") != 0) {
+        printf("server merge: SKIP, node not found\n");
+        return;
+    }
+    CHECK(system("node ../stats_merge_check.js stat_lines.txt stat_expected.txt") == 0);
+}
+
+int main(int argc, char **argv)
+{
+    test_seed(argc, argv);
+    sim_init();
+
+    accuracy("400 +- 10", 400.0, 20.0, 1e-3);
+    accuracy("1e4 +- 0.5", 1e4, 1.0, 2e-2);
+    edges();
+    telemetry();
+    server_merge(1e4, 1.0);
+
+    return test_finish();
+}
@@ -0,0 +1,224 @@
+/**
+ * @file    test_ts_codec.c
+ * @brief   ts_codec round trips and encode cost
+ * @details Round trips: random values of every width at block sizes
+ *          56..256, the shapes with no float and no channel at all,
+ *          erased-flash padding after the block, and a truncated block
+ *          failing cleanly. Benchmark: a synthetic day of 1 Hz samples
+ *          shaped like the board's channels, as storage_sample_to_record()
+ *          maps them (8 fixed-point ints, 2 floats), in 248-byte blocks.
+ *          Server decoder: writes ts_blocks.bin and ts_expected.txt and
+ *          runs ts_codec_check.js (上云/server/ts-codec.js) on them when
+ *          node is installed.
+ */
+
+#include "sensor_test.h"
+#include "ts_codec.h"
+
+#define DAY     86400
+#define LOG_REC 48                          /* storage_sample_t + flash_log header */
+
+static TsCodec_Record r[DAY];
+static TsCodec_Encoder enc;
+
+/* Drift of each channel around a typical value, the ADC voltage on 12 bits */
+static void day(int n, int jitter)
+{
+    double co2 = 600, tvoc = 0.12, hcho = 0.03, temp = 24.3, humi = 61.0;
+    double eth = 1.2, etv = 0.41, bat = 87.0;
+    uint32_t ts = 836000000u;
+    float v;
+    int k;
+
+    for (k = 0; k < n; k++) {
+        ts += 1u + ((jitter && rand() % 50 == 0) ? 1u : 0u);
+        co2 += test_gauss() * 2;
+        tvoc = fmax(0, tvoc + test_gauss() * 0.002);
+        hcho = fmax(0, hcho + test_gauss() * 0.0005);
+        temp += test_gauss() * 0.01;
+        humi += test_gauss() * 0.03;
+        eth = fmax(0, eth + test_gauss() * 0.01);
+        etv += test_gauss() * 0.002;
+        if (k % 600 == 0) {
+            bat -= 0.1;
+        }
+        memset(&r[k], 0, sizeof(r[k]));
+        r[k].timestamp = ts;
+        r[k].i[0] = (int32_t)lrint(co2);
+        r[k].i[1] = (int32_t)lrint(tvoc * 1000);
+        r[k].i[2] = (int32_t)lrint(hcho * 1000);
+        r[k].i[3] = (int32_t)lrint(temp * 10);
+        r[k].i[4] = (int32_t)lrint(humi * 10);
+        r[k].i[5] = (int32_t)lrint(eth * 100);
+        r[k].i[6] = (int32_t)lrint(bat * 10);
+        r[k].i[7] = eth > 5;
+        v = (float)(floor(etv / 3.3 * 4096) * 3.3 / 4096);
+        r[k].f[0] = v;
+        r[k].f[1] = (float)(v * v * 12.5);
+    }
+}
+
+/* Random full-width values, runs of repeats */
+static void adversarial(int n)
+{
+    uint32_t b;
+    int k, i;
+
+    for (k = 0; k < n; k++) {
+        if (k % 7 != 0) {
+            r[k] = r[k - 1];
+            continue;
+        }
+        memset(&r[k], 0, sizeof(r[k]));
+        r[k].timestamp = (uint32_t)rand() * (uint32_t)rand();
+        for (i = 0; i < TSCODEC_MAX_INT; i++) {
+            r[k].i[i] = (int32_t)(((uint32_t)rand() << (rand() % 24)) ^
+                                  ((rand() % 3) ? 0u : (uint32_t)rand()));
+        }
+        for (i = 0; i < TSCODEC_MAX_FLOAT; i++) {
+            b = (rand() % 4) ? ((uint32_t)rand() << 1) ^ (uint32_t)rand() : 0u;
+            memcpy(&r[k].f[i], &b, 4);
+        }
+    }
+}
+
+static int same(const TsCodec_Record *a, const TsCodec_Record *b, int ni, int nf)
+{
+    return a->timestamp == b->timestamp && memcmp(a->i, b->i, ni * sizeof(a->i[0])) == 0 &&
+           memcmp(a->f, b->f, nf * sizeof(a->f[0])) == 0;
+}
+
+/* Encode n records into blocks, decode each back; returns the block count */
+static int roundtrip(int n, int ni, int nf, uint16_t size, double *ns_per_rec, FILE *out)
+{
+    TsCodec_Decoder d;
+    TsCodec_Record o;
+    TsCodec_Status s;
+    uint8_t blk[TSCODEC_BLOCK_SIZE];
+    uint16_t used;
+    int k = 0, start, j, blocks = 0;
+    double ns = 0, t0;
+
+    CHECK(TsCodec_EncoderInit(&enc, (uint8_t)ni, (uint8_t)nf, size) == TSCODEC_OK);
+    while (k < n) {
+        start = k;
+        t0 = test_now_ns();
+        while (k < n) {
+            s = TsCodec_Add(&enc, &r[k]);
+            if (s == TSCODEC_FULL) {
+                break;
+            }
+            CHECK(s == TSCODEC_OK);
+            k++;
+        }
+        ns += test_now_ns() - t0;
+        if (enc.count == 0 || enc.count != k - start) {
+            printf("FAIL size %u: block of %u records at %d\n", size, enc.count, start);
+            test_fails++;
+            return blocks;
+        }
+        used = TsCodec_BlockBytes(&enc);
+        memset(blk, 0xFF, sizeof(blk));             /* Erased flash after the block */
+        memcpy(blk, enc.block, used);
+        if (out != NULL) {
+            fwrite(blk, 1, size, out);
+        }
+        CHECK(TsCodec_DecoderInit(&d, blk, size) == TSCODEC_OK);
+        for (j = start; j < k; j++) {
+            if (TsCodec_Next(&d, &o) != TSCODEC_OK || !same(&o, &r[j], ni, nf)) {
+                printf("FAIL size %u: record %d\n", size, j);
+                test_fails++;
+                return blocks;
+            }
+        }
+        CHECK(TsCodec_Next(&d, &o) == TSCODEC_END);
+        if (blocks == 0 && used > 8) {
+            CHECK(TsCodec_DecoderInit(&d, enc.block, (uint16_t)(used - 3u)) == TSCODEC_OK);
+            while ((s = TsCodec_Next(&d, &o)) == TSCODEC_OK) {
+            }
+            CHECK(s == TSCODEC_CORRUPT);
+        }
+        blocks++;
+        TsCodec_EncoderReset(&enc);
+    }
+    if (ns_per_rec != NULL) {
+        *ns_per_rec = ns / n;
+    }
+    return blocks;
+}
+
+static void params(void)
+{
+    TsCodec_Decoder d;
+    uint8_t b[4] = {0x00, 0, 0, 0};
+
+    CHECK(TsCodec_EncoderInit(&enc, 9, 0, 256) == TSCODEC_INVALID_PARAM);
+    CHECK(TsCodec_EncoderInit(&enc, 8, 4, 55) == TSCODEC_INVALID_PARAM);
+    CHECK(TsCodec_EncoderInit(&enc, 8, 4, 56) == TSCODEC_OK);
+    CHECK(TsCodec_DecoderInit(&d, b, 4) == TSCODEC_CORRUPT);
+}
+
+/* Blocks for the node decoder, and the records as bit patterns */
+static void server_check(void)
+{
+    FILE *blocks = fopen("ts_blocks.bin", "wb"), *txt = fopen("ts_expected.txt", "w");
+    uint32_t fb[2];
+    int k, i, n = 30000;
+
+    for (k = 0; k < n; k++) {
+        memset(&r[k], 0, sizeof(r[k]));
+        r[k].timestamp = 836000000u + (uint32_t)(k + k / 77) + (rand() % 200 == 0 ? (uint32_t)rand() : 0u);
+        for (i = 0; i < 8; i++) {
+            r[k].i[i] = (k % 500 == 0) ? (int32_t)((uint32_t)rand() * 3u)
+                      : 500 * i + (int)(10 * sin(k / 100.0 + i)) + rand() % 3 - (i == 5 ? 100000 : 0);
+        }
+        r[k].f[0] = (float)(0.4 + 0.01 * sin(k / 300.0));
+        r[k].f[1] = (k % 1000 == 0) ? -1e30f : (float)(floor(k / 10.0) * 0.125);
+        memcpy(fb, r[k].f, sizeof(fb));
+        fprintf(txt, "%u", r[k].timestamp);
+        for (i = 0; i < 8; i++) {
+            fprintf(txt, " %d", r[k].i[i]);
+        }
+        fprintf(txt, " %u %u\n", fb[0], fb[1]);
+    }
+    roundtrip(n, 8, 2, 248, NULL, blocks);
+    fclose(blocks);
+    fclose(txt);
+    fflush(stdout);
+    if (system("node --version > /dev/null 2>&1") != 0) {
+        printf("server decoder: SKIP, node not found\n");
+        return;
+    }
+    CHECK(system("node ../ts_codec_check.js ts_blocks.bin ts_expected.txt 248") == 0);
+}
+
+int main(int argc, char **argv)
+{
+    double ns;
+    int blocks, jitter;
+    uint16_t size;
+
+    test_seed(argc, argv);
+    params();
+
+    adversarial(20000);
+    for (size = 56; size <= 256; size += 25) {
+        roundtrip(20000, 8, 4, size, NULL, NULL);
+    }
+    roundtrip(20000, 0, 0, 8, NULL, NULL);
+    roundtrip(20000, 3, 0, 20, NULL, NULL);
+    printf("random values: block sizes 56..256 round-trip\n");
+
+    for (jitter = 0; jitter < 2; jitter++) {
+        day(DAY, jitter);
+        blocks = roundtrip(DAY, 8, 2, 248, &ns, NULL);
+        printf("%s: %d records -> %d blocks, %.1f records/block, %.2f B/record, "
+               "%.2fx smaller than log records, %.0f ns/record to encode\n",
+               jitter ? "jittered 1 Hz" : "1 Hz", DAY, blocks, (double)DAY / blocks,
+               248.0 * blocks / DAY, (double)DAY * LOG_REC / (248.0 * blocks), ns);
+        CHECK((double)DAY * LOG_REC / (248.0 * blocks) > 3.5);
+    }
+
+    server_check();
+    return test_finish();
+}
@@ -0,0 +1,40 @@
+/**
+ * Decodes test_ts_codec's blocks with the server decoder and compares every
+ * record with the C encoder's input.
+ *   node ts_codec_check.js <blocks.bin> <expected.txt> <block size>
+ * expected.txt: one record per line, "ts i0 .. i7 f0bits f1bits".
+ */
+
+const fs = require('fs');
+const path = require('path');
+const { decodeBlock } = require(path.join(__dirname, '../../上云/server/ts-codec.js'));
+
+const [blocksPath, expectedPath, sizeArg] = process.argv.slice(2);
+const size = Number(sizeArg);
+const buf = fs.readFileSync(blocksPath);
+const expected = fs.readFileSync(expectedPath, 'utf8').trim().split('\n');
+const dv = new DataView(new ArrayBuffer(4));
+
+function floatBits(v) {
+    dv.setFloat32(0, v);
+    return dv.getUint32(0);
+}
+
+let n = 0;
+let bad = 0;
+for (let o = 0; o < buf.length; o += size) {
+    for (const r of decodeBlock(buf.subarray(o, o + size)).records) {
+        const want = expected[n++].split(' ').map(Number);
+        const got = [r.timestamp, ...r.i, ...r.f.map(floatBits)];
+        if (got.some((v, j) => v !== want[j]) && bad++ < 3) {
+            console.log('mismatch at record', n - 1, got, want);
+        }
+    }
+}
+
+if (n === expected.length && bad === 0) {
+    console.log(`server decoder: ${n} records match`);
+} else {
+    console.log(`FAIL server decoder: ${n}/${expected.length} records, ${bad} mismatches`);
+    process.exit(1);
+}
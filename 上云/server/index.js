@@ -8,6 +8,8 @@ const express = require('express');
 const http = require('http');
 const WebSocket = require('ws');
 const path = require('path');
+const uplink = require('./uplink');
+const stats = require('./stats');
 
 // 默认配置
 const DEFAULT_PORT = 8080;
@@ -37,6 +39,37 @@ const wss = new WebSocket.Server({ server });
 const clients = new Map();
 let clientIdCounter = 0;
 
+// 设备上行去重 (设备重连后补发的行与已收到的行 seq 相同)，每台设备一份，
+// 每秒有变化时存盘，服务器重启后补发的行不会重复计入
+const UPLINK_STATE_FILE = path.join(__dirname, 'uplink-seen.json');
+const uplinkFilters = new uplink.SeqFilters(UPLINK_STATE_FILE);
+setInterval(() => saveUplinkState(), 1000).unref();
+
+// STAT 窗口按设备、通道合成每小时统计
+const statsMerger = new stats.StatsMerger();
+
+/**
+ * 连接对应的设备标识: 连接地址带 ?dev=<id> 时用它 (同一出口 IP 后有多台
+ * 设备时必须带)，否则用对端 IP
+ * @param {http.IncomingMessage} req - WebSocket 握手请求
+ * @returns {string}
+ */
+function deviceKey(req) {
+    const dev = new URL(req.url, 'ws://localhost').searchParams.get('dev');
+    return dev ? `dev:${dev}` : `ip:${req.socket.remoteAddress}`;
+}
+
+/**
+ * 写回去重状态，失败只打印 (下次再试)
+ */
+function saveUplinkState() {
+    try {
+        uplinkFilters.save();
+    } catch (e) {
+        console.error(`[错误] 保存上行去重状态失败: ${e.message}`);
+    }
+}
+
 /**
  * 将字符串中的非 ASCII 字符转换为 Unicode 转义
  * @param {string} str - 原始字符串
@@ -115,10 +148,42 @@ function getOrCreateClientInfo(ws, req) {
     return clientInfo;
 }
 
+/**
+ * 合并一个 STAT 窗口，向所有客户端发送该窗口和所在小时的合并统计
+ * @param {object} info - 发送者客户端信息
+ * @param {string} devKey - 设备标识
+ * @param {object} stat - stats.parseStat() 的结果
+ * @param {number} deviceTime - 设备时间 (秒)
+ */
+function broadcastStat(info, devKey, stat, deviceTime) {
+    const { start, summary } = statsMerger.add(devKey, stat, deviceTime);
+    const view = (s) => ({
+        count: s.count,
+        mean: s.mean,
+        std: stats.stdDev(s),
+        min: s.min,
+        max: s.max
+    });
+
+    broadcastToAll(safeJsonStringify({
+        type: 'stats',
+        from: info.id,
+        fromIp: info.ip,
+        data: {
+            channel: stat.name,
+            window: view(stat),
+            periodStart: uplink.deviceTimeToIso(start),
+            period: view(summary)
+        },
+        timestamp: new Date().toISOString()
+    }));
+}
+
 // 处理新连接
 wss.on('connection', (ws, req) => {
     const clientId = ++clientIdCounter;
     const clientIp = req.socket.remoteAddress;
+    const devKey = deviceKey(req);
 
     // 存储客户端信息
     const clientInfo = {
@@ -161,6 +226,37 @@ wss.on('connection', (ws, req) => {
 
         console.log(`[消息] 来自客户端 #${info.id}: ${messageStr}，当前在线: ${clients.size}`);
 
+        // 设备上行行: 逐条回复 ACK，重复的 seq 不再转发
+        const line = uplink.parseLine(messageStr);
+        if (line) {
+            try {
+                ws.send(`ACK:${line.seq}\r\n`);
+            } catch (e) {
+                // 设备收不到 ACK 会补发，这里忽略
+            }
+            if (!uplinkFilters.accept(devKey, line)) {
+                return;
+            }
+            // 补发的是历史数据，用 replay 类型转发，避免页面当作实时值显示
+            broadcast(safeJsonStringify({
+                type: line.replay ? 'replay' : 'forward',
+                from: info.id,
+                fromIp: info.ip,
+                data: {
+                    type: 'text',
+                    content: line.content,
+                    seq: line.seq,
+                    deviceTime: uplink.deviceTimeToIso(line.deviceTime)
+                },
+                timestamp: new Date().toISOString()
+            }), ws);
+            const stat = stats.parseStat(line.content);
+            if (stat) {
+                broadcastStat(info, devKey, stat, line.deviceTime);
+            }
+            return;
+        }
+
         // 尝试解析 JSON 消息
         let parsedMessage;
         try {
@@ -240,6 +336,7 @@ server.listen(port, () => {
 // 优雅关闭
 process.on('SIGINT', () => {
     console.log('\n[服务器] 正在关闭...');
+    saveUplinkState();
 
     // 通知所有客户端服务器即将关闭
     broadcastToAll(safeJsonStringify({
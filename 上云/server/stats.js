@@ -0,0 +1,111 @@
+/**
+ * 设备 STAT 行解析与合并
+ * 与固件 App/stats_app.c 一致: 每个统计窗口结束时每个通道一行
+ *   STAT,<通道>,<count>,<mean>,<m2>,<min>,<max>
+ * {count, mean, m2, min, max} 可以合并 (Chan 等人的公式，见 run_stats.h)，
+ * 所以服务器不需要原始采样就能把每分钟的窗口合成每小时的统计
+ */
+
+const STAT_RE = /^STAT,([^,]+),(\d+),([^,]+),([^,]+),([^,]+),([^,\r\n]+)[\r\n]*$/;
+
+/**
+ * 解析一行 STAT
+ * @param {string} str - 上行行正文
+ * @returns {{name: string, count: number, mean: number, m2: number, min: number, max: number}|null}
+ *          不是 STAT 行时返回 null
+ */
+function parseStat(str) {
+    const m = STAT_RE.exec(str);
+    if (!m) {
+        return null;
+    }
+    const s = {
+        name: m[1],
+        count: Number(m[2]),
+        mean: Number(m[3]),
+        m2: Number(m[4]),
+        min: Number(m[5]),
+        max: Number(m[6])
+    };
+    if ([s.mean, s.m2, s.min, s.max].some(Number.isNaN)) {
+        return null;
+    }
+    return s;
+}
+
+/**
+ * 合并两个窗口的统计 (与 RunStats_Merge 相同，双精度计算)
+ *   n = na + nb, d = mean_b - mean_a
+ *   mean = mean_a + d * nb / n
+ *   m2   = m2_a + m2_b + d^2 * na * nb / n
+ * @param {object} a
+ * @param {object} b
+ * @returns {{count: number, mean: number, m2: number, min: number, max: number}}
+ */
+function mergeStats(a, b) {
+    if (!a || a.count === 0) {
+        return { count: b.count, mean: b.mean, m2: b.m2, min: b.min, max: b.max };
+    }
+    if (b.count === 0) {
+        return { count: a.count, mean: a.mean, m2: a.m2, min: a.min, max: a.max };
+    }
+    const n = a.count + b.count;
+    const d = b.mean - a.mean;
+    return {
+        count: n,
+        mean: a.mean + d * b.count / n,
+        m2: a.m2 + b.m2 + d * d * a.count * b.count / n,
+        min: Math.min(a.min, b.min),
+        max: Math.max(a.max, b.max)
+    };
+}
+
+/**
+ * 样本标准差 (n - 1 分母)，少于 2 个样本为 0
+ * @param {object} s
+ * @returns {number}
+ */
+function stdDev(s) {
+    return s.count < 2 ? 0 : Math.sqrt(s.m2 / (s.count - 1));
+}
+
+/**
+ * 按设备、通道、时间段 (默认每小时，按设备时间) 合并 STAT 窗口
+ * 补发的旧窗口落进它自己的时间段；只保留最近 keep 个时间段
+ */
+class StatsMerger {
+    /**
+     * @param {number} [periodSec] - 时间段长度 (秒)
+     * @param {number} [keep] - 每个设备通道保留的时间段数
+     */
+    constructor(periodSec = 3600, keep = 48) {
+        this.periodSec = periodSec;
+        this.keep = keep;
+        this.periods = new Map();   // "设备|通道" -> Map(段起点 -> 统计)
+    }
+
+    /**
+     * 合并一个窗口
+     * @param {string} key - 设备标识
+     * @param {object} stat - parseStat() 的结果
+     * @param {number} deviceTime - 该行的设备时间 (秒)
+     * @returns {{start: number, summary: object}} 该窗口所在时间段合并后的统计
+     */
+    add(key, stat, deviceTime) {
+        const id = `${key}|${stat.name}`;
+        let periods = this.periods.get(id);
+        if (!periods) {
+            periods = new Map();
+            this.periods.set(id, periods);
+        }
+        const start = deviceTime - deviceTime % this.periodSec;
+        const summary = mergeStats(periods.get(start), stat);
+        periods.set(start, summary);
+        if (periods.size > this.keep) {
+            periods.delete(Math.min(...periods.keys()));
+        }
+        return { start, summary };
+    }
+}
+
+module.exports = { parseStat, mergeStats, stdDev, StatsMerger };
@@ -0,0 +1,164 @@
+/**
+ * 传感器时间序列块解码器
+ * 与固件 Components/ts_codec 的块格式一致 (格式说明见 ts_codec.h)
+ * 每个块独立解码，不依赖前后块
+ */
+
+const TSCODEC_MAGIC = 0xC5;
+const TSCODEC_HDR_SIZE = 4;
+
+/**
+ * MSB 优先的位读取器
+ */
+class BitReader {
+    constructor(buf, start, end) {
+        this.buf = buf;
+        this.pos = start * 8;
+        this.end = end * 8;
+    }
+
+    /**
+     * 读取 n 位 (n <= 32)，返回无符号整数
+     * @param {number} n - 位数
+     * @returns {number}
+     */
+    get(n) {
+        if (this.pos + n > this.end) {
+            throw new Error('数据块被截断');
+        }
+        let out = 0;
+        while (n > 0) {
+            const room = 8 - (this.pos & 7);
+            const take = Math.min(n, room);
+            const bits = (this.buf[this.pos >> 3] >> (room - take)) & ((1 << take) - 1);
+            out = out * (1 << take) + bits;     // 避免 32 位有符号溢出
+            this.pos += take;
+            n -= take;
+        }
+        return out >>> 0;
+    }
+}
+
+/**
+ * zig-zag 反变换，结果为 32 位有符号整数
+ * @param {number} z - 无符号编码值
+ * @returns {number}
+ */
+function unzigzag(z) {
+    return ((z >>> 1) ^ -(z & 1)) | 0;
+}
+
+const f32 = new DataView(new ArrayBuffer(4));
+
+/**
+ * 32 位位模式转 float
+ * @param {number} bits - 无符号位模式
+ * @returns {number}
+ */
+function bitsToFloat(bits) {
+    f32.setUint32(0, bits >>> 0);
+    return f32.getFloat32(0);
+}
+
+/**
+ * 解码一个数据块
+ * @param {Buffer|Uint8Array} block - 块数据 (末尾的填充字节会被忽略)
+ * @returns {{nInt: number, nFloat: number, records: Array<{timestamp: number, i: number[], f: number[]}>}}
+ */
+function decodeBlock(block) {
+    if (block.length < TSCODEC_HDR_SIZE || block[0] !== TSCODEC_MAGIC) {
+        throw new Error('不是 ts_codec 数据块');
+    }
+    const nInt = block[1] >> 4;
+    const nFloat = block[1] & 0x0F;
+    const count = block[2] | (block[3] << 8);
+    if (nInt > 8 || nFloat > 4) {
+        throw new Error('通道数无效');
+    }
+
+    const r = new BitReader(block, TSCODEC_HDR_SIZE, block.length);
+    const st = {
+        ts: 0, delta: 0,
+        i: new Array(nInt).fill(0),
+        f: new Array(nFloat).fill(0),
+        lead: new Array(nFloat).fill(0),
+        len: new Array(nFloat).fill(0)
+    };
+    const records = [];
+
+    for (let k = 0; k < count; k++) {
+        if (k === 0) {
+            st.ts = r.get(32);
+            for (let c = 0; c < nInt; c++) st.i[c] = r.get(32) | 0;
+            for (let c = 0; c < nFloat; c++) st.f[c] = r.get(32);
+        } else {
+            // 时间戳: 二阶差分
+            let ones = 0;
+            while (ones < 4 && r.get(1) === 1) ones++;
+            const z = ones > 0 ? r.get([7, 9, 12, 32][ones - 1]) : 0;
+            st.delta = (st.delta + unzigzag(z)) >>> 0;
+            st.ts = (st.ts + st.delta) >>> 0;
+
+            // 整数通道: zig-zag varint 差分
+            for (let c = 0; c < nInt; c++) {
+                if (r.get(1) === 1) {
+                    let z = 0, shift = 0, byte;
+                    do {
+                        if (shift > 28) throw new Error('varint 过长');
+                        byte = r.get(8);
+                        z += (byte & 0x7F) * 2 ** shift;
+                        shift += 7;
+                    } while (byte & 0x80);
+                    st.i[c] = (st.i[c] + unzigzag(z >>> 0)) | 0;
+                }
+            }
+
+            // 浮点通道: Gorilla XOR
+            for (let c = 0; c < nFloat; c++) {
+                if (r.get(1) === 0) continue;
+                if (r.get(1) === 1) {
+                    st.lead[c] = r.get(5);
+                    st.len[c] = r.get(6);
+                    if (st.len[c] === 0 || st.lead[c] + st.len[c] > 32) {
+                        throw new Error('XOR 窗口无效');
+                    }
+                } else if (st.len[c] === 0) {
+                    throw new Error('XOR 窗口未定义');
+                }
+                const x = r.get(st.len[c]) * 2 ** (32 - st.lead[c] - st.len[c]);
+                st.f[c] = (st.f[c] ^ x) >>> 0;
+            }
+        }
+
+        records.push({
+            timestamp: st.ts,
+            i: st.i.slice(),
+            f: st.f.map(bitsToFloat)
+        });
+    }
+
+    return { nInt, nFloat, records };
+}
+
+/**
+ * 将固件 storage_sample_to_record() 的整数定点值还原为物理量
+ * @param {{timestamp: number, i: number[], f: number[]}} rec - 解码后的记录
+ * @returns {object}
+ */
+function toSample(rec) {
+    return {
+        timestamp: rec.timestamp,
+        co2_ppm: rec.i[0],
+        tvoc_mg_m3: rec.i[1] / 1000,
+        hcho_mg_m3: rec.i[2] / 1000,
+        temp_c: rec.i[3] / 10,
+        humi_percent: rec.i[4] / 10,
+        ethanol_ppm: rec.i[5] / 100,
+        battery: rec.i[6] / 10,
+        alarm: rec.i[7] & 0xFF,
+        ethylene_v: rec.f[0],
+        ethylene_ppm: rec.f[1]
+    };
+}
+
+module.exports = { decodeBlock, toSample };
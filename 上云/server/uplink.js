@@ -0,0 +1,204 @@
+/**
+ * 设备上行存储转发协议
+ * 与固件 Components/uplink_queue 一致 (格式说明见 uplink_queue.h)
+ *   实时:   #<seq>,<timestamp> <正文>
+ *   补发:   #<seq>,<timestamp>,R <正文>
+ * 服务器对每一行回复 "ACK:<seq>"；同一 seq 可能到达多次，只转发第一次
+ * 行里没有设备标识，去重按连接的设备 key 分开 (见 index.js deviceKey)
+ */
+
+const fs = require('fs');
+
+const LINE_RE = /^#(\d+),(\d+)(,R)? ([\s\S]*?)[\r\n]*$/;
+
+// 设备 RTC 时间戳起点 2000-01-01 (见 storage_app.h)
+const DEVICE_EPOCH_MS = Date.UTC(2000, 0, 1);
+
+/**
+ * 解析一行上行数据
+ * @param {string} str - 收到的文本
+ * @returns {{seq: number, deviceTime: number, replay: boolean, content: string}|null}
+ *          不是上行格式时返回 null
+ */
+function parseLine(str) {
+    const m = LINE_RE.exec(str);
+    if (!m) {
+        return null;
+    }
+    return {
+        seq: Number(m[1]),
+        deviceTime: Number(m[2]),
+        replay: m[3] !== undefined,
+        content: m[4]
+    };
+}
+
+/**
+ * 设备时间戳转 ISO 字符串
+ * @param {number} ts - 自 2000-01-01 起的秒数
+ * @returns {string}
+ */
+function deviceTimeToIso(ts) {
+    return new Date(DEVICE_EPOCH_MS + ts * 1000).toISOString();
+}
+
+/**
+ * 一台设备的 seq 去重，记住最近 limit 个序号
+ *
+ * 设备的 seq 只增不减 (复位后从 Flash 恢复)，时间戳随 seq 一起增长，
+ * 所以下面几种情况说明设备的序号重新开始了 (队列分区被格式化、换了设备)，
+ * 而不是重复行，此时清空已记住的序号:
+ *   - 实时行的 seq 不大于已见过的最大 seq (实时行不会重发，重发都带 R)
+ *   - seq 不大于最大 seq，但设备时间比最大 seq 那一行晚
+ *   - seq 比最大 seq 小了 limit 以上
+ */
+class SeqFilter {
+    constructor(limit = 65536) {
+        this.limit = limit;
+        this.seen = new Set();
+        this.order = [];
+        this.high = -1;             // 最大 seq
+        this.highTime = 0;          // 最大 seq 那一行的设备时间
+        this.duplicates = 0;
+        this.resets = 0;
+    }
+
+    /**
+     * 第一次见到该行的 seq 返回 true
+     * @param {{seq: number, deviceTime: number, replay: boolean}} line - parseLine() 的结果
+     * @returns {boolean}
+     */
+    accept(line) {
+        const seq = line.seq;
+
+        if (seq <= this.high &&
+            (!line.replay || line.deviceTime > this.highTime || seq + this.limit < this.high)) {
+            this.reset();
+        }
+        if (this.seen.has(seq)) {
+            this.duplicates++;
+            return false;
+        }
+        this.seen.add(seq);
+        this.order.push(seq);
+        if (this.order.length > this.limit) {
+            this.seen.delete(this.order.shift());
+        }
+        if (seq > this.high) {
+            this.high = seq;
+            this.highTime = line.deviceTime;
+        }
+        return true;
+    }
+
+    /** 忘掉所有序号 (设备的序号重新开始) */
+    reset() {
+        this.seen.clear();
+        this.order = [];
+        this.high = -1;
+        this.highTime = 0;
+        this.resets++;
+    }
+
+    /**
+     * 可存盘的状态: 记住的序号压成连续区间 [first, last]
+     * @returns {object}
+     */
+    toJSON() {
+        const seqs = [...this.seen].sort((a, b) => a - b);
+        const runs = [];
+        for (const seq of seqs) {
+            const last = runs[runs.length - 1];
+            if (last && last[1] + 1 === seq) {
+                last[1] = seq;
+            } else {
+                runs.push([seq, seq]);
+            }
+        }
+        return {
+            high: this.high,
+            highTime: this.highTime,
+            duplicates: this.duplicates,
+            resets: this.resets,
+            runs
+        };
+    }
+
+    /**
+     * 从 toJSON() 的结果恢复 (淘汰顺序按 seq 从小到大)
+     * @param {object} state
+     * @param {number} [limit]
+     * @returns {SeqFilter}
+     */
+    static fromJSON(state, limit) {
+        const f = new SeqFilter(limit);
+        for (const [first, last] of state.runs || []) {
+            for (let seq = first; seq <= last; seq++) {
+                f.seen.add(seq);
+                f.order.push(seq);
+            }
+        }
+        while (f.order.length > f.limit) {
+            f.seen.delete(f.order.shift());
+        }
+        f.high = state.high ?? -1;
+        f.highTime = state.highTime ?? 0;
+        f.duplicates = state.duplicates ?? 0;
+        f.resets = state.resets ?? 0;
+        return f;
+    }
+}
+
+/**
+ * 每台设备一个 SeqFilter，可存到文件，服务器重启后补发的行仍能去重
+ */
+class SeqFilters {
+    /**
+     * @param {string} [file] - 状态文件，存在则从中恢复
+     * @param {number} [limit] - 每台设备记住的序号数
+     */
+    constructor(file, limit) {
+        this.file = file;
+        this.limit = limit;
+        this.filters = new Map();
+        this.dirty = false;
+        if (file && fs.existsSync(file)) {
+            const state = JSON.parse(fs.readFileSync(file, 'utf8'));
+            for (const key of Object.keys(state)) {
+                this.filters.set(key, SeqFilter.fromJSON(state[key], limit));
+            }
+        }
+    }
+
+    /**
+     * 设备 key 对应的行第一次到达返回 true
+     * @param {string} key - 设备标识
+     * @param {object} line - parseLine() 的结果
+     * @returns {boolean}
+     */
+    accept(key, line) {
+        let f = this.filters.get(key);
+        if (!f) {
+            f = new SeqFilter(this.limit);
+            this.filters.set(key, f);
+        }
+        this.dirty = true;
+        return f.accept(line);
+    }
+
+    /** 有变化时写回状态文件 (先写临时文件再改名，写一半掉电不会损坏旧文件) */
+    save() {
+        if (!this.file || !this.dirty) {
+            return;
+        }
+        const state = {};
+        for (const [key, f] of this.filters) {
+            state[key] = f.toJSON();
+        }
+        fs.writeFileSync(this.file + '.tmp', JSON.stringify(state));
+        fs.renameSync(this.file + '.tmp', this.file);
+        this.dirty = false;
+    }
+}
+
+module.exports = { parseLine, deviceTimeToIso, SeqFilter, SeqFilters };